@@ -62,6 +62,15 @@ public class Index implements Cloneable, Serializable {
     /** Whether the posting lists of this index field should have interleaved features (num occs, field length) in document id stream. */
     private boolean interleavedFeatures = false;
 
+    /**
+     * Whether the posting lists of this index field should store max term frequency per skip block, used by block-max weak and.
+     * Implies interleaved features.
+     */
+    private boolean blockMax = false;
+
+    /** Whether the posting lists of this index field should store document ids in bit packed blocks. */
+    private boolean packedDocIds = false;
+
     public Index(String name) {
         this(name, false);
     }
@@ -123,6 +132,8 @@ public class Index implements Cloneable, Serializable {
         Index index = (Index) o;
         return prefix == index.prefix &&
                interleavedFeatures == index.interleavedFeatures &&
+               blockMax == index.blockMax &&
+               packedDocIds == index.packedDocIds &&
                Objects.equals(name, index.name) &&
                rankType == index.rankType &&
                Objects.equals(aliases, index.aliases) &&
@@ -134,7 +145,7 @@ public class Index implements Cloneable, Serializable {
 
     @Override
     public int hashCode() {
-        return Objects.hash(name, rankType, prefix, aliases, stemming, type, boolIndex, hnswIndexParams, interleavedFeatures);
+        return Objects.hash(name, rankType, prefix, aliases, stemming, type, boolIndex, hnswIndexParams, interleavedFeatures, blockMax, packedDocIds);
     }
 
     public String toString() {
@@ -194,7 +205,23 @@ public class Index implements Cloneable, Serializable {
     }
 
     public boolean useInterleavedFeatures() {
-        return interleavedFeatures;
+        return interleavedFeatures || blockMax;
+    }
+
+    public void setBlockMax(boolean value) {
+        blockMax = value;
+    }
+
+    public boolean useBlockMax() {
+        return blockMax;
+    }
+
+    public void setPackedDocIds(boolean value) {
+        packedDocIds = value;
+    }
+
+    public boolean usePackedDocIds() {
+        return packedDocIds;
     }
 
 }
@@ -514,6 +514,12 @@ public class Schema implements ImmutableSchema {
             if (current.useInterleavedFeatures()) {
                 consolidated.setInterleavedFeatures(true);
             }
+            if (current.useBlockMax()) {
+                consolidated.setBlockMax(true);
+            }
+            if (current.usePackedDocIds()) {
+                consolidated.setPackedDocIds(true);
+            }
 
             if (consolidated.getRankType() == null) {
                 consolidated.setRankType(current.getRankType());
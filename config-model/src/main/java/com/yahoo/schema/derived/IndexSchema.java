@@ -118,7 +118,9 @@ public class IndexSchema extends Derived implements IndexschemaConfig.Producer {
                 .prefix(f.hasPrefix())
                 .phrases(false)
                 .positions(true)
-                .interleavedfeatures(f.useInterleavedFeatures());
+                .interleavedfeatures(f.useInterleavedFeatures())
+                .packeddocids(f.usePackedDocIds())
+                .blockmax(f.useBlockMax());
             if (!f.getCollectionType().equals("SINGLE")) {
                 ifB.collectiontype(IndexschemaConfig.Indexfield.Collectiontype.Enum.valueOf(f.getCollectionType()));
             }
@@ -177,6 +179,12 @@ public class IndexSchema extends Derived implements IndexschemaConfig.Producer {
         // Whether the posting lists of this index field should have interleaved features (num occs, field length) in document id stream.
         private boolean interleavedFeatures = false;
 
+        // Whether the posting lists of this index field should store max term frequency per skip block.
+        private boolean blockMax = false;
+
+        // Whether the posting lists of this index field should store document ids in bit packed blocks.
+        private boolean packedDocIds = false;
+
         public IndexField(String name, Index.Type type, DataType sdFieldType) {
             this.name = name;
             this.type = type;
@@ -186,6 +194,8 @@ public class IndexSchema extends Derived implements IndexschemaConfig.Producer {
             if (type.equals(Index.Type.TEXT)) {
                 prefix = index.isPrefix();
                 interleavedFeatures = index.useInterleavedFeatures();
+                blockMax = index.useBlockMax();
+                packedDocIds = index.usePackedDocIds();
             }
         }
         public String getName() { return name; }
@@ -204,6 +214,8 @@ public class IndexSchema extends Derived implements IndexschemaConfig.Producer {
 	    }
         public boolean hasPrefix() { return prefix; }
         public boolean useInterleavedFeatures() { return interleavedFeatures; }
+        public boolean useBlockMax() { return blockMax; }
+        public boolean usePackedDocIds() { return packedDocIds; }
     }
 
     /**
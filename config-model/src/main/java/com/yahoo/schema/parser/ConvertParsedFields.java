@@ -269,6 +269,8 @@ public class ConvertParsedFields {
             index.setBooleanIndexDefiniton(bid);
         }
         parsed.getEnableBm25().ifPresent(enableBm25 -> index.setInterleavedFeatures(enableBm25));
+        parsed.getEnableBlockMax().ifPresent(enableBlockMax -> index.setBlockMax(enableBlockMax));
+        parsed.getEnablePackedDocIds().ifPresent(enablePackedDocIds -> index.setPackedDocIds(enablePackedDocIds));
         parsed.getHnswIndexParams().ifPresent
             (hnswIndexParams -> index.setHnswIndexParams(hnswIndexParams));
     }
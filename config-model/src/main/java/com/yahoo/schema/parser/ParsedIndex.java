@@ -17,6 +17,8 @@ import java.util.Optional;
 class ParsedIndex extends ParsedBlock {
 
     private Boolean enableBm25 = null;
+    private Boolean enableBlockMax = null;
+    private Boolean enablePackedDocIds = null;
     private Boolean isPrefix = null;
     private HnswIndexParams hnswParams = null;
     private final List<String> aliases = new ArrayList<>();
@@ -31,6 +33,8 @@ class ParsedIndex extends ParsedBlock {
     }
 
     Optional<Boolean> getEnableBm25() { return Optional.ofNullable(this.enableBm25); }
+    Optional<Boolean> getEnableBlockMax() { return Optional.ofNullable(this.enableBlockMax); }
+    Optional<Boolean> getEnablePackedDocIds() { return Optional.ofNullable(this.enablePackedDocIds); }
     Optional<Boolean> getPrefix() { return Optional.ofNullable(this.isPrefix); }
     Optional<HnswIndexParams> getHnswIndexParams() { return Optional.ofNullable(this.hnswParams); }
     List<String> getAliases() { return List.copyOf(aliases); }
@@ -57,6 +61,14 @@ class ParsedIndex extends ParsedBlock {
         this.enableBm25 = value;
     }
 
+    void setEnableBlockMax(boolean value) {
+        this.enableBlockMax = value;
+    }
+
+    void setEnablePackedDocIds(boolean value) {
+        this.enablePackedDocIds = value;
+    }
+
     void setHnswIndexParams(HnswIndexParams params) {
         this.hnswParams = params;
     }
@@ -497,6 +497,10 @@ public class VespaMetricSet {
         metrics.add(new Metric("content.proton.resource_usage.malloc_arena.max"));
         metrics.add(new Metric("content.proton.documentdb.attribute.resource_usage.address_space.max"));
         metrics.add(new Metric("content.proton.documentdb.attribute.resource_usage.feeding_blocked.max"));
+        metrics.add(new Metric("content.proton.documentdb.attribute.filter_cache.memory_usage.average"));
+        metrics.add(new Metric("content.proton.documentdb.attribute.filter_cache.hit_rate.average"));
+        metrics.add(new Metric("content.proton.documentdb.attribute.filter_cache.lookups.rate"));
+        metrics.add(new Metric("content.proton.documentdb.attribute.filter_cache.invalidations.rate"));
 
         // CPU util
         metrics.add(new Metric("content.proton.resource_usage.cpu_util.setup.max"));
@@ -580,8 +584,13 @@ public class VespaMetricSet {
         metrics.add(new Metric("content.proton.documentdb.matching.query_setup_time.count"));
         metrics.add(new Metric("content.proton.documentdb.matching.docs_matched.rate"));
         metrics.add(new Metric("content.proton.documentdb.matching.docs_matched.count"));
+        metrics.add(new Metric("content.proton.documentdb.matching.result_cache.memory_usage.average"));
+        metrics.add(new Metric("content.proton.documentdb.matching.result_cache.hit_rate.average"));
+        metrics.add(new Metric("content.proton.documentdb.matching.result_cache.lookups.rate"));
+        metrics.add(new Metric("content.proton.documentdb.matching.result_cache.invalidations.rate"));
         metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.queries.rate"));
         metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.soft_doomed_queries.rate"));
+        metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.docid_range_steals.rate"));
         metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.soft_doom_factor.min"));
         metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.soft_doom_factor.max"));
         metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.soft_doom_factor.sum"));
@@ -10,6 +10,7 @@ import java.io.IOException;
 
 import static com.yahoo.config.model.test.TestUtil.joinLines;
 import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
 import static org.junit.jupiter.api.Assertions.assertTrue;
 
 /**
@@ -59,4 +60,51 @@ public class IndexSettingsTestCase extends AbstractSchemaTestCase {
         assertTrue(extraIndex.useInterleavedFeatures());
     }
 
+    @Test
+    void requireThatBlockMaxImpliesInterleavedFeatures() throws ParseException {
+        ApplicationBuilder builder = ApplicationBuilder.createFromString(joinLines(
+                "search test {",
+                "  document test {",
+                "    field content type string {",
+                "      indexing: index | summary",
+                "      index: enable-block-max",
+                "    }",
+                "    field title type string {",
+                "      indexing: index | summary",
+                "      index: enable-bm25",
+                "    }",
+                "  }",
+                "}"
+        ));
+        Schema schema = builder.getSchema();
+        Index contentIndex = schema.getIndex("content");
+        assertTrue(contentIndex.useBlockMax());
+        assertTrue(contentIndex.useInterleavedFeatures());
+        Index titleIndex = schema.getIndex("title");
+        assertFalse(titleIndex.useBlockMax());
+        assertTrue(titleIndex.useInterleavedFeatures());
+    }
+
+    @Test
+    void requireThatPackedDocIdsAreSetOnIndex() throws ParseException {
+        ApplicationBuilder builder = ApplicationBuilder.createFromString(joinLines(
+                "search test {",
+                "  document test {",
+                "    field content type string {",
+                "      indexing: index | summary",
+                "      index: enable-packed-doc-ids",
+                "    }",
+                "    field title type string {",
+                "      indexing: index | summary",
+                "    }",
+                "  }",
+                "}"
+        ));
+        Schema schema = builder.getSchema();
+        assertTrue(schema.getIndex("content").usePackedDocIds());
+        assertFalse(schema.getIndex("content").useInterleavedFeatures());
+        Index titleIndex = schema.getIndex("title");
+        assertTrue(titleIndex == null || !titleIndex.usePackedDocIds());
+    }
+
 }
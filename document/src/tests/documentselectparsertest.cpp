@@ -26,6 +26,7 @@
 #include <vespa/document/select/invalidconstant.h>
 #include <vespa/document/select/doctype.h>
 #include <vespa/document/select/compare.h>
+#include <vespa/document/select/compiled_selection.h>
 #include <vespa/document/select/operator.h>
 #include <vespa/document/select/parse_utils.h>
 #include <vespa/document/select/parser_limits.h>
@@ -509,6 +510,9 @@ DocumentSelectParserTest::doParse(vespalib::stringref expr,
     EXPECT_EQ(result, clonedResult) << expr;
     EXPECT_EQ(result, tracedResult) << oss.str();
 
+    select::CompiledSelection compiled(*root);
+    EXPECT_EQ(result.combineResults(), compiled.evaluate(t)) << "compiled: " << expr;
+
     return result;
 }
 
@@ -1679,6 +1683,22 @@ TEST_F(DocumentSelectParserTest, imported_field_references_only_support_for_simp
     PARSE("with_imported.my_imported_field{foo}", doc, Invalid);
 }
 
+TEST_F(DocumentSelectParserTest, compiled_selection_only_falls_back_to_tree_for_unsupported_subtrees) {
+    createDocs();
+    auto fallbacks = [this](const char* expr) {
+        std::unique_ptr<select::Node> root(_parser->parse(expr));
+        return select::CompiledSelection(*root).fallback_count();
+    };
+    EXPECT_EQ(0u, fallbacks("testdoctype1 and testdoctype1.headerval > 10 and testdoctype1.hstringval =~ \"^f\""));
+    EXPECT_EQ(0u, fallbacks("not (id.namespace == \"myspace\" or id.user == 1234) and now() > 0"));
+    EXPECT_EQ(0u, fallbacks("testdoctype1.hfloatval >= 2.0 or testdoctype1.content = \"*oo\" or testdoctype1.headerlongval != null"));
+    EXPECT_EQ(1u, fallbacks("testdoctype1 and testdoctype1.headerval + 1 > 10"));
+    EXPECT_EQ(1u, fallbacks("testdoctype1.mystruct.key == 14 and testdoctype1.headerval > 10"));
+    EXPECT_EQ(1u, fallbacks("id.bucket == 1234 and true"));
+    // Variable bindings span branches, so the whole expression is left to the tree
+    EXPECT_EQ(1u, fallbacks("testdoctype1.structarray[$x].key == 15 and testdoctype1.headerval > 10"));
+}
+
 TEST_F(DocumentSelectParserTest, prefix_and_suffix_wildcard_globs_are_rewritten_to_optimized_form) {
     using select::GlobOperator;
     EXPECT_EQ(GlobOperator::convertToRegex("*foo"), "foo$");
@@ -0,0 +1,96 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/document/base/documentid.h>
+#include <vespa/document/bucket/bucketidfactory.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/floatfieldvalue.h>
+#include <vespa/document/fieldvalue/intfieldvalue.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/document/repo/configbuilder.h>
+#include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/select/compiled_selection.h>
+#include <vespa/document/select/node.h>
+#include <vespa/document/select/parser.h>
+#include <vespa/document/select/resultlist.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace document;
+using document::config_builder::Struct;
+using vespalib::BenchmarkTimer;
+
+/**
+ * Compares evaluating a selection through the selection tree with evaluating
+ * the same selection compiled, over a set of documents.
+ */
+int main(int argc, char *argv[])
+{
+    const char* selection = "music and music.year >= 2000 and music.artist =~ \"^a\" and id.namespace != \"archive\"";
+    uint32_t num_docs = 10000;
+    if (argc > 1) {
+        selection = argv[1];
+    }
+    if (argc > 2) {
+        num_docs = strtoul(argv[2], nullptr, 0);
+    }
+    config_builder::DocumenttypesConfigBuilderHelper builder;
+    builder.document(42, "music",
+                     Struct("music.header")
+                             .addField("year", DataType::T_INT)
+                             .addField("rating", DataType::T_FLOAT)
+                             .addField("artist", DataType::T_STRING),
+                     Struct("music.body"));
+    DocumentTypeRepo repo(builder.config());
+    const DocumentType& type = *repo.getDocumentType("music");
+
+    std::vector<std::unique_ptr<Document>> docs;
+    const char* artists[] = { "abba", "beatles", "aerosmith", "creedence" };
+    for (uint32_t i = 0; i < num_docs; ++i) {
+        vespalib::string id = vespalib::make_string("id:%s:music::%u", (i % 10 == 0) ? "archive" : "music", i);
+        auto doc = std::make_unique<Document>(type, DocumentId(id));
+        doc->setValue("year", IntFieldValue(1960 + (i % 64)));
+        doc->setValue("rating", FloatFieldValue(i % 5));
+        doc->setValue("artist", StringFieldValue(artists[i % 4]));
+        docs.push_back(std::move(doc));
+    }
+
+    BucketIdFactory bucket_id_factory;
+    select::Parser parser(repo, bucket_id_factory);
+    std::unique_ptr<select::Node> root(parser.parse(selection));
+    select::CompiledSelection compiled(*root);
+    printf("Selection '%s' over %u documents, %u subtrees not compiled\n", selection, num_docs, compiled.fallback_count());
+
+    uint64_t tree_matches = 0;
+    uint64_t compiled_matches = 0;
+    double tree_time = BenchmarkTimer::benchmark([&]() {
+        for (const auto& doc : docs) {
+            tree_matches += (root->contains(*doc) == select::Result::True) ? 1 : 0;
+        }
+    }, 5.0);
+    double compiled_time = BenchmarkTimer::benchmark([&]() {
+        for (const auto& doc : docs) {
+            compiled_matches += (compiled.evaluate(*doc) == select::Result::True) ? 1 : 0;
+        }
+    }, 5.0);
+    uint64_t matches = 0;
+    for (const auto& doc : docs) {
+        bool tree_match = (root->contains(*doc) == select::Result::True);
+        bool compiled_match = (compiled.evaluate(*doc) == select::Result::True);
+        if (tree_match != compiled_match) {
+            fprintf(stderr, "Mismatch for %s\n", doc->getId().toString().c_str());
+            return 1;
+        }
+        matches += tree_match ? 1 : 0;
+    }
+    printf("%" PRIu64 " documents match\n", matches);
+    printf("tree:     %8.1f ns per document\n", tree_time * 1e9 / num_docs);
+    printf("compiled: %8.1f ns per document\n", compiled_time * 1e9 / num_docs);
+    printf("speedup:  %8.2fx\n", tree_time / compiled_time);
+    (void) tree_matches;
+    (void) compiled_matches;
+    return 0;
+}
@@ -0,0 +1,894 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compiled_selection.h"
+#include "branch.h"
+#include "compare.h"
+#include "constant.h"
+#include "context.h"
+#include "doctype.h"
+#include "invalidconstant.h"
+#include "operator.h"
+#include "resultlist.h"
+#include "traversingvisitor.h"
+#include "valuenodes.h"
+#include <vespa/document/base/documentid.h>
+#include <vespa/document/base/field.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/document/update/documentupdate.h>
+#include <vespa/vespalib/regex/regex.h>
+#include <array>
+#include <cctype>
+#include <cassert>
+#include <typeinfo>
+
+namespace document::select {
+
+namespace {
+
+// A set of possible outcomes, one bit per Result::toEnum(). This is what a ResultList
+// without variable bindings boils down to.
+using Outcomes = uint8_t;
+
+constexpr Outcomes INVALID_BIT = 1u << 0u;
+constexpr Outcomes FALSE_BIT = 1u << 1u;
+constexpr Outcomes TRUE_BIT = 1u << 2u;
+
+Outcomes
+bit(const Result& result) noexcept
+{
+    return Outcomes(1u << result.toEnum());
+}
+
+Outcomes
+outcomes_of(const ResultList& results) noexcept
+{
+    Outcomes outcomes = 0;
+    for (const auto& entry : results) {
+        outcomes |= bit(*entry.second);
+    }
+    return outcomes;
+}
+
+// Same precedence as ResultList::combineResults()
+const Result&
+combine(Outcomes outcomes) noexcept
+{
+    if ((outcomes & TRUE_BIT) != 0) {
+        return Result::True;
+    }
+    if ((outcomes & FALSE_BIT) != 0) {
+        return Result::False;
+    }
+    return ((outcomes & INVALID_BIT) != 0) ? Result::Invalid : Result::False;
+}
+
+using OutcomeTable = std::array<std::array<Outcomes, 8>, 8>;
+
+// Combines every pair of outcomes from the two sets, as ResultList does for its entries.
+template <typename Op>
+OutcomeTable
+make_table(Op op)
+{
+    OutcomeTable table{};
+    for (uint32_t a = 0; a < 8; ++a) {
+        for (uint32_t b = 0; b < 8; ++b) {
+            Outcomes outcomes = 0;
+            for (uint32_t i = 0; i < Result::enumRange; ++i) {
+                for (uint32_t j = 0; j < Result::enumRange; ++j) {
+                    if ((a & (1u << i)) && (b & (1u << j))) {
+                        outcomes |= bit(op(Result::fromEnum(i), Result::fromEnum(j)));
+                    }
+                }
+            }
+            table[a][b] = outcomes;
+        }
+    }
+    return table;
+}
+
+const OutcomeTable&
+and_table()
+{
+    static const OutcomeTable table = make_table([](const Result& a, const Result& b) -> const Result& { return a && b; });
+    return table;
+}
+
+const OutcomeTable&
+or_table()
+{
+    static const OutcomeTable table = make_table([](const Result& a, const Result& b) -> const Result& { return a || b; });
+    return table;
+}
+
+Outcomes
+negate(Outcomes outcomes) noexcept
+{
+    // Invalid stays invalid, true and false swap places
+    return Outcomes((outcomes & INVALID_BIT) | ((outcomes & FALSE_BIT) << 1u) | ((outcomes & TRUE_BIT) >> 1u));
+}
+
+// Only the value types a comparison can produce without involving arrays, structs or buckets.
+using Scalar = TypedValue;
+
+bool
+is_number(const Scalar& v) noexcept
+{
+    return (v.type == Value::Integer) || (v.type == Value::Float);
+}
+
+double
+as_double(const Scalar& v) noexcept
+{
+    return (v.type == Value::Integer) ? double(v.int_value) : v.float_value;
+}
+
+bool
+number_equals(const Scalar& a, const Scalar& b) noexcept
+{
+    if ((a.type == Value::Integer) && (b.type == Value::Integer)) {
+        return a.int_value == b.int_value;
+    }
+    return as_double(a) == as_double(b);
+}
+
+bool
+number_greater(const Scalar& a, const Scalar& b) noexcept
+{
+    if ((a.type == Value::Integer) && (b.type == Value::Integer)) {
+        return a.int_value > b.int_value;
+    }
+    return as_double(a) > as_double(b);
+}
+
+// Mirrors the operator== overloads of the Value subclasses
+const Result&
+equals(const Scalar& a, const Scalar& b) noexcept
+{
+    switch (a.type) {
+    case Value::Null:
+        if (b.type == Value::Null) {
+            return Result::True;
+        }
+        return (b.type == Value::Invalid) ? Result::Invalid : Result::False;
+    case Value::String:
+        if (b.type == Value::String) {
+            return Result::get(a.string_value == b.string_value);
+        }
+        return (b.type == Value::Null) ? Result::False : Result::Invalid;
+    case Value::Integer:
+    case Value::Float:
+        if (is_number(b)) {
+            return Result::get(number_equals(b, a));
+        }
+        return (b.type == Value::Null) ? Result::False : Result::Invalid;
+    default:
+        return Result::Invalid;
+    }
+}
+
+// Mirrors the operator< overloads of the Value subclasses
+const Result&
+less(const Scalar& a, const Scalar& b) noexcept
+{
+    switch (a.type) {
+    case Value::String:
+        if (b.type == Value::String) {
+            return Result::get(a.string_value < b.string_value);
+        }
+        return Result::Invalid;
+    case Value::Integer:
+    case Value::Float:
+        if (is_number(b)) {
+            return Result::get(number_greater(b, a));
+        }
+        return Result::Invalid;
+    default:
+        return Result::Invalid;
+    }
+}
+
+enum class CompareOp : uint8_t { EQ, NE, LT, LEQ, GT, GEQ, REGEX, GLOB };
+
+bool
+to_compare_op(const Operator& op, CompareOp& result) noexcept
+{
+    if (op == FunctionOperator::EQ) {
+        result = CompareOp::EQ;
+    } else if (op == FunctionOperator::NE) {
+        result = CompareOp::NE;
+    } else if (op == FunctionOperator::LT) {
+        result = CompareOp::LT;
+    } else if (op == FunctionOperator::LEQ) {
+        result = CompareOp::LEQ;
+    } else if (op == FunctionOperator::GT) {
+        result = CompareOp::GT;
+    } else if (op == FunctionOperator::GEQ) {
+        result = CompareOp::GEQ;
+    } else if (op == GlobOperator::GLOB) {
+        result = CompareOp::GLOB;
+    } else if (op == RegexOperator::REGEX) {
+        result = CompareOp::REGEX;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * A simple document field, resolved against the type of the documents being
+ * evaluated. Fields of other types than the primitive ones are left to the tree.
+ */
+struct FieldOperand {
+    enum class State : uint8_t { INVALID, NULL_VALUE, TYPED, GENERIC };
+
+    const FieldValueNode&       node;
+    State                       state;
+    const Field*                field;
+    std::unique_ptr<FieldValue> value;
+
+    explicit FieldOperand(const FieldValueNode& node_in) noexcept
+        : node(node_in), state(State::GENERIC), field(nullptr), value()
+    {}
+
+    void resolve(const DocumentType& type) {
+        field = nullptr;
+        value.reset();
+        const vespalib::string& name = node.getFieldName();
+        if (type.getName() != node.getDocType()) {
+            state = State::INVALID;
+        } else if (type.has_imported_field_name(name)) {
+            // Same as FieldValueNode, imported fields are treated as valid fields without values
+            state = State::NULL_VALUE;
+        } else if (!type.hasField(name)) {
+            state = State::GENERIC;
+        } else {
+            field = &type.getField(name);
+            value = field->createValue();
+            switch (value->type()) {
+            case FieldValue::Type::BOOL:
+            case FieldValue::Type::BYTE:
+            case FieldValue::Type::INT:
+            case FieldValue::Type::LONG:
+            case FieldValue::Type::FLOAT:
+            case FieldValue::Type::DOUBLE:
+            case FieldValue::Type::STRING:
+                state = State::TYPED;
+                break;
+            default:
+                state = State::GENERIC;
+                field = nullptr;
+                value.reset();
+            }
+        }
+    }
+
+    // Returns false if the value must be fetched through the tree.
+    bool load(const Document& doc, Scalar& result) const {
+        switch (state) {
+        case State::INVALID:
+            result.type = Value::Invalid;
+            return true;
+        case State::NULL_VALUE:
+            result.type = Value::Null;
+            return true;
+        case State::GENERIC:
+            return false;
+        case State::TYPED:
+            break;
+        }
+        if (!doc.getValue(*field, *value)) {
+            result.type = Value::Null;
+            return true;
+        }
+        // Same conversions as FieldValueNode
+        switch (value->type()) {
+        case FieldValue::Type::BOOL:
+        case FieldValue::Type::INT:
+            result.type = Value::Integer;
+            result.int_value = value->getAsInt();
+            break;
+        case FieldValue::Type::BYTE:
+            result.type = Value::Integer;
+            result.int_value = value->getAsByte();
+            break;
+        case FieldValue::Type::LONG:
+            result.type = Value::Integer;
+            result.int_value = value->getAsLong();
+            break;
+        case FieldValue::Type::FLOAT:
+            result.type = Value::Float;
+            result.float_value = value->getAsFloat();
+            break;
+        case FieldValue::Type::DOUBLE:
+            result.type = Value::Float;
+            result.float_value = value->getAsDouble();
+            break;
+        default:
+            result.type = Value::String;
+            result.string_value = static_cast<const StringFieldValue&>(*value).getValueRef();
+        }
+        return true;
+    }
+};
+
+struct Operand {
+    enum class Kind : uint8_t { LITERAL, NOW, ID, FIELD, TYPED_NODE };
+
+    Kind                  kind = Kind::LITERAL;
+    Scalar                literal;
+    vespalib::string      literal_string;
+    const ValueNode*      node = nullptr;
+    IdValueNode::Type     id_type = IdValueNode::ALL;
+    FieldOperand*         field = nullptr;
+    const TypedValueNode* typed_node = nullptr;
+
+    void set_literal(const Value& value) {
+        literal.type = value.getType();
+        switch (value.getType()) {
+        case Value::Integer:
+            literal.int_value = static_cast<const IntegerValue&>(value).getValue();
+            break;
+        case Value::Float:
+            literal.float_value = static_cast<const FloatValue&>(value).getValue();
+            break;
+        case Value::String:
+            literal_string = static_cast<const StringValue&>(value).getValue();
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Returns false if the value must be fetched through the tree.
+    bool load(const Context& context, Scalar& result) const {
+        switch (kind) {
+        case Kind::LITERAL:
+            result = literal;
+            if (literal.type == Value::String) {
+                result.string_value = literal_string;
+            }
+            return true;
+        case Kind::NOW:
+            result.type = Value::Integer;
+            result.int_value = static_cast<const CurrentTimeValueNode&>(*node).getValue();
+            return true;
+        case Kind::ID:
+            return load_id(context, result);
+        case Kind::FIELD:
+            if (context._doc == nullptr) {
+                result.type = Value::Invalid;
+                return true;
+            }
+            return field->load(*context._doc, result);
+        case Kind::TYPED_NODE:
+            return typed_node->load_typed_value(context, result);
+        }
+        return false;
+    }
+
+    // Mirrors IdValueNode::getValue(), without building strings
+    bool load_id(const Context& context, Scalar& result) const {
+        const DocumentId* id = nullptr;
+        if (context._doc != nullptr) {
+            id = &context._doc->getId();
+        } else if (context._docId != nullptr) {
+            id = context._docId;
+        } else if (context._docUpdate != nullptr) {
+            id = &context._docUpdate->getId();
+        } else {
+            return false;
+        }
+        const IdString& scheme = id->getScheme();
+        result.type = Value::String;
+        switch (id_type) {
+        case IdValueNode::SCHEME:
+            result.string_value = "id";
+            break;
+        case IdValueNode::NS:
+            result.string_value = scheme.getNamespace();
+            break;
+        case IdValueNode::TYPE:
+            if (scheme.hasDocType()) {
+                result.string_value = scheme.getDocType();
+            } else {
+                result.type = Value::Invalid;
+            }
+            break;
+        case IdValueNode::SPEC:
+            result.string_value = scheme.getNamespaceSpecific();
+            break;
+        case IdValueNode::ALL:
+            result.string_value = scheme.toString();
+            break;
+        case IdValueNode::GROUP:
+            if (scheme.hasGroup()) {
+                result.string_value = scheme.getGroup();
+            } else {
+                result.type = Value::Invalid;
+            }
+            break;
+        case IdValueNode::USER:
+            if (scheme.hasNumber()) {
+                result.type = Value::Integer;
+                result.int_value = scheme.getNumber();
+            } else {
+                result.type = Value::Invalid;
+            }
+            break;
+        default:
+            return false;
+        }
+        return true;
+    }
+};
+
+bool
+is_simple_field_expression(vespalib::stringref expr) noexcept
+{
+    for (char c : expr) {
+        if (!(isalnum(static_cast<unsigned char>(c)) || (c == '_'))) {
+            return false;
+        }
+    }
+    return !expr.empty();
+}
+
+/**
+ * Classifies a value node as an operand the program can load by itself.
+ */
+struct OperandClassifier : TraversingVisitor {
+    Operand& operand;
+    bool     supported;
+
+    explicit OperandClassifier(Operand& operand_in) noexcept
+        : operand(operand_in), supported(false)
+    {}
+
+    void literal(const ValueNode& node) {
+        // Literals do not depend on the context. Bucket literals get the special
+        // treatment of Compare and are left to the tree.
+        auto value = node.getValue(Context());
+        if (value->getType() != Value::Bucket) {
+            operand.kind = Operand::Kind::LITERAL;
+            operand.set_literal(*value);
+            supported = true;
+        }
+    }
+
+    void visitArithmeticValueNode(const ArithmeticValueNode&) override {}
+    void visitFunctionValueNode(const FunctionValueNode&) override {}
+    void visitVariableValueNode(const VariableValueNode&) override {}
+    void visitFloatValueNode(const FloatValueNode& node) override { literal(node); }
+    void visitIntegerValueNode(const IntegerValueNode& node) override { literal(node); }
+    void visitBoolValueNode(const BoolValueNode& node) override { literal(node); }
+    void visitStringValueNode(const StringValueNode& node) override { literal(node); }
+    void visitNullValueNode(const NullValueNode& node) override { literal(node); }
+    void visitInvalidValueNode(const InvalidValueNode& node) override { literal(node); }
+
+    void visitCurrentTimeValueNode(const CurrentTimeValueNode& node) override {
+        operand.kind = Operand::Kind::NOW;
+        operand.node = &node;
+        supported = true;
+    }
+
+    void visitIdValueNode(const IdValueNode& node) override {
+        if ((node.getType() == IdValueNode::BUCKET) || (node.getType() == IdValueNode::GID)) {
+            return;
+        }
+        operand.kind = Operand::Kind::ID;
+        operand.id_type = node.getType();
+        supported = true;
+    }
+
+    void visitFieldValueNode(const FieldValueNode& node) override {
+        if (typeid(node) != typeid(FieldValueNode)) {
+            // Subclasses (e.g. attribute backed fields in proton) have their own value semantics,
+            // and are only compiled if they can load their values themselves.
+            operand.typed_node = dynamic_cast<const TypedValueNode*>(&node);
+            if (operand.typed_node != nullptr) {
+                operand.kind = Operand::Kind::TYPED_NODE;
+                operand.node = &node;
+                supported = true;
+            }
+            return;
+        }
+        if (!is_simple_field_expression(node.getFieldName())) {
+            return;
+        }
+        operand.kind = Operand::Kind::FIELD;
+        operand.node = &node;
+        supported = true;
+    }
+};
+
+/**
+ * Variable bindings are tracked per ResultList entry and combined across
+ * branches; outcome sets cannot represent them.
+ */
+struct VariableDetector : TraversingVisitor {
+    bool found = false;
+
+    void visitVariableValueNode(const VariableValueNode&) override { found = true; }
+    void visitFieldValueNode(const FieldValueNode& node) override {
+        if (node.getFieldName().find('$') != vespalib::string::npos) {
+            found = true;
+        }
+    }
+};
+
+struct Comparison {
+    const Compare&  node;
+    CompareOp       op;
+    Operand         left;
+    Operand         right;
+    bool            has_pattern;
+    bool            match_all;
+    vespalib::Regex pattern;
+
+    Comparison(const Compare& node_in, CompareOp op_in) noexcept
+        : node(node_in), op(op_in), left(), right(), has_pattern(false), match_all(false), pattern()
+    {}
+
+    // Regex and glob patterns given as literals are compiled once
+    void prepare_pattern() {
+        if (((op != CompareOp::REGEX) && (op != CompareOp::GLOB)) ||
+            (right.kind != Operand::Kind::LITERAL) || (right.literal.type != Value::String))
+        {
+            return;
+        }
+        vespalib::string expr = (op == CompareOp::GLOB)
+                ? GlobOperator::convertToRegex(right.literal_string)
+                : right.literal_string;
+        has_pattern = true;
+        match_all = expr.empty();
+        if (!match_all) {
+            pattern = vespalib::Regex::from_pattern(std::string_view(expr.data(), expr.size()));
+        }
+    }
+
+    // Same as RegexOperator::match()
+    const Result& match(vespalib::stringref value, vespalib::stringref expr) const {
+        std::string_view input(value.data(), value.size());
+        if (has_pattern) {
+            return match_all ? Result::True : Result::get(pattern.partial_match(input));
+        }
+        if (expr.empty()) {
+            return Result::True;
+        }
+        return Result::get(vespalib::Regex::partial_match(input, std::string_view(expr.data(), expr.size())));
+    }
+
+    const Result& evaluate(const Scalar& a, const Scalar& b) const {
+        switch (op) {
+        case CompareOp::EQ:
+            return equals(a, b);
+        case CompareOp::NE:
+            return !equals(a, b);
+        case CompareOp::LT:
+            return less(a, b);
+        case CompareOp::GT:
+            if (a.type == Value::Null) {
+                return Result::Invalid;
+            }
+            return !less(a, b) && !equals(a, b);
+        case CompareOp::GEQ:
+            if (a.type == Value::Null) {
+                return Result::Invalid;
+            }
+            return !less(a, b);
+        case CompareOp::LEQ:
+            if (a.type == Value::Null) {
+                return Result::Invalid;
+            }
+            return less(a, b) || equals(a, b);
+        case CompareOp::REGEX:
+            if ((a.type != Value::String) || (b.type != Value::String)) {
+                return Result::Invalid;
+            }
+            return match(a.string_value, b.string_value);
+        case CompareOp::GLOB:
+            if (b.type != Value::String) {
+                return equals(a, b);
+            }
+            if (a.type != Value::String) {
+                return Result::Invalid;
+            }
+            if (has_pattern) {
+                return match(a.string_value, b.string_value);
+            }
+            return match(a.string_value, GlobOperator::convertToRegex(b.string_value));
+        }
+        return Result::Invalid;
+    }
+};
+
+}
+
+class CompiledSelection::Program {
+public:
+    enum class OpCode : uint8_t { PUSH, DOCTYPE, COMPARE, FALLBACK, AND, OR, NOT, AND_JUMP, OR_JUMP };
+
+    struct Instruction {
+        OpCode   op;
+        // For jumps: whether the skipped operand compares document fields
+        bool     depends_on_fields;
+        // Outcomes to push, index of the leaf, or number of instructions to skip
+        uint32_t arg;
+    };
+
+    class Compiler;
+
+    std::vector<Instruction>                   code;
+    std::vector<vespalib::string>              doc_types;
+    std::vector<std::unique_ptr<Comparison>>   comparisons;
+    std::vector<const Node*>                   fallbacks;
+    std::vector<std::unique_ptr<FieldOperand>> fields;
+    uint32_t                                   max_stack_depth;
+    mutable const DocumentType*                resolved_type;
+    mutable bool                               fields_typed;
+    mutable std::vector<Outcomes>              stack;
+
+    Program() noexcept
+        : code(), doc_types(), comparisons(), fallbacks(), fields(), max_stack_depth(0),
+          resolved_type(nullptr), fields_typed(true), stack()
+    {}
+
+    Outcomes doc_type(uint32_t idx, const Context& context) const;
+    Outcomes compare(const Comparison& comparison, const Context& context) const;
+    bool prepare_fields(const Context& context) const;
+    const Result& evaluate(const Context& context) const;
+};
+
+/**
+ * Lowers a selection tree to postfix code. Each subtree becomes a fragment that
+ * leaves the outcome set of the subtree on the stack.
+ */
+class CompiledSelection::Program::Compiler : public TraversingVisitor {
+    struct Fragment {
+        std::vector<Instruction> code;
+        // Fallback subtrees may produce empty result lists, which must not be short-circuited.
+        bool may_be_empty = false;
+        bool depends_on_fields = false;
+        uint32_t stack_depth = 0;
+    };
+
+    Program& _program;
+    Fragment _fragment;
+
+    Fragment compile(const Node& node) {
+        _fragment = Fragment();
+        node.visit(*this);
+        if (_fragment.code.empty()) {
+            fallback(node);
+        }
+        return std::move(_fragment);
+    }
+
+    void leaf(OpCode op, uint32_t arg) {
+        _fragment = Fragment();
+        _fragment.code.push_back(Instruction{op, false, arg});
+        _fragment.stack_depth = 1;
+    }
+
+    void fallback(const Node& node) {
+        leaf(OpCode::FALLBACK, _program.fallbacks.size());
+        _program.fallbacks.push_back(&node);
+        _fragment.may_be_empty = true;
+    }
+
+    // An empty right hand side annihilates the result, so the left hand side may only
+    // decide the outcome alone if the right hand side always produces some outcome.
+    void binary(const Node& left_node, const Node& right_node, OpCode op, OpCode jump) {
+        Fragment left = compile(left_node);
+        Fragment right = compile(right_node);
+        Fragment result;
+        result.code = std::move(left.code);
+        if (!right.may_be_empty) {
+            result.code.push_back(Instruction{jump, right.depends_on_fields, uint32_t(right.code.size() + 1)});
+        }
+        result.code.insert(result.code.end(), right.code.begin(), right.code.end());
+        result.code.push_back(Instruction{op, false, 0});
+        result.may_be_empty = left.may_be_empty || right.may_be_empty;
+        result.depends_on_fields = left.depends_on_fields || right.depends_on_fields;
+        result.stack_depth = std::max(left.stack_depth, right.stack_depth + 1);
+        _fragment = std::move(result);
+    }
+
+    bool operand(const ValueNode& node, Operand& result) {
+        OperandClassifier classifier(result);
+        node.visit(classifier);
+        if (!classifier.supported) {
+            return false;
+        }
+        if (result.kind == Operand::Kind::FIELD) {
+            _program.fields.push_back(std::make_unique<FieldOperand>(static_cast<const FieldValueNode&>(*result.node)));
+            result.field = _program.fields.back().get();
+        }
+        return true;
+    }
+
+public:
+    explicit Compiler(Program& program) noexcept
+        : _program(program), _fragment()
+    {}
+
+    void compile_root(const Node& root) {
+        VariableDetector variables;
+        root.visit(variables);
+        if (variables.found) {
+            fallback(root);
+        } else {
+            _fragment = compile(root);
+        }
+        _program.code = std::move(_fragment.code);
+        _program.max_stack_depth = _fragment.stack_depth;
+    }
+
+    void visitAndBranch(const And& expr) override {
+        binary(expr.getLeft(), expr.getRight(), OpCode::AND, OpCode::AND_JUMP);
+    }
+
+    void visitOrBranch(const Or& expr) override {
+        binary(expr.getLeft(), expr.getRight(), OpCode::OR, OpCode::OR_JUMP);
+    }
+
+    void visitNotBranch(const Not& expr) override {
+        Fragment child = compile(expr.getChild());
+        child.code.push_back(Instruction{OpCode::NOT, false, 0});
+        _fragment = std::move(child);
+    }
+
+    void visitConstant(const Constant& node) override {
+        leaf(OpCode::PUSH, bit(Result::get(node.getConstantValue())));
+    }
+
+    void visitInvalidConstant(const InvalidConstant&) override {
+        leaf(OpCode::PUSH, INVALID_BIT);
+    }
+
+    void visitDocumentType(const DocType& node) override {
+        leaf(OpCode::DOCTYPE, _program.doc_types.size());
+        _program.doc_types.push_back(node.getDocType());
+    }
+
+    void visitComparison(const Compare& node) override {
+        CompareOp op;
+        if (!to_compare_op(node.getOperator(), op)) {
+            fallback(node);
+            return;
+        }
+        auto comparison = std::make_unique<Comparison>(node, op);
+        size_t num_fields = _program.fields.size();
+        if (!operand(node.getLeft(), comparison->left) || !operand(node.getRight(), comparison->right)) {
+            _program.fields.resize(num_fields);
+            fallback(node);
+            return;
+        }
+        comparison->prepare_pattern();
+        leaf(OpCode::COMPARE, _program.comparisons.size());
+        _fragment.depends_on_fields = (_program.fields.size() != num_fields);
+        _program.comparisons.push_back(std::move(comparison));
+    }
+};
+
+Outcomes
+CompiledSelection::Program::doc_type(uint32_t idx, const Context& context) const
+{
+    // Same as DocType::contains()
+    const vespalib::string& name = doc_types[idx];
+    if (context._doc != nullptr) {
+        return bit(Result::get(context._doc->getType().getName() == name));
+    }
+    if (context._docId != nullptr) {
+        return bit(Result::get(context._docId->getDocType() == name));
+    }
+    return bit(Result::get(context._docUpdate->getType().getName() == name));
+}
+
+Outcomes
+CompiledSelection::Program::compare(const Comparison& comparison, const Context& context) const
+{
+    Scalar left;
+    Scalar right;
+    if (!comparison.left.load(context, left) || !comparison.right.load(context, right)) {
+        return outcomes_of(comparison.node.contains(context));
+    }
+    return bit(comparison.evaluate(left, right));
+}
+
+/**
+ * Resolves field operands when the document type changes. Returns whether all
+ * comparisons are typed for this context, in which case none of them can
+ * produce an empty outcome set.
+ */
+bool
+CompiledSelection::Program::prepare_fields(const Context& context) const
+{
+    if (fields.empty() || (context._doc == nullptr)) {
+        return true;
+    }
+    const DocumentType* type = &context._doc->getType();
+    if (type != resolved_type) {
+        fields_typed = true;
+        for (const auto& field : fields) {
+            field->resolve(*type);
+            fields_typed = fields_typed && (field->state != FieldOperand::State::GENERIC);
+        }
+        resolved_type = type;
+    }
+    return fields_typed;
+}
+
+const Result&
+CompiledSelection::Program::evaluate(const Context& context) const
+{
+    const bool typed = prepare_fields(context);
+    Outcomes* sp = stack.data();
+    const Instruction* pc = code.data();
+    const Instruction* end = pc + code.size();
+    for (; pc < end; ++pc) {
+        switch (pc->op) {
+        case OpCode::PUSH:
+            *sp++ = Outcomes(pc->arg);
+            break;
+        case OpCode::DOCTYPE:
+            *sp++ = doc_type(pc->arg, context);
+            break;
+        case OpCode::COMPARE:
+            *sp++ = compare(*comparisons[pc->arg], context);
+            break;
+        case OpCode::FALLBACK:
+            *sp++ = outcomes_of(fallbacks[pc->arg]->contains(context));
+            break;
+        case OpCode::AND:
+            --sp;
+            sp[-1] = and_table()[sp[-1]][sp[0]];
+            break;
+        case OpCode::OR:
+            --sp;
+            sp[-1] = or_table()[sp[-1]][sp[0]];
+            break;
+        case OpCode::NOT:
+            sp[-1] = negate(sp[-1]);
+            break;
+        case OpCode::AND_JUMP:
+            if ((sp[-1] == FALSE_BIT) && (typed || !pc->depends_on_fields)) {
+                pc += pc->arg;
+            }
+            break;
+        case OpCode::OR_JUMP:
+            if ((sp[-1] == TRUE_BIT) && (typed || !pc->depends_on_fields)) {
+                pc += pc->arg;
+            }
+            break;
+        }
+    }
+    assert(sp == stack.data() + 1);
+    return combine(stack[0]);
+}
+
+CompiledSelection::CompiledSelection(const Node& root)
+    : _program(std::make_unique<Program>())
+{
+    Program::Compiler compiler(*_program);
+    compiler.compile_root(root);
+    _program->stack.resize(_program->max_stack_depth);
+}
+
+CompiledSelection::~CompiledSelection() = default;
+
+const Result&
+CompiledSelection::evaluate(const Context& context) const
+{
+    return _program->evaluate(context);
+}
+
+uint32_t
+CompiledSelection::fallback_count() const noexcept
+{
+    return _program->fallbacks.size();
+}
+
+}
@@ -0,0 +1,75 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+/**
+ * @class document::select::CompiledSelection
+ * @ingroup select
+ *
+ * @brief A document selection lowered to a flat program.
+ *
+ * Evaluating a selection tree through Node::contains() allocates a Value for
+ * each side of every comparison and a ResultList for every node. When the same
+ * selection is matched against a large number of documents (visiting, garbage
+ * collection, streaming search) that overhead dominates.
+ *
+ * The program evaluates the boolean structure of the selection over small
+ * outcome sets, and comparisons between literals, document id components and
+ * simple primitive fields with typed compares directly against the document.
+ * Value nodes implementing TypedValueNode (e.g. attribute backed fields in
+ * proton) are compared the same way through the value they load from the
+ * context. Any other subtree is evaluated through the selection tree. The result is
+ * always the same as root.contains(context).combineResults().
+ *
+ * The program refers to the tree it was compiled from, which must outlive it.
+ * Like the tree, it caches field lookups and must only be used by one thread at
+ * a time.
+ */
+#pragma once
+
+#include "result.h"
+#include "value.h"
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+
+namespace document::select {
+
+class Context;
+class Node;
+
+/**
+ * A single integer, float or string value (or null/invalid) as seen by the
+ * comparison operators. String values refer to memory owned by the source.
+ */
+struct TypedValue {
+    Value::Type         type = Value::Invalid;
+    int64_t             int_value = 0;
+    double              float_value = 0.0;
+    vespalib::stringref string_value;
+};
+
+/**
+ * Implemented by value nodes that can produce their value without creating a
+ * Value object. The loaded value must compare the same as getValue(context).
+ */
+class TypedValueNode {
+public:
+    virtual ~TypedValueNode() = default;
+    // Returns false if the value must be fetched through the tree.
+    virtual bool load_typed_value(const Context& context, TypedValue& result) const = 0;
+};
+
+class CompiledSelection {
+public:
+    explicit CompiledSelection(const Node& root);
+    CompiledSelection(const CompiledSelection&) = delete;
+    CompiledSelection& operator=(const CompiledSelection&) = delete;
+    ~CompiledSelection();
+
+    const Result& evaluate(const Context& context) const;
+
+    /** Number of subtrees that are evaluated through the selection tree. */
+    uint32_t fallback_count() const noexcept;
+private:
+    class Program;
+    std::unique_ptr<Program> _program;
+};
+
+}
@@ -26,6 +26,7 @@ public:
     ResultList trace(const Context&, std::ostream& trace) const override;
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
     void visit(Visitor& v) const override;
+    const vespalib::string& getDocType() const noexcept { return _doctype; }
 
     Node::UP clone() const override { return wrapParens(new DocType(_doctype)); }
 
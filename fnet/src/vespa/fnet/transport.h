@@ -84,6 +84,15 @@ public:
         _config._drop_empty_buffers = v;
         return *this;
     }
+    // wait for I/O events using io_uring instead of epoll when the
+    // kernel supports it; transport threads fall back to epoll
+    // otherwise. This only replaces readiness polling; socket reads
+    // and writes are still plain read/write calls done by the
+    // connections (and their crypto sockets), one per operation.
+    TransportConfig &io_uring(bool v) {
+        _config._io_uring = v;
+        return *this;
+    }
 
 private:
     FNET_Config                 _config;
@@ -241,7 +241,7 @@ FNET_TransportThread::FNET_TransportThread(FNET_Transport &owner_in)
       _componentsTail(nullptr),
       _componentCnt(0),
       _deleteList(nullptr),
-      _selector(),
+      _selector(owner_in.getConfig()._io_uring ? vespalib::SelectorBackend::IO_URING : vespalib::SelectorBackend::EPOLL),
       _queue(),
       _myQueue(),
       _lock(),
@@ -254,6 +254,9 @@ FNET_TransportThread::FNET_TransportThread(FNET_Transport &owner_in)
       _detaching()
 {
     trapsigpipe();
+    if (owner_in.getConfig()._io_uring && !_selector.using_io_uring()) {
+        LOG(info, "Transport: io_uring not available, using epoll");
+    }
 }
 
 
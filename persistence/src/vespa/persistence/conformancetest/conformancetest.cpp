@@ -989,6 +989,69 @@ TEST_F(ConformanceTest, testUpdate)
     }
 }
 
+TEST_F(ConformanceTest, test_feed_batch)
+{
+    document::TestDocMan testDocMan;
+    _factory->clear();
+    PersistenceProviderUP spi(getSpi(*_factory, testDocMan));
+    Document::SP doc1 = testDocMan.createRandomDocumentAtLocation(0x01, 1);
+    Document::SP doc2 = testDocMan.createRandomDocumentAtLocation(0x01, 2);
+    DocumentId removeId("id:fraggle:testdoctype1:n=1:rock");
+    Context context(Priority(0), Trace::TraceLevel(0));
+
+    Bucket bucket(makeSpiBucket(BucketId(8, 0x01)));
+    spi->createBucket(bucket);
+
+    const document::DocumentType *docType(testDocMan.getTypeRepo().getDocumentType("testdoctype1"));
+    auto update = std::make_shared<DocumentUpdate>(testDocMan.getTypeRepo(), *docType, doc1->getId());
+    update->addUpdate(FieldUpdate(docType->getField("headerval")).addUpdate(std::make_unique<AssignValueUpdate>(std::make_unique<IntFieldValue>(42))));
+
+    std::vector<std::future<std::unique_ptr<Result>>> futures;
+    auto catcher = [&futures]() {
+        auto catch_result = std::make_unique<CatchResult>();
+        futures.push_back(catch_result->future_result());
+        return catch_result;
+    };
+    FeedBatch batch;
+    batch.add_put(Timestamp(3), doc1, catcher());
+    batch.add_put(Timestamp(4), doc2, catcher());
+    batch.add_update(Timestamp(5), update, catcher());
+    batch.add_remove(Timestamp(6), doc2->getId(), catcher());
+    batch.add_remove(Timestamp(7), removeId, catcher());
+    spi->feedBatchAsync(bucket, std::move(batch));
+    std::vector<std::unique_ptr<Result>> results;
+    for (auto &future : futures) {
+        results.push_back(future.get());
+    }
+    ASSERT_EQ(5u, results.size());
+    EXPECT_EQ(Result(), *results[0]);
+    EXPECT_EQ(Result(), *results[1]);
+    auto &update_result = dynamic_cast<const UpdateResult &>(*results[2]);
+    EXPECT_EQ(Result::ErrorType::NONE, update_result.getErrorCode());
+    EXPECT_EQ(Timestamp(3), update_result.getExistingTimestamp());
+    auto &remove_result = dynamic_cast<const RemoveResult &>(*results[3]);
+    EXPECT_EQ(Result::ErrorType::NONE, remove_result.getErrorCode());
+    EXPECT_TRUE(remove_result.wasFound());
+    auto &missing_remove_result = dynamic_cast<const RemoveResult &>(*results[4]);
+    EXPECT_EQ(Result::ErrorType::NONE, missing_remove_result.getErrorCode());
+    EXPECT_FALSE(missing_remove_result.wasFound());
+
+    {
+        GetResult result = spi->get(bucket, document::AllFields(), doc1->getId(), context);
+        EXPECT_EQ(Result::ErrorType::NONE, result.getErrorCode());
+        EXPECT_EQ(Timestamp(5), result.getTimestamp());
+        EXPECT_FALSE(result.is_tombstone());
+        EXPECT_EQ(IntFieldValue(42), static_cast<IntFieldValue&>(*result.getDocument().getValue("headerval")));
+    }
+    {
+        GetResult result = spi->get(bucket, document::AllFields(), doc2->getId(), context);
+        EXPECT_EQ(Result::ErrorType::NONE, result.getErrorCode());
+        EXPECT_EQ(Timestamp(6), result.getTimestamp());
+        EXPECT_FALSE(result.hasDocument());
+        EXPECT_TRUE(result.is_tombstone());
+    }
+}
+
 TEST_F(ConformanceTest, testGet)
 {
     document::TestDocMan testDocMan;
@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "dummypersistence.h"
+#include <vespa/document/select/compiled_selection.h>
 #include <vespa/document/select/parser.h>
 #include <vespa/document/base/documentid.h>
 #include <vespa/document/fieldvalue/document.h>
@@ -577,6 +578,10 @@ DummyPersistence::createIterator(const Bucket &b, FieldSetSP fs, const Selection
     it->_fieldSet = std::move(fs);
     const BucketContent::GidMapType& gidMap((*bc)->_gidMap);
 
+    std::unique_ptr<document::select::CompiledSelection> compiledSelection;
+    if (docSelection) {
+        compiledSelection = std::make_unique<document::select::CompiledSelection>(*docSelection);
+    }
     if (s.getTimestampSubset().empty()) {
         using reverse_iterator = std::vector<BucketEntry>::const_reverse_iterator;
         for (reverse_iterator entryIter((*bc)->_entries.rbegin()),
@@ -596,8 +601,8 @@ DummyPersistence::createIterator(const Bucket &b, FieldSetSP fs, const Selection
                 if (v == NEWEST_DOCUMENT_ONLY) {
                     continue;
                 }
-                if (docSelection.get()
-                    && (docSelection->contains(*entry.getDocumentId())
+                if (compiledSelection
+                    && (compiledSelection->evaluate(*entry.getDocumentId())
                         != document::select::Result::True))
                 {
                     continue;
@@ -610,8 +615,8 @@ DummyPersistence::createIterator(const Bucket &b, FieldSetSP fs, const Selection
                     // points to a remove instead.
                     continue;
                 }
-                if (docSelection.get()
-                    && (docSelection->contains(*entry.getDocument())
+                if (compiledSelection
+                    && (compiledSelection->evaluate(*entry.getDocument())
                         != document::select::Result::True))
                 {
                     continue;
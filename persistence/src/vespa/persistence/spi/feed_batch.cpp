@@ -0,0 +1,62 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "feed_batch.h"
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/update/documentupdate.h>
+
+namespace storage::spi {
+
+FeedBatch::Entry::Entry(Type type_, Timestamp timestamp_, DocumentSP doc_, DocumentUpdateSP update_,
+                        document::DocumentId remove_id_, OperationComplete::UP on_complete_) noexcept
+    : type(type_),
+      timestamp(timestamp_),
+      doc(std::move(doc_)),
+      update(std::move(update_)),
+      remove_id(std::move(remove_id_)),
+      on_complete(std::move(on_complete_))
+{
+}
+
+FeedBatch::Entry::Entry(Entry&&) noexcept = default;
+FeedBatch::Entry& FeedBatch::Entry::operator=(Entry&&) noexcept = default;
+FeedBatch::Entry::~Entry() = default;
+
+const document::DocumentId&
+FeedBatch::Entry::document_id() const noexcept
+{
+    switch (type) {
+    case Type::PUT:
+        return doc->getId();
+    case Type::UPDATE:
+        return update->getId();
+    default:
+        return remove_id;
+    }
+}
+
+FeedBatch::FeedBatch() = default;
+FeedBatch::FeedBatch(FeedBatch&&) noexcept = default;
+FeedBatch& FeedBatch::operator=(FeedBatch&&) noexcept = default;
+FeedBatch::~FeedBatch() = default;
+
+void
+FeedBatch::add_put(Timestamp timestamp, DocumentSP doc, OperationComplete::UP on_complete)
+{
+    _entries.emplace_back(Type::PUT, timestamp, std::move(doc), DocumentUpdateSP(), document::DocumentId(),
+                          std::move(on_complete));
+}
+
+void
+FeedBatch::add_remove(Timestamp timestamp, const document::DocumentId& id, OperationComplete::UP on_complete)
+{
+    _entries.emplace_back(Type::REMOVE, timestamp, DocumentSP(), DocumentUpdateSP(), id, std::move(on_complete));
+}
+
+void
+FeedBatch::add_update(Timestamp timestamp, DocumentUpdateSP update, OperationComplete::UP on_complete)
+{
+    _entries.emplace_back(Type::UPDATE, timestamp, DocumentSP(), std::move(update), document::DocumentId(),
+                          std::move(on_complete));
+}
+
+}
@@ -0,0 +1,58 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "operationcomplete.h"
+#include "types.h"
+#include <vespa/document/base/documentid.h>
+#include <vector>
+
+namespace storage::spi {
+
+/**
+ * A sequence of put, remove and update operations for the same bucket,
+ * handed to the persistence provider in one call (see
+ * PersistenceProvider::feedBatchAsync).
+ *
+ * Each entry has its own completion callback, which gets the same result
+ * as the corresponding single operation. Removes have removeIfFound
+ * semantics. The entries are applied in order, and all entries must have
+ * distinct timestamps.
+ */
+class FeedBatch {
+public:
+    enum class Type : uint8_t { PUT, REMOVE, UPDATE };
+
+    struct Entry {
+        Type                  type;
+        Timestamp             timestamp;
+        DocumentSP            doc;
+        DocumentUpdateSP      update;
+        document::DocumentId  remove_id;
+        OperationComplete::UP on_complete;
+
+        Entry(Type type_, Timestamp timestamp_, DocumentSP doc_, DocumentUpdateSP update_,
+              document::DocumentId remove_id_, OperationComplete::UP on_complete_) noexcept;
+        Entry(Entry&&) noexcept;
+        Entry& operator=(Entry&&) noexcept;
+        ~Entry();
+        const document::DocumentId& document_id() const noexcept;
+    };
+
+    FeedBatch();
+    FeedBatch(FeedBatch&&) noexcept;
+    FeedBatch& operator=(FeedBatch&&) noexcept;
+    ~FeedBatch();
+
+    void add_put(Timestamp timestamp, DocumentSP doc, OperationComplete::UP on_complete);
+    void add_remove(Timestamp timestamp, const document::DocumentId& id, OperationComplete::UP on_complete);
+    void add_update(Timestamp timestamp, DocumentUpdateSP update, OperationComplete::UP on_complete);
+
+    bool empty() const noexcept { return _entries.empty(); }
+    size_t size() const noexcept { return _entries.size(); }
+    std::vector<Entry>& entries() noexcept { return _entries; }
+    const std::vector<Entry>& entries() const noexcept { return _entries; }
+private:
+    std::vector<Entry> _entries;
+};
+
+}
@@ -66,4 +66,21 @@ PersistenceProvider::update(const Bucket& bucket, Timestamp timestamp, DocumentU
     return dynamic_cast<const UpdateResult &>(*future.get());
 }
 
+void
+PersistenceProvider::feedBatchAsync(const Bucket& bucket, FeedBatch batch) {
+    for (auto& entry : batch.entries()) {
+        switch (entry.type) {
+        case FeedBatch::Type::PUT:
+            putAsync(bucket, entry.timestamp, std::move(entry.doc), std::move(entry.on_complete));
+            break;
+        case FeedBatch::Type::REMOVE:
+            removeIfFoundAsync(bucket, entry.timestamp, entry.remove_id, std::move(entry.on_complete));
+            break;
+        case FeedBatch::Type::UPDATE:
+            updateAsync(bucket, entry.timestamp, std::move(entry.update), std::move(entry.on_complete));
+            break;
+        }
+    }
+}
+
 }
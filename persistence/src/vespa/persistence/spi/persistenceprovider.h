@@ -4,6 +4,7 @@
 #include "bucket.h"
 #include "bucketinfo.h"
 #include "context.h"
+#include "feed_batch.h"
 #include "id_and_timestamp.h"
 #include "result.h"
 #include "selection.h"
@@ -210,6 +211,16 @@ struct PersistenceProvider
      */
     virtual void updateAsync(const Bucket&, Timestamp timestamp, DocumentUpdateSP update, OperationComplete::UP) = 0;
 
+    /**
+     * Applies a batch of puts, removes (with removeIfFound semantics) and
+     * updates to the given bucket, in order. The completion callback of each
+     * entry gets the same result as the corresponding single operation.
+     * Providers can override this to amortize per operation overhead, the
+     * default implementation passes each entry on to putAsync,
+     * removeIfFoundAsync or updateAsync.
+     */
+    virtual void feedBatchAsync(const Bucket&, FeedBatch batch);
+
     /**
      * Retrieves the latest version of the document specified by the
      * document id. If no versions were found, or the document was removed,
@@ -227,6 +227,7 @@ App::usage()
         "[--rpc-network-threads threads]\n"
         "[--rpc-targets-per-node targets]\n"
         "[--skip-get-spi-bucket-info]\n"
+        "[--spi-feed-batch-size size]\n"
         "[--update-passes update-passes]\n"
         "[--use-async-message-handling]\n"
         "[--use-document-api]\n"
@@ -258,6 +259,7 @@ App::get_options(int argc, char **argv)
         { "rpc-network-threads", 1, nullptr, 0 },
         { "rpc-targets-per-node", 1, nullptr, 0 },
         { "skip-get-spi-bucket-info", 0, nullptr, 0 },
+        { "spi-feed-batch-size", 1, nullptr, 0 },
         { "update-passes", 1, nullptr, 0 },
         { "use-async-message-handling", 0, nullptr, 0 },
         { "use-document-api", 0, nullptr, 0 },
@@ -284,6 +286,7 @@ App::get_options(int argc, char **argv)
         LONGOPT_RPC_NETWORK_THREADS,
         LONGOPT_RPC_TARGETS_PER_NODE,
         LONGOPT_SKIP_GET_SPI_BUCKET_INFO,
+        LONGOPT_SPI_FEED_BATCH_SIZE,
         LONGOPT_UPDATE_PASSES,
         LONGOPT_USE_ASYNC_MESSAGE_HANDLING,
         LONGOPT_USE_DOCUMENT_API,
@@ -352,6 +355,9 @@ App::get_options(int argc, char **argv)
             case LONGOPT_SKIP_GET_SPI_BUCKET_INFO:
                 _bm_params.set_skip_get_spi_bucket_info(true);
                 break;
+            case LONGOPT_SPI_FEED_BATCH_SIZE:
+                _bm_params.set_spi_feed_batch_size(atoi(optarg));
+                break;
             case LONGOPT_USE_ASYNC_MESSAGE_HANDLING:
                 _bm_params.set_use_async_message_handling_on_schedule(true);
                 break;
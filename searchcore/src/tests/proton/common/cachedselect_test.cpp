@@ -9,6 +9,7 @@
 #include <vespa/document/repo/configbuilder.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/document/select/cloningvisitor.h>
+#include <vespa/document/select/compiled_selection.h>
 #include <vespa/document/select/parser.h>
 #include <vespa/searchcore/proton/common/cachedselect.h>
 #include <vespa/searchcore/proton/common/selectcontext.h>
@@ -40,6 +41,7 @@ using document::config_builder::Map;
 using document::config_builder::Struct;
 using document::config_builder::Wset;
 using document::select::CloningVisitor;
+using document::select::CompiledSelection;
 using document::select::Context;
 using document::select::Node;
 using document::select::Result;
@@ -638,7 +640,31 @@ TEST_F("Test performance when using attributes", TestFixture)
     LOG(info,
         "Elapsed time for %u iterations of 4 docs each: %" PRId64 " ns, %8.4f ns/doc",
         i, vespalib::count_ns(elapsed), static_cast<double>(vespalib::count_ns(elapsed)) / ( 4 * i));
-    
+
+    // Attribute fields are compared by the compiled program, not through the tree
+    CompiledSelection compiled(*sel);
+    EXPECT_EQUAL(0u, compiled.fallback_count());
+    LOG(info, "Starting compiled minibm loop, %u iterations of 4 docs each", loopcnt);
+    vespalib::Timer compiled_sw;
+    for (i = 0; i < loopcnt; ++i) {
+        ctx._docId = 1u;
+        if (compiled.evaluate(ctx) != Result::False)
+            break;
+        ctx._docId = 2u;
+        if (compiled.evaluate(ctx) != Result::True)
+            break;
+        ctx._docId = 3u;
+        if (compiled.evaluate(ctx) != Result::Invalid)
+            break;
+        ctx._docId = 4u;
+        if (compiled.evaluate(ctx) != Result::Invalid)
+            break;
+    }
+    elapsed = compiled_sw.elapsed();
+    EXPECT_EQUAL(loopcnt, i);
+    LOG(info,
+        "Elapsed time for %u compiled iterations of 4 docs each: %" PRId64 " ns, %8.4f ns/doc",
+        i, vespalib::count_ns(elapsed), static_cast<double>(vespalib::count_ns(elapsed)) / ( 4 * i));
 }
 
 
@@ -67,6 +67,7 @@
 #include <vespa/vespalib/geo/zcurve.h>
 #include <vespa/vespalib/util/destructor_callbacks.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/config-summary.h>
 #include <filesystem>
 #include <regex>
@@ -488,6 +489,25 @@ TEST_F("requireThatAdapterHandlesMultipleDocuments", Fixture)
     bc._str.flush(flushToken);
 }
 
+TEST_F("requireThatAdapterServesPrefetchedDocuments", Fixture)
+{
+    BuildContext bc([](auto& header) { header.addField("a", DataType::T_INT); });
+    for (uint32_t lid = 0; lid < 3; ++lid) {
+        auto doc = bc.make_document(vespalib::make_string("id:ns:searchdocument::%u", lid));
+        doc->setValue("a", IntFieldValue(1000 * (lid + 1)));
+        bc.put_document(lid, std::move(doc));
+    }
+
+    DocumentStoreAdapter dsa(bc._str, bc.get_repo());
+    dsa.prefetch({0, 2, 5});
+    EXPECT_EQUAL(3000, dsa.get_document(2)->get_field_value("a")->getAsInt());
+    EXPECT_EQUAL(1000, dsa.get_document(0)->get_field_value("a")->getAsInt());
+    EXPECT_EQUAL(2000, dsa.get_document(1)->get_field_value("a")->getAsInt());
+    EXPECT_TRUE(!dsa.get_document(5));
+    // A document is also found when requested again after being served from the prefetched set
+    EXPECT_EQUAL(3000, dsa.get_document(2)->get_field_value("a")->getAsInt());
+}
+
 TEST_F("requireThatAdapterHandlesDocumentIdField", Fixture)
 {
     BuildContext bc([](auto&) noexcept {});
@@ -394,10 +394,17 @@ FeedTokenContext::~FeedTokenContext() = default;
 struct MyTlsWriter : TlsWriter {
     int store_count;
     int erase_count;
+    int batch_count;
     bool erase_return;
+    bool batching;
 
-    MyTlsWriter() : store_count(0), erase_count(0), erase_return(true) {}
+    MyTlsWriter() : store_count(0), erase_count(0), batch_count(0), erase_return(true), batching(false) {}
     void appendOperation(const FeedOperation &, DoneCallback) override { ++store_count; }
+    void start_batch() override { batching = true; }
+    void flush_batch() override {
+        ++batch_count;
+        batching = false;
+    }
     CommitResult startCommit(DoneCallback) override { return CommitResult(); }
     bool erase(SerialNum) override { ++erase_count; return erase_return; }
 
@@ -747,6 +754,26 @@ TEST_F("require that put with different document type repo is ok", FeedHandlerFi
     EXPECT_EQUAL(1, f.tls_writer.store_count);
 }
 
+TEST_F("require that operations handled together are stored in one batch", FeedHandlerFixture)
+{
+    f.handler.changeToNormalFeedState();
+    DocumentContext doc_context1("id:ns:searchdocument::foo", f.schema.builder);
+    DocumentContext doc_context2("id:ns:searchdocument::bar", f.schema.builder);
+    FeedTokenContext token_context1;
+    FeedTokenContext token_context2;
+    FeedHandler::FeedOperations ops;
+    ops.emplace_back(std::move(token_context1.token),
+                     std::make_unique<PutOperation>(doc_context1.bucketId, Timestamp(10), std::move(doc_context1.doc)));
+    ops.emplace_back(std::move(token_context2.token),
+                     std::make_unique<PutOperation>(doc_context2.bucketId, Timestamp(11), std::move(doc_context2.doc)));
+    f.handler.handleOperations(std::move(ops));
+    f.syncMaster();
+    EXPECT_EQUAL(2, f.feedView.put_count);
+    EXPECT_EQUAL(2, f.tls_writer.store_count);
+    EXPECT_EQUAL(1, f.tls_writer.batch_count);
+    EXPECT_FALSE(f.tls_writer.batching);
+}
+
 TEST_F("require that feed stats are updated", FeedHandlerFixture)
 {
     DocumentContext doc_context("id:ns:searchdocument::foo", f.schema.builder);
@@ -10,6 +10,7 @@
 #include <vespa/searchcore/proton/test/bucketfactory.h>
 #include <vespa/searchcore/proton/common/feedtoken.h>
 #include <vespa/searchcore/proton/index/i_index_writer.h>
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
 #include <vespa/searchcore/proton/server/isummaryadapter.h>
 #include <vespa/searchcore/proton/server/matchview.h>
 #include <vespa/searchcore/proton/server/searchable_feed_view.h>
@@ -29,8 +30,12 @@
 #include <vespa/searchlib/test/doc_builder.h>
 #include <vespa/searchlib/test/schema_builder.h>
 #include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
 #include <vespa/vespalib/util/destructor_callbacks.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/stllike/asciistream.h>
+#include <vespa/vespalib/util/size_literals.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("feedview_test");
@@ -41,6 +46,7 @@ using document::Document;
 using document::DocumentId;
 using document::DocumentUpdate;
 using document::StringFieldValue;
+using proton::matching::QueryResultCache;
 using proton::matching::SessionManager;
 using proton::test::MockGidToLidChangeHandler;
 using search::AttributeVector;
@@ -1288,6 +1294,53 @@ TEST_F("require that move() notifies gid to lid change handler", SearchableFeedV
     TEST_DO(f.assertChangeHandler(dc2.gid(), 1u, 4u));
 }
 
+TEST_F("require that cached query results are not used after a fed document becomes visible", SearchableFeedViewFixture)
+{
+    QueryResultCache cache(1_Mi, 0);
+    search::engine::SearchRequest request;
+    request.stackDump = {'a', 'b', 'c'};
+    auto key = QueryResultCache::makeKey(request);
+    search::engine::SearchReply reply;
+    reply.totalHitCount = 0;
+    cache.insert(key, reply, f._dmsc->getVisibleSerialNum());
+    EXPECT_TRUE(cache.lookup(key, f._dmsc->getVisibleSerialNum()));
+
+    f.putAndWait(f.doc1());
+    // Not yet visible to search, the cached reply is still valid
+    EXPECT_TRUE(cache.lookup(key, f._dmsc->getVisibleSerialNum()));
+    f.forceCommitAndWait();
+    EXPECT_FALSE(cache.lookup(key, f._dmsc->getVisibleSerialNum()));
+}
+
+TEST_F("require that cached query results are used until the memory index commit is done", SearchableFeedViewFixture)
+{
+    QueryResultCache cache(1_Mi, 0);
+    search::engine::SearchRequest request;
+    request.stackDump = {'a', 'b', 'c'};
+    auto key = QueryResultCache::makeKey(request);
+    search::engine::SearchReply reply;
+    reply.totalHitCount = 0;
+    f.putAndWait(f.doc1());
+    cache.insert(key, reply, f._dmsc->getVisibleSerialNum());
+
+    Gate index_blocked;
+    Gate commit_done;
+    f._writeService.index().execute(vespalib::makeLambdaTask([&index_blocked]() { index_blocked.await(); }));
+    f.runInMaster([&f, onDone = std::make_shared<GateCallback>(commit_done)]() {
+        f.performForceCommit(std::move(onDone));
+    });
+    f._writeService.master().sync();
+    // The document meta store is committed, but the memory index commit is still pending
+    EXPECT_EQUAL(f.serial, f.getMetaStore().getLastSerialNum());
+    EXPECT_LESS(f._dmsc->getVisibleSerialNum(), f.serial);
+    EXPECT_TRUE(cache.lookup(key, f._dmsc->getVisibleSerialNum()));
+
+    index_blocked.countDown();
+    commit_done.await();
+    EXPECT_EQUAL(f.serial, f._dmsc->getVisibleSerialNum());
+    EXPECT_FALSE(cache.lookup(key, f._dmsc->getVisibleSerialNum()));
+}
+
 TEST_MAIN()
 {
     TEST_RUN_ALL();
@@ -139,6 +139,17 @@ struct AdaptiveSchedulerFactory : public SchedulerFactory {
     }
 };
 
+struct WorkStealingSchedulerFactory : public SchedulerFactory {
+    size_t num_threads;
+    size_t min_task;
+    WorkStealingSchedulerFactory(size_t num_threads_in, size_t min_task_in)
+        : num_threads(num_threads_in), min_task(min_task_in) {}
+    vespalib::string desc() const override { return make_string("work_stealing(threads:%zu,min_task:%zu)", num_threads, min_task); }
+    DocidRangeScheduler::UP create(uint32_t docid_limit) const override {
+        return std::make_unique<WorkStealingDocidRangeScheduler>(num_threads, min_task, docid_limit);
+    }
+};
+
 struct SchedulerList {
     std::vector<SchedulerFactory::UP> factory_list;
     SchedulerList(size_t num_threads) : factory_list() {
@@ -152,6 +163,8 @@ struct SchedulerList {
         factory_list.push_back(std::make_unique<AdaptiveSchedulerFactory>(num_threads, 100));
         factory_list.push_back(std::make_unique<AdaptiveSchedulerFactory>(num_threads, 10));
         factory_list.push_back(std::make_unique<AdaptiveSchedulerFactory>(num_threads, 1));
+        factory_list.push_back(std::make_unique<WorkStealingSchedulerFactory>(num_threads, 100));
+        factory_list.push_back(std::make_unique<WorkStealingSchedulerFactory>(num_threads, 1));
     }
 };
 
@@ -3,6 +3,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/testkit/time_bomb.h>
 #include <vespa/searchcore/proton/matching/docid_range_scheduler.h>
+#include <vespa/vespalib/util/stringfmt.h>
 
 using namespace proton::matching;
 using vespalib::TimeBomb;
@@ -287,4 +288,78 @@ TEST_MT_FF("require that the adaptive scheduler handles fewer documents than thr
 
 //-----------------------------------------------------------------------------
 
+TEST("require that the work stealing scheduler hands out chunks of its own part first") {
+    WorkStealingDocidRangeScheduler scheduler(2, 3, 21);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 20u);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 4)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(4, 7)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(11, 14)));
+    EXPECT_EQUAL(scheduler.total_size(0), 6u);
+    EXPECT_EQUAL(scheduler.total_size(1), 3u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 11u);
+    EXPECT_EQUAL(scheduler.steal_count(0), 0u);
+    EXPECT_TRUE(scheduler.make_idle_observer().is_always_zero());
+}
+
+TEST("require that the work stealing scheduler steals the upper half from the thread with most work left") {
+    WorkStealingDocidRangeScheduler scheduler(3, 1, 31);
+    for (size_t i = 0; i < 10; ++i) {
+        EXPECT_EQUAL(scheduler.next_range(0).size(), 1u);
+    }
+    TEST_DO(verify_range(scheduler.next_range(2), DocidRange(21, 22)));
+    // thread 1 has 10 docids left, thread 2 has 9
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(16, 17)));
+    EXPECT_EQUAL(scheduler.steal_count(0), 1u);
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(11, 12)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(17, 18)));
+}
+
+TEST("require that the work stealing scheduler does not steal ranges at or below the minimal task size") {
+    WorkStealingDocidRangeScheduler scheduler(2, 4, 9);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 5)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange()));
+    EXPECT_EQUAL(scheduler.steal_count(0), 0u);
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(5, 9)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange()));
+}
+
+TEST("require that the work stealing scheduler protects against documents underflow") {
+    WorkStealingDocidRangeScheduler scheduler(2, 1, 0);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange()));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange()));
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+}
+
+TEST_MT_FF("require that the work stealing scheduler covers all docids exactly once",
+           8, WorkStealingDocidRangeScheduler(num_threads, 1, 100001), std::vector<std::atomic<uint32_t>>(100001))
+{
+    size_t assigned = 0;
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        assigned += docid_range.size();
+        for (uint32_t docid = docid_range.begin; docid < docid_range.end; ++docid) {
+            f2[docid].fetch_add(1, std::memory_order_relaxed);
+            if ((thread_id == 0) && ((docid % 64) == 0)) {
+                // thread 0 is slow, and should get help from the others
+                std::this_thread::sleep_for(std::chrono::microseconds(10));
+            }
+        }
+    }
+    EXPECT_EQUAL(assigned, f1.total_size(thread_id));
+    TEST_BARRIER();
+    if (thread_id == 0) {
+        EXPECT_EQUAL(f1.unassigned_size(), 0u);
+        for (uint32_t docid = 1; docid < f2.size(); ++docid) {
+            if (f2[docid].load(std::memory_order_relaxed) != 1u) {
+                TEST_ERROR(vespalib::make_string("docid %u was matched %u times", docid, f2[docid].load()).c_str());
+                break;
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
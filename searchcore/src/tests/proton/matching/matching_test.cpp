@@ -10,12 +10,15 @@
 #include <vespa/searchcore/proton/matching/matcher.h>
 #include <vespa/searchcore/proton/matching/querynodes.h>
 #include <vespa/searchcore/proton/matching/sessionmanager.h>
+#include <vespa/searchcore/proton/matching/sorted_top_k_limiter.h>
 #include <vespa/searchcore/proton/matching/viewresolver.h>
 #include <vespa/searchcore/proton/test/bucketfactory.h>
 #include <vespa/searchlib/aggregation/aggregation.h>
 #include <vespa/searchlib/aggregation/grouping.h>
 #include <vespa/searchlib/aggregation/perdocexpression.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
 #include <vespa/searchlib/attribute/extendableattributes.h>
+#include <vespa/searchlib/attribute/integerbase.h>
 #include <vespa/searchlib/common/featureset.h>
 #include <vespa/searchlib/engine/docsumreply.h>
 #include <vespa/searchlib/engine/docsumrequest.h>
@@ -29,6 +32,7 @@
 #include <vespa/searchlib/query/tree/stackdumpcreator.h>
 #include <vespa/searchlib/queryeval/isourceselector.h>
 #include <vespa/searchlib/test/mock_attribute_context.h>
+#include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchcommon/attribute/iattributecontext.h>
 #include <vespa/document/base/globalid.h>
 #include <vespa/eval/eval/simple_value.h>
@@ -311,6 +315,31 @@ struct MyWorld {
         config.import(cfg);
     }
 
+    void setup_sorted_top_k() {
+        schema.addAttributeField(Schema::AttributeField("a4", DataType::INT32));
+        search::attribute::Config cfg(search::attribute::BasicType::INT32, search::attribute::CollectionType::SINGLE);
+        cfg.setFastSearch(true);
+        auto attr = AttributeFactory::createAttribute("a4", cfg);
+        attr->addDocs(NUM_DOCS);
+        auto &int_attr = dynamic_cast<IntegerAttribute &>(*attr);
+        for (uint32_t i = 0; i < NUM_DOCS; ++i) {
+            int_attr.update(i, i); // value = docid
+        }
+        attr->commit();
+        attributeContext.add(std::move(attr));
+
+        FakeResult dense; // every 4th document
+        for (uint32_t i = 4; i < NUM_DOCS; i += 4) {
+            dense.doc(i);
+        }
+        searchContext.idx(0).getFake().addResult("f1", "dense", dense);
+        FakeResult prefix; // the 256 documents with the highest a4 values
+        for (uint32_t i = NUM_DOCS - 256; i < NUM_DOCS; ++i) {
+            prefix.doc(i);
+        }
+        searchContext.attr().addResult("a4", "[;;-256]", prefix);
+    }
+
     void verbose_a1_result(const vespalib::string &term) {
         FakeResult result;
         for (uint32_t i = 15; i < NUM_DOCS; ++i) {
@@ -392,6 +421,26 @@ struct MyWorld {
         return match_tools->match_data().get_termwise_limit();
     }
 
+    bool has_first_phase_batch() {
+        Matcher::SP matcher = createMatcher();
+        SearchRequest::SP request = createSimpleRequest("f1", "spread");
+        search::fef::Properties overrides;
+        MatchToolsFactory::UP match_tools_factory = matcher->create_match_tools_factory(
+            *request, searchContext, attributeContext, metaStore, overrides, ttb(), true);
+        MatchTools::UP match_tools = match_tools_factory->createMatchTools();
+        match_tools->setup_first_phase(nullptr);
+        return (match_tools->first_phase_batch() != nullptr);
+    }
+
+    bool uses_weakand_block_max() {
+        Matcher::SP matcher = createMatcher();
+        SearchRequest::SP request = createSimpleRequest("f1", "spread");
+        search::fef::Properties overrides;
+        MatchToolsFactory::UP match_tools_factory = matcher->create_match_tools_factory(
+            *request, searchContext, attributeContext, metaStore, overrides, ttb(), true);
+        return match_tools_factory->getRequestContext().use_weakand_block_max();
+    }
+
     SearchReply::UP performSearch(const SearchRequest & req, size_t threads) {
         Matcher::SP matcher = createMatcher();
         SearchSession::OwnershipBundle owned_objects;
@@ -717,6 +766,65 @@ TEST("require that sortspec can be used (multi-threaded)") {
     }
 }
 
+TEST("require that sorted top-k is only considered for descending sort by attribute") {
+    EXPECT_EQUAL("a1", SortedTopKLimiter::descending_sort_attribute("-a1"));
+    EXPECT_EQUAL("a1", SortedTopKLimiter::descending_sort_attribute(" -a1 +a2"));
+    EXPECT_EQUAL("", SortedTopKLimiter::descending_sort_attribute("+a1"));
+    EXPECT_EQUAL("", SortedTopKLimiter::descending_sort_attribute("a1"));
+    EXPECT_EQUAL("", SortedTopKLimiter::descending_sort_attribute("-[rank]"));
+    EXPECT_EQUAL("", SortedTopKLimiter::descending_sort_attribute("-lowercase(a1)"));
+    EXPECT_EQUAL("", SortedTopKLimiter::descending_sort_attribute(""));
+}
+
+SearchReply::UP
+perform_sorted_top_k_search(MyWorld &world, const vespalib::string &term, bool sorted_top_k, size_t threads)
+{
+    SearchRequest::SP request = MyWorld::createSimpleRequest("f1", term);
+    request->sortSpec = "-a4";
+    request->maxhits = 3;
+    request->propertiesMap.lookupCreate(MapNames::RANK).add(SortedTopK::NAME, sorted_top_k ? "true" : "false");
+    return world.performSearch(*request, threads);
+}
+
+TEST("require that sorted top-k matching gives the same top hits as unlimited matching (multi-threaded)") {
+    for (size_t threads = 1; threads <= 4; ++threads) {
+        MyWorld world;
+        world.basicSetup();
+        world.setup_sorted_top_k();
+        SearchReply::UP expect = perform_sorted_top_k_search(world, "dense", false, threads);
+        EXPECT_EQUAL(249u, world.matchingStats.docsMatched());
+        SearchReply::UP actual = perform_sorted_top_k_search(world, "dense", true, threads);
+        EXPECT_EQUAL(249u + 64u, world.matchingStats.docsMatched()); // only the prefix was matched
+        ASSERT_EQUAL(3u, expect->hits.size());
+        ASSERT_EQUAL(expect->hits.size(), actual->hits.size());
+        for (size_t i = 0; i < expect->hits.size(); ++i) {
+            EXPECT_EQUAL(expect->hits[i].gid, actual->hits[i].gid);
+        }
+        EXPECT_EQUAL(document::DocumentId("id:ns:searchdocument::996").getGlobalId(), actual->hits[0].gid);
+        EXPECT_EQUAL(document::DocumentId("id:ns:searchdocument::988").getGlobalId(), actual->hits[2].gid);
+        EXPECT_TRUE(expect->sortIndex == actual->sortIndex);
+        EXPECT_TRUE(expect->sortData == actual->sortData);
+    }
+}
+
+TEST("require that sorted top-k matching falls back to unlimited matching") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.setup_sorted_top_k();
+    // Too few estimated hits for a prefix considerably smaller than the corpus
+    SearchReply::UP reply = perform_sorted_top_k_search(world, "spread", true, 1);
+    EXPECT_EQUAL(9u, world.matchingStats.docsMatched());
+    ASSERT_EQUAL(3u, reply->hits.size());
+    EXPECT_EQUAL(document::DocumentId("id:ns:searchdocument::900").getGlobalId(), reply->hits[0].gid);
+    // Hits may be dropped after matching when a rank drop limit is set
+    world.set_property(indexproperties::hitcollector::RankScoreDropLimit::NAME, "-1000");
+    reply = perform_sorted_top_k_search(world, "dense", true, 1);
+    EXPECT_EQUAL(9u + 249u, world.matchingStats.docsMatched());
+    ASSERT_EQUAL(3u, reply->hits.size());
+    EXPECT_EQUAL(document::DocumentId("id:ns:searchdocument::996").getGlobalId(), reply->hits[0].gid);
+}
+
 ExpressionNode::UP createAttr() { return std::make_unique<AttributeNode>("a1"); }
 TEST("require that grouping is performed (multi-threaded)") {
     for (size_t threads = 1; threads <= 16; ++threads) {
@@ -1080,6 +1188,58 @@ TEST("require that termwise limit is set correctly for first phase ranking progr
     EXPECT_EQUAL(0.02, world.get_first_phase_termwise_limit());
 }
 
+TEST("require that ranking with match data is performed (multi-threaded)") {
+    for (size_t threads = 1; threads <= 16; ++threads) {
+        MyWorld world;
+        world.basicSetup();
+        world.basicResults();
+        world.set_property(indexproperties::rank::FirstPhase::NAME, "attribute(a1)*matches(f1)");
+        SearchRequest::SP request = MyWorld::createSimpleRequest("f1", "spread");
+        SearchReply::UP reply = world.performSearch(*request, threads);
+        EXPECT_EQUAL(9u, world.matchingStats.docsRanked());
+        ASSERT_TRUE(reply->hits.size() == 9u);
+        EXPECT_EQUAL(document::DocumentId("id:ns:searchdocument::900").getGlobalId(),  reply->hits[0].gid);
+        EXPECT_EQUAL(900.0, reply->hits[0].metric);
+        EXPECT_EQUAL(document::DocumentId("id:ns:searchdocument::800").getGlobalId(),  reply->hits[1].gid);
+        EXPECT_EQUAL(800.0, reply->hits[1].metric);
+    }
+}
+
+TEST("require that first phase ranking is only batched when no match data is used") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::rank::FirstPhase::NAME, "value(5)*2");
+    EXPECT_TRUE(world.has_first_phase_batch());
+    world.set_property(indexproperties::rank::FirstPhase::NAME, "matches(f1)");
+    EXPECT_FALSE(world.has_first_phase_batch());
+}
+
+TEST("require that weak and block max is passed to the request context") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    EXPECT_FALSE(world.uses_weakand_block_max());
+    world.set_property(indexproperties::matching::WeakAndBlockMax::NAME, "true");
+    EXPECT_TRUE(world.uses_weakand_block_max());
+}
+
+TEST("require that batched first phase ranking is performed (multi-threaded)") {
+    for (size_t threads = 1; threads <= 16; ++threads) {
+        MyWorld world;
+        world.basicSetup();
+        world.basicResults();
+        world.set_property(indexproperties::rank::FirstPhase::NAME, "value(5)*2");
+        SearchRequest::SP request = MyWorld::createSimpleRequest("f1", "spread");
+        SearchReply::UP reply = world.performSearch(*request, threads);
+        EXPECT_EQUAL(9u, world.matchingStats.docsRanked());
+        ASSERT_TRUE(reply->hits.size() == 9u);
+        for (const auto &hit: reply->hits) {
+            EXPECT_EQUAL(10.0, hit.metric);
+        }
+    }
+}
+
 TEST("require that fields are tagged with data type") {
     MyWorld world;
     world.basicSetup();
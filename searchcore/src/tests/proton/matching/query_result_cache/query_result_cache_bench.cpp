@@ -0,0 +1,70 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <functional>
+
+using proton::matching::QueryResultCache;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using vespalib::BenchmarkTimer;
+
+//-----------------------------------------------------------------------------
+
+SearchReply
+make_reply(size_t num_hits, size_t sort_data_per_hit, size_t group_result_size)
+{
+    SearchReply reply;
+    reply.totalHitCount = num_hits * 100;
+    reply.hits.resize(num_hits);
+    for (size_t i = 0; i < num_hits; ++i) {
+        reply.hits[i].metric = num_hits - i;
+    }
+    if (sort_data_per_hit > 0) {
+        reply.sortIndex.resize(num_hits + 1);
+        for (size_t i = 0; i <= num_hits; ++i) {
+            reply.sortIndex[i] = i * sort_data_per_hit;
+        }
+        reply.sortData.resize(num_hits * sort_data_per_hit, 'x');
+    }
+    reply.groupResult.resize(group_result_size);
+    return reply;
+}
+
+double
+measure(const char *desc, const std::function<void()> &fun)
+{
+    BenchmarkTimer timer(1.0);
+    while (timer.has_budget()) {
+        timer.before();
+        fun();
+        timer.after();
+    }
+    double min_time_us = timer.min_time() * 1000.0 * 1000.0;
+    fprintf(stderr, "%s: %g us\n", desc, min_time_us);
+    return min_time_us;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST("measure cost of returning a cached reply") {
+    SearchRequest request;
+    request.stackDump = {'a', 'b', 'c'};
+    auto key = QueryResultCache::makeKey(request);
+    struct Shape { size_t hits; size_t sort_data; size_t group_result; };
+    for (Shape shape : {Shape{10, 0, 0}, Shape{100, 0, 0}, Shape{400, 16, 0}, Shape{1000, 16, 64_Ki}}) {
+        QueryResultCache cache(64_Mi, 0);
+        cache.insert(key, make_reply(shape.hits, shape.sort_data, shape.group_result), 1);
+        vespalib::string desc = vespalib::make_string("lookup %zu hits, %zu bytes sort data per hit, %zu bytes grouping",
+                                                      shape.hits, shape.sort_data, shape.group_result);
+        EXPECT_TRUE(cache.lookup(key, 1));
+        measure(desc.c_str(), [&]() { (void) cache.lookup(key, 1); });
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
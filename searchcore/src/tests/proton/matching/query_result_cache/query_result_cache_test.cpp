@@ -0,0 +1,167 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/size_literals.h>
+
+using proton::matching::QueryResultCache;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+
+namespace {
+
+std::unique_ptr<SearchRequest>
+make_request(const vespalib::string &ranking = "default")
+{
+    auto request = std::make_unique<SearchRequest>();
+    request->ranking = ranking;
+    request->stackDump = {'a', 'b', 'c'};
+    request->offset = 0;
+    request->maxhits = 10;
+    return request;
+}
+
+SearchReply
+make_reply(uint64_t totalHits, size_t numHits = 1)
+{
+    SearchReply reply;
+    reply.totalHitCount = totalHits;
+    reply.hits.resize(numHits);
+    for (size_t i = 0; i < numHits; ++i) {
+        reply.hits[i].metric = numHits - i;
+    }
+    return reply;
+}
+
+}
+
+TEST(QueryResultCacheTest, key_depends_on_all_parts_of_the_request)
+{
+    auto base = QueryResultCache::makeKey(*make_request());
+    EXPECT_FALSE(base.empty());
+    EXPECT_EQ(base, QueryResultCache::makeKey(*make_request()));
+    EXPECT_NE(base, QueryResultCache::makeKey(*make_request("other")));
+    auto req = make_request();
+    req->offset = 10;
+    EXPECT_NE(base, QueryResultCache::makeKey(*req));
+    req = make_request();
+    req->maxhits = 20;
+    EXPECT_NE(base, QueryResultCache::makeKey(*req));
+    req = make_request();
+    req->stackDump.push_back('d');
+    EXPECT_NE(base, QueryResultCache::makeKey(*req));
+    req = make_request();
+    req->sortSpec = "+foo";
+    EXPECT_NE(base, QueryResultCache::makeKey(*req));
+    req = make_request();
+    req->propertiesMap.lookupCreate("rank").add("foo", "bar");
+    EXPECT_NE(base, QueryResultCache::makeKey(*req));
+}
+
+TEST(QueryResultCacheTest, key_is_independent_of_property_insertion_order)
+{
+    auto a = make_request();
+    a->propertiesMap.lookupCreate("rank").add("x", "1").add("y", "2");
+    a->propertiesMap.lookupCreate("feature").add("z", "3");
+    auto b = make_request();
+    b->propertiesMap.lookupCreate("feature").add("z", "3");
+    b->propertiesMap.lookupCreate("rank").add("y", "2").add("x", "1");
+    EXPECT_EQ(QueryResultCache::makeKey(*a), QueryResultCache::makeKey(*b));
+}
+
+TEST(QueryResultCacheTest, traced_and_session_requests_are_not_cached)
+{
+    auto req = make_request();
+    req->trace().setLevel(1);
+    EXPECT_TRUE(QueryResultCache::makeKey(*req).empty());
+    req = make_request();
+    req->sessionId = {'s', '1'};
+    EXPECT_FALSE(QueryResultCache::makeKey(*req).empty());
+    req->propertiesMap.lookupCreate("caches").add("query", "true");
+    EXPECT_TRUE(QueryResultCache::makeKey(*req).empty());
+}
+
+TEST(QueryResultCacheTest, reply_is_returned_until_serial_num_has_advanced_beyond_max_staleness)
+{
+    QueryResultCache cache(1_Mi, 2);
+    auto key = QueryResultCache::makeKey(*make_request());
+    EXPECT_FALSE(cache.lookup(key, 10));
+    cache.insert(key, make_reply(42, 3), 10);
+    for (uint64_t serial : {10, 11, 12}) {
+        auto reply = cache.lookup(key, serial);
+        ASSERT_TRUE(reply);
+        EXPECT_EQ(42u, reply->totalHitCount);
+        EXPECT_EQ(3u, reply->hits.size());
+    }
+    EXPECT_FALSE(cache.lookup(key, 13));
+    EXPECT_EQ(0u, cache.size());
+    auto stats = cache.getStats();
+    EXPECT_EQ(3u, stats.hits);
+    EXPECT_EQ(2u, stats.misses);
+    EXPECT_EQ(1u, stats.invalidations);
+}
+
+TEST(QueryResultCacheTest, reply_properties_are_returned_with_the_cached_reply)
+{
+    QueryResultCache cache(1_Mi, 0);
+    auto key = QueryResultCache::makeKey(*make_request());
+    auto reply = make_reply(42);
+    reply.propertiesMap.lookupCreate("match").add("foo", "bar").add("foo", "baz");
+    cache.insert(key, reply, 10);
+    auto cached = cache.lookup(key, 10);
+    ASSERT_TRUE(cached);
+    EXPECT_EQ(1u, cached->propertiesMap.size());
+    auto property = cached->propertiesMap.lookupCreate("match").lookup("foo");
+    ASSERT_EQ(2u, property.size());
+    EXPECT_EQ("bar", property.getAt(0));
+    EXPECT_EQ("baz", property.getAt(1));
+}
+
+TEST(QueryResultCacheTest, reply_from_the_future_is_not_returned)
+{
+    QueryResultCache cache(1_Mi, 10);
+    auto key = QueryResultCache::makeKey(*make_request());
+    cache.insert(key, make_reply(42), 10);
+    EXPECT_FALSE(cache.lookup(key, 9));
+}
+
+TEST(QueryResultCacheTest, least_recently_used_replies_are_evicted_when_memory_limit_is_reached)
+{
+    QueryResultCache cache(64_Ki, 0);
+    auto key_a = QueryResultCache::makeKey(*make_request("a"));
+    auto key_b = QueryResultCache::makeKey(*make_request("b"));
+    auto key_c = QueryResultCache::makeKey(*make_request("c"));
+    cache.insert(key_a, make_reply(1, 1000), 1);
+    cache.insert(key_b, make_reply(2, 1000), 1);
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_TRUE(cache.lookup(key_a, 1));
+    cache.insert(key_c, make_reply(3, 1000), 1);
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_TRUE(cache.lookup(key_a, 1));
+    EXPECT_FALSE(cache.lookup(key_b, 1));
+    EXPECT_TRUE(cache.lookup(key_c, 1));
+    EXPECT_LE(cache.getStats().memory_used, 64_Ki);
+}
+
+TEST(QueryResultCacheTest, too_large_reply_is_not_cached)
+{
+    QueryResultCache cache(4_Ki, 0);
+    auto key = QueryResultCache::makeKey(*make_request());
+    cache.insert(key, make_reply(1, 1000), 1);
+    EXPECT_EQ(0u, cache.size());
+}
+
+TEST(QueryResultCacheTest, clear_drops_all_replies)
+{
+    QueryResultCache cache(1_Mi, 0);
+    cache.insert(QueryResultCache::makeKey(*make_request("a")), make_reply(1), 1);
+    cache.insert(QueryResultCache::makeKey(*make_request("b")), make_reply(2), 1);
+    cache.clear();
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_EQ(2u, cache.getStats().invalidations);
+    EXPECT_EQ(0u, cache.getStats().memory_used);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -4,6 +4,7 @@
 #include <vespa/searchcore/proton/persistenceengine/persistence_handler_map.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/document/update/documentupdate.h>
+#include <vespa/persistence/spi/feed_batch.h>
 
 #include <vespa/vespalib/testkit/testapp.h>
 
@@ -18,6 +19,7 @@ struct DummyPersistenceHandler : public IPersistenceHandler {
     void handlePut(FeedToken, const storage::spi::Bucket &, storage::spi::Timestamp, DocumentSP) override {}
     void handleUpdate(FeedToken, const storage::spi::Bucket &, storage::spi::Timestamp, DocumentUpdateSP) override {}
     void handleRemove(FeedToken, const storage::spi::Bucket &, storage::spi::Timestamp, const document::DocumentId &) override {}
+    void handleFeedBatch(std::vector<FeedToken>, const storage::spi::Bucket &, storage::spi::FeedBatch) override {}
     void handleListBuckets(IBucketIdListResultHandler &) override {}
     void handleSetClusterState(const storage::spi::ClusterState &, IGenericResultHandler &) override {}
     void handleSetActiveState(const storage::spi::Bucket &, storage::spi::BucketInfo::ActiveState, std::shared_ptr<IGenericResultHandler>) override {}
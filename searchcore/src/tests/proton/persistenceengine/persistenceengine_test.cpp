@@ -9,6 +9,7 @@
 #include <vespa/document/fieldvalue/stringfieldvalue.h>
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/document/update/assignvalueupdate.h>
+#include <vespa/persistence/spi/catchresult.h>
 #include <vespa/persistence/spi/documentselection.h>
 #include <vespa/persistence/spi/test.h>
 #include <vespa/searchcore/proton/persistenceengine/ipersistenceengineowner.h>
@@ -38,6 +39,7 @@ using storage::spi::ClusterState;
 using storage::spi::Context;
 using storage::spi::CreateIteratorResult;
 using storage::spi::DocumentSelection;
+using storage::spi::FeedBatch;
 using storage::spi::GetResult;
 using storage::spi::IterateResult;
 using storage::spi::IteratorId;
@@ -160,6 +162,7 @@ struct MyHandler : public IPersistenceHandler, IBucketFreezer {
     const Document              *document;
     std::multiset<uint64_t>      frozen;
     std::multiset<uint64_t>      was_frozen;
+    uint32_t                     feedBatches;
 
     MyHandler()
         : initialized(false),
@@ -179,7 +182,8 @@ struct MyHandler : public IPersistenceHandler, IBucketFreezer {
           _createBucketResult(),
           document(nullptr),
           frozen(),
-          was_frozen()
+          was_frozen(),
+          feedBatches(0)
     {
     }
 
@@ -218,6 +222,24 @@ struct MyHandler : public IPersistenceHandler, IBucketFreezer {
         handle(token, bucket, timestamp, id);
     }
 
+    void handleFeedBatch(std::vector<FeedToken> tokens, const Bucket& bucket, FeedBatch batch) override {
+        ++feedBatches;
+        for (size_t i = 0; i < batch.size(); ++i) {
+            auto &entry = batch.entries()[i];
+            switch (entry.type) {
+            case FeedBatch::Type::PUT:
+                handlePut(std::move(tokens[i]), bucket, entry.timestamp, std::move(entry.doc));
+                break;
+            case FeedBatch::Type::REMOVE:
+                handleRemove(std::move(tokens[i]), bucket, entry.timestamp, entry.remove_id);
+                break;
+            case FeedBatch::Type::UPDATE:
+                handleUpdate(std::move(tokens[i]), bucket, entry.timestamp, std::move(entry.update));
+                break;
+            }
+        }
+    }
+
     void handleListBuckets(IBucketIdListResultHandler &resultHandler) override {
         resultHandler.handle(BucketIdListResult(BucketId::List(bucketList.begin(), bucketList.end())));
     }
@@ -562,6 +584,82 @@ TEST_F("require that remove is NOT rejected if resource limit is reached", Simpl
 }
 
 
+using FutureResult = std::future<std::unique_ptr<Result>>;
+
+FutureResult
+addPut(FeedBatch &batch, Timestamp ts, Document::SP doc)
+{
+    auto catcher = std::make_unique<storage::spi::CatchResult>();
+    auto future = catcher->future_result();
+    batch.add_put(ts, std::move(doc), std::move(catcher));
+    return future;
+}
+
+FutureResult
+addRemove(FeedBatch &batch, Timestamp ts, const DocumentId &id)
+{
+    auto catcher = std::make_unique<storage::spi::CatchResult>();
+    auto future = catcher->future_result();
+    batch.add_remove(ts, id, std::move(catcher));
+    return future;
+}
+
+FutureResult
+addUpdate(FeedBatch &batch, Timestamp ts, DocumentUpdate::SP upd)
+{
+    auto catcher = std::make_unique<storage::spi::CatchResult>();
+    auto future = catcher->future_result();
+    batch.add_update(ts, std::move(upd), std::move(catcher));
+    return future;
+}
+
+TEST_F("require that feed batches are routed to handlers", SimpleFixture)
+{
+    f.hset.handler1.setExistingTimestamp(tstamp2);
+    FeedBatch batch;
+    auto put1 = addPut(batch, tstamp1, doc1);
+    auto put2 = addPut(batch, tstamp2, doc2);
+    auto remove1 = addRemove(batch, tstamp3, docId1);
+    auto update1 = addUpdate(batch, Timestamp(4), upd1);
+    f.engine.feedBatchAsync(bucket1, std::move(batch));
+    EXPECT_EQUAL(1u, f.hset.handler1.feedBatches);
+    EXPECT_EQUAL(1u, f.hset.handler2.feedBatches);
+    TEST_DO(assertHandler(bucket1, Timestamp(4), docId1, f.hset.handler1));
+    TEST_DO(assertHandler(bucket1, tstamp2, docId2, f.hset.handler2));
+    EXPECT_EQUAL(Result(), *put1.get());
+    EXPECT_EQUAL(Result(), *put2.get());
+    auto removeResult = remove1.get();
+    EXPECT_TRUE(dynamic_cast<const RemoveResult &>(*removeResult).wasFound());
+    auto updateResult = update1.get();
+    EXPECT_EQUAL(tstamp2, dynamic_cast<const UpdateResult &>(*updateResult).getExistingTimestamp());
+}
+
+TEST_F("require that feed batch with failing operations is handled one operation at a time", SimpleFixture)
+{
+    FeedBatch batch;
+    auto put1 = addPut(batch, tstamp1, doc1);
+    auto put3 = addPut(batch, tstamp2, doc3);
+    f.engine.feedBatchAsync(bucket1, std::move(batch));
+    EXPECT_EQUAL(0u, f.hset.handler1.feedBatches);
+    TEST_DO(assertHandler(bucket1, tstamp1, docId1, f.hset.handler1));
+    EXPECT_EQUAL(Result(), *put1.get());
+    EXPECT_EQUAL(Result(Result::ErrorType::PERMANENT_ERROR, "No handler for document type 'type3'"), *put3.get());
+}
+
+TEST_F("require that feed batch is handled one operation at a time if resource limit is reached", SimpleFixture)
+{
+    f._writeFilter._acceptWriteOperation = false;
+    f._writeFilter._message = "Disk is full";
+    FeedBatch batch;
+    auto put1 = addPut(batch, tstamp1, doc1);
+    auto remove1 = addRemove(batch, tstamp2, docId1);
+    f.engine.feedBatchAsync(bucket1, std::move(batch));
+    EXPECT_EQUAL(0u, f.hset.handler1.feedBatches);
+    EXPECT_EQUAL(Result(Result::ErrorType::RESOURCE_EXHAUSTED,
+                        "Put operation rejected for document 'id:type1:type1::1': 'Disk is full'"), *put1.get());
+    EXPECT_EQUAL(Result(), *remove1.get());
+}
+
 TEST_F("require that listBuckets() is routed to handlers and merged", SimpleFixture)
 {
     f.hset.prepareListBuckets();
@@ -362,7 +362,8 @@ BmCluster::create_feed_handler()
         }
     } else {
         auto providers = collect_persistence_providers(_nodes);
-        _feed_handler = std::make_unique<SpiBmFeedHandler>(std::move(providers), *_field_set_repo, *_distribution, _params.get_skip_get_spi_bucket_info());
+        _feed_handler = std::make_unique<SpiBmFeedHandler>(std::move(providers), *_field_set_repo, *_distribution, _params.get_skip_get_spi_bucket_info(),
+                                                           _params.get_spi_feed_batch_size());
     }
 }
 
@@ -28,6 +28,7 @@ BmClusterParams::BmClusterParams()
       _rpc_network_threads(1),      // Same default as previous in stor-communicationmanager.def
       _rpc_targets_per_node(1),     // Same default as in stor-communicationmanager.def
       _skip_get_spi_bucket_info(false),
+      _spi_feed_batch_size(1),
       _use_async_message_handling_on_schedule(false),
       _use_document_api(false),
       _use_message_bus(false),
@@ -53,6 +54,10 @@ BmClusterParams::check() const
         std::cerr << "Too few rpc targets per node: " << _rpc_targets_per_node << std::endl;
         return false;
     }
+    if (_spi_feed_batch_size < 1) {
+        std::cerr << "Too small spi feed batch size: " << _spi_feed_batch_size << std::endl;
+        return false;
+    }
     if (_nodes_per_group < _redundancy) {
         std::cerr << "Too high redundancy " << _redundancy << " with " << _nodes_per_group << " nodes per group" << std::endl;
         return false;
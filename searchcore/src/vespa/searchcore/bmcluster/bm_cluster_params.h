@@ -35,6 +35,7 @@ class BmClusterParams
     uint32_t _rpc_network_threads;
     uint32_t _rpc_targets_per_node;
     bool     _skip_get_spi_bucket_info;
+    uint32_t _spi_feed_batch_size;
     bool     _use_async_message_handling_on_schedule;
     bool     _use_document_api;
     bool     _use_message_bus;
@@ -64,6 +65,7 @@ public:
     uint32_t get_rpc_network_threads() const { return _rpc_network_threads; }
     uint32_t get_rpc_targets_per_node() const { return _rpc_targets_per_node; }
     bool get_skip_get_spi_bucket_info() const { return _skip_get_spi_bucket_info; }
+    uint32_t get_spi_feed_batch_size() const noexcept { return _spi_feed_batch_size; }
     bool get_use_async_message_handling_on_schedule() const { return _use_async_message_handling_on_schedule; }
     bool get_use_document_api() const { return _use_document_api; }
     bool get_use_message_bus() const { return _use_message_bus; }
@@ -92,6 +94,7 @@ public:
     void set_rpc_network_threads(uint32_t threads_in) { _rpc_network_threads = threads_in; }
     void set_rpc_targets_per_node(uint32_t targets_in) { _rpc_targets_per_node = targets_in; }
     void set_skip_get_spi_bucket_info(bool value) { _skip_get_spi_bucket_info = value; }
+    void set_spi_feed_batch_size(uint32_t value) { _spi_feed_batch_size = value; }
     void set_use_async_message_handling_on_schedule(bool value) { _use_async_message_handling_on_schedule = value; }
     void set_use_document_api(bool value) { _use_document_api = value; }
     void set_use_message_bus(bool value) { _use_message_bus = value; }
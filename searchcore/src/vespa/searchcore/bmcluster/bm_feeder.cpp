@@ -106,6 +106,7 @@ BmFeeder::feed_task(uint32_t max_pending, BmRange range, const vespalib::nbostre
         ++op_count;
     }
     assert(is.empty() || _stop.load(std::memory_order_relaxed));
+    _feed_handler.flush(pending_tracker);
     pending_tracker.drain();
     return op_count;
 }
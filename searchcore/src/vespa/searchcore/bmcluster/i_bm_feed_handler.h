@@ -29,6 +29,8 @@ public:
     virtual void remove(const document::Bucket& bucket, const document::DocumentId& document_id,  uint64_t timestamp, PendingTracker& tracker) = 0;
     virtual void get(const document::Bucket& bucket, vespalib::stringref field_set_string, const document::DocumentId& document_id, PendingTracker& tracker) = 0;
     virtual void attach_bucket_info_queue(PendingTracker& tracker) = 0;
+    // Sends operations held back by the feed handler for the given tracker
+    virtual void flush(PendingTracker& tracker) { (void) tracker; }
     virtual uint32_t get_error_count() const = 0;
     virtual const vespalib::string &get_name() const = 0;
     virtual bool manages_timestamp() const = 0;
@@ -13,6 +13,7 @@ using document::Document;
 using document::DocumentId;
 using document::DocumentUpdate;
 using storage::spi::Bucket;
+using storage::spi::FeedBatch;
 using storage::spi::PersistenceProvider;
 using storage::spi::Timestamp;
 
@@ -78,14 +79,18 @@ MyOperationComplete::addResultHandler(const storage::spi::ResultHandler * result
 
 }
 
-SpiBmFeedHandler::SpiBmFeedHandler(std::vector<PersistenceProvider* >providers, const document::FieldSetRepo &field_set_repo, const IBmDistribution& distribution, bool skip_get_spi_bucket_info)
+SpiBmFeedHandler::SpiBmFeedHandler(std::vector<PersistenceProvider* >providers, const document::FieldSetRepo &field_set_repo, const IBmDistribution& distribution, bool skip_get_spi_bucket_info, uint32_t feed_batch_size)
     : IBmFeedHandler(),
-      _name(vespalib::string("SpiBmFeedHandler(") + (skip_get_spi_bucket_info ? "skip-get-spi-bucket-info" : "get-spi-bucket-info") + ")"),
+      _name(vespalib::string("SpiBmFeedHandler(") + (skip_get_spi_bucket_info ? "skip-get-spi-bucket-info" : "get-spi-bucket-info") +
+            (feed_batch_size > 1 ? (",feed-batch-size=" + std::to_string(feed_batch_size)) : std::string()) + ")"),
       _providers(std::move(providers)),
       _field_set_repo(field_set_repo),
       _errors(0u),
       _skip_get_spi_bucket_info(skip_get_spi_bucket_info),
-      _distribution(distribution)
+      _distribution(distribution),
+      _feed_batch_size(feed_batch_size),
+      _batches_lock(),
+      _batches()
 {
 }
 
@@ -101,12 +106,47 @@ SpiBmFeedHandler::get_provider(const document::Bucket& bucket)
     return _providers[node_idx];
 }
 
+void
+SpiBmFeedHandler::add_to_batch(const document::Bucket& bucket, FeedBatch single, PendingTracker& tracker)
+{
+    FeedBatch batch;
+    {
+        std::lock_guard guard(_batches_lock);
+        auto& pending = _batches[bucket];
+        pending.tracker = &tracker;
+        pending.batch.entries().push_back(std::move(single.entries().front()));
+        if (pending.batch.size() < _feed_batch_size) {
+            return;
+        }
+        batch = std::move(pending.batch);
+        _batches.erase(bucket);
+    }
+    send_batch(bucket, std::move(batch), tracker);
+}
+
+void
+SpiBmFeedHandler::send_batch(const document::Bucket& bucket, FeedBatch batch, PendingTracker& tracker)
+{
+    // Completions are created when the batch is sent, to not hold back pending operations
+    auto provider = get_provider(bucket);
+    Bucket spi_bucket(bucket);
+    for (auto& entry : batch.entries()) {
+        entry.on_complete = std::make_unique<MyOperationComplete>(provider, _errors, spi_bucket, tracker);
+    }
+    provider->feedBatchAsync(spi_bucket, std::move(batch));
+}
+
 void
 SpiBmFeedHandler::put(const document::Bucket& bucket, std::unique_ptr<Document> document, uint64_t timestamp, PendingTracker& tracker)
 {
     get_bucket_info_loop(tracker);
     auto provider = get_provider(bucket);
     if (provider) {
+        if (_feed_batch_size > 1) {
+            FeedBatch single;
+            single.add_put(Timestamp(timestamp), std::move(document), {});
+            return add_to_batch(bucket, std::move(single), tracker);
+        }
         Bucket spi_bucket(bucket);
         provider->putAsync(spi_bucket, Timestamp(timestamp), std::move(document), std::make_unique<MyOperationComplete>(provider, _errors, spi_bucket, tracker));
     } else {
@@ -120,6 +160,11 @@ SpiBmFeedHandler::update(const document::Bucket& bucket, std::unique_ptr<Documen
     get_bucket_info_loop(tracker);
     auto provider = get_provider(bucket);
     if (provider) {
+        if (_feed_batch_size > 1) {
+            FeedBatch single;
+            single.add_update(Timestamp(timestamp), std::move(document_update), {});
+            return add_to_batch(bucket, std::move(single), tracker);
+        }
         Bucket spi_bucket(bucket);
         provider->updateAsync(spi_bucket, Timestamp(timestamp), std::move(document_update), std::make_unique<MyOperationComplete>(provider, _errors, spi_bucket, tracker));
     } else {
@@ -133,6 +178,11 @@ SpiBmFeedHandler::remove(const document::Bucket& bucket, const DocumentId& docum
     get_bucket_info_loop(tracker);
     auto provider = get_provider(bucket);
     if (provider) {
+        if (_feed_batch_size > 1) {
+            FeedBatch single;
+            single.add_remove(Timestamp(timestamp), document_id, {});
+            return add_to_batch(bucket, std::move(single), tracker);
+        }
         Bucket spi_bucket(bucket);
         std::vector<storage::spi::IdAndTimestamp> ids;
         ids.emplace_back(document_id, Timestamp(timestamp));
@@ -167,6 +217,26 @@ SpiBmFeedHandler::attach_bucket_info_queue(PendingTracker& tracker)
     }
 }
 
+void
+SpiBmFeedHandler::flush(PendingTracker& tracker)
+{
+    std::vector<std::pair<document::Bucket, FeedBatch>> batches;
+    {
+        std::lock_guard guard(_batches_lock);
+        for (auto itr = _batches.begin(); itr != _batches.end();) {
+            if (itr->second.tracker == &tracker) {
+                batches.emplace_back(itr->first, std::move(itr->second.batch));
+                itr = _batches.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
+    }
+    for (auto& batch : batches) {
+        send_batch(batch.first, std::move(batch.second), tracker);
+    }
+}
+
 uint32_t
 SpiBmFeedHandler::get_error_count() const
 {
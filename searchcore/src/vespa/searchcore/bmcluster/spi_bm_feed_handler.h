@@ -3,7 +3,11 @@
 #pragma once
 
 #include "i_bm_feed_handler.h"
+#include <vespa/document/bucket/bucket.h>
+#include <vespa/persistence/spi/feed_batch.h>
 #include <atomic>
+#include <map>
+#include <mutex>
 #include <vector>
 
 namespace document { class FieldSetRepo; }
@@ -14,26 +18,39 @@ namespace search::bmcluster {
 class IBmDistribution;
 
 /*
- * Benchmark feed handler for feed directly to persistence provider
+ * Benchmark feed handler for feed directly to persistence provider.
+ * Puts, updates and removes are passed on in batches per bucket when
+ * feed_batch_size is larger than 1.
  */
 class SpiBmFeedHandler : public IBmFeedHandler
 {
+    struct PendingFeedBatch {
+        storage::spi::FeedBatch batch;
+        PendingTracker*         tracker;
+        PendingFeedBatch() : batch(), tracker(nullptr) {}
+    };
     vespalib::string                                _name;
     std::vector<storage::spi::PersistenceProvider*> _providers;
     const document::FieldSetRepo&                   _field_set_repo;
     std::atomic<uint32_t>                            _errors;
     bool                                            _skip_get_spi_bucket_info;
     const IBmDistribution&                          _distribution;
+    uint32_t                                        _feed_batch_size;
+    std::mutex                                      _batches_lock;
+    std::map<document::Bucket, PendingFeedBatch>    _batches;
 
     storage::spi::PersistenceProvider* get_provider(const document::Bucket &bucket);
+    void add_to_batch(const document::Bucket& bucket, storage::spi::FeedBatch single, PendingTracker& tracker);
+    void send_batch(const document::Bucket& bucket, storage::spi::FeedBatch batch, PendingTracker& tracker);
 public:
-    SpiBmFeedHandler(std::vector<storage::spi::PersistenceProvider*> providers, const document::FieldSetRepo& field_set_repo, const IBmDistribution& distribution, bool skip_get_spi_bucket_info);
+    SpiBmFeedHandler(std::vector<storage::spi::PersistenceProvider*> providers, const document::FieldSetRepo& field_set_repo, const IBmDistribution& distribution, bool skip_get_spi_bucket_info, uint32_t feed_batch_size);
     ~SpiBmFeedHandler();
     void put(const document::Bucket& bucket, std::unique_ptr<document::Document> document, uint64_t timestamp, PendingTracker& tracker) override;
     void update(const document::Bucket& bucket, std::unique_ptr<document::DocumentUpdate> document_update, uint64_t timestamp, PendingTracker& tracker) override;
     void remove(const document::Bucket& bucket, const document::DocumentId& document_id,  uint64_t timestamp, PendingTracker& tracker) override;
     void get(const document::Bucket& bucket, vespalib::stringref field_set_string, const document::DocumentId& document_id, PendingTracker& tracker) override;
     void attach_bucket_info_queue(PendingTracker &tracker) override;
+    void flush(PendingTracker& tracker) override;
     uint32_t get_error_count() const override;
     const vespalib::string &get_name() const override;
     bool manages_timestamp() const override;
@@ -5,8 +5,11 @@
 #include "groupingcontext.h"
 #include <vespa/searchlib/aggregation/fs4hit.h>
 #include <vespa/searchlib/expression/attributenode.h>
+#include <vespa/searchlib/grouping/partitioned_grouping_merger.h>
 #include <vespa/vespalib/util/issue.h>
+#include <vespa/vespalib/util/runnable.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/thread_bundle.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".groupingmanager");
@@ -18,6 +21,42 @@ using attribute::IAttributeContext;
 using vespalib::Issue;
 using vespalib::make_string_short::fmt;
 
+namespace {
+
+// Below this number of first level groups, partitioning is not worth it
+constexpr size_t min_groups_for_partitioned_merge = 4096;
+
+using Mergers = std::vector<std::unique_ptr<PartitionedGroupingMerger>>;
+
+struct SplitTask : vespalib::Runnable {
+    const Mergers &mergers;
+    uint32_t first_input;
+    uint32_t input_stride;
+    SplitTask(const Mergers &mergers_in, uint32_t first_input_in, uint32_t input_stride_in)
+        : mergers(mergers_in), first_input(first_input_in), input_stride(input_stride_in) {}
+    void run() override {
+        for (const auto &merger : mergers) {
+            for (uint32_t i = first_input; i < merger->get_num_inputs(); i += input_stride) {
+                merger->split(i);
+            }
+        }
+    }
+};
+
+struct MergePartitionTask : vespalib::Runnable {
+    const Mergers &mergers;
+    uint32_t partition_id;
+    MergePartitionTask(const Mergers &mergers_in, uint32_t partition_id_in)
+        : mergers(mergers_in), partition_id(partition_id_in) {}
+    void run() override {
+        for (const auto &merger : mergers) {
+            merger->merge_partition(partition_id);
+        }
+    }
+};
+
+}
+
 //-----------------------------------------------------------------------------
 
 GroupingManager::GroupingManager(GroupingContext & groupingContext)
@@ -110,6 +149,52 @@ GroupingManager::merge(GroupingContext &ctx)
     }
 }
 
+void
+GroupingManager::merge(const std::vector<GroupingContext *> &others, vespalib::ThreadBundle &thread_bundle)
+{
+    GroupingContext::GroupingList &list_a(_groupingContext.getGroupingList());
+    size_t num_threads = thread_bundle.size();
+    Mergers mergers;
+    for (size_t i = 0; i < list_a.size(); ++i) {
+        Grouping &a = *list_a[i];
+        std::vector<Grouping *> inputs;
+        inputs.push_back(&a);
+        size_t num_groups = a.getRoot().getChildrenSize();
+        for (GroupingContext *ctx : others) {
+            GroupingContext::GroupingList &list_b(ctx->getGroupingList());
+            LOG_ASSERT(list_a.size() == list_b.size());
+            Grouping &b = *list_b[i];
+            LOG_ASSERT(a.getId() == b.getId());
+            num_groups += b.getRoot().getChildrenSize();
+            inputs.push_back(&b);
+        }
+        if (num_threads > 1 && num_groups >= min_groups_for_partitioned_merge) {
+            mergers.push_back(std::make_unique<PartitionedGroupingMerger>(std::move(inputs), num_threads));
+        } else {
+            for (size_t j = 1; j < inputs.size(); ++j) {
+                a.merge(*inputs[j]);
+            }
+        }
+    }
+    if (mergers.empty()) {
+        return;
+    }
+    uint32_t num_split_tasks = std::min(num_threads, others.size() + 1);
+    std::vector<vespalib::Runnable::UP> tasks;
+    for (uint32_t i = 0; i < num_split_tasks; ++i) {
+        tasks.push_back(std::make_unique<SplitTask>(mergers, i, num_split_tasks));
+    }
+    thread_bundle.run(tasks);
+    tasks.clear();
+    for (uint32_t i = 0; i < num_threads; ++i) {
+        tasks.push_back(std::make_unique<MergePartitionTask>(mergers, i));
+    }
+    thread_bundle.run(tasks);
+    for (const auto &merger : mergers) {
+        merger->finish();
+    }
+}
+
 void
 GroupingManager::prune()
 {
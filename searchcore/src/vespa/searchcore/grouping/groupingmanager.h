@@ -3,12 +3,15 @@
 
 #include <vespa/searchlib/common/idocumentmetastore.h>
 #include <vespa/searchcommon/attribute/iattributecontext.h>
+#include <vector>
 
 namespace search {
     struct RankedHit;
     class BitVector;
 }
 
+namespace vespalib { struct ThreadBundle; }
+
 namespace search::grouping {
 
 class GroupingContext;
@@ -80,6 +83,17 @@ public:
      **/
     void merge(GroupingContext &ctx);
 
+    /**
+     * Merge several grouping contexts into the underlying context of
+     * this manager. Groupings with many first level groups are merged
+     * using all threads in the given thread bundle, where each thread
+     * merges the groups in a separate partition of group id hashes.
+     *
+     * @param others contexts to merge into the underlying context of this manager
+     * @param thread_bundle threads used to merge partitions in parallel
+     **/
+    void merge(const std::vector<GroupingContext *> &others, vespalib::ThreadBundle &thread_bundle);
+
     /**
      * Called after merge has been called (possibly multiple times) to
      * prune unwanted information from the underlying grouping
@@ -15,6 +15,7 @@
 #include <vespa/searchlib/attribute/attribute_read_guard.h>
 #include <vespa/searchlib/attribute/attributecontext.h>
 #include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/searchlib/attribute/filter_search_cache.h>
 #include <vespa/searchlib/attribute/imported_attribute_vector.h>
 #include <vespa/searchlib/attribute/interlock.h>
 #include <vespa/searchlib/common/flush_token.h>
@@ -35,6 +36,7 @@ using search::AttributeGuard;
 using search::AttributeVector;
 using search::common::ThreadedCompactableLidSpace;
 using search::TuneFileAttributes;
+using search::attribute::FilterSearchCache;
 using search::attribute::IAttributeContext;
 using search::attribute::IAttributeVector;
 using search::common::FileHeaderContext;
@@ -262,7 +264,8 @@ AttributeManager::AttributeManager(const vespalib::string &baseDir,
       _attributeFieldWriter(attributeFieldWriter),
       _shared_executor(shared_executor),
       _hwInfo(hwInfo),
-      _importedAttributes()
+      _importedAttributes(),
+      _filter_search_cache(std::make_shared<FilterSearchCache>())
 {
 }
 
@@ -288,7 +291,8 @@ AttributeManager::AttributeManager(const vespalib::string &baseDir,
       _attributeFieldWriter(attributeFieldWriter),
       _shared_executor(shared_executor),
       _hwInfo(hwInfo),
-      _importedAttributes()
+      _importedAttributes(),
+      _filter_search_cache(std::make_shared<FilterSearchCache>())
 {
 }
 
@@ -308,7 +312,8 @@ AttributeManager::AttributeManager(const AttributeManager &currMgr,
       _attributeFieldWriter(currMgr._attributeFieldWriter),
       _shared_executor(currMgr._shared_executor),
       _hwInfo(currMgr._hwInfo),
-      _importedAttributes()
+      _importedAttributes(),
+      _filter_search_cache(std::make_shared<FilterSearchCache>())
 {
     Spec::AttributeList toBeAdded = transferExistingAttributes(currMgr, newSpec.stealAttributes());
     addNewAttributes(newSpec, std::move(toBeAdded), initializerRegistry);
@@ -87,6 +87,7 @@ private:
     vespalib::Executor& _shared_executor;
     HwInfo _hwInfo;
     std::unique_ptr<ImportedAttributesRepo> _importedAttributes;
+    std::shared_ptr<search::attribute::FilterSearchCache> _filter_search_cache;
 
     AttributeVectorSP internalAddAttribute(AttributeSpec && spec, uint64_t serialNum, const IAttributeFactory &factory);
     void addAttribute(AttributeWrap attribute, const ShrinkerSP &shrinker);
@@ -185,6 +186,8 @@ public:
 
     const ImportedAttributesRepo *getImportedAttributes() const override { return _importedAttributes.get(); }
 
+    std::shared_ptr<search::attribute::FilterSearchCache> get_filter_search_cache() const override { return _filter_search_cache; }
+
     std::shared_ptr<search::attribute::ReadableAttributeVector> readable_attribute_vector(const string& name) const override;
 
     TransientResourceUsage get_transient_resource_usage() const override;
@@ -28,6 +28,7 @@ AttributesConfigScout::adjust(AttributesConfig::Attribute &attr,
     attr.enableonlybitvector = liveAttr.enableonlybitvector;
     attr.fastsearch = liveAttr.fastsearch;
     attr.paged = liveAttr.paged;
+    attr.compressed = liveAttr.compressed;
     // Note: Predicate attributes only handle changes for the dense-posting-list-threshold config.
     attr.densepostinglistthreshold = liveAttr.densepostinglistthreshold;
     attr.distancemetric = liveAttr.distancemetric;
@@ -249,6 +249,12 @@ FilterAttributeManager::getImportedAttributes() const
     return nullptr;
 }
 
+std::shared_ptr<search::attribute::FilterSearchCache>
+FilterAttributeManager::get_filter_search_cache() const
+{
+    return {};
+}
+
 std::shared_ptr<search::attribute::ReadableAttributeVector>
 FilterAttributeManager::readable_attribute_vector(const string& name) const
 {
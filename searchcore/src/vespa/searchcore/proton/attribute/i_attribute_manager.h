@@ -11,7 +11,10 @@
 #include <vespa/searchlib/attribute/iattributemanager.h>
 #include <vespa/searchlib/common/serialnum.h>
 
-namespace search::attribute { class IAttributeFunctor; }
+namespace search::attribute {
+    class FilterSearchCache;
+    class IAttributeFunctor;
+}
 
 namespace vespalib {
     class ISequencedTaskExecutor;
@@ -107,6 +110,11 @@ struct IAttributeManager : public search::IAttributeManager
 
     virtual const ImportedAttributesRepo *getImportedAttributes() const = 0;
 
+    /**
+     * Returns the cache used for the results of filter terms searched in these attributes, if any.
+     */
+    virtual std::shared_ptr<search::attribute::FilterSearchCache> get_filter_search_cache() const = 0;
+
     virtual TransientResourceUsage get_transient_resource_usage() const = 0;
 };
 
@@ -18,6 +18,7 @@ using document::select::FloatValue;
 using document::select::IntegerValue;
 using document::select::NullValue;
 using document::select::StringValue;
+using document::select::TypedValue;
 using document::select::Value;
 using document::select::ValueNode;
 using document::select::Visitor;
@@ -93,6 +94,61 @@ getValue(const Context &context) const
 }
 
 
+bool
+AttributeFieldValueNode::load_typed_value(const Context &context, TypedValue &result) const
+{
+    // Same values as getValue(), without allocating a Value
+    const auto &sc(static_cast<const SelectContext &>(context));
+    uint32_t docId(sc._docId);
+    assert(docId != 0u);
+    const auto& v = sc.guarded_attribute_at_index(_attr_guard_index);
+    if (v.isUndefined(docId)) {
+        result.type = Value::Null;
+        return true;
+    }
+    switch (v.getBasicType()) {
+        case BasicType::STRING:
+            {
+                // String attributes hand out pointers into their own storage
+                AttributeContent<const char *> content;
+                content.fill(v, docId);
+                assert(content.size() == 1u);
+                result.type = Value::String;
+                result.string_value = content[0];
+                return true;
+            };
+        case BasicType::BOOL:
+        case BasicType::UINT2:
+        case BasicType::UINT4:
+        case BasicType::INT8:
+        case BasicType::INT16:
+        case BasicType::INT32:
+        case BasicType::INT64:
+            {
+                AttributeContent<IAttributeVector::largeint_t> content;
+                content.fill(v, docId);
+                assert(content.size() == 1u);
+                result.type = Value::Integer;
+                result.int_value = content[0];
+                return true;
+            }
+        case BasicType::FLOAT:
+        case BasicType::DOUBLE:
+            {
+                AttributeContent<double> content;
+                content.fill(v, docId);
+                assert(content.size() == 1u);
+                result.type = Value::Float;
+                result.float_value = content[0];
+                return true;
+            };
+        default:
+            // Let getValue() report the unsupported type
+            return false;
+    }
+}
+
+
 std::unique_ptr<Value>
 AttributeFieldValueNode::traceValue(const Context &context, std::ostream& out) const
 {
@@ -1,12 +1,14 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <vespa/document/select/compiled_selection.h>
 #include <vespa/document/select/valuenodes.h>
 
 namespace search { class ReadableAttributeVector; }
 namespace proton {
 
-class AttributeFieldValueNode : public document::select::FieldValueNode
+class AttributeFieldValueNode : public document::select::FieldValueNode,
+                                public document::select::TypedValueNode
 {
     using Context = document::select::Context;
     uint32_t _attr_guard_index;
@@ -18,6 +20,7 @@ public:
                             uint32_t attr_guard_index);
 
     std::unique_ptr<document::select::Value> getValue(const Context &context) const override;
+    bool load_typed_value(const Context &context, document::select::TypedValue &result) const override;
     std::unique_ptr<document::select::Value> traceValue(const Context &context, std::ostream& out) const override;
     document::select::ValueNode::UP clone() const override;
 };
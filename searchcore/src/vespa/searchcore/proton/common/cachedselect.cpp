@@ -5,6 +5,7 @@
 #include "select_utils.h"
 #include "selectcontext.h"
 #include "selectpruner.h"
+#include <vespa/document/select/compiled_selection.h>
 #include <vespa/document/select/parser.h>
 #include <vespa/searchlib/attribute/attributevector.h>
 #include <vespa/searchlib/attribute/attribute_read_guard.h>
@@ -20,9 +21,16 @@ using search::attribute::CollectionType;
 using search::attribute::BasicType;
 
 using NodeUP = std::unique_ptr<document::select::Node>;
+using document::select::CompiledSelection;
 
 namespace {
 
+std::unique_ptr<CompiledSelection>
+compile(const NodeUP& node)
+{
+    return node ? std::make_unique<CompiledSelection>(*node) : std::unique_ptr<CompiledSelection>();
+}
+
 class AttrVisitor : public document::select::CloningVisitor
 {
 public:
@@ -125,25 +133,30 @@ CachedSelect::Session::Session(std::unique_ptr<document::select::Node> docSelect
                                std::unique_ptr<document::select::Node> preDocSelect)
     : _docSelect(std::move(docSelect)),
       _preDocOnlySelect(std::move(preDocOnlySelect)),
-      _preDocSelect(std::move(preDocSelect))
+      _preDocSelect(std::move(preDocSelect)),
+      _compiledDocSelect(compile(_docSelect)),
+      _compiledPreDocOnlySelect(compile(_preDocOnlySelect)),
+      _compiledPreDocSelect(compile(_preDocSelect))
 {
 }
 
+CachedSelect::Session::~Session() = default;
+
 bool
 CachedSelect::Session::contains(const SelectContext &context) const
 {
-    if (_preDocSelect && (_preDocSelect->contains(context) == document::select::Result::False)) {
+    if (_compiledPreDocSelect && (_compiledPreDocSelect->evaluate(context) == document::select::Result::False)) {
         return false;
     }
-    return (!_preDocOnlySelect) ||
-            (_preDocOnlySelect && (_preDocOnlySelect->contains(context) == document::select::Result::True));
+    return (!_compiledPreDocOnlySelect) ||
+            (_compiledPreDocOnlySelect->evaluate(context) == document::select::Result::True);
 }
 
 bool
 CachedSelect::Session::contains(const document::Document &doc) const
 {
     return (_preDocOnlySelect) ||
-            (_docSelect && (_docSelect->contains(doc) == document::select::Result::True));
+            (_compiledDocSelect && (_compiledDocSelect->evaluate(doc) == document::select::Result::True));
 }
 
 const document::select::Node &
@@ -9,7 +9,10 @@
 namespace document {
     class DocumentTypeRepo;
     class Document;
-    namespace select { class Node; }
+    namespace select {
+        class CompiledSelection;
+        class Node;
+    }
 }
 namespace search {
     class AttributeVector;
@@ -32,16 +35,24 @@ class CachedSelect
 public:
     using SP = std::shared_ptr<CachedSelect>;
 
+    /**
+     * Per thread copy of the selection expressions, compiled for
+     * evaluation against many documents.
+     */
     class Session {
     private:
         std::unique_ptr<document::select::Node> _docSelect;
         std::unique_ptr<document::select::Node> _preDocOnlySelect;
         std::unique_ptr<document::select::Node> _preDocSelect;
+        std::unique_ptr<document::select::CompiledSelection> _compiledDocSelect;
+        std::unique_ptr<document::select::CompiledSelection> _compiledPreDocOnlySelect;
+        std::unique_ptr<document::select::CompiledSelection> _compiledPreDocSelect;
 
     public:
         Session(std::unique_ptr<document::select::Node> docSelect,
                 std::unique_ptr<document::select::Node> preDocOnlySelect,
                 std::unique_ptr<document::select::Node> preDocSelect);
+        ~Session();
         bool contains(const SelectContext &context) const;
         bool contains(const document::Document &doc) const;
         const document::select::Node &selectNode() const;
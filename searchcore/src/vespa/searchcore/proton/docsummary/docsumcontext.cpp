@@ -9,6 +9,7 @@
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.docsummary.docsumcontext");
@@ -43,6 +44,10 @@ Memory TYPE("type");
 Memory MESSAGE("message");
 Memory TIMEOUT("timeout");
 
+// Number of documents fetched from the document store at a time, bounding memory use
+// while still letting hits in the same chunk share a single read and decompression.
+constexpr size_t PREFETCH_BATCH_SIZE = 256;
+
 }
 
 void
@@ -80,9 +85,14 @@ DocsumContext::createSlimeReply()
     Cursor & array = root.setArray(DOCSUMS);
     const Symbol docsumSym = response->insert(DOCSUM);
     _docsumState._omit_summary_features = (rci.res_class != nullptr) ? rci.res_class->omit_summary_features() : true;
+    const bool prefetch = (rci.res_class != nullptr) && ! rci.all_fields_generated;
+    const auto & docIds = _docsumState._docsumbuf;
     uint32_t num_ok(0);
-    for (uint32_t docId : _docsumState._docsumbuf) {
+    for (uint32_t docId : docIds) {
         if (_request.expired() ) { break; }
+        if (prefetch && ((num_ok % PREFETCH_BATCH_SIZE) == 0)) {
+            prefetchDocuments(num_ok, std::min(docIds.size(), num_ok + PREFETCH_BATCH_SIZE));
+        }
         Cursor &docSumC = array.addObject();
         ObjectSymbolInserter inserter(docSumC, docsumSym);
         if ((docId != search::endDocId) && rci.res_class != nullptr) {
@@ -101,6 +111,23 @@ DocsumContext::createSlimeReply()
     return response;
 }
 
+void
+DocsumContext::prefetchDocuments(size_t begin, size_t end)
+{
+    std::vector<uint32_t> docIds;
+    docIds.reserve(end - begin);
+    for (size_t i(begin); i < end; i++) {
+        uint32_t docId = _docsumState._docsumbuf[i];
+        if (docId != search::endDocId) {
+            docIds.push_back(docId);
+        }
+    }
+    // A document requested more than once is only prefetched once, later requests read it again.
+    std::sort(docIds.begin(), docIds.end());
+    docIds.erase(std::unique(docIds.begin(), docIds.end()), docIds.end());
+    _docsumStore.prefetch(docIds);
+}
+
 DocsumContext::DocsumContext(const DocsumRequest & request, IDocsumWriter & docsumWriter,
                              IDocsumStore & docsumStore, std::shared_ptr<Matcher> matcher,
                              ISearchContext & searchCtx, IAttributeContext & attrCtx,
@@ -33,6 +33,7 @@ private:
 
     void initState();
     std::unique_ptr<vespalib::Slime> createSlimeReply();
+    void prefetchDocuments(size_t begin, size_t end);
 
 public:
     using UP = std::unique_ptr<DocsumContext>;
@@ -7,6 +7,7 @@
 #include <vespa/eval/eval/value_codec.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/document/fieldvalue/tensorfieldvalue.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.docsummary.documentstoreadapter");
@@ -20,13 +21,30 @@ namespace {
 
 const vespalib::string DOCUMENT_ID_FIELD("documentid");
 
+class PrefetchVisitor : public search::IDocumentVisitor
+{
+public:
+    explicit PrefetchVisitor(vespalib::hash_map<uint32_t, DocumentUP> & documents) : _documents(documents) { }
+    void visit(uint32_t lid, DocumentUP doc) override {
+        if (doc) {
+            _documents[lid] = std::move(doc);
+        }
+    }
+    // Docsum reads are random, and must not fill the visit cache, but should fill the document cache.
+    bool allowVisitCaching() const override { return false; }
+    bool allowDocumentCaching() const override { return true; }
+private:
+    vespalib::hash_map<uint32_t, DocumentUP> & _documents;
+};
+
 }
 
 DocumentStoreAdapter::
 DocumentStoreAdapter(const search::IDocumentStore & docStore,
                      const DocumentTypeRepo &repo)
     : _docStore(docStore),
-      _repo(repo)
+      _repo(repo),
+      _prefetched()
 {
 }
 
@@ -35,7 +53,14 @@ DocumentStoreAdapter::~DocumentStoreAdapter() = default;
 std::unique_ptr<const IDocsumStoreDocument>
 DocumentStoreAdapter::get_document(uint32_t docId)
 {
-    auto document = _docStore.read(docId, _repo);
+    DocumentUP document;
+    auto found = _prefetched.find(docId);
+    if (found != _prefetched.end()) {
+        document = std::move(found->second);
+        _prefetched.erase(found);
+    } else {
+        document = _docStore.read(docId, _repo);
+    }
     if ( ! document) {
         LOG(debug, "Did not find summary document for docId %u. Returning empty docsum", docId);
         return {};
@@ -44,4 +69,15 @@ DocumentStoreAdapter::get_document(uint32_t docId)
     return std::make_unique<DocsumStoreDocument>(std::move(document));
 }
 
+void
+DocumentStoreAdapter::prefetch(const std::vector<uint32_t> & docIds)
+{
+    _prefetched.clear();
+    if (docIds.size() < 2) {
+        return;
+    }
+    PrefetchVisitor visitor(_prefetched);
+    _docStore.visit(docIds, _repo, visitor);
+}
+
 } // namespace proton
@@ -4,14 +4,17 @@
 
 #include <vespa/searchsummary/docsummary/docsumstore.h>
 #include <vespa/searchlib/docstore/idocumentstore.h>
+#include <vespa/vespalib/stllike/hash_map.h>
 
 namespace proton {
 
 class DocumentStoreAdapter : public search::docsummary::IDocsumStore
 {
 private:
+    using DocumentUP = std::unique_ptr<document::Document>;
     const search::IDocumentStore           & _docStore;
     const document::DocumentTypeRepo       & _repo;
+    vespalib::hash_map<uint32_t, DocumentUP> _prefetched;
 
 public:
     DocumentStoreAdapter(const search::IDocumentStore &docStore,
@@ -19,6 +22,11 @@ public:
     ~DocumentStoreAdapter();
 
     std::unique_ptr<const search::docsummary::IDocsumStoreDocument> get_document(uint32_t docId) override;
+    /**
+     * Reads the given documents with a single visit of the document store, which lets the
+     * log data store read and decompress each chunk once for all the documents it holds.
+     **/
+    void prefetch(const std::vector<uint32_t> & docIds) override;
 };
 
 } // namespace proton
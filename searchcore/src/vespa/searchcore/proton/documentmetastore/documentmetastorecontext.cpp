@@ -18,14 +18,16 @@ DocumentMetaStoreContext::DocumentMetaStoreContext(std::shared_ptr<bucketdb::Buc
                                                    const vespalib::string &name,
                                                    const search::GrowStrategy &grow)
     : _metaStoreAttr(std::make_shared<DocumentMetaStore>(std::move(bucketDB), name, grow)),
-      _metaStore(std::dynamic_pointer_cast<IDocumentMetaStore>(_metaStoreAttr))
+      _metaStore(std::dynamic_pointer_cast<IDocumentMetaStore>(_metaStoreAttr)),
+      _visibleSerialNum(0)
 {
 }
 
 
 DocumentMetaStoreContext::DocumentMetaStoreContext(const search::AttributeVector::SP &metaStoreAttr) :
     _metaStoreAttr(metaStoreAttr),
-    _metaStore(std::dynamic_pointer_cast<IDocumentMetaStore>(_metaStoreAttr))
+    _metaStore(std::dynamic_pointer_cast<IDocumentMetaStore>(_metaStoreAttr)),
+    _visibleSerialNum(0)
 {
 }
 
@@ -37,4 +39,16 @@ DocumentMetaStoreContext::constructFreeList()
     _metaStore->constructFreeList();
 }
 
+void
+DocumentMetaStoreContext::bumpVisibleSerialNum(search::SerialNum serialNum)
+{
+    search::SerialNum oldSerialNum = _visibleSerialNum.load(std::memory_order_relaxed);
+    while ((serialNum > oldSerialNum) &&
+           !_visibleSerialNum.compare_exchange_weak(oldSerialNum, serialNum,
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed))
+    {
+    }
+}
+
 }
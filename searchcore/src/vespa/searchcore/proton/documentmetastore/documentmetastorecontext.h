@@ -4,6 +4,7 @@
 
 #include "documentmetastore.h"
 #include "i_document_meta_store_context.h"
+#include <atomic>
 
 namespace proton {
 
@@ -25,6 +26,7 @@ public:
 private:
     search::AttributeVector::SP _metaStoreAttr;
     IDocumentMetaStore::SP      _metaStore;
+    std::atomic<search::SerialNum> _visibleSerialNum;
 public:
 
     explicit DocumentMetaStoreContext(std::shared_ptr<bucketdb::BucketDBOwner> bucketDB);
@@ -49,6 +51,10 @@ public:
     }
 
     void constructFreeList() override;
+    search::SerialNum getVisibleSerialNum() const override {
+        return _visibleSerialNum.load(std::memory_order_acquire);
+    }
+    void bumpVisibleSerialNum(search::SerialNum serialNum) override;
 };
 
 } // namespace proton
@@ -27,6 +27,15 @@ struct IDocumentMetaStoreContext : public search::IDocumentMetaStoreContext {
      * Construct free lists of underlying meta store.
      */
     virtual void constructFreeList() = 0;
+
+    /**
+     * Serial number of the last forced commit that is fully visible to
+     * search. Unlike the last serial number of the meta store, this is
+     * only advanced when the attribute and memory index commits for the
+     * same forced commit are done as well.
+     */
+    virtual search::SerialNum getVisibleSerialNum() const = 0;
+    virtual void bumpVisibleSerialNum(search::SerialNum serialNum) = 0;
 };
 
 } // namespace proton
@@ -26,6 +26,13 @@ using searchcorespi::index::IThreadingService;
 
 namespace proton::index {
 
+namespace {
+
+// Max number of word ranges merged in parallel for a single large field during fusion
+constexpr uint32_t max_field_merge_partitions = 4;
+
+}
+
 IndexManager::MaintainerOperations::MaintainerOperations(const FileHeaderContext &fileHeaderContext,
                                                          const TuneFileIndexManager &tuneFileIndexManager,
                                                          size_t cacheSize,
@@ -71,6 +78,7 @@ IndexManager::MaintainerOperations::runFusion(const Schema &schema,
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext, serialNum);
     Fusion fusion(schema, outputDir, sources, selectorArray,
                   _tuneFileIndexing, fileHeaderContext);
+    fusion.set_max_field_merge_partitions(max_field_merge_partitions);
     return fusion.merge(_threadingService.shared(), std::move(flush_token));
 }
 
@@ -75,7 +75,7 @@ private:
     }
 
     void buildWeakAnd(ProtonWeakAnd &n) {
-        WeakAndBlueprint *wand = new WeakAndBlueprint(n.getMinHits());
+        WeakAndBlueprint *wand = new WeakAndBlueprint(n.getMinHits(), _requestContext.use_weakand_block_max());
         Blueprint::UP result(wand);
         for (size_t i = 0; i < n.getChildren().size(); ++i) {
             search::query::Node &node = *n.getChildren()[i];
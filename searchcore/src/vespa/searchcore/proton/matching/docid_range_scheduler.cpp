@@ -164,4 +164,90 @@ AdaptiveDocidRangeScheduler::share_range(size_t thread_id, DocidRange todo)
 
 //-----------------------------------------------------------------------------
 
+WorkStealingDocidRangeScheduler::WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit)
+    : _min_task(std::max(1u, min_task)),
+      _chunk_size(1),
+      _workers(num_threads)
+{
+    DocidRangeSplitter splitter(DocidRange(1, docid_limit), num_threads);
+    _chunk_size = std::max(size_t(_min_task), splitter.get(0).size() / CHUNKS_PER_THREAD);
+    for (size_t i = 0; i < num_threads; ++i) {
+        _workers[i].todo.store(pack(splitter.get(i)), std::memory_order_relaxed);
+    }
+}
+
+WorkStealingDocidRangeScheduler::~WorkStealingDocidRangeScheduler() = default;
+
+DocidRange
+WorkStealingDocidRangeScheduler::take_chunk(size_t thread_id)
+{
+    Worker &me = _workers[thread_id];
+    uint64_t old_todo = me.todo.load(std::memory_order_relaxed);
+    for (;;) {
+        DocidRange todo = unpack(old_todo);
+        if (todo.empty()) {
+            return DocidRange();
+        }
+        uint32_t mid = todo.begin + std::min(todo.size(), size_t(_chunk_size));
+        if (me.todo.compare_exchange_weak(old_todo, pack(DocidRange(mid, todo.end)), std::memory_order_relaxed)) {
+            me.assigned += (mid - todo.begin);
+            return DocidRange(todo.begin, mid);
+        }
+    }
+}
+
+bool
+WorkStealingDocidRangeScheduler::steal(size_t thread_id)
+{
+    for (;;) {
+        size_t victim = thread_id;
+        uint64_t victim_todo = 0;
+        size_t most_left = _min_task;
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            uint64_t value = _workers[i].todo.load(std::memory_order_relaxed);
+            size_t left = unpack(value).size();
+            if ((i != thread_id) && (left > most_left)) {
+                victim = i;
+                victim_todo = value;
+                most_left = left;
+            }
+        }
+        if (victim == thread_id) {
+            return false;
+        }
+        DocidRange todo = unpack(victim_todo);
+        uint32_t mid = todo.begin + (todo.size() / 2);
+        if (_workers[victim].todo.compare_exchange_strong(victim_todo, pack(DocidRange(todo.begin, mid)),
+                                                          std::memory_order_relaxed))
+        {
+            // nobody touches an empty range, so the stolen part can simply be stored as our own
+            _workers[thread_id].todo.store(pack(DocidRange(mid, todo.end)), std::memory_order_relaxed);
+            ++_workers[thread_id].steals;
+            return true;
+        }
+    }
+}
+
+DocidRange
+WorkStealingDocidRangeScheduler::next_range(size_t thread_id)
+{
+    DocidRange range = take_chunk(thread_id);
+    if (range.empty() && steal(thread_id)) {
+        range = take_chunk(thread_id);
+    }
+    return range;
+}
+
+size_t
+WorkStealingDocidRangeScheduler::unassigned_size() const
+{
+    size_t sum = 0;
+    for (const Worker &worker : _workers) {
+        sum += unpack(worker.todo.load(std::memory_order_relaxed)).size();
+    }
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+
 }
@@ -111,6 +111,8 @@ struct DocidRangeScheduler {
     virtual size_t unassigned_size() const = 0;
     virtual IdleObserver make_idle_observer() const = 0;
     virtual DocidRange share_range(size_t thread_id, DocidRange todo) = 0;
+    // number of times the given worker took work from another worker
+    virtual size_t steal_count(size_t) const { return 0; }
     virtual ~DocidRangeScheduler() {}
 };
 
@@ -200,4 +202,47 @@ public:
     DocidRange share_range(size_t, DocidRange todo) override;
 };
 
+/**
+ * A lock-free work-stealing scheduler. Each thread owns an equal part
+ * of the docid space and works through it in chunks of increasing
+ * docid. A thread running out of work steals the upper half of the
+ * remaining part of the thread with the most work left, and continues
+ * with that as its own part. Work is done when no thread has more
+ * than 'min_task' docids left that are not already being worked on.
+ *
+ * The remaining part of each thread is kept in a single atomic
+ * word. The owner moves the beginning forward and thieves move the
+ * end backwards, both using compare-and-swap.
+ **/
+class WorkStealingDocidRangeScheduler : public DocidRangeScheduler
+{
+private:
+    static constexpr size_t CHUNKS_PER_THREAD = 16;
+    struct alignas(64) Worker {
+        std::atomic<uint64_t> todo;
+        size_t                assigned;
+        size_t                steals;
+        Worker() noexcept : todo(0), assigned(0), steals(0) {}
+    };
+    static uint64_t pack(DocidRange range) { return (uint64_t(range.begin) << 32) | range.end; }
+    static DocidRange unpack(uint64_t value) { return DocidRange(value >> 32, uint32_t(value)); }
+
+    uint32_t            _min_task;
+    uint32_t            _chunk_size;
+    std::vector<Worker> _workers;
+
+    VESPA_DLL_LOCAL DocidRange take_chunk(size_t thread_id);
+    VESPA_DLL_LOCAL bool steal(size_t thread_id);
+public:
+    WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit);
+    ~WorkStealingDocidRangeScheduler() override;
+    DocidRange first_range(size_t thread_id) override { return next_range(thread_id); }
+    DocidRange next_range(size_t thread_id) override;
+    size_t total_size(size_t thread_id) const override { return _workers[thread_id].assigned; }
+    size_t unassigned_size() const override;
+    IdleObserver make_idle_observer() const override { return IdleObserver(); }
+    DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    size_t steal_count(size_t thread_id) const override { return _workers[thread_id].steals; }
+};
+
 }
@@ -63,7 +63,7 @@ DocidRangeScheduler::UP
 createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs)
 {
     if (numSearchPartitions == 0) {
-        return std::make_unique<AdaptiveDocidRangeScheduler>(numThreads, 1, numDocs);
+        return std::make_unique<WorkStealingDocidRangeScheduler>(numThreads, 1, numDocs);
     }
     if (numSearchPartitions <= numThreads) {
         return std::make_unique<PartitionDocidRangeScheduler>(numThreads, numDocs);
@@ -113,6 +113,7 @@ MatchMaster::match(search::engine::Trace & trace,
     }
     resultProcessor.prepareThreadContextCreation(threadBundle.size());
     threadBundle.run(threadState);
+    threadState[0]->merge_grouping(threadBundle);
     auto reply = make_reply(mtf, resultProcessor, threadBundle, threadState[0]->extract_result());
     double query_time_s = vespalib::to_s(query_latency_time.elapsed());
     double rerank_time_s = vespalib::to_s(timedCommunicator.elapsed);
@@ -44,11 +44,17 @@ struct WaitTimer {
 
 // seek_next maps to SearchIterator::seekNext
 struct SimpleStrategy {
+    static constexpr bool rank_in_blocks = false;
     static uint32_t seek_next(SearchIterator &search, uint32_t docid) {
         return search.seekNext(docid);
     }
 };
 
+// used when the first phase score can be calculated for a block of hits at a time without unpacking them
+struct BlockRankStrategy : SimpleStrategy {
+    static constexpr bool rank_in_blocks = true;
+};
+
 LazyValue get_score_feature(const RankProgram &rankProgram) {
     FeatureResolver resolver(rankProgram.get_seeds());
     assert(resolver.num_features() == 1u);
@@ -63,9 +69,13 @@ MatchThread::Context::Context(double rankDropLimit, MatchTools &tools, HitCollec
     : matches(0),
       _matches_limit(tools.match_limiter().sample_hits_per_thread(num_threads)),
       _score_feature(get_score_feature(tools.rank_program())),
+      _batch_evaluator(tools.first_phase_batch()),
       _rankDropLimit(rankDropLimit),
       _hits(hits),
       _doom(tools.getDoom()),
+      _block_size(0),
+      _block(),
+      _scores(),
       dropped()
 {
 }
@@ -89,6 +99,30 @@ MatchThread::Context::rankHit(uint32_t docId) {
     }
 }
 
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::rankBlock() {
+    const uint32_t n = _block_size;
+    _batch_evaluator->evaluate(vespalib::ConstArrayRef<uint32_t>(_block.data(), n), _scores.data());
+    // convert NaN and Inf scores to -Inf, branch free so that it can be vectorized
+    for (uint32_t i = 0; i < n; ++i) {
+        double score = _scores[i];
+        _scores[i] = (std::isfinite(score)) ? score : -HUGE_VAL;
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+        if (use_rank_drop_limit != RankDropLimitE::no) {
+            if (__builtin_expect(_scores[i] > _rankDropLimit, true)) {
+                _hits.addHit(_block[i], _scores[i]);
+            } else if (use_rank_drop_limit == RankDropLimitE::track) {
+                dropped.template emplace_back(_block[i]);
+            }
+        } else {
+            _hits.addHit(_block[i], _scores[i]);
+        }
+    }
+    _block_size = 0;
+}
+
 //-----------------------------------------------------------------------------
 
 double
@@ -150,8 +184,12 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
     uint32_t docId = search->seekFirst(docid_range.begin);
     while ((docId < docid_range.end) && !context.atSoftDoom()) {
         if (do_rank) {
-            search->unpack(docId);
-            context.rankHit<use_rank_drop_limit>(docId);
+            if constexpr (Strategy::rank_in_blocks) {
+                context.deferRankHit<use_rank_drop_limit>(docId);
+            } else {
+                search->unpack(docId);
+                context.rankHit<use_rank_drop_limit>(docId);
+            }
         } else {
             context.addHit(docId);
         }
@@ -166,6 +204,9 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
             docId = Strategy::seek_next(*search, docId + 1);
         }
     }
+    if constexpr (do_rank && Strategy::rank_in_blocks) {
+        context.rankBlock<use_rank_drop_limit>();
+    }
     return docId;
 }
 
@@ -202,6 +243,7 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     thread_stats.docsCovered(docsCovered);
     thread_stats.docsMatched(matches);
     thread_stats.softDoomed(softDoomed);
+    thread_stats.docidRangeSteals(scheduler.steal_count(thread_id));
     if (softDoomed) {
         thread_stats.doomOvertime(overtime);
     }
@@ -221,6 +263,12 @@ template <bool do_rank, bool do_limit, bool do_share, MatchThread::RankDropLimit
 void
 MatchThread::match_loop_helper_rank_limit_share_drop(MatchTools &tools, HitCollector &hits)
 {
+    if constexpr (do_rank) {
+        if (tools.first_phase_batch() != nullptr) {
+            match_loop<BlockRankStrategy, do_rank, do_limit, do_share, use_rank_drop_limit>(tools, hits);
+            return;
+        }
+    }
     match_loop<SimpleStrategy, do_rank, do_limit, do_share, use_rank_drop_limit>(tools, hits);
 }
 
@@ -279,6 +327,9 @@ MatchThread::findMatches(MatchTools &tools)
         LOG(spam, "SearchIterator: %s", tools.search().asString().c_str());
     }
     tools.give_back_search(search::queryeval::MultiBitVectorIteratorBase::optimize(tools.borrow_search()));
+    if (const auto *limiter = matchToolsFactory.sorted_top_k_limiter()) {
+        tools.give_back_search(limiter->limit(tools.borrow_search()));
+    }
     if (isFirstThread()) {
         LOG(debug, "SearchIterator after MultiBitVectorIteratorBase::optimize(): %s", tools.search().asString().c_str());
         if (trace->shouldTrace(7)) {
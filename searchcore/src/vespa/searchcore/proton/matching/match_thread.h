@@ -16,6 +16,9 @@
 #include <vespa/searchlib/common/unique_issues.h>
 #include <vespa/searchlib/queryeval/hitcollector.h>
 #include <vespa/searchlib/fef/featureexecutor.h>
+#include <array>
+
+namespace search::fef { class BatchFeatureEvaluator; }
 
 namespace search::engine {
     class Trace;
@@ -77,6 +80,16 @@ private:
                 uint32_t num_threads) __attribute__((noinline));
         template <RankDropLimitE use_rank_drop_limit>
         void rankHit(uint32_t docId);
+        // Collects hits that can be ranked without unpacking, and ranks them a block at a time.
+        template <RankDropLimitE use_rank_drop_limit>
+        void deferRankHit(uint32_t docId) {
+            _block[_block_size++] = docId;
+            if (__builtin_expect(_block_size == RANK_BLOCK_SIZE, false)) {
+                rankBlock<use_rank_drop_limit>();
+            }
+        }
+        template <RankDropLimitE use_rank_drop_limit>
+        void rankBlock() __attribute__((noinline));
         void addHit(uint32_t docId) { _hits.addHit(docId, search::zero_rank_value); }
         bool isBelowLimit() const { return matches < _matches_limit; }
         bool    isAtLimit() const { return matches == _matches_limit; }
@@ -84,11 +97,16 @@ private:
         vespalib::duration timeLeft() const { return _doom.soft_left(); }
         uint32_t        matches;
     private:
+        static constexpr uint32_t RANK_BLOCK_SIZE = 128;
         uint32_t        _matches_limit;
         LazyValue       _score_feature;
+        search::fef::BatchFeatureEvaluator *_batch_evaluator;
         double          _rankDropLimit;
         HitCollector   &_hits;
         const Doom     &_doom;
+        uint32_t        _block_size;
+        std::array<uint32_t, RANK_BLOCK_SIZE> _block;
+        std::array<double, RANK_BLOCK_SIZE>   _scores;
     public:
         std::vector<uint32_t> dropped;
     };
@@ -137,6 +155,7 @@ public:
     const MatchingStats::Partition &get_thread_stats() const { return thread_stats; }
     double get_match_time() const { return match_time_s; }
     PartialResult::UP extract_result() { return std::move(resultContext->result); }
+    void merge_grouping(vespalib::ThreadBundle &thread_bundle) { resultContext->groupingSource.mergeGrouping(thread_bundle); }
     const Trace & getTrace() const { return *trace; }
     const UniqueIssues &get_issues() const { return my_issues; }
 };
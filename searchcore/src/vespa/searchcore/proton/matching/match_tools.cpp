@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "match_tools.h"
+#include "match_params.h"
 #include "querynodes.h"
 #include "rangequerylocator.h"
 #include <vespa/searchcorespi/index/indexsearchable.h>
@@ -78,6 +79,7 @@ MatchTools::setup(std::unique_ptr<RankProgram> rank_program, ExecutionProfiler *
     if (_search) {
         _match_data->soft_reset();
     }
+    _first_phase_batch.reset();
     _rank_program = std::move(rank_program);
     HandleRecorder recorder;
     {
@@ -112,6 +114,7 @@ MatchTools::MatchTools(QueryLimiter & queryLimiter,
       _featureOverrides(featureOverrides),
       _match_data(mdl.createMatchData()),
       _rank_program(),
+      _first_phase_batch(),
       _search(),
       _used_handles(),
       _search_has_changed(false)
@@ -130,6 +133,7 @@ MatchTools::setup_first_phase(ExecutionProfiler *profiler)
 {
     setup(_rankSetup.create_first_phase_program(), profiler,
           TermwiseLimit::lookup(_queryEnv.getProperties(), _rankSetup.get_termwise_limit()));
+    _first_phase_batch = _rank_program->make_batch_evaluator();
 }
 
 void
@@ -179,11 +183,13 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
       _query(),
       _match_limiter(),
       _queryEnv(indexEnv, attributeContext, rankProperties, searchContext.getIndexes()),
-      _requestContext(doom, attributeContext, _queryEnv, _queryEnv.getObjectStore(), _global_filter_params),
+      _requestContext(doom, attributeContext, _queryEnv, _queryEnv.getObjectStore(), _global_filter_params,
+                      WeakAndBlockMax::lookup(rankProperties, rankSetup.get_weakand_block_max())),
       _mdl(),
       _rankSetup(rankSetup),
       _featureOverrides(featureOverrides),
       _diversityParams(),
+      _sorted_top_k_limiter(),
       _valid(false)
 {
     search::engine::Trace trace(root_trace.getRelativeTime(), root_trace.getLevel(), root_trace.getProfileDepth());
@@ -235,6 +241,42 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
 
 MatchToolsFactory::~MatchToolsFactory() = default;
 
+void
+MatchToolsFactory::setup_sorted_top_k(ISearchContext &searchContext, vespalib::stringref sort_spec,
+                                      const MatchParams &params, bool has_grouping)
+{
+    // A rank drop limit removes hits after matching, so the prefix could hold too few of them
+    if (!_valid || has_grouping || params.has_rank_drop_limit() || _match_limiter->is_enabled() ||
+        !SortedTopK::lookup(_queryEnv.getProperties(), _rankSetup.get_sorted_top_k()) ||
+        hasOnMatchTask() || createOnFirstPhaseTask())
+    {
+        return;
+    }
+    vespalib::string attribute = SortedTopKLimiter::descending_sort_attribute(sort_spec);
+    if (attribute.empty()) {
+        return;
+    }
+    const auto * attr = _requestContext.getAttribute(attribute);
+    const search::fef::FieldInfo * fieldInfo = _queryEnv.getIndexEnvironment().getFieldByName(attribute);
+    if ((attr == nullptr) || (fieldInfo == nullptr) || attr->isImported() || !attr->getIsFastSearch() ||
+        (attr->getCollectionType() != search::attribute::CollectionType::SINGLE) || !attr->isIntegerType())
+    {
+        return;
+    }
+    search::queryeval::Blueprint::HitEstimate est = estimate();
+    if (est.empty) {
+        return;
+    }
+    _rangeLocator = std::make_unique<LocateRangeItemFromQuery>(*_query.peekRoot(), fieldInfo->id());
+    auto limiter = std::make_unique<SortedTopKLimiter>(*_rangeLocator, searchContext.getAttributes(),
+                                                       _requestContext, attribute);
+    if (limiter->setup(_query, _mdl, params.offset + params.hits, est.estHits,
+                       searchContext.getDocIdLimit(), _requestContext.getDoom()))
+    {
+        _sorted_top_k_limiter = std::move(limiter);
+    }
+}
+
 MatchTools::UP
 MatchToolsFactory::createMatchTools() const
 {
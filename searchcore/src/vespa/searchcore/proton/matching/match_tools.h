@@ -10,6 +10,7 @@
 #include "match_phase_limiter.h"
 #include "handlerecorder.h"
 #include "requestcontext.h"
+#include "sorted_top_k_limiter.h"
 #include <vespa/searchcommon/attribute/i_attribute_functor.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
 #include <vespa/searchlib/common/idocumentmetastore.h>
@@ -24,12 +25,15 @@ namespace vespalib { struct ThreadBundle; }
 namespace search::engine { class Trace; }
 
 namespace search::fef {
+    class BatchFeatureEvaluator;
     class RankProgram;
     class RankSetup;
 }
 
 namespace proton::matching {
 
+struct MatchParams;
+
 class MatchTools
 {
 private:
@@ -40,6 +44,7 @@ private:
     using Properties = search::fef::Properties;
     using RankProgram = search::fef::RankProgram;
     using RankSetup = search::fef::RankSetup;
+    using BatchFeatureEvaluator = search::fef::BatchFeatureEvaluator;
     using ExecutionProfiler = vespalib::ExecutionProfiler;
     QueryLimiter                    &_queryLimiter;
     const vespalib::Doom            &_doom;
@@ -50,6 +55,7 @@ private:
     const Properties                &_featureOverrides;
     std::unique_ptr<MatchData>       _match_data;
     std::unique_ptr<RankProgram>     _rank_program;
+    std::unique_ptr<BatchFeatureEvaluator> _first_phase_batch;
     std::unique_ptr<SearchIterator>  _search;
     HandleRecorder::HandleMap        _used_handles;
     bool                             _search_has_changed;
@@ -73,6 +79,13 @@ public:
     bool has_second_phase_rank() const;
     const MatchData &match_data() const { return *_match_data; }
     RankProgram &rank_program() { return *_rank_program; }
+    /**
+     * Evaluator calculating the first phase score for a block of hits
+     * at a time without unpacking them. Only available after
+     * setup_first_phase, and only when the first phase rank program
+     * supports it (see RankProgram::make_batch_evaluator).
+     **/
+    BatchFeatureEvaluator *first_phase_batch() { return _first_phase_batch.get(); }
     SearchIterator &search() { return *_search; }
     std::unique_ptr<SearchIterator> borrow_search() { return std::move(_search); }
     void give_back_search(std::unique_ptr<SearchIterator> search_in) { _search = std::move(search_in); }
@@ -122,6 +135,7 @@ private:
     const RankSetup           & _rankSetup;
     const Properties          & _featureOverrides;
     DiversityParams             _diversityParams;
+    std::unique_ptr<SortedTopKLimiter> _sorted_top_k_limiter;
     bool                        _valid;
 
     std::unique_ptr<AttributeOperationTask>
@@ -149,6 +163,16 @@ public:
     ~MatchToolsFactory();
     bool valid() const { return _valid; }
     const MaybeMatchPhaseLimiter &match_limiter() const { return *_match_limiter; }
+    /**
+     * Limit first phase matching to a prefix of the documents in sort
+     * order if sorted top-k matching is enabled and can be used for
+     * this query, cf. SortedTopKLimiter. Must be called before any
+     * match tools are created.
+     **/
+    void setup_sorted_top_k(ISearchContext &searchContext, vespalib::stringref sort_spec,
+                            const MatchParams &params, bool has_grouping);
+    // Returns nullptr if first phase matching is not limited
+    const SortedTopKLimiter *sorted_top_k_limiter() const { return _sorted_top_k_limiter.get(); }
     MatchTools::UP createMatchTools() const;
     bool should_diversify() const { return _diversityParams.enabled(); }
     std::unique_ptr<IDiversifier> createDiversifier(uint32_t heapSize) const;
@@ -239,6 +239,7 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
                            _rankSetup->getRankScoreDropLimit(), request.offset, request.maxhits,
                            !_rankSetup->getSecondPhaseRank().empty(), !willNotNeedRanking(request, groupingContext));
 
+        mtf->setup_sorted_top_k(searchContext, request.sortSpec, params, !groupingContext.empty());
         ResultProcessor rp(attrContext, metaStore, sessionMgr, groupingContext, sessionId,
                            request.sortSpec, params.offset, params.hits);
 
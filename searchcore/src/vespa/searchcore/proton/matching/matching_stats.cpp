@@ -27,6 +27,7 @@ MatchingStats::MatchingStats(double prev_soft_doom_factor)
       _docsRanked(0),
       _docsReRanked(0),
       _softDoomed(0),
+      _docidRangeSteals(0),
       _doomOvertime(),
       _softDoomFactor(prev_soft_doom_factor),
       _querySetupTime(),
@@ -48,6 +49,7 @@ MatchingStats::merge_partition(const Partition &partition, size_t id)
     _docsMatched += partition.docsMatched();
     _docsRanked += partition.docsRanked();
     _docsReRanked += partition.docsReRanked();
+    _docidRangeSteals += partition.docidRangeSteals();
     _doomOvertime.add(partition._doomOvertime);
     if (partition.softDoomed()) {
         _softDoomed = 1;
@@ -67,6 +69,7 @@ MatchingStats::add(const MatchingStats &rhs)
     _docsRanked += rhs._docsRanked;
     _docsReRanked += rhs._docsReRanked;
     _softDoomed += rhs.softDoomed();
+    _docidRangeSteals += rhs._docidRangeSteals;
     _doomOvertime.add(rhs._doomOvertime);
 
     _querySetupTime.add(rhs._querySetupTime);
@@ -63,6 +63,7 @@ public:
         size_t _docsRanked;
         size_t _docsReRanked;
         size_t _softDoomed;
+        size_t _docidRangeSteals;
         Avg    _doomOvertime;
         Avg    _active_time;
         Avg    _wait_time;
@@ -74,6 +75,7 @@ public:
               _docsRanked(0),
               _docsReRanked(0),
               _softDoomed(0),
+              _docidRangeSteals(0),
               _doomOvertime(),
               _active_time(),
               _wait_time() { }
@@ -88,6 +90,8 @@ public:
         size_t docsReRanked() const { return _docsReRanked; }
         Partition &softDoomed(bool v) { _softDoomed += v ? 1 : 0; return *this; }
         size_t softDoomed() const { return _softDoomed; }
+        Partition &docidRangeSteals(size_t value) { _docidRangeSteals = value; return *this; }
+        size_t docidRangeSteals() const { return _docidRangeSteals; }
         Partition & doomOvertime(vespalib::duration overtime) { _doomOvertime.set(vespalib::to_s(overtime)); return *this; }
         vespalib::duration doomOvertime() const { return vespalib::from_s(_doomOvertime.max()); }
 
@@ -108,6 +112,7 @@ public:
             _docsRanked += rhs._docsRanked;
             _docsReRanked += rhs._docsReRanked;
             _softDoomed += rhs._softDoomed;
+            _docidRangeSteals += rhs._docidRangeSteals;
             _doomOvertime.add(rhs._doomOvertime);
 
             _active_time.add(rhs._active_time);
@@ -124,6 +129,7 @@ private:
     size_t                 _docsRanked;
     size_t                 _docsReRanked;
     size_t                 _softDoomed;
+    size_t                 _docidRangeSteals;
     Avg                    _doomOvertime;
     using SoftDoomFactor = vespalib::datastore::AtomicValueWrapper<double>;
     SoftDoomFactor         _softDoomFactor;
@@ -164,6 +170,9 @@ public:
     MatchingStats &softDoomed(size_t value) { _softDoomed = value; return *this; }
     size_t softDoomed() const { return _softDoomed; }
 
+    MatchingStats &docidRangeSteals(size_t value) { _docidRangeSteals = value; return *this; }
+    size_t docidRangeSteals() const { return _docidRangeSteals; }
+
     vespalib::duration doomOvertime() const { return vespalib::from_s(_doomOvertime.max()); }
 
     MatchingStats &softDoomFactor(double value) { _softDoomFactor.store_relaxed(value); return *this; }
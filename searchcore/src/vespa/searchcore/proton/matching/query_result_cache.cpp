@@ -0,0 +1,292 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "query_result_cache.h"
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+#include <algorithm>
+
+using search::engine::PropertiesMap;
+using search::fef::IPropertiesVisitor;
+using search::fef::Properties;
+using search::fef::Property;
+
+namespace proton::matching {
+
+namespace {
+
+void
+appendField(vespalib::string &key, vespalib::stringref value)
+{
+    // Length prefixed, so that adjacent fields can not be confused with each other.
+    uint32_t len = value.size();
+    key.append(reinterpret_cast<const char *>(&len), sizeof(len));
+    key.append(value);
+}
+
+void
+appendField(vespalib::string &key, uint32_t value)
+{
+    key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void
+appendField(vespalib::string &key, const std::vector<char> &value)
+{
+    appendField(key, vespalib::stringref(value.data(), value.size()));
+}
+
+class SortedPropertiesCollector : public IPropertiesVisitor {
+public:
+    std::vector<std::pair<vespalib::string, Property>> properties;
+    void visitProperty(const Property::Value &key, const Property &values) override {
+        properties.emplace_back(key, values);
+    }
+};
+
+void
+appendProperties(vespalib::string &key, const Properties &props)
+{
+    SortedPropertiesCollector collector;
+    props.visitProperties(collector);
+    std::sort(collector.properties.begin(), collector.properties.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+    appendField(key, uint32_t(collector.properties.size()));
+    for (const auto &prop : collector.properties) {
+        appendField(key, prop.first);
+        appendField(key, prop.second.size());
+        for (uint32_t i = 0; i < prop.second.size(); ++i) {
+            appendField(key, prop.second.getAt(i));
+        }
+    }
+}
+
+void
+appendPropertiesMap(vespalib::string &key, const PropertiesMap &propsMap)
+{
+    std::vector<const PropertiesMap::ITR::value_type *> maps;
+    for (const auto &entry : propsMap) {
+        if (entry.second.numKeys() != 0) {
+            maps.push_back(&entry);
+        }
+    }
+    std::sort(maps.begin(), maps.end(), [](const auto *a, const auto *b) { return a->first < b->first; });
+    appendField(key, uint32_t(maps.size()));
+    for (const auto *entry : maps) {
+        appendField(key, entry->first);
+        appendProperties(key, entry->second);
+    }
+}
+
+class PropertiesSizeEstimator : public IPropertiesVisitor {
+public:
+    size_t size = 0;
+    void visitProperty(const Property::Value &key, const Property &values) override {
+        size += sizeof(Property::Value) + key.size();
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            size += sizeof(Property::Value) + values.getAt(i).size();
+        }
+    }
+};
+
+size_t
+estimateReplySize(const search::engine::SearchReply &reply)
+{
+    size_t size = sizeof(search::engine::SearchReply);
+    size += reply.hits.size() * sizeof(search::engine::SearchReply::Hit);
+    size += reply.sortIndex.size() * sizeof(uint32_t);
+    size += reply.sortData.size();
+    size += reply.groupResult.size();
+    for (const auto &name : reply.match_features.names) {
+        size += sizeof(vespalib::string) + name.size();
+    }
+    for (const auto &value : reply.match_features.values) {
+        size += sizeof(value) + (value.is_data() ? value.as_data().size : 0);
+    }
+    for (const auto &entry : reply.propertiesMap) {
+        PropertiesSizeEstimator estimator;
+        entry.second.visitProperties(estimator);
+        size += sizeof(Properties) + entry.first.size() + estimator.size;
+    }
+    return size;
+}
+
+}
+
+QueryResultCache::Entry::Entry(std::unique_ptr<const SearchReply> reply_, SerialNum serialNum_, size_t size_) noexcept
+    : reply(std::move(reply_)),
+      serialNum(serialNum_),
+      size(size_)
+{
+}
+
+QueryResultCache::Entry::~Entry() = default;
+
+QueryResultCache::EntryMap::EntryMap(size_t maxMemory)
+    : vespalib::lrucache_map<EntryParam>(UNLIMITED),
+      _maxMemory(maxMemory),
+      _memoryUsed(0)
+{
+}
+
+QueryResultCache::EntryMap::~EntryMap() = default;
+
+void
+QueryResultCache::EntryMap::add(const vespalib::string &key, Entry::SP entry)
+{
+    // Another thread may have produced a reply for the same key after our lookup, keep the newest one.
+    remove(key);
+    // Account for the new entry up front, as eviction of the oldest entries is done while inserting it.
+    _memoryUsed += calcSize(key, *entry);
+    insert(key, std::move(entry));
+}
+
+void
+QueryResultCache::EntryMap::remove(const vespalib::string &key)
+{
+    Entry::SP *entry = findAndRef(key);
+    if (entry != nullptr) {
+        _memoryUsed -= calcSize(key, **entry);
+        erase(key);
+    }
+}
+
+void
+QueryResultCache::EntryMap::removeAll()
+{
+    for (auto itr = begin(); itr != end(); ) {
+        itr = erase(itr);
+    }
+    _memoryUsed = 0;
+}
+
+bool
+QueryResultCache::EntryMap::removeOldest(const value_type &v)
+{
+    bool remove = (_memoryUsed > _maxMemory);
+    if (remove) {
+        _memoryUsed -= calcSize(v.first, *v.second._value);
+    }
+    return remove;
+}
+
+size_t
+QueryResultCache::calcSize(const vespalib::string &key, const Entry &entry)
+{
+    return sizeof(EntryParam::value_type) + sizeof(Entry) + key.size() + entry.size;
+}
+
+QueryResultCache::QueryResultCache(size_t maxMemory, SerialNum maxStaleness)
+    : _mutex(),
+      _maxMemory(maxMemory),
+      _maxStaleness(maxStaleness),
+      _entries(maxMemory),
+      _hits(0),
+      _misses(0),
+      _invalidations(0)
+{
+}
+
+QueryResultCache::~QueryResultCache() = default;
+
+vespalib::string
+QueryResultCache::makeKey(const SearchRequest &request)
+{
+    vespalib::string key;
+    if (request.trace().getLevel() > 0) {
+        return key;
+    }
+    if (!request.sessionId.empty() && (request.propertiesMap.cacheProperties().numKeys() != 0)) {
+        // The sessions kept by the matcher are needed by the docsum requests that follow.
+        return key;
+    }
+    key.reserve(request.stackDump.size() + request.groupSpec.size() + 256);
+    appendField(key, request.ranking);
+    appendField(key, request.stackDump);
+    appendField(key, request.location);
+    appendField(key, request.sortSpec);
+    appendField(key, request.groupSpec);
+    appendField(key, request.offset);
+    appendField(key, request.maxhits);
+    appendField(key, uint32_t(request.dumpFeatures ? 1 : 0));
+    appendPropertiesMap(key, request.propertiesMap);
+    return key;
+}
+
+std::unique_ptr<QueryResultCache::SearchReply>
+QueryResultCache::copyReply(const SearchReply &reply)
+{
+    auto copy = std::make_unique<SearchReply>();
+    copy->totalHitCount = reply.totalHitCount;
+    copy->sortIndex = reply.sortIndex;
+    copy->sortData = reply.sortData;
+    copy->groupResult = reply.groupResult;
+    copy->coverage = reply.coverage;
+    copy->hits = reply.hits;
+    copy->match_features = reply.match_features;
+    for (const auto &entry : reply.propertiesMap) {
+        copy->propertiesMap.lookupCreate(entry.first).import(entry.second);
+    }
+    return copy;
+}
+
+std::unique_ptr<QueryResultCache::SearchReply>
+QueryResultCache::lookup(const vespalib::string &key, SerialNum serialNum)
+{
+    Entry::SP entry;
+    {
+        LockGuard guard(_mutex);
+        Entry::SP *found = _entries.findAndRef(key);
+        if (found != nullptr) {
+            SerialNum entrySerialNum = (*found)->serialNum;
+            if ((entrySerialNum <= serialNum) && (serialNum - entrySerialNum <= _maxStaleness)) {
+                entry = *found;
+                ++_hits;
+            } else {
+                _entries.remove(key);
+                ++_invalidations;
+            }
+        }
+        if (!entry) {
+            ++_misses;
+            return {};
+        }
+    }
+    // Copy the reply outside the lock, the entry is kept alive by the shared pointer.
+    return copyReply(*entry->reply);
+}
+
+void
+QueryResultCache::insert(const vespalib::string &key, const SearchReply &reply, SerialNum serialNum)
+{
+    auto entry = std::make_shared<const Entry>(copyReply(reply), serialNum, estimateReplySize(reply));
+    if (calcSize(key, *entry) > _maxMemory) {
+        return;
+    }
+    LockGuard guard(_mutex);
+    _entries.add(key, std::move(entry));
+}
+
+size_t
+QueryResultCache::size() const
+{
+    LockGuard guard(_mutex);
+    return _entries.size();
+}
+
+void
+QueryResultCache::clear()
+{
+    LockGuard guard(_mutex);
+    _invalidations += _entries.size();
+    _entries.removeAll();
+}
+
+vespalib::CacheStats
+QueryResultCache::getStats() const
+{
+    LockGuard guard(_mutex);
+    return vespalib::CacheStats(_hits, _misses, _entries.size(), _entries.memoryUsed(), _invalidations);
+}
+
+}
@@ -0,0 +1,107 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/cache_stats.h>
+#include <vespa/vespalib/stllike/lrucache_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <mutex>
+
+namespace search::engine {
+class SearchReply;
+class SearchRequest;
+}
+
+namespace proton::matching {
+
+/**
+ * Class that caches the replies of search requests against a document db.
+ *
+ * The key is the serialized request: query stack, rank profile, all property maps, location,
+ * sorting, grouping and the requested hit window. Requests that are traced or that ask for
+ * search or grouping sessions to be kept are not cached.
+ *
+ * Each entry is tagged with the serial number of the last commit that was visible to search
+ * when the reply was produced. An entry is dropped on lookup when the visible serial number has
+ * advanced more than the configured staleness bound since then, so a max staleness of 0 gives
+ * replies that are always consistent with the visible documents. Changes that are not reflected
+ * in the serial number (e.g. bucket activation) must be handled by clearing the cache. Memory used
+ * by the cached replies is bounded by evicting the least recently used entries.
+ *
+ * Replies are handed out as copies, as the match engine completes and consumes them as mutable
+ * objects. Copying is a few flat vectors (hits, sort data, grouping blob and match features) and the
+ * reply properties, see query_result_cache_bench for its cost.
+ */
+class QueryResultCache {
+public:
+    using SearchReply = search::engine::SearchReply;
+    using SearchRequest = search::engine::SearchRequest;
+    using SerialNum = uint64_t;
+
+private:
+    struct Entry {
+        using SP = std::shared_ptr<const Entry>;
+        std::unique_ptr<const SearchReply> reply;
+        SerialNum serialNum;
+        size_t size;
+        Entry(std::unique_ptr<const SearchReply> reply_, SerialNum serialNum_, size_t size_) noexcept;
+        ~Entry();
+    };
+
+    using LockGuard = std::lock_guard<std::mutex>;
+    using EntryParam = vespalib::LruParam<vespalib::string, Entry::SP>;
+
+    class EntryMap : public vespalib::lrucache_map<EntryParam> {
+    public:
+        using value_type = EntryParam::value_type;
+        explicit EntryMap(size_t maxMemory);
+        ~EntryMap() override;
+        size_t memoryUsed() const { return _memoryUsed; }
+        void add(const vespalib::string &key, Entry::SP entry);
+        void remove(const vespalib::string &key);
+        void removeAll();
+    private:
+        bool removeOldest(const value_type &v) override;
+        size_t _maxMemory;
+        size_t _memoryUsed;
+    };
+
+    static size_t calcSize(const vespalib::string &key, const Entry &entry);
+
+    mutable std::mutex _mutex;
+    size_t             _maxMemory;
+    SerialNum          _maxStaleness;
+    EntryMap           _entries;
+    size_t             _hits;
+    size_t             _misses;
+    size_t             _invalidations;
+
+public:
+    QueryResultCache(size_t maxMemory, SerialNum maxStaleness);
+    ~QueryResultCache();
+
+    /**
+     * Make the cache key for the given request. An empty key is returned if the request
+     * should not be cached.
+     */
+    static vespalib::string makeKey(const SearchRequest &request);
+
+    /**
+     * Copy the parts of a reply that are produced by matching. The request, issues and
+     * distribution key are left out, they are set by the match engine for each request.
+     */
+    static std::unique_ptr<SearchReply> copyReply(const SearchReply &reply);
+
+    /**
+     * Look up the cached reply for the given key. A copy of the reply is returned if it was
+     * produced at most max staleness serial numbers before the given visible serial number.
+     */
+    std::unique_ptr<SearchReply> lookup(const vespalib::string &key, SerialNum serialNum);
+    void insert(const vespalib::string &key, const SearchReply &reply, SerialNum serialNum);
+    size_t size() const;
+    void clear();
+    vespalib::CacheStats getStats() const;
+};
+
+}
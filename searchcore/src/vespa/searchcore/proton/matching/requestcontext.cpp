@@ -22,12 +22,14 @@ using search::attribute::IAttributeVector;
 RequestContext::RequestContext(const Doom & doom, IAttributeContext & attributeContext,
                                const search::fef::IQueryEnvironment& query_env,
                                search::fef::IObjectStore& shared_store,
-                               const search::attribute::AttributeBlueprintParams& attribute_blueprint_params)
+                               const search::attribute::AttributeBlueprintParams& attribute_blueprint_params,
+                               bool weakand_block_max)
     : _doom(doom),
       _attributeContext(attributeContext),
       _query_env(query_env),
       _shared_store(shared_store),
-      _attribute_blueprint_params(attribute_blueprint_params)
+      _attribute_blueprint_params(attribute_blueprint_params),
+      _weakand_block_max(weakand_block_max)
 {
 }
 
@@ -26,7 +26,8 @@ public:
                    IAttributeContext& attributeContext,
                    const search::fef::IQueryEnvironment& query_env,
                    search::fef::IObjectStore& shared_store,
-                   const search::attribute::AttributeBlueprintParams& attribute_blueprint_params);
+                   const search::attribute::AttributeBlueprintParams& attribute_blueprint_params,
+                   bool weakand_block_max);
 
     const Doom & getDoom() const override { return _doom; }
     const search::attribute::IAttributeVector *getAttribute(const vespalib::string &name) const override;
@@ -39,12 +40,15 @@ public:
 
     const search::attribute::AttributeBlueprintParams& get_attribute_blueprint_params() const override;
 
+    bool use_weakand_block_max() const override { return _weakand_block_max; }
+
 private:
     const Doom                      _doom;
     IAttributeContext             & _attributeContext;
     const search::fef::IQueryEnvironment& _query_env;
     search::fef::IObjectStore& _shared_store;
     search::attribute::AttributeBlueprintParams _attribute_blueprint_params;
+    bool _weakand_block_max;
 };
 
 }
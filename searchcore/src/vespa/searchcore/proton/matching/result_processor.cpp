@@ -45,13 +45,24 @@ ResultProcessor::Context::Context(Sort::UP s, PartialResult::UP r, GroupingConte
 
 ResultProcessor::Context::~Context() = default;
 
+ResultProcessor::GroupingSource::~GroupingSource() = default;
+
 void
 ResultProcessor::GroupingSource::merge(Source &s) {
     auto &rhs = dynamic_cast<GroupingSource&>(s);
     assert((ctx == nullptr) == (rhs.ctx == nullptr));
     if (ctx != nullptr) {
+        others.push_back(rhs.ctx);
+        others.insert(others.end(), rhs.others.begin(), rhs.others.end());
+    }
+}
+
+void
+ResultProcessor::GroupingSource::mergeGrouping(vespalib::ThreadBundle &threadBundle) {
+    if ((ctx != nullptr) && !others.empty()) {
         search::grouping::GroupingManager man(*ctx);
-        man.merge(*rhs.ctx);
+        man.merge(others, threadBundle);
+        others.clear();
     }
 }
 
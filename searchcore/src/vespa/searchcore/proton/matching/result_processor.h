@@ -4,6 +4,9 @@
 
 #include <vespa/searchlib/common/sortresults.h>
 #include <vespa/vespalib/util/dual_merge_director.h>
+#include <vector>
+
+namespace vespalib { struct ThreadBundle; }
 
 namespace search {
     namespace engine {
@@ -46,12 +49,17 @@ public:
     };
 
     /**
-     * Adapter to use grouping contexts as merging sources.
+     * Adapter to use grouping contexts as merging sources. Merging
+     * only collects the grouping contexts of the other threads, the
+     * grouping results are merged afterwards by mergeGrouping.
      **/
     struct GroupingSource : vespalib::DualMergeDirector::Source {
         GroupingContext *ctx;
-        GroupingSource(GroupingContext *g) : ctx(g) {}
+        std::vector<GroupingContext *> others;
+        GroupingSource(GroupingContext *g) : ctx(g), others() {}
+        ~GroupingSource() override;
         void merge(Source &s) override;
+        void mergeGrouping(vespalib::ThreadBundle &threadBundle);
     };
 
     /**
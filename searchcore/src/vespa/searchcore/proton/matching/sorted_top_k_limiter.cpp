@@ -0,0 +1,138 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sorted_top_k_limiter.h"
+#include "attribute_limiter.h"
+#include "match_phase_limiter.h"
+#include "query.h"
+#include <vespa/searchlib/fef/matchdata.h>
+#include <vespa/searchlib/fef/matchdatalayout.h>
+#include <vespa/vespalib/util/doom.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".proton.matching.sorted_top_k_limiter");
+
+using search::queryeval::SearchIterator;
+using search::queryeval::Searchable;
+using search::queryeval::IRequestContext;
+
+namespace proton::matching {
+
+namespace {
+
+// Smallest prefix tried, and how much it grows when too few documents match
+constexpr size_t min_limit = 256;
+constexpr size_t limit_growth_factor = 8;
+// How much larger than the prefix expected to hold the wanted hits the first tried prefix is
+constexpr size_t estimate_slack_factor = 2;
+
+/**
+ * The prefix iterator is strict and drives the search, the query
+ * iterator provides the match data.
+ **/
+class SortedTopKSearch : public LimitedSearch {
+public:
+    SortedTopKSearch(SearchIterator::UP limiter, SearchIterator::UP search)
+        : LimitedSearch(std::move(limiter), std::move(search))
+    {
+    }
+    void doUnpack(uint32_t docId) override { getSecond().doUnpack(docId); }
+};
+
+uint32_t
+count_matches(SearchIterator &search, uint32_t docid_limit, uint32_t max_matches)
+{
+    uint32_t matches = 0;
+    search.initRange(1, docid_limit);
+    for (uint32_t docid = search.seekFirst(1);
+         !search.isAtEnd(docid) && (matches < max_matches);
+         docid = search.seekNext(docid + 1))
+    {
+        ++matches;
+    }
+    return matches;
+}
+
+}
+
+SortedTopKLimiter::SortedTopKLimiter(const RangeQueryLocator &rangeQueryLocator,
+                                     Searchable &searchable_attributes,
+                                     const IRequestContext &requestContext,
+                                     const vespalib::string &attribute_name)
+    : _rangeQueryLocator(rangeQueryLocator),
+      _searchable_attributes(searchable_attributes),
+      _requestContext(requestContext),
+      _attribute_name(attribute_name),
+      _limiter(),
+      _limit(0)
+{
+}
+
+SortedTopKLimiter::~SortedTopKLimiter() = default;
+
+std::unique_ptr<AttributeLimiter>
+SortedTopKLimiter::make_attribute_limiter() const
+{
+    return std::make_unique<AttributeLimiter>(_rangeQueryLocator, _searchable_attributes, _requestContext,
+                                              _attribute_name, true, "", 1.0,
+                                              AttributeLimiter::DiversityCutoffStrategy::LOOSE);
+}
+
+bool
+SortedTopKLimiter::setup(const Query &query, const search::fef::MatchDataLayout &mdl,
+                         uint32_t wanted_hits, uint32_t estimated_hits, uint32_t docid_limit,
+                         const vespalib::Doom &doom)
+{
+    if ((wanted_hits == 0) || (estimated_hits < wanted_hits)) {
+        return false;
+    }
+    // Assume that the matches are spread evenly in sort order
+    size_t expected_limit = (size_t(wanted_hits) * docid_limit) / estimated_hits;
+    size_t start_limit = std::max(min_limit, expected_limit * estimate_slack_factor);
+    LOG(debug, "Estimated %u hits for %u documents, starting with a prefix of %zu documents sorted by '%s'",
+        estimated_hits, docid_limit, start_limit, _attribute_name.c_str());
+    for (size_t limit = start_limit;
+         (limit < docid_limit / 2) && !doom.soft_doom();
+         limit *= limit_growth_factor)
+    {
+        auto limiter = make_attribute_limiter();
+        auto match_data = mdl.createMatchData();
+        SortedTopKSearch search(limiter->create_search(limit, limit, true), query.createSearch(*match_data));
+        uint32_t matches = count_matches(search, docid_limit, wanted_hits);
+        LOG(debug, "Prefix of %zu documents sorted by '%s' has %u of %u wanted matches",
+            limit, _attribute_name.c_str(), matches, wanted_hits);
+        if (matches >= wanted_hits) {
+            _limiter = std::move(limiter);
+            _limit = limit;
+            return true;
+        }
+        if (limiter->getEstimatedHits() < ssize_t(limit)) {
+            return false; // All documents with a value were in the prefix
+        }
+    }
+    return false;
+}
+
+std::unique_ptr<SearchIterator>
+SortedTopKLimiter::limit(std::unique_ptr<SearchIterator> search) const
+{
+    return std::make_unique<SortedTopKSearch>(_limiter->create_search(_limit, _limit, true), std::move(search));
+}
+
+vespalib::string
+SortedTopKLimiter::descending_sort_attribute(vespalib::stringref sort_spec)
+{
+    size_t pos = 0;
+    for (; (pos < sort_spec.size()) && (sort_spec[pos] == ' '); ++pos);
+    if ((pos == sort_spec.size()) || (sort_spec[pos] != '-')) {
+        return "";
+    }
+    size_t begin = ++pos;
+    for (; (pos < sort_spec.size()) && (sort_spec[pos] != ' '); ++pos) {
+        if ((sort_spec[pos] == '(') || (sort_spec[pos] == '[')) {
+            return ""; // sort function, or sort by rank or docid
+        }
+    }
+    return sort_spec.substr(begin, pos - begin);
+}
+
+}
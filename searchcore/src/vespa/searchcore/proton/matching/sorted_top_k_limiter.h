@@ -0,0 +1,82 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+
+namespace search::queryeval {
+    class Searchable;
+    class IRequestContext;
+}
+namespace search::fef { class MatchDataLayout; }
+namespace vespalib { class Doom; }
+
+namespace proton::matching {
+
+class AttributeLimiter;
+class Query;
+class RangeQueryLocator;
+
+/**
+ * Limits the evaluation of a query sorted in descending order by a
+ * single value integer attribute with fast-search to a prefix of the
+ * documents in sort order.
+ *
+ * The prefix is selected by walking the attribute dictionary in sort
+ * order, using a range limited attribute search (cf. AttributeLimiter).
+ * The prefix always contains all documents with one of the selected
+ * attribute values, and it is made larger until the query has the
+ * wanted number of matches within it. The top hits in sort order are
+ * then the same as for the unlimited query. Documents without a value
+ * are sorted last in descending order, and they are never part of
+ * the prefix. The total hit count is a lower bound when the query is
+ * limited.
+ **/
+class SortedTopKLimiter
+{
+public:
+    using SearchIterator = search::queryeval::SearchIterator;
+
+    SortedTopKLimiter(const RangeQueryLocator &rangeQueryLocator,
+                      search::queryeval::Searchable &searchable_attributes,
+                      const search::queryeval::IRequestContext &requestContext,
+                      const vespalib::string &attribute_name);
+    ~SortedTopKLimiter();
+
+    /**
+     * Select the smallest tried prefix with at least wanted_hits
+     * matches for the given query. The first prefix tried is sized
+     * from the estimated hits of the query. Returns false if there is
+     * no such prefix that is considerably smaller than the corpus,
+     * which is assumed without trying when the estimate is too low.
+     **/
+    bool setup(const Query &query, const search::fef::MatchDataLayout &mdl,
+               uint32_t wanted_hits, uint32_t estimated_hits, uint32_t docid_limit,
+               const vespalib::Doom &doom);
+    bool is_limited() const { return bool(_limiter); }
+    size_t get_limit() const { return _limit; }
+    /**
+     * Returns a search only matching the documents in the selected
+     * prefix that are matched by the given search.
+     **/
+    std::unique_ptr<SearchIterator> limit(std::unique_ptr<SearchIterator> search) const;
+
+    /**
+     * Returns the attribute name if the primary order of the given
+     * sort spec is descending by a plain attribute, otherwise empty.
+     **/
+    static vespalib::string descending_sort_attribute(vespalib::stringref sort_spec);
+private:
+    std::unique_ptr<AttributeLimiter> make_attribute_limiter() const;
+
+    const RangeQueryLocator                  &_rangeQueryLocator;
+    search::queryeval::Searchable            &_searchable_attributes;
+    const search::queryeval::IRequestContext &_requestContext;
+    vespalib::string                          _attribute_name;
+    std::unique_ptr<AttributeLimiter>         _limiter;
+    size_t                                    _limit;
+};
+
+}
@@ -83,7 +83,8 @@ DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics::~DocumentStoreMetri
 DocumentDBTaggedMetrics::AttributeMetrics::AttributeMetrics(MetricSet *parent)
     : MetricSet("attribute", {}, "Attribute vector metrics for this document db", parent),
       resourceUsage(this),
-      totalMemoryUsage(this)
+      totalMemoryUsage(this),
+      filterCache(this)
 {
 }
 
@@ -99,6 +100,18 @@ DocumentDBTaggedMetrics::AttributeMetrics::ResourceUsageMetrics::ResourceUsageMe
 
 DocumentDBTaggedMetrics::AttributeMetrics::ResourceUsageMetrics::~ResourceUsageMetrics() = default;
 
+DocumentDBTaggedMetrics::AttributeMetrics::FilterCacheMetrics::FilterCacheMetrics(MetricSet *parent)
+    : MetricSet("filter_cache", {}, "Metrics for the cache of filter term results in the attributes of the ready sub db", parent),
+      memoryUsage("memory_usage", {}, "Memory usage of the cache (in bytes)", this),
+      elements("elements", {}, "Number of elements in the cache", this),
+      hitRate("hit_rate", {}, "Rate of hits in the cache compared to number of lookups", this),
+      lookups("lookups", {}, "Number of lookups in the cache (hits + misses)", this),
+      invalidations("invalidations", {}, "Number of elements dropped from the cache because the attribute has changed", this)
+{
+}
+
+DocumentDBTaggedMetrics::AttributeMetrics::FilterCacheMetrics::~FilterCacheMetrics() = default;
+
 DocumentDBTaggedMetrics::IndexMetrics::IndexMetrics(MetricSet *parent)
     : MetricSet("index", {}, "Index metrics (memory and disk) for this document db", parent),
       diskUsage("disk_usage", {}, "Disk space usage in bytes", this),
@@ -131,12 +144,25 @@ DocumentDBTaggedMetrics::MatchingMetrics::MatchingMetrics(MetricSet *parent)
       queries("queries", {}, "Number of queries executed", this),
       softDoomedQueries("soft_doomed_queries", {}, "Number of queries hitting the soft timeout", this),
       querySetupTime("query_setup_time", {}, "Average time (sec) spent setting up and tearing down queries", this),
-      queryLatency("query_latency", {}, "Total average latency (sec) when matching and ranking a query", this)
+      queryLatency("query_latency", {}, "Total average latency (sec) when matching and ranking a query", this),
+      resultCache(this)
 {
 }
 
 DocumentDBTaggedMetrics::MatchingMetrics::~MatchingMetrics() = default;
 
+DocumentDBTaggedMetrics::MatchingMetrics::ResultCacheMetrics::ResultCacheMetrics(MetricSet *parent)
+    : MetricSet("result_cache", {}, "Metrics for the cache of query results in this document db", parent),
+      memoryUsage("memory_usage", {}, "Memory usage of the cache (in bytes)", this),
+      elements("elements", {}, "Number of elements in the cache", this),
+      hitRate("hit_rate", {}, "Rate of hits in the cache compared to number of lookups", this),
+      lookups("lookups", {}, "Number of lookups in the cache (hits + misses)", this),
+      invalidations("invalidations", {}, "Number of elements dropped from the cache because they have become stale", this)
+{
+}
+
+DocumentDBTaggedMetrics::MatchingMetrics::ResultCacheMetrics::~ResultCacheMetrics() = default;
+
 DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::RankProfileMetrics(const vespalib::string &name,
                                                                                  size_t numDocIdPartitions,
                                                                                  MetricSet *parent)
@@ -147,6 +173,7 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::RankProfileMetrics
       queries("queries", {}, "Number of queries executed", this),
       limitedQueries("limited_queries", {}, "Number of queries limited in match phase", this),
       softDoomedQueries("soft_doomed_queries", {}, "Number of queries hitting the soft timeout", this),
+      docidRangeSteals("docid_range_steals", {}, "Number of times a match thread took docids to match from another match thread", this),
       softDoomFactor("soft_doom_factor", {}, "Factor used to compute soft-timeout", this),
       matchTime("match_time", {}, "Average time (sec) for matching a query (1st phase)", this),
       groupingTime("grouping_time", {}, "Average time (sec) spent on grouping", this),
@@ -168,6 +195,7 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::Do
       docsMatched("docs_matched", {}, "Number of documents matched", this),
       docsRanked("docs_ranked", {}, "Number of documents ranked (first phase)", this),
       docsReRanked("docs_reranked", {}, "Number of documents re-ranked (second phase)", this),
+      docidRangeSteals("docid_range_steals", {}, "Number of times this match thread took docids to match from another match thread", this),
       activeTime("active_time", {}, "Time (sec) spent doing actual work", this),
       waitTime("wait_time", {}, "Time (sec) spent waiting for other external threads and resources", this)
 { }
@@ -180,6 +208,7 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::up
     docsMatched.inc(stats.docsMatched());
     docsRanked.inc(stats.docsRanked());
     docsReRanked.inc(stats.docsReRanked());
+    docidRangeSteals.inc(stats.docidRangeSteals());
     activeTime.addValueBatch(stats.active_time_avg(), stats.active_time_count(),
                              stats.active_time_min(), stats.active_time_max());
     waitTime.addValueBatch(stats.wait_time_avg(), stats.wait_time_count(),
@@ -196,6 +225,7 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::update(const metri
     queries.inc(stats.queries());
     limitedQueries.inc(stats.limited_queries());
     softDoomedQueries.inc(stats.softDoomed());
+    docidRangeSteals.inc(stats.docidRangeSteals());
     softDoomFactor.set(stats.softDoomFactor());
     matchTime.addValueBatch(stats.matchTimeAvg(), stats.matchTimeCount(),
                             stats.matchTimeMin(), stats.matchTimeMax());
@@ -93,8 +93,21 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
             ~ResourceUsageMetrics() override;
         };
 
+        struct FilterCacheMetrics : metrics::MetricSet
+        {
+            metrics::LongValueMetric memoryUsage;
+            metrics::LongValueMetric elements;
+            metrics::LongAverageMetric hitRate;
+            metrics::LongCountMetric lookups;
+            metrics::LongCountMetric invalidations;
+
+            FilterCacheMetrics(metrics::MetricSet *parent);
+            ~FilterCacheMetrics() override;
+        };
+
         ResourceUsageMetrics resourceUsage;
         MemoryUsageMetrics totalMemoryUsage;
+        FilterCacheMetrics filterCache;
 
         AttributeMetrics(metrics::MetricSet *parent);
         ~AttributeMetrics() override;
@@ -119,11 +132,26 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
         metrics::DoubleAverageMetric querySetupTime;
         metrics::DoubleAverageMetric queryLatency;
 
+        struct ResultCacheMetrics : metrics::MetricSet
+        {
+            metrics::LongValueMetric memoryUsage;
+            metrics::LongValueMetric elements;
+            metrics::LongAverageMetric hitRate;
+            metrics::LongCountMetric lookups;
+            metrics::LongCountMetric invalidations;
+
+            ResultCacheMetrics(metrics::MetricSet *parent);
+            ~ResultCacheMetrics() override;
+        };
+
+        ResultCacheMetrics resultCache;
+
         struct RankProfileMetrics : metrics::MetricSet {
             struct DocIdPartition : metrics::MetricSet {
                 metrics::LongCountMetric docsMatched;
                 metrics::LongCountMetric docsRanked;
                 metrics::LongCountMetric docsReRanked;
+                metrics::LongCountMetric docidRangeSteals;
                 metrics::DoubleAverageMetric activeTime;
                 metrics::DoubleAverageMetric waitTime;
 
@@ -141,6 +169,7 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
             metrics::LongCountMetric     queries;
             metrics::LongCountMetric     limitedQueries;
             metrics::LongCountMetric     softDoomedQueries;
+            metrics::LongCountMetric     docidRangeSteals;
             metrics::DoubleValueMetric   softDoomFactor;
             metrics::DoubleAverageMetric matchTime;
             metrics::DoubleAverageMetric groupingTime;
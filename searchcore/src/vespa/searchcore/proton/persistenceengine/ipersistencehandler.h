@@ -9,7 +9,10 @@ namespace document {
     class Document;
     class DocumentUpdate;
 }
-namespace storage::spi { class ClusterState; }
+namespace storage::spi {
+    class ClusterState;
+    class FeedBatch;
+}
 
 namespace proton {
 
@@ -48,6 +51,13 @@ public:
     virtual void handleRemove(FeedToken token, const storage::spi::Bucket &bucket,
                               storage::spi::Timestamp timestamp, const document::DocumentId &id) = 0;
 
+    /**
+     * Handles the put, remove and update operations in the given batch in
+     * order. The feed tokens belong to the corresponding batch entries.
+     */
+    virtual void handleFeedBatch(std::vector<FeedToken> tokens, const storage::spi::Bucket &bucket,
+                                 storage::spi::FeedBatch batch) = 0;
+
     virtual void handleListBuckets(IBucketIdListResultHandler &resultHandler) = 0;
     virtual void handleSetClusterState(const storage::spi::ClusterState &calc, IGenericResultHandler &resultHandler) = 0;
 
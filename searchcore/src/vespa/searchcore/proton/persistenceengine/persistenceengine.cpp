@@ -10,6 +10,7 @@
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/document/util/feed_reject_helper.h>
 #include <vespa/document/base/exceptions.h>
+#include <algorithm>
 #include <thread>
 
 #include <vespa/log/log.h>
@@ -17,9 +18,11 @@ LOG_SETUP(".proton.persistenceengine.persistenceengine");
 
 using document::Document;
 using document::DocumentId;
+using document::DocumentUpdate;
 using storage::spi::BucketChecksum;
 using storage::spi::BucketExecutor;
 using storage::spi::BucketTask;
+using storage::spi::FeedBatch;
 using storage::spi::BucketIdListResult;
 using storage::spi::BucketInfo;
 using storage::spi::BucketInfoResult;
@@ -190,6 +193,35 @@ public:
 
 BucketInfoResultHandler::~BucketInfoResultHandler() = default;
 
+/**
+ * The part of a feed batch handled by a single persistence handler.
+ */
+struct HandlerFeedBatch {
+    IPersistenceHandler    *handler;
+    std::vector<FeedToken>  tokens;
+    FeedBatch               batch;
+    explicit HandlerFeedBatch(IPersistenceHandler *handler_in)
+        : handler(handler_in),
+          tokens(),
+          batch()
+    {}
+};
+
+bool
+canEagerDeserialize(DocumentUpdate &upd)
+{
+    try {
+        upd.eagerDeserialize();
+    } catch (document::FieldNotFoundException &) {
+        return false;
+    } catch (document::DocumentTypeNotFoundException &) {
+        return false;
+    } catch (document::WrongTensorTypeException &) {
+        return false;
+    }
+    return true;
+}
+
 }
 
 PersistenceEngine::HandlerSnapshot
@@ -481,6 +513,65 @@ PersistenceEngine::updateAsync(const Bucket& b, Timestamp t, DocumentUpdate::SP
     handler->handleUpdate(feedtoken::make(std::move(transportContext)), b, t, std::move(upd));
 }
 
+bool
+PersistenceEngine::getFeedBatchHandlers(const ReadGuard & guard, const Bucket &b, const FeedBatch &batch,
+                                        std::vector<IPersistenceHandler *> &handlers) const
+{
+    handlers.reserve(batch.size());
+    for (const auto &entry : batch.entries()) {
+        const DocumentId &id = entry.document_id();
+        if (!id.hasDocType()) {
+            return false;
+        }
+        DocTypeName docType(id.getDocType());
+        if ((entry.type == FeedBatch::Type::UPDATE) && (entry.update->getType().getName() != docType.getName())) {
+            return false;
+        }
+        IPersistenceHandler *handler = getHandler(guard, b.getBucketSpace(), docType);
+        if (handler == nullptr) {
+            return false;
+        }
+        handlers.push_back(handler);
+    }
+    return true;
+}
+
+void
+PersistenceEngine::feedBatchAsync(const Bucket &b, FeedBatch batch)
+{
+    LOG(spam, "feedBatch(%s, %zu operations)", b.toString().c_str(), batch.size());
+    // Operations that might be rejected, or that fail, are handled one by one to get the proper results.
+    bool use_batch = _writeFilter.acceptWriteOperation();
+    for (auto &entry : batch.entries()) {
+        if (use_batch && (entry.type == FeedBatch::Type::UPDATE)) {
+            use_batch = canEagerDeserialize(*entry.update);
+        }
+    }
+    if (use_batch) {
+        ReadGuard rguard(_rwMutex);
+        std::vector<IPersistenceHandler *> handlers;
+        if (getFeedBatchHandlers(rguard, b, batch, handlers)) {
+            std::vector<HandlerFeedBatch> handler_batches;
+            for (size_t i = 0; i < batch.size(); ++i) {
+                auto &entry = batch.entries()[i];
+                auto itr = std::find_if(handler_batches.begin(), handler_batches.end(),
+                                        [handler = handlers[i]](const auto &hb) { return hb.handler == handler; });
+                if (itr == handler_batches.end()) {
+                    itr = handler_batches.emplace(handler_batches.end(), handlers[i]);
+                }
+                auto transportContext = std::make_shared<AsyncTransportContext>(1, std::move(entry.on_complete));
+                itr->tokens.push_back(feedtoken::make(std::move(transportContext)));
+                itr->batch.entries().push_back(std::move(entry));
+            }
+            for (auto &hb : handler_batches) {
+                hb.handler->handleFeedBatch(std::move(hb.tokens), b, std::move(hb.batch));
+            }
+            return;
+        }
+    }
+    AbstractPersistenceProvider::feedBatchAsync(b, std::move(batch));
+}
+
 
 PersistenceEngine::GetResult
 PersistenceEngine::get(const Bucket& b, const document::FieldSet& fields, const DocumentId& did, Context& context) const
@@ -91,6 +91,8 @@ private:
     std::shared_ptr<BucketExecutor> get_bucket_executor() noexcept { return _bucket_executor.lock(); }
     void removeAsyncSingle(const Bucket&, Timestamp, const document::DocumentId &id, OperationComplete::UP);
     void removeAsyncMulti(const Bucket&, std::vector<storage::spi::IdAndTimestamp> ids, OperationComplete::UP);
+    bool getFeedBatchHandlers(const ReadGuard & guard, const Bucket &b, const storage::spi::FeedBatch &batch,
+                              std::vector<IPersistenceHandler *> &handlers) const;
 public:
     using UP = std::unique_ptr<PersistenceEngine>;
 
@@ -110,6 +112,7 @@ public:
     void putAsync(const Bucket &, Timestamp, storage::spi::DocumentSP, OperationComplete::UP) override;
     void removeAsync(const Bucket&, std::vector<storage::spi::IdAndTimestamp> ids, OperationComplete::UP) override;
     void updateAsync(const Bucket&, Timestamp, storage::spi::DocumentUpdateSP, OperationComplete::UP) override;
+    void feedBatchAsync(const Bucket&, storage::spi::FeedBatch batch) override;
     GetResult get(const Bucket&, const document::FieldSet&, const document::DocumentId&, Context&) const override;
     CreateIteratorResult
     createIterator(const Bucket &bucket, FieldSetSP, const Selection &, IncludedVersions, Context &context) override;
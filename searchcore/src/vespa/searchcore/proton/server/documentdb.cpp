@@ -25,6 +25,7 @@
 #include <vespa/searchcore/proton/feedoperation/noopoperation.h>
 #include <vespa/searchcore/proton/index/index_writer.h>
 #include <vespa/searchcore/proton/initializer/task_runner.h>
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
 #include <vespa/searchcore/proton/metrics/executor_threading_service_stats.h>
 #include <vespa/searchcore/proton/metrics/metricswireservice.h>
 #include <vespa/searchcore/proton/persistenceengine/commit_and_wait_document_retriever.h>
@@ -89,6 +90,14 @@ make_replay_throttling_policy(const ProtonConfig::ReplayThrottlingPolicy& cfg) {
     return ReplayThrottlingPolicy(params);
 }
 
+std::unique_ptr<QueryResultCache>
+make_query_result_cache(const ProtonConfig::Search::Resultcache& cfg) {
+    if (cfg.maxbytes <= 0) {
+        return {};
+    }
+    return std::make_unique<QueryResultCache>(cfg.maxbytes, std::max(cfg.maxstaleness, int64_t(0)));
+}
+
 class MetricsUpdateHook : public metrics::UpdateHook {
     DocumentDB &_db;
 public:
@@ -217,6 +226,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _writeFilter(),
       _transient_usage_provider(std::make_shared<DocumentDBResourceUsageProvider>(*this)),
       _feedHandler(std::make_unique<FeedHandler>(_writeService, tlsSpec, docTypeName, *this, _writeFilter, *this, tlsWriterFactory)),
+      _queryResultCache(make_query_result_cache(protonCfg.search.resultcache)),
       _subDBs(*this, *this, *_feedHandler, _docTypeName,
               _writeService, shared_service.warmup(), fileHeaderContext, std::move(attribute_interlock),
               metricsWireService, getMetrics(), queryLimiter, shared_service.clock(),
@@ -224,7 +234,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _maintenanceController(shared_service.transport(), _writeService.master(), _refCount, _docTypeName),
       _jobTrackers(),
       _calc(),
-      _metricsUpdater(_subDBs, _writeService, _jobTrackers, _writeFilter, *_feedHandler)
+      _metricsUpdater(_subDBs, _writeService, _jobTrackers, _writeFilter, *_feedHandler, _queryResultCache.get())
 {
     assert(configSnapshot);
 
@@ -249,6 +259,8 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
     _clusterStateHandler.addClusterStateChangedHandler(this);
     // Forward changes of cluster state to bucket handler
     _clusterStateHandler.addClusterStateChangedHandler(&_bucketHandler);
+    // Changes of bucket state are not reflected in the serial number used to invalidate cached query results
+    _bucketHandler.addBucketStateChangedHandler(this);
 
     _writeFilter.setConfig(loaded_config->getMaintenanceConfigSP()->getAttributeUsageFilterConfig());
 }
@@ -530,6 +542,10 @@ DocumentDB::applyConfig(DocumentDBConfig::SP configSnapshot, SerialNum serialNum
     if (_subDBs.getReprocessingRunner().empty()) {
         _subDBs.pruneRemovedFields(serialNum);
     }
+    if (_queryResultCache) {
+        // Rank profiles and schema might have changed
+        _queryResultCache->clear();
+    }
 }
 
 void
@@ -597,6 +613,7 @@ DocumentDB::close()
 DocumentDB::~DocumentDB()
 {
     close();
+    _bucketHandler.removeBucketStateChangedHandler(this);
     // Remove forwarding of cluster state change
     _clusterStateHandler.removeClusterStateChangedHandler(&_bucketHandler);
     _clusterStateHandler.removeClusterStateChangedHandler(this);
@@ -772,8 +789,30 @@ DocumentDB::getNewestFlushedSerial()
 std::unique_ptr<SearchReply>
 DocumentDB::match(const SearchRequest &req, vespalib::ThreadBundle &threadBundle) const
 {
-    ISearchHandler::SP view(_subDBs.getReadySubDB()->getSearchView());
-    return view->match(req, threadBundle);
+    const IDocumentSubDB *readySubDB = _subDBs.getReadySubDB();
+    vespalib::string key = _queryResultCache ? QueryResultCache::makeKey(req) : vespalib::string();
+    // Tag the reply with the serial number of the last commit visible in the ready sub db, including its
+    // attributes and memory index. It is read before the search view, so that a reply is never tagged with
+    // a later commit than it was produced from.
+    SerialNum serialNum = key.empty() ? 0 : readySubDB->getDocumentMetaStoreContext().getVisibleSerialNum();
+    ISearchHandler::SP view(readySubDB->getSearchView());
+    if (key.empty()) {
+        return view->match(req, threadBundle);
+    }
+    auto reply = _queryResultCache->lookup(key, serialNum);
+    if (reply) {
+        return reply;
+    }
+    UniqueIssues issues;
+    {
+        auto capture_issues = vespalib::Issue::listen(issues);
+        reply = view->match(req, threadBundle);
+    }
+    issues.for_each_message([](const auto &msg) { vespalib::Issue::report(msg); });
+    if ((issues.size() == 0) && !reply->coverage.wasDegradedByMatchPhase() && !reply->coverage.wasDegradedByTimeout()) {
+        _queryResultCache->insert(key, *reply, serialNum);
+    }
+    return reply;
 }
 
 std::unique_ptr<DocsumReply>
@@ -1015,6 +1054,18 @@ DocumentDB::notifyClusterStateChanged(const std::shared_ptr<IBucketStateCalculat
             cfv->setCalculator(newCalc);
     }
     _subDBs.setBucketStateCalculator(newCalc, std::shared_ptr<vespalib::IDestructorCallback>());
+    if (_queryResultCache) {
+        _queryResultCache->clear();
+    }
+}
+
+void
+DocumentDB::notifyBucketStateChanged(const document::BucketId &, storage::spi::BucketInfo::ActiveState)
+{
+    // Called by executor thread
+    if (_queryResultCache) {
+        _queryResultCache->clear();
+    }
 }
 
 
@@ -12,6 +12,7 @@
 #include "executorthreadingservice.h"
 #include "i_document_subdb_owner.h"
 #include "i_feed_handler_owner.h"
+#include "ibucketstatechangedhandler.h"
 #include "ifeedview.h"
 #include "ireplayconfig.h"
 #include "maintenancecontroller.h"
@@ -62,7 +63,10 @@ class StatusReport;
 struct MetricsWireService;
 class DocumentDBMaintenanceConfig;
 
-namespace matching { class SessionManager; }
+namespace matching {
+class QueryResultCache;
+class SessionManager;
+}
 
 struct ActiveDocs {
     ActiveDocs() noexcept : active(0), target_active(0) { }
@@ -87,6 +91,7 @@ class DocumentDB : public DocumentDBConfigOwner,
                    public IFeedHandlerOwner,
                    public IDocumentSubDBOwner,
                    public IClusterStateChangedHandler,
+                   public IBucketStateChangedHandler,
                    public search::transactionlog::SyncProxy,
                    public std::enable_shared_from_this<DocumentDB>
 {
@@ -137,6 +142,7 @@ private:
     AttributeUsageFilter                             _writeFilter;
     std::shared_ptr<ITransientResourceUsageProvider> _transient_usage_provider;
     std::unique_ptr<FeedHandler>                     _feedHandler;
+    std::unique_ptr<matching::QueryResultCache>      _queryResultCache;
     DocumentSubDBCollection                          _subDBs;
     MaintenanceController                            _maintenanceController;
     DocumentDBJobTrackers                            _jobTrackers;
@@ -196,6 +202,12 @@ private:
     void notifyClusterStateChanged(const std::shared_ptr<IBucketStateCalculator> &newCalc) override;
     void notifyAllBucketsChanged();
 
+    /**
+     * Implements IBucketStateChangedHandler
+     */
+    void notifyBucketStateChanged(const document::BucketId &bucketId,
+                                  storage::spi::BucketInfo::ActiveState newState) override;
+
     /*
      * Tear down references to this document db (e.g. listeners for
      * gid to lid changes) from other document dbs.
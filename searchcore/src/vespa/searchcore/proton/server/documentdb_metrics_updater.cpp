@@ -11,9 +11,11 @@
 #include <vespa/searchcore/proton/attribute/i_attribute_manager.h>
 #include <vespa/searchcore/proton/docsummary/isummarymanager.h>
 #include <vespa/searchcore/proton/matching/matching_stats.h>
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
 #include <vespa/searchcore/proton/metrics/documentdb_job_trackers.h>
 #include <vespa/searchcore/proton/metrics/executor_threading_service_stats.h>
 #include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/searchlib/attribute/filter_search_cache.h>
 #include <vespa/vespalib/stllike/cache_stats.h>
 #include <vespa/searchlib/util/searchable_stats.h>
 #include <vespa/vespalib/util/memoryusage.h>
@@ -33,13 +35,17 @@ DocumentDBMetricsUpdater::DocumentDBMetricsUpdater(const DocumentSubDBCollection
                                                    ExecutorThreadingService &writeService,
                                                    DocumentDBJobTrackers &jobTrackers,
                                                    const AttributeUsageFilter &writeFilter,
-                                                   FeedHandler& feed_handler)
+                                                   FeedHandler& feed_handler,
+                                                   const matching::QueryResultCache *queryResultCache)
     : _subDBs(subDBs),
       _writeService(writeService),
       _jobTrackers(jobTrackers),
       _writeFilter(writeFilter),
       _feed_handler(feed_handler),
+      _queryResultCache(queryResultCache),
       _lastDocStoreCacheStats(),
+      _lastFilterCacheStats(),
+      _lastResultCacheStats(),
       _last_feed_handler_stats()
 {
 }
@@ -249,6 +255,42 @@ updateDocumentStoreMetrics(DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreM
     lastCacheStats = cacheStats;
 }
 
+void
+updateFilterCacheMetrics(DocumentDBTaggedMetrics::AttributeMetrics::FilterCacheMetrics &metrics,
+                         const IDocumentSubDB &ready, CacheStats &lastCacheStats, TotalStats &totalStats)
+{
+    auto attrMgr = ready.getAttributeManager();
+    auto filterCache = attrMgr ? attrMgr->get_filter_search_cache() : std::shared_ptr<search::attribute::FilterSearchCache>();
+    CacheStats cacheStats = filterCache ? filterCache->getStats() : CacheStats();
+    if (cacheStats.hits < lastCacheStats.hits || cacheStats.misses < lastCacheStats.misses ||
+        cacheStats.invalidations < lastCacheStats.invalidations)
+    {
+        // A new cache is used after the attribute manager has been reconfigured.
+        lastCacheStats = CacheStats();
+    }
+    totalStats.memoryUsage.incAllocatedBytes(cacheStats.memory_used);
+    metrics.memoryUsage.set(cacheStats.memory_used);
+    metrics.elements.set(cacheStats.elements);
+    metrics.hitRate.addTotalValueWithCount(cacheStats.hits - lastCacheStats.hits, cacheStats.lookups() - lastCacheStats.lookups());
+    updateCountMetric(cacheStats.lookups(), lastCacheStats.lookups(), metrics.lookups);
+    updateCountMetric(cacheStats.invalidations, lastCacheStats.invalidations, metrics.invalidations);
+    lastCacheStats = cacheStats;
+}
+
+void
+updateResultCacheMetrics(DocumentDBTaggedMetrics::MatchingMetrics::ResultCacheMetrics &metrics,
+                         const matching::QueryResultCache *resultCache, CacheStats &lastCacheStats, TotalStats &totalStats)
+{
+    CacheStats cacheStats = resultCache ? resultCache->getStats() : CacheStats();
+    totalStats.memoryUsage.incAllocatedBytes(cacheStats.memory_used);
+    metrics.memoryUsage.set(cacheStats.memory_used);
+    metrics.elements.set(cacheStats.elements);
+    metrics.hitRate.addTotalValueWithCount(cacheStats.hits - lastCacheStats.hits, cacheStats.lookups() - lastCacheStats.lookups());
+    updateCountMetric(cacheStats.lookups(), lastCacheStats.lookups(), metrics.lookups);
+    updateCountMetric(cacheStats.invalidations, lastCacheStats.invalidations, metrics.invalidations);
+    lastCacheStats = cacheStats;
+}
+
 void
 updateDocumentStoreMetrics(DocumentDBTaggedMetrics &metrics, const DocumentSubDBCollection &subDBs,
                            DocumentDBMetricsUpdater::DocumentStoreCacheStats &lastDocStoreCacheStats, TotalStats &totalStats)
@@ -304,6 +346,8 @@ DocumentDBMetricsUpdater::updateMetrics(const metrics::MetricLockGuard & guard,
     updateMatchingMetrics(guard, metrics, *_subDBs.getReadySubDB());
     updateDocumentsMetrics(metrics, _subDBs);
     updateDocumentStoreMetrics(metrics, _subDBs, _lastDocStoreCacheStats, totalStats);
+    updateFilterCacheMetrics(metrics.attribute.filterCache, *_subDBs.getReadySubDB(), _lastFilterCacheStats, totalStats);
+    updateResultCacheMetrics(metrics.matching.resultCache, _queryResultCache, _lastResultCacheStats, totalStats);
     updateMiscMetrics(metrics, threadingServiceStats);
 
     metrics.totalMemoryUsage.update(totalStats.memoryUsage);
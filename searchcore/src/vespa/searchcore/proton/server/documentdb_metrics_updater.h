@@ -15,6 +15,7 @@ class DocumentSubDBCollection;
 class ExecutorThreadingService;
 class ExecutorThreadingServiceStats;
 class FeedHandler;
+namespace matching { class QueryResultCache; }
 
 /**
  * Class used to update metrics for a document db.
@@ -35,8 +36,11 @@ private:
     DocumentDBJobTrackers         &_jobTrackers;
     const AttributeUsageFilter    &_writeFilter;
     FeedHandler                   &_feed_handler;
+    const matching::QueryResultCache *_queryResultCache;
     // Last updated document store cache statistics. Necessary due to metrics implementation is upside down.
     DocumentStoreCacheStats        _lastDocStoreCacheStats;
+    vespalib::CacheStats           _lastFilterCacheStats;
+    vespalib::CacheStats           _lastResultCacheStats;
     std::optional<FeedHandlerStats> _last_feed_handler_stats;
 
     void updateMiscMetrics(DocumentDBTaggedMetrics &metrics, const ExecutorThreadingServiceStats &threadingServiceStats);
@@ -47,7 +51,8 @@ public:
                              ExecutorThreadingService &writeService,
                              DocumentDBJobTrackers &jobTrackers,
                              const AttributeUsageFilter &writeFilter,
-                             FeedHandler& feed_handler);
+                             FeedHandler& feed_handler,
+                             const matching::QueryResultCache *queryResultCache);
     ~DocumentDBMetricsUpdater();
 
     void updateMetrics(const metrics::MetricLockGuard & guard, DocumentDBTaggedMetrics &metrics);
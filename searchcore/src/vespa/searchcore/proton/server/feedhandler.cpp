@@ -57,35 +57,69 @@ ignoreOperation(const DocumentOperation &op) {
 }
 
 class TlsMgrWriter : public TlsWriter {
+    using Packet = search::transactionlog::Packet;
+    using DoneCallbacks = std::vector<DoneCallback>;
     TransactionLogManager &_tls_mgr;
     std::shared_ptr<search::transactionlog::Writer> _writer;
+    bool                  _batching;
+    Packet                _batch;
+    DoneCallbacks         _batch_callbacks;
+
+    void append_batch();
 public:
     TlsMgrWriter(TransactionLogManager &tls_mgr,
                  const search::transactionlog::WriterFactory & factory)
         : _tls_mgr(tls_mgr),
-          _writer(factory.getWriter(tls_mgr.getDomainName()))
+          _writer(factory.getWriter(tls_mgr.getDomainName())),
+          _batching(false),
+          _batch(0),
+          _batch_callbacks()
     { }
     void appendOperation(const FeedOperation &op, DoneCallback onDone) override;
     [[nodiscard]] CommitResult startCommit(DoneCallback onDone) override {
+        append_batch();
         return _writer->startCommit(std::move(onDone));
     }
     bool erase(SerialNum oldest_to_keep) override;
     SerialNum sync(SerialNum syncTo) override;
+    void start_batch() override { _batching = true; }
+    void flush_batch() override {
+        append_batch();
+        _batching = false;
+    }
 };
 
 void
 TlsMgrWriter::appendOperation(const FeedOperation &op, DoneCallback onDone) {
-    using Packet = search::transactionlog::Packet;
     vespalib::nbostream stream;
     op.serialize(stream);
     LOG(debug, "appendOperation(): serialNum(%" PRIu64 "), type(%u), size(%zu)",
         op.getSerialNum(), (uint32_t)op.getType(), stream.size());
     Packet::Entry entry(op.getSerialNum(), op.getType(), vespalib::ConstBufferRef(stream.data(), stream.size()));
+    if (_batching) {
+        _batch.add(entry);
+        if (onDone) {
+            _batch_callbacks.push_back(std::move(onDone));
+        }
+        return;
+    }
     Packet packet(entry.serializedSize());
     packet.add(entry);
     _writer->append(packet, std::move(onDone));
 }
 
+void
+TlsMgrWriter::append_batch() {
+    if (_batch.empty()) {
+        return;
+    }
+    LOG(debug, "append_batch(): serialNum(%" PRIu64 "-%" PRIu64 "), count(%zu), size(%zu)",
+        _batch.range().from(), _batch.range().to(), _batch.size(), _batch.sizeBytes());
+    _writer->append(_batch, std::make_shared<vespalib::KeepAlive<DoneCallbacks>>(std::move(_batch_callbacks)));
+    _batch.clear();
+    _batch_callbacks = DoneCallbacks();
+}
+
 bool
 TlsMgrWriter::erase(SerialNum oldest_to_keep) {
     return _tls_mgr.getSession()->erase(oldest_to_keep);
@@ -757,6 +791,19 @@ FeedHandler::handleOperation(FeedToken token, FeedOperation::UP op)
     }));
 }
 
+void
+FeedHandler::handleOperations(FeedOperations ops)
+{
+    // See handleOperation() for why the calling thread is blocked.
+    _writeService.blocking_master_execute(makeLambdaTask([this, ops = std::move(ops)]() mutable {
+        _tlsWriter->start_batch();
+        for (auto &op : ops) {
+            doHandleOperation(std::move(op.first), std::move(op.second));
+        }
+        _tlsWriter->flush_batch();
+    }));
+}
+
 void
 FeedHandler::handleMove(MoveOperation &op, vespalib::IDestructorCallback::SP moveDoneCtx)
 {
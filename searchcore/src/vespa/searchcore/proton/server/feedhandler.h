@@ -138,6 +138,8 @@ private:
     void initiateCommit(vespalib::steady_time start_time);
     void enqueCommitTask();
 public:
+    using FeedOperations = std::vector<std::pair<FeedToken, std::unique_ptr<FeedOperation>>>;
+
     FeedHandler(const FeedHandler &) = delete;
     FeedHandler & operator = (const FeedHandler &) = delete;
     /**
@@ -238,6 +240,11 @@ public:
 
     void performOperation(FeedToken token, FeedOperationUP op);
     void handleOperation(FeedToken token, FeedOperationUP op);
+    /**
+     * Handles the given external feed operations in order, as one task in
+     * the master write thread, storing them in the transaction log together.
+     */
+    void handleOperations(FeedOperations ops);
 
     void handleMove(MoveOperation &op, std::shared_ptr<vespalib::IDestructorCallback> moveDoneCtx) override;
     void heartBeat() override;
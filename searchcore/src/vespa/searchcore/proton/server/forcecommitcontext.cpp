@@ -3,6 +3,7 @@
 #include "forcecommitcontext.h"
 #include "forcecommitdonetask.h"
 #include <vespa/searchcore/proton/common/docid_limit.h>
+#include <vespa/searchcore/proton/documentmetastore/i_document_meta_store_context.h>
 #include <vespa/searchcore/proton/reference/i_pending_gid_to_lid_changes.h>
 #include <cassert>
 
@@ -17,6 +18,8 @@ ForceCommitContext::ForceCommitContext(vespalib::Executor &executor,
       _task(std::make_unique<ForceCommitDoneTask>(documentMetaStore, std::move(pending_gid_to_lid_changes))),
       _committedDocIdLimit(0u),
       _docIdLimit(nullptr),
+      _visibleSerialNum(0u),
+      _documentMetaStoreContext(nullptr),
       _onDone(std::move(onDone)),
       _lidsToCommit(std::move(lidsToCommit))
 {
@@ -27,6 +30,9 @@ ForceCommitContext::~ForceCommitContext()
     if (_docIdLimit != nullptr) {
         _docIdLimit->bumpUpLimit(_committedDocIdLimit);
     }
+    if (_documentMetaStoreContext != nullptr) {
+        _documentMetaStoreContext->bumpVisibleSerialNum(_visibleSerialNum);
+    }
     if (!_task->empty()) {
         vespalib::Executor::Task::UP res = _executor.execute(std::move(_task));
         assert(!res);
@@ -52,4 +58,11 @@ ForceCommitContext::registerCommittedDocIdLimit(uint32_t committedDocIdLimit, Do
     _docIdLimit = docIdLimit;
 }
 
+void
+ForceCommitContext::registerVisibleSerialNum(search::SerialNum serialNum, IDocumentMetaStoreContext *documentMetaStoreContext)
+{
+    _visibleSerialNum = serialNum;
+    _documentMetaStoreContext = documentMetaStoreContext;
+}
+
 }  // namespace proton
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/searchcore/proton/common/pendinglidtracker.h>
+#include <vespa/searchlib/common/serialnum.h>
 #include <vespa/vespalib/util/idestructorcallback.h>
 
 namespace vespalib { class Executor; }
@@ -11,6 +12,7 @@ namespace proton {
 
 class ForceCommitDoneTask;
 struct IDocumentMetaStore;
+struct IDocumentMetaStoreContext;
 class DocIdLimit;
 class IPendingGidToLidChanges;
 
@@ -28,6 +30,8 @@ class ForceCommitContext : public vespalib::IDestructorCallback
     std::unique_ptr<ForceCommitDoneTask>  _task;
     uint32_t                              _committedDocIdLimit;
     DocIdLimit                           *_docIdLimit;
+    search::SerialNum                     _visibleSerialNum;
+    IDocumentMetaStoreContext            *_documentMetaStoreContext;
     std::shared_ptr<IDestructorCallback>  _onDone;
     PendingLidTrackerBase::Snapshot       _lidsToCommit;
 
@@ -43,6 +47,11 @@ public:
     void reuseLids(std::vector<uint32_t> &&lids);
     void holdUnblockShrinkLidSpace();
     void registerCommittedDocIdLimit(uint32_t committedDocIdLimit, DocIdLimit *docIdLimit);
+    /**
+     * Publish the given serial number as visible to search in the given
+     * meta store context when all the commit work is done.
+     */
+    void registerVisibleSerialNum(search::SerialNum serialNum, IDocumentMetaStoreContext *documentMetaStoreContext);
 };
 
 }  // namespace proton
@@ -58,7 +58,7 @@ MatchView::getMatcher(const vespalib::string & rankProfile) const
 MatchContext::UP
 MatchView::createContext() const {
     IAttributeContext::UP attrCtx = _attrMgr->createContext();
-    auto searchCtx = std::make_unique<SearchContext>(_indexSearchable, _docIdLimit.get());
+    auto searchCtx = std::make_unique<SearchContext>(_indexSearchable, _docIdLimit.get(), _attrMgr->get_filter_search_cache());
     return std::make_unique<MatchContext>(std::move(attrCtx), std::move(searchCtx));
 }
 
@@ -11,8 +11,10 @@
 #include <vespa/searchcore/proton/feedoperation/splitbucketoperation.h>
 #include <vespa/searchcore/proton/feedoperation/updateoperation.h>
 #include <vespa/document/update/documentupdate.h>
+#include <vespa/persistence/spi/feed_batch.h>
 
 using storage::spi::Bucket;
+using storage::spi::FeedBatch;
 using storage::spi::Timestamp;
 
 namespace proton {
@@ -54,6 +56,29 @@ PersistenceHandlerProxy::handleRemove(FeedToken token, const Bucket &bucket, Tim
     _feedHandler.handleOperation(std::move(token), std::move(op));
 }
 
+void
+PersistenceHandlerProxy::handleFeedBatch(std::vector<FeedToken> tokens, const Bucket &bucket, FeedBatch batch)
+{
+    document::BucketId bucketId = bucket.getBucketId().stripUnused();
+    FeedHandler::FeedOperations ops;
+    ops.reserve(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        auto &entry = batch.entries()[i];
+        switch (entry.type) {
+        case FeedBatch::Type::PUT:
+            ops.emplace_back(std::move(tokens[i]), std::make_unique<PutOperation>(bucketId, entry.timestamp, std::move(entry.doc)));
+            break;
+        case FeedBatch::Type::REMOVE:
+            ops.emplace_back(std::move(tokens[i]), std::make_unique<RemoveOperationWithDocId>(bucketId, entry.timestamp, entry.remove_id));
+            break;
+        case FeedBatch::Type::UPDATE:
+            ops.emplace_back(std::move(tokens[i]), std::make_unique<UpdateOperation>(bucketId, entry.timestamp, std::move(entry.update)));
+            break;
+        }
+    }
+    _feedHandler.handleOperations(std::move(ops));
+}
+
 void
 PersistenceHandlerProxy::handleListBuckets(IBucketIdListResultHandler &resultHandler)
 {
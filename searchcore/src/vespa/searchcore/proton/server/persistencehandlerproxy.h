@@ -36,6 +36,9 @@ public:
                       storage::spi::Timestamp timestamp,
                       const document::DocumentId &id) override;
 
+    void handleFeedBatch(std::vector<FeedToken> tokens, const storage::spi::Bucket &bucket,
+                         storage::spi::FeedBatch batch) override;
+
     void handleListBuckets(IBucketIdListResultHandler &resultHandler) override;
     void handleSetClusterState(const storage::spi::ClusterState &calc, IGenericResultHandler &resultHandler) override;
 
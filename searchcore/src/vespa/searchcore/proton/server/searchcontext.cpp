@@ -25,8 +25,14 @@ uint32_t SearchContext::getDocIdLimit()
 }
 
 SearchContext::SearchContext(const std::shared_ptr<IndexSearchable> &indexSearchable, uint32_t docIdLimit)
+    : SearchContext(indexSearchable, docIdLimit, {})
+{
+}
+
+SearchContext::SearchContext(const std::shared_ptr<IndexSearchable> &indexSearchable, uint32_t docIdLimit,
+                             std::shared_ptr<search::attribute::FilterSearchCache> filterSearchCache)
     : _indexSearchable(indexSearchable),
-      _attributeBlueprintFactory(),
+      _attributeBlueprintFactory(std::move(filterSearchCache)),
       _docIdLimit(docIdLimit)
 {
 }
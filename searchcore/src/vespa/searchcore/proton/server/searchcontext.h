@@ -26,6 +26,8 @@ private:
 
 public:
     SearchContext(const std::shared_ptr<IndexSearchable> &indexSearchable, uint32_t docIdLimit);
+    SearchContext(const std::shared_ptr<IndexSearchable> &indexSearchable, uint32_t docIdLimit,
+                  std::shared_ptr<search::attribute::FilterSearchCache> filterSearchCache);
     ~SearchContext() override;
 };
 
@@ -224,10 +224,14 @@ StoreOnlyFeedView::forceCommit(const CommitParam & param, DoneCallback onDone)
     if (useDocumentMetaStore(param.lastSerialNum())) {
         _metaStore.commit(param);
     }
-    internalForceCommit(param, std::make_shared<ForceCommitContext>(_writeService.master(), _metaStore,
-                                                                    _pendingLidsForCommit->produceSnapshot(),
-                                                                    _gidToLidChangeHandler.grab_pending_changes(),
-                                                                    onDone));
+    auto commitContext = std::make_shared<ForceCommitContext>(_writeService.master(), _metaStore,
+                                                              _pendingLidsForCommit->produceSnapshot(),
+                                                              _gidToLidChangeHandler.grab_pending_changes(),
+                                                              onDone);
+    // Attribute and memory index commits complete asynchronously, the commit context is
+    // released when they are visible to search.
+    commitContext->registerVisibleSerialNum(param.lastSerialNum(), _documentMetaStoreContext.get());
+    internalForceCommit(param, commitContext);
 }
 
 void
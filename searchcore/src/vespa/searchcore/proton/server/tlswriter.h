@@ -15,6 +15,13 @@ struct TlsWriter : public IOperationStorer {
 
     virtual bool erase(search::SerialNum oldest_to_keep) = 0;
     virtual search::SerialNum sync(search::SerialNum syncTo) = 0;
+
+    /**
+     * Operations appended after start_batch() may be held back, and stored
+     * together when flush_batch() or startCommit() is called.
+     */
+    virtual void start_batch() { }
+    virtual void flush_batch() { }
 };
 
 }
@@ -28,6 +28,8 @@ struct DocumentMetaStoreContextObserver : public IDocumentMetaStoreContext
     proton::IDocumentMetaStore &     get()       override { return *_observer; }
     IReadGuard::UP          getReadGuard() const override { return _context.getReadGuard(); }
     void               constructFreeList()       override { return _context.constructFreeList(); }
+    search::SerialNum getVisibleSerialNum() const override { return _context.getVisibleSerialNum(); }
+    void bumpVisibleSerialNum(search::SerialNum serialNum) override { _context.bumpVisibleSerialNum(serialNum); }
 };
 
 }
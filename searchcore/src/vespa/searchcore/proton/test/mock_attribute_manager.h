@@ -99,6 +99,9 @@ public:
     const ImportedAttributesRepo *getImportedAttributes() const override {
         return _importedAttributes.get();
     }
+    std::shared_ptr<search::attribute::FilterSearchCache> get_filter_search_cache() const override {
+        return {};
+    }
     void asyncForAttribute(const vespalib::string & name, std::unique_ptr<IAttributeFunctor> func) const override {
         _mock.asyncForAttribute(name, std::move(func));
     }
@@ -84,6 +84,7 @@ private:
         const IAttributeVector *getAttributeStableEnum(const vespalib::string &) const override { return nullptr; }
         const vespalib::eval::Value* get_query_tensor(const vespalib::string&) const override;
         const AttributeBlueprintParams& get_attribute_blueprint_params() const override { return _params; }
+        bool use_weakand_block_max() const override { return false; }
     private:
         const vespalib::Doom _doom;
         const AttributeBlueprintParams _params;
@@ -6,6 +6,7 @@
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/signalhandler.h>
 #include <vespa/vespalib/util/exception.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <cinttypes>
 #include <cassert>
 
@@ -27,12 +28,14 @@ CreateIdxFileFromDatApp::usage(const char *self)
 }
 
 namespace {
-bool tryDecode(size_t chunks, size_t offset, const char * p, size_t sz, size_t nextSync)
+using ZStdDictionary = vespalib::compression::ZStdDictionary;
+
+bool tryDecode(size_t chunks, size_t offset, const char * p, size_t sz, size_t nextSync, const ZStdDictionary * dictionary)
 {
     bool success(false);
     for (size_t lengthError(0); !success && (sz + lengthError <= nextSync); lengthError++) {
         try {
-            Chunk chunk(chunks, p, sz + lengthError, false);
+            Chunk chunk(chunks, p, sz + lengthError, false, dictionary);
             success = true;
         } catch (const vespalib::Exception & e) {
             fprintf(stdout, "Chunk %ld, with size=%ld failed with lengthError %ld due to '%s'\n", offset, sz, lengthError, e.what());
@@ -47,7 +50,7 @@ bool validUncompressed(const char * n, size_t offset) {
            (n[3] == 0) &&
            (n[4] == 0) &&
            (n[5] != 0) &&
-           tryDecode(0, offset, n, 6ul + 4ul + uint8_t(n[5]), 6ul + 4ul + uint8_t(n[5]) + 4);
+           tryDecode(0, offset, n, 6ul + 4ul + uint8_t(n[5]), 6ul + 4ul + uint8_t(n[5]) + 4, nullptr);
 }
 
 bool validHead(const char * n, size_t offset) {
@@ -55,14 +58,16 @@ bool validHead(const char * n, size_t offset) {
 }
 
 uint64_t
-generate(uint64_t serialNum, size_t chunks, FastOS_FileInterface & idxFile, size_t sz, const char * current, const char * start, const char * nextStart) __attribute__((noinline));
+generate(uint64_t serialNum, size_t chunks, FastOS_FileInterface & idxFile, size_t sz, const char * current, const char * start, const char * nextStart,
+         const ZStdDictionary * dictionary) __attribute__((noinline));
 uint64_t
-generate(uint64_t serialNum, size_t chunks, FastOS_FileInterface & idxFile, size_t sz, const char * current, const char * start, const char * nextStart)
+generate(uint64_t serialNum, size_t chunks, FastOS_FileInterface & idxFile, size_t sz, const char * current, const char * start, const char * nextStart,
+         const ZStdDictionary * dictionary)
 {
     vespalib::nbostream os;
     for (size_t lengthError(0); int64_t(sz+lengthError) <= nextStart-start; lengthError++) {
         try {
-            Chunk chunk(chunks, current, sz + lengthError, false);
+            Chunk chunk(chunks, current, sz + lengthError, false, dictionary);
             fprintf(stdout, "id=%d lastSerial=%" PRIu64 " count=%ld\n", chunk.getId(), chunk.getLastSerial(), chunk.count());
             const Chunk::LidList & lidlist = chunk.getLids();
             if (chunk.getLastSerial() < serialNum) {
@@ -91,6 +96,7 @@ int CreateIdxFileFromDatApp::createIdxFile(const vespalib::string & datFileName,
     MMapRandRead datFile(datFileName, 0, 0);
     int64_t fileSize = datFile.getSize();
     uint64_t datHeaderLen = FileChunk::readDataHeader(datFile);
+    FileChunk::DictionarySP dictionary = FileChunk::readDataDictionary(datFile, datHeaderLen);
     const char * start = static_cast<const char *>(datFile.getMapping());
     const char * end = start + fileSize;
     uint64_t chunks(0);
@@ -112,7 +118,7 @@ int CreateIdxFileFromDatApp::createIdxFile(const vespalib::string & datFileName,
                     while(*(tail-1) == 0) {
                         tail--;
                     }
-                    if (tryDecode(chunks, current-start, current, tail - current, nextStart-current)) {
+                    if (tryDecode(chunks, current-start, current, tail - current, nextStart-current, dictionary.get())) {
                         break;
                     } else {
                         fprintf(stdout, "chunk %" PRIu64 " possibly starting at %ld ending at %ld false sync at pos=%ld\n",
@@ -129,7 +135,7 @@ int CreateIdxFileFromDatApp::createIdxFile(const vespalib::string & datFileName,
             }
             uint64_t sz = tail - current;
             fprintf(stdout, "Most likely found chunk at offset %ld with length %" PRIu64 "\n", current - start, sz);
-            serialNum = generate(serialNum, chunks,idxFile, sz, current, start, nextStart);
+            serialNum = generate(serialNum, chunks,idxFile, sz, current, start, nextStart, dictionary.get());
             chunks++;
             for(current += alignment; current < tail; current += alignment);
         } else {
@@ -0,0 +1,283 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/document/update/arithmeticvalueupdate.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/compressed_numeric_block.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/search_context.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <limits>
+#include <random>
+
+using Arith = document::ArithmeticValueUpdate;
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::IntegerAttribute;
+using search::QueryTermSimple;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::CompressedNumericBlock;
+using search::attribute::Config;
+using search::attribute::SearchContextParams;
+using search::fef::TermFieldMatchData;
+
+namespace {
+
+constexpr uint32_t block_size = CompressedNumericBlock::block_size;
+constexpr int64_t undefined = std::numeric_limits<int64_t>::min();
+
+std::vector<int64_t>
+make_values(int64_t value)
+{
+    return std::vector<int64_t>(block_size, value);
+}
+
+std::vector<int64_t>
+decode(const std::vector<int64_t>& block, int64_t default_value)
+{
+    std::vector<int64_t> values(block_size);
+    CompressedNumericBlock::decode(block, default_value, values.data());
+    return values;
+}
+
+uint64_t
+expected_hits(const std::vector<int64_t>& values, int64_t low, int64_t high)
+{
+    uint64_t hits = 0;
+    for (uint32_t i = 0; i < block_size; ++i) {
+        if (low <= values[i] && values[i] <= high) {
+            hits |= uint64_t(1) << i;
+        }
+    }
+    return hits;
+}
+
+void
+assert_round_trip(const std::vector<int64_t>& values, int64_t default_value)
+{
+    auto block = CompressedNumericBlock::encode(values.data(), default_value);
+    EXPECT_LE(block.size(), CompressedNumericBlock::max_array_size);
+    EXPECT_EQ(values, decode(block, default_value));
+    for (uint32_t i = 0; i < block_size; ++i) {
+        EXPECT_EQ(values[i], CompressedNumericBlock::get(block, i, default_value));
+    }
+}
+
+}
+
+TEST(CompressedNumericBlockTest, block_with_only_default_values_is_empty)
+{
+    auto values = make_values(undefined);
+    auto block = CompressedNumericBlock::encode(values.data(), undefined);
+    EXPECT_TRUE(block.empty());
+    EXPECT_EQ(values, decode(block, undefined));
+    EXPECT_EQ(undefined, CompressedNumericBlock::get(block, 17, undefined));
+    EXPECT_EQ(0u, CompressedNumericBlock::match(block, 0, 10, false));
+    EXPECT_EQ(std::numeric_limits<uint64_t>::max(), CompressedNumericBlock::match(block, 0, 10, true));
+}
+
+TEST(CompressedNumericBlockTest, narrow_range_gives_narrow_codes)
+{
+    std::vector<int64_t> values(block_size);
+    for (uint32_t i = 0; i < block_size; ++i) {
+        values[i] = 1000000 + (i % 7);
+    }
+    auto block = CompressedNumericBlock::encode(values.data(), undefined);
+    EXPECT_EQ(3u, CompressedNumericBlock::get_width(block));
+    EXPECT_EQ(0u, CompressedNumericBlock::get_num_exceptions(block));
+    EXPECT_EQ(CompressedNumericBlock::header_size + 3, block.size());
+    assert_round_trip(values, undefined);
+}
+
+TEST(CompressedNumericBlockTest, outliers_are_stored_as_exceptions)
+{
+    std::vector<int64_t> values(block_size);
+    for (uint32_t i = 0; i < block_size; ++i) {
+        values[i] = 42 + (i % 3);
+    }
+    values[5] = std::numeric_limits<int64_t>::max();
+    values[60] = -1000000000;
+    auto block = CompressedNumericBlock::encode(values.data(), undefined);
+    // Codes for default value, 3 values and exception marker
+    EXPECT_EQ(3u, CompressedNumericBlock::get_width(block));
+    EXPECT_EQ(2u, CompressedNumericBlock::get_num_exceptions(block));
+    assert_round_trip(values, undefined);
+    EXPECT_EQ(expected_hits(values, 43, 43), CompressedNumericBlock::match(block, 43, 43, false));
+    EXPECT_EQ(expected_hits(values, 44, std::numeric_limits<int64_t>::max()),
+              CompressedNumericBlock::match(block, 44, std::numeric_limits<int64_t>::max(), false));
+    EXPECT_EQ(expected_hits(values, -1000000000, 42), CompressedNumericBlock::match(block, -1000000000, 42, false));
+}
+
+TEST(CompressedNumericBlockTest, full_value_range_is_handled)
+{
+    std::vector<int64_t> values(block_size);
+    for (uint32_t i = 0; i < block_size; ++i) {
+        values[i] = (i & 1) ? std::numeric_limits<int64_t>::max() : std::numeric_limits<int64_t>::min() + 1 + i;
+    }
+    assert_round_trip(values, undefined);
+    auto block = CompressedNumericBlock::encode(values.data(), undefined);
+    EXPECT_EQ(expected_hits(values, 0, std::numeric_limits<int64_t>::max()),
+              CompressedNumericBlock::match(block, 0, std::numeric_limits<int64_t>::max(), false));
+}
+
+TEST(CompressedNumericBlockTest, default_value_is_matched_only_when_requested)
+{
+    auto values = make_values(0);
+    values[3] = 10;
+    values[9] = 12;
+    auto block = CompressedNumericBlock::encode(values.data(), 0);
+    assert_round_trip(values, 0);
+    EXPECT_EQ((uint64_t(1) << 3) | (uint64_t(1) << 9), CompressedNumericBlock::match(block, 5, 15, false));
+    EXPECT_EQ(expected_hits(values, -5, 15), CompressedNumericBlock::match(block, -5, 15, true));
+    EXPECT_EQ(0u, CompressedNumericBlock::match(block, 13, 20, false));
+    EXPECT_EQ(0u, CompressedNumericBlock::match(block, 20, 13, false));
+}
+
+TEST(CompressedNumericBlockTest, random_blocks_round_trip_and_match)
+{
+    std::mt19937_64 rnd(42);
+    for (uint32_t iter = 0; iter < 2000; ++iter) {
+        uint32_t range_bits = 1 + (iter % 63);
+        int64_t base = static_cast<int64_t>(rnd());
+        std::vector<int64_t> values(block_size);
+        for (uint32_t i = 0; i < block_size; ++i) {
+            uint32_t kind = rnd() % 16;
+            if (kind == 0) {
+                values[i] = undefined;
+            } else if (kind == 1) {
+                values[i] = static_cast<int64_t>(rnd());
+            } else {
+                values[i] = static_cast<int64_t>(static_cast<uint64_t>(base) + (rnd() >> (64 - range_bits)));
+            }
+        }
+        assert_round_trip(values, undefined);
+        auto block = CompressedNumericBlock::encode(values.data(), undefined);
+        int64_t a = values[rnd() % block_size];
+        int64_t b = values[rnd() % block_size];
+        int64_t low = std::min(a, b);
+        int64_t high = std::max(a, b);
+        auto exp = expected_hits(values, low, high);
+        if (low == undefined) {
+            EXPECT_EQ(exp, CompressedNumericBlock::match(block, low, high, true));
+        } else {
+            EXPECT_EQ(exp, CompressedNumericBlock::match(block, low, high, false));
+        }
+        if (HasFailure()) {
+            break;
+        }
+    }
+}
+
+class CompressedAttributeTest : public ::testing::Test {
+protected:
+    std::shared_ptr<AttributeVector> _attr;
+    std::vector<int32_t> _values;
+
+    CompressedAttributeTest()
+        : _attr(),
+          _values()
+    {
+        Config cfg(BasicType::INT32, CollectionType::SINGLE);
+        cfg.setCompressed(true);
+        _attr = AttributeFactory::createAttribute("compressed", cfg);
+    }
+    ~CompressedAttributeTest() override;
+
+    IntegerAttribute& iattr() { return dynamic_cast<IntegerAttribute&>(*_attr); }
+
+    void add_docs(uint32_t num_docs) {
+        _attr->addReservedDoc();
+        _values.emplace_back(search::attribute::getUndefined<int32_t>());
+        for (uint32_t i = 0; i < num_docs; ++i) {
+            uint32_t doc_id = 0;
+            _attr->addDoc(doc_id);
+            _values.emplace_back(search::attribute::getUndefined<int32_t>());
+        }
+        _attr->commit();
+    }
+    void update(uint32_t doc_id, int32_t value) {
+        iattr().update(doc_id, value);
+        _values[doc_id] = value;
+    }
+    void assert_values() {
+        for (uint32_t doc_id = 1; doc_id < _values.size(); ++doc_id) {
+            EXPECT_EQ(_values[doc_id], _attr->getInt(doc_id)) << "doc_id=" << doc_id;
+        }
+    }
+    std::vector<uint32_t> search(const vespalib::string& term, bool strict) {
+        auto ctx = _attr->getSearch(std::make_unique<QueryTermSimple>(term, QueryTermSimple::Type::WORD), SearchContextParams());
+        TermFieldMatchData tfmd;
+        auto itr = ctx->createIterator(&tfmd, strict);
+        uint32_t doc_id_limit = _attr->getCommittedDocIdLimit();
+        itr->initRange(1, doc_id_limit);
+        std::vector<uint32_t> result;
+        for (uint32_t doc_id = 1; doc_id < doc_id_limit; ++doc_id) {
+            if (itr->seek(doc_id)) {
+                result.emplace_back(doc_id);
+            } else if (strict) {
+                doc_id = itr->getDocId() - 1;
+            }
+        }
+        return result;
+    }
+    std::vector<uint32_t> expected(int32_t low, int32_t high) {
+        std::vector<uint32_t> result;
+        for (uint32_t doc_id = 1; doc_id < _values.size(); ++doc_id) {
+            if (!search::attribute::isUndefined(_values[doc_id]) && low <= _values[doc_id] && _values[doc_id] <= high) {
+                result.emplace_back(doc_id);
+            }
+        }
+        return result;
+    }
+    void assert_search(const vespalib::string& term, int32_t low, int32_t high) {
+        auto exp = expected(low, high);
+        EXPECT_EQ(exp, search(term, true)) << "term=" << term;
+        EXPECT_EQ(exp, search(term, false)) << "term=" << term;
+    }
+};
+
+CompressedAttributeTest::~CompressedAttributeTest() = default;
+
+TEST_F(CompressedAttributeTest, values_can_be_updated_and_searched)
+{
+    add_docs(300);
+    for (uint32_t doc_id = 1; doc_id < 300; doc_id += 3) {
+        update(doc_id, 1000 + (doc_id % 11));
+    }
+    update(100, -5);
+    update(257, 2000000000);
+    _attr->commit();
+    assert_values();
+    assert_search("1005", 1005, 1005);
+    assert_search("[1003;1007]", 1003, 1007);
+    assert_search("[-10;0]", -10, 0);
+    assert_search(">1008", 1009, std::numeric_limits<int32_t>::max());
+    iattr().clearDoc(100);
+    _values[100] = search::attribute::getUndefined<int32_t>();
+    EXPECT_TRUE(iattr().apply(4, Arith(Arith::Sub, 1010)));
+    _values[4] -= 1010;
+    _attr->commit();
+    assert_values();
+    assert_search("[-10;0]", -10, 0);
+}
+
+TEST_F(CompressedAttributeTest, lid_space_can_be_shrunk)
+{
+    add_docs(200);
+    for (uint32_t doc_id = 1; doc_id < 200; ++doc_id) {
+        update(doc_id, doc_id);
+    }
+    _attr->commit();
+    _attr->compactLidSpace(70);
+    _attr->shrinkLidSpace();
+    _values.resize(70);
+    EXPECT_EQ(70u, _attr->getNumDocs());
+    assert_values();
+    assert_search("[60;100]", 60, 100);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,101 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchlib/attribute/filter_search_cache.h>
+#include <vespa/searchlib/common/bitvector.h>
+
+using namespace search;
+using namespace search::attribute;
+
+using Entry = FilterSearchCache::Entry;
+
+Entry::SP
+makeEntry(uint32_t generation, uint32_t docIdLimit)
+{
+    return std::make_shared<Entry>(BitVector::create(docIdLimit), generation, docIdLimit, 0);
+}
+
+TEST("require that a term must be missed before its result is inserted")
+{
+    FilterSearchCache cache(FilterSearchCache::DEFAULT_MAX_MEMORY, 2);
+    auto key = FilterSearchCache::makeKey("foo", 'r', "[1;5]");
+    EXPECT_FALSE(cache.lookup(key, 1, 100).shouldInsert);
+    auto result = cache.lookup(key, 1, 100);
+    EXPECT_TRUE(result.shouldInsert);
+    EXPECT_TRUE(result.entry.get() == nullptr);
+    auto entry = makeEntry(1, 100);
+    cache.insert(key, entry);
+    result = cache.lookup(key, 1, 100);
+    EXPECT_FALSE(result.shouldInsert);
+    EXPECT_EQUAL(entry, result.entry);
+    auto stats = cache.getStats();
+    EXPECT_EQUAL(1u, stats.hits);
+    EXPECT_EQUAL(2u, stats.misses);
+    EXPECT_EQUAL(1u, stats.elements);
+}
+
+TEST("require that keys include attribute name and term kind")
+{
+    EXPECT_NOT_EQUAL(FilterSearchCache::makeKey("foo", 'n', "5"), FilterSearchCache::makeKey("foo", 's', "5"));
+    EXPECT_NOT_EQUAL(FilterSearchCache::makeKey("foo", 'n', "5"), FilterSearchCache::makeKey("bar", 'n', "5"));
+}
+
+TEST("require that entries are dropped when the attribute has changed")
+{
+    FilterSearchCache cache(FilterSearchCache::DEFAULT_MAX_MEMORY, 1);
+    auto key = FilterSearchCache::makeKey("foo", 'n', "5");
+    cache.insert(key, makeEntry(1, 100));
+    EXPECT_TRUE(cache.lookup(key, 1, 100).entry);
+    auto result = cache.lookup(key, 2, 100);
+    EXPECT_TRUE(result.entry.get() == nullptr);
+    EXPECT_TRUE(result.shouldInsert);
+    EXPECT_EQUAL(0u, cache.size());
+    cache.insert(key, makeEntry(2, 100));
+    EXPECT_TRUE(cache.lookup(key, 2, 100).entry);
+    EXPECT_TRUE(cache.lookup(key, 2, 101).entry.get() == nullptr);
+    auto stats = cache.getStats();
+    EXPECT_EQUAL(2u, stats.invalidations);
+    EXPECT_EQUAL(0u, stats.elements);
+    EXPECT_EQUAL(0u, stats.memory_used);
+}
+
+TEST("require that least recently used entries are evicted when memory is exhausted")
+{
+    constexpr uint32_t docIdLimit = 80000;
+    size_t entryMemory = BitVector::getFileBytes(docIdLimit);
+    FilterSearchCache cache(entryMemory * 2 + entryMemory / 2, 1);
+    auto key1 = FilterSearchCache::makeKey("foo", 'n', "1");
+    auto key2 = FilterSearchCache::makeKey("foo", 'n', "2");
+    auto key3 = FilterSearchCache::makeKey("foo", 'n', "3");
+    cache.insert(key1, makeEntry(1, docIdLimit));
+    cache.insert(key2, makeEntry(1, docIdLimit));
+    EXPECT_EQUAL(2u, cache.size());
+    EXPECT_TRUE(cache.lookup(key1, 1, docIdLimit).entry);
+    cache.insert(key3, makeEntry(1, docIdLimit));
+    EXPECT_EQUAL(2u, cache.size());
+    EXPECT_TRUE(cache.lookup(key1, 1, docIdLimit).entry);
+    EXPECT_TRUE(cache.lookup(key2, 1, docIdLimit).entry.get() == nullptr);
+    EXPECT_TRUE(cache.lookup(key3, 1, docIdLimit).entry);
+    EXPECT_LESS_EQUAL(cache.getStats().memory_used, entryMemory * 2 + entryMemory / 2);
+}
+
+TEST("require that entries larger than the cache are not inserted")
+{
+    FilterSearchCache cache(1000, 1);
+    auto key = FilterSearchCache::makeKey("foo", 'n', "5");
+    cache.insert(key, makeEntry(1, 80000));
+    EXPECT_EQUAL(0u, cache.size());
+}
+
+TEST("require that cache can be cleared")
+{
+    FilterSearchCache cache(FilterSearchCache::DEFAULT_MAX_MEMORY, 1);
+    cache.insert(FilterSearchCache::makeKey("foo", 'n', "1"), makeEntry(1, 100));
+    cache.insert(FilterSearchCache::makeKey("foo", 'n', "2"), makeEntry(1, 100));
+    EXPECT_EQUAL(2u, cache.size());
+    cache.clear();
+    EXPECT_EQUAL(0u, cache.size());
+    EXPECT_EQUAL(0u, cache.getStats().memory_used);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
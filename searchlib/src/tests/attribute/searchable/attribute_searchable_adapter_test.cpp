@@ -7,6 +7,7 @@
 #include <vespa/searchlib/attribute/attributecontext.h>
 #include <vespa/searchlib/attribute/attributeguard.h>
 #include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/searchlib/attribute/filter_search_cache.h>
 #include <vespa/searchlib/attribute/attribute_read_guard.h>
 #include <vespa/searchlib/attribute/singlestringattribute.h>
 #include <vespa/searchlib/attribute/iattributemanager.h>
@@ -208,15 +209,20 @@ void extract_wand_params(Result &result, ParallelWeakAndSearch *wand) {
     }
 }
 
-Result do_search(IAttributeManager &attribute_manager, const Node &node, bool strict) {
+Result do_search(IAttributeManager &attribute_manager, const Node &node, bool strict,
+                 std::shared_ptr<FilterSearchCache> filter_cache = {}) {
     uint32_t fieldId = 0;
     AttributeContext ac(attribute_manager);
     FakeRequestContext requestContext(&ac);
-    AttributeBlueprintFactory source;
+    bool is_filter = bool(filter_cache);
+    AttributeBlueprintFactory source(std::move(filter_cache));
     MatchDataLayout mdl;
     TermFieldHandle handle = mdl.allocTermField(fieldId);
     MatchData::UP match_data = mdl.createMatchData();
-    Blueprint::UP bp = source.createBlueprint(requestContext, FieldSpec(field, fieldId, handle), node);
+    Blueprint::UP bp = source.createBlueprint(requestContext, FieldSpec(field, fieldId, handle, is_filter), node);
+    if (is_filter) {
+        bp->setDocIdLimit(num_docs);
+    }
     ASSERT_TRUE(bp);
     Result result(bp->getState().estimate().estHits, bp->getState().estimate().empty);
     bp->fetchPostings(queryeval::ExecuteInfo::create(strict, 1.0));
@@ -632,6 +638,35 @@ TEST("require that suffix terms work") {
     EXPECT_EQUAL(50u, result.hits[2].docid);
 }
 
+TEST("require that filter term results are cached until the attribute changes") {
+    MyAttributeManager attribute_manager = makeAttributeManager(int64_t(42));
+    auto cache = std::make_shared<FilterSearchCache>(FilterSearchCache::DEFAULT_MAX_MEMORY, 2);
+    vespalib::string term = "[40;50]";
+    SimpleRangeTerm node(term, "", 0, Weight(1));
+    for (uint32_t i = 0; i < 3; ++i) {
+        Result result = do_search(attribute_manager, node, true, cache);
+        ASSERT_EQUAL(1u, result.hits.size());
+        EXPECT_EQUAL(num_docs - 1, result.hits[0].docid);
+        EXPECT_EQUAL((i == 0) ? 0u : 1u, cache->size());
+    }
+    auto stats = cache->getStats();
+    EXPECT_EQUAL(1u, stats.hits);
+    EXPECT_EQUAL(2u, stats.misses);
+    EXPECT_GREATER(stats.memory_used, num_docs / 8);
+
+    auto &attr = dynamic_cast<IntegerAttribute &>(*attribute_manager.getAttribute(field)->get());
+    attr.update(10, 45);
+    attr.commit();
+    Result result = do_search(attribute_manager, node, true, cache);
+    ASSERT_EQUAL(2u, result.hits.size());
+    EXPECT_EQUAL(10u, result.hits[0].docid);
+    EXPECT_EQUAL(num_docs - 1, result.hits[1].docid);
+    stats = cache->getStats();
+    EXPECT_EQUAL(1u, stats.hits);
+    EXPECT_EQUAL(1u, stats.invalidations);
+    EXPECT_EQUAL(0u, cache->size());
+}
+
 void set_attr_value(AttributeVector &attr, uint32_t docid, size_t value) {
     IntegerAttribute *int_attr = dynamic_cast<IntegerAttribute *>(&attr);
     FloatingPointAttribute *float_attr = dynamic_cast<FloatingPointAttribute *>(&attr);
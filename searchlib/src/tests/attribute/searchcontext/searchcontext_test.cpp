@@ -18,6 +18,7 @@
 #include <vespa/searchlib/queryeval/simpleresult.h>
 #include <vespa/searchlib/test/attribute_builder.h>
 #include <vespa/searchlib/test/searchiteratorverifier.h>
+#include <vespa/vespalib/fuzzy/fuzzy_matcher.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/compress.h>
@@ -249,6 +250,8 @@ private:
     // test fuzzy search
     void testFuzzySearch(const vespalib::string& name, const Config& cfg);
     void testFuzzySearch();
+    void testFuzzySearchWithManyUniqueValues(const vespalib::string& name, const Config& cfg);
+    void testFuzzySearchWithManyUniqueValues();
 
     // test that search is working after clear doc
     template <typename VectorType, typename ValueType>
@@ -1471,6 +1474,48 @@ SearchContextTest::testFuzzySearch()
     }
 }
 
+void
+SearchContextTest::testFuzzySearchWithManyUniqueValues(const vespalib::string& name, const Config& cfg)
+{
+    LOG(info, "testFuzzySearchWithManyUniqueValues: vector '%s'", name.c_str());
+    const char * syllables[] = {"ba", "be", "da", "De", "ka", "ke"};
+    std::vector<vespalib::string> values;
+    for (auto a : syllables) {
+        for (auto b : syllables) {
+            for (auto c : syllables) {
+                values.emplace_back(vespalib::string(a) + b + c);
+            }
+        }
+    }
+    AttributePtr attr = AttributeFactory::createAttribute(name + "-fuzzy-many", cfg);
+    addDocs(*attr, values.size());
+    auto & string_attr = dynamic_cast<StringAttribute &>(*attr);
+    for (uint32_t i = 0; i < values.size(); ++i) {
+        EXPECT_TRUE(string_attr.update(i + 1, values[i]));
+    }
+    attr->commit();
+
+    // The expected hits are found by testing every value with the edit distance based matcher
+    for (const char * term : {"badeka", "KEKEKE", "bedab", "ddd", "zzzzzz"}) {
+        vespalib::FuzzyMatcher matcher(term, 2, 0, false);
+        DocSet expected;
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            if (matcher.isMatch(values[i].c_str())) {
+                expected.put(i + 1);
+            }
+        }
+        performSearch(*attr, term, expected, TermType::FUZZYTERM);
+    }
+}
+
+void
+SearchContextTest::testFuzzySearchWithManyUniqueValues()
+{
+    for (const char * name : {"s-str", "s-fs-str"}) {
+        testFuzzySearchWithManyUniqueValues(name, _stringCfg[name]);
+    }
+}
+
 
 template <typename VectorType, typename ValueType>
 void
@@ -1966,6 +2011,7 @@ SearchContextTest::Main()
     testSearchIteratorConformance();
     testSearchIteratorUnpacking();
     testFuzzySearch();
+    testFuzzySearchWithManyUniqueValues();
     TEST_DO(requireThatSearchIsWorkingAfterClearDoc());
     TEST_DO(requireThatSearchIsWorkingAfterLoadAndClearDoc());
     TEST_DO(requireThatSearchIsWorkingAfterUpdates());
@@ -125,12 +125,12 @@ public:
 class MockIndexLoader : public NearestNeighborIndexLoader {
 private:
     int& _index_value;
-    search::FileReader<int> _reader;
+    search::ReleasingBufferReader<int> _reader;
 
 public:
-    MockIndexLoader(int& index_value, FastOS_FileInterface& file)
+    MockIndexLoader(int& index_value, const search::fileutil::LoadedBuffer& buffer)
         : _index_value(index_value),
-          _reader(&file)
+          _reader(buffer)
     {}
     bool load_next() override {
         _index_value = _reader.readHostOrder();
@@ -157,6 +157,7 @@ private:
     generation_t _transfer_gen;
     generation_t _trim_gen;
     mutable size_t _memory_usage_cnt;
+    mutable std::vector<size_t> _batch_sizes;
     int _index_value;
 
 public:
@@ -169,6 +170,7 @@ public:
           _transfer_gen(std::numeric_limits<generation_t>::max()),
           _trim_gen(std::numeric_limits<generation_t>::max()),
           _memory_usage_cnt(0),
+          _batch_sizes(),
           _index_value(0)
     {
     }
@@ -225,6 +227,7 @@ public:
     generation_t get_transfer_gen() const { return _transfer_gen; }
     generation_t get_trim_gen() const { return _trim_gen; }
     size_t memory_usage_cnt() const { return _memory_usage_cnt; }
+    const std::vector<size_t>& batch_sizes() const { return _batch_sizes; }
 
     void add_document(uint32_t docid) override {
         auto vector = _vectors.get_vector(docid, 0).typify<double>();
@@ -277,8 +280,8 @@ public:
         }
         return std::unique_ptr<NearestNeighborIndexSaver>();
     }
-    std::unique_ptr<NearestNeighborIndexLoader> make_loader(FastOS_FileInterface& file) override {
-        return std::make_unique<MockIndexLoader>(_index_value, file);
+    std::unique_ptr<NearestNeighborIndexLoader> make_loader(const search::fileutil::LoadedBuffer& buffer) override {
+        return std::make_unique<MockIndexLoader>(_index_value, buffer);
     }
     std::vector<Neighbor> find_top_k(uint32_t k, vespalib::eval::TypedCells vector, uint32_t explore_k,
                                      double distance_threshold) const override
@@ -300,6 +303,12 @@ public:
         (void) distance_threshold;
         return std::vector<Neighbor>();
     }
+    std::vector<std::vector<Neighbor>> find_top_k_batch(const std::vector<TopKQuery>& queries,
+                                                        const GlobalFilter* filter) const override
+    {
+        _batch_sizes.push_back(queries.size());
+        return NearestNeighborIndex::find_top_k_batch(queries, filter);
+    }
 
     const search::tensor::DistanceFunction *distance_function() const override {
         static search::tensor::SquaredEuclideanDistance my_dist_fun(vespalib::eval::CellType::DOUBLE);
@@ -1139,7 +1148,8 @@ TEST_F("onLoad() uses executor if major index parameters are changed", DenseTens
     f.set_hnsw_index_params(HnswIndexParams(5, 20, DistanceMetric::Euclidean));
     EXPECT_EQUAL(0ul, f._executor.getStats().acceptedTasks);
     f.loadWithExecutor();
-    EXPECT_EQUAL(2ul, f._executor.getStats().acceptedTasks);
+    // Both documents are prepared in the same batch
+    EXPECT_EQUAL(1ul, f._executor.getStats().acceptedTasks);
     f.assert_example_tensors();
     auto& index = f.mock_index();
     EXPECT_EQUAL(0, index.get_index_value());
@@ -1172,6 +1182,14 @@ TEST_F("onLoad() uses saved nearest neighbor index if only minor index parameter
     index.expect_adds({});
 }
 
+TEST("Number of build threads is not part of the hnsw index parameters compared for config changes")
+{
+    HnswIndexParams lhs(4, 20, DistanceMetric::Euclidean, false, false, 1);
+    HnswIndexParams rhs(4, 20, DistanceMetric::Euclidean, false, false, 8);
+    EXPECT_TRUE(lhs == rhs);
+    EXPECT_FALSE(lhs == HnswIndexParams(4, 20, DistanceMetric::Euclidean, false, true, 1));
+}
+
 TEST_F("Nearest neighbor index type is added to attribute file header", DenseTensorAttributeMockIndex)
 {
     f.save_example_tensors_with_mock_index();
@@ -1183,11 +1201,11 @@ TEST_F("Nearest neighbor index type is added to attribute file header", DenseTen
 template <typename ParentT>
 class NearestNeighborBlueprintFixtureBase : public ParentT {
 private:
-    std::unique_ptr<Value> _query_tensor;
+    std::vector<std::unique_ptr<Value>> _query_tensors;
 
 public:
     NearestNeighborBlueprintFixtureBase()
-        : _query_tensor()
+        : _query_tensors()
     {
         this->set_tensor(1, vec_2d(1, 1));
         this->set_tensor(2, vec_2d(2, 2));
@@ -1202,8 +1220,8 @@ public:
     }
 
     const Value& create_query_tensor(const TensorSpec& spec) {
-        _query_tensor = SimpleValue::from_spec(spec);
-        return *_query_tensor;
+        _query_tensors.push_back(SimpleValue::from_spec(spec));
+        return *_query_tensors.back();
     }
 
     std::unique_ptr<NearestNeighborBlueprint> make_blueprint(bool approximate = true, double global_filter_lower_limit = 0.05) {
@@ -1294,6 +1312,28 @@ TEST_F("NN blueprint handles strong filter triggering exact search", NearestNeig
     EXPECT_EQUAL(NNBA::EXACT_FALLBACK, bp->get_algorithm());
 }
 
+TEST_F("NN blueprints using the same index perform top k search as one batch", NearestNeighborBlueprintFixture)
+{
+    auto bp1 = f.make_blueprint();
+    auto bp2 = f.make_blueprint();
+    auto bp3 = f.make_blueprint(true, 0.2);
+    auto filter = search::BitVector::create(1,11);
+    filter->setBit(3);
+    filter->invalidateCachedCount();
+    auto strong_filter = GlobalFilter::create(std::move(filter));
+    EXPECT_TRUE(bp1->global_filter_batch_key() != nullptr);
+    EXPECT_EQUAL(bp1->global_filter_batch_key(), bp2->global_filter_batch_key());
+    EXPECT_EQUAL(bp1->global_filter_batch_key(), bp3->global_filter_batch_key());
+    bp1->set_global_filter_batch({bp1.get(), bp2.get(), bp3.get()}, *strong_filter, 0.6);
+    EXPECT_EQUAL(std::vector<size_t>({2}), f.mock_index().batch_sizes());
+    EXPECT_EQUAL(NNBA::INDEX_TOP_K_WITH_FILTER, bp1->get_algorithm());
+    EXPECT_TRUE(bp1->get_batched_top_k());
+    EXPECT_EQUAL(NNBA::INDEX_TOP_K_WITH_FILTER, bp2->get_algorithm());
+    EXPECT_TRUE(bp2->get_batched_top_k());
+    EXPECT_EQUAL(NNBA::EXACT_FALLBACK, bp3->get_algorithm());
+    EXPECT_FALSE(bp3->get_batched_top_k());
+}
+
 TEST_F("NN blueprint wants global filter when having index", NearestNeighborBlueprintFixture)
 {
     auto bp = f.make_blueprint();
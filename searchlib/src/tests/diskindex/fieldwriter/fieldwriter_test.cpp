@@ -342,8 +342,10 @@ compare_files(const vespalib::string &file_name_prefix, const vespalib::string &
     FileChecksum baseline_checksum(file_name_prefix + file_name_suffix);
     FileChecksum cooked_fusion_checksum(file_name_prefix + "x" + file_name_suffix);
     FileChecksum raw_fusion_checksum(file_name_prefix + "xx" + file_name_suffix);
+    FileChecksum segmented_fusion_checksum(file_name_prefix + "xxx" + file_name_suffix);
     assert(baseline_checksum == cooked_fusion_checksum);
     assert(baseline_checksum == raw_fusion_checksum);
+    assert(baseline_checksum == segmented_fusion_checksum);
 }
 
 std::vector<vespalib::string> suffixes = {
@@ -367,6 +369,7 @@ remove_field(const vespalib::string &file_name_prefix)
     FieldWriter::remove(remove_prefix);
     FieldWriter::remove(remove_prefix + "x");
     FieldWriter::remove(remove_prefix + "xx");
+    FieldWriter::remove(remove_prefix + "xxx");
 }
 
 void
@@ -609,6 +612,70 @@ fusionField(uint32_t numWordIds,
 }
 
 
+void
+fusionFieldSegmented(uint32_t numWordIds,
+                     uint32_t docIdLimit,
+                     const vespalib::string &ipref,
+                     const vespalib::string &opref,
+                     uint32_t num_segments,
+                     bool dynamicK,
+                     bool encode_interleaved_features)
+{
+    LOG(info,
+        "enter fusionFieldSegmented, ipref=%s, opref=%s, num_segments=%u,"
+        " dynamicK=%s, encode_interleaved_features=%s",
+        ipref.c_str(),
+        opref.c_str(),
+        num_segments,
+        bool_to_str(dynamicK), bool_to_str(encode_interleaved_features));
+
+    vespalib::Timer tv;
+
+    for (uint32_t segment = 0; segment < num_segments; ++segment) {
+        WrappedFieldWriter ostate(opref + "seg" + std::to_string(segment), dynamicK, encode_interleaved_features, numWordIds, docIdLimit);
+        WrappedFieldReader istate(ipref, numWordIds, docIdLimit);
+        ostate.open();
+        istate.open();
+        PostingListParams featureParams;
+        featureParams.clear();
+        featureParams.set("cooked", false);
+        istate._fieldReader->setFeatureParams(featureParams);
+        istate._fieldReader->set_word_num_range(1 + uint64_t(numWordIds) * segment / num_segments,
+                                                1 + uint64_t(numWordIds) * (segment + 1) / num_segments);
+        if (istate._fieldReader->isValid())
+            istate._fieldReader->read();
+
+        while (istate._fieldReader->isValid()) {
+            istate._fieldReader->write(*ostate._fieldWriter);
+            istate._fieldReader->read();
+        }
+        istate.close();
+        ostate.close();
+    }
+    WrappedFieldWriter ostate(opref, dynamicK, encode_interleaved_features, numWordIds, docIdLimit);
+    ostate.open();
+    TuneFileSeqRead tuneFileRead;
+    for (uint32_t segment = 0; segment < num_segments; ++segment) {
+        vespalib::string segment_prefix(dirprefix + opref + "seg" + std::to_string(segment));
+        bool appendres = ostate._fieldWriter->append(segment_prefix, tuneFileRead);
+        assert(appendres);
+        (void) appendres;
+        FieldWriter::remove(segment_prefix);
+    }
+    ostate.close();
+
+    LOG(info,
+        "leave fusionFieldSegmented, ipref=%s, opref=%s, num_segments=%u,"
+        " dynamicK=%s, encode_interleaved_features=%s,"
+        " elapsed=%10.6f",
+        ipref.c_str(),
+        opref.c_str(),
+        num_segments,
+        bool_to_str(dynamicK), bool_to_str(encode_interleaved_features),
+        vespalib::to_s(tv.elapsed()));
+}
+
+
 void
 testFieldWriterVariant(FakeWordSet &wordSet, uint32_t doc_id_limit,
                        const vespalib::string &file_name_prefix,
@@ -627,6 +694,10 @@ testFieldWriterVariant(FakeWordSet &wordSet, uint32_t doc_id_limit,
                 doc_id_limit,
                 file_name_prefix, file_name_prefix + "xx",
                 true, dynamic_k, encode_interleaved_features);
+    fusionFieldSegmented(wordSet.getNumWords(),
+                         doc_id_limit,
+                         file_name_prefix, file_name_prefix + "xxx",
+                         3, dynamic_k, encode_interleaved_features);
     check_fusion(file_name_prefix);
     remove_field(file_name_prefix);
 }
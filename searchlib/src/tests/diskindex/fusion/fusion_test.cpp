@@ -77,6 +77,7 @@ class FusionTest : public ::testing::Test
 protected:
     Schema _schema;
     bool   _force_small_merge_chunk;
+    uint32_t _max_field_merge_partitions;
     const Schema & getSchema() const { return _schema; }
 
     void requireThatFusionIsWorking(const vespalib::string &prefix, bool directio, bool readmmap, bool force_short_merge_chunk);
@@ -405,6 +406,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         Fusion fusion(schema, prefix + "dump3", sources, selector,
                       tuneFileIndexing,fileHeaderContext);
         fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        fusion.set_max_field_merge_partitions(_max_field_merge_partitions);
         ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
     } while (0);
     do {
@@ -419,6 +421,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         Fusion fusion(schema2, prefix + "dump4", sources, selector,
                       tuneFileIndexing, fileHeaderContext);
         fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        fusion.set_max_field_merge_partitions(_max_field_merge_partitions);
         ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
     } while (0);
     do {
@@ -433,6 +436,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         Fusion fusion(schema3, prefix + "dump5", sources, selector,
                       tuneFileIndexing, fileHeaderContext);
         fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        fusion.set_max_field_merge_partitions(_max_field_merge_partitions);
         ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
     } while (0);
     do {
@@ -448,6 +452,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
                       tuneFileIndexing, fileHeaderContext);
         fusion.set_dynamic_k_pos_index_format(true);
         fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        fusion.set_max_field_merge_partitions(_max_field_merge_partitions);
         ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
     } while (0);
     do {
@@ -462,6 +467,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         Fusion fusion(schema, prefix + "dump3", sources, selector,
                       tuneFileIndexing, fileHeaderContext);
         fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        fusion.set_max_field_merge_partitions(_max_field_merge_partitions);
         ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
     } while (0);
     do {
@@ -518,7 +524,8 @@ FusionTest::merge_simple_indexes(const vespalib::string &dump_dir, const std::ve
 FusionTest::FusionTest()
     : ::testing::Test(),
       _schema(make_schema(false)),
-      _force_small_merge_chunk(false)
+      _force_small_merge_chunk(false),
+      _max_field_merge_partitions(1)
 {
 }
 
@@ -547,6 +554,12 @@ TEST_F(FusionTest, require_that_small_merge_chunk_fusion_is_working)
     requireThatFusionIsWorking("s", false, false, true);
 }
 
+TEST_F(FusionTest, require_that_partitioned_field_merge_fusion_is_working)
+{
+    _max_field_merge_partitions = 3;
+    requireThatFusionIsWorking("p", false, false, true);
+}
+
 namespace {
 
 void clean_field_length_testdirs()
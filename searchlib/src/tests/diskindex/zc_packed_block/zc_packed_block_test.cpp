@@ -0,0 +1,123 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/diskindex/zc_packed_block.h>
+#include <vespa/searchlib/diskindex/zcbuf.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vector>
+
+using search::diskindex::ZcBuf;
+using search::diskindex::ZcPackedBlock;
+
+namespace {
+
+struct Posting {
+    uint32_t doc_id;
+    uint32_t field_length;
+    uint32_t num_occs;
+};
+
+std::vector<Posting>
+make_postings(uint32_t count, uint32_t first_doc_id, uint32_t doc_id_step)
+{
+    std::vector<Posting> result;
+    uint32_t doc_id = first_doc_id;
+    for (uint32_t i = 0; i < count; ++i) {
+        result.push_back({doc_id, 10 + i * 7, 1 + (i % 3)});
+        doc_id += doc_id_step + (i % 5);
+    }
+    return result;
+}
+
+void
+encode(ZcBuf &buf, const std::vector<Posting> &postings, uint32_t prev_doc_id, bool interleaved)
+{
+    ZcPackedBlock block;
+    for (const auto &posting : postings) {
+        block.add(posting.doc_id, posting.field_length, posting.num_occs);
+    }
+    block.flush(buf, prev_doc_id, interleaved);
+    EXPECT_TRUE(block.empty());
+}
+
+void
+assert_decode(const ZcBuf &buf, const std::vector<Posting> &postings, uint32_t prev_doc_id, bool interleaved)
+{
+    ZcPackedBlock block;
+    const uint8_t *end = block.decode(buf._mallocStart, prev_doc_id, interleaved);
+    EXPECT_EQ(buf.size(), static_cast<size_t>(end - buf._mallocStart));
+    for (const auto &posting : postings) {
+        ASSERT_FALSE(block.at_end());
+        EXPECT_EQ(posting.doc_id, block.next_doc_id());
+        if (interleaved) {
+            EXPECT_EQ(posting.field_length, block.get_field_length());
+            EXPECT_EQ(posting.num_occs, block.get_num_occs());
+        }
+    }
+    EXPECT_TRUE(block.at_end());
+}
+
+}
+
+TEST(ZcPackedBlockTest, full_block_can_be_encoded_and_decoded)
+{
+    for (bool interleaved : {false, true}) {
+        auto postings = make_postings(ZcPackedBlock::max_size, 1000, 3);
+        ZcBuf buf;
+        encode(buf, postings, 900, interleaved);
+        assert_decode(buf, postings, 900, interleaved);
+    }
+}
+
+TEST(ZcPackedBlockTest, partial_block_can_be_encoded_and_decoded)
+{
+    for (uint32_t count = 1; count < ZcPackedBlock::max_size; ++count) {
+        auto postings = make_postings(count, 7, 1000);
+        ZcBuf buf;
+        encode(buf, postings, 0, true);
+        assert_decode(buf, postings, 0, true);
+    }
+}
+
+TEST(ZcPackedBlockTest, dense_block_uses_zero_width_for_doc_id_deltas)
+{
+    ZcPackedBlock block;
+    for (uint32_t doc_id = 1; doc_id <= ZcPackedBlock::max_size; ++doc_id) {
+        block.add(doc_id, 1, 1);
+    }
+    ZcBuf buf;
+    block.flush(buf, 0, true);
+    // Only the block header remains when all values are equal to 1
+    EXPECT_EQ(4u, buf.size());
+    ZcPackedBlock decoded;
+    decoded.decode(buf._mallocStart, 0, true);
+    for (uint32_t doc_id = 1; doc_id <= ZcPackedBlock::max_size; ++doc_id) {
+        EXPECT_EQ(doc_id, decoded.next_doc_id());
+        EXPECT_EQ(1u, decoded.get_num_occs());
+    }
+}
+
+TEST(ZcPackedBlockTest, large_values_use_full_width)
+{
+    std::vector<Posting> postings = {{1, 1, 1}, {0xfffffffeu, 0xffffffffu, 0x10000u}};
+    ZcBuf buf;
+    encode(buf, postings, 0, true);
+    assert_decode(buf, postings, 0, true);
+}
+
+TEST(ZcPackedBlockTest, seek_steps_to_first_doc_id_not_below_target)
+{
+    auto postings = make_postings(ZcPackedBlock::max_size, 10, 10);
+    ZcBuf buf;
+    encode(buf, postings, 0, false);
+    ZcPackedBlock block;
+    block.decode(buf._mallocStart, 0, false);
+    EXPECT_EQ(1u, block.seek(postings[0].doc_id));
+    EXPECT_EQ(postings[0].doc_id, block.get_doc_id());
+    EXPECT_EQ(3u, block.seek(postings[3].doc_id - 1));
+    EXPECT_EQ(postings[3].doc_id, block.get_doc_id());
+    EXPECT_EQ(ZcPackedBlock::max_size - 4, block.seek(postings.back().doc_id + 1));
+    EXPECT_TRUE(block.at_end());
+    EXPECT_EQ(postings.back().doc_id, block.get_doc_id());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -8,12 +8,15 @@
 #include <vespa/searchlib/docstore/chunkformats.h>
 #include <vespa/vespalib/objects/hexdump.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <zstd.h>
 
 LOG_SETUP("chunk_test");
 
 using namespace search;
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
 
 TEST("require that Chunk obey limits")
 {
@@ -100,4 +103,44 @@ TEST("require that V2 can create and handle lz4, zstd, and none") {
     verifyChunkCompression(CompressionConfig::ZSTD, MY_LONG_STRING, strlen(MY_LONG_STRING), zstd_compressed_length);
 }
 
+vespalib::string
+makeDocument(uint32_t id) {
+    return vespalib::make_string("{\"id\":\"id:news:news::%u\",\"fields\":{\"title\":\"Headline %u\","
+                                 "\"body\":\"Story number %u\",\"popularity\":%u}}", id, id * 3, id * 11, id % 100);
+}
+
+TEST("require that V2 can pack and unpack with a zstd dictionary") {
+    std::vector<vespalib::string> documents;
+    std::vector<vespalib::ConstBufferRef> samples;
+    for (uint32_t id = 0; id < 1000; ++id) {
+        documents.push_back(makeDocument(id));
+    }
+    for (const auto & document : documents) {
+        samples.emplace_back(document.c_str(), document.size());
+    }
+    auto dictionary = ZStdDictionary::train(samples, 2048, 9);
+    ASSERT_TRUE(dictionary);
+
+    CompressionConfig cfg(CompressionConfig::ZSTD, 9, 100);
+    Chunk chunk(0, Chunk::Config(1000));
+    for (uint32_t lid = 1; lid <= 3; ++lid) {
+        vespalib::string document = makeDocument(10000 + lid);
+        chunk.append(lid, document.c_str(), document.size());
+    }
+    vespalib::DataBuffer plain;
+    chunk.pack(7, plain, cfg);
+    vespalib::DataBuffer buffer;
+    chunk.pack(7, buffer, cfg, dictionary.get());
+    EXPECT_LESS(buffer.getDataLen(), plain.getDataLen());
+
+    Chunk deserialized(0, buffer.getData(), buffer.getDataLen(), false, dictionary.get());
+    EXPECT_EQUAL(7u, deserialized.getLastSerial());
+    EXPECT_EQUAL(3u, deserialized.count());
+    for (uint32_t lid = 1; lid <= 3; ++lid) {
+        vespalib::string document = makeDocument(10000 + lid);
+        vespalib::ConstBufferRef blob = deserialized.getLid(lid);
+        EXPECT_EQUAL(document, vespalib::string(blob.c_str(), blob.size()));
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
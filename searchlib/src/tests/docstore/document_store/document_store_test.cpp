@@ -2,9 +2,15 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/searchlib/docstore/logdocumentstore.h>
 #include <vespa/searchlib/docstore/value.h>
+#include <vespa/searchlib/docstore/ibucketizer.h>
 #include <vespa/vespalib/stllike/cache_stats.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <map>
 
 using namespace search;
 using CompressionConfig = vespalib::compression::CompressionConfig;
@@ -49,6 +55,49 @@ struct NullDataStore : IDataStore {
 
 NullDataStore::~NullDataStore() = default;
 
+struct MapDataStore : NullDataStore {
+    std::map<uint32_t, vespalib::nbostream> docs;
+    mutable uint32_t single_reads = 0;
+    MapDataStore() : NullDataStore(), docs() {}
+    ~MapDataStore() override;
+    void add(uint32_t lid) {
+        document::Document doc(*repo.getDocumentType("document"), document::DocumentId(vespalib::make_string("id:ns:document::%u", lid)));
+        doc.serialize(docs[lid]);
+    }
+    ssize_t read(uint32_t lid, vespalib::DataBuffer & buf) const override {
+        ++single_reads;
+        auto found = docs.find(lid);
+        if (found == docs.end()) {
+            return 0;
+        }
+        buf.writeBytes(found->second.peek(), found->second.size());
+        return found->second.size();
+    }
+    void read(const LidVector & lids, IBufferVisitor & visitor) const override {
+        for (uint32_t lid : lids) {
+            auto found = docs.find(lid);
+            if (found != docs.end()) {
+                visitor.visit(lid, vespalib::ConstBufferRef(found->second.peek(), found->second.size()));
+            }
+        }
+    }
+};
+
+MapDataStore::~MapDataStore() = default;
+
+struct CollectingVisitor : IDocumentVisitor {
+    std::vector<uint32_t> lids;
+    bool                  allow_document_caching;
+    explicit CollectingVisitor(bool allow_document_caching_in) : lids(), allow_document_caching(allow_document_caching_in) { }
+    void visit(uint32_t lid, DocumentUP doc) override {
+        if (doc) {
+            lids.push_back(lid);
+        }
+    }
+    bool allowVisitCaching() const override { return false; }
+    bool allowDocumentCaching() const override { return allow_document_caching; }
+};
+
 TEST_FFF("require that uncache docstore lookups are counted",
          DocumentStore::Config(CompressionConfig::NONE, 0, 0),
          NullDataStore(), DocumentStore(f1, f2))
@@ -67,6 +116,37 @@ TEST_FFF("require that cached docstore lookups are counted",
     EXPECT_EQUAL(1u, f3.getCacheStats().misses);
 }
 
+TEST_FFF("require that batched visit populates the document cache",
+         DocumentStore::Config(CompressionConfig::NONE, 100000, 100),
+         MapDataStore(), DocumentStore(f1, f2))
+{
+    f2.add(1);
+    f2.add(2);
+    CollectingVisitor visitor(true);
+    f3.visit({1, 2, 3}, repo, visitor);
+    ASSERT_EQUAL(2u, visitor.lids.size());
+    EXPECT_EQUAL(1u, visitor.lids[0]);
+    EXPECT_EQUAL(2u, visitor.lids[1]);
+    EXPECT_EQUAL(2u, f3.getCacheStats().elements);
+    auto doc = f3.read(2, repo);
+    ASSERT_TRUE(doc);
+    EXPECT_EQUAL("id:ns:document::2", doc->getId().toString());
+    EXPECT_EQUAL(0u, f2.single_reads);
+    EXPECT_EQUAL(1u, f3.getCacheStats().hits);
+}
+
+TEST_FFF("require that batched visit only populates the document cache when the visitor allows it",
+         DocumentStore::Config(CompressionConfig::NONE, 100000, 100),
+         MapDataStore(), DocumentStore(f1, f2))
+{
+    f2.add(1);
+    f2.add(2);
+    CollectingVisitor visitor(false);
+    f3.visit({1, 2, 3}, repo, visitor);
+    EXPECT_EQUAL(2u, visitor.lids.size());
+    EXPECT_EQUAL(0u, f3.getCacheStats().elements);
+}
+
 TEST("require that DocumentStore::Config equality operator detects inequality") {
     using C = DocumentStore::Config;
     EXPECT_TRUE(C() == C());
@@ -9,8 +9,10 @@
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/compressionconfig.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <map>
 
 #include <vespa/log/log.h>
 
@@ -31,10 +33,18 @@ struct MyFileHeaderContext : public FileHeaderContext {
 
 struct SetLidObserver : public ISetLid {
     std::vector<uint32_t> lids;
+    LidInfoWithLidV lidInfos;
     void setLid(const unique_lock &guard, uint32_t lid, const LidInfo &lidInfo) override {
         (void) guard;
-        (void) lidInfo;
         lids.push_back(lid);
+        lidInfos.emplace_back(lidInfo, lid);
+    }
+};
+
+struct BufferCollector : public IBufferVisitor {
+    std::map<uint32_t, vespalib::string> buffers;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buffer) override {
+        buffers[lid] = vespalib::string(buffer.c_str(), buffer.size());
     }
 };
 
@@ -99,11 +109,14 @@ struct ReadFixture : public FixtureBase {
     FileChunk chunk;
 
     explicit ReadFixture(const vespalib::string &baseName, bool dirCleanup = true)
+        : ReadFixture(baseName, TuneFileSummary(), dirCleanup)
+    { }
+    ReadFixture(const vespalib::string &baseName, const TuneFileSummary &tune, bool dirCleanup)
         : FixtureBase(baseName, dirCleanup),
           chunk(FileChunk::FileId(0),
                 FileChunk::NameId(1234),
                 baseName,
-                tuneFile,
+                tune,
                 &bucketizer,
                 false)
     {
@@ -130,6 +143,7 @@ struct WriteFixture : public FixtureBase {
                 serialNum,
                 docIdLimit,
                 WriteableFileChunk::Config(CompressionConfig(), 0x1000),
+                FileChunk::DictionarySP(),
                 tuneFile,
                 fileHeaderCtx,
                 &bucketizer,
@@ -239,6 +253,36 @@ TEST("require that entries with lid >= docIdLimit are skipped in updateLidMap()"
     }
 }
 
+TEST("require that lids in many chunks are read in one batch with io_uring tuning")
+{
+    {
+        WriteFixture f("tmp", 1000, false);
+        for (uint32_t lid(1); lid <= 100; lid++) {
+            f.append(lid);
+            if ((lid % 3) == 0) {
+                f.flush();
+            }
+        }
+        f.flush();
+    }
+    TuneFileSummary tune;
+    tune._randRead.setWantIoUring();
+    ReadFixture f("tmp", tune, true);
+    f.updateLidMap(1000);
+    f.chunk.enableRead();
+    LidInfoWithLidV lidInfos = f.lidObserver.lidInfos;
+    std::stable_sort(lidInfos.begin(), lidInfos.end(), [](const LidInfo &a, const LidInfo &b) {
+        return a.getChunkId() < b.getChunkId();
+    });
+    EXPECT_EQUAL(33u, lidInfos.back().getChunkId() - lidInfos.front().getChunkId());
+    BufferCollector collector;
+    f.chunk.read(lidInfos.begin(), lidInfos.size(), collector);
+    EXPECT_EQUAL(100u, collector.buffers.size());
+    for (const auto &entry : collector.buffers) {
+        EXPECT_EQUAL(getData(entry.first), entry.second);
+    }
+}
+
 using vespalib::compression::CompressionConfig;
 
 TEST("require that operator == detects inequality") {
@@ -395,6 +395,68 @@ TEST_F("require that fast-forest gbdt evaluation is pure", Fixture()) {
     EXPECT_EQUAL(f1.final_executor_name(), "search::features::FastForestExecutor");
 }
 
+std::vector<uint32_t> make_docids(size_t num_docs) {
+    std::vector<uint32_t> docids;
+    for (size_t i = 0; i < num_docs; ++i) {
+        docids.push_back(1 + 3 * i);
+    }
+    return docids;
+}
+
+TEST_F("require that batch evaluation gives the same result as evaluating one document at a time", Fixture()) {
+    f1.lazy_expressions(false);
+    f1.add_expr("rank", "2*docid+value(3)").compile();
+    auto evaluator = f1.program.make_batch_evaluator();
+    ASSERT_TRUE(evaluator);
+    EXPECT_EQUAL(2u, evaluator->num_steps());
+    auto docids = make_docids(BatchFeatureEvaluator::max_block_size * 2 + 7);
+    std::vector<double> result(docids.size(), 0.0);
+    evaluator->evaluate(docids, result.data());
+    for (size_t i = 0; i < docids.size(); ++i) {
+        EXPECT_EQUAL(f1.get(docids[i]), result[i]);
+        EXPECT_EQUAL(2.0 * docids[i] + 3.0, result[i]);
+    }
+}
+
+TEST_F("require that batch evaluation of const features gives the const value", Fixture()) {
+    f1.lazy_expressions(false);
+    f1.add_expr("rank", "value(1)+value(2)").compile();
+    auto evaluator = f1.program.make_batch_evaluator();
+    ASSERT_TRUE(evaluator);
+    EXPECT_EQUAL(0u, evaluator->num_steps());
+    auto docids = make_docids(10);
+    std::vector<double> result(docids.size(), 0.0);
+    evaluator->evaluate(docids, result.data());
+    for (double value: result) {
+        EXPECT_EQUAL(3.0, value);
+    }
+}
+
+TEST_F("require that batch evaluation is not possible when an executor does not support it", Fixture()) {
+    f1.lazy_expressions(false);
+    f1.add_expr("rank", "docid+ivalue(1)").compile();
+    EXPECT_FALSE(f1.program.make_batch_evaluator());
+}
+
+TEST_F("require that batch evaluation is not possible with lazy compiled ranking expressions", Fixture()) {
+    f1.lazy_expressions(true);
+    f1.add_expr("rank", "2*docid+value(3)").compile();
+    EXPECT_FALSE(f1.program.make_batch_evaluator());
+}
+
+TEST_F("require that batch evaluation is not possible with feature overrides", Fixture()) {
+    f1.lazy_expressions(false);
+    f1.override("docid", 5.0);
+    f1.add_expr("rank", "2*docid+value(3)").compile();
+    EXPECT_FALSE(f1.program.make_batch_evaluator());
+}
+
+TEST_F("require that batch evaluation is not possible with multiple seeds", Fixture()) {
+    f1.lazy_expressions(false);
+    f1.add("docid").add_expr("rank", "2*docid+value(3)").compile();
+    EXPECT_FALSE(f1.program.make_batch_evaluator());
+}
+
 TEST_F("require that rank program can be profiled", Fixture()) {
     ExecutionProfiler profiler(64);
     f1.add("mysum(value(10),ivalue(5))").compile(&profiler);
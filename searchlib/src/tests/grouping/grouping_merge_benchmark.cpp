@@ -0,0 +1,156 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/aggregation/grouping.h>
+#include <vespa/searchlib/aggregation/sumaggregationresult.h>
+#include <vespa/searchlib/expression/attributenode.h>
+#include <vespa/searchlib/expression/integerresultnode.h>
+#include <vespa/searchlib/grouping/partitioned_grouping_merger.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <vespa/vespalib/util/time.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace search::aggregation;
+using namespace search::expression;
+using search::grouping::PartitionedGroupingMerger;
+
+/*
+ * Benchmark merging of the grouping results produced by the match
+ * threads for a group-by with many distinct values. Each thread has
+ * seen a random sample of the documents, with a random subset of the
+ * distinct values.
+ *
+ * usage: grouping_merge_benchmark [num threads] [num distinct values] [values per thread]
+ */
+
+namespace {
+
+Grouping
+make_thread_result(size_t num_values, size_t values_per_thread, uint32_t seed)
+{
+    std::mt19937 rnd(seed);
+    std::vector<int64_t> ids;
+    ids.reserve(values_per_thread);
+    for (size_t i = 0; i < values_per_thread; ++i) {
+        ids.push_back(rnd() % num_values);
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    GroupingLevel level;
+    level.setExpression(std::make_unique<AttributeNode>("attr"));
+    level.addResult(SumAggregationResult().setExpression(std::make_unique<AttributeNode>("attr")));
+    Group root;
+    for (int64_t id : ids) {
+        root.addChild(Group().setId(Int64ResultNode(id))
+                      .addResult(SumAggregationResult()
+                                 .setExpression(std::make_unique<AttributeNode>("attr"))
+                                 .setResult(Int64ResultNode(id))));
+    }
+    Grouping grouping;
+    grouping.setFirstLevel(0).setLastLevel(1).addLevel(std::move(level)).setRoot(root);
+    return grouping;
+}
+
+std::vector<Grouping>
+make_thread_results(size_t num_threads, size_t num_values, size_t values_per_thread)
+{
+    std::vector<Grouping> results;
+    for (size_t i = 0; i < num_threads; ++i) {
+        results.push_back(make_thread_result(num_values, values_per_thread, i + 1));
+    }
+    return results;
+}
+
+size_t
+finish_result(Grouping &result)
+{
+    result.postMerge();
+    result.sortById();
+    return result.getRoot().getChildrenSize();
+}
+
+double
+merge_serial(std::vector<Grouping> &results)
+{
+    auto start = vespalib::steady_clock::now();
+    for (size_t i = 1; i < results.size(); ++i) {
+        results[0].merge(results[i]);
+    }
+    size_t groups = finish_result(results[0]);
+    double ms = vespalib::count_ms(vespalib::steady_clock::now() - start);
+    fprintf(stderr, "serial merge:      %8.1f ms (%zu groups)\n", ms, groups);
+    return ms;
+}
+
+struct SplitTask : vespalib::Runnable {
+    PartitionedGroupingMerger &merger;
+    size_t first;
+    size_t stride;
+    SplitTask(PartitionedGroupingMerger &merger_in, size_t first_in, size_t stride_in)
+        : merger(merger_in), first(first_in), stride(stride_in) {}
+    void run() override {
+        for (size_t i = first; i < merger.get_num_inputs(); i += stride) {
+            merger.split(i);
+        }
+    }
+};
+
+struct MergePartitionTask : vespalib::Runnable {
+    PartitionedGroupingMerger &merger;
+    size_t partition_id;
+    MergePartitionTask(PartitionedGroupingMerger &merger_in, size_t partition_id_in)
+        : merger(merger_in), partition_id(partition_id_in) {}
+    void run() override { merger.merge_partition(partition_id); }
+};
+
+double
+merge_partitioned(std::vector<Grouping> &results, vespalib::ThreadBundle &thread_bundle)
+{
+    auto start = vespalib::steady_clock::now();
+    std::vector<Grouping *> inputs;
+    for (auto &result : results) {
+        inputs.push_back(&result);
+    }
+    size_t num_threads = thread_bundle.size();
+    PartitionedGroupingMerger merger(std::move(inputs), num_threads);
+    std::vector<vespalib::Runnable::UP> tasks;
+    for (size_t t = 0; t < num_threads; ++t) {
+        tasks.push_back(std::make_unique<SplitTask>(merger, t, num_threads));
+    }
+    thread_bundle.run(tasks);
+    tasks.clear();
+    for (size_t t = 0; t < num_threads; ++t) {
+        tasks.push_back(std::make_unique<MergePartitionTask>(merger, t));
+    }
+    thread_bundle.run(tasks);
+    merger.finish();
+    size_t groups = finish_result(results[0]);
+    double ms = vespalib::count_ms(vespalib::steady_clock::now() - start);
+    fprintf(stderr, "partitioned merge: %8.1f ms (%zu groups)\n", ms, groups);
+    return ms;
+}
+
+}
+
+int
+main(int argc, char **argv)
+{
+    size_t num_threads = (argc > 1) ? strtoul(argv[1], nullptr, 0) : 8;
+    size_t num_values = (argc > 2) ? strtoul(argv[2], nullptr, 0) : 1000000;
+    size_t values_per_thread = (argc > 3) ? strtoul(argv[3], nullptr, 0) : num_values / 2;
+    fprintf(stderr, "threads=%zu, distinct values=%zu, values per thread=%zu\n",
+            num_threads, num_values, values_per_thread);
+    vespalib::SimpleThreadBundle thread_bundle(num_threads);
+    auto serial = make_thread_results(num_threads, num_values, values_per_thread);
+    auto partitioned = make_thread_results(num_threads, num_values, values_per_thread);
+    double serial_ms = merge_serial(serial);
+    double partitioned_ms = merge_partitioned(partitioned, thread_bundle);
+    if (serial[0].getRoot().asString() != partitioned[0].getRoot().asString()) {
+        fprintf(stderr, "merge results differ\n");
+        return 1;
+    }
+    fprintf(stderr, "speedup: %.2f\n", serial_ms / partitioned_ms);
+    return 0;
+}
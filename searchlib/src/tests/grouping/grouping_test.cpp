@@ -8,9 +8,11 @@
 #include <vespa/searchlib/aggregation/hitsaggregationresult.h>
 #include <vespa/searchlib/aggregation/fs4hit.h>
 #include <vespa/searchlib/aggregation/predicates.h>
+#include <vespa/searchlib/grouping/partitioned_grouping_merger.h>
 #include <vespa/searchlib/expression/fixedwidthbucketfunctionnode.h>
 #include <vespa/searchlib/test/make_attribute_map_lookup_node.h>
 #include <vespa/searchcommon/common/undefinedvalues.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <algorithm>
 #include <cmath>
 #include <iostream>
@@ -163,6 +165,8 @@ public:
                    const Group &expect);
     bool testPartialMerge(const Grouping &a, const Grouping &b,
                    const Group &expect);
+    bool testPartitionedMerge(const Grouping &a, const Grouping &b, const Grouping &c,
+                              uint32_t numPartitions);
     void testAggregationSimple();
     void testAggregationLevels();
     void testAggregationMaxGroups();
@@ -173,6 +177,7 @@ public:
     void testMergeLevels();
     void testMergeGroups();
     void testMergeTrees();
+    void testPartitionedMerge();
     void testPruneSimple();
     void testPruneComplex();
     void testPartialMerging();
@@ -297,6 +302,39 @@ Test::testMerge(const Grouping &a, const Grouping &b, const Grouping &c,
     return EXPECT_EQUAL(tmp.getRoot().asString(), expect.asString());
 }
 
+/**
+ * Merge the given grouping requests using hash partitions and verify
+ * that the resulting group tree matches the one obtained by merging
+ * them one by one.
+ **/
+bool
+Test::testPartitionedMerge(const Grouping &a, const Grouping &b, const Grouping &c,
+                           uint32_t numPartitions)
+{
+    Grouping expect = a; // create local copy
+    Grouping expectB = b;
+    Grouping expectC = c;
+    expect.merge(expectB);
+    expect.merge(expectC);
+    expect.postMerge();
+    expect.sortById();
+
+    Grouping tmp = a; // create local copy
+    Grouping tmpB = b;
+    Grouping tmpC = c;
+    search::grouping::PartitionedGroupingMerger merger({&tmp, &tmpB, &tmpC}, numPartitions);
+    for (uint32_t i = 0; i < merger.get_num_inputs(); ++i) {
+        merger.split(i);
+    }
+    for (uint32_t i = 0; i < merger.get_num_partitions(); ++i) {
+        merger.merge_partition(i);
+    }
+    merger.finish();
+    tmp.postMerge();
+    tmp.sortById();
+    return EXPECT_EQUAL(tmp.getRoot().asString(), expect.getRoot().asString());
+}
+
 //-----------------------------------------------------------------------------
 
 /**
@@ -1021,6 +1059,57 @@ Test::testMergeGroups()
     EXPECT_TRUE(testMerge(request.unchain().setRoot(b), request.unchain().setRoot(a), expect_all));
 }
 
+/**
+ * Verify that merging the first level groups in hash partitions gives
+ * the same result as merging the whole group trees one by one.
+ **/
+void
+Test::testPartitionedMerge()
+{
+    Grouping request;
+    request.addLevel(createGL(MU<AttributeNode>("c1"), MU<AttributeNode>("s1")))
+           .addLevel(createGL(MU<AttributeNode>("c2"), MU<AttributeNode>("s2")));
+
+    auto makeRoot = [](int64_t first, int64_t last, int64_t step, int64_t sum) {
+        Group root;
+        root.setId(NullResultNode())
+            .addResult(SumAggregationResult()
+                       .setExpression(MU<AttributeNode>("s0"))
+                       .setResult(Int64ResultNode(sum)));
+        for (int64_t id = first; id < last; id += step) {
+            root.addChild(Group()
+                          .setId(Int64ResultNode(id))
+                          .setRank(RawRank(id % 7))
+                          .addResult(SumAggregationResult()
+                                     .setExpression(MU<AttributeNode>("s1"))
+                                     .setResult(Int64ResultNode(sum)))
+                          .addChild(Group()
+                                    .setId(Int64ResultNode(id % 3))
+                                    .addResult(SumAggregationResult()
+                                               .setExpression(MU<AttributeNode>("s2"))
+                                               .setResult(Int64ResultNode(sum)))));
+        }
+        return root;
+    };
+    Group a = makeRoot(0, 100, 1, 1);
+    Group b = makeRoot(50, 150, 2, 2);
+    Group c = makeRoot(0, 200, 5, 3);
+
+    for (uint32_t numPartitions : {1, 2, 3, 16}) {
+        TEST_STATE(vespalib::make_string("numPartitions=%u", numPartitions).c_str());
+        request.levels()[0].setMaxGroups(-1);
+        EXPECT_TRUE(testPartitionedMerge(request.unchain().setRoot(a), request.unchain().setRoot(b),
+                                         request.unchain().setRoot(c), numPartitions));
+        request.levels()[0].setMaxGroups(10);
+        EXPECT_TRUE(testPartitionedMerge(request.unchain().setRoot(a), request.unchain().setRoot(b),
+                                         request.unchain().setRoot(c), numPartitions));
+        EXPECT_TRUE(testPartitionedMerge(request.unchain().setRoot(c).setFirstLevel(1).setLastLevel(2),
+                                         request.unchain().setRoot(a).setFirstLevel(1).setLastLevel(2),
+                                         request.unchain().setRoot(b).setFirstLevel(1).setLastLevel(2),
+                                         numPartitions));
+    }
+}
+
 /**
  * Merge two relatively complex tree structures and verify that the
  * end result is as expected.
@@ -1969,6 +2058,7 @@ Test::Main()
     testMergeLevels();
     testMergeGroups();
     testMergeTrees();
+    testPartitionedMerge();
     testPruneSimple();
     testPruneComplex();
     testPartialMerging();
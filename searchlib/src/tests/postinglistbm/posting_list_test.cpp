@@ -5,12 +5,15 @@
 #include <vespa/searchlib/test/fakedata/fakeword.h>
 #include <vespa/searchlib/test/fakedata/fakewordset.h>
 #include <vespa/searchlib/test/fakedata/fpfactory.h>
+#include <vespa/searchlib/queryeval/wand/block_max_info.h>
 #include <vespa/vespalib/util/rand48.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <limits>
 #include <cinttypes>
 
 using search::fef::TermFieldMatchData;
 using search::fef::TermFieldMatchDataArray;
+using search::queryeval::BlockMaxInfo;
 using search::queryeval::SearchIterator;
 
 using namespace search::index;
@@ -35,6 +38,52 @@ validate_posting_list_for_word(const FakePosting& posting, const FakeWord& word)
     }
 }
 
+void
+validate_block_max_for_word(const FakePosting& posting, const FakeWord& word)
+{
+    TermFieldMatchData md;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&md);
+
+    md.setNeedNormalFeatures(posting.enable_unpack_normal_features());
+    md.setNeedInterleavedFeatures(posting.enable_unpack_interleaved_features());
+    std::unique_ptr<SearchIterator> iterator(posting.createIterator(tfmda));
+    auto* block_max = dynamic_cast<BlockMaxInfo*>(iterator.get());
+    if (block_max == nullptr) {
+        // Rare word without skip info
+        return;
+    }
+    ASSERT_TRUE(block_max->has_block_max());
+    iterator->initFullRange();
+    // Posting lists too short to have L1 skip entries have no bound
+    constexpr uint32_t unbounded = std::numeric_limits<uint32_t>::max();
+    BlockMaxInfo::Block block{0, 0};
+    uint32_t seen_max_num_occs = 0;
+    uint32_t blocks = 0;
+    for (const auto& doc : word._postings) {
+        if (doc._docId > block.last_docid) {
+            if (blocks > 0 && block.max_num_occs != unbounded) {
+                // Block max is exact, not just an upper bound
+                EXPECT_EQ(block.max_num_occs, seen_max_num_occs);
+            }
+            block = block_max->get_block(doc._docId);
+            ASSERT_LE(doc._docId, block.last_docid);
+            EXPECT_LE(iterator->getDocId(), doc._docId);
+            seen_max_num_occs = 0;
+            ++blocks;
+        }
+        ASSERT_TRUE(iterator->seek(doc._docId));
+        uint32_t num_occs = doc._collapsedDocWordFeatures._num_occs;
+        EXPECT_EQ(num_occs, block_max->get_num_occs());
+        EXPECT_LE(num_occs, block.max_num_occs);
+        seen_max_num_occs = std::max(seen_max_num_occs, num_occs);
+    }
+    if (block.max_num_occs != unbounded) {
+        EXPECT_EQ(block.max_num_occs, seen_max_num_occs);
+    }
+    EXPECT_EQ(word._postings.back()._docId, block.last_docid);
+}
+
 void
 test_fake(const std::string& posting_type,
           const Schema& schema,
@@ -55,6 +104,9 @@ test_fake(const std::string& posting_type,
            static_cast<int>(posting->l4SkipBitSize()));
 
     validate_posting_list_for_word(*posting, word);
+    if (posting_type.find(".bm") != std::string::npos) {
+        validate_block_max_for_word(*posting, word);
+    }
 }
 
 struct PostingListTest : public ::testing::Test {
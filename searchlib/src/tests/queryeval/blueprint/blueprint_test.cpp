@@ -678,6 +678,8 @@ getExpectedBlueprint()
            "        empty: false\n"
            "        estHits: 9\n"
            "        cost_tier: 1\n"
+           "        cost: 1\n"
+           "        strict_cost: 1\n"
            "        tree_size: 2\n"
            "        allow_termwise_eval: false\n"
            "    }\n"
@@ -697,6 +699,8 @@ getExpectedBlueprint()
            "                empty: false\n"
            "                estHits: 9\n"
            "                cost_tier: 1\n"
+           "                cost: 1\n"
+           "                strict_cost: 1\n"
            "                tree_size: 1\n"
            "                allow_termwise_eval: true\n"
            "            }\n"
@@ -726,6 +730,8 @@ getExpectedSlimeBlueprint() {
            "        empty: false,"
            "        estHits: 9,"
            "        cost_tier: 1,"
+           "        cost: 1.0,"
+           "        strict_cost: 1.0,"
            "        tree_size: 2,"
            "        allow_termwise_eval: false"
            "    },"
@@ -750,6 +756,8 @@ getExpectedSlimeBlueprint() {
            "                empty: false,"
            "                estHits: 9,"
            "                cost_tier: 1,"
+           "                cost: 1.0,"
+           "                strict_cost: 1.0,"
            "                tree_size: 1,"
            "                allow_termwise_eval: true"
            "            },"
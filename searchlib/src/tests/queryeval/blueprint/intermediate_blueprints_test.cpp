@@ -1410,6 +1410,64 @@ TEST("require that intermediate cost tier is minimum cost tier of children") {
     EXPECT_EQUAL(bp2->getState().cost_tier(), 2u);
 }
 
+TEST("require that AND is driven by the child with the lowest total strict cost") {
+    // the most selective child is expensive to iterate strictly (like a scan)
+    Blueprint::UP top_up(
+            ap((new AndBlueprint())->
+               addChild(ap(MyLeafSpec(100).strict_cost(1.0).create())).
+               addChild(ap(MyLeafSpec(200).create()))));
+    top_up->setDocIdLimit(1000);
+    top_up = Blueprint::optimize(std::move(top_up));
+    auto &bp = dynamic_cast<AndBlueprint &>(*top_up);
+    ASSERT_EQUAL(2u, bp.childCnt());
+    EXPECT_EQUAL(200u, bp.getChild(0).getState().estimate().estHits);
+    EXPECT_EQUAL(100u, bp.getChild(1).getState().estimate().estHits);
+    EXPECT_FALSE(bp.inheritStrict(1));
+    EXPECT_APPROX(1.2, bp.cost(), 1e-9);
+    EXPECT_APPROX(0.4, bp.strict_cost(), 1e-9);
+}
+
+TEST("require that AND sorts children that are expensive to check last") {
+    Blueprint::UP top_up(
+            ap((new AndBlueprint())->
+               addChild(ap(MyLeafSpec(100).cost(10.0).strict_cost(5.0).create())).
+               addChild(ap(MyLeafSpec(300).create()))));
+    top_up->setDocIdLimit(1000);
+    top_up = Blueprint::optimize(std::move(top_up));
+    auto &bp = dynamic_cast<AndBlueprint &>(*top_up);
+    ASSERT_EQUAL(2u, bp.childCnt());
+    EXPECT_EQUAL(300u, bp.getChild(0).getState().estimate().estHits);
+    EXPECT_EQUAL(100u, bp.getChild(1).getState().estimate().estHits);
+}
+
+TEST("require that AND children are strict when iterating them is cheaper than seeking them") {
+    AndBlueprint bp;
+    bp.addChild(ap(MyLeafSpec(10).create()));
+    bp.addChild(ap(MyLeafSpec(500).cost(1000.0).strict_cost(0.9).create()));
+    bp.addChild(ap(MyLeafSpec(900).create()));
+    bp.addChild(ap(MyLeafSpec(50).cost(1000.0).strict_cost(0.9).cost_tier(Blueprint::State::COST_TIER_EXPENSIVE).create()));
+    bp.setDocIdLimit(1000);
+    EXPECT_TRUE(bp.inheritStrict(0));
+    EXPECT_TRUE(bp.inheritStrict(1));
+    EXPECT_FALSE(bp.inheritStrict(2));
+    EXPECT_FALSE(bp.inheritStrict(3)); // not in the same cost tier as the first child
+}
+
+TEST("require that OR sorts children by cost of accepting documents") {
+    Blueprint::UP top_up(
+            ap((new OrBlueprint())->
+               addChild(ap(MyLeafSpec(100).cost(10.0).create())).
+               addChild(ap(MyLeafSpec(50).create()))));
+    top_up->setDocIdLimit(1000);
+    top_up = Blueprint::optimize(std::move(top_up));
+    auto &bp = dynamic_cast<OrBlueprint &>(*top_up);
+    ASSERT_EQUAL(2u, bp.childCnt());
+    EXPECT_EQUAL(50u, bp.getChild(0).getState().estimate().estHits);
+    EXPECT_EQUAL(100u, bp.getChild(1).getState().estimate().estHits);
+    EXPECT_APPROX(11.0, bp.cost(), 1e-9);
+    EXPECT_APPROX(1.05, bp.strict_cost(), 1e-9);
+}
+
 void verify_or_est(const std::vector<Blueprint::HitEstimate> &child_estimates, Blueprint::HitEstimate expect) {
     OrBlueprint my_or;
     my_or.setDocIdLimit(32);
@@ -4,6 +4,7 @@
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/vespalib/objects/visit.hpp>
+#include <optional>
 
 namespace search::queryeval {
 
@@ -126,6 +127,14 @@ public:
         set_cost_tier(value);
         return *this;
     }
+    MyLeaf &cost(double value) {
+        set_cost(value);
+        return *this;
+    }
+    MyLeaf &strict_cost(double value) {
+        set_strict_cost(value);
+        return *this;
+    }
     void set_global_filter(const GlobalFilter &, double) override {
         _got_global_filter = true;
     }
@@ -146,11 +155,13 @@ private:
     FieldSpecBaseList      _fields;
     Blueprint::HitEstimate _estimate;
     uint32_t               _cost_tier;
+    std::optional<double>  _cost;
+    std::optional<double>  _strict_cost;
     bool                   _want_global_filter;
 
 public:
     explicit MyLeafSpec(uint32_t estHits, bool empty = false)
-        : _fields(), _estimate(estHits, empty), _cost_tier(0), _want_global_filter(false) {}
+        : _fields(), _estimate(estHits, empty), _cost_tier(0), _cost(), _strict_cost(), _want_global_filter(false) {}
 
     MyLeafSpec &addField(uint32_t fieldId, uint32_t handle) {
         _fields.add(FieldSpecBase(fieldId, handle));
@@ -161,6 +172,14 @@ public:
         _cost_tier = value;
         return *this;
     }
+    MyLeafSpec &cost(double value) {
+        _cost = value;
+        return *this;
+    }
+    MyLeafSpec &strict_cost(double value) {
+        _strict_cost = value;
+        return *this;
+    }
     MyLeafSpec &want_global_filter() {
         _want_global_filter = true;
         return *this;
@@ -175,6 +194,12 @@ public:
         if (_cost_tier > 0) {
             leaf->cost_tier(_cost_tier);
         }
+        if (_cost) {
+            leaf->cost(_cost.value());
+        }
+        if (_strict_cost) {
+            leaf->strict_cost(_strict_cost.value());
+        }
         leaf->set_want_global_filter(_want_global_filter);
         return leaf;
     }
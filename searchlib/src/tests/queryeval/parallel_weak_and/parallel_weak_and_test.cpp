@@ -594,6 +594,8 @@ TEST_F("require that asString() on blueprint works", BlueprintAsStringFixture)
                               "        empty: false\n"
                               "        estHits: 2\n"
                               "        cost_tier: 1\n"
+                              "        cost: 1\n"
+                              "        strict_cost: 1\n"
                               "        tree_size: 2\n"
                               "        allow_termwise_eval: false\n"
                               "    }\n"
@@ -616,6 +618,8 @@ TEST_F("require that asString() on blueprint works", BlueprintAsStringFixture)
                               "                empty: false\n"
                               "                estHits: 2\n"
                               "                cost_tier: 1\n"
+                              "                cost: 1\n"
+                              "                strict_cost: 1\n"
                               "                tree_size: 1\n"
                               "                allow_termwise_eval: true\n"
                               "            }\n"
@@ -1,6 +1,9 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchlib/attribute/fixedsourceselector.h>
 #include <vespa/searchlib/queryeval/fake_search.h>
+#include <vespa/searchlib/queryeval/sourceblendersearch.h>
+#include <vespa/searchlib/queryeval/wand/block_max_info.h>
 #include <vespa/searchlib/queryeval/wand/weak_and_search.h>
 #include <vespa/searchlib/queryeval/simpleresult.h>
 #include <vespa/searchlib/queryeval/simplesearch.h>
@@ -52,6 +55,116 @@ struct AdvancedWandFixture {
     }
 };
 
+// Term search over (docid, num occs) postings, with block max info for fixed size blocks
+class BlockMaxTerm : public SearchIterator, public BlockMaxInfo
+{
+private:
+    using Postings = std::vector<std::pair<uint32_t, uint32_t>>;
+    Postings  _postings;
+    uint32_t  _block_size;
+    size_t    _pos;
+    uint32_t &_visited;
+
+    size_t first_at_or_after(uint32_t docid) const {
+        size_t pos = _pos;
+        while ((pos < _postings.size()) && (_postings[pos].first < docid)) {
+            ++pos;
+        }
+        return pos;
+    }
+
+public:
+    BlockMaxTerm(Postings postings, uint32_t block_size, uint32_t &visited)
+        : _postings(std::move(postings)), _block_size(block_size), _pos(0), _visited(visited)
+    {}
+    void initRange(uint32_t begin, uint32_t end) override {
+        SearchIterator::initRange(begin, end);
+        _pos = 0;
+    }
+    void doSeek(uint32_t docid) override {
+        _pos = first_at_or_after(docid);
+        if (_pos < _postings.size()) {
+            setDocId(_postings[_pos].first);
+            ++_visited;
+        } else {
+            setAtEnd();
+        }
+    }
+    void doUnpack(uint32_t) override {}
+    bool has_block_max() const override { return true; }
+    Block get_block(uint32_t docid) override {
+        size_t pos = first_at_or_after(docid);
+        if (pos == _postings.size()) {
+            return {search::endDocId, 0};
+        }
+        size_t begin = pos - (pos % _block_size);
+        size_t end = std::min(begin + _block_size, _postings.size());
+        uint32_t max_num_occs = 0;
+        for (size_t i = begin; i < end; ++i) {
+            max_num_occs = std::max(max_num_occs, _postings[i].second);
+        }
+        return {_postings[end - 1].first, max_num_occs};
+    }
+    uint32_t get_num_occs() const override { return _postings[_pos].second; }
+};
+
+struct BlockMaxWandFixture {
+    uint32_t     visited;
+    SimpleResult hits;
+    explicit BlockMaxWandFixture(bool block_max) : visited(0), hits() {
+        // All documents have num occs 1, except document 1 and 40
+        std::vector<std::pair<uint32_t, uint32_t>> postings;
+        for (uint32_t docid = 1; docid <= 64; ++docid) {
+            postings.emplace_back(docid, (docid == 1) ? 5 : ((docid == 40) ? 10 : 1));
+        }
+        wand::Terms terms;
+        terms.emplace_back(new BlockMaxTerm(std::move(postings), 8, visited), 100, 64);
+        SearchIterator::UP search(WeakAndSearch::create(terms, 1, true, block_max));
+        hits.search(*search);
+    }
+};
+
+// Same postings as BlockMaxWandFixture, split across two sources below a source blender
+struct BlendedBlockMaxWandFixture {
+    uint32_t                     visited;
+    search::FixedSourceSelector  selector;
+    SearchIterator::UP           blender;
+    explicit BlendedBlockMaxWandFixture(bool block_max_in_both_sources)
+        : visited(0), selector(0, "fs"), blender()
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> first;
+        std::vector<std::pair<uint32_t, uint32_t>> second;
+        SimpleResult second_docs;
+        for (uint32_t docid = 1; docid <= 64; ++docid) {
+            uint32_t num_occs = (docid == 1) ? 5 : ((docid == 40) ? 10 : 1);
+            if (docid <= 32) {
+                first.emplace_back(docid, num_occs);
+                selector.setSource(docid, 0);
+            } else {
+                second.emplace_back(docid, num_occs);
+                second_docs.addHit(docid);
+                selector.setSource(docid, 1);
+            }
+        }
+        SourceBlenderSearch::Children children;
+        children.emplace_back(new BlockMaxTerm(std::move(first), 8, visited), 0);
+        if (block_max_in_both_sources) {
+            children.emplace_back(new BlockMaxTerm(std::move(second), 8, visited), 1);
+        } else {
+            children.emplace_back(new SimpleSearch(second_docs), 1);
+        }
+        blender = SourceBlenderSearch::create(selector.createIterator(), children, true);
+    }
+    SimpleResult search() {
+        wand::Terms terms;
+        terms.emplace_back(blender.release(), 100, 64);
+        SearchIterator::UP search(WeakAndSearch::create(terms, 1, true, true));
+        SimpleResult hits;
+        hits.search(*search);
+        return hits;
+    }
+};
+
 struct WeightOrder {
     bool operator()(const wand::Term &t1, const wand::Term &t2) const {
         return (t1.weight < t2.weight);
@@ -99,6 +212,48 @@ TEST("require that initial docid for subsearches are taken into account") {
                  history);
 }
 
+TEST("require that block max wand only returns hits competitive with the best hit so far") {
+    BlockMaxWandFixture f(true);
+    EXPECT_EQUAL(SimpleResult().addHit(1).addHit(40), f.hits);
+}
+
+TEST("require that block max wand skips blocks that can not produce competitive hits") {
+    BlockMaxWandFixture f(true);
+    // Only the first document of each block without competitive hits is visited
+    EXPECT_LESS(f.visited, 64u / 2);
+}
+
+TEST("require that wand without block max scores all documents matching the term equally") {
+    BlockMaxWandFixture f(false);
+    EXPECT_EQUAL(64u, f.hits.getHitCount());
+    EXPECT_EQUAL(64u, f.visited);
+}
+
+TEST_F("require that source blender forwards block max info from its sources", BlendedBlockMaxWandFixture(true)) {
+    auto *info = dynamic_cast<BlockMaxInfo *>(f.blender.get());
+    ASSERT_TRUE(info != nullptr);
+    EXPECT_TRUE(info->has_block_max());
+    f.blender->initFullRange();
+    // Ends with the first source block, bounded by the max num occs in any source
+    BlockMaxInfo::Block block = info->get_block(2);
+    EXPECT_EQUAL(8u, block.last_docid);
+    EXPECT_EQUAL(10u, block.max_num_occs);
+    block = info->get_block(41);
+    EXPECT_EQUAL(48u, block.last_docid);
+    EXPECT_EQUAL(1u, block.max_num_occs);
+}
+
+TEST_F("require that block max wand works through a source blender", BlendedBlockMaxWandFixture(true)) {
+    EXPECT_EQUAL(SimpleResult().addHit(1).addHit(40), f.search());
+}
+
+TEST_F("require that block max wand falls back to max score when a blended source lacks block max info",
+       BlendedBlockMaxWandFixture(false))
+{
+    EXPECT_FALSE(dynamic_cast<BlockMaxInfo &>(*f.blender).has_block_max());
+    EXPECT_EQUAL(64u, f.search().getHitCount());
+}
+
 class IteratorChildrenVerifier : public search::test::IteratorChildrenVerifier {
 private:
     SearchIterator::UP create(bool strict) const override {
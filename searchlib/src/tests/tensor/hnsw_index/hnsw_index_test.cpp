@@ -4,6 +4,7 @@
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/test/vector_buffer_reader.h>
 #include <vespa/searchlib/test/vector_buffer_writer.h>
+#include <vespa/searchlib/tensor/distance_function_factory.h>
 #include <vespa/searchlib/tensor/distance_functions.h>
 #include <vespa/searchlib/tensor/doc_vector_access.h>
 #include <vespa/searchlib/tensor/hnsw_index.h>
@@ -13,12 +14,14 @@
 #include <vespa/searchlib/tensor/inv_log_level_generator.h>
 #include <vespa/searchlib/tensor/subspace_type.h>
 #include <vespa/searchlib/tensor/vector_bundle.h>
+#include <vespa/searchlib/util/fileutil.h>
 #include <vespa/searchlib/queryeval/global_filter.h>
 #include <vespa/vespalib/datastore/compaction_spec.h>
 #include <vespa/vespalib/datastore/compaction_strategy.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/generationhandler.h>
 #include <vespa/vespalib/data/slime/slime.h>
+#include <cmath>
 #include <type_traits>
 #include <vector>
 
@@ -32,6 +35,7 @@ using namespace vespalib::slime;
 using vespalib::Slime;
 using search::BitVector;
 using search::BufferWriter;
+using search::attribute::DistanceMetric;
 using vespalib::eval::get_cell_type;
 using vespalib::eval::ValueType;
 using vespalib::datastore::CompactionSpec;
@@ -105,12 +109,13 @@ public:
 
     ~HnswIndexTest() {}
 
-    void init(bool heuristic_select_neighbors) {
+    void init(bool heuristic_select_neighbors, bool quantize_vectors = false) {
         auto generator = std::make_unique<LevelGenerator>();
         level_generator = generator.get();
         index = std::make_unique<IndexType>(vectors, std::make_unique<SquaredEuclideanDistance>(vespalib::eval::CellType::FLOAT),
                                             std::move(generator),
-                                            HnswIndexConfig(5, 2, 10, 0, heuristic_select_neighbors));
+                                            HnswIndexConfig(5, 2, 10, 0, heuristic_select_neighbors),
+                                            quantize_vectors ? std::make_unique<ScalarQuantizedVectorStore>(2, DistanceMetric::Euclidean) : nullptr);
     }
     void add_document(uint32_t docid, uint32_t max_level = 0) {
         level_generator->level = max_level;
@@ -755,6 +760,96 @@ TYPED_TEST(HnswIndexTest, hnsw_graph_can_be_saved_and_loaded)
     this->check_savetest_index("after load");
 }
 
+TYPED_TEST(HnswIndexTest, search_with_quantized_vectors_returns_exact_distances)
+{
+    this->init(false, true);
+    for (uint32_t docid = 1; docid < 8; ++docid) {
+        this->add_document(docid);
+    }
+    EXPECT_NE(nullptr, this->index->quantized_vectors());
+    this->expect_top_3(1, {1});
+    this->expect_top_3(2, {2, 1, 3});
+    this->expect_top_3(4, {4, 1, 3});
+    this->expect_top_3(5, {5, 6, 2});
+    this->expect_top_3(8, {4, 3, 1});
+    this->expect_top_3(9, {7, 3, 2});
+
+    auto qv = this->vectors.get_vector(9, 0);
+    auto hits = this->index->find_top_k(3, qv, 3, 10000.0);
+    ASSERT_EQ(3, hits.size());
+    SquaredEuclideanDistance exact(vespalib::eval::CellType::FLOAT);
+    for (const auto& hit : hits) {
+        EXPECT_EQ(exact.calc(qv, this->vectors.get_vector(hit.docid, 0)), hit.distance);
+    }
+}
+
+TYPED_TEST(HnswIndexTest, batched_top_k_search_gives_same_result_as_single_searches)
+{
+    for (bool quantize_vectors : {false, true}) {
+        SCOPED_TRACE(quantize_vectors ? "quantized" : "original");
+        this->init(true, quantize_vectors);
+        for (uint32_t docid = 1; docid < 10; ++docid) {
+            this->add_document(docid, docid % 3 == 0 ? 1 : 0);
+        }
+        std::vector<NearestNeighborIndex::TopKQuery> queries;
+        for (uint32_t docid : {2, 5, 8}) {
+            queries.emplace_back(this->vectors.get_vector(docid, 0), 3, 5, 10000.0);
+        }
+        queries.emplace_back(this->vectors.get_vector(9, 0), 1, 1, 10000.0);
+        for (bool use_filter : {false, true}) {
+            if (use_filter) {
+                this->set_filter({2, 3, 4, 6, 7});
+            }
+            auto* filter = this->global_filter->ptr_if_active();
+            auto batch_result = this->index->find_top_k_batch(queries, filter);
+            ASSERT_EQ(queries.size(), batch_result.size());
+            for (size_t i = 0; i < queries.size(); ++i) {
+                const auto& query = queries[i];
+                auto exp = filter
+                    ? this->index->find_top_k_with_filter(query.k, query.vector, *filter, query.explore_k, query.distance_threshold)
+                    : this->index->find_top_k(query.k, query.vector, query.explore_k, query.distance_threshold);
+                EXPECT_EQ(exp, batch_result[i]);
+            }
+        }
+        this->global_filter = GlobalFilter::create();
+    }
+}
+
+TYPED_TEST(HnswIndexTest, quantized_vectors_are_populated_when_graph_is_loaded)
+{
+    this->init(false, true);
+    this->make_savetest_index();
+    auto data = this->save_index();
+    this->init(false, true);
+    this->load_index(data);
+    this->index->populate_quantized_vectors();
+    this->check_savetest_index("after load");
+    this->expect_top_3_by_docid("{3, 5}", {3, 5}, {4, 7});
+}
+
+TYPED_TEST(HnswIndexTest, quantized_vectors_are_populated_by_index_loader)
+{
+    this->init(false, true);
+    this->make_savetest_index();
+    auto data = this->save_index();
+    this->init(false, true);
+    search::fileutil::LoadedBuffer buffer(data.data(), data.size());
+    auto loader = this->index->make_loader(buffer);
+    while (loader->load_next()) {}
+    this->check_savetest_index("after load");
+    const auto* quantized = this->index->quantized_vectors();
+    ASSERT_NE(nullptr, quantized);
+    std::vector<float> buf(2);
+    for (uint32_t docid : {4, 7}) {
+        SCOPED_TRACE(docid);
+        auto exp = this->vectors.get_vector(docid, 0).template typify<float>();
+        auto act = quantized->get_vector(this->get_single_nodeid(docid), buf.data()).template typify<float>();
+        EXPECT_FLOAT_EQ(exp[0], act[0]);
+        EXPECT_FLOAT_EQ(exp[1], act[1]);
+    }
+    this->expect_top_3_by_docid("{3, 5}", {3, 5}, {4, 7});
+}
+
 using HnswMultiIndexTest = HnswIndexTest<HnswIndex<HnswIndexType::MULTI>>;
 
 TEST_F(HnswMultiIndexTest, duplicate_docid_is_removed)
@@ -895,4 +990,31 @@ TYPED_TEST(TwoPhaseTest, two_phase_add)
     this->expect_levels(nodeids[0], {{2}, {4}});
 }
 
+
+TEST(ScalarQuantizedVectorStoreTest, quantized_distances_approximate_exact_distances)
+{
+    constexpr uint32_t dims = 64;
+    std::vector<std::vector<float>> vectors;
+    for (uint32_t i = 0; i < 8; ++i) {
+        std::vector<float> vector(dims);
+        for (uint32_t j = 0; j < dims; ++j) {
+            vector[j] = std::sin(float(i * dims + j)) * 0.125f;
+        }
+        vectors.push_back(std::move(vector));
+    }
+    auto cells = [&](uint32_t i) { return vespalib::eval::TypedCells(vectors[i].data(), vespalib::eval::CellType::FLOAT, dims); };
+    for (auto metric : {DistanceMetric::Euclidean, DistanceMetric::Angular, DistanceMetric::InnerProduct}) {
+        SCOPED_TRACE(static_cast<int>(metric));
+        auto exact = make_distance_function(metric, vespalib::eval::CellType::FLOAT);
+        ScalarQuantizedVectorStore store(dims, metric);
+        for (uint32_t i = 0; i < vectors.size(); ++i) {
+            store.set(i, cells(i));
+        }
+        ScalarQuantizedVectorStore::QueryDistance distance(store, cells(0));
+        for (uint32_t i = 0; i < vectors.size(); ++i) {
+            EXPECT_NEAR(exact->calc(cells(0), cells(i)), distance.calc(i), 0.01);
+        }
+    }
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -158,6 +158,14 @@ public:
         HnswIndexLoader<VectorBufferReader, GraphType::index_type> loader(copy, id_mapping, std::make_unique<VectorBufferReader>(data));
         while (loader.load_next()) {}
     }
+    void load_copy_from_loaded_buffer(std::vector<char> data, size_t misalign = 0) {
+        typename HnswIndexTraits<GraphType::index_type>::IdMapping id_mapping;
+        data.insert(data.begin(), misalign, 0);
+        LoadedBuffer buffer(data.data() + misalign, data.size() - misalign);
+        using ReaderType = search::ReleasingBufferReader<uint32_t>;
+        HnswIndexLoader<ReaderType, GraphType::index_type> loader(copy, id_mapping, std::make_unique<ReaderType>(buffer));
+        while (loader.load_next()) {}
+    }
 
     void expect_docid_and_subspace(uint32_t nodeid) const {
         auto& node = copy.node_refs.get_elem_ref(nodeid);
@@ -201,6 +209,22 @@ TYPED_TEST(CopyGraphTest, reconstructs_graph)
     this->expect_copy_as_populated();
 }
 
+TYPED_TEST(CopyGraphTest, reconstructs_graph_from_loaded_buffer)
+{
+    populate(this->original);
+    auto data = this->save_original();
+    this->load_copy_from_loaded_buffer(data);
+    this->expect_copy_as_populated();
+}
+
+TYPED_TEST(CopyGraphTest, reconstructs_graph_from_unaligned_loaded_buffer)
+{
+    populate(this->original);
+    auto data = this->save_original();
+    this->load_copy_from_loaded_buffer(data, 1);
+    this->expect_copy_as_populated();
+}
+
 TYPED_TEST(CopyGraphTest, later_changes_ignored)
 {
     populate(this->original);
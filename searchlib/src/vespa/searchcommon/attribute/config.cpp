@@ -24,6 +24,7 @@ Config::Config(BasicType bt, CollectionType ct, bool fastSearch_) noexcept
       _fastAccess(false),
       _mutable(false),
       _paged(false),
+      _compressed(false),
       _maxUnCommittedMemory(MAX_UNCOMMITTED_MEMORY),
       _match(Match::UNCASED),
       _dictionary(),
@@ -53,6 +54,7 @@ Config::operator==(const Config &b) const
            _fastAccess == b._fastAccess &&
            _mutable == b._mutable &&
            _paged == b._paged &&
+           _compressed == b._compressed &&
            _maxUnCommittedMemory == b._maxUnCommittedMemory &&
            _match == b._match &&
            _dictionary == b._dictionary &&
@@ -38,6 +38,7 @@ public:
     CollectionType collectionType()       const { return _type; }
     bool fastSearch()                     const { return _fastSearch; }
     bool paged()                          const { return _paged; }
+    bool compressed()                     const { return _compressed; }
     const PredicateParams &predicateParams() const { return _predicateParams; }
     const vespalib::eval::ValueType & tensorType() const { return _tensorType; }
     DistanceMetric distance_metric() const { return _distance_metric; }
@@ -99,6 +100,7 @@ public:
     Config & setIsFilter(bool isFilter) { _isFilter = isFilter; return *this; }
     Config & setMutable(bool isMutable) { _mutable = isMutable; return *this; }
     Config & setPaged(bool paged_in) { _paged = paged_in; return *this; }
+    Config & setCompressed(bool compressed_in) { _compressed = compressed_in; return *this; }
     Config & setFastAccess(bool v) { _fastAccess = v; return *this; }
     Config & setGrowStrategy(const GrowStrategy &gs) { _growStrategy = gs; return *this; }
     Config & setCompactionStrategy(const CompactionStrategy &compactionStrategy) {
@@ -122,6 +124,7 @@ private:
     bool           _fastAccess;
     bool           _mutable;
     bool           _paged;
+    bool           _compressed;
     uint64_t       _maxUnCommittedMemory;
     Match                          _match;
     DictionaryConfig               _dictionary;
@@ -17,28 +17,39 @@ private:
     // This is always the same as in the attribute config, and is duplicated here to simplify usage.
     DistanceMetric _distance_metric;
     bool _multi_threaded_indexing;
+    bool _quantize_vectors;
+    // Max number of threads used to build the index during load, 0 means one per cpu core.
+    uint32_t _build_threads;
 
 public:
     HnswIndexParams(uint32_t max_links_per_node_in,
                     uint32_t neighbors_to_explore_at_insert_in,
                     DistanceMetric distance_metric_in,
-                    bool multi_threaded_indexing_in = false) noexcept
+                    bool multi_threaded_indexing_in = false,
+                    bool quantize_vectors_in = false,
+                    uint32_t build_threads_in = 0) noexcept
             : _max_links_per_node(max_links_per_node_in),
               _neighbors_to_explore_at_insert(neighbors_to_explore_at_insert_in),
               _distance_metric(distance_metric_in),
-              _multi_threaded_indexing(multi_threaded_indexing_in)
+              _multi_threaded_indexing(multi_threaded_indexing_in),
+              _quantize_vectors(quantize_vectors_in),
+              _build_threads(build_threads_in)
     {}
 
     uint32_t max_links_per_node() const { return _max_links_per_node; }
     uint32_t neighbors_to_explore_at_insert() const { return _neighbors_to_explore_at_insert; }
     DistanceMetric distance_metric() const { return _distance_metric; }
     bool multi_threaded_indexing() const { return _multi_threaded_indexing; }
+    bool quantize_vectors() const { return _quantize_vectors; }
+    uint32_t build_threads() const { return _build_threads; }
 
+    // build_threads only tunes how the index is built on load, and is not part of the index definition.
     bool operator==(const HnswIndexParams& rhs) const {
         return (_max_links_per_node == rhs._max_links_per_node &&
                 _neighbors_to_explore_at_insert == rhs._neighbors_to_explore_at_insert &&
                 _distance_metric == rhs._distance_metric &&
-                _multi_threaded_indexing == rhs._multi_threaded_indexing);
+                _multi_threaded_indexing == rhs._multi_threaded_indexing &&
+                _quantize_vectors == rhs._quantize_vectors);
     }
 };
 
@@ -128,7 +128,9 @@ Schema::Field::operator!=(const Field &rhs) const
 Schema::IndexField::IndexField(vespalib::stringref name, DataType dt) noexcept
     : Field(name, dt),
       _avgElemLen(512),
-      _interleaved_features(false)
+      _interleaved_features(false),
+      _packed_doc_ids(false),
+      _block_max(false)
 {
 }
 
@@ -136,14 +138,18 @@ Schema::IndexField::IndexField(vespalib::stringref name, DataType dt,
                                CollectionType ct) noexcept
     : Field(name, dt, ct),
       _avgElemLen(512),
-      _interleaved_features(false)
+      _interleaved_features(false),
+      _packed_doc_ids(false),
+      _block_max(false)
 {
 }
 
 Schema::IndexField::IndexField(const config::StringVector &lines)
     : Field(lines),
       _avgElemLen(ConfigParser::parse<int32_t>("averageelementlen", lines, 512)),
-      _interleaved_features(ConfigParser::parse<bool>("interleavedfeatures", lines, false))
+      _interleaved_features(ConfigParser::parse<bool>("interleavedfeatures", lines, false)),
+      _packed_doc_ids(ConfigParser::parse<bool>("packeddocids", lines, false)),
+      _block_max(ConfigParser::parse<bool>("blockmax", lines, false))
 {
 }
 
@@ -158,6 +164,8 @@ Schema::IndexField::write(vespalib::asciistream & os, vespalib::stringref prefix
     Field::write(os, prefix);
     os << prefix << "averageelementlen " << static_cast<int32_t>(_avgElemLen) << "\n";
     os << prefix << "interleavedfeatures " << (_interleaved_features ? "true" : "false") << "\n";
+    os << prefix << "packeddocids " << (_packed_doc_ids ? "true" : "false") << "\n";
+    os << prefix << "blockmax " << (_block_max ? "true" : "false") << "\n";
 
     // TODO: Remove prefix, phrases and positions when breaking downgrade is no longer an issue.
     os << prefix << "prefix false" << "\n";
@@ -170,7 +178,9 @@ Schema::IndexField::operator==(const IndexField &rhs) const
 {
     return Field::operator==(rhs) &&
             _avgElemLen == rhs._avgElemLen &&
-            _interleaved_features == rhs._interleaved_features;
+            _interleaved_features == rhs._interleaved_features &&
+            _packed_doc_ids == rhs._packed_doc_ids &&
+            _block_max == rhs._block_max;
 }
 
 bool
@@ -178,7 +188,9 @@ Schema::IndexField::operator!=(const IndexField &rhs) const
 {
     return Field::operator!=(rhs) ||
             _avgElemLen != rhs._avgElemLen ||
-            _interleaved_features != rhs._interleaved_features;
+            _interleaved_features != rhs._interleaved_features ||
+            _packed_doc_ids != rhs._packed_doc_ids ||
+            _block_max != rhs._block_max;
 }
 
 Schema::FieldSet::FieldSet(const config::StringVector & lines) :
@@ -78,6 +78,10 @@ public:
         uint32_t _avgElemLen;
         // TODO: Remove when posting list format with interleaved features is made default
         bool _interleaved_features;
+        // Use posting lists with bit packed blocks of document ids
+        bool _packed_doc_ids;
+        // Store max term frequency per skip block (requires interleaved features)
+        bool _block_max;
 
     public:
         IndexField(vespalib::stringref name, DataType dt) noexcept;
@@ -96,12 +100,22 @@ public:
             _interleaved_features = value;
             return *this;
         }
+        IndexField &set_packed_doc_ids(bool value) {
+            _packed_doc_ids = value;
+            return *this;
+        }
+        IndexField &set_block_max(bool value) {
+            _block_max = value;
+            return *this;
+        }
 
         void write(vespalib::asciistream &os,
                    vespalib::stringref prefix) const override;
 
         uint32_t getAvgElemLen() const { return _avgElemLen; }
         bool use_interleaved_features() const { return _interleaved_features; }
+        bool use_packed_doc_ids() const { return _packed_doc_ids; }
+        bool use_block_max() const { return _block_max; }
 
         bool operator==(const IndexField &rhs) const;
         bool operator!=(const IndexField &rhs) const;
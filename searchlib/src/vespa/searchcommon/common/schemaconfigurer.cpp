@@ -113,7 +113,9 @@ SchemaBuilder::build(const IndexschemaConfig &cfg, Schema &schema)
         schema.addIndexField(Schema::IndexField(f.name, convertIndexDataType(f.datatype),
                                                 convertIndexCollectionType(f.collectiontype)).
                 setAvgElemLen(f.averageelementlen).
-                set_interleaved_features(f.interleavedfeatures));
+                set_interleaved_features(f.interleavedfeatures).
+                set_packed_doc_ids(f.packeddocids).
+                set_block_max(f.blockmax));
     }
     for (size_t i = 0; i < cfg.fieldset.size(); ++i) {
         const IndexschemaConfig::Fieldset &fs = cfg.fieldset[i];
@@ -501,12 +501,8 @@ calculateRank(const Sketch<BucketBits, HashT> &sketch) {
         return static_cast<const SparseSketch<BucketBits, HashT>&>(sketch)
             .getSize();
     }
-    auto normal = static_cast<const NormalSketch<BucketBits, HashT>&>(sketch);
-    int rank = 0;
-    for (size_t i = 0; i < sketch.BUCKET_COUNT; ++i) {
-        rank += normal.bucket[i];
-    }
-    return rank;
+    const auto & normal = static_cast<const NormalSketch<BucketBits, HashT>&>(sketch);
+    return vespalib::hwaccelrated::IAccelrated::getAccelerator().sumUint8(normal.bucket, sketch.BUCKET_COUNT);
 }
 }  // namespace
 
@@ -468,6 +468,44 @@ Group::Value::mergePartial(const GroupingLevelList &levels, uint32_t firstLevel,
     }
 }
 
+void
+Group::Value::partitionChildren(std::vector<Group> & partitions)
+{
+    size_t numPartitions = partitions.size();
+    for (ChildP *it(_children), *mt(_children + getChildrenSize()); it != mt; ++it) {
+        partitions[(*it)->getId().hash() % numPartitions]._aggr.addChild(*it);
+        reset(*it);
+    }
+    setChildrenSize(0);
+}
+
+void
+Group::Value::joinChildren(std::vector<Group> & partitions)
+{
+    size_t count(getChildrenSize());
+    for (const Group & partition : partitions) {
+        count += partition.getChildrenSize();
+    }
+    auto z = new ChildP[(count > 0) ? std::max(4ul, 2ul << vespalib::Optimized::msbIdx(count)) : 4ul];
+    size_t kept(0);
+    for (ChildP *it(_children), *mt(_children + getChildrenSize()); it != mt; ++it) {
+        z[kept++] = *it;
+        reset(*it);
+    }
+    for (Group & partition : partitions) {
+        Value & p(partition._aggr);
+        for (ChildP *it(p._children), *mt(p._children + p.getChildrenSize()); it != mt; ++it) {
+            z[kept++] = *it;
+            reset(*it);
+        }
+        p.setChildrenSize(0);
+    }
+    std::swap(_children, z);
+    destruct(z, getAllChildrenSize());
+    setChildrenSize(kept);
+    _childInfo._allChildren = 0;
+}
+
 void
 Group::Value::postMerge(const std::vector<GroupingLevel> &levels, uint32_t firstLevel, uint32_t currentLevel)
 {
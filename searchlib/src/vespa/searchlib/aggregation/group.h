@@ -94,6 +94,8 @@ private:
         void prune(const Value & b, uint32_t lastLevel, uint32_t currentLevel);
         void postMerge(const std::vector<GroupingLevel> &levels, uint32_t firstLevel, uint32_t currentLevel);
         void partialCopy(const Value & rhs);
+        void partitionChildren(std::vector<Group> & partitions);
+        void joinChildren(std::vector<Group> & partitions);
         VESPA_DLL_LOCAL Group * groupSingle(const ResultNode & selectResult, HitRank rank, const GroupingLevel & level);
 
         GroupList groups() const { return _children; }
@@ -262,6 +264,35 @@ public:
     void postMerge(const std::vector<GroupingLevel> &levels, uint32_t firstLevel, uint32_t currentLevel) {
         _aggr.postMerge(levels, firstLevel, currentLevel);
     }
+
+    /**
+     * Move the children of this group into the given partitions,
+     * selected by the hash of the group id. The order of the children
+     * is kept within each partition.
+     *
+     * @param partitions The groups receiving the children.
+     **/
+    void partitionChildren(std::vector<Group> &partitions) { _aggr.partitionChildren(partitions); }
+
+    /**
+     * Merge the children of another group into the children of this
+     * group, leaving the results of the groups themselves untouched.
+     *
+     * @param b The group to merge children from.
+     * @param firstLevel The first level to merge.
+     * @param currentLevel The level of this group.
+     **/
+    void mergeChildren(const std::vector<GroupingLevel> &levels, uint32_t firstLevel, uint32_t currentLevel, Group &b) {
+        _aggr.merge(levels, firstLevel, currentLevel, b._aggr);
+    }
+
+    /**
+     * Move the children of the given partitions into this group. The
+     * children are not ordered by id afterwards.
+     *
+     * @param partitions The groups to take the children from.
+     **/
+    void joinChildren(std::vector<Group> &partitions) { _aggr.joinChildren(partitions); }
 };
 
 }
@@ -2,12 +2,16 @@
 
 #include "attribute_blueprint_factory.h"
 #include "attribute_weighted_set_blueprint.h"
+#include "attributevector.h"
+#include "filter_search_cache.h"
 #include "i_document_weight_attribute.h"
 #include "iterator_pack.h"
 #include "predicate_attribute.h"
 #include "attribute_blueprint_params.h"
 #include "document_weight_or_filter_search.h"
 #include <vespa/eval/eval/value.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
 #include <vespa/searchlib/common/location.h>
 #include <vespa/searchlib/common/locationiterators.h>
 #include <vespa/searchlib/common/matching_elements_fields.h>
@@ -47,6 +51,7 @@ LOG_SETUP(".searchlib.attribute.attribute_blueprint_factory");
 
 using search::attribute::BasicType;
 using search::attribute::CollectionType;
+using search::attribute::FilterSearchCache;
 using search::attribute::IAttributeVector;
 using search::attribute::ISearchContext;
 using search::fef::TermFieldMatchData;
@@ -125,6 +130,33 @@ private:
     ISearchContext::UP _search_context;
     enum Type {INT, FLOAT, OTHER};
     Type _type;
+    // Set when the result of this (filter) term is found in the cache, or should be calculated and inserted.
+    std::shared_ptr<FilterSearchCache> _filter_cache;
+    vespalib::string _filter_cache_key;
+    FilterSearchCache::Entry::SP _cached;
+    FilterSearchCache::generation_t _attr_generation;
+    uint32_t _attr_docid_limit;
+
+    SearchIteratorUP create_iterator(fef::TermFieldMatchData *tfmd, bool strict) const {
+        if (_cached) {
+            uint32_t docid_limit = std::min(get_docid_limit(), _cached->docIdLimit);
+            return BitVectorIterator::create(_cached->bitVector.get(), docid_limit, *tfmd, strict);
+        }
+        return _search_context->createIterator(tfmd, strict);
+    }
+
+    void populate_filter_cache() {
+        fef::TermFieldMatchData tfmd;
+        auto bv = BitVector::create(_attr_docid_limit);
+        auto search = _search_context->createIterator(&tfmd, true);
+        search->initRange(1, _attr_docid_limit);
+        search->or_hits_into(*bv, 1);
+        bv->invalidateCachedCount();
+        uint32_t hits = bv->countTrueBits();
+        _cached = std::make_shared<FilterSearchCache::Entry>(std::move(bv), _attr_generation, _attr_docid_limit, hits);
+        _filter_cache->insert(_filter_cache_key, _cached);
+        _filter_cache.reset();
+    }
 
     AttributeFieldBlueprint(const FieldSpec &field, const IAttributeVector &attribute,
                             QueryTermSimple::UP term, const attribute::SearchContextParams &params)
@@ -132,7 +164,12 @@ private:
           _attr(attribute),
           _query_term(term->getTermString()),
           _search_context(attribute.createSearchContext(std::move(term), params)),
-          _type(OTHER)
+          _type(OTHER),
+          _filter_cache(),
+          _filter_cache_key(),
+          _cached(),
+          _attr_generation(0),
+          _attr_docid_limit(0)
     {
         uint32_t estHits = _search_context->approximateHits();
         HitEstimate estimate(estHits, estHits == 0);
@@ -169,15 +206,35 @@ public:
                                       .diversityCutoffStrict(diversityCutoffStrict))
     {}
 
+    /**
+     * Use the given cache for the result of this term. The attribute generation and committed docid limit
+     * are captured here, before the attribute is searched, so that a result inserted into the cache is
+     * never newer than what it is tagged with.
+     */
+    void use_filter_cache(std::shared_ptr<FilterSearchCache> cache, const vespalib::string &key, const AttributeVector &attr) {
+        _attr_generation = attr.getCurrentGeneration();
+        _attr_docid_limit = attr.getCommittedDocIdLimit();
+        auto result = cache->lookup(key, _attr_generation, _attr_docid_limit);
+        if (result.entry) {
+            _cached = std::move(result.entry);
+            setEstimate(HitEstimate(_cached->hits, _cached->hits == 0));
+            // testing a bit is cheaper than seeking a posting list
+            set_cost(0.5);
+        } else if (result.shouldInsert) {
+            _filter_cache = std::move(cache);
+            _filter_cache_key = key;
+        }
+    }
+
     SearchIteratorUP createLeafSearch(const TermFieldMatchDataArray &tfmda, bool strict) const override {
         assert(tfmda.size() == 1);
-        return _search_context->createIterator(tfmda[0], strict);
+        return create_iterator(tfmda[0], strict);
     }
 
     SearchIterator::UP createSearch(fef::MatchData &md, bool strict) const override {
         const State &state = getState();
         assert(state.numFields() == 1);
-        return _search_context->createIterator(state.field(0).resolve(md), strict);
+        return create_iterator(state.field(0).resolve(md), strict);
     }
 
     SearchIteratorUP createFilterSearch(bool strict, FilterConstraint constraint) const override {
@@ -188,7 +245,13 @@ public:
     }
 
     void fetchPostings(const queryeval::ExecuteInfo &execInfo) override {
+        if (_cached) {
+            return;
+        }
         _search_context->fetchPostings(execInfo);
+        if (_filter_cache) {
+            populate_filter_cache();
+        }
     }
 
     void visitMembers(vespalib::ObjectVisitor &visitor) const override;
@@ -233,6 +296,7 @@ AttributeFieldBlueprint::visitMembers(vespalib::ObjectVisitor &visitor) const
     LeafBlueprint::visitMembers(visitor);
     visit_attribute(visitor, _attr);
     visit(visitor, "query_term", _query_term);
+    visit(visitor, "cached", bool(_cached));
 }
 
 //-----------------------------------------------------------------------------
@@ -700,28 +764,54 @@ private:
     const FieldSpec &_field;
     const IAttributeVector &_attr;
     const IDocumentWeightAttribute *_dwa;
+    const std::shared_ptr<FilterSearchCache> &_filter_cache;
     vespalib::string _scratchPad;
 
+    /**
+     * Filter terms are cached when searching them is expensive: range terms, and exact terms in
+     * attributes without fast-search. Imported attributes have their own cache.
+     */
+    void maybe_use_filter_cache(AttributeFieldBlueprint &bp, query::Node &n, char term_kind) {
+        if (!_filter_cache || !_field.isFilter()) {
+            return;
+        }
+        if ((term_kind != 'r') && _attr.getIsFastSearch()) {
+            return;
+        }
+        const auto *attr = dynamic_cast<const AttributeVector *>(&_attr);
+        if (attr == nullptr) {
+            return;
+        }
+        auto key = FilterSearchCache::makeKey(_attr.getName(), term_kind, queryeval::termAsString(n));
+        bp.use_filter_cache(_filter_cache, key, *attr);
+    }
+
 public:
     CreateBlueprintVisitor(Searchable &searchable, const IRequestContext &requestContext,
-                           const FieldSpec &field, const IAttributeVector &attr)
+                           const FieldSpec &field, const IAttributeVector &attr,
+                           const std::shared_ptr<FilterSearchCache> &filter_cache)
         : CreateBlueprintVisitorHelper(searchable, field, requestContext),
           _field(field),
           _attr(attr),
           _dwa(attr.asDocumentWeightAttribute()),
+          _filter_cache(filter_cache),
           _scratchPad()
     {
     }
     ~CreateBlueprintVisitor() override;
 
     template <class TermNode>
-    void visitTerm(TermNode &n, bool simple = false) {
+    void visitTerm(TermNode &n, bool simple = false, char term_kind = '\0') {
         if (simple && (_dwa != nullptr) && !_field.isFilter() && n.isRanked()) {
             NodeAsKey key(n, _scratchPad);
             setResult(std::make_unique<DirectAttributeBlueprint>(_field, _attr.getName(), _attr, *_dwa, key));
         } else {
             const string stack = StackDumpCreator::create(n);
-            setResult(std::make_unique<AttributeFieldBlueprint>(_field, _attr, stack));
+            auto bp = std::make_unique<AttributeFieldBlueprint>(_field, _attr, stack);
+            if (term_kind != '\0') {
+                maybe_use_filter_cache(*bp, n, term_kind);
+            }
+            setResult(std::move(bp));
         }
     }
 
@@ -739,7 +829,7 @@ public:
         }
     }
 
-    void visit(NumberTerm & n) override { visitTerm(n, true); }
+    void visit(NumberTerm & n) override { visitTerm(n, true, 'n'); }
     void visit(LocationTerm &n) override { visitLocation(n); }
     void visit(PrefixTerm & n) override { visitTerm(n); }
 
@@ -757,11 +847,13 @@ public:
                 setResult(std::make_unique<queryeval::EmptyBlueprint>(_field));
             }
         } else {
-            setResult(std::make_unique<AttributeFieldBlueprint>(_field, _attr, stack));
+            auto bp = std::make_unique<AttributeFieldBlueprint>(_field, _attr, stack);
+            maybe_use_filter_cache(*bp, n, 'r');
+            setResult(std::move(bp));
         }
     }
 
-    void visit(StringTerm & n) override { visitTerm(n, true); }
+    void visit(StringTerm & n) override { visitTerm(n, true, 's'); }
     void visit(SubstringTerm & n) override {
         query::SimpleRegExpTerm re(vespalib::RegexpUtil::make_from_substring(n.getTerm()),
                                    n.getView(), n.getId(), n.getWeight());
@@ -892,6 +984,15 @@ CreateBlueprintVisitor::~CreateBlueprintVisitor() = default;
 
 //-----------------------------------------------------------------------------
 
+AttributeBlueprintFactory::AttributeBlueprintFactory() = default;
+
+AttributeBlueprintFactory::AttributeBlueprintFactory(std::shared_ptr<attribute::FilterSearchCache> filter_cache)
+    : _filter_cache(std::move(filter_cache))
+{
+}
+
+AttributeBlueprintFactory::~AttributeBlueprintFactory() = default;
+
 Blueprint::UP
 AttributeBlueprintFactory::createBlueprint(const IRequestContext & requestContext,
                                            const FieldSpec &field,
@@ -903,7 +1004,7 @@ AttributeBlueprintFactory::createBlueprint(const IRequestContext & requestContex
         return std::make_unique<queryeval::EmptyBlueprint>(field);
     }
     try {
-        CreateBlueprintVisitor visitor(*this, requestContext, field, *attr);
+        CreateBlueprintVisitor visitor(*this, requestContext, field, *attr, _filter_cache);
         const_cast<Node &>(term).accept(visitor);
         return visitor.getResult();
     } catch (const vespalib::UnsupportedOperationException &e) {
@@ -3,12 +3,24 @@
 #pragma once
 
 #include <vespa/searchlib/queryeval/searchable.h>
+#include <memory>
+
+namespace search::attribute { class FilterSearchCache; }
 
 namespace search {
 
 class AttributeBlueprintFactory : public queryeval::Searchable
 {
+private:
+    std::shared_ptr<attribute::FilterSearchCache> _filter_cache;
 public:
+    AttributeBlueprintFactory();
+    /**
+     * The given cache (if any) is used for the results of expensive filter terms.
+     */
+    explicit AttributeBlueprintFactory(std::shared_ptr<attribute::FilterSearchCache> filter_cache);
+    ~AttributeBlueprintFactory() override;
+
     std::unique_ptr<queryeval::Blueprint>
     createBlueprint(const queryeval::IRequestContext & requestContext,
                     const queryeval::FieldSpec &field,
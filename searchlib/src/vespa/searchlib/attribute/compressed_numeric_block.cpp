@@ -0,0 +1,239 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compressed_numeric_block.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+namespace search::attribute {
+
+namespace {
+
+constexpr uint32_t block_size = CompressedNumericBlock::block_size;
+constexpr uint32_t header_size = CompressedNumericBlock::header_size;
+
+constexpr uint64_t
+code_mask(uint32_t width) noexcept
+{
+    return (width >= 64) ? std::numeric_limits<uint64_t>::max() : ((uint64_t(1) << width) - 1);
+}
+
+uint32_t
+bits_needed(uint64_t value) noexcept
+{
+    return 64 - __builtin_clzll(value);
+}
+
+uint64_t
+get_code(const int64_t *packed, uint32_t offset, uint32_t width) noexcept
+{
+    uint32_t bit_pos = offset * width;
+    uint32_t idx = bit_pos >> 6;
+    uint32_t shift = bit_pos & 63;
+    uint64_t code = static_cast<uint64_t>(packed[idx]) >> shift;
+    if (shift + width > 64) {
+        code |= static_cast<uint64_t>(packed[idx + 1]) << (64 - shift);
+    }
+    return code & code_mask(width);
+}
+
+/*
+ * Unpack codes for all documents in block. The loop is branch free,
+ * using a local copy of the packed codes with a padding word.
+ */
+void
+unpack_codes(const int64_t *packed, uint32_t width, uint64_t *codes) noexcept
+{
+    uint64_t buf[block_size + 1];
+    memcpy(buf, packed, width * sizeof(uint64_t));
+    buf[width] = 0;
+    uint64_t mask = code_mask(width);
+    for (uint32_t i = 0; i < block_size; ++i) {
+        uint32_t bit_pos = i * width;
+        uint32_t idx = bit_pos >> 6;
+        uint32_t shift = bit_pos & 63;
+        codes[i] = ((buf[idx] >> shift) | ((buf[idx + 1] << 1) << (63 - shift))) & mask;
+    }
+}
+
+struct Layout {
+    uint32_t width;
+    uint32_t exceptions;
+    int64_t  low;
+    int64_t  high;
+    Layout() noexcept : width(65), exceptions(0), low(0), high(0) { }
+    uint32_t cost() const noexcept { return width + 2 * exceptions; }
+};
+
+/*
+ * Select the window of sorted values to be covered by codes. Values
+ * outside the window become exceptions.
+ */
+Layout
+select_layout(const int64_t *sorted, uint32_t num_values) noexcept
+{
+    Layout best;
+    uint32_t max_exceptions = std::min(CompressedNumericBlock::max_exceptions, num_values - 1);
+    for (uint32_t exceptions = 0; exceptions <= max_exceptions; ++exceptions) {
+        uint64_t reserved = (exceptions > 0) ? 1 : 0;
+        for (uint32_t lo = 0; lo <= exceptions; ++lo) {
+            uint32_t hi = lo + num_values - exceptions - 1;
+            uint64_t range = static_cast<uint64_t>(sorted[hi]) - static_cast<uint64_t>(sorted[lo]);
+            if (range > std::numeric_limits<uint64_t>::max() - 1 - reserved) {
+                continue; // Codes would not fit in 64 bits
+            }
+            Layout layout;
+            layout.width = bits_needed(range + 1 + reserved);
+            layout.exceptions = exceptions;
+            layout.low = sorted[lo];
+            layout.high = sorted[hi];
+            if (layout.cost() < best.cost()) {
+                best = layout;
+            }
+        }
+    }
+    return best;
+}
+
+int64_t
+get_exception(CompressedNumericBlock::ConstArrayRef block, uint32_t offset) noexcept
+{
+    uint32_t num_exceptions = CompressedNumericBlock::get_num_exceptions(block);
+    const int64_t *exceptions = block.data() + header_size + CompressedNumericBlock::get_width(block);
+    for (uint32_t i = 0; i < num_exceptions; ++i) {
+        if (static_cast<uint32_t>(exceptions[2 * i]) == offset) {
+            return exceptions[2 * i + 1];
+        }
+    }
+    abort();
+}
+
+}
+
+int64_t
+CompressedNumericBlock::get(ConstArrayRef block, uint32_t offset, int64_t default_value) noexcept
+{
+    if (block.empty()) {
+        return default_value;
+    }
+    uint32_t width = get_width(block);
+    uint64_t code = get_code(block.data() + header_size, offset, width);
+    if (code == 0) {
+        return default_value;
+    }
+    if (code == code_mask(width) && get_num_exceptions(block) != 0) {
+        return get_exception(block, offset);
+    }
+    return static_cast<int64_t>(static_cast<uint64_t>(block[0]) + code - 1);
+}
+
+void
+CompressedNumericBlock::decode(ConstArrayRef block, int64_t default_value, int64_t *values) noexcept
+{
+    if (block.empty()) {
+        std::fill(values, values + block_size, default_value);
+        return;
+    }
+    uint32_t width = get_width(block);
+    uint64_t codes[block_size];
+    unpack_codes(block.data() + header_size, width, codes);
+    uint64_t base = static_cast<uint64_t>(block[0]);
+    for (uint32_t i = 0; i < block_size; ++i) {
+        values[i] = (codes[i] == 0) ? default_value : static_cast<int64_t>(base + codes[i] - 1);
+    }
+    uint32_t num_exceptions = get_num_exceptions(block);
+    const int64_t *exceptions = block.data() + header_size + width;
+    for (uint32_t i = 0; i < num_exceptions; ++i) {
+        values[exceptions[2 * i]] = exceptions[2 * i + 1];
+    }
+}
+
+std::vector<int64_t>
+CompressedNumericBlock::encode(const int64_t *values, int64_t default_value)
+{
+    int64_t sorted[block_size];
+    uint32_t num_values = 0;
+    for (uint32_t i = 0; i < block_size; ++i) {
+        if (values[i] != default_value) {
+            sorted[num_values++] = values[i];
+        }
+    }
+    if (num_values == 0) {
+        return {};
+    }
+    std::sort(sorted, sorted + num_values);
+    Layout layout = select_layout(sorted, num_values);
+    assert(layout.width >= 1 && layout.width <= 64);
+    std::vector<int64_t> block(header_size + layout.width, 0);
+    block.reserve(header_size + layout.width + 2 * layout.exceptions);
+    block[0] = layout.low;
+    uint64_t base = static_cast<uint64_t>(layout.low);
+    uint64_t exception_code = code_mask(layout.width);
+    uint64_t *packed = reinterpret_cast<uint64_t *>(block.data() + header_size);
+    uint32_t num_exceptions = 0;
+    for (uint32_t i = 0; i < block_size; ++i) {
+        int64_t value = values[i];
+        uint64_t code;
+        if (value == default_value) {
+            code = 0;
+        } else if (value >= layout.low && value <= layout.high) {
+            code = static_cast<uint64_t>(value) - base + 1;
+        } else {
+            code = exception_code;
+            block.push_back(i);
+            block.push_back(value);
+            ++num_exceptions;
+        }
+        uint32_t bit_pos = i * layout.width;
+        uint32_t idx = bit_pos >> 6;
+        uint32_t shift = bit_pos & 63;
+        packed[idx] |= code << shift;
+        if (shift + layout.width > 64) {
+            packed[idx + 1] |= code >> (64 - shift);
+        }
+    }
+    assert(num_exceptions <= layout.exceptions);
+    block[1] = layout.width | (num_exceptions << 8);
+    return block;
+}
+
+uint64_t
+CompressedNumericBlock::match(ConstArrayRef block, int64_t low, int64_t high, bool match_default) noexcept
+{
+    if (block.empty()) {
+        return match_default ? std::numeric_limits<uint64_t>::max() : 0;
+    }
+    uint32_t width = get_width(block);
+    uint32_t num_exceptions = get_num_exceptions(block);
+    uint64_t codes[block_size];
+    unpack_codes(block.data() + header_size, width, codes);
+    uint64_t hits = 0;
+    // Map [low, high] to the range of value codes
+    int64_t base = block[0];
+    uint64_t max_value_code = code_mask(width) - ((num_exceptions != 0) ? 1 : 0);
+    uint64_t low_diff = (low <= base) ? 0 : (static_cast<uint64_t>(low) - static_cast<uint64_t>(base));
+    if (high >= base && low <= high && low_diff < max_value_code) {
+        uint64_t low_code = low_diff + 1;
+        uint64_t high_diff = static_cast<uint64_t>(high) - static_cast<uint64_t>(base);
+        uint64_t high_code = (high_diff >= max_value_code) ? max_value_code : (high_diff + 1);
+        uint64_t span = high_code - low_code;
+        for (uint32_t i = 0; i < block_size; ++i) {
+            hits |= static_cast<uint64_t>((codes[i] - low_code) <= span) << i;
+        }
+    }
+    if (match_default) {
+        for (uint32_t i = 0; i < block_size; ++i) {
+            hits |= static_cast<uint64_t>(codes[i] == 0) << i;
+        }
+    }
+    const int64_t *exceptions = block.data() + header_size + width;
+    for (uint32_t i = 0; i < num_exceptions; ++i) {
+        int64_t value = exceptions[2 * i + 1];
+        uint64_t bit = uint64_t(1) << exceptions[2 * i];
+        hits = (low <= value && value <= high) ? (hits | bit) : (hits & ~bit);
+    }
+    return hits;
+}
+
+}
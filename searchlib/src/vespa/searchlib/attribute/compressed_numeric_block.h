@@ -0,0 +1,51 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/arrayref.h>
+#include <cstdint>
+#include <vector>
+
+namespace search::attribute {
+
+/*
+ * Frame of reference encoding of the values for a block of documents
+ * in a compressed single value numeric attribute.
+ *
+ * Block layout (array of 64-bit words):
+ *
+ *   [base] [width | num exceptions << 8] [packed codes] [exceptions]
+ *
+ * Each document in the block has a code with the given bit width.
+ * Code 0 is the default value for the attribute, code c > 0 is the
+ * value base + c - 1. When the block has exceptions the highest code
+ * is reserved, and the value for such a document is found in the
+ * exception list, stored as (offset in block, value) pairs. Outliers
+ * are kept as exceptions when that gives a smaller block than
+ * widening the codes for all documents.
+ *
+ * An empty block means that all documents have the default value.
+ * Blocks are never modified after being published to readers.
+ */
+class CompressedNumericBlock {
+public:
+    using ConstArrayRef = vespalib::ConstArrayRef<int64_t>;
+    static constexpr uint32_t block_shift = 6;
+    static constexpr uint32_t block_size = 1u << block_shift;
+    static constexpr uint32_t block_mask = block_size - 1;
+    static constexpr uint32_t header_size = 2;
+    static constexpr uint32_t max_exceptions = 8;
+    static constexpr uint32_t max_array_size = header_size + block_size + 2 * max_exceptions;
+
+    static uint32_t get_width(ConstArrayRef block) noexcept { return block[1] & 0xff; }
+    static uint32_t get_num_exceptions(ConstArrayRef block) noexcept { return (block[1] >> 8) & 0xff; }
+    static int64_t get(ConstArrayRef block, uint32_t offset, int64_t default_value) noexcept;
+    // Decode values for all documents in block
+    static void decode(ConstArrayRef block, int64_t default_value, int64_t *values) noexcept;
+    // Encode values for all documents in block, empty result if all have the default value
+    static std::vector<int64_t> encode(const int64_t *values, int64_t default_value);
+    // Returns bit mask for documents in block with a value in the range [low, high]
+    static uint64_t match(ConstArrayRef block, int64_t low, int64_t high, bool match_default) noexcept;
+};
+
+}
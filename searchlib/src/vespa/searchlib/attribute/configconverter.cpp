@@ -108,6 +108,7 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     retval.setFastAccess(cfg.fastaccess);
     retval.setMutable(cfg.ismutable);
     retval.setPaged(cfg.paged);
+    retval.setCompressed(cfg.compressed);
     retval.setMaxUnCommittedMemory(cfg.maxuncommittedmemory);
     predicateParams.setArity(cfg.arity);
     predicateParams.setBounds(cfg.lowerbound, cfg.upperbound);
@@ -138,7 +139,9 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     if (cfg.index.hnsw.enabled) {
         retval.set_hnsw_index_params(HnswIndexParams(cfg.index.hnsw.maxlinkspernode,
                                                      cfg.index.hnsw.neighborstoexploreatinsert,
-                                                     dm, cfg.index.hnsw.multithreadedindexing));
+                                                     dm, cfg.index.hnsw.multithreadedindexing,
+                                                     cfg.index.hnsw.quantizevectors,
+                                                     cfg.index.hnsw.buildthreads));
     }
     if (retval.basicType().type() == BasicType::Type::TENSOR) {
         if (!cfg.tensortype.empty()) {
@@ -7,6 +7,7 @@
 #include "singlestringattribute.h"
 #include "singleboolattribute.h"
 #include "singlenumericattribute.hpp"
+#include "singlecompressednumericattribute.h"
 #include <vespa/eval/eval/fast_value.h>
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
 #include <vespa/searchlib/tensor/serialized_fast_value_attribute.h>
@@ -15,6 +16,20 @@ namespace search {
 
 using attribute::BasicType;
 
+namespace {
+
+template <typename T>
+AttributeVector::SP
+createSingleInteger(vespalib::stringref name, const attribute::Config & info)
+{
+    if (info.compressed()) {
+        return std::make_shared<SingleValueCompressedNumericAttribute<IntegerAttributeTemplate<T>>>(name, info);
+    }
+    return std::make_shared<SingleValueNumericAttribute<IntegerAttributeTemplate<T>>>(name, info);
+}
+
+}
+
 AttributeVector::SP
 AttributeFactory::createSingleStd(stringref name, const Config & info)
 {
@@ -27,14 +42,14 @@ AttributeFactory::createSingleStd(stringref name, const Config & info)
     case BasicType::UINT4:
         return std::make_shared<SingleValueNibbleNumericAttribute>(name, info.getGrowStrategy());
     case BasicType::INT8:
-        return std::make_shared<SingleValueNumericAttribute<IntegerAttributeTemplate<int8_t>>>(name, info);
+        return createSingleInteger<int8_t>(name, info);
     case BasicType::INT16:
         // XXX: Unneeded since we don't have short document fields in java.
-        return std::make_shared<SingleValueNumericAttribute<IntegerAttributeTemplate<int16_t>>>(name, info);
+        return createSingleInteger<int16_t>(name, info);
     case BasicType::INT32:
-        return std::make_shared<SingleValueNumericAttribute<IntegerAttributeTemplate<int32_t>>>(name, info);
+        return createSingleInteger<int32_t>(name, info);
     case BasicType::INT64:
-        return std::make_shared<SingleValueNumericAttribute<IntegerAttributeTemplate<int64_t>>>(name, info);
+        return createSingleInteger<int64_t>(name, info);
     case BasicType::FLOAT:
         return std::make_shared<SingleValueNumericAttribute<FloatingPointAttributeTemplate<float>>>(name, info);
     case BasicType::DOUBLE:
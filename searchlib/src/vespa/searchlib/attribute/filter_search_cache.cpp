@@ -0,0 +1,157 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "filter_search_cache.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+
+namespace search::attribute {
+
+namespace {
+
+// Number of terms that are tracked while they are missed, before they are admitted into the cache.
+constexpr size_t MAX_CANDIDATES = 4096;
+
+}
+
+FilterSearchCache::EntryMap::EntryMap(size_t maxMemory)
+    : vespalib::lrucache_map<EntryParam>(UNLIMITED),
+      _maxMemory(maxMemory),
+      _memoryUsed(0)
+{
+}
+
+FilterSearchCache::EntryMap::~EntryMap() = default;
+
+void
+FilterSearchCache::EntryMap::add(const vespalib::string &key, Entry::SP entry)
+{
+    if (hasKey(key)) {
+        return;
+    }
+    // Account for the new entry up front, as eviction of the oldest entries is done while inserting it.
+    _memoryUsed += calcSize(key, *entry);
+    insert(key, std::move(entry));
+}
+
+void
+FilterSearchCache::EntryMap::remove(const vespalib::string &key)
+{
+    Entry::SP *entry = findAndRef(key);
+    if (entry != nullptr) {
+        _memoryUsed -= calcSize(key, **entry);
+        erase(key);
+    }
+}
+
+void
+FilterSearchCache::EntryMap::removeAll()
+{
+    for (auto itr = begin(); itr != end(); ) {
+        itr = erase(itr);
+    }
+    _memoryUsed = 0;
+}
+
+bool
+FilterSearchCache::EntryMap::removeOldest(const value_type &v)
+{
+    bool remove = (_memoryUsed > _maxMemory);
+    if (remove) {
+        _memoryUsed -= calcSize(v.first, *v.second._value);
+    }
+    return remove;
+}
+
+size_t
+FilterSearchCache::calcSize(const vespalib::string &key, const Entry &entry)
+{
+    return sizeof(EntryParam::value_type) + sizeof(Entry) + key.size() + entry.bitVector->getFileBytes();
+}
+
+FilterSearchCache::FilterSearchCache()
+    : FilterSearchCache(DEFAULT_MAX_MEMORY, DEFAULT_MIN_MISSES)
+{
+}
+
+FilterSearchCache::FilterSearchCache(size_t maxMemory, uint32_t minMisses)
+    : _mutex(),
+      _maxMemory(maxMemory),
+      _minMisses(minMisses),
+      _entries(maxMemory),
+      _candidates(MAX_CANDIDATES),
+      _hits(0),
+      _misses(0),
+      _invalidations(0)
+{
+}
+
+FilterSearchCache::~FilterSearchCache() = default;
+
+vespalib::string
+FilterSearchCache::makeKey(const vespalib::string &attribute, char termKind, const vespalib::string &term)
+{
+    vespalib::string key;
+    key.reserve(attribute.size() + term.size() + 2);
+    key.append(attribute);
+    key.push_back(':');
+    key.push_back(termKind);
+    key.append(term);
+    return key;
+}
+
+FilterSearchCache::LookupResult
+FilterSearchCache::lookup(const vespalib::string &key, generation_t generation, uint32_t docIdLimit)
+{
+    LockGuard guard(_mutex);
+    Entry::SP *found = _entries.findAndRef(key);
+    if (found != nullptr) {
+        const Entry &entry = **found;
+        if ((entry.generation == generation) && (entry.docIdLimit == docIdLimit)) {
+            ++_hits;
+            return {*found, false};
+        }
+        _entries.remove(key);
+        ++_invalidations;
+    }
+    ++_misses;
+    uint32_t &misses = _candidates[key];
+    if (++misses < _minMisses) {
+        return {Entry::SP(), false};
+    }
+    _candidates.erase(key);
+    return {Entry::SP(), true};
+}
+
+void
+FilterSearchCache::insert(const vespalib::string &key, Entry::SP entry)
+{
+    if (calcSize(key, *entry) > _maxMemory) {
+        return;
+    }
+    LockGuard guard(_mutex);
+    _entries.add(key, std::move(entry));
+}
+
+size_t
+FilterSearchCache::size() const
+{
+    LockGuard guard(_mutex);
+    return _entries.size();
+}
+
+void
+FilterSearchCache::clear()
+{
+    LockGuard guard(_mutex);
+    _invalidations += _entries.size();
+    _entries.removeAll();
+}
+
+vespalib::CacheStats
+FilterSearchCache::getStats() const
+{
+    LockGuard guard(_mutex);
+    return vespalib::CacheStats(_hits, _misses, _entries.size(), _entries.memoryUsed(), _invalidations);
+}
+
+}
@@ -0,0 +1,100 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/cache_stats.h>
+#include <vespa/vespalib/stllike/lrucache_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <memory>
+#include <mutex>
+
+namespace search { class BitVector; }
+namespace search::attribute {
+
+/**
+ * Class that caches the results (as bit vectors) of filter terms searched in attribute vectors.
+ * It is shared by all queries against the attributes of a document db.
+ *
+ * Each entry is tagged with the generation and committed docid limit the attribute vector had when
+ * the lookup preceding the calculation of the result was done. Any change to the attribute vector
+ * bumps its generation, so an entry that no longer matches the attribute vector is dropped on lookup.
+ *
+ * A term must be missed a given number of times before the caller is asked to insert its result,
+ * to avoid calculating full results for terms that are not repeated. Memory used by the cached
+ * bit vectors is bounded by evicting the least recently used entries.
+ */
+class FilterSearchCache {
+public:
+    using BitVectorSP = std::shared_ptr<const BitVector>;
+    using generation_t = uint64_t;
+
+    static constexpr size_t DEFAULT_MAX_MEMORY = 64_Mi;
+    static constexpr uint32_t DEFAULT_MIN_MISSES = 2;
+
+    struct Entry {
+        using SP = std::shared_ptr<const Entry>;
+        BitVectorSP bitVector;
+        generation_t generation;
+        uint32_t docIdLimit;
+        uint32_t hits;
+        Entry(BitVectorSP bitVector_, generation_t generation_, uint32_t docIdLimit_, uint32_t hits_) noexcept
+            : bitVector(std::move(bitVector_)), generation(generation_), docIdLimit(docIdLimit_), hits(hits_) {}
+    };
+
+    struct LookupResult {
+        Entry::SP entry;
+        // Set on a miss when the caller should calculate the result and insert it.
+        bool shouldInsert;
+    };
+
+private:
+    using LockGuard = std::lock_guard<std::mutex>;
+    using CandidateMap = vespalib::lrucache_map<vespalib::LruParam<vespalib::string, uint32_t>>;
+    using EntryParam = vespalib::LruParam<vespalib::string, Entry::SP>;
+
+    class EntryMap : public vespalib::lrucache_map<EntryParam> {
+    public:
+        using value_type = EntryParam::value_type;
+        explicit EntryMap(size_t maxMemory);
+        ~EntryMap() override;
+        size_t memoryUsed() const { return _memoryUsed; }
+        void add(const vespalib::string &key, Entry::SP entry);
+        void remove(const vespalib::string &key);
+        void removeAll();
+    private:
+        bool removeOldest(const value_type &v) override;
+        size_t _maxMemory;
+        size_t _memoryUsed;
+    };
+
+    static size_t calcSize(const vespalib::string &key, const Entry &entry);
+
+    mutable std::mutex _mutex;
+    size_t             _maxMemory;
+    uint32_t           _minMisses;
+    EntryMap           _entries;
+    CandidateMap       _candidates;
+    size_t             _hits;
+    size_t             _misses;
+    size_t             _invalidations;
+
+public:
+    FilterSearchCache();
+    FilterSearchCache(size_t maxMemory, uint32_t minMisses);
+    ~FilterSearchCache();
+
+    static vespalib::string makeKey(const vespalib::string &attribute, char termKind, const vespalib::string &term);
+
+    /**
+     * Look up the cached result for the given key. The entry is only returned if it was calculated
+     * when the attribute vector had the given generation and committed docid limit.
+     */
+    LookupResult lookup(const vespalib::string &key, generation_t generation, uint32_t docIdLimit);
+    void insert(const vespalib::string &key, Entry::SP entry);
+    size_t size() const;
+    void clear();
+    vespalib::CacheStats getStats() const;
+};
+
+}
@@ -11,6 +11,7 @@
 #include <vespa/searchcommon/common/range.h>
 #include <vespa/vespalib/util/regexp.h>
 #include <vespa/vespalib/fuzzy/fuzzy_matcher.h>
+#include <vespa/vespalib/fuzzy/levenshtein_dfa.h>
 #include <regex>
 
 namespace search::attribute {
@@ -61,6 +62,17 @@ protected:
         (void) it;
         return true;
     }
+    /**
+     * Returns whether the dictionary entry at the given iterator should be used, leaving the iterator as is.
+     * Otherwise the iterator is stepped forward, possibly past several entries that cannot be used.
+     */
+    virtual bool use_dictionary_entry(DictionaryConstIterator & it) const {
+        if (useThis(it)) {
+            return true;
+        }
+        ++it;
+        return false;
+    }
 
     float calculateFilteringCost() const {
         // filtering search time (ms) ~ FSTC * numValues; (FSTC =
@@ -183,6 +195,8 @@ private:
     using RegexpUtil = vespalib::RegexpUtil;
     using Parent::_enumStore;
     bool useThis(const PostingListSearchContext::DictionaryConstIterator & it) const override;
+    bool use_dictionary_entry(PostingListSearchContext::DictionaryConstIterator & it) const override;
+    bool use_dfa_dictionary_walk() const;
 public:
     StringPostingSearchContext(BaseSC&& base_sc, bool useBitVector, const AttrT &toBeSearched);
 };
@@ -313,6 +327,38 @@ StringPostingSearchContext<BaseSC, AttrT, DataT>::useThis(const PostingListSearc
     return true;
 }
 
+template <typename BaseSC, typename AttrT, typename DataT>
+bool
+StringPostingSearchContext<BaseSC, AttrT, DataT>::use_dfa_dictionary_walk() const
+{
+    // The successor from the automaton is lowercased, and can only be used to seek
+    // in a dictionary that is ordered by folded values only.
+    return this->isFuzzy() && (this->getDfaFuzzyMatcher() != nullptr) &&
+           !this->isCased() && _enumStore.is_folded();
+}
+
+template <typename BaseSC, typename AttrT, typename DataT>
+bool
+StringPostingSearchContext<BaseSC, AttrT, DataT>::use_dictionary_entry(PostingListSearchContext::DictionaryConstIterator & it) const {
+    if (!use_dfa_dictionary_walk()) {
+        return Parent::use_dictionary_entry(it);
+    }
+    vespalib::string successor;
+    if (this->getDfaFuzzyMatcher()->match(_enumStore.get_value(it.getKey().load_acquire()), successor)) {
+        return true;
+    }
+    if (successor.empty()) {
+        it = this->_upperDictItr;
+    } else {
+        auto comp = _enumStore.make_folded_comparator(successor.c_str());
+        it.seek(vespalib::datastore::AtomicEntryRef(), comp);
+        if ((this->_upperDictItr - it) <= 0) {
+            it = this->_upperDictItr;
+        }
+    }
+    return false;
+}
+
 template <typename BaseSC, typename AttrT, typename DataT>
 NumericPostingSearchContext<BaseSC, AttrT, DataT>::
 NumericPostingSearchContext(BaseSC&& base_sc, const Params & params_in, const AttrT &toBeSearched)
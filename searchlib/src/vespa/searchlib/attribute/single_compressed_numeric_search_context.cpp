@@ -0,0 +1,94 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "single_compressed_numeric_search_context.h"
+#include "attributeiterators.hpp"
+#include <vespa/searchlib/queryeval/emptysearch.h>
+#include <limits>
+
+namespace search::attribute {
+
+namespace {
+
+/*
+ * Strict iterator that finds the next hit using the bit mask of
+ * matching documents for the current block.
+ */
+template <typename SC, typename Parent>
+class CompressedNumericAttributeIteratorStrict : public Parent
+{
+    using Block = CompressedNumericBlock;
+    uint32_t _block_id;
+    uint64_t _block_hits;
+
+    void doSeek(uint32_t docId) override;
+    vespalib::Trinary is_strict() const override { return vespalib::Trinary::True; }
+public:
+    CompressedNumericAttributeIteratorStrict(const SC& concreteSearchCtx, fef::TermFieldMatchData* matchData)
+        : Parent(concreteSearchCtx, matchData),
+          _block_id(std::numeric_limits<uint32_t>::max()),
+          _block_hits(0)
+    {
+    }
+};
+
+template <typename SC, typename Parent>
+void
+CompressedNumericAttributeIteratorStrict<SC, Parent>::doSeek(uint32_t docId)
+{
+    uint32_t end_id = this->getEndId();
+    while (docId < end_id) {
+        uint32_t block_id = docId >> Block::block_shift;
+        if (block_id != _block_id) {
+            _block_hits = this->_concreteSearchCtx.find_block(block_id);
+            _block_id = block_id;
+        }
+        uint64_t hits = _block_hits & (std::numeric_limits<uint64_t>::max() << (docId & Block::block_mask));
+        if (hits != 0) {
+            uint32_t next_id = (block_id << Block::block_shift) + __builtin_ctzl(hits);
+            if (next_id < end_id) {
+                this->setDocId(next_id);
+                return;
+            }
+            break;
+        }
+        docId = (block_id + 1) << Block::block_shift;
+    }
+    this->setAtEnd();
+}
+
+}
+
+template <typename T>
+SingleCompressedNumericSearchContext<T>::SingleCompressedNumericSearchContext(std::unique_ptr<QueryTermSimple> qTerm, const AttributeVector& toBeSearched,
+                                                                              BlocksReadView blocks, T default_value)
+    : NumericSearchContext<NumericRangeMatcher<T>>(toBeSearched, *qTerm, true),
+      _blocks(blocks),
+      _default_value(default_value),
+      _match_default(this->match(default_value))
+{
+}
+
+template <typename T>
+std::unique_ptr<queryeval::SearchIterator>
+SingleCompressedNumericSearchContext<T>::createFilterIterator(fef::TermFieldMatchData* matchData, bool strict)
+{
+    using SC = SingleCompressedNumericSearchContext<T>;
+    if (!this->valid()) {
+        return std::make_unique<queryeval::EmptySearch>();
+    }
+    if (this->getIsFilter()) {
+        return strict
+            ? std::make_unique<CompressedNumericAttributeIteratorStrict<SC, FilterAttributeIteratorT<SC>>>(*this, matchData)
+            : std::make_unique<FilterAttributeIteratorT<SC>>(*this, matchData);
+    }
+    return strict
+        ? std::make_unique<CompressedNumericAttributeIteratorStrict<SC, AttributeIteratorT<SC>>>(*this, matchData)
+        : std::make_unique<AttributeIteratorT<SC>>(*this, matchData);
+}
+
+template class SingleCompressedNumericSearchContext<int8_t>;
+template class SingleCompressedNumericSearchContext<int16_t>;
+template class SingleCompressedNumericSearchContext<int32_t>;
+template class SingleCompressedNumericSearchContext<int64_t>;
+
+}
@@ -0,0 +1,63 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "compressed_numeric_block.h"
+#include "multi_value_mapping_read_view.h"
+#include "numeric_range_matcher.h"
+#include "numeric_search_context.h"
+
+namespace search::attribute {
+
+/*
+ * SingleCompressedNumericSearchContext handles the creation of search iterators for
+ * a query term on a single value compressed numeric attribute vector.
+ *
+ * Strict iterators evaluate the query range for a whole block of
+ * documents at a time.
+ */
+template <typename T>
+class SingleCompressedNumericSearchContext final : public NumericSearchContext<NumericRangeMatcher<T>>
+{
+private:
+    using DocId = ISearchContext::DocId;
+    using Block = CompressedNumericBlock;
+    using BlocksReadView = MultiValueMappingReadView<int64_t>;
+    BlocksReadView _blocks;
+    int64_t        _default_value;
+    bool           _match_default;
+
+    int32_t onFind(DocId docId, int32_t elemId, int32_t& weight) const override {
+        return find(docId, elemId, weight);
+    }
+
+    int32_t onFind(DocId docId, int elemId) const override {
+        return find(docId, elemId);
+    }
+
+public:
+    SingleCompressedNumericSearchContext(std::unique_ptr<QueryTermSimple> qTerm, const AttributeVector& toBeSearched,
+                                         BlocksReadView blocks, T default_value);
+    int32_t find(DocId docId, int32_t elemId, int32_t& weight) const {
+        if ( elemId != 0) return -1;
+        const T v = static_cast<T>(Block::get(_blocks.get(docId >> Block::block_shift), docId & Block::block_mask, _default_value));
+        weight = 1;
+        return this->match(v) ? 0 : -1;
+    }
+
+    int32_t find(DocId docId, int elemId) const {
+        if ( elemId != 0) return -1;
+        const T v = static_cast<T>(Block::get(_blocks.get(docId >> Block::block_shift), docId & Block::block_mask, _default_value));
+        return this->match(v) ? 0 : -1;
+    }
+
+    // Returns bit mask of matching documents in block
+    uint64_t find_block(uint32_t block_id) const {
+        return Block::match(_blocks.get(block_id), this->_low, this->_high, _match_default);
+    }
+
+    std::unique_ptr<queryeval::SearchIterator>
+    createFilterIterator(fef::TermFieldMatchData* matchData, bool strict) override;
+};
+
+}
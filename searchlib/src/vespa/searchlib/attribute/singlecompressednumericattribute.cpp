@@ -0,0 +1,12 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "singlecompressednumericattribute.hpp"
+
+namespace search {
+
+template class SingleValueCompressedNumericAttribute<IntegerAttributeTemplate<int8_t>>;
+template class SingleValueCompressedNumericAttribute<IntegerAttributeTemplate<int16_t>>;
+template class SingleValueCompressedNumericAttribute<IntegerAttributeTemplate<int32_t>>;
+template class SingleValueCompressedNumericAttribute<IntegerAttributeTemplate<int64_t>>;
+
+}
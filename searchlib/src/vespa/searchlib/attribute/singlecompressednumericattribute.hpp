@@ -0,0 +1,272 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "attributevector.hpp"
+#include "load_utils.h"
+#include "primitivereader.h"
+#include "singlecompressednumericattribute.h"
+#include "singlecompressednumericattributesaver.h"
+#include "single_compressed_numeric_search_context.h"
+#include "valuemodifier.h"
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/util/memory_allocator.h>
+
+namespace search {
+
+namespace singlecompressednumericattribute {
+
+constexpr bool enable_free_lists = true;
+
+}
+
+template <typename B>
+SingleValueCompressedNumericAttribute<B>::
+SingleValueCompressedNumericAttribute(const vespalib::string & baseFileName, const AttributeVector::Config & c)
+    : B(baseFileName, c),
+      _blocks(BlockMapping::optimizedConfigForHugePage(Block::max_array_size,
+                                                       vespalib::alloc::MemoryAllocator::HUGEPAGE_SIZE,
+                                                       vespalib::alloc::MemoryAllocator::PAGE_SIZE,
+                                                       8 * 1024,
+                                                       c.getGrowStrategy().getMultiValueAllocGrowFactor(),
+                                                       singlecompressednumericattribute::enable_free_lists),
+              c.getGrowStrategy(), this->get_memory_allocator())
+{ }
+
+template <typename B>
+SingleValueCompressedNumericAttribute<B>::~SingleValueCompressedNumericAttribute()
+{
+    B::getGenerationHolder().reclaim_all();
+}
+
+template <typename B>
+void
+SingleValueCompressedNumericAttribute<B>::onCommit()
+{
+    this->checkSetMaxValueCount(1);
+
+    {
+        // Decode each changed block once, apply updates and publish new blocks
+        typename B::ValueModifier valueGuard(this->getValueModifier());
+        const int64_t default_value = B::defaultValue();
+        vespalib::hash_map<uint32_t, uint32_t> block_slots;
+        std::vector<uint32_t> block_ids;
+        std::vector<int64_t> values;
+        auto value_ref = [&](DocId doc) -> int64_t & {
+            uint32_t block_id = doc >> Block::block_shift;
+            auto itr = block_slots.find(block_id);
+            uint32_t slot;
+            if (itr == block_slots.end()) {
+                slot = block_ids.size();
+                block_slots[block_id] = slot;
+                block_ids.push_back(block_id);
+                values.resize(values.size() + Block::block_size);
+                Block::decode(_blocks.get(block_id), default_value, &values[slot * Block::block_size]);
+            } else {
+                slot = itr->second;
+            }
+            return values[(slot << Block::block_shift) + (doc & Block::block_mask)];
+        };
+        for (const auto & change : this->_changes.getInsertOrder()) {
+            if (change._type == ChangeBase::UPDATE) {
+                T new_value = change._data;
+                value_ref(change._doc) = new_value;
+            } else if (change._type >= ChangeBase::ADD && change._type <= ChangeBase::DIV) {
+                int64_t &value = value_ref(change._doc);
+                value = this->template applyArithmetic<T, typename B::Change::DataType>(static_cast<T>(value), change._data.getArithOperand(), change._type);
+            } else if (change._type == ChangeBase::CLEARDOC) {
+                value_ref(change._doc) = default_value;
+            }
+        }
+        for (uint32_t slot = 0; slot < block_ids.size(); ++slot) {
+            auto block = Block::encode(&values[slot * Block::block_size], default_value);
+            _blocks.set(block_ids[slot], block);
+        }
+    }
+
+    this->reclaim_unused_memory();
+
+    this->_changes.clear();
+    if (_blocks.considerCompact(this->getConfig().getCompactionStrategy())) {
+        this->incGeneration();
+        this->updateStat(true);
+    }
+}
+
+template <typename B>
+void
+SingleValueCompressedNumericAttribute<B>::onUpdateStat()
+{
+    auto& compaction_strategy = this->getConfig().getCompactionStrategy();
+    vespalib::MemoryUsage usage = _blocks.updateStat(compaction_strategy);
+    usage.merge(this->getChangeVectorMemoryUsage());
+    uint32_t num_docs = B::getNumDocs();
+    this->updateStatistics(num_docs, num_docs,
+                           usage.allocatedBytes(), usage.usedBytes(), usage.deadBytes(), usage.allocatedBytesOnHold());
+}
+
+template <typename B>
+void
+SingleValueCompressedNumericAttribute<B>::onAddDocs(DocId lidLimit) {
+    _blocks.reserve(num_blocks(lidLimit));
+}
+
+template <typename B>
+bool
+SingleValueCompressedNumericAttribute<B>::addDoc(DocId & doc) {
+    bool incGen = false;
+    if ((B::getNumDocs() & Block::block_mask) == 0) {
+        // New documents have the default value, i.e. an empty block
+        incGen = _blocks.isFull();
+        uint32_t block_id = 0;
+        _blocks.addDoc(block_id);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    B::incNumDocs();
+    doc = B::getNumDocs() - 1;
+    this->updateUncommittedDocIdLimit(doc);
+    if (incGen) {
+        this->incGeneration();
+    } else
+        this->reclaim_unused_memory();
+    return true;
+}
+
+template <typename B>
+void
+SingleValueCompressedNumericAttribute<B>::reclaim_memory(generation_t oldest_used_gen)
+{
+    _blocks.reclaim_memory(oldest_used_gen);
+    B::getGenerationHolder().reclaim(oldest_used_gen);
+}
+
+template <typename B>
+void
+SingleValueCompressedNumericAttribute<B>::before_inc_generation(generation_t current_gen)
+{
+    _blocks.assign_generation(current_gen);
+    B::getGenerationHolder().assign_generation(current_gen);
+}
+
+template <typename B>
+template <typename ValueReader>
+void
+SingleValueCompressedNumericAttribute<B>::load_blocks(uint32_t num_docs, ValueReader&& next_value)
+{
+    const int64_t default_value = B::defaultValue();
+    int64_t values[Block::block_size];
+    _blocks.prepareLoadFromMultiValue();
+    _blocks.reserve(num_blocks(num_docs));
+    for (uint32_t doc = 0; doc < num_docs; doc += Block::block_size) {
+        uint32_t count = std::min(Block::block_size, num_docs - doc);
+        for (uint32_t i = 0; i < count; ++i) {
+            values[i] = next_value();
+        }
+        std::fill(values + count, values + Block::block_size, default_value);
+        uint32_t block_id = 0;
+        _blocks.addDoc(block_id);
+        auto block = Block::encode(values, default_value);
+        _blocks.set(block_id, block);
+    }
+    _blocks.doneLoadFromMultiValue();
+    B::setNumDocs(num_docs);
+    B::setCommittedDocIdLimit(num_docs);
+}
+
+template <typename B>
+bool
+SingleValueCompressedNumericAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
+{
+    uint32_t numDocs = attrReader.getEnumCount();
+
+    auto udatBuffer = attribute::LoadUtils::loadUDAT(*this);
+    assert((udatBuffer->size() % sizeof(T)) == 0);
+    vespalib::ConstArrayRef<T> map(reinterpret_cast<const T *>(udatBuffer->buffer()),
+                                   udatBuffer->size() / sizeof(T));
+    load_blocks(numDocs, [&attrReader, &map]() -> int64_t {
+        uint32_t enumValue = attrReader.getNextEnum();
+        assert(enumValue < map.size());
+        return map[enumValue];
+    });
+    return true;
+}
+
+
+template <typename B>
+bool
+SingleValueCompressedNumericAttribute<B>::onLoad(vespalib::Executor *)
+{
+    PrimitiveReader<T> attrReader(*this);
+    bool ok(attrReader.getHasLoadData());
+
+    if (!ok)
+        return false;
+
+    this->setCreateSerialNum(attrReader.getCreateSerialNum());
+
+    if (attrReader.getEnumerated())
+        return onLoadEnumerated(attrReader);
+
+    const size_t sz(attrReader.getDataCount());
+    load_blocks(sz, [&attrReader]() -> int64_t { return attrReader.getNextData(); });
+    return true;
+}
+
+template <typename B>
+std::unique_ptr<attribute::SearchContext>
+SingleValueCompressedNumericAttribute<B>::getSearch(QueryTermSimple::UP qTerm,
+                                                    const attribute::SearchContextParams & params) const
+{
+    (void) params;
+    auto blocks = _blocks.make_read_view(num_blocks(this->getCommittedDocIdLimit()));
+    return std::make_unique<attribute::SingleCompressedNumericSearchContext<T>>(std::move(qTerm), *this, blocks, B::defaultValue());
+}
+
+
+template <typename B>
+void
+SingleValueCompressedNumericAttribute<B>::clearDocs(DocId lidLow, DocId lidLimit, bool in_shrink_lid_space)
+{
+    assert(lidLow <= lidLimit);
+    assert(lidLimit <= this->getNumDocs());
+    const T default_value = B::defaultValue();
+    uint32_t count = 0;
+    constexpr uint32_t commit_interval = 1000;
+    for (DocId lid = lidLow; lid < lidLimit; ++lid) {
+        if (getFast(lid) != default_value) {
+            this->clearDoc(lid);
+        }
+        if ((++count % commit_interval) == 0) {
+            if (in_shrink_lid_space) {
+                this->clear_uncommitted_doc_id_limit();
+            }
+            this->commit();
+        }
+    }
+}
+
+template <typename B>
+void
+SingleValueCompressedNumericAttribute<B>::onShrinkLidSpace()
+{
+    uint32_t committedDocIdLimit = this->getCommittedDocIdLimit();
+    uint32_t wanted_blocks = num_blocks(committedDocIdLimit);
+    assert(_blocks.size() >= wanted_blocks);
+    if (wanted_blocks < _blocks.size()) {
+        // Documents above committed docid limit have been cleared
+        _blocks.shrink(wanted_blocks);
+    }
+    this->setNumDocs(committedDocIdLimit);
+}
+
+template <typename B>
+std::unique_ptr<AttributeSaver>
+SingleValueCompressedNumericAttribute<B>::onInitSave(vespalib::stringref fileName)
+{
+    vespalib::GenerationHandler::Guard guard(this->getGenerationHandler().takeGuard());
+    return std::make_unique<SingleValueCompressedNumericAttributeSaver<T>>
+        (std::move(guard), this->createAttributeHeader(fileName), _blocks, B::defaultValue());
+}
+
+}
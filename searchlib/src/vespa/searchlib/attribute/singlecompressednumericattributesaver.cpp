@@ -0,0 +1,56 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "singlecompressednumericattributesaver.h"
+#include "compressed_numeric_block.h"
+#include "iattributesavetarget.h"
+#include <vespa/searchlib/util/bufferwriter.h>
+#include <algorithm>
+
+using search::attribute::CompressedNumericBlock;
+using vespalib::GenerationHandler;
+
+namespace search {
+
+template <typename T>
+SingleValueCompressedNumericAttributeSaver<T>::
+SingleValueCompressedNumericAttributeSaver(GenerationHandler::Guard &&guard,
+                                           const attribute::AttributeHeader &header,
+                                           const BlockMapping &blocks,
+                                           T default_value)
+    : AttributeSaver(std::move(guard), header),
+      _frozen_blocks(blocks.getRefCopy((header.getNumDocs() + CompressedNumericBlock::block_mask) >> CompressedNumericBlock::block_shift)),
+      _blocks(blocks),
+      _num_docs(header.getNumDocs()),
+      _default_value(default_value)
+{
+}
+
+template <typename T>
+SingleValueCompressedNumericAttributeSaver<T>::~SingleValueCompressedNumericAttributeSaver() = default;
+
+template <typename T>
+bool
+SingleValueCompressedNumericAttributeSaver<T>::onSave(IAttributeSaveTarget &saveTarget)
+{
+    std::unique_ptr<BufferWriter> writer(saveTarget.datWriter().allocBufferWriter());
+    int64_t values[CompressedNumericBlock::block_size];
+    T block_values[CompressedNumericBlock::block_size];
+    for (uint32_t block_id = 0; block_id < _frozen_blocks.size(); ++block_id) {
+        CompressedNumericBlock::decode(_blocks.getDataForIdx(_frozen_blocks[block_id]), _default_value, values);
+        uint32_t doc_id = block_id << CompressedNumericBlock::block_shift;
+        uint32_t count = std::min(CompressedNumericBlock::block_size, _num_docs - doc_id);
+        for (uint32_t i = 0; i < count; ++i) {
+            block_values[i] = static_cast<T>(values[i]);
+        }
+        writer->write(block_values, count * sizeof(T));
+    }
+    writer->flush();
+    return true;
+}
+
+template class SingleValueCompressedNumericAttributeSaver<int8_t>;
+template class SingleValueCompressedNumericAttributeSaver<int16_t>;
+template class SingleValueCompressedNumericAttributeSaver<int32_t>;
+template class SingleValueCompressedNumericAttributeSaver<int64_t>;
+
+}  // namespace search
@@ -0,0 +1,38 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "attributesaver.h"
+#include "multi_value_mapping.h"
+
+namespace search {
+
+/*
+ * Class for saving a compressed single value numeric attribute.
+ *
+ * The values are decoded and saved in the same format as for a plain
+ * single value numeric attribute.
+ */
+template <typename T>
+class SingleValueCompressedNumericAttributeSaver : public AttributeSaver
+{
+    using GenerationHandler = vespalib::GenerationHandler;
+    using BlockMapping = attribute::MultiValueMapping<int64_t>;
+    using RefCopyVector = attribute::MultiValueMappingBase::RefCopyVector;
+
+    RefCopyVector       _frozen_blocks;
+    const BlockMapping& _blocks;
+    uint32_t            _num_docs;
+    int64_t             _default_value;
+
+    bool onSave(IAttributeSaveTarget &saveTarget) override;
+public:
+    SingleValueCompressedNumericAttributeSaver(GenerationHandler::Guard &&guard,
+                                               const attribute::AttributeHeader &header,
+                                               const BlockMapping &blocks,
+                                               T default_value);
+
+    ~SingleValueCompressedNumericAttributeSaver() override;
+};
+
+} // namespace search
@@ -30,6 +30,7 @@ protected:
     bool isFuzzy() const { return _helper.isFuzzy(); }
     const vespalib::Regex& getRegex() const { return _helper.getRegex(); }
     const vespalib::FuzzyMatcher& getFuzzyMatcher() const { return _helper.getFuzzyMatcher(); }
+    const vespalib::LevenshteinDfa* getDfaFuzzyMatcher() const { return _helper.getDfaFuzzyMatcher(); }
     const QueryTermUCS4* get_query_term_ptr() const noexcept { return _query_term.get(); }
 };
 
@@ -5,6 +5,7 @@
 #include <vespa/vespalib/text/lowercase.h>
 #include <vespa/vespalib/text/utf8.h>
 #include <vespa/vespalib/fuzzy/fuzzy_matcher.h>
+#include <vespa/vespalib/fuzzy/levenshtein_dfa.h>
 
 
 namespace search::attribute {
@@ -12,6 +13,7 @@ namespace search::attribute {
 StringSearchHelper::StringSearchHelper(QueryTermUCS4 & term, bool cased)
     : _regex(),
       _fuzzyMatcher(),
+      _dfaFuzzyMatcher(),
       _term(),
       _termLen(),
       _isPrefix(term.isPrefix()),
@@ -28,6 +30,12 @@ StringSearchHelper::StringSearchHelper(QueryTermUCS4 & term, bool cased)
                                                                  term.getFuzzyMaxEditDistance(),
                                                                  term.getFuzzyPrefixLength(),
                                                                  isCased());
+        if (vespalib::LevenshteinDfa::supports(term.getFuzzyMaxEditDistance())) {
+            _dfaFuzzyMatcher = std::make_unique<vespalib::LevenshteinDfa>(term.getTerm(),
+                                                                          term.getFuzzyMaxEditDistance(),
+                                                                          term.getFuzzyPrefixLength(),
+                                                                          isCased());
+        }
     } else if (isCased()) {
         _term._char = term.getTerm();
         _termLen = term.getTermLen();
@@ -46,7 +54,9 @@ StringSearchHelper::isMatch(const char *src) const {
         return getRegex().valid() && getRegex().partial_match(std::string_view(src));
     }
     if (__builtin_expect(isFuzzy(), false)) {
-        return getFuzzyMatcher().isMatch(src);
+        return _dfaFuzzyMatcher
+               ? _dfaFuzzyMatcher->is_match(src)
+               : getFuzzyMatcher().isMatch(src);
     }
     if (__builtin_expect(isCased(), false)) {
         int res = strncmp(_term._char, src, _termLen);
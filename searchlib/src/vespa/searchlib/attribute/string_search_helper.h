@@ -5,7 +5,10 @@
 #include <vespa/fastlib/text/unicodeutil.h>
 #include <vespa/vespalib/regex/regex.h>
 
-namespace vespalib { class FuzzyMatcher; }
+namespace vespalib {
+class FuzzyMatcher;
+class LevenshteinDfa;
+}
 namespace search { class QueryTermUCS4; }
 
 namespace search::attribute {
@@ -28,9 +31,12 @@ public:
     bool isFuzzy() const noexcept { return _isFuzzy; }
     const vespalib::Regex & getRegex() const noexcept { return _regex; }
     const vespalib::FuzzyMatcher & getFuzzyMatcher() const noexcept { return *_fuzzyMatcher; }
+    // Only present for fuzzy terms with a max edit distance supported by the automaton.
+    const vespalib::LevenshteinDfa * getDfaFuzzyMatcher() const noexcept { return _dfaFuzzyMatcher.get(); }
 private:
     vespalib::Regex                _regex;
     std::unique_ptr<vespalib::FuzzyMatcher> _fuzzyMatcher;
+    std::unique_ptr<vespalib::LevenshteinDfa> _dfaFuzzyMatcher;
     union {
         const ucs4_t *_ucs4;
         const char   *_char;
@@ -93,7 +93,7 @@ public:
 class TuneFileRandRead
 {
 public:
-    enum TuneControl { NORMAL, DIRECTIO, MMAP };
+    enum TuneControl { NORMAL, DIRECTIO, MMAP, IOURING };
 private:
     TuneControl _tuneControl;
     int         _mmapFlags;
@@ -109,8 +109,10 @@ public:
     void setWantMemoryMap() { _tuneControl = MMAP; }
     void setWantDirectIO()  { _tuneControl = DIRECTIO; }
     void setWantNormal()    { _tuneControl = NORMAL; }
+    void setWantIoUring()   { _tuneControl = IOURING; }
     bool getWantDirectIO()   const { return _tuneControl == DIRECTIO; }
     bool getWantMemoryMap()  const { return _tuneControl == MMAP; }
+    bool getWantIoUring()    const { return _tuneControl == IOURING; }
     int  getMemoryMapFlags() const { return _mmapFlags; }
     int  getAdvise()         const { return _advise; }
 
@@ -3,6 +3,7 @@
 #include "field_merger.h"
 #include "fieldreader.h"
 #include "field_length_scanner.h"
+#include "field_merger_partition.h"
 #include "fusion_input_index.h"
 #include "fusion_output_index.h"
 #include "dictionarywordreader.h"
@@ -45,6 +46,7 @@ constexpr uint32_t renumber_word_ids_merge_chunk = 1000000;
 constexpr uint32_t merge_postings_heap_limit = 4;
 constexpr uint32_t merge_postings_merge_chunk = 50000;
 constexpr uint32_t scan_chunk = 80000;
+constexpr uint64_t merge_postings_partition_min_words = 200000;
 
 vespalib::string
 createTmpPath(const vespalib::string & base, uint32_t index) {
@@ -55,6 +57,15 @@ createTmpPath(const vespalib::string & base, uint32_t index) {
     return os.str();
 }
 
+vespalib::string
+createSegmentPath(const vespalib::string & base, uint32_t partition_id) {
+    vespalib::asciistream os;
+    os << base;
+    os << "/tmpsegment";
+    os << partition_id;
+    return os.str();
+}
+
 }
 
 FieldMerger::FieldMerger(uint32_t id, const FusionOutputIndex& fusion_out_index, std::shared_ptr<IFlushToken> flush_token)
@@ -72,6 +83,8 @@ FieldMerger::FieldMerger(uint32_t id, const FusionOutputIndex& fusion_out_index,
       _heap(),
       _writer(),
       _field_length_scanner(),
+      _partitions(),
+      _active_partitions(0),
       _open_reader_idx(std::numeric_limits<uint32_t>::max()),
       _state(State::MERGE_START),
       _failed(false)
@@ -313,6 +326,19 @@ FieldMerger::scan_element_lengths()
 }
 
 
+void
+FieldMerger::open_field_writer(FieldWriter& writer, const vespalib::string& dir, const FieldLengthInfo& field_length_info)
+{
+    SchemaUtil::IndexIterator index(_fusion_out_index.get_schema(), _id);
+    if (!writer.open(dir + "/", 64, 262144, _fusion_out_index.get_dynamic_k_pos_index_format(),
+                     index.use_interleaved_features(), index.getSchema(),
+                     index.getIndex(),
+                     field_length_info,
+                     _fusion_out_index.get_tune_file_indexing()._write, _fusion_out_index.get_file_header_context())) {
+        throw IllegalArgumentException(make_string("Could not open output posocc + dictionary in %s", dir.c_str()));
+    }
+}
+
 bool
 FieldMerger::open_field_writer()
 {
@@ -320,19 +346,12 @@ FieldMerger::open_field_writer()
     if (!_readers.empty()) {
         field_length_info = _readers.back()->get_field_length_info();
     }
-    SchemaUtil::IndexIterator index(_fusion_out_index.get_schema(), _id);
-    if (!_writer->open(_field_dir + "/", 64, 262144, _fusion_out_index.get_dynamic_k_pos_index_format(),
-                       index.use_interleaved_features(), index.getSchema(),
-                       index.getIndex(),
-                       field_length_info,
-                       _fusion_out_index.get_tune_file_indexing()._write, _fusion_out_index.get_file_header_context())) {
-        throw IllegalArgumentException(make_string("Could not open output posocc + dictionary in %s", _field_dir.c_str()));
-    }
+    open_field_writer(*_writer, _field_dir, field_length_info);
     return true;
 }
 
 bool
-FieldMerger::select_cooked_or_raw_features(FieldReader& reader)
+FieldMerger::select_cooked_or_raw_features(FieldReader& reader, FieldWriter& writer)
 {
     bool rawFormatOK = true;
     bool cookedFormatOK = true;
@@ -345,7 +364,7 @@ FieldMerger::select_cooked_or_raw_features(FieldReader& reader)
         return true;
     }
     {
-        _writer->getFeatureParams(featureParams);
+        writer.getFeatureParams(featureParams);
         cookedFormat = featureParams.getStr("cookedEncoding");
         rawFormat = featureParams.getStr("encoding");
         if (rawFormat == "") {
@@ -395,7 +414,7 @@ FieldMerger::setup_merge_heap()
 {
     _heap = std::make_unique<PostingPriorityQueueMerger<FieldReader, FieldWriter>>();
     for (auto &reader : _readers) {
-        if (!select_cooked_or_raw_features(*reader)) {
+        if (!select_cooked_or_raw_features(*reader, *_writer)) {
             return false;
         }
         if (reader->isValid()) {
@@ -410,6 +429,84 @@ FieldMerger::setup_merge_heap()
     return true;
 }
 
+uint32_t
+FieldMerger::calc_num_partitions() const
+{
+    uint32_t max_partitions = _fusion_out_index.get_max_field_merge_partitions();
+    if (max_partitions <= 1) {
+        return 1;
+    }
+    SchemaUtil::IndexIterator index(_fusion_out_index.get_schema(), _id);
+    for (const auto& oi : _fusion_out_index.get_old_indexes()) {
+        const Schema &oldSchema = oi.getSchema();
+        if (index.hasOldFields(oldSchema) &&
+            (!index.hasMatchingOldFields(oldSchema) ||
+             (index.use_interleaved_features() && !index.has_matching_use_interleaved_features(oldSchema)))) {
+            return 1; // Degraded reader, keep single pass over input
+        }
+    }
+    uint64_t min_words = _fusion_out_index.get_force_small_merge_chunk() ? 1u : merge_postings_partition_min_words;
+    uint64_t num_partitions = std::min(static_cast<uint64_t>(max_partitions), _num_word_ids / min_words);
+    return std::max(num_partitions, static_cast<uint64_t>(1u));
+}
+
+bool
+FieldMerger::open_partition_field_readers(std::vector<std::unique_ptr<FieldReader>>& readers)
+{
+    SchemaUtil::IndexIterator index(_fusion_out_index.get_schema(), _id);
+    for (const auto& oi : _fusion_out_index.get_old_indexes()) {
+        const Schema &oldSchema = oi.getSchema();
+        if (!index.hasOldFields(oldSchema)) {
+            continue; // drop data
+        }
+        readers.push_back(FieldReader::allocFieldReader(index, oldSchema, {}));
+        auto& reader = *readers.back();
+        reader.setup(_word_num_mappings[oi.getIndex()], oi.getDocIdMapping());
+        if (!reader.open(oi.getPath() + "/" + _field_name + "/", _fusion_out_index.get_tune_file_indexing()._read)) {
+            readers.pop_back();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+FieldMerger::setup_partitions(uint32_t num_partitions)
+{
+    FieldLengthInfo field_length_info;
+    if (!_readers.empty()) {
+        field_length_info = _readers.back()->get_field_length_info();
+    }
+    uint32_t merge_chunk = _fusion_out_index.get_force_small_merge_chunk() ? 1u : merge_postings_merge_chunk;
+    _partitions.reserve(num_partitions);
+    for (uint32_t i = 0; i < num_partitions; ++i) {
+        std::vector<std::unique_ptr<FieldReader>> readers;
+        if (i == 0) {
+            readers = std::move(_readers);
+            _readers.clear();
+        } else if (!open_partition_field_readers(readers)) {
+            return false;
+        }
+        uint64_t word_num_begin = 1 + _num_word_ids * i / num_partitions;
+        uint64_t word_num_end = 1 + _num_word_ids * (i + 1) / num_partitions;
+        vespalib::string segment_dir = createSegmentPath(_field_dir, i);
+        std::filesystem::create_directory(std::filesystem::path(segment_dir));
+        auto writer = std::make_unique<FieldWriter>(_fusion_out_index.get_doc_id_limit(), _num_word_ids);
+        open_field_writer(*writer, segment_dir, field_length_info);
+        for (auto& reader : readers) {
+            reader->set_word_num_range(word_num_begin, word_num_end);
+            if (!select_cooked_or_raw_features(*reader, *writer)) {
+                return false;
+            }
+        }
+        _partitions.push_back(std::make_unique<FieldMergerPartition>(segment_dir, std::move(readers), std::move(writer),
+                                                                     merge_postings_heap_limit, merge_chunk));
+    }
+    _active_partitions = num_partitions;
+    LOG(debug, "Merging %u words for field %s in %u partitions", (uint32_t) _num_word_ids, _field_name.c_str(), num_partitions);
+    return true;
+}
+
 void
 FieldMerger::merge_postings_start()
 {
@@ -424,7 +521,14 @@ FieldMerger::merge_postings_start()
 void
 FieldMerger::merge_postings_open_field_readers_done()
 {
-    if (!open_field_writer() || !setup_merge_heap()) {
+    uint32_t num_partitions = calc_num_partitions();
+    if (num_partitions > 1) {
+        if (!setup_partitions(num_partitions) || !open_field_writer()) {
+            merge_postings_failed();
+        } else {
+            _state = State::MERGE_POSTINGS_PARTITIONS;
+        }
+    } else if (!open_field_writer() || !setup_merge_heap()) {
         merge_postings_failed();
     } else {
         _state = State::MERGE_POSTINGS;
@@ -442,6 +546,44 @@ FieldMerger::merge_postings_main()
     }
 }
 
+bool
+FieldMerger::merge_partition(uint32_t partition_id)
+{
+    return _partitions[partition_id]->merge(*_flush_token);
+}
+
+bool
+FieldMerger::partition_done()
+{
+    if (--_active_partitions != 0) {
+        return false;
+    }
+    _state = State::MERGE_POSTINGS_CONCATENATE;
+    return true;
+}
+
+void
+FieldMerger::merge_postings_concatenate()
+{
+    for (auto& partition : _partitions) {
+        if (partition->failed()) {
+            _partitions.clear();
+            merge_postings_failed();
+            return;
+        }
+    }
+    for (auto& partition : _partitions) {
+        if (!_writer->append(partition->get_segment_dir() + "/", _fusion_out_index.get_tune_file_indexing()._read)) {
+            _partitions.clear();
+            merge_postings_failed();
+            return;
+        }
+        std::filesystem::remove_all(std::filesystem::path(partition->get_segment_dir()));
+    }
+    _partitions.clear();
+    _state = State::MERGE_POSTINGS_FINISH;
+}
+
 bool
 FieldMerger::merge_postings_finish()
 {
@@ -553,6 +695,9 @@ FieldMerger::process_merge_field()
     case State::MERGE_POSTINGS:
         merge_postings_main();
         break;
+    case State::MERGE_POSTINGS_CONCATENATE:
+        merge_postings_concatenate();
+        break;
     case State::MERGE_POSTINGS_FINISH:
         merge_field_finish();
         break;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/vespalib/stllike/string.h>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -12,10 +13,13 @@ class IFlushToken;
 template <class Reader, class Writer> class PostingPriorityQueueMerger;
 }
 
+namespace search::index { class FieldLengthInfo; }
+
 namespace search::diskindex {
 
 class DictionaryWordReader;
 class FieldLengthScanner;
+class FieldMergerPartition;
 class FieldReader;
 class FieldWriter;
 class FusionOutputIndex;
@@ -37,6 +41,8 @@ class FieldMerger
         SCAN_ELEMENT_LENGTHS,
         OPEN_POSTINGS_FIELD_READERS_FINISH,
         MERGE_POSTINGS,
+        MERGE_POSTINGS_PARTITIONS,
+        MERGE_POSTINGS_CONCATENATE,
         MERGE_POSTINGS_FINISH,
         MERGE_DONE
     };
@@ -55,6 +61,8 @@ class FieldMerger
     std::unique_ptr<PostingPriorityQueueMerger<FieldReader, FieldWriter>> _heap;
     std::unique_ptr<FieldWriter> _writer;
     std::shared_ptr<FieldLengthScanner> _field_length_scanner;
+    std::vector<std::unique_ptr<FieldMergerPartition>> _partitions;
+    std::atomic<uint32_t> _active_partitions;
     uint32_t _open_reader_idx;
     State _state;
     bool _failed;
@@ -72,8 +80,13 @@ class FieldMerger
     void open_input_field_readers();
     void scan_element_lengths();
     bool open_field_writer();
-    bool select_cooked_or_raw_features(FieldReader& reader);
+    void open_field_writer(FieldWriter& writer, const vespalib::string& dir, const index::FieldLengthInfo& field_length_info);
+    static bool select_cooked_or_raw_features(FieldReader& reader, FieldWriter& writer);
     bool setup_merge_heap();
+    uint32_t calc_num_partitions() const;
+    bool open_partition_field_readers(std::vector<std::unique_ptr<FieldReader>>& readers);
+    bool setup_partitions(uint32_t num_partitions);
+    void merge_postings_concatenate();
     void merge_postings_start();
     void merge_postings_open_field_readers_done();
     void merge_postings_main();
@@ -86,6 +99,10 @@ public:
     void merge_field_finish();
     void process_merge_field(); // Called multiple times
     uint32_t get_id() const noexcept { return _id; }
+    bool merging_partitions() const noexcept { return _state == State::MERGE_POSTINGS_PARTITIONS; }
+    uint32_t get_num_partitions() const noexcept { return _partitions.size(); }
+    bool merge_partition(uint32_t partition_id); // Called multiple times, returns true when partition is done
+    bool partition_done(); // Returns true when all partitions are done
     bool done() const noexcept { return _state == State::MERGE_DONE; }
     bool failed() const noexcept { return _failed; }
 };
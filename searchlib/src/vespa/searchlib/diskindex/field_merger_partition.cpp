@@ -0,0 +1,79 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "field_merger_partition.h"
+#include "fieldreader.h"
+#include "fieldwriter.h"
+#include <vespa/searchlib/common/i_flush_token.h>
+#include <vespa/searchlib/util/posting_priority_queue_merger.hpp>
+
+#include <vespa/log/log.h>
+
+LOG_SETUP(".diskindex.field_merger_partition");
+
+namespace search::diskindex {
+
+FieldMergerPartition::FieldMergerPartition(vespalib::string segment_dir, std::vector<std::unique_ptr<FieldReader>> readers,
+                                           std::unique_ptr<FieldWriter> writer, uint32_t heap_limit, uint32_t merge_chunk)
+    : _segment_dir(std::move(segment_dir)),
+      _readers(std::move(readers)),
+      _heap(),
+      _writer(std::move(writer)),
+      _heap_limit(heap_limit),
+      _merge_chunk(merge_chunk),
+      _failed(false)
+{
+}
+
+FieldMergerPartition::~FieldMergerPartition() = default;
+
+void
+FieldMergerPartition::setup_merge_heap()
+{
+    // Reading the first posting skips all words before the partition
+    _heap = std::make_unique<PostingPriorityQueueMerger<FieldReader, FieldWriter>>();
+    for (auto &reader : _readers) {
+        if (reader->isValid()) {
+            reader->read();
+        }
+        if (reader->isValid()) {
+            _heap->initialAdd(reader.get());
+        }
+    }
+    _heap->setup(_heap_limit);
+    _heap->set_merge_chunk(_merge_chunk);
+}
+
+void
+FieldMergerPartition::close()
+{
+    _heap.reset();
+    for (auto &reader : _readers) {
+        if (!reader->close()) {
+            _failed = true;
+        }
+    }
+    _readers.clear();
+    if (!_writer->close()) {
+        LOG(error, "Could not close output posocc + dictionary in %s", _segment_dir.c_str());
+        _failed = true;
+    }
+    _writer.reset();
+}
+
+bool
+FieldMergerPartition::merge(const IFlushToken& flush_token)
+{
+    if (!_heap) {
+        setup_merge_heap();
+    }
+    _heap->merge(*_writer, flush_token);
+    if (flush_token.stop_requested()) {
+        _failed = true;
+    } else if (!_heap->empty()) {
+        return false;
+    }
+    close();
+    return true;
+}
+
+}
@@ -0,0 +1,47 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace search {
+class IFlushToken;
+template <class Reader, class Writer> class PostingPriorityQueueMerger;
+}
+
+namespace search::diskindex {
+
+class FieldReader;
+class FieldWriter;
+
+/*
+ * Class for merging posting lists for a range of words in a single
+ * field during fusion. The posting lists for a large field are split
+ * into multiple partitions that are merged in parallel to separate
+ * segments, which are then concatenated by FieldMerger.
+ */
+class FieldMergerPartition
+{
+    vespalib::string _segment_dir;
+    std::vector<std::unique_ptr<FieldReader>> _readers;
+    std::unique_ptr<PostingPriorityQueueMerger<FieldReader, FieldWriter>> _heap;
+    std::unique_ptr<FieldWriter> _writer;
+    uint32_t _heap_limit;
+    uint32_t _merge_chunk;
+    bool _failed;
+
+    void setup_merge_heap();
+    void close();
+public:
+    FieldMergerPartition(vespalib::string segment_dir, std::vector<std::unique_ptr<FieldReader>> readers,
+                         std::unique_ptr<FieldWriter> writer, uint32_t heap_limit, uint32_t merge_chunk);
+    ~FieldMergerPartition();
+    bool merge(const IFlushToken& flush_token); // Called multiple times, returns true when done
+    const vespalib::string& get_segment_dir() const noexcept { return _segment_dir; }
+    bool failed() const noexcept { return _failed; }
+};
+
+}
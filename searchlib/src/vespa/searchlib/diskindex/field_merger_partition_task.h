@@ -0,0 +1,32 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/threadexecutor.h>
+
+namespace search::diskindex {
+
+class FieldMerger;
+class FieldMergersState;
+
+/*
+ * Task for processing a portion of a field merge partition.
+ */
+class FieldMergerPartitionTask : public vespalib::Executor::Task
+{
+    FieldMerger&       _field_merger;
+    uint32_t           _partition_id;
+    FieldMergersState& _field_mergers_state;
+
+    void run() override;
+public:
+    FieldMergerPartitionTask(FieldMerger& field_merger, uint32_t partition_id, FieldMergersState& field_mergers_state)
+        : vespalib::Executor::Task(),
+          _field_merger(field_merger),
+          _partition_id(partition_id),
+          _field_mergers_state(field_mergers_state)
+    {
+    }
+};
+
+}
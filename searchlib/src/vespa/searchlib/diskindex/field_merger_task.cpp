@@ -14,6 +14,8 @@ FieldMergerTask::run()
         _field_mergers_state.field_merger_done(_field_merger, true);
     } else if (_field_merger.done()) {
         _field_mergers_state.field_merger_done(_field_merger, false);
+    } else if (_field_merger.merging_partitions()) {
+        _field_mergers_state.schedule_partition_tasks(_field_merger);
     } else {
         _field_mergers_state.schedule_task(_field_merger);
     }
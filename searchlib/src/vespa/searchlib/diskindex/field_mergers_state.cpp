@@ -3,6 +3,7 @@
 #include "field_mergers_state.h"
 #include "field_merger.h"
 #include "field_merger_task.h"
+#include "field_merger_partition_task.h"
 #include "fusion_output_index.h"
 #include <vespa/searchcommon/common/schema.h>
 #include <vespa/vespalib/util/cpu_usage.h>
@@ -74,4 +75,22 @@ FieldMergersState::schedule_task(FieldMerger& field_merger)
     assert(!rejected);
 }
 
+void
+FieldMergersState::schedule_partition_task(FieldMerger& field_merger, uint32_t partition_id)
+{
+    auto task = std::make_unique<FieldMergerPartitionTask>(field_merger, partition_id, *this);
+    auto rejected = _executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::COMPACT));
+    assert(!rejected);
+}
+
+void
+FieldMergersState::schedule_partition_tasks(FieldMerger& field_merger)
+{
+    // Partition tasks might finish the merge before the loop completes
+    uint32_t num_partitions = field_merger.get_num_partitions();
+    for (uint32_t partition_id = 0; partition_id < num_partitions; ++partition_id) {
+        schedule_partition_task(field_merger, partition_id);
+    }
+}
+
 }
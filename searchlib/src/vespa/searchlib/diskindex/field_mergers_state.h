@@ -34,6 +34,8 @@ public:
     void field_merger_done(FieldMerger& field_merger, bool failed);
     void wait_field_mergers_done();
     void schedule_task(FieldMerger& field_merger);
+    void schedule_partition_task(FieldMerger& field_merger, uint32_t partition_id);
+    void schedule_partition_tasks(FieldMerger& field_merger);
     uint32_t get_failed() const noexcept { return _failed; }
 };
 
@@ -38,6 +38,9 @@ FieldReader::FieldReader()
       _wordNumMapper(),
       _docIdMapper(),
       _oldWordNum(noWordNumHigh()),
+      _word_num_begin(noWordNum()),
+      _word_num_end(noWordNumHigh()),
+      _skip_bit_length(0u),
       _residue(0u),
       _docIdLimit(0u),
       _word()
@@ -53,14 +56,30 @@ FieldReader::readCounts()
 {
     PostingListCounts counts;
     _dictFile->readWord(_word, _oldWordNum, counts);
-    _oldposoccfile->readCounts(counts);
     if (_oldWordNum != noWordNumHigh()) {
         _wordNum = _wordNumMapper.map(_oldWordNum);
         assert(_wordNum != noWordNum());
         assert(_wordNum != noWordNumHigh());
+        if (__builtin_expect(_wordNum < _word_num_begin, false)) {
+            _skip_bit_length += counts._bitLength;
+            _residue = 0;
+            return;
+        }
+        if (__builtin_expect(_wordNum >= _word_num_end, false)) {
+            _wordNum = noWordNumHigh();
+            _residue = 0;
+            return;
+        }
+        if (__builtin_expect(_skip_bit_length != 0, false)) {
+            _oldposoccfile->skip_posting_lists(_skip_bit_length);
+            _skip_bit_length = 0;
+        }
+        _oldposoccfile->readCounts(counts);
         _residue = counts._numDocs;
-    } else
+    } else {
+        _oldposoccfile->readCounts(counts);
         _wordNum = _oldWordNum;
+    }
 }
 
 
@@ -118,6 +137,12 @@ FieldReader::setup(const WordNumMapping &wordNumMapping,
     _docIdMapper.setup(docIdMapping);
 }
 
+void
+FieldReader::set_word_num_range(uint64_t begin, uint64_t end)
+{
+    _word_num_begin = begin;
+    _word_num_end = end;
+}
 
 bool
 FieldReader::open(const vespalib::string &prefix,
@@ -48,6 +48,9 @@ protected:
     WordNumMapper _wordNumMapper;
     DocIdMapper _docIdMapper;
     uint64_t _oldWordNum;
+    uint64_t _word_num_begin;
+    uint64_t _word_num_end;
+    uint64_t _skip_bit_length; // Posting lists for skipped words, not yet skipped in posting file
     uint32_t _residue;
     uint32_t _docIdLimit;
     vespalib::string _word;
@@ -91,6 +94,12 @@ public:
     }
 
     virtual void setup(const WordNumMapping &wordNumMapping, const DocIdMapping &docIdMapping);
+    /*
+     * Limit reader to words with (mapped) word numbers in the range
+     * [begin, end). Posting lists for words before the range are
+     * skipped without being decoded.
+     */
+    void set_word_num_range(uint64_t begin, uint64_t end);
     virtual bool open(const vespalib::string &prefix, const TuneFileSeqRead &tuneFileRead);
     virtual bool close();
     virtual void setFeatureParams(const PostingListParams &params);
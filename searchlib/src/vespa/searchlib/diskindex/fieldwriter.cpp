@@ -1,10 +1,13 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "fieldwriter.h"
+#include "bitvectordictionary.h"
 #include "zcposocc.h"
 #include "extposocc.h"
 #include "pagedict4file.h"
+#include <vespa/searchlib/index/schemautil.h>
 #include <vespa/vespalib/util/error.h>
+#include <limits>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".diskindex.fieldwriter");
@@ -64,6 +67,14 @@ FieldWriter::open(const vespalib::string &prefix,
     }
     if (encode_interleaved_features) {
         params.set("interleaved_features", encode_interleaved_features);
+        // Block max num occs is cheap to store when num occs is already interleaved with the doc ids,
+        // but readers not knowing the "block_max" tag can not decode the skip info, hence opt-in.
+        if (schema.getIndexField(indexId).use_block_max()) {
+            params.set("block_max", true);
+        }
+    }
+    if (schema.getIndexField(indexId).use_packed_doc_ids()) {
+        params.set("packed_doc_ids", true);
     }
     
     _dictFile = std::make_unique<PageDict4FileSeqWrite>();
@@ -111,7 +122,7 @@ FieldWriter::flush()
     } else {
         assert(counts._bitLength == 0);
         assert(_bvc.empty());
-        assert(_compactWordNum == 0);
+        assert(_wordNum == noWordNum());
     }
 }
 
@@ -134,6 +145,58 @@ FieldWriter::newWord(vespalib::stringref word)
     newWord(_wordNum + 1, word);
 }
 
+bool
+FieldWriter::append(const vespalib::string &segment_prefix, const TuneFileSeqRead &tuneFileRead)
+{
+    flush();
+    _wordNum = noWordNum();
+    vespalib::string name = segment_prefix + "posocc.dat.compressed";
+    vespalib::string cname = segment_prefix + "dictionary";
+    PageDict4FileSeqRead dictFile;
+    PostingListParams featureParams;
+    auto posoccfile = makePosOccRead(name, &dictFile, featureParams, tuneFileRead);
+    if (!dictFile.open(cname, tuneFileRead)) {
+        LOG(error, "Could not open posocc count file %s for read", cname.c_str());
+        return false;
+    }
+    if (!posoccfile || !posoccfile->open(name, tuneFileRead)) {
+        LOG(error, "Could not open posocc file %s for read", name.c_str());
+        return false;
+    }
+    BitVectorDictionary bitVectors;
+    if (!bitVectors.open(segment_prefix, TuneFileRandRead(), BitVectorKeyScope::PERFIELD_WORDS)) {
+        LOG(error, "Could not open bit vectors with prefix %s for read", segment_prefix.c_str());
+        return false;
+    }
+    auto bv_itr = bitVectors.getEntries().begin();
+    auto bv_end = bitVectors.getEntries().end();
+    vespalib::string word;
+    uint64_t wordNum = noWordNum();
+    PostingListCounts counts;
+    for (;;) {
+        dictFile.readWord(word, wordNum, counts);
+        if (wordNum == std::numeric_limits<uint64_t>::max()) {
+            break;
+        }
+        _posoccfile->copy_posting_list(*posoccfile, counts);
+        _dictFile->writeWord(word, counts);
+        ++_compactWordNum;
+        if (bv_itr != bv_end && bv_itr->_wordNum == wordNum) {
+            auto bv = bitVectors.lookup(wordNum);
+            assert(bv);
+            _bmapfile.addWordSingle(_compactWordNum, *bv);
+            ++bv_itr;
+        }
+    }
+    assert(bv_itr == bv_end);
+    bool ret = posoccfile->close();
+    ret &= dictFile.close();
+    if (!ret) {
+        LOG(error, "Could not close segment files with prefix %s", segment_prefix.c_str());
+    }
+    return ret;
+}
+
 bool
 FieldWriter::close()
 {
@@ -76,6 +76,15 @@ public:
               const TuneFileSeqWrite &tuneFileWrite,
               const search::common::FileHeaderContext &fileHeaderContext);
 
+    /*
+     * Append all words in the dictionary, posting list and bitvector
+     * files with the given prefix, written by another field writer with
+     * the same parameters. Used to concatenate segments of a field that
+     * have been merged in parallel. Words must follow the words already
+     * written.
+     */
+    bool append(const vespalib::string &segment_prefix, const TuneFileSeqRead &tuneFileRead);
+
     bool close();
 
     void setFeatureParams(const PostingListParams &params);
@@ -43,6 +43,8 @@ public:
     ~Fusion();
     void set_dynamic_k_pos_index_format(bool dynamic_k_pos_index_format) { _fusion_out_index.set_dynamic_k_pos_index_format(dynamic_k_pos_index_format); }
     void set_force_small_merge_chunk(bool force_small_merge_chunk) { _fusion_out_index.set_force_small_merge_chunk(force_small_merge_chunk); }
+    // Max number of word ranges that the posting lists for a large field are split into and merged in parallel
+    void set_max_field_merge_partitions(uint32_t max_field_merge_partitions) { _fusion_out_index.set_max_field_merge_partitions(max_field_merge_partitions); }
     bool merge(vespalib::Executor& shared_executor, std::shared_ptr<IFlushToken> flush_token);
 };
 
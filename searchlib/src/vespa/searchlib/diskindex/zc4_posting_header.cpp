@@ -48,4 +48,34 @@ Zc4PostingHeader::read(bitcompression::DecodeContext64Base &decode_context, cons
     _has_more = has_more;
 }
 
+template <bool bigEndian>
+void
+Zc4PostingHeader::write(bitcompression::FeatureEncodeContext<bigEndian> &encode_context, const Zc4PostingParams &params) const
+{
+    auto &e = encode_context;
+    e.encodeExpGolomb(_num_docs - 1, K_VALUE_ZCPOSTING_NUMDOCS);
+    if (_num_docs >= params._min_chunk_docs) {
+        e.writeBits((_has_more ? 1 : 0), 1);
+    }
+    e.encodeExpGolomb(_doc_ids_size - 1, K_VALUE_ZCPOSTING_DOCIDSSIZE);
+    e.encodeExpGolomb(_l1_skip_size, K_VALUE_ZCPOSTING_L1SKIPSIZE);
+    if (_l1_skip_size != 0) {
+        e.encodeExpGolomb(_l2_skip_size, K_VALUE_ZCPOSTING_L2SKIPSIZE);
+        if (_l2_skip_size != 0) {
+            e.encodeExpGolomb(_l3_skip_size, K_VALUE_ZCPOSTING_L3SKIPSIZE);
+            if (_l3_skip_size != 0) {
+                e.encodeExpGolomb(_l4_skip_size, K_VALUE_ZCPOSTING_L4SKIPSIZE);
+            }
+        }
+    }
+    if (params._encode_features) {
+        e.encodeExpGolomb(_features_size, K_VALUE_ZCPOSTING_FEATURESSIZE);
+    }
+    e.encodeExpGolomb(params._doc_id_limit - 1 - _last_doc_id, _doc_id_k);
+    e.smallAlign(8);    // Byte align
+}
+
+template void Zc4PostingHeader::write<false>(bitcompression::FeatureEncodeContext<false> &, const Zc4PostingParams &) const;
+template void Zc4PostingHeader::write<true>(bitcompression::FeatureEncodeContext<true> &, const Zc4PostingParams &) const;
+
 }
@@ -4,7 +4,10 @@
 
 #include <cstdint>
 
-namespace search::bitcompression { class DecodeContext64Base; }
+namespace search::bitcompression {
+class DecodeContext64Base;
+template <bool bigEndian> class FeatureEncodeContext;
+}
 
 namespace search::diskindex {
 
@@ -29,6 +32,14 @@ struct Zc4PostingHeader {
 
     void
     read(bitcompression::DecodeContext64Base &decode_context, const Zc4PostingParams &params);
+
+    /*
+     * Write header for a word or chunk with skip info, including the
+     * padding to byte alignment. _doc_id_k must already be set.
+     */
+    template <bool bigEndian>
+    void
+    write(bitcompression::FeatureEncodeContext<bigEndian> &encode_context, const Zc4PostingParams &params) const;
 };
 
 }
@@ -16,14 +16,18 @@ struct Zc4PostingParams {
     bool     _dynamic_k;
     bool     _encode_features;
     bool     _encode_interleaved_features;
+    bool     _encode_block_max; // Max num occs per skip block, requires interleaved features
+    bool     _encode_packed_doc_ids; // Bit packed blocks of doc ids (and interleaved features)
 
-    Zc4PostingParams(uint32_t min_skip_docs, uint32_t min_chunk_docs, uint32_t doc_id_limit, bool dynamic_k, bool encode_features, bool encode_interleaved_features)
+    Zc4PostingParams(uint32_t min_skip_docs, uint32_t min_chunk_docs, uint32_t doc_id_limit, bool dynamic_k, bool encode_features, bool encode_interleaved_features, bool encode_block_max = false, bool encode_packed_doc_ids = false)
         : _min_skip_docs(min_skip_docs),
           _min_chunk_docs(min_chunk_docs),
           _doc_id_limit(doc_id_limit),
           _dynamic_k(dynamic_k),
           _encode_features(encode_features),
-          _encode_interleaved_features(encode_interleaved_features)
+          _encode_interleaved_features(encode_interleaved_features),
+          _encode_block_max(encode_block_max),
+          _encode_packed_doc_ids(encode_packed_doc_ids)
     {
     }
 };
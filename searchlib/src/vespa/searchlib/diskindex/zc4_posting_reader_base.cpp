@@ -3,6 +3,7 @@
 #include "zc4_posting_reader_base.h"
 #include "zc4_posting_header.h"
 #include <vespa/searchlib/index/docidandfeatures.h>
+#include <limits>
 
 namespace search::diskindex {
 
@@ -44,15 +45,30 @@ Zc4PostingReaderBase::NoSkipBase::check_end(uint32_t last_doc_id)
 Zc4PostingReaderBase::NoSkip::NoSkip()
     : NoSkipBase(),
       _field_length(1),
-      _num_occs(1)
+      _num_occs(1),
+      _packed_block()
 {
 }
 
 Zc4PostingReaderBase::NoSkip::~NoSkip() = default;
 
 void
-Zc4PostingReaderBase::NoSkip::read(bool decode_interleaved_features)
+Zc4PostingReaderBase::NoSkip::read(bool decode_interleaved_features, bool decode_packed_doc_ids)
 {
+    if (decode_packed_doc_ids) {
+        if (_packed_block.at_end()) {
+            assert(_zc_buf._valI < _zc_buf._valE);
+            const uint8_t *block_end = _packed_block.decode(_zc_buf._valI, _doc_id, decode_interleaved_features);
+            _zc_buf._valI += (block_end - _zc_buf._valI);
+            _doc_id_pos = _zc_buf.pos();
+        }
+        _doc_id = _packed_block.next_doc_id();
+        if (decode_interleaved_features) {
+            _field_length = _packed_block.get_field_length();
+            _num_occs = _packed_block.get_num_occs();
+        }
+        return;
+    }
     assert(_zc_buf._valI < _zc_buf._valE);
     _doc_id += (_zc_buf.decode()+ 1);
     if (decode_interleaved_features) {
@@ -66,22 +82,25 @@ void
 Zc4PostingReaderBase::NoSkip::check_not_end(uint32_t last_doc_id)
 {
     assert(_doc_id < last_doc_id);
-    assert(_zc_buf._valI < _zc_buf._valE);
+    assert(_zc_buf._valI < _zc_buf._valE || !_packed_block.at_end());
 }
 
 Zc4PostingReaderBase::L1Skip::L1Skip()
     : NoSkipBase(),
-      _l1_skip_pos(0)
+      _l1_skip_pos(0),
+      _block_max_num_occs(std::numeric_limits<uint32_t>::max())
 {
 }
 
 void
-Zc4PostingReaderBase::L1Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id)
+Zc4PostingReaderBase::L1Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max)
 {
     NoSkipBase::setup(decode_context, size, doc_id);
     _l1_skip_pos = 0;
+    // No upper bound unless the skip table has block max info
+    _block_max_num_occs = std::numeric_limits<uint32_t>::max();
     if (size != 0) {
-        next_skip_entry();
+        next_skip_entry(decode_block_max);
     } else {
         _doc_id = last_doc_id;
     }
@@ -103,9 +122,19 @@ Zc4PostingReaderBase::L1Skip::check(const NoSkipBase &no_skip, bool top_level, b
 }
 
 void
-Zc4PostingReaderBase::L1Skip::next_skip_entry()
+Zc4PostingReaderBase::L1Skip::check_block_max(const NoSkip &no_skip) const
+{
+    assert(no_skip.get_doc_id() <= _doc_id);
+    assert(no_skip.get_num_occs() <= _block_max_num_occs);
+}
+
+void
+Zc4PostingReaderBase::L1Skip::next_skip_entry(bool decode_block_max)
 {
     _doc_id += (_zc_buf.decode() + 1);
+    if (decode_block_max) {
+        _block_max_num_occs = _zc_buf.decode() + 1;
+    }
 }
 
 Zc4PostingReaderBase::L2Skip::L2Skip()
@@ -115,9 +144,9 @@ Zc4PostingReaderBase::L2Skip::L2Skip()
 }
 
 void
-Zc4PostingReaderBase::L2Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id)
+Zc4PostingReaderBase::L2Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max)
 {
-    L1Skip::setup(decode_context, size, doc_id, last_doc_id);
+    L1Skip::setup(decode_context, size, doc_id, last_doc_id, decode_block_max);
     _l2_skip_pos = 0;
 }
 
@@ -139,9 +168,9 @@ Zc4PostingReaderBase::L3Skip::L3Skip()
 }
 
 void
-Zc4PostingReaderBase::L3Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id)
+Zc4PostingReaderBase::L3Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max)
 {
-    L2Skip::setup(decode_context, size, doc_id, last_doc_id);
+    L2Skip::setup(decode_context, size, doc_id, last_doc_id, decode_block_max);
     _l3_skip_pos = 0;
 }
 
@@ -162,9 +191,9 @@ Zc4PostingReaderBase::L4Skip::L4Skip()
 }
 
 void
-Zc4PostingReaderBase::L4Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id)
+Zc4PostingReaderBase::L4Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max)
 {
-    L3Skip::setup(decode_context, size, doc_id, last_doc_id);
+    L3Skip::setup(decode_context, size, doc_id, last_doc_id, decode_block_max);
 }
 
 void
@@ -201,6 +230,7 @@ Zc4PostingReaderBase::~Zc4PostingReaderBase()
 void
 Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_context)
 {
+    bool decode_block_max = _posting_params._encode_block_max;
     // Split docid & features.
     if (_no_skip.get_doc_id() >= _l1_skip.get_doc_id()) {
         _no_skip.set_features_pos(decode_context.getReadOffset());
@@ -211,15 +241,21 @@ Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_contex
                 _l3_skip.check(_l2_skip, true, _posting_params._encode_features);
                 if (_no_skip.get_doc_id() >= _l4_skip.get_doc_id()) {
                     _l4_skip.check(_l3_skip, _posting_params._encode_features);
-                    _l4_skip.next_skip_entry();
+                    _l4_skip.next_skip_entry(decode_block_max);
                 }
-                _l3_skip.next_skip_entry();
+                _l3_skip.next_skip_entry(decode_block_max);
             }
-            _l2_skip.next_skip_entry();
+            _l2_skip.next_skip_entry(decode_block_max);
         }
-        _l1_skip.next_skip_entry();
+        _l1_skip.next_skip_entry(decode_block_max);
+    }
+    _no_skip.read(_posting_params._encode_interleaved_features, _posting_params._encode_packed_doc_ids);
+    if (decode_block_max) {
+        _l1_skip.check_block_max(_no_skip);
+        _l2_skip.check_block_max(_no_skip);
+        _l3_skip.check_block_max(_no_skip);
+        _l4_skip.check_block_max(_no_skip);
     }
-    _no_skip.read(_posting_params._encode_interleaved_features);
     if (_residue == 1) {
         _no_skip.check_end(_last_doc_id);
         _l1_skip.check_end(_last_doc_id);
@@ -249,10 +285,10 @@ Zc4PostingReaderBase::read_word_start_with_skip(DecodeContext64Base &decode_cont
     }
     uint32_t prev_doc_id = _no_skip.get_doc_id();
     _no_skip.setup(decode_context, header._doc_ids_size, prev_doc_id);
-    _l1_skip.setup(decode_context, header._l1_skip_size, prev_doc_id, _last_doc_id);
-    _l2_skip.setup(decode_context, header._l2_skip_size, prev_doc_id, _last_doc_id);
-    _l3_skip.setup(decode_context, header._l3_skip_size, prev_doc_id, _last_doc_id);
-    _l4_skip.setup(decode_context, header._l4_skip_size, prev_doc_id, _last_doc_id);
+    _l1_skip.setup(decode_context, header._l1_skip_size, prev_doc_id, _last_doc_id, _posting_params._encode_block_max);
+    _l2_skip.setup(decode_context, header._l2_skip_size, prev_doc_id, _last_doc_id, _posting_params._encode_block_max);
+    _l3_skip.setup(decode_context, header._l3_skip_size, prev_doc_id, _last_doc_id, _posting_params._encode_block_max);
+    _l4_skip.setup(decode_context, header._l4_skip_size, prev_doc_id, _last_doc_id, _posting_params._encode_block_max);
     if (_has_more || has_more) {
         assert(_last_doc_id == _counts._segments[_chunkNo]._lastDoc);
     }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "zc4_posting_params.h"
+#include "zc_packed_block.h"
 #include "zcbuf.h"
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/index/postinglistcounts.h>
@@ -42,10 +43,11 @@ protected:
     protected:
         uint32_t _field_length;
         uint32_t _num_occs;
+        ZcPackedBlock _packed_block;
     public:
         NoSkip();
         ~NoSkip();
-        void read(bool decode_interleaved_features);
+        void read(bool decode_interleaved_features, bool decode_packed_doc_ids);
         void check_not_end(uint32_t last_doc_id);
         uint32_t get_field_length() const { return _field_length; }
         uint32_t get_num_occs()     const { return _num_occs; }
@@ -56,11 +58,13 @@ protected:
     class L1Skip : public NoSkipBase {
     protected:
         uint32_t _l1_skip_pos;
+        uint32_t _block_max_num_occs;
     public:
         L1Skip();
-        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id);
+        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max);
         void check(const NoSkipBase &no_skip, bool top_level, bool decode_features);
-        void next_skip_entry();
+        void check_block_max(const NoSkip &no_skip) const;
+        void next_skip_entry(bool decode_block_max);
         uint32_t get_l1_skip_pos() const { return _l1_skip_pos; }
     };
     class L2Skip : public L1Skip
@@ -69,7 +73,7 @@ protected:
         uint32_t _l2_skip_pos;
     public:
         L2Skip();
-        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id);
+        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max);
         void check(const L1Skip &l1_skip, bool top_level, bool decode_features);
         uint32_t get_l2_skip_pos() const { return _l2_skip_pos; }
     };
@@ -79,7 +83,7 @@ protected:
         uint32_t _l3_skip_pos;
     public:
         L3Skip();
-        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id);
+        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max);
         void check(const L2Skip &l2_skip, bool top_level, bool decode_features);
         uint32_t get_l3_skip_pos() const { return _l3_skip_pos; }
     };
@@ -87,7 +91,7 @@ protected:
     {
     public:
         L4Skip();
-        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id);
+        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max);
         void check(const L3Skip &l3_skip, bool decode_features);
     };
     uint32_t _doc_id_k;
@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "zc4_posting_writer.h"
+#include "zc4_posting_header.h"
 #include <vespa/searchlib/index/docidandfeatures.h>
 #include <vespa/searchlib/index/postinglistcounts.h>
 
@@ -47,48 +48,32 @@ Zc4PostingWriter<bigEndian>::flush_word_with_skip(bool hasMore)
 
     uint32_t numDocs = _docIds.size();
 
-    e.encodeExpGolomb(numDocs - 1, K_VALUE_ZCPOSTING_NUMDOCS);
-    if (numDocs >= _minChunkDocs) {
-        e.writeBits((hasMore ? 1 : 0), 1);
-    }
-
     calc_skip_info(_encode_features != nullptr);
 
-    uint32_t docIdsSize = _zcDocIds.size();
-    uint32_t l1SkipSize = _l1Skip.size();
-    uint32_t l2SkipSize = _l2Skip.size();
-    uint32_t l3SkipSize = _l3Skip.size();
-    uint32_t l4SkipSize = _l4Skip.size();
-
-    e.encodeExpGolomb(docIdsSize - 1, K_VALUE_ZCPOSTING_DOCIDSSIZE);
-    e.encodeExpGolomb(l1SkipSize, K_VALUE_ZCPOSTING_L1SKIPSIZE);
-    if (l1SkipSize != 0) {
-        e.encodeExpGolomb(l2SkipSize, K_VALUE_ZCPOSTING_L2SKIPSIZE);
-        if (l2SkipSize != 0) {
-            e.encodeExpGolomb(l3SkipSize, K_VALUE_ZCPOSTING_L3SKIPSIZE);
-            if (l3SkipSize != 0) {
-                e.encodeExpGolomb(l4SkipSize, K_VALUE_ZCPOSTING_L4SKIPSIZE);
-            }
-        }
-    }
-    if (_encode_features != nullptr) {
-        e.encodeExpGolomb(_featureOffset, K_VALUE_ZCPOSTING_FEATURESSIZE);
-    }
-
+    Zc4PostingHeader header;
+    header._has_more = hasMore;
+    header._num_docs = numDocs;
+    header._doc_ids_size = _zcDocIds.size();
+    header._l1_skip_size = _l1Skip.size();
+    header._l2_skip_size = _l2Skip.size();
+    header._l3_skip_size = _l3Skip.size();
+    header._l4_skip_size = _l4Skip.size();
+    header._features_size = _featureOffset;
+    header._last_doc_id = _docIds.back()._doc_id;
     // Encode last document id in chunk or word.
     if (_dynamicK) {
-        uint32_t docIdK = e.calcDocIdK((_counts._segments.empty() &&
-                                        !hasMore) ?
-                                       numDocs : 1,
-                                       _docIdLimit);
-        e.encodeExpGolomb(_docIdLimit - 1 - _docIds.back()._doc_id,
-                          docIdK);
-    } else {
-        e.encodeExpGolomb(_docIdLimit - 1 - _docIds.back()._doc_id,
-                          K_VALUE_ZCPOSTING_LASTDOCID);
+        header._doc_id_k = e.calcDocIdK((_counts._segments.empty() &&
+                                         !hasMore) ?
+                                        numDocs : 1,
+                                        _docIdLimit);
     }
+    header.write(e, get_posting_params());
 
-    e.smallAlign(8);    // Byte align
+    uint32_t docIdsSize = header._doc_ids_size;
+    uint32_t l1SkipSize = header._l1_skip_size;
+    uint32_t l2SkipSize = header._l2_skip_size;
+    uint32_t l3SkipSize = header._l3_skip_size;
+    uint32_t l4SkipSize = header._l4_skip_size;
 
     uint8_t *docIds = _zcDocIds._mallocStart;
     e.writeBits(reinterpret_cast<const uint64_t *>(docIds),
@@ -224,6 +209,47 @@ Zc4PostingWriter<bigEndian>::flush_word()
     _writePos = writePos;
 }
 
+template <bool bigEndian>
+void
+Zc4PostingWriter<bigEndian>::copy_word(bitcompression::DecodeContext64Base &decode_context, const Zc4PostingParams &params,
+                                       PostingListCounts &counts)
+{
+    assert(_docIds.empty() && _counts._segments.empty());
+    EncodeContext &e = _encode_context;
+    uint64_t bit_length = counts._bitLength;
+    bool has_skip = (counts._numDocs >= params._min_skip_docs || !counts._segments.empty());
+    if (has_skip && ((e.getWriteOffset() - decode_context.getReadOffset()) & 7) != 0) {
+        /*
+         * Doc id deltas and skip info are byte aligned. Write the
+         * header again with new padding. All following data then has
+         * the same relative byte alignment and is copied unchanged.
+         */
+        uint64_t read_start = decode_context.getReadOffset();
+        uint64_t write_start = e.getWriteOffset();
+        Zc4PostingHeader header;
+        header.read(decode_context, params);
+        header.write(e, params);
+        uint64_t old_header_bit_length = decode_context.getReadOffset() - read_start;
+        uint64_t new_header_bit_length = e.getWriteOffset() - write_start;
+        bit_length -= old_header_bit_length;
+        counts._bitLength = counts._bitLength - old_header_bit_length + new_header_bit_length;
+        if (!counts._segments.empty()) {
+            auto &segment = counts._segments.front();
+            segment._bitLength = segment._bitLength - old_header_bit_length + new_header_bit_length;
+        }
+    }
+    while (bit_length > 0) {
+        uint32_t length = std::min(bit_length, static_cast<uint64_t>(64));
+        e.writeBits(decode_context.readBits(length), length);
+        e.writeComprBufferIfNeeded();
+        bit_length -= length;
+    }
+    if (counts._numDocs > 0) {
+        ++_numWords;
+    }
+    _writePos = e.getWriteOffset();
+}
+
 template <bool bigEndian>
 void
 Zc4PostingWriter<bigEndian>::set_encode_features(EncodeContext *encode_features)
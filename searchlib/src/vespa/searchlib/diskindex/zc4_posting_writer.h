@@ -3,8 +3,12 @@
 #pragma once
 
 #include "zc4_posting_writer_base.h"
+#include "zc4_posting_params.h"
 
-namespace search::index { class DocIdAndFeatures; }
+namespace search::index {
+class DocIdAndFeatures;
+class PostingListCounts;
+}
 
 namespace search::diskindex {
 
@@ -40,12 +44,23 @@ public:
     void flush_word_no_skip();
     void flush_word();
     void write_docid_and_features(const index::DocIdAndFeatures &features);
+    /*
+     * Copy the posting list for a word from a posting list file
+     * written with the same parameters. The header of the first
+     * chunk is written again with new padding if the relative byte
+     * alignment differs, adjusting the bit lengths in counts.
+     */
+    void copy_word(bitcompression::DecodeContext64Base &decode_context, const Zc4PostingParams &params, index::PostingListCounts &counts);
     void set_encode_features(EncodeContext *encode_features);
     void on_open();
     void on_close();
 
     EncodeContext &get_encode_features() { return *_encode_features; }
     EncodeContext &get_encode_context() { return _encode_context; }
+    Zc4PostingParams get_posting_params() const {
+        return Zc4PostingParams(_minSkipDocs, _minChunkDocs, _docIdLimit, _dynamicK, _encode_features != nullptr,
+                                _encode_interleaved_features, _encode_block_max, _encode_packed_doc_ids);
+    }
 };
 
 extern template class Zc4PostingWriter<false>;
@@ -1,8 +1,10 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "zc4_posting_writer_base.h"
+#include "zc_packed_block.h"
 #include <vespa/searchlib/index/postinglistcounts.h>
 #include <vespa/searchlib/index/postinglistparams.h>
+#include <algorithm>
 
 using search::index::PostingListCounts;
 using search::index::PostingListParams;
@@ -27,6 +29,8 @@ public:
     }
 
     void write(ZcBuf &zc_buf, const DocIdAndFeatureSize &doc_id_and_feature_size, bool encode_interleaved_features);
+    void write_packed(ZcBuf &zc_buf, ZcPackedBlock &block, const DocIdAndFeatureSize &doc_id_and_feature_size, bool encode_interleaved_features);
+    void flush_packed(ZcBuf &zc_buf, ZcPackedBlock &block, bool encode_interleaved_features);
     void set_doc_id(uint32_t doc_id) { _doc_id = doc_id; }
     uint32_t get_doc_id() const { return _doc_id; }
     uint32_t get_doc_id_pos() const { return _doc_id_pos; }
@@ -37,14 +41,20 @@ class L1SkipEncoder : public DocIdEncoder {
 protected:
     uint32_t _stride_check;
     uint32_t _l1_skip_pos;
+    uint32_t _block_max_num_occs; // Max num occs for documents since last skip entry
     const bool _encode_features;
+    const bool _encode_block_max;
+
+    void encode_block_max(ZcBuf &zc_buf);
 
 public:
-    L1SkipEncoder(bool encode_features)
+    L1SkipEncoder(bool encode_features, bool encode_block_max)
         : DocIdEncoder(),
           _stride_check(0u),
           _l1_skip_pos(0u),
-          _encode_features(encode_features)
+          _block_max_num_occs(0u),
+          _encode_features(encode_features),
+          _encode_block_max(encode_block_max)
     {
     }
 
@@ -53,6 +63,7 @@ public:
     bool should_write_skip(uint32_t stride) { return ++_stride_check >= stride; }
     void dec_stride_check() { --_stride_check; }
     void write_partial_skip(ZcBuf &zc_buf, uint32_t doc_id);
+    void add_num_occs(uint32_t num_occs) { _block_max_num_occs = std::max(_block_max_num_occs, num_occs); }
     uint32_t get_l1_skip_pos() const { return _l1_skip_pos; }
 };
 
@@ -61,8 +72,8 @@ protected:
     uint32_t _l2_skip_pos;
 
 public:
-    L2SkipEncoder(bool encode_features)
-        : L1SkipEncoder(encode_features),
+    L2SkipEncoder(bool encode_features, bool encode_block_max)
+        : L1SkipEncoder(encode_features, encode_block_max),
           _l2_skip_pos(0u)
     {
     }
@@ -77,8 +88,8 @@ protected:
     uint32_t _l3_skip_pos;
 
 public:
-    L3SkipEncoder(bool encode_features)
-        : L2SkipEncoder(encode_features),
+    L3SkipEncoder(bool encode_features, bool encode_block_max)
+        : L2SkipEncoder(encode_features, encode_block_max),
           _l3_skip_pos(0u)
     {
     }
@@ -91,8 +102,8 @@ public:
 class L4SkipEncoder : public L3SkipEncoder {
 
 public:
-    L4SkipEncoder(bool encode_features)
-        : L3SkipEncoder(encode_features)
+    L4SkipEncoder(bool encode_features, bool encode_block_max)
+        : L3SkipEncoder(encode_features, encode_block_max)
     {
     }
 
@@ -115,6 +126,38 @@ DocIdEncoder::write(ZcBuf &zc_buf, const DocIdAndFeatureSize &doc_id_and_feature
     _doc_id_pos = zc_buf.size();
 }
 
+void
+DocIdEncoder::write_packed(ZcBuf &zc_buf, ZcPackedBlock &block, const DocIdAndFeatureSize &doc_id_and_feature_size, bool encode_interleaved_features)
+{
+    _feature_pos += doc_id_and_feature_size._features_size;
+    block.add(doc_id_and_feature_size._doc_id, doc_id_and_feature_size._field_length, doc_id_and_feature_size._num_occs);
+    if (block.full()) {
+        // Block is complete when next skip entry is written
+        flush_packed(zc_buf, block, encode_interleaved_features);
+    }
+}
+
+void
+DocIdEncoder::flush_packed(ZcBuf &zc_buf, ZcPackedBlock &block, bool encode_interleaved_features)
+{
+    if (!block.empty()) {
+        uint32_t last_doc_id = block.last_doc_id();
+        block.flush(zc_buf, _doc_id, encode_interleaved_features);
+        _doc_id = last_doc_id;
+        _doc_id_pos = zc_buf.size();
+    }
+}
+
+void
+L1SkipEncoder::encode_block_max(ZcBuf &zc_buf)
+{
+    if (_encode_block_max) {
+        assert(_block_max_num_occs > 0);
+        zc_buf.encode(_block_max_num_occs - 1);
+        _block_max_num_occs = 0;
+    }
+}
+
 void
 L1SkipEncoder::encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
 {
@@ -124,6 +167,8 @@ L1SkipEncoder::encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
     assert(static_cast<int32_t>(doc_id_delta) > 0);
     zc_buf.encode(doc_id_delta - 1);
     _doc_id = doc_id_encoder.get_doc_id();
+    // max num occs for documents covered by skip entry
+    encode_block_max(zc_buf);
     // doc id pos
     zc_buf.encode(doc_id_encoder.get_doc_id_pos() - _doc_id_pos - 1);
     _doc_id_pos = doc_id_encoder.get_doc_id_pos();
@@ -146,6 +191,7 @@ L1SkipEncoder::write_partial_skip(ZcBuf &zc_buf, uint32_t doc_id)
 {
     if (zc_buf.size() > 0) {
         zc_buf.encode(doc_id - _doc_id - 1);
+        encode_block_max(zc_buf);
     }
 }
 
@@ -207,6 +253,8 @@ Zc4PostingWriterBase::Zc4PostingWriterBase(PostingListCounts &counts)
       _writePos(0),
       _dynamicK(false),
       _encode_interleaved_features(false),
+      _encode_block_max(false),
+      _encode_packed_doc_ids(false),
       _zcDocIds(),
       _l1Skip(),
       _l2Skip(),
@@ -237,10 +285,12 @@ void
 Zc4PostingWriterBase::calc_skip_info(bool encode_features)
 {
     DocIdEncoder doc_id_encoder;
-    L1SkipEncoder l1_skip_encoder(encode_features);
-    L2SkipEncoder l2_skip_encoder(encode_features);
-    L3SkipEncoder l3_skip_encoder(encode_features);
-    L4SkipEncoder l4_skip_encoder(encode_features);
+    L1SkipEncoder l1_skip_encoder(encode_features, _encode_block_max);
+    L2SkipEncoder l2_skip_encoder(encode_features, _encode_block_max);
+    L3SkipEncoder l3_skip_encoder(encode_features, _encode_block_max);
+    L4SkipEncoder l4_skip_encoder(encode_features, _encode_block_max);
+    ZcPackedBlock packed_block;
+    static_assert(ZcPackedBlock::max_size == L1SKIPSTRIDE, "packed blocks must be aligned with L1 skip entries");
     l1_skip_encoder.dec_stride_check();
     if (!_counts._segments.empty()) {
         uint32_t doc_id = _counts._segments.back()._lastDoc;
@@ -263,8 +313,20 @@ Zc4PostingWriterBase::calc_skip_info(bool encode_features)
                 }
             }
         }
-        doc_id_encoder.write(_zcDocIds, doc_id_and_feature_size, _encode_interleaved_features);
+        if (_encode_packed_doc_ids) {
+            doc_id_encoder.write_packed(_zcDocIds, packed_block, doc_id_and_feature_size, _encode_interleaved_features);
+        } else {
+            doc_id_encoder.write(_zcDocIds, doc_id_and_feature_size, _encode_interleaved_features);
+        }
+        if (_encode_block_max) {
+            uint32_t num_occs = doc_id_and_feature_size._num_occs;
+            l1_skip_encoder.add_num_occs(num_occs);
+            l2_skip_encoder.add_num_occs(num_occs);
+            l3_skip_encoder.add_num_occs(num_occs);
+            l4_skip_encoder.add_num_occs(num_occs);
+        }
     }
+    doc_id_encoder.flush_packed(_zcDocIds, packed_block, _encode_interleaved_features);
     // Extra partial entries for skip tables to simplify iterator during search
     l1_skip_encoder.write_partial_skip(_l1Skip, doc_id_encoder.get_doc_id());
     l2_skip_encoder.write_partial_skip(_l2Skip, doc_id_encoder.get_doc_id());
@@ -289,6 +351,10 @@ Zc4PostingWriterBase::set_posting_list_params(const PostingListParams &params)
     params.get("minChunkDocs", _minChunkDocs);
     params.get("minSkipDocs", _minSkipDocs);
     params.get("interleaved_features", _encode_interleaved_features);
+    params.get("block_max", _encode_block_max);
+    // Block max is derived from the interleaved num occs.
+    _encode_block_max = _encode_block_max && _encode_interleaved_features;
+    params.get("packed_doc_ids", _encode_packed_doc_ids);
 }
 
 }
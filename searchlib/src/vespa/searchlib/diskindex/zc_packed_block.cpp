@@ -0,0 +1,159 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "zc_packed_block.h"
+#include "zcbuf.h"
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace search::diskindex {
+
+namespace {
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "packed arrays are decoded as little endian words");
+
+// Room for max_size values of 32 bits, plus slack for the last 64 bit word read
+constexpr size_t packed_buf_size = ZcPackedBlock::max_size * sizeof(uint32_t) + sizeof(uint64_t);
+
+constexpr size_t
+packed_bytes(uint32_t size, uint32_t width) noexcept
+{
+    return (static_cast<size_t>(size) * width + 7) / 8;
+}
+
+uint32_t
+calc_width(const uint32_t *values, uint32_t size) noexcept
+{
+    uint32_t all_bits = 0;
+    for (uint32_t i = 0; i < size; ++i) {
+        all_bits |= values[i];
+    }
+    return (all_bits == 0) ? 0 : (32 - __builtin_clz(all_bits));
+}
+
+void
+pack(ZcBuf &zc_buf, const uint32_t *values, uint32_t size, uint32_t width)
+{
+    uint8_t buf[packed_buf_size] = {};
+    for (uint32_t i = 0; i < size; ++i) {
+        uint32_t bit_pos = i * width;
+        uint64_t word;
+        memcpy(&word, buf + (bit_pos >> 3), sizeof(word));
+        word |= static_cast<uint64_t>(values[i]) << (bit_pos & 7);
+        memcpy(buf + (bit_pos >> 3), &word, sizeof(word));
+    }
+    zc_buf.append(buf, packed_bytes(size, width));
+}
+
+/*
+ * Unpacks a full block of values with the given width, adding 1 to
+ * each value. The source must have packed_buf_size readable bytes.
+ */
+template <uint32_t width>
+void
+unpack(const uint8_t *src, uint32_t *dst) noexcept
+{
+    constexpr uint64_t mask = (uint64_t(1) << width) - 1;
+    for (uint32_t i = 0; i < ZcPackedBlock::max_size; ++i) {
+        uint32_t bit_pos = i * width;
+        uint64_t word;
+        memcpy(&word, src + (bit_pos >> 3), sizeof(word));
+        dst[i] = static_cast<uint32_t>((word >> (bit_pos & 7)) & mask) + 1;
+    }
+}
+
+using UnpackFunc = void (*)(const uint8_t *, uint32_t *) noexcept;
+
+template <size_t... widths>
+constexpr std::array<UnpackFunc, sizeof...(widths)>
+make_unpack_table(std::index_sequence<widths...>) noexcept
+{
+    return {{ &unpack<widths>... }};
+}
+
+constexpr auto unpack_table = make_unpack_table(std::make_index_sequence<33>());
+
+const uint8_t *
+unpack_values(const uint8_t *valI, uint32_t *dst, uint32_t size, uint32_t width) noexcept
+{
+    assert(width < unpack_table.size());
+    size_t bytes = packed_bytes(size, width);
+    // Copy to local buffer to avoid reading beyond end of encoded data
+    uint8_t buf[packed_buf_size];
+    memcpy(buf, valI, bytes);
+    memset(buf + bytes, 0, packed_buf_size - bytes);
+    unpack_table[width](buf, dst);
+    return valI + bytes;
+}
+
+}
+
+void
+ZcPackedBlock::flush(ZcBuf &zc_buf, uint32_t prev_doc_id, bool encode_interleaved_features)
+{
+    assert(_size > 0);
+    uint32_t deltas[max_size];
+    for (uint32_t i = 0; i < _size; ++i) {
+        assert(_doc_ids[i] > prev_doc_id);
+        deltas[i] = _doc_ids[i] - prev_doc_id - 1;
+        prev_doc_id = _doc_ids[i];
+    }
+    uint8_t header[4];
+    uint32_t header_size = 0;
+    header[header_size++] = _size - 1;
+    uint32_t doc_id_width = calc_width(deltas, _size);
+    header[header_size++] = doc_id_width;
+    uint32_t field_length_width = 0;
+    uint32_t num_occs_width = 0;
+    uint32_t field_lengths[max_size];
+    uint32_t num_occs[max_size];
+    if (encode_interleaved_features) {
+        for (uint32_t i = 0; i < _size; ++i) {
+            assert(_field_lengths[i] > 0);
+            field_lengths[i] = _field_lengths[i] - 1;
+            assert(_num_occs[i] > 0);
+            num_occs[i] = _num_occs[i] - 1;
+        }
+        field_length_width = calc_width(field_lengths, _size);
+        num_occs_width = calc_width(num_occs, _size);
+        header[header_size++] = field_length_width;
+        header[header_size++] = num_occs_width;
+    }
+    zc_buf.append(header, header_size);
+    pack(zc_buf, deltas, _size, doc_id_width);
+    if (encode_interleaved_features) {
+        pack(zc_buf, field_lengths, _size, field_length_width);
+        pack(zc_buf, num_occs, _size, num_occs_width);
+    }
+    _size = 0;
+    _pos = 0;
+}
+
+const uint8_t *
+ZcPackedBlock::decode(const uint8_t *valI, uint32_t prev_doc_id, bool decode_interleaved_features) noexcept
+{
+    _size = static_cast<uint32_t>(valI[0]) + 1;
+    uint32_t doc_id_width = valI[1];
+    valI += 2;
+    uint32_t field_length_width = 0;
+    uint32_t num_occs_width = 0;
+    if (decode_interleaved_features) {
+        field_length_width = valI[0];
+        num_occs_width = valI[1];
+        valI += 2;
+    }
+    valI = unpack_values(valI, _doc_ids, _size, doc_id_width);
+    for (uint32_t i = 0; i < _size; ++i) {
+        prev_doc_id += _doc_ids[i];
+        _doc_ids[i] = prev_doc_id;
+    }
+    if (decode_interleaved_features) {
+        valI = unpack_values(valI, _field_lengths, _size, field_length_width);
+        valI = unpack_values(valI, _num_occs, _size, num_occs_width);
+    }
+    _pos = 0;
+    return valI;
+}
+
+}
@@ -0,0 +1,89 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::diskindex {
+
+class ZcBuf;
+
+/*
+ * Block of document ids (and optionally interleaved features) in a
+ * posting list using packed doc ids. Blocks are aligned with the L1
+ * skip entries, thus a skip entry always refers to the start of a
+ * block and all blocks except the last one in a chunk are full.
+ *
+ * Block layout (all widths are in bits, each packed array is byte aligned):
+ *
+ *   [size - 1] [doc id delta width] [field length width] [num occs width]
+ *   [packed doc id deltas - 1] [packed field lengths - 1] [packed num occs - 1]
+ *
+ * Field length and num occs are only present when interleaved features
+ * are used. Values are stored with fixed width within an array, which
+ * allows a branch free decode loop that the compiler can vectorize
+ * instead of the byte by byte decoding of zc encoded values.
+ */
+class ZcPackedBlock
+{
+public:
+    static constexpr uint32_t max_size = 16; // Same as L1 skip stride
+
+private:
+    uint32_t _size;
+    uint32_t _pos;
+    uint32_t _doc_ids[max_size];
+    uint32_t _field_lengths[max_size];
+    uint32_t _num_occs[max_size];
+
+public:
+    ZcPackedBlock() noexcept
+        : _size(0),
+          _pos(0),
+          _doc_ids(),
+          _field_lengths(),
+          _num_occs()
+    {
+    }
+
+    // Writer side
+    bool empty() const noexcept { return _size == 0; }
+    bool full() const noexcept { return _size == max_size; }
+    void add(uint32_t doc_id, uint32_t field_length, uint32_t num_occs) noexcept {
+        _doc_ids[_size] = doc_id;
+        _field_lengths[_size] = field_length;
+        _num_occs[_size] = num_occs;
+        ++_size;
+    }
+    uint32_t last_doc_id() const noexcept { return _doc_ids[_size - 1]; }
+    // Encode block (doc ids relative to prev_doc_id) and make it empty
+    void flush(ZcBuf &zc_buf, uint32_t prev_doc_id, bool encode_interleaved_features);
+
+    // Reader side, returns position after encoded block
+    const uint8_t *decode(const uint8_t *valI, uint32_t prev_doc_id, bool decode_interleaved_features) noexcept;
+    bool at_end() const noexcept { return _pos == _size; }
+    uint32_t next_doc_id() noexcept { return _doc_ids[_pos++]; }
+    /*
+     * Step to the first doc id >= doc_id in the remaining part of the
+     * block, or to the end of the block if there is none. Returns the
+     * number of doc ids stepped over, including the one stepped to.
+     */
+    uint32_t seek(uint32_t doc_id) noexcept {
+        uint32_t pos = _pos;
+        while (pos < _size && _doc_ids[pos] < doc_id) {
+            ++pos;
+        }
+        if (pos < _size) {
+            ++pos;
+        }
+        uint32_t steps = pos - _pos;
+        _pos = pos;
+        return steps;
+    }
+    // Features for the last doc id returned by next_doc_id() or seek()
+    uint32_t get_doc_id() const noexcept { return _doc_ids[_pos - 1]; }
+    uint32_t get_field_length() const noexcept { return _field_lengths[_pos - 1]; }
+    uint32_t get_num_occs() const noexcept { return _num_occs[_pos - 1]; }
+};
+
+}
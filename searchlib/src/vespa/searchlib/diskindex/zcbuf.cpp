@@ -61,4 +61,17 @@ ZcBuf::expand()
     _valE = _mallocStart + newSize - zcSlack();
 }
 
+void
+ZcBuf::append(const uint8_t *buf, size_t len)
+{
+    while (_valI + len > _valE) {
+        expand();
+    }
+    if (len > 0) {
+        memcpy(_valI, buf, len);
+        _valI += len;
+    }
+    maybeExpand();
+}
+
 }
@@ -36,6 +36,8 @@ public:
         }
     }
 
+    void append(const uint8_t *buf, size_t len);
+
     void encode(uint32_t num) {
         for (;;) {
             if (num < (1 << 7)) {
@@ -38,8 +38,8 @@ private:
     DecodeContext _decodeContextReal;
 public:
     ZcPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
-                     bool decode_normal_features, bool decode_interleaved_features,
-                     bool unpack_normal_features, bool unpack_interleaved_features,
+                     bool decode_normal_features, bool decode_interleaved_features, bool decode_block_max,
+                     bool decode_packed_doc_ids, bool unpack_normal_features, bool unpack_interleaved_features,
                      uint32_t minChunkDocs, const index::PostingListCounts &counts,
                      const bitcompression::PosOccFieldsParams *fieldsParams,
                      fef::TermFieldMatchDataArray matchData);
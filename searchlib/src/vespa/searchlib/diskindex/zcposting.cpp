@@ -17,6 +17,8 @@ namespace {
 vespalib::string myId5("Zc.5");
 vespalib::string myId4("Zc.4");
 vespalib::string interleaved_features("interleaved_features");
+vespalib::string block_max("block_max");
+vespalib::string packed_doc_ids("packed_doc_ids");
 
 }
 
@@ -62,6 +64,14 @@ Zc4PostingSeqRead::readCounts(const PostingListCounts &counts)
 }
 
 
+void
+Zc4PostingSeqRead::skip_posting_lists(uint64_t bit_length)
+{
+    auto &d = _reader.get_decode_features();
+    _reader.get_read_context().setPosition(d.getReadOffset() + bit_length);
+}
+
+
 bool
 Zc4PostingSeqRead::open(const vespalib::string &name,
                         const TuneFileSeqRead &tuneFileRead)
@@ -121,6 +131,8 @@ Zc4PostingSeqRead::getParams(PostingListParams &params)
     }
     params.set("minSkipDocs", _reader.get_posting_params()._min_skip_docs);
     params.set(interleaved_features, _reader.get_posting_params()._encode_interleaved_features);
+    params.set(block_max, _reader.get_posting_params()._encode_block_max);
+    params.set(packed_doc_ids, _reader.get_posting_params()._encode_packed_doc_ids);
 }
 
 
@@ -167,6 +179,12 @@ Zc4PostingSeqRead::readHeader()
     if (header.hasTag(interleaved_features) && (header.getTag(interleaved_features).asInteger() != 0)) {
        posting_params._encode_interleaved_features = true;
     }
+    if (header.hasTag(block_max) && (header.getTag(block_max).asInteger() != 0)) {
+       posting_params._encode_block_max = true;
+    }
+    if (header.hasTag(packed_doc_ids) && (header.getTag(packed_doc_ids).asInteger() != 0)) {
+       posting_params._encode_packed_doc_ids = true;
+    }
     assert(header.getTag("endian").asString() == "big");
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
@@ -217,6 +235,14 @@ Zc4PostingSeqWrite::flushWord()
 }
 
 
+void
+Zc4PostingSeqWrite::copy_posting_list(index::PostingListFileSeqRead &source, PostingListCounts &counts)
+{
+    auto &zc_source = dynamic_cast<Zc4PostingSeqRead &>(source);
+    _writer.copy_word(zc_source.get_decode_features(), zc_source.get_posting_params(), counts);
+}
+
+
 void
 Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
 {
@@ -234,6 +260,8 @@ Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
     header.putTag(Tag("format.0", myId));
     header.putTag(Tag("format.1", f.getIdentifier()));
     header.putTag(Tag("interleaved_features", _writer.get_encode_interleaved_features() ? 1 : 0));
+    header.putTag(Tag("block_max", _writer.get_encode_block_max() ? 1 : 0));
+    header.putTag(Tag("packed_doc_ids", _writer.get_encode_packed_doc_ids() ? 1 : 0));
     header.putTag(Tag("numWords", 0));
     header.putTag(Tag("minChunkDocs", _writer.get_min_chunk_docs()));
     header.putTag(Tag("docIdLimit", _writer.get_docid_limit()));
@@ -355,6 +383,8 @@ getParams(PostingListParams &params)
     }
     params.set("minSkipDocs", _writer.get_min_skip_docs());
     params.set(interleaved_features, _writer.get_encode_interleaved_features());
+    params.set(block_max, _writer.get_encode_block_max());
+    params.set(packed_doc_ids, _writer.get_encode_packed_doc_ids());
 }
 
 
@@ -38,12 +38,15 @@ public:
 
     void readDocIdAndFeatures(DocIdAndFeatures &features) override;
     void readCounts(const PostingListCounts &counts) override; // Fill in for next word
+    void skip_posting_lists(uint64_t bit_length) override;
     bool open(const vespalib::string &name, const TuneFileSeqRead &tuneFileRead) override;
     bool close() override;
     void getParams(PostingListParams &params) override;
     void getFeatureParams(PostingListParams &params) override;
     void readHeader();
     static const vespalib::string &getIdentifier(bool dynamic_k);
+    bitcompression::FeatureDecodeContextBE &get_decode_features() { return _reader.get_decode_features(); }
+    Zc4PostingParams &get_posting_params() { return _reader.get_posting_params(); }
 };
 
 
@@ -74,6 +77,7 @@ public:
 
     void writeDocIdAndFeatures(const DocIdAndFeatures &features) override;
     void flushWord() override;
+    void copy_posting_list(index::PostingListFileSeqRead &source, PostingListCounts &counts) override;
 
     bool open(const vespalib::string &name,
               const TuneFileSeqWrite &tuneFileWrite,
@@ -189,6 +189,7 @@ ZcRareWordPostingIterator<bigEndian, dynamic_k>::readWordStart(uint32_t docIdLim
 
 ZcPostingIteratorBase::ZcPostingIteratorBase(TermFieldMatchDataArray matchData, Position start, uint32_t docIdLimit,
                                              bool decode_normal_features, bool decode_interleaved_features,
+                                             bool decode_block_max, bool decode_packed_doc_ids,
                                              bool unpack_normal_features, bool unpack_interleaved_features)
     : ZcIteratorBase(std::move(matchData), start, docIdLimit),
       _valI(nullptr),
@@ -203,11 +204,14 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(TermFieldMatchDataArray matchData,
       _hasMore(false),
       _decode_normal_features(decode_normal_features),
       _decode_interleaved_features(decode_interleaved_features),
+      _decode_block_max(decode_block_max),
+      _decode_packed_doc_ids(decode_packed_doc_ids),
       _unpack_normal_features(unpack_normal_features),
       _unpack_interleaved_features(unpack_interleaved_features),
       _chunkNo(0),
       _field_length(0),
-      _num_occs(0)
+      _num_occs(0),
+      _packed_block()
 {
 }
 
@@ -218,11 +222,11 @@ ZcPostingIterator(uint32_t minChunkDocs,
                   const PostingListCounts &counts,
                   search::fef::TermFieldMatchDataArray matchData,
                   Position start, uint32_t docIdLimit,
-                  bool decode_normal_features, bool decode_interleaved_features,
-                  bool unpack_normal_features, bool unpack_interleaved_features)
+                  bool decode_normal_features, bool decode_interleaved_features, bool decode_block_max,
+                  bool decode_packed_doc_ids, bool unpack_normal_features, bool unpack_interleaved_features)
     : ZcPostingIteratorBase(std::move(matchData), start, docIdLimit,
-                            decode_normal_features, decode_interleaved_features,
-                            unpack_normal_features, unpack_interleaved_features),
+                            decode_normal_features, decode_interleaved_features, decode_block_max,
+                            decode_packed_doc_ids, unpack_normal_features, unpack_interleaved_features),
       _decodeContext(nullptr),
       _minChunkDocs(minChunkDocs),
       _docIdK(0),
@@ -310,10 +314,10 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     const uint8_t *bcompr = d.getByteCompr();
     _valIBase = _valI = bcompr;
     bcompr += docIdsSize;
-    _l1.setup(prevDocId, _chunk._lastDocId, bcompr, l1SkipSize);
-    _l2.setup(prevDocId, _chunk._lastDocId, bcompr, l2SkipSize);
-    _l3.setup(prevDocId, _chunk._lastDocId, bcompr, l3SkipSize);
-    _l4.setup(prevDocId, _chunk._lastDocId, bcompr, l4SkipSize);
+    _l1.setup(prevDocId, _chunk._lastDocId, bcompr, l1SkipSize, _decode_block_max);
+    _l2.setup(prevDocId, _chunk._lastDocId, bcompr, l2SkipSize, _decode_block_max);
+    _l3.setup(prevDocId, _chunk._lastDocId, bcompr, l3SkipSize, _decode_block_max);
+    _l4.setup(prevDocId, _chunk._lastDocId, bcompr, l4SkipSize, _decode_block_max);
     _l1.postSetup(*this);
     _l2.postSetup(_l1);
     _l3.postSetup(_l2);
@@ -364,7 +368,7 @@ ZcPostingIteratorBase::doL4SkipSeek(uint32_t docId)
     do {
         lastL4SkipDocId = _l4._skipDocId;
         _l4.decodeSkipEntry(_decode_normal_features);
-        _l4.nextDocId();
+        _l4.nextDocId(_decode_block_max);
 #if DEBUG_ZCPOSTING_PRINTF
         printf("L4Decode docId %d, docIdPos %d,"
                "l1SkipPos %d, l2SkipPos %d, l3SkipPos %d, nextDocId %d\n",
@@ -385,9 +389,9 @@ ZcPostingIteratorBase::doL4SkipSeek(uint32_t docId)
     _l2._valI = _l3._l2Pos = _l4._l2Pos;
     _l3._valI = _l4._l3Pos;
     nextDocId(lastL4SkipDocId);
-    _l1.nextDocId();
-    _l2.nextDocId();
-    _l3.nextDocId();
+    _l1.nextDocId(_decode_block_max);
+    _l2.nextDocId(_decode_block_max);
+    _l3.nextDocId(_decode_block_max);
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L4Seek, docId %d docIdPos %d"
            " L1SkipPos %d L2SkipPos %d L3SkipPos %d, nextDocId %d\n",
@@ -417,7 +421,7 @@ ZcPostingIteratorBase::doL3SkipSeek(uint32_t docId)
     do {
         lastL3SkipDocId = _l3._skipDocId;
         _l3.decodeSkipEntry(_decode_normal_features);
-        _l3.nextDocId();
+        _l3.nextDocId(_decode_block_max);
 #if DEBUG_ZCPOSTING_PRINTF
         printf("L3Decode docId %d, docIdPos %d,"
                "l1SkipPos %d, l2SkipPos %d, nextDocId %d\n",
@@ -434,8 +438,8 @@ ZcPostingIteratorBase::doL3SkipSeek(uint32_t docId)
     _l1._valI = _l2._l1Pos = _l3._l1Pos;
     _l2._valI = _l3._l2Pos;
     nextDocId(lastL3SkipDocId);
-    _l1.nextDocId();
-    _l2.nextDocId();
+    _l1.nextDocId(_decode_block_max);
+    _l2.nextDocId(_decode_block_max);
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L3Seek, docId %d docIdPos %d"
            " L1SkipPos %d L2SkipPos %d, nextDocId %d\n",
@@ -464,7 +468,7 @@ ZcPostingIteratorBase::doL2SkipSeek(uint32_t docId)
     do {
         lastL2SkipDocId = _l2._skipDocId;
         _l2.decodeSkipEntry(_decode_normal_features);
-        _l2.nextDocId();
+        _l2.nextDocId(_decode_block_max);
 #if DEBUG_ZCPOSTING_PRINTF
         printf("L2Decode docId %d, docIdPos %d, l1SkipPos %d, nextDocId %d\n",
                lastL2SkipDocId,
@@ -478,7 +482,7 @@ ZcPostingIteratorBase::doL2SkipSeek(uint32_t docId)
     _l1._skipDocId = lastL2SkipDocId;
     _l1._valI = _l2._l1Pos;
     nextDocId(lastL2SkipDocId);
-    _l1.nextDocId();
+    _l1.nextDocId(_decode_block_max);
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L2Seek, docId %d docIdPos %d L1SkipPos %d, nextDocId %d\n",
            lastL2SkipDocId,
@@ -504,7 +508,7 @@ ZcPostingIteratorBase::doL1SkipSeek(uint32_t docId)
     do {
         lastL1SkipDocId = _l1._skipDocId;
         _l1.decodeSkipEntry(_decode_normal_features);
-        _l1.nextDocId();
+        _l1.nextDocId(_decode_block_max);
 #if DEBUG_ZCPOSTING_PRINTF
         printf("L1Decode docId %d, docIdPos %d, L1SkipPos %d, nextDocId %d\n",
                lastL1SkipDocId,
@@ -526,9 +530,39 @@ ZcPostingIteratorBase::doL1SkipSeek(uint32_t docId)
 }
 
 
+void
+ZcPostingIteratorBase::doPackedSeek(uint32_t docId)
+{
+    if (docId > _l1._skipDocId) {
+        doL1SkipSeek(docId);
+    }
+    uint32_t oDocId = getDocId();
+    if (__builtin_expect(oDocId >= docId, false)) {
+        return;
+    }
+    // Scan decoded block, skip entries are aligned with block boundaries
+    do {
+        if (_packed_block.at_end()) {
+            _valI = _packed_block.decode(_valI, oDocId, _decode_interleaved_features);
+        }
+        addNeedUnpack(_packed_block.seek(docId));
+        oDocId = _packed_block.get_doc_id();
+    } while (oDocId < docId);
+    setDocId(oDocId);
+    if (_decode_interleaved_features) {
+        _field_length = _packed_block.get_field_length();
+        _num_occs = _packed_block.get_num_occs();
+    }
+}
+
+
 void
 ZcPostingIteratorBase::doSeek(uint32_t docId)
 {
+    if (_decode_packed_doc_ids) {
+        doPackedSeek(docId);
+        return;
+    }
     if (docId > _l1._skipDocId) {
         doL1SkipSeek(docId);
     }
@@ -574,6 +608,17 @@ ZcPostingIteratorBase::doSeek(uint32_t docId)
 }
 
 
+queryeval::BlockMaxInfo::Block
+ZcPostingIteratorBase::get_block(uint32_t docId)
+{
+    if (docId > _l1._skipDocId) {
+        // Positions the iterator at the start of the L1 skip block containing docId
+        doL1SkipSeek(docId);
+    }
+    return {_l1._skipDocId, _l1._blockMaxNumOccs};
+}
+
+
 template <bool bigEndian>
 void
 ZcPostingIterator<bigEndian>::doUnpack(uint32_t docId)
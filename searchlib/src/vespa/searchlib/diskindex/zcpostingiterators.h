@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include "zc_packed_block.h"
 #include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/queryeval/iterators.h>
+#include <vespa/searchlib/queryeval/wand/block_max_info.h>
+#include <limits>
 
 namespace search::diskindex {
 
@@ -134,7 +137,8 @@ public:
     void readWordStart(uint32_t docIdLimit) override;
 };
 
-class ZcPostingIteratorBase : public ZcIteratorBase
+class ZcPostingIteratorBase : public ZcIteratorBase,
+                              public queryeval::BlockMaxInfo
 {
 protected:
     const uint8_t *_valI;     // docid deltas
@@ -146,6 +150,7 @@ protected:
     {
     public:
         uint32_t _skipDocId;
+        uint32_t _blockMaxNumOccs; // Max num occs for documents up to and including _skipDocId
         const uint8_t *_valI;
         const uint8_t *_docIdPos;
         uint64_t _skipFeaturePos;
@@ -153,6 +158,7 @@ protected:
 
         L1Skip()
             : _skipDocId(0),
+              _blockMaxNumOccs(std::numeric_limits<uint32_t>::max()),
               _valI(nullptr),
               _docIdPos(nullptr),
               _skipFeaturePos(0),
@@ -160,12 +166,13 @@ protected:
         {
         }
 
-        void setup(uint32_t prevDocId, uint32_t lastDocId, const uint8_t *&bcompr, uint32_t skipSize) {
+        void setup(uint32_t prevDocId, uint32_t lastDocId, const uint8_t *&bcompr, uint32_t skipSize, bool decode_block_max) {
+            _blockMaxNumOccs = std::numeric_limits<uint32_t>::max();
             if (skipSize != 0) {
                 _valI = _valIBase = bcompr;
                 bcompr += skipSize;
-                _skipDocId = prevDocId + 1;
-                ZCDECODE(_valI, _skipDocId +=);
+                _skipDocId = prevDocId;
+                nextDocId(decode_block_max);
             } else {
                 _valI = _valIBase = nullptr;
                 _skipDocId = lastDocId;
@@ -181,8 +188,11 @@ protected:
                 ZCDECODE(_valI, _skipFeaturePos += 1 +);
             }
         }
-        void nextDocId() {
+        void nextDocId(bool decode_block_max) {
             ZCDECODE(_valI, _skipDocId += 1 +);
+            if (decode_block_max) {
+                ZCDECODE(_valI, _blockMaxNumOccs = 1 +);
+            }
         }
     };
 
@@ -276,13 +286,28 @@ protected:
     bool     _hasMore;
     bool     _decode_normal_features;
     bool     _decode_interleaved_features;
+    bool     _decode_block_max;
+    bool     _decode_packed_doc_ids;
     bool     _unpack_normal_features;
     bool     _unpack_interleaved_features;
     uint32_t _chunkNo;
     uint32_t _field_length;
     uint32_t _num_occs;
+    ZcPackedBlock _packed_block; // Current block when using packed doc ids
 
+    void nextPackedDocId(uint32_t prevDocId) {
+        _valI = _packed_block.decode(_valI, prevDocId, _decode_interleaved_features);
+        setDocId(_packed_block.next_doc_id());
+        if (_decode_interleaved_features) {
+            _field_length = _packed_block.get_field_length();
+            _num_occs = _packed_block.get_num_occs();
+        }
+    }
     void nextDocId(uint32_t prevDocId) {
+        if (_decode_packed_doc_ids) {
+            nextPackedDocId(prevDocId);
+            return;
+        }
         uint32_t docId = prevDocId + 1;
         ZCDECODE(_valI, docId +=);
         setDocId(docId);
@@ -297,11 +322,15 @@ protected:
     VESPA_DLL_LOCAL void doL3SkipSeek(uint32_t docId);
     VESPA_DLL_LOCAL void doL2SkipSeek(uint32_t docId);
     VESPA_DLL_LOCAL void doL1SkipSeek(uint32_t docId);
+    VESPA_DLL_LOCAL void doPackedSeek(uint32_t docId);
     void doSeek(uint32_t docId) override;
 public:
     ZcPostingIteratorBase(fef::TermFieldMatchDataArray matchData, Position start, uint32_t docIdLimit,
-                          bool decode_normal_features, bool decode_interleaved_features,
-                          bool unpack_normal_features, bool unpack_interleaved_features);
+                          bool decode_normal_features, bool decode_interleaved_features, bool decode_block_max,
+                          bool decode_packed_doc_ids, bool unpack_normal_features, bool unpack_interleaved_features);
+    bool has_block_max() const override { return _decode_block_max; }
+    Block get_block(uint32_t docId) override;
+    uint32_t get_num_occs() const override { return _num_occs; }
 };
 
 template <bool bigEndian>
@@ -329,8 +358,8 @@ public:
 
     ZcPostingIterator(uint32_t minChunkDocs, bool dynamicK, const PostingListCounts &counts,
                       search::fef::TermFieldMatchDataArray matchData, Position start, uint32_t docIdLimit,
-                      bool decode_normal_features, bool decode_interleaved_features,
-                      bool unpack_normal_features, bool unpack_interleaved_features);
+                      bool decode_normal_features, bool decode_interleaved_features, bool decode_block_max,
+                      bool decode_packed_doc_ids, bool unpack_normal_features, bool unpack_interleaved_features);
 
 
     void doUnpack(uint32_t docId) override;
@@ -14,6 +14,7 @@ namespace vespalib {
     class DataBuffer;
 }
 namespace vespalib::alloc { class Alloc; }
+namespace vespalib::compression { class ZStdDictionary; }
 
 namespace search {
 
@@ -64,6 +65,7 @@ class Chunk {
 public:
     using UP = std::unique_ptr<Chunk>;
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using ZStdDictionary = vespalib::compression::ZStdDictionary;
     class Config {
     public:
         Config(size_t maxBytes) : _maxBytes(maxBytes) { }
@@ -87,7 +89,7 @@ public:
     };
     using LidList = std::vector<Entry>;
     Chunk(uint32_t id, const Config & config);
-    Chunk(uint32_t id, const void * buffer, size_t len, bool skipcrc=false);
+    Chunk(uint32_t id, const void * buffer, size_t len, bool skipcrc=false, const ZStdDictionary * dictionary=nullptr);
     ~Chunk();
     LidMeta append(uint32_t lid, const void * buffer, size_t len);
     ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const;
@@ -98,7 +100,8 @@ public:
     const LidList & getLids() const { return _lids; }
     LidList getUniqueLids() const;
     size_t getMaxPackSize(CompressionConfig compression) const;
-    void pack(uint64_t lastSerial, vespalib::DataBuffer & buffer, CompressionConfig compression);
+    void pack(uint64_t lastSerial, vespalib::DataBuffer & buffer, CompressionConfig compression,
+              const ZStdDictionary * dictionary=nullptr);
     uint64_t getLastSerial() const { return _lastSerial; }
     uint32_t getId() const { return _id; }
     bool validSerial() const { return getLastSerial() != static_cast<uint64_t>(-1l); }
@@ -7,6 +7,8 @@
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/exception.h>
 
+namespace vespalib::compression { class ZStdDictionary; }
+
 namespace search {
 
 class ChunkException : public vespalib::Exception
@@ -22,6 +24,7 @@ public:
     virtual ~ChunkFormat();
     using UP = std::unique_ptr<ChunkFormat>;
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using ZStdDictionary = vespalib::compression::ZStdDictionary;
     vespalib::nbostream & getBuffer() { return _dataBuf; }
     const vespalib::nbostream & getBuffer() const { return _dataBuf; }
 
@@ -30,15 +33,19 @@ public:
      * @param lastSerial The last serial number of any entry in the packet.
      * @param compressed The buffer where the serialized data shall be placed.
      * @param compression What kind of compression shall be employed.
+     * @param dictionary Optional dictionary used for zstd compression.
      */
-    void pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, CompressionConfig compression);
+    void pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, CompressionConfig compression,
+              const ZStdDictionary * dictionary = nullptr);
     /**
      * Will deserialize and create a representation of the uncompressed data.
      * param buffer Pointer to the serialized data
      * @param len Length of serialized data
      * @param indicate if crc verification shall be skipped.
+     * @param dictionary The dictionary the chunk was packed with, if any.
      */
-    static ChunkFormat::UP deserialize(const void * buffer, size_t len, bool skipcrc);
+    static ChunkFormat::UP deserialize(const void * buffer, size_t len, bool skipcrc,
+                                       const ZStdDictionary * dictionary = nullptr);
     /**
      * return the maximum size a packet can have. It allows correct size estimation
      * need for direct io alignment.
@@ -59,8 +66,9 @@ protected:
     /**
      * Will deserialize and uncompress the body.
      * @param the potentially compressed stream.
+     * @param dictionary The dictionary the body was compressed with, if any.
      */
-    void deserializeBody(vespalib::nbostream & is);
+    void deserializeBody(vespalib::nbostream & is, const ZStdDictionary * dictionary);
     /**
      * Wille compute and check the crc of the incoming stream.
      * Will start 1 byte earlier and stop 4 bytes ahead of end.
@@ -6,6 +6,7 @@
 #include "value.h"
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/vespalib/stllike/cache.hpp>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
 #include <vespa/vespalib/util/size_literals.h>
@@ -110,6 +111,41 @@ public:
     Cache(BackingStore & b, size_t maxBytes) : vespalib::cache<CacheParams>(b, maxBytes) { }
 };
 
+/*
+ * Hands documents read in bulk from the backing store to the visitor, and inserts
+ * them in the document cache the same way as a cache miss in DocumentStore::read() does.
+ * The cache generation of each lid is fetched before the bulk read, so documents written
+ * or removed while the read was in progress are not inserted.
+ */
+class CachePopulatingVisitorAdapter : public IBufferVisitor
+{
+public:
+    using Generations = vespalib::hash_map<uint32_t, uint64_t>;
+    CachePopulatingVisitorAdapter(Cache & cache, const Generations & generations, CompressionConfig compression,
+                                  const DocumentTypeRepo & repo, IDocumentVisitor & visitor)
+        : _cache(cache),
+          _generations(generations),
+          _compression(compression),
+          _adapter(repo, visitor)
+    { }
+    void visit(uint32_t lid, vespalib::ConstBufferRef buf) override {
+        auto found = _generations.find(lid);
+        if ((buf.size() > 0) && (found != _generations.end())) {
+            Value value;
+            vespalib::DataBuffer copy(buf.size());
+            copy.writeBytes(buf.c_str(), buf.size());
+            value.set(std::move(copy), buf.size(), _compression);
+            _cache.populate(lid, std::move(value), found->second);
+        }
+        _adapter.visit(lid, buf);
+    }
+private:
+    Cache                  & _cache;
+    const Generations      & _generations;
+    CompressionConfig        _compression;
+    DocumentVisitorAdapter   _adapter;
+};
+
 }
 
 using docstore::Value;
@@ -163,6 +199,25 @@ DocumentStore::visit(const LidVector & lids, const DocumentTypeRepo &repo, IDocu
         for (DocumentIdT lid : lids) {
             adapter.visit(lid, blobSet.get(lid));
         }
+    } else if (useCache() && visitor.allowDocumentCaching()) {
+        // Documents already in the document cache are served from there, the rest are read in bulk.
+        LidVector uncached;
+        docstore::CachePopulatingVisitorAdapter::Generations generations(lids.size() * 2);
+        uncached.reserve(lids.size());
+        for (DocumentIdT lid : lids) {
+            if (_cache->hasKey(lid)) {
+                auto doc = read(lid, repo);
+                if (doc) {
+                    visitor.visit(lid, std::move(doc));
+                }
+            } else {
+                generations[lid] = _cache->getGeneration(lid);
+                uncached.push_back(lid);
+            }
+        }
+        _uncached_lookups.fetch_add(uncached.size());
+        docstore::CachePopulatingVisitorAdapter adapter(*_cache, generations, _store->getCompression(), repo, visitor);
+        _backingStore.read(uncached, adapter);
     } else {
         _store->visit(lids, repo, visitor);
     }
@@ -220,6 +275,8 @@ DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const vespalib::nbostr
                     _cache->write(lid, std::move(value));
                 } else {
                     _backingStore.write(syncToken, lid, stream.peek(), stream.size());
+                    // Not cached, but a concurrent batched visit must not populate the cache with the old document.
+                    _cache->invalidate(lid);
                 }
                 break;
         }
@@ -9,10 +9,12 @@
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/encoding/base64.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/executor.h>
 #include <vespa/vespalib/util/arrayqueue.hpp>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/vespalib/util/array.hpp>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/fastos/file.h>
@@ -30,8 +32,11 @@ namespace search {
 namespace {
 
 constexpr size_t ALIGNMENT=0x1000;
+// Bounds the memory held by the chunks of a single batch read.
+constexpr size_t MAX_CHUNKS_PER_BATCH_READ = 64;
 constexpr size_t ENTRY_BIAS_SIZE=8;
 const vespalib::string DOC_ID_LIMIT_KEY("docIdLimit");
+const vespalib::string ZSTD_DICTIONARY_KEY("zstdDictionary");
 
 }
 
@@ -86,7 +91,8 @@ FileChunk::FileChunk(FileId fileId, NameId nameId, const vespalib::string & base
       _idxHeaderLen(0u),
       _numLids(0),
       _docIdLimit(std::numeric_limits<uint32_t>::max()),
-      _modificationTime()
+      _modificationTime(),
+      _dictionary()
 {
     FastOS_File dataFile(_dataFileName.c_str());
     if (dataFile.OpenReadOnly()) {
@@ -270,6 +276,9 @@ FileChunk::enableRead()
             LOG(debug, "enableRead(): MMapRandReadDynamic: file='%s'", _dataFileName.c_str());
             _file = std::make_unique<MMapRandReadDynamic>(_dataFileName, mmapFlags, fadviseOptions);
         }
+    } else if (_tune._randRead.getWantIoUring()) {
+        LOG(debug, "enableRead(): URingRandRead: file='%s'", _dataFileName.c_str());
+        _file = std::make_unique<URingRandRead>(_dataFileName);
     } else {
         LOG(debug, "enableRead(): NormalRandRead: file='%s'", _dataFileName.c_str());
         _file = std::make_unique<NormalRandRead>(_dataFileName);
@@ -278,6 +287,9 @@ FileChunk::enableRead()
     if (_dataHeaderLen == 0u) {
         throw std::runtime_error(make_string("bad file header: %s", _dataFileName.c_str()));
     }
+    if ( ! _dictionary) {
+        _dictionary = readDataDictionary(*_file, _dataHeaderLen);
+    }
 }
 
 size_t FileChunk::adjustSize(size_t sz) {
@@ -353,7 +365,7 @@ FileChunk::appendTo(vespalib::Executor & executor, const IGetLid & db, IWriteDat
             const ChunkInfo & cInfo(_chunkInfo[chunkId]);
             vespalib::DataBuffer whole(0ul, ALIGNMENT);
             FileRandRead::FSP keepAlive(_file->read(cInfo.getOffset(), whole, cInfo.getSize()));
-            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen()));
+            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen(), false, _dictionary.get()));
         });
         executor.execute(CpuUsage::wrap(std::move(task), cpu_category));
 
@@ -375,19 +387,16 @@ void
 FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const
 {
     if (count == 0) { return; }
-    uint32_t prevChunk = begin->getChunkId();
-    uint32_t start(0);
-    for (size_t i(0); i < count; i++) {
-        const LidInfoWithLid & li = *(begin + i);
-        if (li.getChunkId() != prevChunk) {
-            ChunkInfo ci = _chunkInfo[prevChunk];
-            read(begin + start, i - start, ci, visitor);
-            prevChunk = li.getChunkId();
+    std::vector<ChunkRun> runs;
+    size_t start(0);
+    for (size_t i(1); i <= count; i++) {
+        uint32_t chunkId = (begin + start)->getChunkId();
+        if ((i == count) || ((begin + i)->getChunkId() != chunkId)) {
+            runs.push_back({begin + start, i - start, _chunkInfo[chunkId]});
             start = i;
         }
     }
-    ChunkInfo ci = _chunkInfo[prevChunk];
-    read(begin + start, count - start, ci, visitor);
+    read(runs, visitor);
 }
 
 void
@@ -395,7 +404,7 @@ FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo c
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
@@ -405,6 +414,40 @@ FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo c
     }
 }
 
+void
+FileChunk::read(const std::vector<ChunkRun> & runs, IBufferVisitor & visitor) const
+{
+    if (runs.size() == 1) {
+        read(runs[0].begin, runs[0].count, runs[0].chunkInfo, visitor);
+        return;
+    }
+    for (size_t first(0); first < runs.size(); first += MAX_CHUNKS_PER_BATCH_READ) {
+        size_t last = std::min(runs.size(), first + MAX_CHUNKS_PER_BATCH_READ);
+        std::vector<std::unique_ptr<vespalib::DataBuffer>> buffers;
+        std::vector<FileRandRead::ReadRequest> requests;
+        buffers.reserve(last - first);
+        requests.reserve(last - first);
+        for (size_t i(first); i < last; i++) {
+            const ChunkInfo & ci = runs[i].chunkInfo;
+            buffers.push_back(std::make_unique<vespalib::DataBuffer>(0ul, ALIGNMENT));
+            requests.push_back({ci.getOffset(), ci.getSize(), buffers.back().get()});
+        }
+        std::vector<FileRandRead::FSP> keepAlive = _file->readBatch(requests);
+        for (size_t i(first); i < last; i++) {
+            const ChunkRun & run = runs[i];
+            const vespalib::DataBuffer & whole = *buffers[i - first];
+            Chunk chunk(run.begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
+            for (size_t j(0); j < run.count; j++) {
+                const LidInfoWithLid & li = *(run.begin + j);
+                vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
+                if (buf.size() != 0) {
+                    visitor.visit(li.getLid(), buf);
+                }
+            }
+        }
+    }
+}
+
 ssize_t
 FileChunk::read(uint32_t lid, SubChunkId chunkId,
                 vespalib::DataBuffer & buffer) const
@@ -420,7 +463,7 @@ FileChunk::read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo,
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
-    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
     return chunk.read(lid, buffer);
 }
 
@@ -442,6 +485,16 @@ FileChunk::readDataHeader(FileRandRead &datFile)
     return dataHeaderLen;
 }
 
+FileChunk::DictionarySP
+FileChunk::readDataDictionary(FileRandRead &datFile, uint64_t dataHeaderLen)
+{
+    vespalib::DataBuffer h(dataHeaderLen, ALIGNMENT);
+    datFile.read(0, h, dataHeaderLen);
+    GenericHeader::BufferReader rd(h);
+    GenericHeader header;
+    header.read(rd);
+    return readDictionary(header, 0);
+}
 
 uint64_t
 FileChunk::readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit)
@@ -482,6 +535,25 @@ FileChunk::writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit)
     header.putTag(vespalib::GenericHeader::Tag(DOC_ID_LIMIT_KEY, docIdLimit));
 }
 
+FileChunk::DictionarySP
+FileChunk::readDictionary(const vespalib::GenericHeader &header, int compressionLevel)
+{
+    if (header.hasTag(ZSTD_DICTIONARY_KEY)) {
+        const vespalib::string & encoded = header.getTag(ZSTD_DICTIONARY_KEY).asString();
+        std::string content = vespalib::Base64::decode(encoded.c_str(), encoded.size());
+        return std::make_shared<vespalib::compression::ZStdDictionary>(vespalib::ConstBufferRef(content.data(), content.size()),
+                                                                       compressionLevel);
+    }
+    return DictionarySP();
+}
+
+void
+FileChunk::writeDictionary(vespalib::GenericHeader &header, const vespalib::compression::ZStdDictionary &dictionary)
+{
+    vespalib::ConstBufferRef content = dictionary.content();
+    header.putTag(vespalib::GenericHeader::Tag(ZSTD_DICTIONARY_KEY, vespalib::Base64::encode(content.c_str(), content.size())));
+}
+
 void
 FileChunk::verify(bool reportOnly) const
 {
@@ -496,7 +568,7 @@ FileChunk::verify(bool reportOnly) const
         vespalib::DataBuffer whole(0ul, ALIGNMENT);
         FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
         try {
-            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen());
+            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen(), false, _dictionary.get());
             assert(chunk.getLastSerial() >= lastSerial);
             lastSerial = chunk.getLastSerial();
             if (errorInPrev) {
@@ -21,6 +21,7 @@ namespace vespalib {
     class GenericHeader;
     class Executor;
 }
+namespace vespalib::compression { class ZStdDictionary; }
 
 namespace search {
 
@@ -106,6 +107,7 @@ public:
     using LidBufferMap = vespalib::hash_map<uint32_t, std::unique_ptr<vespalib::DataBuffer>>;
     using UP = std::unique_ptr<FileChunk>;
     using SubChunkId = uint32_t;
+    using DictionarySP = std::shared_ptr<const vespalib::compression::ZStdDictionary>;
     FileChunk(FileId fileId, NameId nameId, const vespalib::string &baseName, const TuneFileSummary &tune,
               const IBucketizer *bucketizer, bool skipCrcOnRead);
     virtual ~FileChunk();
@@ -160,6 +162,11 @@ public:
     size_t   getErasedBytes() const { return _erasedBytes; }
     uint64_t getLastPersistedSerialNum() const;
     uint32_t getDocIdLimit() const { return _docIdLimit; }
+    /**
+     * The zstd dictionary the chunks in this file are compressed with, if any.
+     * It is stored in the header of the data file.
+     */
+    const DictionarySP & getDictionary() const { return _dictionary; }
     virtual vespalib::system_time getModificationTime() const;
     virtual bool frozen() const { return true; }
     const vespalib::string & getName() const { return _name; }
@@ -195,6 +202,10 @@ public:
      */
     static uint64_t readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit);
     static uint64_t readDataHeader(FileRandRead &idxFile);
+    /**
+     * Read the zstd dictionary stored in the header of the given .dat file, if any.
+     */
+    static DictionarySP readDataDictionary(FileRandRead &datFile, uint64_t dataHeaderLen);
     static bool isIdxFileEmpty(const vespalib::string & name);
     static void eraseIdxFile(const vespalib::string & name);
     static void eraseDatFile(const vespalib::string & name);
@@ -237,8 +248,20 @@ protected:
     void setNumUniqueBuckets(size_t numUniqueBuckets) { _numUniqueBuckets = numUniqueBuckets; }
     ssize_t read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo, vespalib::DataBuffer & buffer) const;
     void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
+    /**
+     * The lids of a single chunk on file. The chunks of a multi lid read are fetched with
+     * a single batch read, so a reader that supports it can have them all in flight at once.
+     */
+    struct ChunkRun {
+        LidInfoWithLidV::const_iterator begin;
+        size_t                          count;
+        ChunkInfo                       chunkInfo;
+    };
+    void read(const std::vector<ChunkRun> & runs, IBufferVisitor & visitor) const;
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
+    static DictionarySP readDictionary(const vespalib::GenericHeader &header, int compressionLevel);
+    static void writeDictionary(vespalib::GenericHeader &header, const vespalib::compression::ZStdDictionary &dictionary);
 
     using ChunkInfoVector = vespalib::Array<ChunkInfo>;
     const IBucketizer   * _bucketizer;
@@ -253,6 +276,7 @@ protected:
     uint32_t              _numLids;
     uint32_t              _docIdLimit; // Limit when the file was created. Stored in idx file header.
     vespalib::system_time  _modificationTime;
+    DictionarySP          _dictionary;
 };
 
 } // namespace search
@@ -8,9 +8,11 @@
 #include <vespa/vespalib/util/memoryusage.h>
 #include <vespa/vespalib/util/time.h>
 #include <atomic>
+#include <memory>
 #include <vector>
 
 namespace vespalib { class DataBuffer; }
+namespace vespalib::compression { class ZStdDictionary; }
 namespace search {
 
 class IBufferVisitor;
@@ -40,6 +42,7 @@ class IDataStore : public common::ICompactableLidSpace
 {
 public:
     using LidVector = std::vector<uint32_t>;
+    using DictionarySP = std::shared_ptr<const vespalib::compression::ZStdDictionary>;
     /**
      * Construct an idata store.
      * A data store has a base directory. The rest is up to the implementation.
@@ -169,6 +172,12 @@ public:
      */
     virtual std::vector<DataStoreFileChunkStats> getFileChunkStats() const = 0;
 
+    /*
+     * Return the zstd dictionary currently used for compressing new data, if any.
+     * Caches compressing the same kind of data can use it too.
+     */
+    virtual DictionarySP getCompressionDictionary() const { return DictionarySP(); }
+
     /**
      * Get the number of entries (including removed IDs
      * or gaps in the local ID sequence) in the data store.
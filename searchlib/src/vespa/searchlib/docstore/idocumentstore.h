@@ -51,6 +51,12 @@ public:
     virtual ~IDocumentVisitor() = default;
     virtual void visit(uint32_t lid, DocumentUP doc) = 0;
     virtual bool allowVisitCaching() const = 0;
+    /**
+     * Whether documents not found in the document cache may be inserted in it when read.
+     * Only visitors with random access patterns similar to single document reads should
+     * allow this, bulk iteration would evict the documents that are actually hot.
+     */
+    virtual bool allowDocumentCaching() const { return false; }
 private:
 };
 
@@ -213,7 +213,7 @@ LogDataStore::requireSpace(MonitorGuard guard, WriteableFileChunk & active, CpuU
               active.getName().c_str(), oldSz, _config.getMaxFileSize(), active.getNumLids(), _config.getMaxNumLids());
     if ((oldSz > _config.getMaxFileSize()) || (active.getNumLids() >= _config.getMaxNumLids())) {
         FileId fileId = allocateFileId(guard);
-        setNewFileChunk(guard, createWritableFile(fileId, active.getSerialNum()));
+        setNewFileChunk(guard, createWritableFile(fileId, active.getSerialNum(), getDictionaryForNewFile(guard)));
         setActive(guard, fileId);
         std::unique_ptr<FileChunkHolder> activeHolder = holdFileChunk(active.getFileId());
         guard.unlock();
@@ -454,7 +454,8 @@ void LogDataStore::compactFile(FileId fileId)
         if ( ! shouldCompactToActiveFile(compacted_size)) {
             MonitorGuard guard(_updateLock);
             destinationFileId = allocateFileId(guard);
-            setNewFileChunk(guard, createWritableFile(destinationFileId, fc->getLastPersistedSerialNum(), fc->getNameId().next()));
+            setNewFileChunk(guard, createWritableFile(destinationFileId, fc->getLastPersistedSerialNum(), fc->getNameId().next(),
+                                                      getDictionaryForNewFile(guard)));
         }
         size_t numSignificantBucketBits = computeNumberOfSignificantBucketIdBits(*_bucketizer, fc->getFileId());
         compacter = std::make_unique<BucketCompacter>(numSignificantBucketBits, _config.compactCompression(), *this, _executor,
@@ -634,7 +635,7 @@ LogDataStore::createReadOnlyFile(FileId fileId, NameId nameId) {
 }
 
 FileChunk::UP
-LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId)
+LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId, DictionarySP dictionary)
 {
     for (const auto & fc : _fileChunks) {
         if (fc && (fc->getNameId() == nameId)) {
@@ -645,16 +646,25 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
     }
     uint32_t docIdLimit = (getDocIdLimit() != 0) ? getDocIdLimit() : std::numeric_limits<uint32_t>::max();
     auto file = std::make_unique< WriteableFileChunk>(_executor, fileId, nameId, getBaseDir(), serialNum,docIdLimit,
-                                                      _config.getFileConfig(), _tune, _fileHeaderContext,
+                                                      _config.getFileConfig(), std::move(dictionary), _tune, _fileHeaderContext,
                                                       _bucketizer.get(), _config.crcOnReadDisabled());
     file->enableRead();
     return file;
 }
 
 FileChunk::UP
-LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum)
+LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, DictionarySP dictionary)
 {
-    return createWritableFile(fileId, serialNum, NameId(vespalib::system_clock::now().time_since_epoch().count()));
+    return createWritableFile(fileId, serialNum, NameId(vespalib::system_clock::now().time_since_epoch().count()),
+                              std::move(dictionary));
+}
+
+FileChunk::DictionarySP
+LogDataStore::getDictionaryForNewFile(const MonitorGuard & guard) const
+{
+    return _config.getFileConfig().useDictionary()
+           ? getActive(guard).getDictionaryForNextFile()
+           : DictionarySP();
 }
 
 namespace {
@@ -781,10 +791,10 @@ LogDataStore::preload()
         }
         _fileChunks.push_back(isReadOnly()
             ? createReadOnlyFile(FileId(_fileChunks.size()), *partList.rbegin())
-            : createWritableFile(FileId(_fileChunks.size()), getMinLastPersistedSerialNum(), *partList.rbegin()));
+            : createWritableFile(FileId(_fileChunks.size()), getMinLastPersistedSerialNum(), *partList.rbegin(), DictionarySP()));
     } else {
         if ( ! isReadOnly() ) {
-            _fileChunks.push_back(createWritableFile(FileId::first(), 0));
+            _fileChunks.push_back(createWritableFile(FileId::first(), 0, DictionarySP()));
         } else {
             throw vespalib::IllegalArgumentException(getBaseDir() + " does not have any summary data... And that is no good in readonly case.");
         }
@@ -1187,6 +1197,13 @@ LogDataStore::getFileChunkStats() const
     return result;
 }
 
+IDataStore::DictionarySP
+LogDataStore::getCompressionDictionary() const
+{
+    MonitorGuard guard(_updateLock);
+    return _fileChunks[getActiveFileId(guard).getId()]->getDictionary();
+}
+
 void
 LogDataStore::compactLidSpace(uint32_t wantedDocLidLimit)
 {
@@ -169,6 +169,7 @@ public:
     DataStoreStorageStats getStorageStats() const override;
     vespalib::MemoryUsage getMemoryUsage() const override;
     std::vector<DataStoreFileChunkStats> getFileChunkStats() const override;
+    DictionarySP getCompressionDictionary() const override;
 
     void compactLidSpace(uint32_t wantedDocLidLimit) override;
     bool canShrinkLidSpace() const override;
@@ -215,8 +216,9 @@ private:
     double getMaxBucketSpread() const;
 
     FileChunk::UP createReadOnlyFile(FileId fileId, NameId nameId);
-    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum);
-    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId);
+    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, DictionarySP dictionary);
+    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId, DictionarySP dictionary);
+    DictionarySP getDictionaryForNewFile(const MonitorGuard & guard) const;
     vespalib::string createFileName(NameId id) const;
     vespalib::string createDatFileName(NameId id) const;
     vespalib::string createIdxFileName(NameId id) const;
@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 class FastOS_FileInterface;
 
@@ -16,8 +17,26 @@ class FileRandRead
 {
 public:
     using FSP = std::shared_ptr<FastOS_FileInterface>;
+    struct ReadRequest {
+        size_t                offset;
+        size_t                size;
+        vespalib::DataBuffer *buffer;
+    };
     virtual ~FileRandRead() { }
     virtual FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) = 0;
+    /**
+     * Performs all the reads in the batch. The returned files must be kept alive as long
+     * as the buffers are in use. The default is to read them one by one, while
+     * implementations that can have several reads in flight should override it.
+     */
+    virtual std::vector<FSP> readBatch(const std::vector<ReadRequest> & requests) {
+        std::vector<FSP> keepAlive;
+        keepAlive.reserve(requests.size());
+        for (const ReadRequest & request : requests) {
+            keepAlive.push_back(read(request.offset, *request.buffer, request.size));
+        }
+        return keepAlive;
+    }
     virtual int64_t getSize() = 0;
 };
 
@@ -2,14 +2,122 @@
 
 #include "randreaders.h"
 #include "summaryexceptions.h"
+#include <vespa/config.h>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/fastos/file.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#ifdef VESPA_HAS_IO_URING
+#include <liburing.h>
+// the 64 bit user data helpers and IORING_ASYNC_CANCEL_ANY are found in liburing 2.2 and later
+#if defined(IO_URING_CHECK_VERSION)
+#if !IO_URING_CHECK_VERSION(2, 2)
+#define HAS_URING_BATCH_READ 1
+#endif
+#elif defined(IORING_ASYNC_CANCEL_ANY)
+#define HAS_URING_BATCH_READ 1
+#endif
+#endif
 
 #include <vespa/log/log.h>
 LOG_SETUP(".search.docstore.randreaders");
 
 namespace search {
 
+#ifdef HAS_URING_BATCH_READ
+namespace {
+
+constexpr unsigned URING_QUEUE_DEPTH = 64;
+
+class URing {
+public:
+    URing() : _ring(), _ok(io_uring_queue_init(URING_QUEUE_DEPTH, &_ring, 0) == 0) { }
+    URing(const URing &) = delete;
+    URing & operator = (const URing &) = delete;
+    ~URing() {
+        if (_ok) {
+            io_uring_queue_exit(&_ring);
+        }
+    }
+    bool ok() const { return _ok; }
+    io_uring * get() { return &_ring; }
+private:
+    io_uring _ring;
+    bool     _ok;
+};
+
+thread_local std::unique_ptr<URing> _tlURing;
+
+// Returns the ring of this thread, or nullptr if io_uring is not usable here.
+io_uring *
+getURing()
+{
+    if ( ! _tlURing) {
+        _tlURing = std::make_unique<URing>();
+        if ( ! _tlURing->ok()) {
+            LOG(debug, "io_uring setup failed, falling back to synchronous reads");
+        }
+    }
+    return _tlURing->ok() ? _tlURing->get() : nullptr;
+}
+
+constexpr uint64_t CANCEL_TAG = ~uint64_t(0);
+
+/*
+ * Waits for the completion of inflight reads, recording the number of bytes read per request.
+ * Interrupted waits are retried. Returns false if waiting failed with reads still in flight.
+ */
+bool
+reapCompletions(io_uring * ring, size_t & inflight, std::vector<size_t> & done)
+{
+    while (inflight > 0) {
+        io_uring_cqe * cqe = nullptr;
+        int err = io_uring_wait_cqe(ring, &cqe);
+        if ((err == -EINTR) || (err == -EAGAIN)) {
+            continue;
+        }
+        if (err != 0) {
+            LOG(warning, "Waiting for io_uring completions failed: %s (%zu reads in flight)", strerror(-err), inflight);
+            return false;
+        }
+        uint64_t tag = io_uring_cqe_get_data64(cqe);
+        if (tag != CANCEL_TAG) {
+            if (cqe->res > 0) {
+                done[tag] = cqe->res;
+            }
+            inflight--;
+        }
+        io_uring_cqe_seen(ring, cqe);
+    }
+    return true;
+}
+
+// Asks the kernel to cancel all reads in the ring. Entries still waiting to be submitted are submitted first.
+void
+cancelInFlight(io_uring * ring, size_t & inflight)
+{
+    io_uring_sqe * sqe = io_uring_get_sqe(ring);
+    if (sqe == nullptr) {
+        int submitted = io_uring_submit(ring);
+        inflight += (submitted > 0) ? submitted : 0;
+        sqe = io_uring_get_sqe(ring);
+    }
+    if (sqe != nullptr) {
+        io_uring_prep_cancel64(sqe, 0, IORING_ASYNC_CANCEL_ANY);
+        io_uring_sqe_set_data64(sqe, CANCEL_TAG);
+        unsigned queued = io_uring_sq_ready(ring);
+        int submitted = io_uring_submit(ring);
+        if (submitted > 0) {
+            // The cancel request is last in the queue, and does not count as a read.
+            inflight += (unsigned(submitted) == queued) ? (submitted - 1) : submitted;
+        }
+    }
+}
+
+}
+#endif
+
 DirectIORandRead::DirectIORandRead(const vespalib::string & fileName)
     : _file(std::make_unique<FastOS_File>(fileName.c_str())),
       _alignment(1),
@@ -161,6 +269,101 @@ NormalRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
     return FSP();
 }
 
+URingRandRead::URingRandRead(const vespalib::string & fileName)
+    : _file(),
+      _fd(-1)
+{
+    auto file = std::make_unique<FastOS_File>(fileName.c_str());
+    if ( ! file->OpenReadOnly()) {
+        throw SummaryException("Failed opening data file", *file, VESPA_STRLOC);
+    }
+    _fd = file->getFileDescriptor();
+    _file = std::move(file);
+}
+
+FileRandRead::FSP
+URingRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
+{
+    // A single read gains nothing from being submitted through the ring.
+    buffer.clear();
+    buffer.ensureFree(sz);
+    _file->ReadBuf(buffer.getFree(), sz, offset);
+    buffer.moveFreeToData(sz);
+    return FSP();
+}
+
+void
+URingRandRead::readRemaining(const ReadRequest & request, size_t done)
+{
+    if (done < request.size) {
+        _file->ReadBuf(request.buffer->getFree() + done, request.size - done, request.offset + done);
+    }
+    request.buffer->moveFreeToData(request.size);
+}
+
+std::vector<FileRandRead::FSP>
+URingRandRead::readBatch(const std::vector<ReadRequest> & requests)
+{
+    for (const ReadRequest & request : requests) {
+        request.buffer->clear();
+        request.buffer->ensureFree(request.size);
+    }
+#ifdef HAS_URING_BATCH_READ
+    io_uring * ring = (requests.size() > 1) ? getURing() : nullptr;
+    if (ring != nullptr) {
+        std::vector<size_t> done(requests.size(), 0);
+        for (size_t first(0); first < requests.size(); first += URING_QUEUE_DEPTH) {
+            size_t last = std::min(requests.size(), first + URING_QUEUE_DEPTH);
+            for (size_t i(first); i < last; i++) {
+                const ReadRequest & request = requests[i];
+                io_uring_sqe * sqe = io_uring_get_sqe(ring);
+                assert(sqe != nullptr);
+                io_uring_prep_read(sqe, _fd, request.buffer->getFree(), request.size, request.offset);
+                io_uring_sqe_set_data64(sqe, i);
+            }
+            int submitted = io_uring_submit_and_wait(ring, last - first);
+            size_t inflight = (submitted > 0) ? submitted : 0;
+            bool intact = (inflight == (last - first));
+            // The kernel may write to the buffers until the reads have completed, so all submitted reads
+            // must be reaped (or cancelled and reaped) before the buffers are touched or the ring is closed.
+            if ( ! reapCompletions(ring, inflight, done)) {
+                intact = false;
+                cancelInFlight(ring, inflight);
+                if ( ! reapCompletions(ring, inflight, done)) {
+                    LOG_ABORT("Unable to reap io_uring reads that are still in flight");
+                }
+            }
+            if ( ! intact) {
+                // Never reuse a ring that might still hold unsubmitted entries referring to these buffers.
+                _tlURing.reset();
+                ring = nullptr;
+            }
+            // Short or failed reads, and anything not completed, are finished synchronously.
+            for (size_t i(first); i < last; i++) {
+                readRemaining(requests[i], done[i]);
+            }
+            if (ring == nullptr) {
+                for (size_t i(last); i < requests.size(); i++) {
+                    readRemaining(requests[i], 0);
+                }
+                break;
+            }
+        }
+        return {};
+    }
+#endif
+    for (const ReadRequest & request : requests) {
+        readRemaining(request, 0);
+    }
+    return {};
+}
+
+int64_t
+URingRandRead::getSize()
+{
+    return _file->GetSize();
+}
+
 int64_t
 NormalRandRead::getSize()
 {
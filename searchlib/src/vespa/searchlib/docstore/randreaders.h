@@ -50,6 +50,24 @@ private:
     std::mutex                                _lock;
 };
 
+/**
+ * Reads with io_uring, so that all the reads in a batch are in flight at the same time.
+ * Falls back to reading them one by one when io_uring is not available, either at
+ * compile time (no liburing, or liburing older than 2.2) or in the running kernel.
+ */
+class URingRandRead : public FileRandRead
+{
+public:
+    URingRandRead(const vespalib::string & fileName);
+    FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
+    std::vector<FSP> readBatch(const std::vector<ReadRequest> & requests) override;
+    int64_t getSize() override;
+private:
+    void readRemaining(const ReadRequest & request, size_t done);
+    std::unique_ptr<FastOS_FileInterface>  _file;
+    int                                    _fd;
+};
+
 class NormalRandRead : public FileRandRead
 {
 public:
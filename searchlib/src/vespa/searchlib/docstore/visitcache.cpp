@@ -77,7 +77,8 @@ BlobSet::get(uint32_t lid) const
 CompressedBlobSet::CompressedBlobSet() :
     _compression(CompressionConfig::Type::LZ4),
     _positions(),
-    _buffer()
+    _buffer(),
+    _dictionary()
 {
 }
 
@@ -85,14 +86,20 @@ CompressedBlobSet::~CompressedBlobSet() = default;
 
 
 CompressedBlobSet::CompressedBlobSet(CompressionConfig compression, const BlobSet & uncompressed) :
+    CompressedBlobSet(compression, uncompressed, DictionarySP())
+{
+}
+
+CompressedBlobSet::CompressedBlobSet(CompressionConfig compression, const BlobSet & uncompressed, DictionarySP dictionary) :
     _compression(compression.type),
     _positions(uncompressed.getPositions()),
-    _buffer()
+    _buffer(),
+    _dictionary(std::move(dictionary))
 {
     if ( ! _positions.empty() ) {
         DataBuffer compressed;
         ConstBufferRef org = uncompressed.getBuffer();
-        _compression = vespalib::compression::compress(compression, org, compressed, false);
+        _compression = vespalib::compression::compress(compression, org, compressed, false, _dictionary.get());
         _buffer = std::make_shared<vespalib::MallocPtr>(compressed.getDataLen());
         memcpy(*_buffer, compressed.getData(), compressed.getDataLen());
     } else {
@@ -108,7 +115,7 @@ CompressedBlobSet::getBlobSet() const
     DataBuffer uncompressed(0, 1, Alloc::alloc(0, 16 * MemoryAllocator::HUGEPAGE_SIZE));
     if ( ! _positions.empty() ) {
         decompress(_compression, getBufferSize(_positions),
-                   ConstBufferRef(_buffer->c_str(), _buffer->size()), uncompressed, false);
+                   ConstBufferRef(_buffer->c_str(), _buffer->size()), uncompressed, false, _dictionary.get());
     }
     return BlobSet(_positions, std::move(uncompressed).stealBuffer());
 }
@@ -144,7 +151,10 @@ bool
 VisitCache::BackingStore::read(const KeySet &key, CompressedBlobSet &blobs) const {
     VisitCollector collector;
     _backingStore.read(key.getKeys(), collector);
-    blobs = CompressedBlobSet(_compression.load(std::memory_order_relaxed), collector.getBlobSet());
+    CompressionConfig compression = _compression.load(std::memory_order_relaxed);
+    blobs = (compression.type == CompressionConfig::ZSTD)
+            ? CompressedBlobSet(compression, collector.getBlobSet(), _backingStore.getCompressionDictionary())
+            : CompressedBlobSet(compression, collector.getBlobSet());
     return ! blobs.empty();
 }
 
@@ -73,8 +73,13 @@ private:
 class CompressedBlobSet {
 public:
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using DictionarySP = IDataStore::DictionarySP;
     CompressedBlobSet();
     CompressedBlobSet(CompressionConfig compression, const BlobSet & uncompressed);
+    /**
+     * Compresses with the given zstd dictionary, which is kept alive for decompression.
+     */
+    CompressedBlobSet(CompressionConfig compression, const BlobSet & uncompressed, DictionarySP dictionary);
     CompressedBlobSet(CompressedBlobSet && rhs) = default;
     CompressedBlobSet & operator=(CompressedBlobSet && rhs) = default;
     CompressedBlobSet(const CompressedBlobSet & rhs) = default;
@@ -87,6 +92,7 @@ private:
     CompressionConfig::Type _compression;
     BlobSet::Positions      _positions;
     std::shared_ptr<vespalib::MallocPtr> _buffer;
+    DictionarySP            _dictionary;
 };
 
 /**
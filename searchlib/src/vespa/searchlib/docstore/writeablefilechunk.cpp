@@ -13,6 +13,7 @@
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".search.writeablefilechunk");
@@ -25,12 +26,15 @@ using vespalib::IllegalHeaderException;
 using vespalib::makeLambdaTask;
 using vespalib::make_string;
 using vespalib::nbostream;
+using vespalib::compression::ZStdDictionary;
 
 namespace search {
 
 namespace {
 
 const size_t Alignment = FileSettings::DIRECTIO_ALIGNMENT;
+// zstd recommends a sample of about 100 times the dictionary size.
+const size_t SampleBytesPerDictionaryByte = 100;
 
 }
 
@@ -74,6 +78,78 @@ private:
     vespalib::DataBuffer _buf;
 };
 
+/*
+ * Collects the first documents written to a file as a sample, and trains a
+ * zstd dictionary from it in the background once the sample is large enough.
+ * A dictionary is trained at most once per file; later documents are not sampled.
+ * It is shared with the training task, so the file can go away while training.
+ */
+class DictionaryTrainer
+{
+public:
+    DictionaryTrainer(size_t maxDictionaryBytes, int compressionLevel)
+        : _lock(),
+          _maxDictionaryBytes(maxDictionaryBytes),
+          _maxSampleBytes(maxDictionaryBytes * SampleBytesPerDictionaryByte),
+          _compressionLevel(compressionLevel),
+          _samples(),
+          _sampleSizes(),
+          _dictionary(),
+          _sampleComplete(false)
+    { }
+    // Returns true when the sample became large enough to train from.
+    bool addSample(const void * buffer, size_t len) {
+        std::lock_guard guard(_lock);
+        if ((len == 0) || _sampleComplete) {
+            return false;
+        }
+        const char * data = static_cast<const char *>(buffer);
+        _samples.insert(_samples.end(), data, data + len);
+        _sampleSizes.push_back(len);
+        _sampleComplete = (_samples.size() >= _maxSampleBytes);
+        return _sampleComplete;
+    }
+    void train() {
+        std::vector<char> samples;
+        std::vector<size_t> sampleSizes;
+        {
+            std::lock_guard guard(_lock);
+            samples.swap(_samples);
+            sampleSizes.swap(_sampleSizes);
+        }
+        std::vector<vespalib::ConstBufferRef> refs;
+        refs.reserve(sampleSizes.size());
+        size_t offset(0);
+        for (size_t sz : sampleSizes) {
+            refs.emplace_back(samples.data() + offset, sz);
+            offset += sz;
+        }
+        auto dictionary = ZStdDictionary::train(refs, _maxDictionaryBytes, _compressionLevel);
+        LOG(debug, "Trained zstd dictionary of %zu bytes from %zu samples of %zu bytes",
+            dictionary ? dictionary->content().size() : 0ul, sampleSizes.size(), samples.size());
+        std::lock_guard guard(_lock);
+        _dictionary = std::move(dictionary);
+    }
+    FileChunk::DictionarySP getDictionary() const {
+        std::lock_guard guard(_lock);
+        return _dictionary;
+    }
+    size_t getMemoryUsage() const {
+        std::lock_guard guard(_lock);
+        return _samples.capacity() + _sampleSizes.capacity() * sizeof(size_t);
+    }
+private:
+
+    mutable std::mutex      _lock;
+    const size_t            _maxDictionaryBytes;
+    const size_t            _maxSampleBytes;
+    const int               _compressionLevel;
+    std::vector<char>       _samples;
+    std::vector<size_t>     _sampleSizes;
+    FileChunk::DictionarySP _dictionary;
+    bool                    _sampleComplete;
+};
+
 WriteableFileChunk::
 WriteableFileChunk(vespalib::Executor &executor,
                    FileId fileId, NameId nameId,
@@ -81,6 +157,7 @@ WriteableFileChunk(vespalib::Executor &executor,
                    SerialNum initialSerialNum,
                    uint32_t docIdLimit,
                    const Config &config,
+                   DictionarySP dictionary,
                    const TuneFileSummary &tune,
                    const FileHeaderContext &fileHeaderContext,
                    const IBucketizer * bucketizer,
@@ -110,9 +187,14 @@ WriteableFileChunk(vespalib::Executor &executor,
       _writeMonitor(),
       _writeCond(),
       _executor(executor),
-      _bucketMap(bucketizer)
+      _bucketMap(bucketizer),
+      _dictionaryTrainer()
 {
     _docIdLimit = docIdLimit;
+    if (_config.useDictionary()) {
+        _dictionaryTrainer = std::make_shared<DictionaryTrainer>(_config.getMaxDictionaryBytes(),
+                                                                 _config.getCompression().compressionLevel);
+    }
     if (tune._write.getWantDirectIO()) {
         _dataFile.EnableDirectIO();
     }
@@ -122,6 +204,7 @@ WriteableFileChunk(vespalib::Executor &executor,
     if (_dataFile.OpenReadWrite()) {
         readDataHeader();
         if (_dataHeaderLen == 0) {
+            _dictionary = std::move(dictionary);
             writeDataHeader(fileHeaderContext);
         }
         _dataFile.SetPosition(_dataFile.GetSize());
@@ -255,11 +338,14 @@ WriteableFileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IB
             visitor.visit(entry._lid, vespalib::ConstBufferRef(entry._buf.get(), entry._size));
             entry._buf = vespalib::alloc::Alloc();
         }
+        std::vector<ChunkRun> runs;
+        runs.reserve(chunksOnFile.size());
         for (auto & it : chunksOnFile) {
             auto first = find_first(begin, it.first);
             auto last = seek_past(first, begin + count, it.first);
-            FileChunk::read(first, last - first, it.second, visitor);
+            runs.push_back({first, size_t(last - first), it.second});
         }
+        FileChunk::read(runs, visitor);
     } else {
         FileChunk::read(begin, count, visitor);
     }
@@ -300,7 +386,7 @@ WriteableFileChunk::internalFlush(uint32_t chunkId, uint64_t serialNum, CpuUsage
     if (_alignment > 1) {
         tmp->getBuf().ensureFree(active->getMaxPackSize(_config.getCompression()) + _alignment - 1);
     }
-    active->pack(serialNum, tmp->getBuf(), _config.getCompression());
+    active->pack(serialNum, tmp->getBuf(), _config.getCompression(), _dictionary.get());
     tmp->setPayLoad();
     if (_alignment > 1) {
         const size_t padAfter((_alignment - tmp->getPayLoad() % _alignment) % _alignment);
@@ -645,10 +731,22 @@ WriteableFileChunk::getMemoryUsage() const
     size_t pendingBytes = _pendingIdx + _pendingDat;
     result.incAllocatedBytes(pendingBytes);
     result.incUsedBytes(pendingBytes);
+    if (_dictionaryTrainer) {
+        size_t sampleBytes = _dictionaryTrainer->getMemoryUsage();
+        result.incAllocatedBytes(sampleBytes);
+        result.incUsedBytes(sampleBytes);
+    }
     result.merge(FileChunk::getMemoryUsage());
     return result;
 }
 
+FileChunk::DictionarySP
+WriteableFileChunk::getDictionaryForNextFile() const
+{
+    DictionarySP trained = _dictionaryTrainer ? _dictionaryTrainer->getDictionary() : DictionarySP();
+    return trained ? trained : _dictionary;
+}
+
 int32_t WriteableFileChunk::flushLastIfNonEmpty(bool force)
 {
     int32_t chunkId(-1);
@@ -740,6 +838,10 @@ WriteableFileChunk::append(uint64_t serialNum, uint32_t lid, const void * buffer
     size_t oldSz(_active->size());
     LidMeta lm = _active->append(lid, buffer, len);
     setDiskFootprint(FileChunk::getDiskFootprint() - oldSz + _active->size());
+    if (_dictionaryTrainer && _dictionaryTrainer->addSample(buffer, len)) {
+        auto task = makeLambdaTask([trainer = _dictionaryTrainer] { trainer->train(); });
+        _executor.execute(CpuUsage::wrap(std::move(task), cpu_category));
+    }
     return LidInfo(getFileId().getId(), _active->getId(), lm.size());
 }
 
@@ -752,6 +854,7 @@ WriteableFileChunk::readDataHeader()
         FileHeader h;
         _dataHeaderLen = h.readFile(_dataFile);
         _dataFile.SetPosition(_dataHeaderLen);
+        _dictionary = readDictionary(h, _config.getCompression().compressionLevel);
     } catch (IllegalHeaderException &e) {
         _dataFile.SetPosition(0);
         try {
@@ -818,6 +921,9 @@ WriteableFileChunk::writeDataHeader(const FileHeaderContext &fileHeaderContext)
     assert(_dataFile.GetPosition() == 0);
     fileHeaderContext.addTags(h, _dataFile.GetFileName());
     h.putTag(Tag("desc", "Log data store chunk data"));
+    if (_dictionary) {
+        writeDictionary(h, *_dictionary);
+    }
     _dataHeaderLen = h.writeFile(_dataFile);
 }
 
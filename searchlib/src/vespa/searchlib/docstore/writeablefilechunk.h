@@ -14,6 +14,7 @@ namespace search {
 
 class PendingChunk;
 class ProcessedChunk;
+class DictionaryTrainer;
 
 namespace common { class FileHeaderContext; }
 
@@ -27,25 +28,40 @@ public:
         Config() : Config({CompressionConfig::LZ4, 9, 60}, 0x10000) { }
 
         Config(CompressionConfig compression, size_t maxChunkBytes)
+            : Config(compression, maxChunkBytes, 0)
+        { }
+
+        Config(CompressionConfig compression, size_t maxChunkBytes, size_t maxDictionaryBytes)
             : _compression(compression),
-              _maxChunkBytes(maxChunkBytes)
+              _maxChunkBytes(maxChunkBytes),
+              _maxDictionaryBytes(maxDictionaryBytes)
         { }
 
         CompressionConfig getCompression() const { return _compression; }
         size_t getMaxChunkBytes() const { return _maxChunkBytes; }
+        /**
+         * Max size of the zstd dictionary trained from the documents written to a file,
+         * and used for compressing the chunks of the next file. 0 disables training.
+         */
+        size_t getMaxDictionaryBytes() const { return _maxDictionaryBytes; }
+        bool useDictionary() const {
+            return (_compression.type == CompressionConfig::ZSTD) && (_maxDictionaryBytes > 0);
+        }
         bool operator == (const Config & rhs) const {
-            return (_compression == rhs._compression) && (_maxChunkBytes == rhs._maxChunkBytes);
+            return (_compression == rhs._compression) && (_maxChunkBytes == rhs._maxChunkBytes) &&
+                   (_maxDictionaryBytes == rhs._maxDictionaryBytes);
         }
     private:
         CompressionConfig _compression;
         size_t _maxChunkBytes;
+        size_t _maxDictionaryBytes;
     };
 
 public:
     using UP = std::unique_ptr<WriteableFileChunk>;
     WriteableFileChunk(vespalib::Executor & executor, FileId fileId, NameId nameId,
                        const vespalib::string & baseName, uint64_t initialSerialNum,
-                       uint32_t docIdLimit, const Config & config,
+                       uint32_t docIdLimit, const Config & config, DictionarySP dictionary,
                        const TuneFileSummary &tune, const common::FileHeaderContext &fileHeaderContext,
                        const IBucketizer * bucketizer, bool crcOnReadDisabled);
     ~WriteableFileChunk() override;
@@ -69,6 +85,11 @@ public:
     void waitForDiskToCatchUpToNow() const;
     void flushPendingChunks(uint64_t serialNum);
     DataStoreFileChunkStats getStats() const override;
+    /**
+     * Returns the dictionary trained from the documents written to this file so far,
+     * or the one used by this file if training has not completed.
+     */
+    DictionarySP getDictionaryForNextFile() const;
 
     static uint64_t writeIdxHeader(const common::FileHeaderContext &fileHeaderContext, uint32_t docIdLimit, FastOS_FileInterface &file);
 private:
@@ -136,6 +157,7 @@ private:
     vespalib::Executor  & _executor;
     ProcessedChunkMap     _orderedChunks;
     BucketDensityComputer _bucketMap;
+    std::shared_ptr<DictionaryTrainer> _dictionaryTrainer;
 };
 
 } // namespace search
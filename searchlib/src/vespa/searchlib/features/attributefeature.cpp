@@ -122,6 +122,10 @@ public:
         o[3].as_number = 1;  // count
     }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<const feature_t *> inputs,
+                       feature_t *output) override;
 };
 
 class BoolAttributeExecutor final : public fef::FeatureExecutor {
@@ -237,6 +241,20 @@ SingleAttributeExecutor<T>::execute(uint32_t docId)
                      : util::getAsFeature(v);
 }
 
+template <typename T>
+void
+SingleAttributeExecutor<T>::execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                                          vespalib::ConstArrayRef<const feature_t *>,
+                                          feature_t *output)
+{
+    for (size_t i = 0; i < docids.size(); ++i) {
+        typename T::LoadedValueType v = _attribute.getFast(docids[i]);
+        output[i] = __builtin_expect(attribute::isUndefined(v), false)
+                    ? attribute::getUndefined<feature_t>()
+                    : util::getAsFeature(v);
+    }
+}
+
 template <typename BaseType>
 void
 ArrayAttributeExecutor<BaseType>::execute(uint32_t docId)
@@ -5,6 +5,7 @@
 #include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/fef/properties.h>
 #include <vespa/vespalib/util/stash.h>
+#include <algorithm>
 
 
 using namespace search::fef;
@@ -17,6 +18,14 @@ FirstPhaseExecutor::execute(uint32_t)
     outputs().set_number(0, inputs().get_number(0));
 }
 
+void
+FirstPhaseExecutor::execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                                  vespalib::ConstArrayRef<const feature_t *> inputs,
+                                  feature_t *output)
+{
+    std::copy(inputs[0], inputs[0] + docids.size(), output);
+}
+
 
 FirstPhaseBlueprint::FirstPhaseBlueprint() :
     Blueprint("firstPhase")
@@ -13,6 +13,10 @@ class FirstPhaseExecutor : public fef::FeatureExecutor {
 public:
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<const feature_t *> inputs,
+                       feature_t *output) override;
 };
     
 /**
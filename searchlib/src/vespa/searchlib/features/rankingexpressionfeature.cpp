@@ -76,6 +76,8 @@ public:
     CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(ConstArrayRef<uint32_t> docids, ConstArrayRef<const feature_t *> inputs, feature_t *output) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -195,6 +197,19 @@ CompiledRankingExpressionExecutor::execute(uint32_t)
     outputs().set_number(0, _ranking_function(_params.data()));
 }
 
+void
+CompiledRankingExpressionExecutor::execute_batch(ConstArrayRef<uint32_t> docids, ConstArrayRef<const feature_t *> inputs,
+                                                 feature_t *output)
+{
+    assert(inputs.size() == _params.size());
+    for (size_t doc = 0; doc < docids.size(); ++doc) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = inputs[i][doc];
+        }
+        output[doc] = _ranking_function(_params.data());
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 namespace {
@@ -0,0 +1,50 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "batch_feature_evaluator.h"
+#include <algorithm>
+#include <cassert>
+
+namespace search::fef {
+
+BatchFeatureEvaluator::BatchFeatureEvaluator()
+    : _stash(),
+      _steps(),
+      _result(nullptr)
+{
+}
+
+BatchFeatureEvaluator::~BatchFeatureEvaluator() = default;
+
+const feature_t *
+BatchFeatureEvaluator::add_const(feature_t value)
+{
+    _result = _stash.create_array<feature_t>(max_block_size, value).data();
+    return _result;
+}
+
+const feature_t *
+BatchFeatureEvaluator::add_step(FeatureExecutor &executor, const std::vector<const feature_t *> &inputs)
+{
+    assert(executor.supports_batch());
+    feature_t *output = _stash.create_array<feature_t>(max_block_size, 0.0).data();
+    auto step_inputs = _stash.copy_array<const feature_t *>(inputs);
+    _steps.push_back(Step{&executor, step_inputs, output});
+    _result = output;
+    return _result;
+}
+
+void
+BatchFeatureEvaluator::evaluate(vespalib::ConstArrayRef<uint32_t> docids, feature_t *result)
+{
+    assert(_result != nullptr);
+    for (size_t offset = 0; offset < docids.size(); offset += max_block_size) {
+        size_t block_size = std::min(max_block_size, docids.size() - offset);
+        vespalib::ConstArrayRef<uint32_t> block(docids.data() + offset, block_size);
+        for (const Step &step: _steps) {
+            step.executor->execute_batch(block, step.inputs, step.output);
+        }
+        std::copy(_result, _result + block_size, result + offset);
+    }
+}
+
+}
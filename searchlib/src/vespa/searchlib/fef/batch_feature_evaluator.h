@@ -0,0 +1,64 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "featureexecutor.h"
+#include <vespa/vespalib/util/arrayref.h>
+#include <vespa/vespalib/util/stash.h>
+#include <vector>
+
+namespace search::fef {
+
+/**
+ * Calculates a single number feature for a block of documents at a
+ * time. Each step runs one feature executor for all documents in the
+ * block, reading its inputs from the result buffers of earlier steps
+ * (or from buffers filled with constant values). Created by
+ * RankProgram::make_batch_evaluator when all the executors needed
+ * to calculate the feature support batch execution.
+ **/
+class BatchFeatureEvaluator
+{
+public:
+    static constexpr size_t max_block_size = 256;
+
+private:
+    struct Step {
+        FeatureExecutor                           *executor;
+        vespalib::ConstArrayRef<const feature_t *> inputs;
+        feature_t                                 *output;
+    };
+    vespalib::Stash   _stash;
+    std::vector<Step> _steps;
+    const feature_t  *_result;
+
+public:
+    using UP = std::unique_ptr<BatchFeatureEvaluator>;
+    BatchFeatureEvaluator();
+    BatchFeatureEvaluator(const BatchFeatureEvaluator &) = delete;
+    BatchFeatureEvaluator &operator=(const BatchFeatureEvaluator &) = delete;
+    ~BatchFeatureEvaluator();
+
+    /**
+     * Add a buffer where all values are the given constant. The last
+     * added buffer holds the result of the evaluation.
+     **/
+    const feature_t *add_const(feature_t value);
+
+    /**
+     * Add a step running the given executor. The inputs are buffers
+     * returned from earlier calls to add_const or add_step. The
+     * returned buffer holds the output of the step.
+     **/
+    const feature_t *add_step(FeatureExecutor &executor, const std::vector<const feature_t *> &inputs);
+
+    size_t num_steps() const { return _steps.size(); }
+
+    /**
+     * Calculate the feature for all the given documents, storing one
+     * value per document in result.
+     **/
+    void evaluate(vespalib::ConstArrayRef<uint32_t> docids, feature_t *result);
+};
+
+}
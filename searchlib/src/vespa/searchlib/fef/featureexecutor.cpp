@@ -2,6 +2,7 @@
 
 #include "featureexecutor.h"
 #include <vespa/vespalib/util/classname.h>
+#include <cstdlib>
 
 namespace search::fef {
 
@@ -20,6 +21,18 @@ FeatureExecutor::isPure()
     return false;
 }
 
+bool
+FeatureExecutor::supports_batch() const
+{
+    return false;
+}
+
+void
+FeatureExecutor::execute_batch(vespalib::ConstArrayRef<uint32_t>, vespalib::ConstArrayRef<const feature_t *>, feature_t *)
+{
+    abort();
+}
+
 void
 FeatureExecutor::handle_bind_inputs(vespalib::ConstArrayRef<LazyValue>)
 {
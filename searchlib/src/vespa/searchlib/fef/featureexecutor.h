@@ -148,6 +148,34 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Check if this feature executor is able to calculate its first
+     * output for a block of documents at a time (see
+     * execute_batch). This requires that the output depends only on
+     * number inputs and on data that can be looked up directly by
+     * docid, like attributes. Term match data is only unpacked for
+     * one document at a time and can not be used. It is always safe
+     * to let this method return false, which is the default.
+     *
+     * @return true if execute_batch is implemented
+     **/
+    virtual bool supports_batch() const;
+
+    /**
+     * Calculate the first output for a block of documents. The value
+     * of input i for document j is found in inputs[i][j], and the
+     * result for document j is stored in output[j]. The regular
+     * inputs and outputs of this executor are not used. Will only be
+     * called if supports_batch returns true.
+     *
+     * @param docids the local document ids being evaluated
+     * @param inputs one array of input values per input
+     * @param output where to store one value per document
+     **/
+    virtual void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                               vespalib::ConstArrayRef<const feature_t *> inputs,
+                               feature_t *output);
+
     /**
      * Make sure this executor has been executed for the given
      * document.
@@ -413,6 +413,38 @@ GlobalFilterUpperLimit::lookup(const Properties &props, double defaultValue)
     return lookupDouble(props, NAME, defaultValue);
 }
 
+const vespalib::string WeakAndBlockMax::NAME("vespa.matching.weakand.block_max");
+
+const bool WeakAndBlockMax::DEFAULT_VALUE(false);
+
+bool
+WeakAndBlockMax::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool
+WeakAndBlockMax::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
+const vespalib::string SortedTopK::NAME("vespa.matching.sorted_top_k");
+
+const bool SortedTopK::DEFAULT_VALUE(false);
+
+bool
+SortedTopK::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool
+SortedTopK::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
 } // namespace matching
 
 namespace softtimeout {
@@ -306,6 +306,34 @@ namespace matching {
         static double lookup(const Properties &props);
         static double lookup(const Properties &props, double defaultValue);
     };
+
+    /**
+     * Property to enable block-max weak and. Terms searching disk
+     * index posting lists with block max info are then scored by
+     * saturated term frequency, and blocks of documents that can not
+     * reach the score threshold are skipped. The default is false.
+     **/
+    struct WeakAndBlockMax {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
+
+    /**
+     * Property to enable sorted top-k matching. When the query is
+     * sorted in descending order by a single value integer attribute
+     * with fast-search, the query is only evaluated for a prefix of
+     * the documents in sort order that is large enough to contain
+     * the wanted hits. The total hit count is then a lower bound. The
+     * default is false.
+     **/
+    struct SortedTopK {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
 }
 
 namespace softtimeout {
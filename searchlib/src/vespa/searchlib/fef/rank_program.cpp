@@ -317,4 +317,64 @@ RankProgram::get_all_features(bool unbox_seeds) const
     return resolve(_resolver->getFeatureMap(), unbox_seeds);
 }
 
+BatchFeatureEvaluator::UP
+RankProgram::make_batch_evaluator() const
+{
+    const auto &specs = _resolver->getExecutorSpecs();
+    const auto &seeds = _resolver->getSeedMap();
+    if (seeds.size() != 1) {
+        return {};
+    }
+    auto seed = seeds.begin()->second;
+    if ((seed.output != 0) || specs[seed.executor].output_types[0].is_object()) {
+        return {};
+    }
+    // executors are ordered so that inputs always come before the executors using them
+    std::vector<bool> needed(seed.executor + 1, false);
+    needed[seed.executor] = true;
+    for (size_t i = seed.executor + 1; i-- > 0; ) {
+        if (!needed[i] || check_const(_executors[i]->outputs().get_raw(0))) {
+            continue;
+        }
+        if (!_executors[i]->supports_batch()) {
+            return {};
+        }
+        for (const auto &ref: specs[i].inputs) {
+            if (specs[ref.executor].output_types[ref.output].is_object()) {
+                return {};
+            }
+            if (!check_const(_executors[ref.executor]->outputs().get_raw(ref.output))) {
+                if (ref.output != 0) {
+                    return {};
+                }
+                needed[ref.executor] = true;
+            }
+        }
+    }
+    auto evaluator = std::make_unique<BatchFeatureEvaluator>();
+    std::vector<const feature_t *> buffers(seed.executor + 1, nullptr);
+    std::vector<const feature_t *> inputs;
+    for (size_t i = 0; i <= seed.executor; ++i) {
+        if (!needed[i]) {
+            continue;
+        }
+        const NumberOrObject *output = _executors[i]->outputs().get_raw(0);
+        if (check_const(output)) {
+            buffers[i] = evaluator->add_const(output->as_number);
+            continue;
+        }
+        inputs.clear();
+        for (const auto &ref: specs[i].inputs) {
+            const NumberOrObject *input_value = _executors[ref.executor]->outputs().get_raw(ref.output);
+            if (check_const(input_value)) {
+                inputs.push_back(evaluator->add_const(input_value->as_number));
+            } else {
+                inputs.push_back(buffers[ref.executor]);
+            }
+        }
+        buffers[i] = evaluator->add_step(*_executors[i], inputs);
+    }
+    return evaluator;
+}
+
 }
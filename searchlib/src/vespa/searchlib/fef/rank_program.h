@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "batch_feature_evaluator.h"
 #include "blueprintresolver.h"
 #include "featureexecutor.h"
 #include "properties.h"
@@ -92,6 +93,18 @@ public:
      * @params unbox_seeds make sure seeds values are numbers
      **/
     FeatureResolver get_all_features(bool unbox_seeds = true) const;
+
+    /**
+     * Create an evaluator calculating the single seed feature of this
+     * rank program for a block of documents at a time. This is only
+     * possible when the seed is a number and all non-const executors
+     * it depends on support batch execution using number inputs
+     * only. Since such executors do not use term match data, there is
+     * no need to unpack matches before using the evaluator.
+     *
+     * @return batch evaluator, or nullptr if not possible
+     **/
+    BatchFeatureEvaluator::UP make_batch_evaluator() const;
 };
 
 }
@@ -69,6 +69,8 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _softTimeoutFactor(0.5),
       _global_filter_lower_limit(0.0),
       _global_filter_upper_limit(1.0),
+      _weakand_block_max(false),
+      _sorted_top_k(false),
       _mutateOnMatch(),
       _mutateOnFirstPhase(),
       _mutateOnSecondPhase(),
@@ -122,6 +124,8 @@ RankSetup::configure()
     setSoftTimeoutFactor(softtimeout::Factor::lookup(_indexEnv.getProperties()));
     set_global_filter_lower_limit(matching::GlobalFilterLowerLimit::lookup(_indexEnv.getProperties()));
     set_global_filter_upper_limit(matching::GlobalFilterUpperLimit::lookup(_indexEnv.getProperties()));
+    set_weakand_block_max(matching::WeakAndBlockMax::lookup(_indexEnv.getProperties()));
+    set_sorted_top_k(matching::SortedTopK::lookup(_indexEnv.getProperties()));
     _mutateOnMatch._attribute = mutate::on_match::Attribute::lookup(_indexEnv.getProperties());
     _mutateOnMatch._operation = mutate::on_match::Operation::lookup(_indexEnv.getProperties());
     _mutateOnFirstPhase._attribute = mutate::on_first_phase::Attribute::lookup(_indexEnv.getProperties());
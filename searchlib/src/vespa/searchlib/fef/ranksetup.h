@@ -77,6 +77,8 @@ private:
     double                   _softTimeoutFactor;
     double                   _global_filter_lower_limit;
     double                   _global_filter_upper_limit;
+    bool                     _weakand_block_max;
+    bool                     _sorted_top_k;
     MutateOperation          _mutateOnMatch;
     MutateOperation          _mutateOnFirstPhase;
     MutateOperation          _mutateOnSecondPhase;
@@ -408,6 +410,10 @@ public:
     double get_global_filter_lower_limit() const { return _global_filter_lower_limit; }
     void set_global_filter_upper_limit(double v) { _global_filter_upper_limit = v; }
     double get_global_filter_upper_limit() const { return _global_filter_upper_limit; }
+    void set_weakand_block_max(bool v) { _weakand_block_max = v; }
+    bool get_weakand_block_max() const { return _weakand_block_max; }
+    void set_sorted_top_k(bool v) { _sorted_top_k = v; }
+    bool get_sorted_top_k() const { return _sorted_top_k; }
 
     /**
      * This method may be used to indicate that certain features
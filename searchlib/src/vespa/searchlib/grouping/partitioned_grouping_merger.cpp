@@ -0,0 +1,53 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "partitioned_grouping_merger.h"
+#include <vespa/searchlib/aggregation/grouping.h>
+#include <cassert>
+
+namespace search::grouping {
+
+using aggregation::Group;
+using aggregation::Grouping;
+
+PartitionedGroupingMerger::PartitionedGroupingMerger(std::vector<Grouping *> inputs, uint32_t num_partitions)
+    : _inputs(std::move(inputs)),
+      _partitions(_inputs.size())
+{
+    assert(!_inputs.empty());
+    assert(num_partitions > 0);
+    for (auto & partitions : _partitions) {
+        partitions.resize(num_partitions);
+    }
+}
+
+PartitionedGroupingMerger::~PartitionedGroupingMerger() = default;
+
+void
+PartitionedGroupingMerger::split(uint32_t input_id)
+{
+    _inputs[input_id]->root().partitionChildren(_partitions[input_id]);
+}
+
+void
+PartitionedGroupingMerger::merge_partition(uint32_t partition_id)
+{
+    Grouping & target = *_inputs[0];
+    Group & partition = _partitions[0][partition_id];
+    for (uint32_t i = 1; i < _inputs.size(); ++i) {
+        // First level groups are children of the (level 0) root
+        partition.mergeChildren(target.levels(), target.getFirstLevel(), 0, _partitions[i][partition_id]);
+    }
+}
+
+void
+PartitionedGroupingMerger::finish()
+{
+    Grouping & target = *_inputs[0];
+    for (uint32_t i = 1; i < _inputs.size(); ++i) {
+        target.merge(*_inputs[i]); // Only merges the root groups, first level groups have been moved
+    }
+    target.root().joinChildren(_partitions[0]);
+    _partitions.clear();
+}
+
+}
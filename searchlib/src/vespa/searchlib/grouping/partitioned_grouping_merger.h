@@ -0,0 +1,43 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/searchlib/aggregation/group.h>
+#include <vector>
+
+namespace search::aggregation { class Grouping; }
+
+namespace search::grouping {
+
+/**
+ * Merges the results of the same grouping request aggregated by
+ * several threads into the first input.
+ *
+ * The first level groups of each input are moved into partitions,
+ * selected by the hash of the group id. Each partition is then merged
+ * across all inputs independently of the other partitions before the
+ * merged partitions are moved back into the first input.
+ *
+ * split() must be called for all inputs before merge_partition() is
+ * called for any partition, and finish() must be called when all
+ * partitions have been merged. Calls for different inputs or for
+ * different partitions can be made concurrently. After finish() the
+ * first level groups of the first input are not ordered by id, cf.
+ * Grouping::postMerge() and Grouping::sortById().
+ **/
+class PartitionedGroupingMerger
+{
+    std::vector<aggregation::Grouping *>          _inputs;
+    std::vector<std::vector<aggregation::Group>> _partitions; // [input][partition]
+public:
+    PartitionedGroupingMerger(std::vector<aggregation::Grouping *> inputs, uint32_t num_partitions);
+    PartitionedGroupingMerger(const PartitionedGroupingMerger &) = delete;
+    PartitionedGroupingMerger & operator = (const PartitionedGroupingMerger &) = delete;
+    ~PartitionedGroupingMerger();
+    uint32_t get_num_inputs() const noexcept { return _inputs.size(); }
+    uint32_t get_num_partitions() const noexcept { return _partitions.empty() ? 0u : _partitions[0].size(); }
+    void split(uint32_t input_id);
+    void merge_partition(uint32_t partition_id);
+    void finish();
+};
+
+}
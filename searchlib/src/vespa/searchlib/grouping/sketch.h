@@ -7,6 +7,7 @@
 #include <lz4.h>
 #include <vespa/searchlib/common/identifiable.h>
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 #include <vespa/vespalib/objects/deserializer.h>
 #include <vespa/vespalib/objects/identifiable.h>
 #include <vespa/vespalib/objects/serializer.h>
@@ -175,8 +176,7 @@ struct NormalSketch : Sketch<BucketBits, HashT> {
     }
 
     void merge(const NormalSketch<BucketBits, HashT> &other) {
-        std::transform(bucket, bucket + BUCKET_COUNT, other.bucket, bucket,
-                       [](uint8_t a, uint8_t b) { return std::max(a, b); });
+        vespalib::hwaccelrated::IAccelrated::getAccelerator().maxUint8(bucket, other.bucket, BUCKET_COUNT);
     }
 
     void merge(const SparseSketch<BucketBits, HashT> &other) {
@@ -201,6 +201,7 @@ void SparseSketch<BucketBits, HashT>::
 deserialize(vespalib::Deserializer &is) {
     uint32_t size;
     is >> size;
+    hash_set.reserve(size);
     for (uint32_t i = 0; i < size; ++i) {
         uint32_t hash;
         is >> hash;
@@ -36,6 +36,13 @@ public:
      */
     virtual void readCounts(const PostingListCounts &counts) = 0;
 
+    /**
+     * Skip posting lists with the given total bit length without
+     * decoding them. Used between words, i.e. counts for the skipped
+     * words are not passed to readCounts().
+     */
+    virtual void skip_posting_lists(uint64_t bit_length) = 0;
+
     /**
      * Open posting list file for sequential read.
      */
@@ -88,6 +95,14 @@ public:
      */
     virtual void flushWord() = 0;
 
+    /**
+     * Copy the posting list for the next word from a posting list file
+     * written with the same parameters, positioned at the start of the
+     * word. Bit lengths in counts are adjusted if the encoding depends
+     * on the position in the file.
+     */
+    virtual void copy_posting_list(PostingListFileSeqRead &source, PostingListCounts &counts) = 0;
+
     /**
      * Open posting list file for sequential write.
      */
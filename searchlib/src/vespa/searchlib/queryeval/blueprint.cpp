@@ -17,6 +17,8 @@
 #include <vespa/vespalib/util/classname.h>
 #include <vespa/vespalib/util/require.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <algorithm>
+#include <functional>
 #include <type_traits>
 #include <map>
 
@@ -92,6 +94,8 @@ Blueprint::sat_sum(const std::vector<HitEstimate> &data, uint32_t docid_limit)
 Blueprint::State::State(const FieldSpecBaseList &fields_in)
     : _fields(fields_in),
       _estimate(),
+      _cost(1.0),
+      _strict_cost(1.0),
       _cost_tier(COST_TIER_NORMAL),
       _tree_size(1),
       _allow_termwise_eval(true),
@@ -134,6 +138,15 @@ Blueprint::set_global_filter(const GlobalFilter &, double)
 {
 }
 
+void
+Blueprint::set_global_filter_batch(const std::vector<Blueprint *> &batch,
+                                   const GlobalFilter &global_filter, double estimated_hit_ratio)
+{
+    for (Blueprint *blueprint : batch) {
+        blueprint->set_global_filter(global_filter, estimated_hit_ratio);
+    }
+}
+
 const Blueprint &
 Blueprint::root() const
 {
@@ -335,6 +348,8 @@ Blueprint::visitMembers(vespalib::ObjectVisitor &visitor) const
     visitor.visitBool("empty", state.estimate().empty);
     visitor.visitInt("estHits", state.estimate().estHits);
     visitor.visitInt("cost_tier", state.cost_tier());
+    visitor.visitFloat("cost", state.cost());
+    visitor.visitFloat("strict_cost", state.strict_cost());
     visitor.visitInt("tree_size", state.tree_size());
     visitor.visitBool("allow_termwise_eval", state.allow_termwise_eval());
     visitor.closeStruct();
@@ -374,6 +389,7 @@ IntermediateBlueprint::setDocIdLimit(uint32_t limit)
     for (Blueprint::UP &child : _children) {
         child->setDocIdLimit(limit);
     }
+    notifyChange(); // cost depends on the hit ratio of children
 }
 
 Blueprint::HitEstimate
@@ -397,6 +413,26 @@ IntermediateBlueprint::calculate_cost_tier() const
     return cost_tier;
 }
 
+double
+IntermediateBlueprint::calculate_cost() const
+{
+    double cost = 0.0;
+    for (const Blueprint::UP &child : _children) {
+        cost += child->cost();
+    }
+    return cost;
+}
+
+double
+IntermediateBlueprint::calculate_strict_cost() const
+{
+    double strict_cost = 0.0;
+    for (const Blueprint::UP &child : _children) {
+        strict_cost += child->strict_cost();
+    }
+    return strict_cost;
+}
+
 uint32_t
 IntermediateBlueprint::calculate_tree_size() const
 {
@@ -495,6 +531,8 @@ IntermediateBlueprint::calculateState() const
     State state(exposeFields());
     state.estimate(calculateEstimate());
     state.cost_tier(calculate_cost_tier());
+    state.cost(calculate_cost());
+    state.strict_cost(calculate_strict_cost());
     state.allow_termwise_eval(infer_allow_termwise_eval());
     state.want_global_filter(infer_want_global_filter());
     state.tree_size(calculate_tree_size());
@@ -535,16 +573,39 @@ IntermediateBlueprint::optimize(Blueprint* &self)
     }
     optimize_self();
     sort(_children);
+    notifyChange(); // cost depends on the order of children
     maybe_eliminate_self(self, get_replacement());
 }
 
 void
 IntermediateBlueprint::set_global_filter(const GlobalFilter &global_filter, double estimated_hit_ratio)
 {
+    std::vector<std::pair<const void *, Blueprint *>> batched;
     for (auto & child : _children) {
         if (child->getState().want_global_filter()) {
-            child->set_global_filter(global_filter, estimated_hit_ratio);
+            const void *key = child->global_filter_batch_key();
+            if (key != nullptr) {
+                batched.emplace_back(key, child.get());
+            } else {
+                child->set_global_filter(global_filter, estimated_hit_ratio);
+            }
+        }
+    }
+    std::stable_sort(batched.begin(), batched.end(),
+                     [](const auto &a, const auto &b) { return std::less<const void *>()(a.first, b.first); });
+    for (auto itr = batched.begin(); itr != batched.end(); ) {
+        const void *key = itr->first;
+        auto group_end = std::find_if(itr, batched.end(), [key](const auto &elem) { return elem.first != key; });
+        if (std::distance(itr, group_end) == 1) {
+            itr->second->set_global_filter(global_filter, estimated_hit_ratio);
+        } else {
+            std::vector<Blueprint *> batch;
+            for (auto batch_itr = itr; batch_itr != group_end; ++batch_itr) {
+                batch.push_back(batch_itr->second);
+            }
+            itr->second->set_global_filter_batch(batch, global_filter, estimated_hit_ratio);
         }
+        itr = group_end;
     }
 }
 
@@ -685,13 +746,28 @@ IntermediateBlueprint::calculateUnpackInfo(const fef::MatchData & md) const
 //-----------------------------------------------------------------------------
 
 LeafBlueprint::LeafBlueprint(const FieldSpecBaseList &fields, bool allow_termwise_eval)
-    : _state(fields)
+    : _state(fields),
+      _fixed_strict_cost()
 {
     _state.allow_termwise_eval(allow_termwise_eval);
+    update_strict_cost();
 }
 
 LeafBlueprint::~LeafBlueprint() = default;
 
+void
+LeafBlueprint::update_strict_cost()
+{
+    _state.strict_cost(_fixed_strict_cost.value_or(_state.hit_ratio(get_docid_limit()) * _state.cost()));
+}
+
+void
+LeafBlueprint::setDocIdLimit(uint32_t limit)
+{
+    Blueprint::setDocIdLimit(limit);
+    update_strict_cost();
+}
+
 void
 LeafBlueprint::fetchPostings(const ExecuteInfo &execInfo)
 {
@@ -733,6 +809,7 @@ void
 LeafBlueprint::setEstimate(HitEstimate est)
 {
     _state.estimate(est);
+    update_strict_cost();
     notifyChange();
 }
 
@@ -743,6 +820,22 @@ LeafBlueprint::set_cost_tier(uint32_t value)
     notifyChange();
 }
 
+void
+LeafBlueprint::set_cost(double value)
+{
+    _state.cost(value);
+    update_strict_cost();
+    notifyChange();
+}
+
+void
+LeafBlueprint::set_strict_cost(double value)
+{
+    _fixed_strict_cost = value;
+    update_strict_cost();
+    notifyChange();
+}
+
 void
 LeafBlueprint::set_allow_termwise_eval(bool value)
 {
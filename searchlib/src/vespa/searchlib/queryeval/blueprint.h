@@ -8,6 +8,8 @@
 #include "global_filter.h"
 #include "multisearch.h"
 #include <vespa/searchlib/common/bitvector.h>
+#include <limits>
+#include <optional>
 
 namespace vespalib { class ObjectVisitor; }
 namespace vespalib::slime {
@@ -66,6 +68,8 @@ public:
     private:
         FieldSpecBaseList _fields;
         HitEstimate       _estimate;
+        double            _cost;
+        double            _strict_cost;
         uint32_t          _cost_tier;
         uint32_t          _tree_size;
         bool              _allow_termwise_eval;
@@ -104,6 +108,12 @@ public:
             uint32_t total_docs = std::max(total_hits, docid_limit);
             return (total_docs == 0) ? 0.0 : double(total_hits) / double(total_docs);
         }
+        // relative cost of checking a single document when not strict
+        void cost(double value) { _cost = value; }
+        double cost() const { return _cost; }
+        // relative cost per document in the corpus when producing all hits strictly
+        void strict_cost(double value) { _strict_cost = value; }
+        double strict_cost() const { return _strict_cost; }
         void tree_size(uint32_t value) { _tree_size = value; }
         uint32_t tree_size() const { return _tree_size; }
         void allow_termwise_eval(bool value) { _allow_termwise_eval = value; }
@@ -150,6 +160,52 @@ public:
         }
     };
 
+    // Order children of AND-like operators by how cheaply they reject
+    // documents (cost / (1 - hit_ratio)), higher tiers last. Falls
+    // back to the lesser estimate when the cost model is undecided.
+    struct TieredLessCost {
+        static double key(const Blueprint &bp) {
+            double rejected = 1.0 - bp.hit_ratio();
+            return (rejected <= 0.0) ? std::numeric_limits<double>::infinity() : (bp.getState().cost() / rejected);
+        }
+        bool operator () (const auto &a, const auto &b) const {
+            const auto &lhs = a->getState();
+            const auto &rhs = b->getState();
+            if (lhs.cost_tier() != rhs.cost_tier()) {
+                return (lhs.cost_tier() < rhs.cost_tier());
+            }
+            double lhs_key = key(*a);
+            double rhs_key = key(*b);
+            if (lhs_key != rhs_key) {
+                return (lhs_key < rhs_key);
+            }
+            return (lhs.estimate() < rhs.estimate());
+        }
+    };
+
+    // Order children of OR-like operators by how cheaply they accept
+    // documents (cost / hit_ratio), higher tiers last. Falls back to
+    // the greater estimate when the cost model is undecided.
+    struct TieredGreaterCost {
+        static double key(const Blueprint &bp) {
+            double accepted = bp.hit_ratio();
+            return (accepted <= 0.0) ? std::numeric_limits<double>::infinity() : (bp.getState().cost() / accepted);
+        }
+        bool operator () (const auto &a, const auto &b) const {
+            const auto &lhs = a->getState();
+            const auto &rhs = b->getState();
+            if (lhs.cost_tier() != rhs.cost_tier()) {
+                return (lhs.cost_tier() < rhs.cost_tier());
+            }
+            double lhs_key = key(*a);
+            double rhs_key = key(*b);
+            if (lhs_key != rhs_key) {
+                return (lhs_key < rhs_key);
+            }
+            return (rhs.estimate() < lhs.estimate());
+        }
+    };
+
 private:
     Blueprint *_parent;
     uint32_t   _sourceId;
@@ -215,10 +271,28 @@ public:
      */
     virtual void set_global_filter(const GlobalFilter &global_filter, double estimated_hit_ratio);
 
+    /**
+     * Sibling blueprints wanting the global filter that return the same (non-null) key are
+     * given the global filter together, by calling set_global_filter_batch() on the first
+     * of them. This lets them share work, e.g. when searching the same index. A key must
+     * only be returned by blueprints of the same type.
+     */
+    virtual const void *global_filter_batch_key() const noexcept { return nullptr; }
+
+    /**
+     * Sets the global filter on all the given blueprints, which have the same batch key as
+     * this one (see global_filter_batch_key()). The default implementation calls
+     * set_global_filter() on each of them.
+     */
+    virtual void set_global_filter_batch(const std::vector<Blueprint *> &batch,
+                                         const GlobalFilter &global_filter, double estimated_hit_ratio);
+
     virtual const State &getState() const = 0;
     const Blueprint &root() const;
 
-    double hit_ratio() const { return getState().hit_ratio(_docid_limit); }        
+    double hit_ratio() const { return getState().hit_ratio(_docid_limit); }
+    double cost() const { return getState().cost(); }
+    double strict_cost() const { return getState().strict_cost(); }
 
     virtual void fetchPostings(const ExecuteInfo &execInfo) = 0;
     virtual void freeze() = 0;
@@ -288,6 +362,8 @@ private:
     Children _children;
     HitEstimate calculateEstimate() const;
     uint32_t calculate_cost_tier() const;
+    virtual double calculate_cost() const;
+    virtual double calculate_strict_cost() const;
     uint32_t calculate_tree_size() const;
     bool infer_allow_termwise_eval() const;
     bool infer_want_global_filter() const;
@@ -347,12 +423,19 @@ public:
 class LeafBlueprint : public Blueprint
 {
 private:
-    State _state;
+    State                 _state;
+    std::optional<double> _fixed_strict_cost;
+
+    void update_strict_cost();
 
 protected:
     void optimize(Blueprint* &self) final;
     void setEstimate(HitEstimate est);
     void set_cost_tier(uint32_t value);
+    // cost of checking a single document, 1.0 being a posting list seek
+    void set_cost(double value);
+    // strict cost defaults to hit_ratio * cost, i.e. proportional to the number of hits
+    void set_strict_cost(double value);
     void set_allow_termwise_eval(bool value);
     void set_want_global_filter(bool value);
     void set_tree_size(uint32_t value);
@@ -361,7 +444,7 @@ protected:
 public:
     ~LeafBlueprint() override;
     const State &getState() const final { return _state; }
-    void setDocIdLimit(uint32_t limit) final { Blueprint::setDocIdLimit(limit); }
+    void setDocIdLimit(uint32_t limit) final;
     void fetchPostings(const ExecuteInfo &execInfo) override;
     void freeze() final;
     SearchIteratorUP createSearch(fef::MatchData &md, bool strict) const override;
@@ -17,7 +17,8 @@ FakeRequestContext::FakeRequestContext(attribute::IAttributeContext * context, v
       _attributeContext(context),
       _query_tensor_name(),
       _query_tensor(),
-      _attribute_blueprint_params()
+      _attribute_blueprint_params(),
+      _weakand_block_max(false)
 {
 }
 
@@ -47,6 +47,8 @@ public:
     }
 
     const search::attribute::AttributeBlueprintParams& get_attribute_blueprint_params() const override;
+    bool use_weakand_block_max() const override { return _weakand_block_max; }
+    void set_weakand_block_max(bool value) { _weakand_block_max = value; }
 
 private:
     std::unique_ptr<vespalib::TestClock> _clock;
@@ -55,6 +57,7 @@ private:
     vespalib::string _query_tensor_name;
     std::unique_ptr<vespalib::eval::Value> _query_tensor;
     search::attribute::AttributeBlueprintParams _attribute_blueprint_params;
+    bool _weakand_block_max;
 };
 
 }
@@ -11,6 +11,7 @@
 #include "isourceselector.h"
 #include "field_spec.hpp"
 #include <vespa/searchlib/queryeval/wand/weak_and_search.h>
+#include <algorithm>
 
 namespace search::queryeval {
 
@@ -83,6 +84,69 @@ need_normal_features_for_children(const IntermediateBlueprint &blueprint, fef::M
     }
 }
 
+// Cost of evaluating AND-like children in their current order, where
+// each child is only asked about documents matched by earlier children.
+double
+and_cost(const Blueprint::Children &children)
+{
+    double flow = 1.0;
+    double cost = 0.0;
+    for (const auto &child : children) {
+        cost += flow * child->cost();
+        flow *= child->hit_ratio();
+    }
+    return cost;
+}
+
+// Later children in the same cost tier as the driving child may be
+// made strict when iterating all their hits is cheaper than seeking
+// them for every candidate document.
+bool
+cheaper_as_strict(const Blueprint &driver, const Blueprint &child, double flow)
+{
+    return ((child.getState().cost_tier() == driver.getState().cost_tier()) &&
+            (child.strict_cost() < flow * child.cost()));
+}
+
+// Cost of strict evaluation of AND-like children with children[first]
+// driving the iteration and the other children in their current order.
+double
+and_strict_cost(const Blueprint::Children &children, size_t first, bool allow_strict_children)
+{
+    const Blueprint &driver = *children[first];
+    double flow = driver.hit_ratio();
+    double cost = driver.strict_cost();
+    for (size_t i = 0; i < children.size(); ++i) {
+        if (i != first) {
+            const Blueprint &child = *children[i];
+            bool strict = allow_strict_children && cheaper_as_strict(driver, child, flow);
+            cost += strict ? child.strict_cost() : (flow * child.cost());
+            flow *= child.hit_ratio();
+        }
+    }
+    return cost;
+}
+
+// Cost of children where only the first child is evaluated for all
+// documents and the others are only evaluated for its hits. Negative
+// children stop evaluation for documents they match.
+double
+first_child_cost(const Blueprint::Children &children, double first_cost, bool negative_rest)
+{
+    if (children.empty()) {
+        return 0.0;
+    }
+    double flow = children[0]->hit_ratio();
+    double cost = first_cost;
+    for (size_t i = 1; i < children.size(); ++i) {
+        cost += flow * children[i]->cost();
+        if (negative_rest) {
+            flow *= (1.0 - children[i]->hit_ratio());
+        }
+    }
+    return cost;
+}
+
 } // namespace search::queryeval::<unnamed>
 
 //-----------------------------------------------------------------------------
@@ -135,11 +199,25 @@ AndNotBlueprint::get_replacement()
     return Blueprint::UP();
 }
 
+double
+AndNotBlueprint::calculate_cost() const
+{
+    const auto &children = get_children();
+    return first_child_cost(children, children.empty() ? 0.0 : children[0]->cost(), true);
+}
+
+double
+AndNotBlueprint::calculate_strict_cost() const
+{
+    const auto &children = get_children();
+    return first_child_cost(children, children.empty() ? 0.0 : children[0]->strict_cost(), true);
+}
+
 void
 AndNotBlueprint::sort(Children &children) const
 {
     if (children.size() > 2) {
-        std::sort(children.begin() + 1, children.end(), TieredGreaterEstimate());
+        std::sort(children.begin() + 1, children.end(), TieredGreaterCost());
     }
 }
 
@@ -216,16 +294,55 @@ AndBlueprint::get_replacement()
     return Blueprint::UP();
 }
 
+double
+AndBlueprint::calculate_cost() const
+{
+    return and_cost(get_children());
+}
+
+double
+AndBlueprint::calculate_strict_cost() const
+{
+    const auto &children = get_children();
+    return children.empty() ? 0.0 : and_strict_cost(children, 0, true);
+}
+
 void
 AndBlueprint::sort(Children &children) const
 {
-    std::sort(children.begin(), children.end(), TieredLessEstimate());
+    std::sort(children.begin(), children.end(), TieredLessCost());
+    // The first child drives strict evaluation. The cheapest child to
+    // evaluate for all documents is not necessarily the best driver,
+    // so pick the one giving the lowest total strict cost.
+    size_t best = 0;
+    if (children.size() > 1) {
+        double best_cost = and_strict_cost(children, 0, true);
+        uint32_t cost_tier = children[0]->getState().cost_tier();
+        for (size_t i = 1; (i < children.size()) && (children[i]->getState().cost_tier() == cost_tier); ++i) {
+            double cost = and_strict_cost(children, i, true);
+            if (cost < best_cost) {
+                best = i;
+                best_cost = cost;
+            }
+        }
+    }
+    if (best > 0) {
+        std::rotate(children.begin(), children.begin() + best, children.begin() + best + 1);
+    }
 }
 
 bool
 AndBlueprint::inheritStrict(size_t i) const
 {
-    return (i == 0);
+    const auto &children = get_children();
+    if ((i == 0) || (i >= children.size())) {
+        return (i == 0);
+    }
+    double flow = 1.0;
+    for (size_t j = 0; j < i; ++j) {
+        flow *= children[j]->hit_ratio();
+    }
+    return cheaper_as_strict(*children[0], *children[i], flow);
 }
 
 SearchIterator::UP
@@ -310,7 +427,7 @@ OrBlueprint::get_replacement()
 void
 OrBlueprint::sort(Children &children) const
 {
-    std::sort(children.begin(), children.end(), TieredGreaterEstimate());
+    std::sort(children.begin(), children.end(), TieredGreaterCost());
 }
 
 bool
@@ -395,7 +512,7 @@ WeakAndBlueprint::createIntermediateSearch(MultiSearch::Children sub_searches,
                                    _weights[i],
                                    getChild(i).getState().estimate().estHits));
     }
-    return WeakAndSearch::create(terms, _n, strict);
+    return WeakAndSearch::create(terms, _n, strict, _block_max);
 }
 
 SearchIterator::UP
@@ -418,6 +535,19 @@ NearBlueprint::exposeFields() const
     return FieldSpecBaseList();
 }
 
+double
+NearBlueprint::calculate_cost() const
+{
+    return and_cost(get_children());
+}
+
+double
+NearBlueprint::calculate_strict_cost() const
+{
+    const auto &children = get_children();
+    return children.empty() ? 0.0 : and_strict_cost(children, 0, false);
+}
+
 void
 NearBlueprint::sort(Children &children) const
 {
@@ -471,6 +601,19 @@ ONearBlueprint::exposeFields() const
     return FieldSpecBaseList();
 }
 
+double
+ONearBlueprint::calculate_cost() const
+{
+    return and_cost(get_children());
+}
+
+double
+ONearBlueprint::calculate_strict_cost() const
+{
+    const auto &children = get_children();
+    return children.empty() ? 0.0 : and_strict_cost(children, 0, false);
+}
+
 void
 ONearBlueprint::sort(Children &children) const
 {
@@ -550,6 +693,20 @@ RankBlueprint::get_replacement()
     return Blueprint::UP();
 }
 
+double
+RankBlueprint::calculate_cost() const
+{
+    const auto &children = get_children();
+    return first_child_cost(children, children.empty() ? 0.0 : children[0]->cost(), false);
+}
+
+double
+RankBlueprint::calculate_strict_cost() const
+{
+    const auto &children = get_children();
+    return first_child_cost(children, children.empty() ? 0.0 : children[0]->strict_cost(), false);
+}
+
 void
 RankBlueprint::sort(Children &children) const
 {
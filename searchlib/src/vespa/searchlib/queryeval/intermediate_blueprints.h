@@ -29,6 +29,8 @@ public:
     createFilterSearch(bool strict, FilterConstraint constraint) const override;
 private:
     bool isPositive(size_t index) const override { return index == 0; }
+    double calculate_cost() const override;
+    double calculate_strict_cost() const override;
 };
 
 //-----------------------------------------------------------------------------
@@ -52,6 +54,8 @@ public:
     createFilterSearch(bool strict, FilterConstraint constraint) const override;
 private:
     double computeNextHitRate(const Blueprint & child, double hitRate) const override;
+    double calculate_cost() const override;
+    double calculate_strict_cost() const override;
 };
 
 //-----------------------------------------------------------------------------
@@ -83,6 +87,7 @@ class WeakAndBlueprint : public IntermediateBlueprint
 private:
     uint32_t              _n;
     std::vector<uint32_t> _weights;
+    bool                  _block_max;
 
 public:
     HitEstimate combine(const std::vector<HitEstimate> &data) const override;
@@ -95,7 +100,8 @@ public:
                              bool strict, fef::MatchData &md) const override;
     SearchIterator::UP createFilterSearch(bool strict, FilterConstraint constraint) const override;
 
-    WeakAndBlueprint(uint32_t n) : _n(n) {}
+    WeakAndBlueprint(uint32_t n) : WeakAndBlueprint(n, false) {}
+    WeakAndBlueprint(uint32_t n, bool block_max) : _n(n), _weights(), _block_max(block_max) {}
     ~WeakAndBlueprint();
     void addTerm(Blueprint::UP bp, uint32_t weight) {
         addChild(std::move(bp));
@@ -103,6 +109,7 @@ public:
     }
     uint32_t getN() const { return _n; }
     const std::vector<uint32_t> &getWeights() const { return _weights; }
+    bool use_block_max() const { return _block_max; }
 };
 
 //-----------------------------------------------------------------------------
@@ -112,6 +119,9 @@ class NearBlueprint : public IntermediateBlueprint
 private:
     uint32_t _window;
 
+    double calculate_cost() const override;
+    double calculate_strict_cost() const override;
+
 public:
     HitEstimate combine(const std::vector<HitEstimate> &data) const override;
     FieldSpecBaseList exposeFields() const override;
@@ -134,6 +144,9 @@ class ONearBlueprint  : public IntermediateBlueprint
 private:
     uint32_t _window;
 
+    double calculate_cost() const override;
+    double calculate_strict_cost() const override;
+
 public:
     HitEstimate combine(const std::vector<HitEstimate> &data) const override;
     FieldSpecBaseList exposeFields() const override;
@@ -153,6 +166,9 @@ public:
 
 class RankBlueprint final : public IntermediateBlueprint
 {
+private:
+    double calculate_cost() const override;
+    double calculate_strict_cost() const override;
 public:
     HitEstimate combine(const std::vector<HitEstimate> &data) const override;
     FieldSpecBaseList exposeFields() const override;
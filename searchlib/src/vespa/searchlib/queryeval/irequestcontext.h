@@ -39,6 +39,12 @@ public:
     virtual const vespalib::eval::Value* get_query_tensor(const vespalib::string& tensor_name) const = 0;
 
     virtual const search::attribute::AttributeBlueprintParams& get_attribute_blueprint_params() const = 0;
+
+    /**
+     * Returns true if weak and should use block max info from the
+     * posting lists (rank property vespa.matching.weakand.block_max).
+     */
+    virtual bool use_weakand_block_max() const = 0;
 };
 
 }
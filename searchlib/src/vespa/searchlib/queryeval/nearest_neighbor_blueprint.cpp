@@ -31,6 +31,14 @@ to_string(NearestNeighborBlueprint::Algorithm algorithm)
     return "unknown";
 }
 
+// Relative cost of calculating the distance to a single document,
+// assuming a posting list seek costs about as much as 16 cell products.
+double
+exact_distance_cost(size_t num_cells)
+{
+    return 1.0 + double(num_cells) / 16.0;
+}
+
 } // namespace <unnamed>
 
 NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& field,
@@ -58,7 +66,8 @@ NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& f
       _global_filter(GlobalFilter::create()),
       _global_filter_set(false),
       _global_filter_hits(),
-      _global_filter_hit_ratio()
+      _global_filter_hit_ratio(),
+      _batched_top_k(false)
 {
     if (distance_threshold < std::numeric_limits<double>::max()) {
         _distance_threshold = _distance_calc->function().convert_threshold(distance_threshold);
@@ -66,6 +75,7 @@ NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& f
     }
     uint32_t est_hits = _attr_tensor.get_num_docs();
     setEstimate(HitEstimate(est_hits, false));
+    set_cost(exact_distance_cost(_query_tensor.cells().size));
     auto nns_index = _attr_tensor.nearest_neighbor_index();
     set_want_global_filter(nns_index && _approximate);
 }
@@ -74,6 +84,54 @@ NearestNeighborBlueprint::~NearestNeighborBlueprint() = default;
 
 void
 NearestNeighborBlueprint::set_global_filter(const GlobalFilter &global_filter, double estimated_hit_ratio)
+{
+    if (prepare_top_k(global_filter, estimated_hit_ratio)) {
+        perform_top_k(_attr_tensor.nearest_neighbor_index());
+    }
+}
+
+const void*
+NearestNeighborBlueprint::global_filter_batch_key() const noexcept
+{
+    return _attr_tensor.nearest_neighbor_index();
+}
+
+void
+NearestNeighborBlueprint::set_global_filter_batch(const std::vector<Blueprint*>& batch,
+                                                  const GlobalFilter &global_filter, double estimated_hit_ratio)
+{
+    using search::tensor::NearestNeighborIndex;
+    // All blueprints in the batch have the same key, i.e. they are nearest neighbor blueprints using the same index.
+    const auto* nns_index = _attr_tensor.nearest_neighbor_index();
+    std::vector<NearestNeighborBlueprint*> pending;
+    for (auto* blueprint : batch) {
+        auto* nn_blueprint = static_cast<NearestNeighborBlueprint*>(blueprint);
+        assert(nn_blueprint->global_filter_batch_key() == nns_index);
+        if (nn_blueprint->prepare_top_k(global_filter, estimated_hit_ratio)) {
+            pending.push_back(nn_blueprint);
+        }
+    }
+    if (pending.size() == 1) {
+        pending[0]->perform_top_k(nns_index);
+    } else if (!pending.empty()) {
+        std::vector<NearestNeighborIndex::TopKQuery> queries;
+        for (auto* blueprint : pending) {
+            queries.push_back(blueprint->make_top_k_query());
+        }
+        const auto* filter = global_filter.is_active() ? &global_filter : nullptr;
+        auto results = nns_index->find_top_k_batch(queries, filter);
+        assert(results.size() == queries.size());
+        for (size_t i = 0; i < pending.size(); ++i) {
+            auto* blueprint = pending[i];
+            blueprint->_found_hits = std::move(results[i]);
+            blueprint->_algorithm = (filter != nullptr) ? Algorithm::INDEX_TOP_K_WITH_FILTER : Algorithm::INDEX_TOP_K;
+            blueprint->_batched_top_k = true;
+        }
+    }
+}
+
+bool
+NearestNeighborBlueprint::prepare_top_k(const GlobalFilter &global_filter, double estimated_hit_ratio)
 {
     _global_filter = global_filter.shared_from_this();
     _global_filter_set = true;
@@ -98,9 +156,19 @@ NearestNeighborBlueprint::set_global_filter(const GlobalFilter &global_filter, d
         if (_algorithm != Algorithm::EXACT_FALLBACK) {
             est_hits = std::min(est_hits, _adjusted_target_hits);
             setEstimate(HitEstimate(est_hits, false));
-            perform_top_k(nns_index);
+            // hits are found up front, so checking a document is a lookup in the result
+            set_cost(1.0);
+            return true;
         }
     }
+    return false;
+}
+
+search::tensor::NearestNeighborIndex::TopKQuery
+NearestNeighborBlueprint::make_top_k_query() const
+{
+    uint32_t k = _adjusted_target_hits;
+    return {_query_tensor.cells(), k, k + _explore_additional_hits, _distance_threshold};
 }
 
 void
@@ -146,6 +214,7 @@ NearestNeighborBlueprint::visitMembers(vespalib::ObjectVisitor& visitor) const
     visitor.visitBool("has_index", _attr_tensor.nearest_neighbor_index());
     visitor.visitString("algorithm", to_string(_algorithm));
     visitor.visitInt("top_k_hits", _found_hits.size());
+    visitor.visitBool("batched_top_k", _batched_top_k);
 
     visitor.openStruct("global_filter", "GlobalFilter");
     visitor.visitBool("wanted", getState().want_global_filter());
@@ -45,7 +45,10 @@ private:
     bool _global_filter_set;
     std::optional<uint32_t> _global_filter_hits;
     std::optional<double> _global_filter_hit_ratio;
+    bool _batched_top_k;
 
+    bool prepare_top_k(const GlobalFilter &global_filter, double estimated_hit_ratio);
+    search::tensor::NearestNeighborIndex::TopKQuery make_top_k_query() const;
     void perform_top_k(const search::tensor::NearestNeighborIndex* nns_index);
 public:
     NearestNeighborBlueprint(const queryeval::FieldSpec& field,
@@ -62,7 +65,15 @@ public:
     uint32_t get_target_hits() const { return _target_hits; }
     uint32_t get_adjusted_target_hits() const { return _adjusted_target_hits; }
     void set_global_filter(const GlobalFilter &global_filter, double estimated_hit_ratio) override;
+    /**
+     * Blueprints using the same nearest neighbor index are batched, and their top k searches
+     * are performed as one batch (see NearestNeighborIndex::find_top_k_batch()).
+     */
+    const void* global_filter_batch_key() const noexcept override;
+    void set_global_filter_batch(const std::vector<Blueprint*>& batch,
+                                 const GlobalFilter &global_filter, double estimated_hit_ratio) override;
     Algorithm get_algorithm() const { return _algorithm; }
+    bool get_batched_top_k() const { return _batched_top_k; }
     double get_distance_threshold() const { return _distance_threshold; }
 
     std::unique_ptr<SearchIterator> createLeafSearch(const search::fef::TermFieldMatchDataArray& tfmda,
@@ -46,6 +46,12 @@ SimplePhraseBlueprint::addTerm(Blueprint::UP term)
     }
     setEstimate(_estimate);
     _terms.push_back(std::move(term));
+    // each candidate document is checked against all terms
+    double cost = 0.0;
+    for (const auto &child : _terms) {
+        cost += child->cost();
+    }
+    set_cost(cost);
 }
 
 SearchIterator::UP
@@ -5,6 +5,7 @@
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/objects/visit.hpp>
 #include <vespa/vespalib/util/array.hpp>
+#include <algorithm>
 
 namespace search::queryeval {
 
@@ -115,6 +116,52 @@ SourceBlenderSearch::doUnpack(uint32_t docid)
     _matchedChild->doUnpack(docid);
 }
 
+void
+SourceBlenderSearch::init_block_max()
+{
+    _block_max.clear();
+    for (auto & child : _children) {
+        SearchIterator *search = getSearch(child);
+        if ((search == nullptr) || (dynamic_cast<EmptySearch *>(search) != nullptr)) {
+            continue;
+        }
+        auto *info = dynamic_cast<BlockMaxInfo *>(search);
+        if ((info == nullptr) || !info->has_block_max()) {
+            _block_max.clear();
+            return;
+        }
+        _block_max.emplace_back(search, info);
+    }
+}
+
+BlockMaxInfo::Block
+SourceBlenderSearch::get_block(uint32_t docid)
+{
+    // Any source may be selected for documents in the returned block, so
+    // the block ends where the first source block ends and is bounded by
+    // the largest max num occs among the sources.
+    Block result{search::endDocId, 0};
+    for (const auto & entry : _block_max) {
+        Block block = entry.second->get_block(docid);
+        if (block.last_docid != search::endDocId) {
+            result.last_docid = std::min(result.last_docid, block.last_docid);
+            result.max_num_occs = std::max(result.max_num_occs, block.max_num_occs);
+        }
+    }
+    return result;
+}
+
+uint32_t
+SourceBlenderSearch::get_num_occs() const
+{
+    for (const auto & entry : _block_max) {
+        if (entry.first == _matchedChild) {
+            return entry.second->get_num_occs();
+        }
+    }
+    return 0;
+}
+
 SourceBlenderSearch::SourceBlenderSearch(
         std::unique_ptr<sourceselector::Iterator> sourceSelector,
         const Children &children) :
@@ -131,6 +178,7 @@ SourceBlenderSearch::SourceBlenderSearch(
         _children.push_back(sid);
         _sources[sid] = child.search;
     }
+    init_block_max();
 }
 
 void
@@ -164,6 +212,7 @@ void
 SourceBlenderSearch::setChild(size_t index, SearchIterator::UP child) {
     assert(_sources[_children[index]] == nullptr);
     _sources[_children[index]] = child.release();
+    init_block_max();
 }
 
 SearchIterator::UP
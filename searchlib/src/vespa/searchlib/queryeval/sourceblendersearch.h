@@ -4,6 +4,7 @@
 
 #include "searchiterator.h"
 #include "emptysearch.h"
+#include "wand/block_max_info.h"
 #include <vector>
 
 namespace search::queryeval {
@@ -17,8 +18,12 @@ namespace search::queryeval {
  * document. The source blender will make sure to only propagate
  * unpack requests to one of the sources below, enabling them to use
  * the same target location for detailed match data unpacking.
+ *
+ * Block max info is forwarded when all non-empty sources provide it,
+ * using the most conservative bound across sources for each block.
  **/
-class SourceBlenderSearch : public SearchIterator
+class SourceBlenderSearch : public SearchIterator,
+                            public BlockMaxInfo
 {
 public:
     /**
@@ -39,6 +44,7 @@ private:
     void visitMembers(vespalib::ObjectVisitor &visitor) const override;
     bool isSourceBlender() const override { return true; }
     static EmptySearch _emptySearch;
+    void init_block_max();
 protected:
     using Iterator = sourceselector::Iterator;
     using Source = uint8_t;
@@ -48,6 +54,7 @@ protected:
     SourceIndex                 _children;
     uint32_t                    _docIdLimit;
     SearchIterator            * _sources[256];
+    std::vector<std::pair<SearchIterator *, BlockMaxInfo *>> _block_max; // non-empty sources, empty when not all provide block max
 
     void doSeek(uint32_t docid) override;
     void doUnpack(uint32_t docid) override;
@@ -76,10 +83,14 @@ public:
     SearchIterator::UP steal(size_t index) {
         SearchIterator::UP retval(_sources[_children[index]]);
         _sources[_children[index]] = nullptr;
+        _block_max.clear();
         return retval;
     }
     void setChild(size_t index, SearchIterator::UP child);
     void initRange(uint32_t beginId, uint32_t endId) override;
+    bool has_block_max() const override { return !_block_max.empty(); }
+    Block get_block(uint32_t docid) override;
+    uint32_t get_num_occs() const override;
 };
 
 }
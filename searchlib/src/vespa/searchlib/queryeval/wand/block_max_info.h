@@ -0,0 +1,41 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::queryeval {
+
+/**
+ * Interface implemented by term search iterators that can provide
+ * block level upper bounds for the term frequency (number of
+ * occurrences in the field). Used by block-max weak and to skip
+ * blocks of documents that can not produce a competitive score
+ * without decoding the document ids in them.
+ **/
+class BlockMaxInfo {
+public:
+    struct Block {
+        uint32_t last_docid;    // last document id covered by the block
+        uint32_t max_num_occs;  // upper bound for num occs in the block
+    };
+    virtual ~BlockMaxInfo() = default;
+    /**
+     * Returns false if the posting list has no block max info. The
+     * other functions should not be used in that case.
+     **/
+    virtual bool has_block_max() const = 0;
+    /**
+     * Returns the block containing the first posting >= docid. The
+     * iterator may be repositioned to the start of that block, but
+     * never beyond the first posting >= docid. last_docid is
+     * search::endDocId when there are no more postings.
+     **/
+    virtual Block get_block(uint32_t docid) = 0;
+    /**
+     * Returns the number of occurrences for the current document.
+     **/
+    virtual uint32_t get_num_occs() const = 0;
+};
+
+}
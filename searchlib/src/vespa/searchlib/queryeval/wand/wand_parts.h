@@ -339,6 +339,8 @@ public:
     }
     ref_t *present_begin() const { return _present; }
     ref_t *present_end() const { return _past; }
+    ref_t *past_begin() const { return _past; }
+    ref_t *past_end() const { return _trash; }
     vespalib::string stringify() const;
 };
 
@@ -416,6 +418,24 @@ struct TermFrequencyScorer
 
 //-----------------------------------------------------------------------------
 
+/**
+ * Scorer used with block-max weak and that scales the max score of a
+ * term (see TermFrequencyScorer) by a saturated term frequency, as
+ * bm25 does without field length normalization. The score is
+ * increasing in num occs and never above the max score of the term.
+ */
+struct SaturatedTermFrequencyScorer
+{
+    static constexpr double k1 = 1.2;
+
+    static score_t calculate_score(score_t max_score, uint32_t num_occs) {
+        double tf = num_occs;
+        return (score_t) (max_score * (tf / (tf + k1)));
+    }
+};
+
+//-----------------------------------------------------------------------------
+
 /**
  * Scorer used with WeakAndAlgorithm that calculates a real dot product upper
  * bound as max score and dot product component score per term.
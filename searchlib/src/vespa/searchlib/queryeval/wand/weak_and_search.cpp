@@ -2,6 +2,7 @@
 
 #include "weak_and_search.h"
 #include "wand_parts.h"
+#include "block_max_info.h"
 #include <vespa/searchlib/queryeval/orsearch.h>
 #include <vespa/vespalib/util/left_right_heap.h>
 #include <vespa/vespalib/util/priority_queue.h>
@@ -16,6 +17,7 @@ class WeakAndSearchLR : public WeakAndSearch
 {
 private:
     using Scores = vespalib::PriorityQueue<score_t>;
+    using Scorer = SaturatedTermFrequencyScorer;
 
     VectorizedIteratorTerms        _terms;
     DualHeap<FutureHeap, PastHeap> _heaps;
@@ -23,6 +25,103 @@ private:
     score_t                        _threshold; // current score threshold
     Scores                         _scores;    // best n scores
     const uint32_t                 _n;
+    std::vector<BlockMaxInfo *>    _block_max; // per term, empty when not using block max
+    score_t                        _score;     // score of current hit when using block max
+
+    void init_block_max() {
+        bool found = false;
+        for (const auto &term : _terms.input_terms()) {
+            auto *info = dynamic_cast<BlockMaxInfo *>(term.search);
+            if ((info != nullptr) && !info->has_block_max()) {
+                info = nullptr;
+            }
+            found = found || (info != nullptr);
+            _block_max.push_back(info);
+        }
+        if (!found) {
+            _block_max.clear();
+        }
+    }
+
+    score_t term_score(ref_t ref) const {
+        const BlockMaxInfo *info = _block_max[ref];
+        return (info != nullptr) ? Scorer::calculate_score(_terms.maxScore(ref), info->get_num_occs()) : _terms.maxScore(ref);
+    }
+
+    // Upper bound for the score of documents in [candidate, block_end]. Terms
+    // without block max info contribute their max score for the entire range.
+    score_t block_max_bound(docid_t &block_end) {
+        docid_t candidate = _algo.get_candidate();
+        block_end = _heaps.has_future() ? (_terms.docId(_heaps.future()) - 1) : search::endDocId;
+        score_t bound = 0;
+        auto add_term = [&](ref_t ref) {
+            BlockMaxInfo *info = _block_max[ref];
+            if (info == nullptr) {
+                bound += _terms.maxScore(ref);
+                return;
+            }
+            BlockMaxInfo::Block block = info->get_block(candidate);
+            if (block.last_docid != search::endDocId) {
+                bound += Scorer::calculate_score(_terms.maxScore(ref), block.max_num_occs);
+                block_end = std::min(block_end, block.last_docid);
+            }
+        };
+        for (ref_t *ref = _heaps.present_begin(); ref != _heaps.present_end(); ++ref) {
+            add_term(*ref);
+        }
+        for (ref_t *ref = _heaps.past_begin(); ref != _heaps.past_end(); ++ref) {
+            add_term(*ref);
+        }
+        return bound;
+    }
+
+    // Check a candidate satisfying the wand constraint against the block
+    // max bound and then against its real score. On failure, next is the
+    // first document that can still be a hit.
+    bool check_block_max(docid_t &next) {
+        GreaterThanEqual aboveThreshold(_threshold);
+        docid_t block_end;
+        if (!aboveThreshold(block_max_bound(block_end))) {
+            // At least one present term has block max info when the bound
+            // is below the wand upper bound, so block_end < endDocId
+            next = block_end + 1;
+            return false;
+        }
+        _algo.find_matching_terms(_terms, _heaps);
+        _score = 0;
+        ref_t *end = _heaps.present_end();
+        for (ref_t *ref = _heaps.present_begin(); ref != end; ++ref) {
+            _score += term_score(*ref);
+        }
+        if (!aboveThreshold(_score)) {
+            next = _algo.get_candidate() + 1;
+            return false;
+        }
+        return true;
+    }
+
+    void seek_strict_block_max(uint32_t docid) {
+        _algo.set_candidate(_terms, _heaps, docid);
+        while (_algo.solve_wand_constraint(_terms, _heaps, GreaterThanEqual(_threshold))) {
+            docid_t next;
+            if (check_block_max(next)) {
+                setDocId(_algo.get_candidate());
+                return;
+            }
+            _algo.set_candidate(_terms, _heaps, next);
+        }
+        setAtEnd();
+    }
+
+    void seek_unstrict_block_max(uint32_t docid) {
+        if (docid > _algo.get_candidate()) {
+            _algo.set_candidate(_terms, _heaps, docid);
+            docid_t next;
+            if (_algo.check_wand_constraint(_terms, _heaps, GreaterThanEqual(_threshold)) && check_block_max(next)) {
+                setDocId(_algo.get_candidate());
+            }
+        }
+    }
 
     void seek_strict(uint32_t docid) {
         _algo.set_candidate(_terms, _heaps, docid);
@@ -43,7 +142,7 @@ private:
     }
 
 public:
-    WeakAndSearchLR(const Terms &terms, uint32_t n)
+    WeakAndSearchLR(const Terms &terms, uint32_t n, bool block_max)
         : _terms(terms,
                  TermFrequencyScorer(),
                  0,
@@ -52,8 +151,13 @@ public:
           _algo(),
           _threshold(1),
           _scores(),
-          _n(n)
+          _n(n),
+          _block_max(),
+          _score(0)
     {
+        if (block_max) {
+            init_block_max();
+        }
     }
     virtual size_t get_num_terms() const override { return _terms.size(); }
     virtual int32_t get_term_weight(size_t idx) const override { return _terms.weight(idx); }
@@ -61,7 +165,13 @@ public:
     const Terms &getTerms() const override { return _terms.input_terms(); }
     uint32_t getN() const override { return _n; }
     void doSeek(uint32_t docid) override {
-        if (IS_STRICT) {
+        if (!_block_max.empty()) {
+            if (IS_STRICT) {
+                seek_strict_block_max(docid);
+            } else {
+                seek_unstrict_block_max(docid);
+            }
+        } else if (IS_STRICT) {
             seek_strict(docid);
         } else {
             seek_unstrict(docid);
@@ -69,7 +179,7 @@ public:
     }
     void doUnpack(uint32_t docid) override {
         _algo.find_matching_terms(_terms, _heaps);
-        _scores.push(_algo.get_upper_bound());
+        _scores.push(_block_max.empty() ? _algo.get_upper_bound() : _score);
         if (_scores.size() > _n) {
             _scores.pop_front();
         }
@@ -107,32 +217,32 @@ WeakAndSearch::visitMembers(vespalib::ObjectVisitor &visitor) const
 //-----------------------------------------------------------------------------
 
 SearchIterator::UP
-WeakAndSearch::createArrayWand(const Terms &terms, uint32_t n, bool strict)
+WeakAndSearch::createArrayWand(const Terms &terms, uint32_t n, bool strict, bool block_max)
 {
     if (strict) {
-        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftArrayHeap, vespalib::RightArrayHeap, true>(terms, n));
+        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftArrayHeap, vespalib::RightArrayHeap, true>(terms, n, block_max));
     } else {
-        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftArrayHeap, vespalib::RightArrayHeap, false>(terms, n));
+        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftArrayHeap, vespalib::RightArrayHeap, false>(terms, n, block_max));
     }
 }
 
 SearchIterator::UP
-WeakAndSearch::createHeapWand(const Terms &terms, uint32_t n, bool strict)
+WeakAndSearch::createHeapWand(const Terms &terms, uint32_t n, bool strict, bool block_max)
 {
     if (strict) {
-        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftHeap, vespalib::RightHeap, true>(terms, n));
+        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftHeap, vespalib::RightHeap, true>(terms, n, block_max));
     } else {
-        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftHeap, vespalib::RightHeap, false>(terms, n));
+        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftHeap, vespalib::RightHeap, false>(terms, n, block_max));
     }
 }
 
 SearchIterator::UP
-WeakAndSearch::create(const Terms &terms, uint32_t n, bool strict)
+WeakAndSearch::create(const Terms &terms, uint32_t n, bool strict, bool block_max)
 {
     if (terms.size() < 128) {
-        return createArrayWand(terms, n, strict);
+        return createArrayWand(terms, n, strict, block_max);
     } else {
-        return createHeapWand(terms, n, strict);
+        return createHeapWand(terms, n, strict, block_max);
     }
 }
 
@@ -16,9 +16,15 @@ struct WeakAndSearch : SearchIterator {
     virtual const Terms &getTerms() const = 0;
     virtual uint32_t getN() const = 0;
     void visitMembers(vespalib::ObjectVisitor &visitor) const override;
-    static SearchIterator::UP createArrayWand(const Terms &terms, uint32_t n, bool strict);
-    static SearchIterator::UP createHeapWand(const Terms &terms, uint32_t n, bool strict);
-    static SearchIterator::UP create(const Terms &terms, uint32_t n, bool strict);
+    static SearchIterator::UP createArrayWand(const Terms &terms, uint32_t n, bool strict, bool block_max = false);
+    static SearchIterator::UP createHeapWand(const Terms &terms, uint32_t n, bool strict, bool block_max = false);
+    /**
+     * With block_max, terms providing block max info (see BlockMaxInfo) are
+     * scored by saturated term frequency, and blocks of documents that can
+     * not reach the current score threshold are skipped. Terms below a
+     * source blender get block max info when all its sources have it.
+     **/
+    static SearchIterator::UP create(const Terms &terms, uint32_t n, bool strict, bool block_max = false);
 };
 
 } // namespace queryeval
@@ -23,6 +23,20 @@ make_random_level_generator(uint32_t m)
     return std::make_unique<InvLogLevelGenerator>(m);
 }
 
+std::unique_ptr<ScalarQuantizedVectorStore>
+make_quantized_vector_store(size_t vector_size, vespalib::eval::CellType cell_type,
+                            const search::attribute::HnswIndexParams& params)
+{
+    // Quantization only pays off for float cells, and is only supported for metrics that can be
+    // calculated from dot products of the quantized vectors.
+    if (params.quantize_vectors() && cell_type == vespalib::eval::CellType::FLOAT &&
+        ScalarQuantizedVectorStore::supports(params.distance_metric()))
+    {
+        return std::make_unique<ScalarQuantizedVectorStore>(vector_size, params.distance_metric());
+    }
+    return {};
+}
+
 } // namespace <unnamed>
 
 std::unique_ptr<NearestNeighborIndex>
@@ -32,7 +46,6 @@ DefaultNearestNeighborIndexFactory::make(const DocVectorAccess& vectors,
                                          vespalib::eval::CellType cell_type,
                                          const search::attribute::HnswIndexParams& params) const
 {
-    (void) vector_size;
     uint32_t m = params.max_links_per_node();
     HnswIndexConfig cfg(m * 2,
                         m,
@@ -43,12 +56,14 @@ DefaultNearestNeighborIndexFactory::make(const DocVectorAccess& vectors,
         return std::make_unique<HnswIndex<HnswIndexType::MULTI>>(vectors,
                                                                   make_distance_function(params.distance_metric(), cell_type),
                                                                   make_random_level_generator(m),
-                                                                  cfg);
+                                                                  cfg,
+                                                                  make_quantized_vector_store(vector_size, cell_type, params));
     } else {
         return std::make_unique<HnswIndex<HnswIndexType::SINGLE>>(vectors,
                                                                   make_distance_function(params.distance_metric(), cell_type),
                                                                   make_random_level_generator(m),
-                                                                  cfg);
+                                                                  cfg,
+                                                                  make_quantized_vector_store(vector_size, cell_type, params));
     }
 }
 
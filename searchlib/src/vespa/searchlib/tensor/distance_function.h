@@ -4,8 +4,7 @@
 
 #include <memory>
 #include <vespa/eval/eval/cell_type.h>
-
-namespace vespalib::eval { struct TypedCells; }
+#include <vespa/eval/eval/typed_cells.h>
 
 namespace search::tensor {
 
@@ -43,6 +42,16 @@ public:
     virtual double calc_with_limit(const vespalib::eval::TypedCells& lhs,
                                    const vespalib::eval::TypedCells& rhs,
                                    double limit) const = 0;
+
+    // calculate internal distance between each of the lhs vectors and the rhs vector.
+    // the default calculates one pair at a time; implementations with a one-to-many
+    // kernel load each part of rhs once for a block of lhs vectors.
+    virtual void calc_batch(const vespalib::eval::TypedCells* lhs, size_t num_lhs,
+                            const vespalib::eval::TypedCells& rhs, double* result) const {
+        for (size_t i = 0; i < num_lhs; ++i) {
+            result[i] = calc(lhs[i], rhs);
+        }
+    }
 };
 
 }
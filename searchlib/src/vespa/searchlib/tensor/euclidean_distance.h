@@ -5,7 +5,9 @@
 #include "distance_function.h"
 #include <vespa/eval/eval/typed_cells.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <algorithm>
 #include <cmath>
+#include <type_traits>
 
 namespace search::tensor {
 
@@ -74,6 +76,29 @@ public:
         }
         return sum;
     }
+
+    void calc_batch(const vespalib::eval::TypedCells* lhs, size_t num_lhs,
+                    const vespalib::eval::TypedCells& rhs, double* result) const override
+    {
+        if constexpr (std::is_same_v<FloatType, float> || std::is_same_v<FloatType, double>) {
+            constexpr vespalib::eval::CellType expected = vespalib::eval::get_cell_type<FloatType>();
+            assert(rhs.type == expected);
+            auto rhs_vector = rhs.typify<FloatType>();
+            size_t sz = rhs_vector.size();
+            constexpr size_t block_size = 16;
+            const FloatType* lhs_ptrs[block_size];
+            for (size_t i = 0; i < num_lhs; i += block_size) {
+                size_t num_block = std::min(block_size, num_lhs - i);
+                for (size_t j = 0; j < num_block; ++j) {
+                    assert(lhs[i + j].type == expected && lhs[i + j].size == sz);
+                    lhs_ptrs[j] = lhs[i + j].typify<FloatType>().data();
+                }
+                _computer.squaredEuclideanDistances(lhs_ptrs, num_block, rhs_vector.data(), sz, result + i);
+            }
+        } else {
+            SquaredEuclideanDistance::calc_batch(lhs, num_lhs, rhs, result);
+        }
+    }
 private:
     const vespalib::hwaccelrated::IAccelrated & _computer;
 };
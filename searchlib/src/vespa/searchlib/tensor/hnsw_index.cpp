@@ -20,6 +20,7 @@
 #include <vespa/vespalib/util/memory_allocator.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/time.h>
+#include <functional>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".searchlib.tensor.hnsw_index");
@@ -40,6 +41,27 @@ constexpr size_t max_level_array_size = 16;
 constexpr size_t max_link_array_size = 193;
 constexpr vespalib::duration MAX_COUNT_DURATION(100ms);
 
+/**
+ * Wraps the loader of the graph, and populates the quantized vectors when the graph is completely loaded.
+ */
+class QuantizingIndexLoader : public NearestNeighborIndexLoader {
+    std::unique_ptr<NearestNeighborIndexLoader> _loader;
+    std::function<void()> _on_complete;
+public:
+    QuantizingIndexLoader(std::unique_ptr<NearestNeighborIndexLoader> loader, std::function<void()> on_complete)
+        : _loader(std::move(loader)),
+          _on_complete(std::move(on_complete))
+    {
+    }
+    bool load_next() override {
+        if (_loader->load_next()) {
+            return true;
+        }
+        _on_complete();
+        return false;
+    }
+};
+
 bool has_link_to(vespalib::ConstArrayRef<uint32_t> links, uint32_t id) {
     for (uint32_t link : links) {
         if (link == id) return true;
@@ -266,7 +288,7 @@ HnswIndex<type>::estimate_visited_nodes(uint32_t level, uint32_t nodeid_limit, u
 
 template <HnswIndexType type>
 HnswCandidate
-HnswIndex<type>::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& entry_point, uint32_t level) const
+HnswIndex<type>::find_nearest_in_layer(TraversalDistance& distance, const HnswCandidate& entry_point, uint32_t level) const
 {
     HnswCandidate nearest = entry_point;
     bool keep_searching = true;
@@ -277,7 +299,7 @@ HnswIndex<type>::find_nearest_in_layer(const TypedCells& input, const HnswCandid
             auto neighbor_ref = neighbor_node.ref().load_acquire();
             uint32_t neighbor_docid = acquire_docid(neighbor_node, neighbor_nodeid);
             uint32_t neighbor_subspace = neighbor_node.acquire_subspace();
-            double dist = calc_distance(input, neighbor_docid, neighbor_subspace);
+            double dist = distance.calc(neighbor_nodeid, neighbor_docid, neighbor_subspace);
             if (_graph.still_valid(neighbor_nodeid, neighbor_ref)
                 && dist < nearest.distance)
             {
@@ -289,10 +311,23 @@ HnswIndex<type>::find_nearest_in_layer(const TypedCells& input, const HnswCandid
     return nearest;
 }
 
+template <HnswIndexType type>
+HnswCandidate
+HnswIndex<type>::find_nearest_in_upper_layers(TraversalDistance& distance, const typename GraphType::EntryNode& entry) const
+{
+    uint32_t entry_docid = get_docid(entry.nodeid);
+    // TODO: check if entry docid/node_ref is still valid here
+    HnswCandidate entry_point(entry.nodeid, entry_docid, entry.node_ref, distance.calc(entry.nodeid));
+    for (int search_level = entry.level; search_level > 0; --search_level) {
+        entry_point = find_nearest_in_layer(distance, entry_point, search_level);
+    }
+    return entry_point;
+}
+
 template <HnswIndexType type>
 template <class VisitedTracker, class BestNeighbors>
 void
-HnswIndex<type>::search_layer_helper(const TypedCells& input, uint32_t neighbors_to_find,
+HnswIndex<type>::search_layer_helper(TraversalDistance& distance, uint32_t neighbors_to_find,
                                BestNeighbors& best_neighbors, uint32_t level, const GlobalFilter *filter,
                                uint32_t nodeid_limit, uint32_t estimated_visited_nodes) const
 {
@@ -330,7 +365,7 @@ HnswIndex<type>::search_layer_helper(const TypedCells& input, uint32_t neighbors
             }
             uint32_t neighbor_docid = acquire_docid(neighbor_node, neighbor_nodeid);
             uint32_t neighbor_subspace = neighbor_node.acquire_subspace();
-            double dist_to_input = calc_distance(input, neighbor_docid, neighbor_subspace);
+            double dist_to_input = distance.calc(neighbor_nodeid, neighbor_docid, neighbor_subspace);
             if (dist_to_input < limit_dist) {
                 candidates.emplace(neighbor_nodeid, neighbor_ref, dist_to_input);
                 if ((!filter) || filter->check(neighbor_nodeid)) {
@@ -348,7 +383,7 @@ HnswIndex<type>::search_layer_helper(const TypedCells& input, uint32_t neighbors
 template <HnswIndexType type>
 template <class BestNeighbors>
 void
-HnswIndex<type>::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
+HnswIndex<type>::search_layer(TraversalDistance& distance, uint32_t neighbors_to_find,
                         BestNeighbors& best_neighbors, uint32_t level, const GlobalFilter *filter) const
 {
     uint32_t nodeid_limit = _graph.node_refs_size.load(std::memory_order_acquire);
@@ -357,24 +392,125 @@ HnswIndex<type>::search_layer(const TypedCells& input, uint32_t neighbors_to_fin
     }
     uint32_t estimated_visited_nodes = estimate_visited_nodes(level, nodeid_limit, neighbors_to_find, filter);
     if (estimated_visited_nodes >= nodeid_limit / 128) {
-        search_layer_helper<BitVectorVisitedTracker>(input, neighbors_to_find, best_neighbors, level, filter, nodeid_limit, estimated_visited_nodes);
+        search_layer_helper<BitVectorVisitedTracker>(distance, neighbors_to_find, best_neighbors, level, filter, nodeid_limit, estimated_visited_nodes);
     } else {
-        search_layer_helper<HashSetVisitedTracker>(input, neighbors_to_find, best_neighbors, level, filter, nodeid_limit, estimated_visited_nodes);
+        search_layer_helper<HashSetVisitedTracker>(distance, neighbors_to_find, best_neighbors, level, filter, nodeid_limit, estimated_visited_nodes);
+    }
+}
+
+template <HnswIndexType type>
+template <class VisitedTracker>
+void
+HnswIndex<type>::search_layer_batch_helper(BatchTraversalDistance& distances, const std::vector<uint32_t>& neighbors_to_find,
+                                           std::vector<SearchBestNeighbors>& best_neighbors, const GlobalFilter *filter,
+                                           uint32_t nodeid_limit, uint32_t estimated_visited_nodes) const
+{
+    size_t num_queries = best_neighbors.size();
+    std::vector<NearestPriQ> candidates(num_queries);
+    std::vector<double> limit_dist(num_queries, std::numeric_limits<double>::max());
+    std::vector<double> dist_to_inputs(num_queries);
+    VisitedTracker visited(nodeid_limit, estimated_visited_nodes);
+    for (size_t i = 0; i < num_queries; ++i) {
+        auto& best = best_neighbors[i];
+        assert(best.peek().size() == 1);
+        auto entry = best.top();
+        if (entry.nodeid >= nodeid_limit) {
+            continue;
+        }
+        candidates[i].push(entry);
+        visited.mark(entry.nodeid);
+        if (filter && !filter->check(entry.nodeid)) {
+            best.pop();
+        }
+    }
+    bool more = true;
+    while (more) {
+        more = false;
+        // Expand the nearest candidate of each query in turn. Newly visited nodes are
+        // considered as candidates for all queries.
+        for (size_t i = 0; i < num_queries; ++i) {
+            auto& query_candidates = candidates[i];
+            if (query_candidates.empty()) {
+                continue;
+            }
+            auto cand = query_candidates.top();
+            if (cand.distance > limit_dist[i]) {
+                query_candidates = NearestPriQ();
+                continue;
+            }
+            query_candidates.pop();
+            more = true;
+            for (uint32_t neighbor_nodeid : _graph.get_link_array(cand.node_ref, 0)) {
+                if (neighbor_nodeid >= nodeid_limit) {
+                    continue;
+                }
+                auto& neighbor_node = _graph.acquire_node_refs_elem_ref(neighbor_nodeid);
+                auto neighbor_ref = neighbor_node.ref().load_acquire();
+                if ((! neighbor_ref.valid())
+                    || ! visited.try_mark(neighbor_nodeid))
+                {
+                    continue;
+                }
+                uint32_t neighbor_docid = acquire_docid(neighbor_node, neighbor_nodeid);
+                uint32_t neighbor_subspace = neighbor_node.acquire_subspace();
+                distances.calc(neighbor_nodeid, neighbor_docid, neighbor_subspace, dist_to_inputs.data());
+                bool accepted = (!filter) || filter->check(neighbor_nodeid);
+                for (size_t j = 0; j < num_queries; ++j) {
+                    double dist_to_input = dist_to_inputs[j];
+                    if (dist_to_input < limit_dist[j]) {
+                        candidates[j].emplace(neighbor_nodeid, neighbor_ref, dist_to_input);
+                        if (accepted) {
+                            auto& best = best_neighbors[j];
+                            best.emplace(neighbor_nodeid, neighbor_docid, neighbor_ref, dist_to_input);
+                            while (best.size() > neighbors_to_find[j]) {
+                                best.pop();
+                                limit_dist[j] = best.top().distance;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::search_layer_batch(BatchTraversalDistance& distances, const std::vector<uint32_t>& neighbors_to_find,
+                                    std::vector<SearchBestNeighbors>& best_neighbors, const GlobalFilter *filter) const
+{
+    uint32_t nodeid_limit = _graph.node_refs_size.load(std::memory_order_acquire);
+    if (filter) {
+        nodeid_limit = std::min(filter->size(), nodeid_limit);
+    }
+    uint64_t sum_neighbors_to_find = 0;
+    for (uint32_t value : neighbors_to_find) {
+        sum_neighbors_to_find += value;
+    }
+    uint32_t estimated_visited_nodes = estimate_visited_nodes(0, nodeid_limit,
+                                                              std::min(sum_neighbors_to_find, uint64_t(nodeid_limit)), filter);
+    if (estimated_visited_nodes >= nodeid_limit / 128) {
+        search_layer_batch_helper<BitVectorVisitedTracker>(distances, neighbors_to_find, best_neighbors, filter, nodeid_limit, estimated_visited_nodes);
+    } else {
+        search_layer_batch_helper<HashSetVisitedTracker>(distances, neighbors_to_find, best_neighbors, filter, nodeid_limit, estimated_visited_nodes);
     }
 }
 
 template <HnswIndexType type>
 HnswIndex<type>::HnswIndex(const DocVectorAccess& vectors, DistanceFunction::UP distance_func,
-                     RandomLevelGenerator::UP level_generator, const HnswIndexConfig& cfg)
+                     RandomLevelGenerator::UP level_generator, const HnswIndexConfig& cfg,
+                     std::unique_ptr<ScalarQuantizedVectorStore> quantized_vectors)
     : _graph(),
       _vectors(vectors),
       _distance_func(std::move(distance_func)),
       _level_generator(std::move(level_generator)),
       _id_mapping(),
       _cfg(cfg),
-      _compaction_spec()
+      _compaction_spec(),
+      _quantized_vectors(std::move(quantized_vectors))
 {
     assert(_distance_func);
+    assert(!_quantized_vectors || _distance_func->expected_cell_type() == vespalib::eval::CellType::FLOAT);
 }
 
 template <HnswIndexType type>
@@ -425,12 +561,13 @@ HnswIndex<type>::internal_prepare_add_node(typename HnswIndex::PreparedAddDoc& o
         return;
     }
     int search_level = entry.level;
-    double entry_dist = calc_distance(input_vector, entry.nodeid);
+    TraversalDistance distance(*this, input_vector, false);
+    double entry_dist = distance.calc(entry.nodeid);
     uint32_t entry_docid = get_docid(entry.nodeid);
     // TODO: check if entry nodeid/node_ref is still valid here
     HnswCandidate entry_point(entry.nodeid, entry_docid, entry.node_ref, entry_dist);
     while (search_level > node_max_level) {
-        entry_point = find_nearest_in_layer(input_vector, entry_point, search_level);
+        entry_point = find_nearest_in_layer(distance, entry_point, search_level);
         --search_level;
     }
 
@@ -439,7 +576,7 @@ HnswIndex<type>::internal_prepare_add_node(typename HnswIndex::PreparedAddDoc& o
     search_level = std::min(node_max_level, search_level);
     // Find neighbors of the added document in each level it should exist in.
     while (search_level >= 0) {
-        search_layer(input_vector, _cfg.neighbors_to_explore_at_construction(), best_neighbors, search_level);
+        search_layer(distance, _cfg.neighbors_to_explore_at_construction(), best_neighbors, search_level);
         auto neighbors = select_neighbors(best_neighbors.peek(), _cfg.max_links_on_inserts());
         auto& links = connections[search_level];
         links.reserve(neighbors.used.size());
@@ -495,6 +632,9 @@ void
 HnswIndex<type>::internal_complete_add_node(uint32_t nodeid, uint32_t docid, uint32_t subspace, PreparedAddNode &prepared_node)
 {
     int32_t num_levels = prepared_node.connections.size();
+    if (_quantized_vectors) {
+        _quantized_vectors->set(nodeid, get_vector(docid, subspace));
+    }
     auto node_ref = _graph.make_node(nodeid, docid, subspace, num_levels);
     for (int level = 0; level < num_levels; ++level) {
         auto neighbors = filter_valid_nodeids(level, prepared_node.connections[level], nodeid);
@@ -612,6 +752,9 @@ HnswIndex<type>::assign_generation(generation_t current_gen)
     _graph.nodes.assign_generation(current_gen);
     _graph.links.assign_generation(current_gen);
     _id_mapping.assign_generation(current_gen);
+    if (_quantized_vectors) {
+        _quantized_vectors->assign_generation(current_gen);
+    }
 }
 
 template <HnswIndexType type>
@@ -622,6 +765,9 @@ HnswIndex<type>::reclaim_memory(generation_t oldest_used_gen)
     _graph.nodes.reclaim_memory(oldest_used_gen);
     _graph.links.reclaim_memory(oldest_used_gen);
     _id_mapping.reclaim_memory(oldest_used_gen);
+    if (_quantized_vectors) {
+        _quantized_vectors->reclaim_memory(oldest_used_gen);
+    }
 }
 
 template <HnswIndexType type>
@@ -707,6 +853,9 @@ HnswIndex<type>::update_stat(const CompactionStrategy& compaction_strategy)
     _compaction_spec = HnswIndexCompactionSpec(compaction_strategy.should_compact(level_arrays_memory_usage, level_arrays_address_space_usage),
                                                compaction_strategy.should_compact(link_arrays_memory_usage, link_arrays_address_space_usage));
     result.merge(link_arrays_memory_usage);
+    if (_quantized_vectors) {
+        result.merge(_quantized_vectors->memory_usage());
+    }
     return result;
 }
 
@@ -719,6 +868,9 @@ HnswIndex<type>::memory_usage() const
     result.merge(_graph.nodes.getMemoryUsage());
     result.merge(_graph.links.getMemoryUsage());
     result.merge(_id_mapping.memory_usage());
+    if (_quantized_vectors) {
+        result.merge(_quantized_vectors->memory_usage());
+    }
     return result;
 }
 
@@ -740,6 +892,9 @@ HnswIndex<type>::get_state(const vespalib::slime::Inserter& inserter) const
     StateExplorerUtils::memory_usage_to_slime(_graph.node_refs.getMemoryUsage(), memUsageObj.setObject("node_refs"));
     StateExplorerUtils::memory_usage_to_slime(_graph.nodes.getMemoryUsage(), memUsageObj.setObject("nodes"));
     StateExplorerUtils::memory_usage_to_slime(_graph.links.getMemoryUsage(), memUsageObj.setObject("links"));
+    if (_quantized_vectors) {
+        StateExplorerUtils::memory_usage_to_slime(_quantized_vectors->memory_usage(), memUsageObj.setObject("quantized_vectors"));
+    }
     object.setLong("nodes", _graph.size());
     auto& histogram_array = object.setArray("level_histogram");
     auto& links_hst_array = object.setArray("level_0_links_histogram");
@@ -768,6 +923,7 @@ HnswIndex<type>::get_state(const vespalib::slime::Inserter& inserter) const
     cfgObj.setLong("max_links_on_inserts", _cfg.max_links_on_inserts());
     cfgObj.setLong("neighbors_to_explore_at_construction",
                    _cfg.neighbors_to_explore_at_construction());
+    cfgObj.setBool("quantized_vectors", static_cast<bool>(_quantized_vectors));
 }
 
 template <HnswIndexType type>
@@ -781,6 +937,9 @@ HnswIndex<type>::shrink_lid_space(uint32_t doc_id_limit)
         return;
     }
     _graph.node_refs.shrink(doc_id_limit);
+    if (_quantized_vectors) {
+        _quantized_vectors->shrink(doc_id_limit);
+    }
 }
 
 template <HnswIndexType type>
@@ -792,12 +951,28 @@ HnswIndex<type>::make_saver() const
 
 template <HnswIndexType type>
 std::unique_ptr<NearestNeighborIndexLoader>
-HnswIndex<type>::make_loader(FastOS_FileInterface& file)
+HnswIndex<type>::make_loader(const fileutil::LoadedBuffer& buffer)
 {
     assert(get_entry_nodeid() == 0); // cannot load after index has data
-    using ReaderType = FileReader<uint32_t>;
+    using ReaderType = ReleasingBufferReader<uint32_t>;
     using LoaderType = HnswIndexLoader<ReaderType, type>;
-    return std::make_unique<LoaderType>(_graph, _id_mapping, std::make_unique<ReaderType>(&file));
+    auto loader = std::make_unique<LoaderType>(_graph, _id_mapping, std::make_unique<ReaderType>(buffer));
+    if (_quantized_vectors) {
+        return std::make_unique<QuantizingIndexLoader>(std::move(loader), [this]() { populate_quantized_vectors(); });
+    }
+    return loader;
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::populate_quantized_vectors()
+{
+    uint32_t nodeid_limit = _graph.node_refs_size.load(std::memory_order_relaxed);
+    for (uint32_t nodeid = 1; nodeid < nodeid_limit; ++nodeid) {
+        if (_graph.get_node_ref(nodeid).valid()) {
+            _quantized_vectors->set(nodeid, get_vector(nodeid));
+        }
+    }
 }
 
 struct NeighborsByDocId {
@@ -847,20 +1022,63 @@ HnswIndex<type>::top_k_candidates(const TypedCells &vector, uint32_t k, const Gl
         // graph has no entry point
         return best_neighbors;
     }
-    int search_level = entry.level;
-    double entry_dist = calc_distance(vector, entry.nodeid);
-    uint32_t entry_docid = get_docid(entry.nodeid);
-    // TODO: check if entry docid/node_ref is still valid here
-    HnswCandidate entry_point(entry.nodeid, entry_docid, entry.node_ref, entry_dist);
-    while (search_level > 0) {
-        entry_point = find_nearest_in_layer(vector, entry_point, search_level);
-        --search_level;
+    TraversalDistance distance(*this, vector, true);
+    best_neighbors.push(find_nearest_in_upper_layers(distance, entry));
+    search_layer(distance, k, best_neighbors, 0, filter);
+    if (distance.quantized()) {
+        return rescore_candidates(vector, best_neighbors);
     }
-    best_neighbors.push(entry_point);
-    search_layer(vector, k, best_neighbors, 0, filter);
     return best_neighbors;
 }
 
+template <HnswIndexType type>
+typename HnswIndex<type>::SearchBestNeighbors
+HnswIndex<type>::rescore_candidates(const TypedCells& vector, const SearchBestNeighbors& candidates) const
+{
+    SearchBestNeighbors result;
+    for (const auto& candidate : candidates.peek()) {
+        result.emplace(candidate.nodeid, candidate.docid, candidate.node_ref, calc_distance(vector, candidate.nodeid));
+    }
+    return result;
+}
+
+template <HnswIndexType type>
+std::vector<std::vector<NearestNeighborIndex::Neighbor>>
+HnswIndex<type>::find_top_k_batch(const std::vector<TopKQuery>& queries, const GlobalFilter* filter) const
+{
+    std::vector<std::vector<Neighbor>> result(queries.size());
+    auto entry = _graph.get_entry_node();
+    if (entry.nodeid == 0) {
+        // graph has no entry point
+        return result;
+    }
+    std::vector<TypedCells> vectors;
+    std::vector<uint32_t> neighbors_to_find;
+    std::vector<SearchBestNeighbors> best_neighbors(queries.size());
+    vectors.reserve(queries.size());
+    neighbors_to_find.reserve(queries.size());
+    // The upper levels are small, and are searched for each query separately.
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const auto& query = queries[i];
+        TraversalDistance distance(*this, query.vector, true);
+        best_neighbors[i].push(find_nearest_in_upper_layers(distance, entry));
+        vectors.push_back(query.vector);
+        neighbors_to_find.push_back(std::max(query.k, query.explore_k));
+    }
+    BatchTraversalDistance distances(*this, std::move(vectors), true);
+    search_layer_batch(distances, neighbors_to_find, best_neighbors, filter);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const auto& query = queries[i];
+        if (distances.quantized()) {
+            result[i] = rescore_candidates(query.vector, best_neighbors[i]).get_neighbors(query.k, query.distance_threshold);
+        } else {
+            result[i] = best_neighbors[i].get_neighbors(query.k, query.distance_threshold);
+        }
+        std::sort(result[i].begin(), result[i].end(), NeighborsByDocId());
+    }
+    return result;
+}
+
 template <HnswIndexType type>
 HnswTestNode
 HnswIndex<type>::get_node(uint32_t nodeid) const
@@ -886,6 +1104,9 @@ HnswIndex<type>::set_node(uint32_t nodeid, const HnswTestNode &node)
 {
     size_t num_levels = node.size();
     assert(num_levels > 0);
+    if (_quantized_vectors) {
+        _quantized_vectors->set(nodeid, get_vector(nodeid, 0));
+    }
     auto node_ref = _graph.make_node(nodeid, nodeid, 0, num_levels);
     for (size_t level = 0; level < num_levels; ++level) {
         connect_new_node(nodeid, node.level(level), level);
@@ -14,6 +14,7 @@
 #include "nearest_neighbor_index.h"
 #include "random_level_generator.h"
 #include "hnsw_graph.h"
+#include "scalar_quantized_vector_store.h"
 #include "vector_bundle.h"
 #include <vespa/eval/eval/typed_cells.h>
 #include <vespa/searchlib/common/bitvector.h>
@@ -22,6 +23,7 @@
 #include <vespa/vespalib/datastore/compaction_spec.h>
 #include <vespa/vespalib/datastore/entryref.h>
 #include <vespa/vespalib/stllike/allocator.h>
+#include <optional>
 
 namespace search::tensor {
 
@@ -101,6 +103,7 @@ protected:
     IdMapping _id_mapping; // mapping from docid to nodeid vector
     HnswIndexConfig _cfg;
     HnswIndexCompactionSpec _compaction_spec;
+    std::unique_ptr<ScalarQuantizedVectorStore> _quantized_vectors;
 
     uint32_t max_links_for_level(uint32_t level) const;
     void add_link_to(uint32_t nodeid, uint32_t level, const LinkArrayRef& old_links, uint32_t new_link) {
@@ -155,18 +158,114 @@ protected:
     double calc_distance(const TypedCells& lhs, uint32_t rhs_docid, uint32_t rhs_subspace) const;
     uint32_t estimate_visited_nodes(uint32_t level, uint32_t nodeid_limit, uint32_t neighbors_to_find, const GlobalFilter* filter) const;
 
+    /**
+     * Calculates the distance between an input vector and the nodes visited during graph traversal.
+     *
+     * When the index has quantized vectors and use_quantized is set, the distances are calculated
+     * on the int8 codes of the quantized input and node vectors instead of the original cells.
+     * The resulting distances are approximate and must be rescored before being returned to the caller.
+     */
+    class TraversalDistance {
+        const HnswIndex& _index;
+        TypedCells _input;
+        std::optional<ScalarQuantizedVectorStore::QueryDistance> _quantized;
+    public:
+        TraversalDistance(const HnswIndex& index, TypedCells input, bool use_quantized)
+            : _index(index),
+              _input(input),
+              _quantized()
+        {
+            if (use_quantized && index._quantized_vectors) {
+                _quantized.emplace(*index._quantized_vectors, input);
+            }
+        }
+        ~TraversalDistance() = default;
+        const TypedCells& input() const noexcept { return _input; }
+        bool quantized() const noexcept { return _quantized.has_value(); }
+        double calc(uint32_t nodeid) {
+            if (_quantized) {
+                return _quantized->calc(nodeid);
+            }
+            return _index.calc_distance(_input, nodeid);
+        }
+        double calc(uint32_t nodeid, uint32_t docid, uint32_t subspace) {
+            if (_quantized) {
+                return _quantized->calc(nodeid);
+            }
+            return _index.calc_distance(_input, docid, subspace);
+        }
+    };
+
+    /**
+     * Calculates the distance between several input vectors and the nodes visited during a batched
+     * graph traversal. Each node vector is read once and compared against all input vectors.
+     */
+    class BatchTraversalDistance {
+        const HnswIndex& _index;
+        std::vector<TypedCells> _inputs;
+        std::vector<ScalarQuantizedVectorStore::QueryDistance> _quantized;
+    public:
+        BatchTraversalDistance(const HnswIndex& index, std::vector<TypedCells> inputs, bool use_quantized)
+            : _index(index),
+              _inputs(std::move(inputs)),
+              _quantized()
+        {
+            if (use_quantized && index._quantized_vectors) {
+                _quantized.reserve(_inputs.size());
+                for (const auto& input : _inputs) {
+                    _quantized.emplace_back(*index._quantized_vectors, input);
+                }
+            }
+        }
+        ~BatchTraversalDistance() = default;
+        size_t size() const noexcept { return _inputs.size(); }
+        bool quantized() const noexcept { return !_quantized.empty(); }
+        void calc(uint32_t nodeid, uint32_t docid, uint32_t subspace, double* result) {
+            if (quantized()) {
+                for (size_t i = 0; i < _quantized.size(); ++i) {
+                    result[i] = _quantized[i].calc(nodeid);
+                }
+            } else {
+                _index._distance_func->calc_batch(_inputs.data(), _inputs.size(), _index.get_vector(docid, subspace), result);
+            }
+        }
+    };
+
     /**
      * Performs a greedy search in the given layer to find the candidate that is nearest the input vector.
      */
-    HnswCandidate find_nearest_in_layer(const TypedCells& input, const HnswCandidate& entry_point, uint32_t level) const;
+    HnswCandidate find_nearest_in_layer(TraversalDistance& distance, const HnswCandidate& entry_point, uint32_t level) const;
+    /**
+     * Performs a greedy search from the entry node down through all layers above level 0,
+     * and returns the candidate to start the level 0 search from.
+     */
+    HnswCandidate find_nearest_in_upper_layers(TraversalDistance& distance, const typename GraphType::EntryNode& entry) const;
     template <class VisitedTracker, class BestNeighbors>
-    void search_layer_helper(const TypedCells& input, uint32_t neighbors_to_find, BestNeighbors& best_neighbors,
+    void search_layer_helper(TraversalDistance& distance, uint32_t neighbors_to_find, BestNeighbors& best_neighbors,
                              uint32_t level, const GlobalFilter *filter,
                              uint32_t nodeid_limit,
                              uint32_t estimated_visited_nodes) const;
     template <class BestNeighbors>
-    void search_layer(const TypedCells& input, uint32_t neighbors_to_find, BestNeighbors& best_neighbors,
+    void search_layer(TraversalDistance& distance, uint32_t neighbors_to_find, BestNeighbors& best_neighbors,
                       uint32_t level, const GlobalFilter *filter = nullptr) const;
+    /**
+     * Searches level 0 for several input vectors at the same time.
+     * The link arrays of expanded nodes are fetched once and the visited tracking is shared.
+     * Each newly visited node is compared against all input vectors using the one-to-many
+     * DistanceFunction::calc_batch(), so the node vector is read from memory once per batch.
+     * This does not reduce the number of distance calculations: a node reached by the search for
+     * one input vector is also compared against the others.
+     */
+    template <class VisitedTracker>
+    void search_layer_batch_helper(BatchTraversalDistance& distances, const std::vector<uint32_t>& neighbors_to_find,
+                                   std::vector<SearchBestNeighbors>& best_neighbors, const GlobalFilter *filter,
+                                   uint32_t nodeid_limit, uint32_t estimated_visited_nodes) const;
+    void search_layer_batch(BatchTraversalDistance& distances, const std::vector<uint32_t>& neighbors_to_find,
+                            std::vector<SearchBestNeighbors>& best_neighbors, const GlobalFilter *filter) const;
+    /**
+     * Recalculates the distances of the given candidates using the original cells.
+     */
+    SearchBestNeighbors rescore_candidates(const TypedCells& vector, const SearchBestNeighbors& candidates) const;
     std::vector<Neighbor> top_k_by_docid(uint32_t k, TypedCells vector,
                                          const GlobalFilter *filter, uint32_t explore_k,
                                          double distance_threshold) const;
@@ -210,10 +309,12 @@ protected:
     void internal_complete_add_node(uint32_t nodeid, uint32_t docid, uint32_t subspace, PreparedAddNode &prepared_node);
 public:
     HnswIndex(const DocVectorAccess& vectors, DistanceFunction::UP distance_func,
-              RandomLevelGenerator::UP level_generator, const HnswIndexConfig& cfg);
+              RandomLevelGenerator::UP level_generator, const HnswIndexConfig& cfg,
+              std::unique_ptr<ScalarQuantizedVectorStore> quantized_vectors = {});
     ~HnswIndex() override;
 
     const HnswIndexConfig& config() const { return _cfg; }
+    const ScalarQuantizedVectorStore* quantized_vectors() const { return _quantized_vectors.get(); }
 
     // Implements NearestNeighborIndex
     void add_document(uint32_t docid) override;
@@ -237,13 +338,17 @@ public:
     void shrink_lid_space(uint32_t doc_id_limit) override;
 
     std::unique_ptr<NearestNeighborIndexSaver> make_saver() const override;
-    std::unique_ptr<NearestNeighborIndexLoader> make_loader(FastOS_FileInterface& file) override;
+    std::unique_ptr<NearestNeighborIndexLoader> make_loader(const fileutil::LoadedBuffer& buffer) override;
+    // Quantizes the vectors of all nodes in the graph. Used after the graph is loaded.
+    void populate_quantized_vectors();
 
     std::vector<Neighbor> find_top_k(uint32_t k, TypedCells vector, uint32_t explore_k,
                                      double distance_threshold) const override;
     std::vector<Neighbor> find_top_k_with_filter(uint32_t k, TypedCells vector,
                                                  const GlobalFilter &filter, uint32_t explore_k,
                                                  double distance_threshold) const override;
+    std::vector<std::vector<Neighbor>> find_top_k_batch(const std::vector<TopKQuery>& queries,
+                                                        const GlobalFilter* filter) const override;
     const DistanceFunction *distance_function() const override { return _distance_func.get(); }
 
     SearchBestNeighbors top_k_candidates(const TypedCells &vector, uint32_t k, const GlobalFilter *filter) const;
@@ -4,7 +4,9 @@
 
 #include "nearest_neighbor_index_loader.h"
 #include "hnsw_index_traits.h"
+#include <vespa/vespalib/util/arrayref.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <concepts>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -16,6 +18,15 @@ namespace search::tensor {
 template <HnswIndexType type>
 struct HnswGraph;
 
+/**
+ * Readers that can return a reference to an array of values in their underlying buffer (e.g. a mmapped file).
+ * The loader copies the referenced array into the graph, without an intermediate vector.
+ */
+template <typename ReaderType>
+concept has_read_array = requires(ReaderType& reader, size_t count) {
+    { reader.read_array(count) } -> std::convertible_to<vespalib::ConstArrayRef<uint32_t>>;
+};
+
 /**
  * Implements loading of HNSW graph structure from binary format.
  **/
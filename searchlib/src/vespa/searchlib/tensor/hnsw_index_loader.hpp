@@ -50,11 +50,16 @@ HnswIndexLoader<ReaderType, type>::load_next()
             _graph.make_node(_nodeid, docid, subspace, num_levels);
             for (uint32_t level = 0; level < num_levels; ++level) {
                 uint32_t num_links = next_int();
-                _link_array.clear();
-                while (num_links-- > 0) {
-                    _link_array.push_back(next_int());
+                if constexpr (has_read_array<ReaderType>) {
+                    // Link array is referenced directly in the reader buffer, without an intermediate copy.
+                    _graph.set_link_array(_nodeid, level, _reader->read_array(num_links));
+                } else {
+                    _link_array.clear();
+                    while (num_links-- > 0) {
+                        _link_array.push_back(next_int());
+                    }
+                    _graph.set_link_array(_nodeid, level, _link_array);
                 }
-                _graph.set_link_array(_nodeid, level, _link_array);
             }
         }
     }
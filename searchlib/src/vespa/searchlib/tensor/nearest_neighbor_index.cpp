@@ -1,3 +1,22 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "nearest_neighbor_index.h"
+
+namespace search::tensor {
+
+std::vector<std::vector<NearestNeighborIndex::Neighbor>>
+NearestNeighborIndex::find_top_k_batch(const std::vector<TopKQuery>& queries, const GlobalFilter* filter) const
+{
+    std::vector<std::vector<Neighbor>> result;
+    result.reserve(queries.size());
+    for (const auto& query : queries) {
+        if (filter != nullptr) {
+            result.push_back(find_top_k_with_filter(query.k, query.vector, *filter, query.explore_k, query.distance_threshold));
+        } else {
+            result.push_back(find_top_k(query.k, query.vector, query.explore_k, query.distance_threshold));
+        }
+    }
+    return result;
+}
+
+}
@@ -11,8 +11,6 @@
 #include <memory>
 #include <vector>
 
-class FastOS_FileInterface;
-
 namespace vespalib::datastore {
 class CompactionSpec;
 class CompactionStrategy;
@@ -49,6 +47,18 @@ public:
             return docid == rhs.docid && distance == rhs.distance;
         }
     };
+    /**
+     * One query vector in a batch of top k searches, with its own parameters.
+     */
+    struct TopKQuery {
+        vespalib::eval::TypedCells vector;
+        uint32_t k;
+        uint32_t explore_k;
+        double distance_threshold;
+        TopKQuery(vespalib::eval::TypedCells vector_in, uint32_t k_in, uint32_t explore_k_in, double distance_threshold_in) noexcept
+            : vector(vector_in), k(k_in), explore_k(explore_k_in), distance_threshold(distance_threshold_in)
+        {}
+    };
     virtual ~NearestNeighborIndex() = default;
     virtual void add_document(uint32_t docid) = 0;
 
@@ -90,11 +100,12 @@ public:
     virtual std::unique_ptr<NearestNeighborIndexSaver> make_saver() const = 0;
 
     /**
-     * Creates a loader that is used to load the index from the given file.
+     * Creates a loader that is used to load the index from the given buffer (the mmapped index file).
+     * The index is copied into memory owned by the index; the buffer must outlive the loader.
      *
      * This might throw std::runtime_error.
      */
-    virtual std::unique_ptr<NearestNeighborIndexLoader> make_loader(FastOS_FileInterface& file) = 0;
+    virtual std::unique_ptr<NearestNeighborIndexLoader> make_loader(const fileutil::LoadedBuffer& buffer) = 0;
 
     virtual std::vector<Neighbor> find_top_k(uint32_t k,
                                              vespalib::eval::TypedCells vector,
@@ -108,6 +119,16 @@ public:
                                                          uint32_t explore_k,
                                                          double distance_threshold) const = 0;
 
+    /**
+     * Performs top k search for all the given queries, returning the neighbors of each query (sorted by docid)
+     * in the same order as the queries. Only neighbors where the corresponding filter bit is set are returned
+     * if a filter is given.
+     *
+     * The default implementation searches for one query at a time.
+     */
+    virtual std::vector<std::vector<Neighbor>> find_top_k_batch(const std::vector<TopKQuery>& queries,
+                                                                const GlobalFilter* filter) const;
+
     virtual const DistanceFunction *distance_function() const = 0;
 };
 
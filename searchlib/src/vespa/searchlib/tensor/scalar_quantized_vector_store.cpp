@@ -0,0 +1,163 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "scalar_quantized_vector_store.h"
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using search::attribute::DistanceMetric;
+
+namespace search::tensor {
+
+ScalarQuantizedVectorStore::ScalarQuantizedVectorStore(uint32_t dims, DistanceMetric metric)
+    : _dims(dims),
+      _metric(metric),
+      _codes(),
+      _params()
+{
+    assert(_dims > 0);
+    assert(supports(_metric));
+}
+
+ScalarQuantizedVectorStore::~ScalarQuantizedVectorStore() = default;
+
+bool
+ScalarQuantizedVectorStore::supports(DistanceMetric metric) noexcept
+{
+    switch (metric) {
+    case DistanceMetric::Euclidean:
+    case DistanceMetric::Angular:
+    case DistanceMetric::InnerProduct:
+        return true;
+    default:
+        return false;
+    }
+}
+
+ScalarQuantizedVectorStore::Params
+ScalarQuantizedVectorStore::quantize(vespalib::ConstArrayRef<float> values, int8_t* codes) noexcept
+{
+    auto minmax = std::minmax_element(values.begin(), values.end());
+    float min_value = *minmax.first;
+    float scale = (*minmax.second - min_value) / 255.0f;
+    float inv_scale = (scale > 0.0f) ? (1.0f / scale) : 0.0f;
+    float offset = min_value + 128.0f * scale;
+    int64_t code_sum = 0;
+    double norm_sq = 0.0;
+    for (size_t i = 0; i < values.size(); ++i) {
+        long code = std::clamp(std::lround((values[i] - min_value) * inv_scale) - 128, -128l, 127l);
+        codes[i] = static_cast<int8_t>(code);
+        code_sum += code;
+        double value = offset + scale * code;
+        norm_sq += value * value;
+    }
+    return {offset, scale, float(code_sum), float(norm_sq)};
+}
+
+void
+ScalarQuantizedVectorStore::set(uint32_t nodeid, vespalib::eval::TypedCells cells)
+{
+    auto values = cells.typify<float>();
+    assert(values.size() == _dims);
+    size_t codes_start = size_t(nodeid) * _dims;
+    size_t params_start = size_t(nodeid) * params_size;
+    _codes.ensure_size(codes_start + _dims);
+    _params.ensure_size(params_start + params_size);
+    Params params = quantize(values, &_codes[codes_start]);
+    _params[params_start] = params.offset;
+    _params[params_start + 1] = params.scale;
+    _params[params_start + 2] = params.code_sum;
+    _params[params_start + 3] = params.norm_sq;
+}
+
+vespalib::eval::TypedCells
+ScalarQuantizedVectorStore::get_vector(uint32_t nodeid, float* buf) const noexcept
+{
+    const int8_t* codes = get_codes(nodeid);
+    Params params = get_params(nodeid);
+    for (uint32_t i = 0; i < _dims; ++i) {
+        buf[i] = params.offset + params.scale * codes[i];
+    }
+    return {buf, vespalib::eval::CellType::FLOAT, _dims};
+}
+
+ScalarQuantizedVectorStore::QueryDistance::QueryDistance(const ScalarQuantizedVectorStore& store,
+                                                         vespalib::eval::TypedCells query)
+    : _store(store),
+      _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator()),
+      _codes(store.dims()),
+      _params()
+{
+    auto values = query.typify<float>();
+    assert(values.size() == store.dims());
+    _params = quantize(values, _codes.data());
+}
+
+ScalarQuantizedVectorStore::QueryDistance::QueryDistance(QueryDistance&&) noexcept = default;
+ScalarQuantizedVectorStore::QueryDistance::~QueryDistance() = default;
+
+double
+ScalarQuantizedVectorStore::QueryDistance::calc(uint32_t nodeid) const noexcept
+{
+    // With q[i] = qo + qs * qc[i] and x[i] = xo + xs * xc[i], the dot product expands to
+    // terms that only depend on each vector, and the int8 dot product of the codes.
+    uint32_t dims = _store.dims();
+    Params x = _store.get_params(nodeid);
+    double code_dot = _computer.dotProduct(_codes.data(), _store.get_codes(nodeid), dims);
+    double dot = double(dims) * _params.offset * x.offset +
+                 double(_params.offset) * x.scale * x.code_sum +
+                 double(x.offset) * _params.scale * _params.code_sum +
+                 double(_params.scale) * x.scale * code_dot;
+    switch (_store._metric) {
+    case DistanceMetric::Euclidean:
+        return std::max(0.0, double(_params.norm_sq) + x.norm_sq - 2.0 * dot);
+    case DistanceMetric::Angular: {
+        double squared_norms = double(_params.norm_sq) * x.norm_sq;
+        double div = (squared_norms > 0) ? std::sqrt(squared_norms) : 1.0;
+        return 1.0 - dot / div;
+    }
+    default:
+        return std::max(0.0, 1.0 - dot);
+    }
+}
+
+void
+ScalarQuantizedVectorStore::shrink(uint32_t nodeid_limit)
+{
+    size_t codes_size = size_t(nodeid_limit) * _dims;
+    if (codes_size < _codes.size()) {
+        _codes.shrink(codes_size);
+    }
+    size_t params_limit = size_t(nodeid_limit) * params_size;
+    if (params_limit < _params.size()) {
+        _params.shrink(params_limit);
+    }
+}
+
+void
+ScalarQuantizedVectorStore::assign_generation(generation_t current_gen)
+{
+    // Note: RcuVector transfers hold lists as part of reallocation based on current generation.
+    //       We need to set the next generation here, as it is incremented on a higher level right after this call.
+    _codes.setGeneration(current_gen + 1);
+    _params.setGeneration(current_gen + 1);
+}
+
+void
+ScalarQuantizedVectorStore::reclaim_memory(generation_t oldest_used_gen)
+{
+    _codes.reclaim_memory(oldest_used_gen);
+    _params.reclaim_memory(oldest_used_gen);
+}
+
+vespalib::MemoryUsage
+ScalarQuantizedVectorStore::memory_usage() const
+{
+    vespalib::MemoryUsage result;
+    result.merge(_codes.getMemoryUsage());
+    result.merge(_params.getMemoryUsage());
+    return result;
+}
+
+}
@@ -0,0 +1,102 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/typed_cells.h>
+#include <vespa/searchcommon/attribute/distance_metric.h>
+#include <vespa/vespalib/util/arrayref.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <cstdint>
+#include <vector>
+
+namespace vespalib::hwaccelrated { class IAccelrated; }
+
+namespace search::tensor {
+
+/**
+ * Stores an int8 scalar quantized shadow copy of the vectors in a hnsw index, indexed by nodeid.
+ *
+ * Each vector is stored as one byte per dimension, together with an offset and a scale per vector,
+ * such that cell[i] ~= offset + scale * code[i].
+ * This is used to calculate approximate distances during graph traversal.
+ * The query vector is quantized the same way (see QueryDistance), so that each distance is computed
+ * from an int8 dot product between the codes and a few per vector terms stored alongside them,
+ * reading 4x fewer bytes than the original float cells.
+ *
+ * Supports the euclidean, angular and innerproduct distance metrics.
+ * Supports 1 write thread and multiple search threads, using the same generation tracking as the graph.
+ */
+class ScalarQuantizedVectorStore {
+private:
+    using generation_t = vespalib::GenerationHandler::generation_t;
+
+    // Per vector terms, see set().
+    struct Params {
+        float offset;
+        float scale;
+        float code_sum;
+        float norm_sq;
+    };
+
+    uint32_t                               _dims;
+    search::attribute::DistanceMetric      _metric;
+    vespalib::RcuVector<int8_t>            _codes;
+    vespalib::RcuVector<float>             _params;
+
+    static constexpr size_t params_size = sizeof(Params) / sizeof(float);
+
+    Params get_params(uint32_t nodeid) const noexcept {
+        const float* p = &_params.acquire_elem_ref(size_t(nodeid) * params_size);
+        return {p[0], p[1], p[2], p[3]};
+    }
+    const int8_t* get_codes(uint32_t nodeid) const noexcept {
+        return &_codes.acquire_elem_ref(size_t(nodeid) * _dims);
+    }
+    static Params quantize(vespalib::ConstArrayRef<float> values, int8_t* codes) noexcept;
+
+public:
+    ScalarQuantizedVectorStore(uint32_t dims, search::attribute::DistanceMetric metric);
+    ~ScalarQuantizedVectorStore();
+
+    static bool supports(search::attribute::DistanceMetric metric) noexcept;
+
+    uint32_t dims() const noexcept { return _dims; }
+
+    /**
+     * Quantizes and stores the given float vector for the given nodeid.
+     * Called from writer only, before the node is made visible to readers.
+     */
+    void set(uint32_t nodeid, vespalib::eval::TypedCells cells);
+
+    /**
+     * Dequantizes the vector for the given nodeid into the given buffer (of dims() floats).
+     * Not used when searching, but useful for inspecting the stored approximations.
+     */
+    vespalib::eval::TypedCells get_vector(uint32_t nodeid, float* buf) const noexcept;
+
+    /**
+     * Calculates approximate distances between a quantized query vector and the stored vectors,
+     * using the same representation as the exact distance function for the metric.
+     * Readers must hold a generation guard and only ask for nodes that are present in the graph.
+     */
+    class QueryDistance {
+        const ScalarQuantizedVectorStore& _store;
+        const vespalib::hwaccelrated::IAccelrated& _computer;
+        std::vector<int8_t> _codes;
+        Params _params;
+    public:
+        QueryDistance(const ScalarQuantizedVectorStore& store, vespalib::eval::TypedCells query);
+        QueryDistance(QueryDistance&&) noexcept;
+        ~QueryDistance();
+        double calc(uint32_t nodeid) const noexcept;
+    };
+
+    void shrink(uint32_t nodeid_limit);
+    void assign_generation(generation_t current_gen);
+    void reclaim_memory(generation_t oldest_used_gen);
+    vespalib::MemoryUsage memory_usage() const;
+};
+
+}
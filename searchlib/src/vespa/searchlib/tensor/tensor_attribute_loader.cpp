@@ -15,8 +15,10 @@
 #include <vespa/vespalib/util/arrayqueue.hpp>
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/lambdatask.h>
-#include <mutex>
+#include <algorithm>
 #include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.tensor.tensor_attribute_loader");
@@ -48,6 +50,19 @@ can_use_index_save_file(const search::attribute::Config &config, const Attribute
     return true;
 }
 
+uint32_t
+build_threads(const search::attribute::Config &config)
+{
+    uint32_t threads = 0;
+    if (config.hnsw_index_params().has_value()) {
+        threads = config.hnsw_index_params().value().build_threads();
+    }
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    return std::max(threads, 1u);
+}
+
 bool
 has_index_file(AttributeVector& attr)
 {
@@ -75,96 +90,106 @@ public:
 /**
  * Will build nearest neighbor index in parallel. Note that indexing order is not guaranteed,
  * but that is inline with the guarantees vespa already has.
+ *
+ * Lids are grouped in batches, and at most max_threads batches are prepared concurrently
+ * by tasks on the shared executor. The prepared documents are completed in the foreground thread.
  */
 class ThreadedIndexBuilder : public IndexBuilder {
 public:
-    ThreadedIndexBuilder(TensorAttribute& attr, vespalib::GenerationHandler& generation_handler, TensorStore& store, NearestNeighborIndex& index, vespalib::Executor& shared_executor)
+    ThreadedIndexBuilder(TensorAttribute& attr, vespalib::GenerationHandler& generation_handler, NearestNeighborIndex& index, vespalib::Executor& shared_executor, uint32_t max_threads)
         : _attr(attr),
           _generation_handler(generation_handler),
           _index(index),
           _shared_executor(shared_executor),
-          _queue(MAX_PENDING),
-          _pending(0)
+          _max_threads(std::max(max_threads, 1u)),
+          _batch(),
+          _queue(),
+          _running_batches(0)
     {
-        (void) store;
+        _batch.reserve(BATCH_SIZE);
+    }
+    void add(uint32_t lid) override {
+        _batch.push_back(lid);
+        if (_batch.size() >= BATCH_SIZE) {
+            dispatch_batch();
+        }
     }
-    void add(uint32_t lid) override;
     void wait_complete() override {
-        drainUntilPending(0);
+        if (!_batch.empty()) {
+            dispatch_batch();
+        }
+        drain_until_running(0);
     }
 private:
     using Entry = std::pair<uint32_t, std::unique_ptr<PrepareResult>>;
     using Queue = vespalib::ArrayQueue<Entry>;
 
-    bool pop(Entry & entry) {
-        std::unique_lock guard(_mutex);
-        if (_queue.empty()) return false;
-        entry = std::move(_queue.front());
-        _queue.pop();
-        return true;
-    }
-    void drainQ() {
-        Queue queue(MAX_PENDING);
-        {
-            std::unique_lock guard(_mutex);
-            queue.swap(_queue);
-        }
-        while (!queue.empty()) {
-            auto item = std::move(queue.front());
-            queue.pop();
-            complete(item.first, std::move(item.second));
-        }
-    }
-
     void complete(uint32_t lid, std::unique_ptr<PrepareResult> prepared) {
         _index.complete_add_document(lid, std::move(prepared));
-        --_pending;
         if ((lid % LOAD_COMMIT_INTERVAL) == 0) {
             _attr.commit();
-        };
+        }
     }
-    void drainUntilPending(uint32_t maxPending) {
-        while (_pending > maxPending) {
+    // Completes prepared documents until no more than max_running batches are being prepared.
+    void drain_until_running(uint32_t max_running) {
+        Queue ready;
+        bool done = false;
+        while (!done) {
             {
                 std::unique_lock guard(_mutex);
-                while (_queue.empty()) {
+                while (_queue.empty() && _running_batches > max_running) {
                     _cond.wait(guard);
                 }
+                ready.swap(_queue);
+                done = (_running_batches <= max_running);
+            }
+            while (!ready.empty()) {
+                auto item = std::move(ready.front());
+                ready.pop();
+                complete(item.first, std::move(item.second));
             }
-            drainQ();
         }
     }
-    static constexpr uint32_t MAX_PENDING = 1000;
+    void dispatch_batch();
+
+    static constexpr uint32_t BATCH_SIZE = 64;
     TensorAttribute&        _attr;
     const vespalib::GenerationHandler& _generation_handler;
     NearestNeighborIndex&   _index;
     vespalib::Executor&     _shared_executor;
+    const uint32_t          _max_threads;
+    std::vector<uint32_t>   _batch; // only used in foreground thread
     std::mutex              _mutex;
     std::condition_variable _cond;
     Queue                   _queue;
-    uint64_t                _pending; // _pending is only modified in forground thread
+    uint32_t                _running_batches;
 };
 
 void
-ThreadedIndexBuilder::add(uint32_t lid) {
-    Entry item;
-    while (pop(item)) {
-        // First process items that are ready to complete
-        complete(item.first, std::move(item.second));
+ThreadedIndexBuilder::dispatch_batch()
+{
+    // Complete what is ready, and ensure that no more than max_threads batches are inflight
+    drain_until_running(_max_threads - 1);
+    {
+        std::lock_guard guard(_mutex);
+        ++_running_batches;
     }
-    // Then ensure that there no more than MAX_PENDING inflight
-    drainUntilPending(MAX_PENDING);
-
-    // Then we can issue a new one
-    ++_pending;
-    auto task = vespalib::makeLambdaTask([this, lid]() {
-        auto prepared = _index.prepare_add_document(lid, _attr.get_vectors(lid),
-                                                    _generation_handler.takeGuard());
-        std::unique_lock guard(_mutex);
-        _queue.push(std::make_pair(lid, std::move(prepared)));
-        if (_queue.size() == 1) {
-            _cond.notify_all();
+    std::vector<uint32_t> batch;
+    batch.reserve(BATCH_SIZE);
+    batch.swap(_batch);
+    auto task = vespalib::makeLambdaTask([this, batch = std::move(batch)]() {
+        for (uint32_t lid : batch) {
+            auto prepared = _index.prepare_add_document(lid, _attr.get_vectors(lid),
+                                                        _generation_handler.takeGuard());
+            std::lock_guard guard(_mutex);
+            _queue.push(std::make_pair(lid, std::move(prepared)));
+            if (_queue.size() == 1) {
+                _cond.notify_all();
+            }
         }
+        std::lock_guard guard(_mutex);
+        --_running_batches;
+        _cond.notify_all();
     });
     _shared_executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::SETUP));
 }
@@ -253,7 +278,7 @@ TensorAttributeLoader::build_index(vespalib::Executor* executor, uint32_t docid_
 {
     std::unique_ptr<IndexBuilder> builder;
     if (executor != nullptr) {
-        builder = std::make_unique<ThreadedIndexBuilder>(_attr, _generation_handler, _store, *_index, *executor);
+        builder = std::make_unique<ThreadedIndexBuilder>(_attr, _generation_handler, *_index, *executor, build_threads(_attr.getConfig()));
     } else {
         builder = std::make_unique<ForegroundIndexBuilder>(_attr, *_index);
     }
@@ -270,9 +295,12 @@ TensorAttributeLoader::build_index(vespalib::Executor* executor, uint32_t docid_
 bool
 TensorAttributeLoader::load_index()
 {
-    FileWithHeader index_file(LoadUtils::openFile(_attr, TensorAttributeSaver::index_file_suffix()));
+    // The index file is mmapped and read sequentially. The link arrays are copied
+    // from the mapping into the graph, and consumed pages are released to keep
+    // the peak resident memory during load low.
+    auto index_buffer = LoadUtils::loadFile(_attr, TensorAttributeSaver::index_file_suffix());
     try {
-        auto index_loader = _index->make_loader(index_file.file());
+        auto index_loader = _index->make_loader(*index_buffer);
         size_t cnt = 0;
         while (index_loader->load_next()) {
             if ((++cnt % LOAD_COMMIT_INTERVAL) == 0) {
@@ -173,6 +173,8 @@ FakeZcFilterOcc::setupT(const FakeWord &fw)
     params.set("minChunkDocs", _posting_params._min_chunk_docs); // Control chunking
     params.set("minSkipDocs", _posting_params._min_skip_docs);   // Control skip info
     params.set("interleaved_features", _posting_params._encode_interleaved_features);
+    params.set("block_max", _posting_params._encode_block_max);
+    params.set("packed_doc_ids", _posting_params._encode_packed_doc_ids);
     writer.set_posting_list_params(params);
     auto &writeContext = writer.get_write_context();
     search::ComprBuffer &cb = writeContext;
@@ -799,6 +801,51 @@ public:
 template <bool bigEndian>
 FakeZc4SkipPosOccCf<bigEndian>::~FakeZc4SkipPosOccCf() = default;
 
+template <bool bigEndian>
+class FakeZc4SkipPosOccCfBlockMax : public FakeZc4SkipPosOcc<bigEndian>
+{
+public:
+    FakeZc4SkipPosOccCfBlockMax(const FakeWord &fw)
+        : FakeZc4SkipPosOcc<bigEndian>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, false, true, true, true),
+                                       (bigEndian ? ".zc4skipposoccbe.cf.bm" : ".zc4skipposoccle.cf.bm"))
+    {
+    }
+    ~FakeZc4SkipPosOccCfBlockMax() override;
+};
+
+template <bool bigEndian>
+FakeZc4SkipPosOccCfBlockMax<bigEndian>::~FakeZc4SkipPosOccCfBlockMax() = default;
+
+template <bool bigEndian>
+class FakeZc4SkipPosOccPacked : public FakeZc4SkipPosOcc<bigEndian>
+{
+public:
+    FakeZc4SkipPosOccPacked(const FakeWord &fw)
+        : FakeZc4SkipPosOcc<bigEndian>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, false, true, false, false, true),
+                                       (bigEndian ? ".zc4skipposoccbe.pd" : ".zc4skipposoccle.pd"))
+    {
+    }
+    ~FakeZc4SkipPosOccPacked() override;
+};
+
+template <bool bigEndian>
+FakeZc4SkipPosOccPacked<bigEndian>::~FakeZc4SkipPosOccPacked() = default;
+
+template <bool bigEndian>
+class FakeZc4SkipPosOccCfBlockMaxPacked : public FakeZc4SkipPosOcc<bigEndian>
+{
+public:
+    FakeZc4SkipPosOccCfBlockMaxPacked(const FakeWord &fw)
+        : FakeZc4SkipPosOcc<bigEndian>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, false, true, true, true, true),
+                                       (bigEndian ? ".zc4skipposoccbe.cf.bm.pd" : ".zc4skipposoccle.cf.bm.pd"))
+    {
+    }
+    ~FakeZc4SkipPosOccCfBlockMaxPacked() override;
+};
+
+template <bool bigEndian>
+FakeZc4SkipPosOccCfBlockMaxPacked<bigEndian>::~FakeZc4SkipPosOccCfBlockMaxPacked() = default;
+
 class FakeZc4SkipPosOccCfNoNormalUnpack : public FakeZc4SkipPosOcc<true>
 {
 public:
@@ -933,6 +980,34 @@ static FPFactoryInit
 initSkipPos0lecf(std::make_pair("Zc4SkipPosOccLE.cf",
                                 makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCf<false> > >));
 
+static FPFactoryInit
+initSkipPos0becfbm(std::make_pair("Zc4SkipPosOccBE.cf.bm",
+                                  makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfBlockMax<true> > >));
+
+
+static FPFactoryInit
+initSkipPos0lecfbm(std::make_pair("Zc4SkipPosOccLE.cf.bm",
+                                  makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfBlockMax<false> > >));
+
+static FPFactoryInit
+initSkipPos0bepd(std::make_pair("Zc4SkipPosOccBE.pd",
+                                makeFPFactory<FPFactoryT<FakeZc4SkipPosOccPacked<true> > >));
+
+
+static FPFactoryInit
+initSkipPos0lepd(std::make_pair("Zc4SkipPosOccLE.pd",
+                                makeFPFactory<FPFactoryT<FakeZc4SkipPosOccPacked<false> > >));
+
+
+static FPFactoryInit
+initSkipPos0becfbmpd(std::make_pair("Zc4SkipPosOccBE.cf.bm.pd",
+                                    makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfBlockMaxPacked<true> > >));
+
+
+static FPFactoryInit
+initSkipPos0lecfbmpd(std::make_pair("Zc4SkipPosOccLE.cf.bm.pd",
+                                    makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfBlockMaxPacked<false> > >));
+
 static FPFactoryInit
 initSkipPos0becfnnu(std::make_pair("Zc4SkipPosOccBE.cf.nnu",
                                 makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfNoNormalUnpack > >));
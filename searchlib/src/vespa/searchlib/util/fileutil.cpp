@@ -8,6 +8,7 @@
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 #include <stdexcept>
 
 #include <vespa/log/log.h>
@@ -124,4 +125,38 @@ FileReaderBase::read(void *buf, size_t sz) {
     return numRead;
 }
 
+ReleasingBufferReaderBase::ReleasingBufferReaderBase(const fileutil::LoadedBuffer & buffer)
+    : _pos(buffer.c_str()),
+      _end(buffer.c_str() + buffer.size()),
+      _released(buffer.c_str()),
+      _release_pages(buffer.is_private_file_mapping())
+{
+    if (_release_pages && !buffer.empty()) {
+        auto page_size = static_cast<uintptr_t>(getpagesize());
+        auto start = reinterpret_cast<uintptr_t>(_pos) & ~(page_size - 1);
+        madvise(reinterpret_cast<void *>(start), reinterpret_cast<uintptr_t>(_end) - start, MADV_SEQUENTIAL);
+    }
+}
+
+void
+ReleasingBufferReaderBase::handleError(size_t wanted) const
+{
+    throw std::runtime_error(vespalib::make_string("Trying to read %zu bytes past end of loaded buffer (%zu bytes left)",
+                                                   wanted, static_cast<size_t>(_end - _pos)));
+}
+
+void
+ReleasingBufferReaderBase::release_consumed()
+{
+    // Only whole pages before the current read position are released. As the buffer is a private
+    // read only mapping of the file, released pages are read back from the file if touched again.
+    auto page_size = static_cast<uintptr_t>(getpagesize());
+    auto start = (reinterpret_cast<uintptr_t>(_released) + page_size - 1) & ~(page_size - 1);
+    auto end = reinterpret_cast<uintptr_t>(_pos) & ~(page_size - 1);
+    if (start < end) {
+        madvise(reinterpret_cast<void *>(start), end - start, MADV_DONTNEED);
+    }
+    _released = _pos;
+}
+
 }
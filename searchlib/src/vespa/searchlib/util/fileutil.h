@@ -3,8 +3,12 @@
 
 #include <vector>
 #include <memory>
+#include <cstring>
+#include <cstdint>
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/util/array.h>
+#include <vespa/vespalib/util/arrayref.h>
+#include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/stllike/string.h>
 
 using vespalib::GenericHeader;
@@ -35,6 +39,11 @@ public:
     bool  empty() const { return _size == 0; }
     size_t size(size_t elemSize) const { return  _size/elemSize; }
     const GenericHeader &getHeader() const { return *_header; }
+    /**
+     * Returns true if the buffer is a private read only mapping of a file, where
+     * pages dropped with MADV_DONTNEED are read back from the file when touched again.
+     */
+    virtual bool is_private_file_mapping() const noexcept { return false; }
 };
 
 class LoadedMmap : public LoadedBuffer
@@ -44,6 +53,7 @@ class LoadedMmap : public LoadedBuffer
 public:
     explicit LoadedMmap(const vespalib::string &fileName);
     ~LoadedMmap() override;
+    bool is_private_file_mapping() const noexcept override { return _mapBuffer != nullptr; }
 };
 
 }
@@ -91,6 +101,68 @@ public:
     }
 };
 
+/**
+ * Reads sequentially from a loaded (mmapped) buffer, releasing consumed pages as it goes.
+ * When the buffer is a private file mapping, pages that have been consumed are
+ * periodically released, so loading a large file does not keep the whole file resident
+ * in addition to the data structure it is loaded into. The caller still copies what it
+ * reads into its own memory; this reader only lowers the peak resident memory during load.
+ * Pages are only released up to the start of the current read, so the bytes
+ * returned by the previous read are valid until the next one.
+ */
+class ReleasingBufferReaderBase
+{
+public:
+    explicit ReleasingBufferReaderBase(const fileutil::LoadedBuffer & buffer);
+    const char * consume(size_t sz) {
+        if (sz > static_cast<size_t>(_end - _pos)) {
+            handleError(sz);
+        }
+        if (_release_pages && static_cast<size_t>(_pos - _released) >= RELEASE_CHUNK_SIZE) {
+            release_consumed();
+        }
+        const char * result = _pos;
+        _pos += sz;
+        return result;
+    }
+private:
+    static constexpr size_t RELEASE_CHUNK_SIZE = 64_Mi;
+    [[noreturn]] void handleError(size_t wanted) const;
+    void release_consumed();
+    const char * _pos;
+    const char * _end;
+    const char * _released;
+    bool         _release_pages;
+};
+
+template <typename T>
+class ReleasingBufferReader : public ReleasingBufferReaderBase
+{
+public:
+    explicit ReleasingBufferReader(const fileutil::LoadedBuffer & buffer) : ReleasingBufferReaderBase(buffer) { }
+    T readHostOrder() {
+        T result;
+        memcpy(&result, consume(sizeof(T)), sizeof(T));
+        return result;
+    }
+    /**
+     * Returns a reference to the next count elements in the buffer.
+     * The elements are referenced directly in the buffer when suitably aligned, otherwise
+     * they are copied to an internal array. The reference is only valid until the next read.
+     */
+    vespalib::ConstArrayRef<T> read_array(size_t count) {
+        const char * src = consume(count * sizeof(T));
+        if ((reinterpret_cast<uintptr_t>(src) % alignof(T)) == 0) {
+            return {reinterpret_cast<const T *>(src), count};
+        }
+        _unaligned.resize(count);
+        memcpy(_unaligned.data(), src, count * sizeof(T));
+        return {_unaligned.data(), count};
+    }
+private:
+    std::vector<T> _unaligned;
+};
+
 template <typename T>
 class SequentialReadModifyWriteInterface
 {
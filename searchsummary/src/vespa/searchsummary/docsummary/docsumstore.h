@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace search::docsummary {
 
@@ -22,6 +24,13 @@ public:
      * Get a docsum specific abstract of the document for the given local document id.
      **/
     virtual std::unique_ptr<const IDocsumStoreDocument> get_document(uint32_t docid) = 0;
+
+    /**
+     * Hint that the documents with the given local document ids will be requested next.
+     * A store that can read several documents more efficiently than one at a time
+     * may fetch them all now, and serve the following get_document() calls from memory.
+     **/
+    virtual void prefetch(const std::vector<uint32_t> & docids) { (void) docids; }
 };
 
 }
@@ -0,0 +1,111 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/storage/persistence/bucket_hash_tree.h>
+#include <vespa/document/base/documentid.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+
+namespace storage {
+
+using LeafVector = std::vector<uint32_t>;
+
+namespace {
+
+document::GlobalId
+gid_of(uint64_t n)
+{
+    return document::DocumentId("id:ns:testdoctype1::" + std::to_string(n)).getGlobalId();
+}
+
+}
+
+TEST(BucketHashTreeTest, leaf_count_depends_on_number_of_entries)
+{
+    EXPECT_EQ(1u, BucketHashTree::leaf_count_for(0));
+    EXPECT_EQ(1u, BucketHashTree::leaf_count_for(63));
+    EXPECT_EQ(2u, BucketHashTree::leaf_count_for(64));
+    EXPECT_EQ(4u, BucketHashTree::leaf_count_for(96));
+    EXPECT_EQ(1024u, BucketHashTree::leaf_count_for(32768));
+    EXPECT_EQ(BucketHashTree::max_leaf_count, BucketHashTree::leaf_count_for(1000000000));
+    EXPECT_TRUE(BucketHashTree::valid_leaf_count(1));
+    EXPECT_TRUE(BucketHashTree::valid_leaf_count(64));
+    EXPECT_FALSE(BucketHashTree::valid_leaf_count(0));
+    EXPECT_FALSE(BucketHashTree::valid_leaf_count(48));
+    EXPECT_FALSE(BucketHashTree::valid_leaf_count(2 * BucketHashTree::max_leaf_count));
+}
+
+TEST(BucketHashTreeTest, hash_is_independent_of_insertion_order)
+{
+    BucketHashTree a(16);
+    BucketHashTree b(16);
+    for (uint64_t ts = 1000; ts < 2000; ++ts) {
+        a.add(ts, gid_of(ts), (ts % 7) == 0);
+        b.add(2999 - ts, gid_of(2999 - ts), ((2999 - ts) % 7) == 0);
+    }
+    EXPECT_NE(0u, a.root_hash());
+    EXPECT_EQ(a.root_hash(), b.root_hash());
+    EXPECT_EQ(a.leaf_hashes(), b.leaf_hashes());
+    EXPECT_TRUE(a.find_differing_leaves(b).empty());
+}
+
+TEST(BucketHashTreeTest, removing_entries_restores_hash)
+{
+    BucketHashTree tree(8);
+    tree.add(10, gid_of(10), false);
+    uint64_t hash = tree.root_hash();
+    tree.add(11, gid_of(11), true);
+    EXPECT_NE(hash, tree.root_hash());
+    tree.remove(11, gid_of(11), true);
+    EXPECT_EQ(hash, tree.root_hash());
+    tree.remove(10, gid_of(10), false);
+    EXPECT_EQ(0u, tree.root_hash());
+}
+
+TEST(BucketHashTreeTest, gid_is_part_of_entry_hash)
+{
+    EXPECT_EQ(BucketHashTree::entry_hash(10, gid_of(1), false), BucketHashTree::entry_hash(10, gid_of(1), false));
+    EXPECT_NE(BucketHashTree::entry_hash(10, gid_of(1), false), BucketHashTree::entry_hash(10, gid_of(2), false));
+    EXPECT_NE(BucketHashTree::entry_hash(10, gid_of(1), false), BucketHashTree::entry_hash(10, gid_of(1), true));
+    EXPECT_NE(BucketHashTree::entry_hash(10, gid_of(1), false), BucketHashTree::entry_hash(11, gid_of(1), false));
+}
+
+TEST(BucketHashTreeTest, tree_can_be_rebuilt_from_leaf_hashes)
+{
+    BucketHashTree tree(32);
+    for (uint64_t ts = 1; ts <= 500; ++ts) {
+        tree.add(ts * 1000, gid_of(ts), false);
+    }
+    BucketHashTree copy(tree.leaf_hashes());
+    EXPECT_EQ(32u, copy.leaf_count());
+    EXPECT_EQ(tree.root_hash(), copy.root_hash());
+}
+
+TEST(BucketHashTreeTest, differing_leaves_are_found)
+{
+    BucketHashTree a(64);
+    BucketHashTree b(64);
+    for (uint64_t ts = 1; ts <= 1000; ++ts) {
+        a.add(ts, gid_of(ts), false);
+        b.add(ts, gid_of(ts), false);
+    }
+    // Missing entry, and put vs remove at the same timestamp
+    a.add(5000, gid_of(5000), false);
+    a.remove(17, gid_of(17), false);
+    a.add(17, gid_of(17), true);
+    LeafVector expected{BucketHashTree::leaf_of(5000, 64), BucketHashTree::leaf_of(17, 64)};
+    std::sort(expected.begin(), expected.end());
+    expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+    EXPECT_EQ(expected, a.find_differing_leaves(b));
+    EXPECT_EQ(expected, b.find_differing_leaves(a));
+}
+
+TEST(BucketHashTreeTest, single_leaf_tree_holds_all_entries)
+{
+    BucketHashTree a(1);
+    BucketHashTree b(1);
+    a.add(42, gid_of(42), false);
+    EXPECT_EQ(0u, BucketHashTree::leaf_of(42, 1));
+    EXPECT_EQ(LeafVector{0}, a.find_differing_leaves(b));
+}
+
+}
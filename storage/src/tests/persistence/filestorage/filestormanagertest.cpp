@@ -3,6 +3,7 @@
 #include <tests/common/dummystoragelink.h>
 #include <tests/common/testhelper.h>
 #include <tests/common/teststorageapp.h>
+#include <tests/persistence/common/persistenceproviderwrapper.h>
 #include <tests/persistence/filestorage/forwardingmessagesender.h>
 #include <vespa/config/common/exceptions.h>
 #include <vespa/document/fieldset/fieldsets.h>
@@ -292,7 +293,11 @@ struct PersistenceHandlerComponents : public FileStorHandlerComponents {
     BucketOwnershipNotifier bucketOwnershipNotifier;
     std::unique_ptr<PersistenceHandler> persistenceHandler;
 
-    PersistenceHandlerComponents(FileStorTestBase& test)
+    explicit PersistenceHandlerComponents(FileStorTestBase& test)
+        : PersistenceHandlerComponents(test, test._node->getPersistenceProvider())
+    {
+    }
+    PersistenceHandlerComponents(FileStorTestBase& test, spi::PersistenceProvider& provider)
         : FileStorHandlerComponents(test),
           executor(test._node->executor()),
           component(test._node->getComponentRegister(), "test"),
@@ -301,8 +306,7 @@ struct PersistenceHandlerComponents : public FileStorHandlerComponents {
     {
         vespa::config::content::StorFilestorConfig cfg;
         persistenceHandler =
-                std::make_unique<PersistenceHandler>(executor, component, cfg,
-                                                     test._node->getPersistenceProvider(),
+                std::make_unique<PersistenceHandler>(executor, component, cfg, provider,
                                                      *filestorHandler, bucketOwnershipNotifier,
                                                      *metrics.threads[0]);
     }
@@ -1090,6 +1094,87 @@ TEST_F(FileStorManagerTest, split_empty_target_with_remapped_ops) {
     top.reset();
 }
 
+TEST_F(FileStorManagerTest, coalesced_feed_ops_are_applied_and_replied_to) {
+    PersistenceHandlerComponents c(*this);
+    auto& filestorHandler = *c.filestorHandler;
+    auto& top = c.top;
+
+    document::BucketId bid(16, 4000);
+    createBucket(bid);
+    filestorHandler.set_max_feed_op_batch_size(4);
+    // Keep the queue blocked until all operations are scheduled, so they end up in one batch.
+    auto resumeGuard = std::make_unique<ResumeGuard>(filestorHandler.pause());
+    auto thread = c.make_disk_thread();
+    for (uint32_t i = 0; i < 3; ++i) {
+        Document::SP doc(createDocument("some content", vespalib::make_string("id:crawler:testdoctype1:n=4000:doc%u", i)).release());
+        auto cmd = std::make_shared<api::PutCommand>(makeDocumentBucket(bid), doc, 100 + i);
+        cmd->setAddress(_Storage3);
+        filestorHandler.schedule(cmd);
+    }
+    auto removeCmd = std::make_shared<api::RemoveCommand>(makeDocumentBucket(bid),
+                                                          document::DocumentId("id:crawler:testdoctype1:n=4000:doc0"), 200);
+    removeCmd->setAddress(_Storage3);
+    filestorHandler.schedule(removeCmd);
+    resumeGuard.reset(); // Unpause
+
+    top.waitForMessages(4, _waitTime);
+    ASSERT_EQ(4, top.getNumReplies());
+    for (uint32_t i = 0; i < 3; ++i) {
+        auto reply = std::dynamic_pointer_cast<api::PutReply>(top.getReply(i));
+        ASSERT_TRUE(reply.get());
+        EXPECT_EQ(ReturnCode(ReturnCode::OK), reply->getResult());
+    }
+    auto reply = std::dynamic_pointer_cast<api::RemoveReply>(top.getReply(3));
+    ASSERT_TRUE(reply.get());
+    EXPECT_EQ(ReturnCode(ReturnCode::OK), reply->getResult());
+    EXPECT_TRUE(reply->wasFound());
+    EXPECT_EQ(2, reply->getBucketInfo().getDocumentCount());
+    EXPECT_EQ(4, c.metrics.stripes[0]->feed_op_batch_size.getLast());
+    EXPECT_EQ(3, c.metrics.stripes[0]->coalesced_feed_ops.getValue());
+    top.reset();
+}
+
+namespace {
+
+struct FeedBatchThrowingProvider : PersistenceProviderWrapper {
+    using PersistenceProviderWrapper::PersistenceProviderWrapper;
+    void feedBatchAsync(const spi::Bucket&, spi::FeedBatch) override {
+        throw std::runtime_error("feed batch failed");
+    }
+};
+
+}
+
+TEST_F(FileStorManagerTest, coalesced_feed_ops_are_failed_if_feed_batch_throws) {
+    FeedBatchThrowingProvider provider(_node->getPersistenceProvider());
+    PersistenceHandlerComponents c(*this, provider);
+    auto& filestorHandler = *c.filestorHandler;
+    auto& top = c.top;
+
+    document::BucketId bid(16, 4000);
+    createBucket(bid);
+    filestorHandler.set_max_feed_op_batch_size(4);
+    auto resumeGuard = std::make_unique<ResumeGuard>(filestorHandler.pause());
+    auto thread = c.make_disk_thread();
+    for (uint32_t i = 0; i < 3; ++i) {
+        Document::SP doc(createDocument("some content", vespalib::make_string("id:crawler:testdoctype1:n=4000:doc%u", i)).release());
+        auto cmd = std::make_shared<api::PutCommand>(makeDocumentBucket(bid), doc, 100 + i);
+        cmd->setAddress(_Storage3);
+        filestorHandler.schedule(cmd);
+    }
+    resumeGuard.reset(); // Unpause
+
+    top.waitForMessages(3, _waitTime);
+    ASSERT_EQ(3, top.getNumReplies());
+    for (uint32_t i = 0; i < 3; ++i) {
+        auto reply = std::dynamic_pointer_cast<api::PutReply>(top.getReply(i));
+        ASSERT_TRUE(reply.get());
+        EXPECT_EQ(ReturnCode::INTERNAL_FAILURE, reply->getResult().getResult());
+        EXPECT_EQ("feed batch failed", reply->getResult().getMessage());
+    }
+    top.reset();
+}
+
 TEST_F(FileStorManagerTest, notify_on_split_source_ownership_changed) {
     PersistenceHandlerComponents c(*this);
     auto& filestorHandler = *c.filestorHandler;
@@ -2087,4 +2172,101 @@ TEST_F(FileStorHandlerTest, inhibited_operations_are_skipped)
     EXPECT_EQ(30, get_next_message().msg->getPriority());
 }
 
+namespace {
+
+api::Timestamp
+timestamp_of(const std::shared_ptr<api::StorageMessage>& msg) {
+    return dynamic_cast<const api::PutCommand&>(*msg).getTimestamp();
+}
+
+}
+
+TEST_F(FileStorHandlerTest, feed_ops_are_not_coalesced_by_default)
+{
+    handler->schedule(make_put_command(20, "id:foo:testdoctype1::bar", 100));
+    handler->schedule(make_put_command(20, "id:foo:testdoctype1::bar", 101));
+    auto locked_msg = get_next_message();
+    EXPECT_EQ(100, timestamp_of(locked_msg.msg));
+    EXPECT_TRUE(locked_msg.coalesced.empty());
+}
+
+TEST_F(FileStorHandlerTest, feed_ops_for_same_bucket_are_coalesced_up_to_max_batch_size)
+{
+    handler->set_max_feed_op_batch_size(3);
+    for (api::Timestamp ts : {100, 101, 102, 103}) {
+        handler->schedule(make_put_command(20, "id:foo:testdoctype1::bar", ts));
+    }
+    {
+        auto locked_msg = get_next_message();
+        EXPECT_EQ(100, timestamp_of(locked_msg.msg));
+        ASSERT_EQ(2, locked_msg.coalesced.size());
+        EXPECT_EQ(101, timestamp_of(locked_msg.coalesced[0].msg));
+        EXPECT_EQ(102, timestamp_of(locked_msg.coalesced[1].msg));
+    }
+    auto locked_msg = get_next_message();
+    EXPECT_EQ(103, timestamp_of(locked_msg.msg));
+    EXPECT_TRUE(locked_msg.coalesced.empty());
+    EXPECT_EQ(0, handler->getQueueSize());
+}
+
+TEST_F(FileStorHandlerTest, feed_ops_with_lower_priority_are_not_coalesced)
+{
+    handler->set_max_feed_op_batch_size(4);
+    handler->schedule(make_put_command(20, "id:foo:testdoctype1::bar", 100));
+    handler->schedule(make_put_command(30, "id:foo:testdoctype1::bar", 101));
+    handler->schedule(make_put_command(20, "id:foo:testdoctype1::bar", 102));
+    {
+        auto locked_msg = get_next_message();
+        EXPECT_EQ(100, timestamp_of(locked_msg.msg));
+        ASSERT_EQ(1, locked_msg.coalesced.size());
+        EXPECT_EQ(102, timestamp_of(locked_msg.coalesced[0].msg));
+    }
+    EXPECT_EQ(101, timestamp_of(get_next_message().msg));
+}
+
+TEST_F(FileStorHandlerTest, coalescing_stops_at_operation_that_can_not_be_batched)
+{
+    handler->set_max_feed_op_batch_size(4);
+    handler->schedule(make_put_command(20, "id:foo:testdoctype1::bar", 100));
+    handler->schedule(make_get_command(20));
+    handler->schedule(make_put_command(20, "id:foo:testdoctype1::bar", 101));
+    {
+        auto locked_msg = get_next_message();
+        EXPECT_EQ(100, timestamp_of(locked_msg.msg));
+        EXPECT_TRUE(locked_msg.coalesced.empty());
+    }
+    EXPECT_EQ(api::MessageType::GET_ID, get_next_message().msg->getType().getId());
+    EXPECT_EQ(101, timestamp_of(get_next_message().msg));
+}
+
+TEST_F(FileStorHandlerTest, coalescing_stops_at_operation_with_older_timestamp)
+{
+    handler->set_max_feed_op_batch_size(4);
+    handler->schedule(make_put_command(20, "id:foo:testdoctype1::bar", 100));
+    handler->schedule(make_put_command(20, "id:foo:testdoctype1::bar", 101));
+    handler->schedule(make_put_command(20, "id:foo:testdoctype1::bar", 90));
+    {
+        auto locked_msg = get_next_message();
+        EXPECT_EQ(100, timestamp_of(locked_msg.msg));
+        ASSERT_EQ(1, locked_msg.coalesced.size());
+        EXPECT_EQ(101, timestamp_of(locked_msg.coalesced[0].msg));
+    }
+    EXPECT_EQ(90, timestamp_of(get_next_message().msg));
+}
+
+TEST_F(FileStorHandlerTest, test_and_set_feed_ops_are_not_coalesced)
+{
+    handler->set_max_feed_op_batch_size(4);
+    handler->schedule(make_put_command(20, "id:foo:testdoctype1::bar", 100));
+    auto tas_put = make_put_command(20, "id:foo:testdoctype1::bar", 101);
+    tas_put->setCondition(TestAndSetCondition("not testdoctype1"));
+    handler->schedule(tas_put);
+    {
+        auto locked_msg = get_next_message();
+        EXPECT_EQ(100, timestamp_of(locked_msg.msg));
+        EXPECT_TRUE(locked_msg.coalesced.empty());
+    }
+    EXPECT_EQ(101, timestamp_of(get_next_message().msg));
+}
+
 } // storage
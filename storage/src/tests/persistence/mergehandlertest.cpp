@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/document/base/testdocman.h>
+#include <vespa/storage/persistence/bucket_hash_tree.h>
 #include <vespa/storage/persistence/mergehandler.h>
 #include <vespa/storage/persistence/filestorage/mergestatus.h>
 #include <tests/persistence/persistencetestutils.h>
@@ -40,6 +41,8 @@ struct MergeHandlerTest : PersistenceTestUtils {
     void setUpChain(ChainPos);
 
     void testGetBucketDiffChain(bool midChain);
+    void start_hash_tree_summary_merge(MergeHandler& handler,
+                                       std::vector<api::GetBucketDiffCommand::Entry>& local);
     void testApplyBucketDiffChain(bool midChain);
 
     // @TODO Add test to test that buildBucketInfo and mergeLists create minimal list (wrong sorting screws this up)
@@ -299,6 +302,143 @@ TEST_F(MergeHandlerTest, get_bucket_diff_end_of_chain) {
     testGetBucketDiffChain(false);
 }
 
+TEST_F(MergeHandlerTest, get_bucket_diff_with_hash_tree) {
+    setUpChain(BACK);
+    MergeHandler handler = createHandler();
+    std::vector<api::GetBucketDiffCommand::Entry> local;
+    ASSERT_TRUE(handler.buildBucketInfoList(spi::Bucket(_bucket), framework::MicroSecTime(_maxTimestamp),
+                                            1, local, *_context));
+    ASSERT_EQ(17, local.size());
+    constexpr uint32_t leaf_count = 4;
+    // The first node in the chain lacks one of the local entries
+    BucketHashTree first_node_tree(leaf_count);
+    for (size_t i = 1; i < local.size(); ++i) {
+        first_node_tree.add(local[i]._timestamp, local[i]._gid, (local[i]._flags & MergeHandler::DELETED) != 0);
+    }
+    uint32_t differing_leaf = BucketHashTree::leaf_of(local[0]._timestamp, leaf_count);
+
+    auto cmd = std::make_shared<api::GetBucketDiffCommand>(_bucket, _nodes, _maxTimestamp);
+    cmd->getHashTreeLeaves() = first_node_tree.leaf_hashes();
+    cmd->setHashTreeLeafCount(leaf_count);
+    auto reply = std::dynamic_pointer_cast<api::GetBucketDiffReply>(
+            std::move(*handler.handleGetBucketDiff(*cmd, createTracker(cmd, _bucket))).stealReplySP());
+    ASSERT_TRUE(reply);
+    EXPECT_TRUE(reply->getDiff().empty());
+    EXPECT_EQ(std::vector<uint32_t>({differing_leaf}), reply->getDifferingLeaves());
+    EXPECT_TRUE(reply->isHashTreeSummaryHandled());
+
+    // Only entries within the differing leaves are part of the following diff
+    auto cmd2 = std::make_shared<api::GetBucketDiffCommand>(_bucket, _nodes, _maxTimestamp);
+    cmd2->setHashTreeLeafCount(leaf_count);
+    cmd2->getDifferingLeaves() = reply->getDifferingLeaves();
+    auto reply2 = std::dynamic_pointer_cast<api::GetBucketDiffReply>(
+            std::move(*handler.handleGetBucketDiff(*cmd2, createTracker(cmd2, _bucket))).stealReplySP());
+    ASSERT_TRUE(reply2);
+    EXPECT_FALSE(reply2->isHashTreeSummaryHandled());
+    auto in_differing_leaf = [&](const auto& e) {
+        return BucketHashTree::leaf_of(e._timestamp, leaf_count) == differing_leaf;
+    };
+    EXPECT_EQ(size_t(std::count_if(local.begin(), local.end(), in_differing_leaf)), reply2->getDiff().size());
+    EXPECT_TRUE(std::all_of(reply2->getDiff().begin(), reply2->getDiff().end(), in_differing_leaf));
+}
+
+void
+MergeHandlerTest::start_hash_tree_summary_merge(MergeHandler& handler,
+                                                std::vector<api::GetBucketDiffCommand::Entry>& local)
+{
+    constexpr uint64_t max_timestamp = 30000;
+    for (uint32_t i = 0; i < 1100; ++i) {
+        doPut(_location, spi::Timestamp(20000 + i));
+    }
+    ASSERT_TRUE(handler.buildBucketInfoList(spi::Bucket(_bucket), framework::MicroSecTime(max_timestamp),
+                                            0, local, *_context));
+    handler.set_use_hash_tree_summary(true);
+    auto cmd = std::make_shared<api::MergeBucketCommand>(_bucket, _nodes, max_timestamp);
+    handler.handleMergeBucket(*cmd, createTracker(cmd, _bucket));
+    ASSERT_EQ(1, messageKeeper()._msgs.size());
+    auto& summary = dynamic_cast<api::GetBucketDiffCommand&>(*messageKeeper()._msgs[0]);
+    EXPECT_TRUE(summary.isHashTreeSummary());
+    EXPECT_EQ(BucketHashTree::leaf_count_for(local.size()), summary.getHashTreeLeafCount());
+    EXPECT_TRUE(summary.getDiff().empty());
+}
+
+TEST_F(MergeHandlerTest, hash_tree_summary_is_followed_by_diff_of_differing_leaves) {
+    MergeHandler handler = createHandler();
+    std::vector<api::GetBucketDiffCommand::Entry> local;
+    ASSERT_NO_FATAL_FAILURE(start_hash_tree_summary_merge(handler, local));
+    auto& summary = dynamic_cast<api::GetBucketDiffCommand&>(*messageKeeper()._msgs[0]);
+    uint32_t leaf_count = summary.getHashTreeLeafCount();
+
+    auto reply = std::make_unique<api::GetBucketDiffReply>(summary);
+    reply->getDifferingLeaves() = {0, 3};
+    reply->setHashTreeSummaryHandled(true);
+    handler.handleGetBucketDiffReply(*reply, messageKeeper());
+
+    ASSERT_EQ(2, messageKeeper()._msgs.size());
+    auto& cmd = dynamic_cast<api::GetBucketDiffCommand&>(*messageKeeper()._msgs[1]);
+    EXPECT_FALSE(cmd.isHashTreeSummary());
+    EXPECT_EQ(leaf_count, cmd.getHashTreeLeafCount());
+    EXPECT_EQ(std::vector<uint32_t>({0, 3}), cmd.getDifferingLeaves());
+    auto in_differing_leaf = [&](const auto& e) {
+        uint32_t leaf = BucketHashTree::leaf_of(e._timestamp, leaf_count);
+        return (leaf == 0) || (leaf == 3);
+    };
+    EXPECT_EQ(size_t(std::count_if(local.begin(), local.end(), in_differing_leaf)), cmd.getDiff().size());
+    EXPECT_TRUE(std::all_of(cmd.getDiff().begin(), cmd.getDiff().end(), in_differing_leaf));
+}
+
+TEST_F(MergeHandlerTest, hash_tree_summary_falls_back_to_full_diff_when_ignored_by_next_node) {
+    MergeHandler handler = createHandler();
+    std::vector<api::GetBucketDiffCommand::Entry> local;
+    ASSERT_NO_FATAL_FAILURE(start_hash_tree_summary_merge(handler, local));
+    auto& summary = dynamic_cast<api::GetBucketDiffCommand&>(*messageKeeper()._msgs[0]);
+
+    // A node not knowing about hash trees treats the summary as a regular
+    // GetBucketDiff, and replies with its own entries and no differing leaves.
+    auto reply = std::make_unique<api::GetBucketDiffReply>(summary);
+    reply->getDiff().push_back(local[0]);
+    reply->getDiff().back()._hasMask = 0x2;
+    handler.handleGetBucketDiffReply(*reply, messageKeeper());
+
+    ASSERT_EQ(2, messageKeeper()._msgs.size());
+    auto& cmd = dynamic_cast<api::GetBucketDiffCommand&>(*messageKeeper()._msgs[1]);
+    EXPECT_FALSE(cmd.isHashTreeSummary());
+    EXPECT_EQ(0u, cmd.getHashTreeLeafCount());
+    EXPECT_EQ(local.size(), cmd.getDiff().size());
+}
+
+TEST_F(MergeHandlerTest, hash_tree_summary_falls_back_to_full_diff_when_ignored_by_node_without_entries) {
+    MergeHandler handler = createHandler();
+    std::vector<api::GetBucketDiffCommand::Entry> local;
+    ASSERT_NO_FATAL_FAILURE(start_hash_tree_summary_merge(handler, local));
+    auto& summary = dynamic_cast<api::GetBucketDiffCommand&>(*messageKeeper()._msgs[0]);
+
+    // An empty diff and no differing leaves does not mean equal copies
+    // unless all nodes handled the summary.
+    auto reply = std::make_unique<api::GetBucketDiffReply>(summary);
+    handler.handleGetBucketDiffReply(*reply, messageKeeper());
+
+    ASSERT_EQ(2, messageKeeper()._msgs.size());
+    auto& cmd = dynamic_cast<api::GetBucketDiffCommand&>(*messageKeeper()._msgs[1]);
+    EXPECT_FALSE(cmd.isHashTreeSummary());
+    EXPECT_EQ(0u, cmd.getHashTreeLeafCount());
+    EXPECT_EQ(local.size(), cmd.getDiff().size());
+}
+
+TEST_F(MergeHandlerTest, hash_tree_summary_without_differing_leaves_completes_merge) {
+    MergeHandler handler = createHandler();
+    std::vector<api::GetBucketDiffCommand::Entry> local;
+    ASSERT_NO_FATAL_FAILURE(start_hash_tree_summary_merge(handler, local));
+    auto& summary = dynamic_cast<api::GetBucketDiffCommand&>(*messageKeeper()._msgs[0]);
+
+    auto reply = std::make_unique<api::GetBucketDiffReply>(summary);
+    reply->setHashTreeSummaryHandled(true);
+    handler.handleGetBucketDiffReply(*reply, messageKeeper());
+
+    ASSERT_EQ(2, messageKeeper()._msgs.size());
+    EXPECT_EQ(api::MessageType::MERGEBUCKET_REPLY, messageKeeper()._msgs[1]->getType());
+}
+
 // Test that a simplistic merge with 1 doc to actually merge,
 // sends apply bucket diff through the entire chain of 3 nodes.
 void
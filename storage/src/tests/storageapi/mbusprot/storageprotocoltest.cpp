@@ -663,6 +663,33 @@ TEST_P(StorageProtocolTest, get_bucket_diff) {
     EXPECT_EQ(nodes, reply2->getNodes());
     EXPECT_EQ(entries, reply2->getDiff());
     EXPECT_EQ(Timestamp(1056), reply2->getMaxTimestamp());
+    EXPECT_TRUE(reply2->getDifferingLeaves().empty());
+    EXPECT_FALSE(reply2->isHashTreeSummaryHandled());
+}
+
+TEST_P(StorageProtocolTest, get_bucket_diff_with_hash_tree) {
+    std::vector<api::MergeBucketCommand::Node> nodes;
+    nodes.push_back(4);
+    nodes.push_back(13);
+    std::vector<uint64_t> leaves{0x1234567890abcdefULL, 0, 42, 0xffffffffffffffffULL};
+    std::vector<uint32_t> differing{1, 3};
+
+    auto cmd = std::make_shared<GetBucketDiffCommand>(_bucket, nodes, 1056);
+    cmd->getHashTreeLeaves() = leaves;
+    cmd->setHashTreeLeafCount(4);
+    cmd->getDifferingLeaves() = differing;
+    auto cmd2 = copyCommand(cmd);
+    EXPECT_TRUE(cmd2->isHashTreeSummary());
+    EXPECT_EQ(leaves, cmd2->getHashTreeLeaves());
+    EXPECT_EQ(4u, cmd2->getHashTreeLeafCount());
+    EXPECT_EQ(differing, cmd2->getDifferingLeaves());
+
+    auto reply = std::make_shared<GetBucketDiffReply>(*cmd2);
+    reply->getDifferingLeaves() = differing;
+    reply->setHashTreeSummaryHandled(true);
+    auto reply2 = copyReply(reply);
+    EXPECT_EQ(differing, reply2->getDifferingLeaves());
+    EXPECT_TRUE(reply2->isHashTreeSummaryHandled());
 }
 
 namespace {
@@ -8,6 +8,7 @@
 #include <vespa/persistence/spi/persistenceprovider.h>
 #include <vespa/persistence/spi/docentry.h>
 #include <vespa/persistence/spi/catchresult.h>
+#include <vespa/persistence/spi/feed_batch.h>
 #include <vespa/storageapi/message/bucket.h>
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/document/fieldset/fieldsets.h>
@@ -167,14 +168,20 @@ AsyncHandler::handlePut(api::PutCommand& cmd, MessageTracker::UP trackerUP) cons
     }
 
     spi::Bucket bucket = _env.getBucket(cmd.getDocumentId(), cmd.getBucket());
+    auto onDone = makePutDone(cmd, std::move(trackerUP));
+    _spi.putAsync(bucket, spi::Timestamp(cmd.getTimestamp()), std::move(cmd.getDocument()), std::move(onDone));
+
+    return trackerUP;
+}
+
+std::unique_ptr<spi::OperationComplete>
+AsyncHandler::makePutDone(api::PutCommand& cmd, MessageTracker::UP trackerUP) const
+{
     auto task = makeResultTask([tracker = std::move(trackerUP)](spi::Result::UP response) {
         tracker->checkForError(*response);
         tracker->sendReply();
     });
-    _spi.putAsync(bucket, spi::Timestamp(cmd.getTimestamp()), std::move(cmd.getDocument()),
-                  std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task)));
-
-    return trackerUP;
+    return std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task));
 }
 
 MessageTracker::UP
@@ -289,7 +296,14 @@ AsyncHandler::handleUpdate(api::UpdateCommand& cmd, MessageTracker::UP trackerUP
     }
 
     spi::Bucket bucket = _env.getBucket(cmd.getDocumentId(), cmd.getBucket());
+    auto onDone = makeUpdateDone(cmd, std::move(trackerUP));
+    _spi.updateAsync(bucket, spi::Timestamp(cmd.getTimestamp()), std::move(cmd.getUpdate()), std::move(onDone));
+    return trackerUP;
+}
 
+std::unique_ptr<spi::OperationComplete>
+AsyncHandler::makeUpdateDone(api::UpdateCommand& cmd, MessageTracker::UP trackerUP) const
+{
     // Note that the &cmd capture is OK since its lifetime is guaranteed by the tracker
     auto task = makeResultTask([&cmd, tracker = std::move(trackerUP)](spi::Result::UP responseUP) {
         auto & response = dynamic_cast<const spi::UpdateResult &>(*responseUP);
@@ -300,9 +314,7 @@ AsyncHandler::handleUpdate(api::UpdateCommand& cmd, MessageTracker::UP trackerUP
         }
         tracker->sendReply();
     });
-    _spi.updateAsync(bucket, spi::Timestamp(cmd.getTimestamp()), std::move(cmd.getUpdate()),
-                     std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task)));
-    return trackerUP;
+    return std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task));
 }
 
 MessageTracker::UP
@@ -319,7 +331,15 @@ AsyncHandler::handleRemove(api::RemoveCommand& cmd, MessageTracker::UP trackerUP
     }
 
     spi::Bucket bucket = _env.getBucket(cmd.getDocumentId(), cmd.getBucket());
+    auto onDone = makeRemoveDone(cmd, std::move(trackerUP));
+    _spi.removeIfFoundAsync(bucket, spi::Timestamp(cmd.getTimestamp()), cmd.getDocumentId(), std::move(onDone));
+    return trackerUP;
+}
 
+std::unique_ptr<spi::OperationComplete>
+AsyncHandler::makeRemoveDone(api::RemoveCommand& cmd, MessageTracker::UP trackerUP) const
+{
+    auto& metrics = _env._metrics.remove;
     // Note that the &cmd capture is OK since its lifetime is guaranteed by the tracker
     auto task = makeResultTask([&metrics, &cmd, tracker = std::move(trackerUP)](spi::Result::UP responseUP) {
         auto & response = dynamic_cast<const spi::RemoveResult &>(*responseUP);
@@ -331,9 +351,63 @@ AsyncHandler::handleRemove(api::RemoveCommand& cmd, MessageTracker::UP trackerUP
         }
         tracker->sendReply();
     });
-    _spi.removeIfFoundAsync(bucket, spi::Timestamp(cmd.getTimestamp()), cmd.getDocumentId(),
-                            std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task)));
-    return trackerUP;
+    return std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task));
+}
+
+std::vector<MessageTracker::UP>
+AsyncHandler::handleFeedBatch(FeedBatchOps ops) const
+{
+    std::vector<MessageTracker::UP> failed;
+    if (ops.empty()) {
+        return failed;
+    }
+    spi::Bucket bucket(ops.front().first->getBucket());
+    spi::FeedBatch batch;
+    for (auto& [msg, trackerUP] : ops) {
+        auto& cmd = static_cast<api::TestAndSetCommand&>(*msg);
+        assert(!tasConditionExists(cmd));
+        try {
+            _env.getBucket(cmd.getDocumentId(), cmd.getBucket());
+        } catch (const std::exception& e) {
+            trackerUP->fail(api::ReturnCode::INTERNAL_FAILURE, e.what());
+            failed.push_back(std::move(trackerUP));
+            continue;
+        }
+        switch (cmd.getType().getId()) {
+        case api::MessageType::PUT_ID: {
+            auto& put = static_cast<api::PutCommand&>(cmd);
+            trackerUP->setMetric(_env._metrics.put);
+            _env._metrics.put.request_size.addValue(put.getApproxByteSize());
+            auto onDone = makePutDone(put, std::move(trackerUP));
+            batch.add_put(spi::Timestamp(put.getTimestamp()), std::move(put.getDocument()), std::move(onDone));
+            break;
+        }
+        case api::MessageType::REMOVE_ID: {
+            auto& remove = static_cast<api::RemoveCommand&>(cmd);
+            trackerUP->setMetric(_env._metrics.remove);
+            _env._metrics.remove.request_size.addValue(remove.getApproxByteSize());
+            auto onDone = makeRemoveDone(remove, std::move(trackerUP));
+            batch.add_remove(spi::Timestamp(remove.getTimestamp()), remove.getDocumentId(), std::move(onDone));
+            break;
+        }
+        case api::MessageType::UPDATE_ID: {
+            auto& update = static_cast<api::UpdateCommand&>(cmd);
+            trackerUP->setMetric(_env._metrics.update);
+            _env._metrics.update.request_size.addValue(update.getApproxByteSize());
+            auto onDone = makeUpdateDone(update, std::move(trackerUP));
+            batch.add_update(spi::Timestamp(update.getTimestamp()), std::move(update.getUpdate()), std::move(onDone));
+            break;
+        }
+        default:
+            trackerUP->fail(api::ReturnCode::INTERNAL_FAILURE, "Not a feed operation: " + cmd.getType().getName());
+            failed.push_back(std::move(trackerUP));
+            break;
+        }
+    }
+    if (!batch.empty()) {
+        _spi.feedBatchAsync(bucket, std::move(batch));
+    }
+    return failed;
 }
 
 bool
@@ -12,6 +12,7 @@ namespace storage {
 namespace spi {
     struct PersistenceProvider;
     class Context;
+    class OperationComplete;
 }
 class PersistenceUtil;
 class BucketOwnershipNotifier;
@@ -24,6 +25,7 @@ class MessageTracker;
 class AsyncHandler {
     using MessageTrackerUP = std::unique_ptr<MessageTracker>;
 public:
+    using FeedBatchOps = std::vector<std::pair<api::StorageCommand*, MessageTrackerUP>>;
     AsyncHandler(const PersistenceUtil&, spi::PersistenceProvider&, BucketOwnershipNotifier  &,
                  vespalib::ISequencedTaskExecutor & executor, const document::BucketIdFactory & bucketIdFactory);
     MessageTrackerUP handlePut(api::PutCommand& cmd, MessageTrackerUP tracker) const;
@@ -34,9 +36,18 @@ public:
     MessageTrackerUP handleDeleteBucket(api::DeleteBucketCommand& cmd, MessageTrackerUP tracker) const;
     MessageTrackerUP handleCreateBucket(api::CreateBucketCommand& cmd, MessageTrackerUP tracker) const;
     MessageTrackerUP handleRemoveLocation(api::RemoveLocationCommand& cmd, MessageTrackerUP tracker) const;
+    /**
+     * Dispatches puts, removes and updates without test-and-set conditions for the same
+     * bucket to the provider as one feed batch, in the given order. Returns the trackers
+     * of operations that failed before being dispatched; the caller must reply to these.
+     */
+    std::vector<MessageTrackerUP> handleFeedBatch(FeedBatchOps ops) const;
     static bool is_async_message(api::MessageType::Id type_id) noexcept;
 private:
     bool checkProviderBucketInfoMatches(const spi::Bucket&, const api::BucketInfo&) const;
+    std::unique_ptr<spi::OperationComplete> makePutDone(api::PutCommand& cmd, MessageTrackerUP tracker) const;
+    std::unique_ptr<spi::OperationComplete> makeRemoveDone(api::RemoveCommand& cmd, MessageTrackerUP tracker) const;
+    std::unique_ptr<spi::OperationComplete> makeUpdateDone(api::UpdateCommand& cmd, MessageTrackerUP tracker) const;
     static bool tasConditionExists(const api::TestAndSetCommand & cmd);
     bool tasConditionMatches(const api::TestAndSetCommand & cmd, MessageTracker & tracker,
                              spi::Context & context, bool missingDocumentImpliesMatch = false) const;
@@ -0,0 +1,132 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bucket_hash_tree.h"
+#include <vespa/vespalib/util/exceptions.h>
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace storage {
+
+namespace {
+
+// Finalizer from MurmurHash3, spreads all input bits over the output
+uint64_t
+mix(uint64_t h) noexcept
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Reads the given bytes as a big endian number, so the hash is the same on all nodes
+uint64_t
+load_bytes(const unsigned char* bytes, size_t count) noexcept
+{
+    uint64_t result = 0;
+    for (size_t i = 0; i < count; ++i) {
+        result = (result << 8) | bytes[i];
+    }
+    return result;
+}
+
+}
+
+BucketHashTree::BucketHashTree(uint32_t leaf_count)
+    : _depth(0),
+      _nodes()
+{
+    if (!valid_leaf_count(leaf_count)) {
+        throw vespalib::IllegalArgumentException("Invalid bucket hash tree leaf count", VESPA_STRLOC);
+    }
+    _depth = std::countr_zero(leaf_count);
+    _nodes.resize(2 * leaf_count - 1);
+}
+
+BucketHashTree::BucketHashTree(const std::vector<uint64_t>& leaf_hashes)
+    : BucketHashTree(uint32_t(leaf_hashes.size()))
+{
+    std::copy(leaf_hashes.begin(), leaf_hashes.end(), _nodes.begin() + first_leaf());
+    for (uint32_t node = first_leaf(); node > 0; --node) {
+        _nodes[node - 1] = _nodes[2 * node - 1] + _nodes[2 * node];
+    }
+}
+
+BucketHashTree::~BucketHashTree() = default;
+
+uint32_t
+BucketHashTree::leaf_count_for(size_t num_entries) noexcept
+{
+    size_t wanted = num_entries / entries_per_leaf;
+    if (wanted >= max_leaf_count) {
+        return max_leaf_count;
+    }
+    return std::bit_ceil(std::max(uint32_t(wanted), 1u));
+}
+
+bool
+BucketHashTree::valid_leaf_count(uint32_t leaf_count) noexcept
+{
+    return (leaf_count != 0) && (leaf_count <= max_leaf_count) && std::has_single_bit(leaf_count);
+}
+
+uint32_t
+BucketHashTree::leaf_of(uint64_t timestamp, uint32_t leaf_count) noexcept
+{
+    uint32_t depth = std::countr_zero(leaf_count);
+    return (depth == 0) ? 0 : (mix(timestamp) >> (64 - depth));
+}
+
+uint64_t
+BucketHashTree::entry_hash(uint64_t timestamp, const document::GlobalId& gid, bool is_remove) noexcept
+{
+    static_assert(document::GlobalId::LENGTH == 12);
+    uint64_t h = mix((timestamp * 0x9e3779b97f4a7c15ULL) ^ (is_remove ? 0x5bd1e9955bd1e995ULL : 0));
+    h = mix(h ^ load_bytes(gid.get(), 8));
+    return mix(h ^ load_bytes(gid.get() + 8, 4));
+}
+
+void
+BucketHashTree::update(uint64_t timestamp, uint64_t delta)
+{
+    uint32_t node = first_leaf() + leaf_of(timestamp, leaf_count());
+    _nodes[node] += delta;
+    while (node > 0) {
+        node = (node - 1) / 2;
+        _nodes[node] += delta;
+    }
+}
+
+std::vector<uint64_t>
+BucketHashTree::leaf_hashes() const
+{
+    return {_nodes.begin() + first_leaf(), _nodes.end()};
+}
+
+void
+BucketHashTree::find_differing_leaves(const BucketHashTree& other, uint32_t node, std::vector<uint32_t>& result) const
+{
+    if (_nodes[node] == other._nodes[node]) {
+        return;
+    }
+    if (node >= first_leaf()) {
+        result.push_back(node - first_leaf());
+    } else {
+        find_differing_leaves(other, 2 * node + 1, result);
+        find_differing_leaves(other, 2 * node + 2, result);
+    }
+}
+
+std::vector<uint32_t>
+BucketHashTree::find_differing_leaves(const BucketHashTree& other) const
+{
+    assert(leaf_count() == other.leaf_count());
+    std::vector<uint32_t> result;
+    find_differing_leaves(other, 0, result);
+    return result;
+}
+
+}
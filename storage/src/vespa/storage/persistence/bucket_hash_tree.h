@@ -0,0 +1,64 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/document/base/globalid.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace storage {
+
+/**
+ * Hierarchical hash summary of the (timestamp, gid, remove flag) entries of a
+ * bucket, used by merges to find the parts of the bucket where the
+ * replicas differ without exchanging metadata for all entries.
+ *
+ * Entries are placed in one of a power of two number of leaves based on
+ * a hash of their timestamp, so that the same entry ends up in the same
+ * leaf on all nodes. The hash of a node in the tree is the sum of the
+ * hashes of all entries below it, which makes the tree cheap to maintain
+ * incrementally, and lets two trees be compared top-down by only visiting
+ * the subtrees with differing hashes.
+ */
+class BucketHashTree {
+    uint32_t              _depth;
+    // Complete binary tree in heap order, the leaves are last
+    std::vector<uint64_t> _nodes;
+
+    uint32_t first_leaf() const noexcept { return (1u << _depth) - 1; }
+    void update(uint64_t timestamp, uint64_t delta);
+    void find_differing_leaves(const BucketHashTree& other, uint32_t node, std::vector<uint32_t>& result) const;
+public:
+    static constexpr uint32_t entries_per_leaf = 32;
+    static constexpr uint32_t max_leaf_count = 1u << 16;
+
+    /** leaf_count must be a power of two, see leaf_count_for */
+    explicit BucketHashTree(uint32_t leaf_count);
+    /** Creates the tree with the given leaf hashes, as returned by leaf_hashes */
+    explicit BucketHashTree(const std::vector<uint64_t>& leaf_hashes);
+    ~BucketHashTree();
+
+    /** Returns a suitable leaf count for a bucket with the given number of entries */
+    static uint32_t leaf_count_for(size_t num_entries) noexcept;
+    static bool valid_leaf_count(uint32_t leaf_count) noexcept;
+    static uint32_t leaf_of(uint64_t timestamp, uint32_t leaf_count) noexcept;
+    static uint64_t entry_hash(uint64_t timestamp, const document::GlobalId& gid, bool is_remove) noexcept;
+
+    void add(uint64_t timestamp, const document::GlobalId& gid, bool is_remove) {
+        update(timestamp, entry_hash(timestamp, gid, is_remove));
+    }
+    void remove(uint64_t timestamp, const document::GlobalId& gid, bool is_remove) {
+        update(timestamp, -entry_hash(timestamp, gid, is_remove));
+    }
+
+    uint32_t leaf_count() const noexcept { return 1u << _depth; }
+    uint64_t root_hash() const noexcept { return _nodes[0]; }
+    std::vector<uint64_t> leaf_hashes() const;
+    /**
+     * Returns the (sorted) leaves where this tree and the other tree,
+     * which must have the same number of leaves, differ.
+     */
+    std::vector<uint32_t> find_differing_leaves(const BucketHashTree& other) const;
+};
+
+}
@@ -3,6 +3,7 @@
 
 namespace storage {
 
+FileStorHandler::CoalescedMessage::~CoalescedMessage() = default;
 FileStorHandler::LockedMessage::~LockedMessage() = default;
 
 }
@@ -75,24 +75,44 @@ public:
         [[nodiscard]] virtual api::LockingRequirements lockingRequirements() const noexcept = 0;
     };
 
+    /**
+     * A feed operation (put, remove or update) for the same bucket as a LockedMessage,
+     * dequeued together with it and covered by the same bucket lock.
+     */
+    struct CoalescedMessage {
+        std::shared_ptr<api::StorageMessage> msg;
+        ThrottleToken                        throttle_token;
+
+        CoalescedMessage(std::shared_ptr<api::StorageMessage> msg_, ThrottleToken token) noexcept
+            : msg(std::move(msg_)),
+              throttle_token(std::move(token))
+        {}
+        CoalescedMessage(CoalescedMessage&&) noexcept = default;
+        ~CoalescedMessage();
+    };
+
     struct LockedMessage {
         std::shared_ptr<BucketLockInterface> lock;
         std::shared_ptr<api::StorageMessage> msg;
         ThrottleToken                        throttle_token;
+        // Feed operations that shall be processed together with msg, in order.
+        std::vector<CoalescedMessage>        coalesced;
 
         LockedMessage() noexcept = default;
         LockedMessage(std::shared_ptr<BucketLockInterface> lock_,
                       std::shared_ptr<api::StorageMessage> msg_) noexcept
             : lock(std::move(lock_)),
               msg(std::move(msg_)),
-              throttle_token()
+              throttle_token(),
+              coalesced()
         {}
         LockedMessage(std::shared_ptr<BucketLockInterface> lock_,
                       std::shared_ptr<api::StorageMessage> msg_,
                       ThrottleToken token) noexcept
                 : lock(std::move(lock_)),
                   msg(std::move(msg_)),
-                  throttle_token(std::move(token))
+                  throttle_token(std::move(token)),
+                  coalesced()
         {}
         LockedMessage(LockedMessage&&) noexcept = default;
         ~LockedMessage();
@@ -287,6 +307,12 @@ public:
     virtual void use_dynamic_operation_throttling(bool use_dynamic) noexcept = 0;
 
     virtual void set_throttle_apply_bucket_diff_ops(bool throttle_apply_bucket_diff) noexcept = 0;
+
+    /**
+     * Sets the maximum number of feed operations for the same bucket that getNextMessage()
+     * may hand out together under a single bucket lock. 1 disables coalescing.
+     */
+    virtual void set_max_feed_op_batch_size(uint32_t max_batch_size) noexcept = 0;
 private:
     vespalib::duration _getNextMessageTimout;
 };
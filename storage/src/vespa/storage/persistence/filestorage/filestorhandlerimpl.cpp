@@ -38,6 +38,31 @@ uint32_t per_stripe_merge_limit(uint32_t num_threads, uint32_t num_stripes) noex
     return std::max(1u, (num_threads / num_stripes) / 2);
 }
 
+// Returns the timestamp of a put, remove or update that may be dispatched to the provider
+// in a batch with other feed operations for the same bucket, or 0 if it may not. Operations
+// with a test-and-set condition must observe the effect of all earlier operations, so they
+// are always processed on their own.
+api::Timestamp
+coalescable_feed_op_timestamp(const api::StorageMessage& msg) noexcept
+{
+    switch (msg.getType().getId()) {
+    case api::MessageType::PUT_ID: {
+        const auto& put = static_cast<const api::PutCommand&>(msg);
+        return put.getCondition().isPresent() ? 0 : put.getTimestamp();
+    }
+    case api::MessageType::REMOVE_ID: {
+        const auto& remove = static_cast<const api::RemoveCommand&>(msg);
+        return remove.getCondition().isPresent() ? 0 : remove.getTimestamp();
+    }
+    case api::MessageType::UPDATE_ID: {
+        const auto& update = static_cast<const api::UpdateCommand&>(msg);
+        return update.getCondition().isPresent() ? 0 : update.getTimestamp();
+    }
+    default:
+        return 0;
+    }
+}
+
 }
 
 FileStorHandlerImpl::FileStorHandlerImpl(MessageSender& sender, FileStorMetrics& metrics,
@@ -62,6 +87,7 @@ FileStorHandlerImpl::FileStorHandlerImpl(uint32_t numThreads, uint32_t numStripe
       _max_active_merges_per_stripe(per_stripe_merge_limit(numThreads, numStripes)),
       _paused(false),
       _throttle_apply_bucket_diff_ops(false),
+      _max_feed_op_batch_size(1),
       _last_active_operations_stats()
 {
     assert(numStripes > 0);
@@ -977,7 +1003,7 @@ FileStorHandlerImpl::Stripe::getNextMessage(vespalib::steady_time deadline)
                 }
             }
             if (!should_throttle_op || throttle_token.valid()) {
-                return getMessage(guard, idx, iter, std::move(throttle_token));
+                return getMessage(guard, idx, iter, std::move(throttle_token), _owner.max_feed_op_batch_size());
             }
         }
         if (attempt == 0) {
@@ -1018,7 +1044,8 @@ FileStorHandlerImpl::Stripe::get_next_async_message(monitor_guard& guard)
         // poll of the throttle policy.
         auto throttle_token = _owner.operation_throttler().try_acquire_one();
         if (throttle_token.valid()) {
-            return getMessage(guard, idx, iter, std::move(throttle_token));
+            // Never coalesce here, since this runs in the context of the RPC thread.
+            return getMessage(guard, idx, iter, std::move(throttle_token), 1);
         } else {
             _metrics->throttled_rpc_direct_dispatches.inc();
         }
@@ -1028,7 +1055,7 @@ FileStorHandlerImpl::Stripe::get_next_async_message(monitor_guard& guard)
 
 FileStorHandler::LockedMessage
 FileStorHandlerImpl::Stripe::getMessage(monitor_guard & guard, PriorityIdx & idx, PriorityIdx::iterator iter,
-                                        ThrottleToken throttle_token)
+                                        ThrottleToken throttle_token, uint32_t max_feed_op_batch_size)
 {
     std::chrono::milliseconds waitTime(uint64_t(iter->_timer.stop(_metrics->averageQueueWaitingTime)));
 
@@ -1041,8 +1068,16 @@ FileStorHandlerImpl::Stripe::getMessage(monitor_guard & guard, PriorityIdx & idx
         auto locker = std::make_unique<BucketLock>(guard, *this, bucket, msg->getPriority(),
                                                    msg->getType().getId(), msg->getMsgId(),
                                                    msg->lockingRequirements());
+        FileStorHandler::LockedMessage locked(std::move(locker), std::move(msg), std::move(throttle_token));
+        std::vector<std::shared_ptr<api::StorageReply>> timed_out;
+        if (max_feed_op_batch_size > 1) {
+            coalesce_feed_ops(guard, locked, max_feed_op_batch_size, timed_out);
+        }
         guard.unlock();
-        return {std::move(locker), std::move(msg), std::move(throttle_token)};
+        for (auto& reply : timed_out) {
+            _messageSender.sendReply(reply);
+        }
+        return locked;
     } else {
         std::shared_ptr<api::StorageReply> msgReply(makeQueueTimeoutReply(*msg));
         guard.unlock();
@@ -1052,6 +1087,52 @@ FileStorHandlerImpl::Stripe::getMessage(monitor_guard & guard, PriorityIdx & idx
     }
 }
 
+void
+FileStorHandlerImpl::Stripe::coalesce_feed_ops(const monitor_guard & guard, FileStorHandler::LockedMessage & locked,
+                                               uint32_t max_feed_op_batch_size,
+                                               std::vector<std::shared_ptr<api::StorageReply>> & timed_out)
+{
+    api::Timestamp last_timestamp = coalescable_feed_op_timestamp(*locked.msg);
+    if (last_timestamp == 0) {
+        return;
+    }
+    // Only operations with the same priority as the first one are coalesced. Queued operations for
+    // the bucket with a lower priority would be scheduled after other buckets' operations anyway,
+    // and the batch size is bounded, so operations with a higher priority are delayed by at most
+    // one batch. Among operations with the same priority the bucket index keeps queue order,
+    // which is also the order in which they would otherwise have been scheduled.
+    const uint8_t priority = locked.msg->getPriority();
+    BucketIdx& idx(bmi::get<2>(*_queue));
+    auto range = idx.equal_range(locked.lock->getBucket());
+    auto iter = range.first;
+    while ((iter != range.second) && (locked.coalesced.size() + 1 < max_feed_op_batch_size)) {
+        if (iter->_priority != priority) {
+            ++iter;
+            continue;
+        }
+        api::Timestamp timestamp = coalescable_feed_op_timestamp(*iter->_command);
+        if (timestamp <= last_timestamp) {
+            break; // Not a feed op that can be batched, or it would be applied out of timestamp order
+        }
+        auto throttle_token = _owner.operation_throttler().try_acquire_one();
+        if (!throttle_token.valid()) {
+            break;
+        }
+        std::chrono::milliseconds waitTime(uint64_t(iter->_timer.stop(_metrics->averageQueueWaitingTime)));
+        std::shared_ptr<api::StorageMessage> msg = iter->_command;
+        iter = idx.erase(iter);
+        if (messageTimedOutInQueue(*msg, waitTime)) {
+            timed_out.emplace_back(makeQueueTimeoutReply(*msg));
+        } else {
+            last_timestamp = timestamp;
+            locked.coalesced.emplace_back(std::move(msg), std::move(throttle_token));
+        }
+    }
+    update_cached_queue_size(guard);
+    _metrics->feed_op_batch_size.addValue(locked.coalesced.size() + 1);
+    _metrics->coalesced_feed_ops.inc(locked.coalesced.size());
+}
+
 void
 FileStorHandlerImpl::Stripe::waitUntilNoLocks() const
 {
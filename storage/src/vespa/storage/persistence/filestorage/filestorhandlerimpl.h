@@ -178,7 +178,13 @@ public:
         // with its locking requirements.
         FileStorHandler::LockedMessage getMessage(monitor_guard & guard, PriorityIdx & idx,
                                                   PriorityIdx::iterator iter,
-                                                  ThrottleToken throttle_token);
+                                                  ThrottleToken throttle_token,
+                                                  uint32_t max_feed_op_batch_size);
+        // Moves queued feed operations for the bucket of `locked` into its coalesced set, as long as
+        // they would have been scheduled right after it anyway.
+        void coalesce_feed_ops(const monitor_guard & guard, FileStorHandler::LockedMessage & locked,
+                               uint32_t max_feed_op_batch_size,
+                               std::vector<std::shared_ptr<api::StorageReply>> & timed_out);
         using LockedBuckets = vespalib::hash_map<document::Bucket, MultiLockEntry, document::Bucket::hash>;
         const FileStorHandlerImpl      &_owner;
         MessageSender                  &_messageSender;
@@ -292,6 +298,10 @@ public:
         _throttle_apply_bucket_diff_ops.store(throttle_apply_bucket_diff, std::memory_order_relaxed);
     }
 
+    void set_max_feed_op_batch_size(uint32_t max_batch_size) noexcept override {
+        _max_feed_op_batch_size.store(std::max(1u, max_batch_size), std::memory_order_relaxed);
+    }
+
     // Implements ResumeGuard::Callback
     void resume() override;
 
@@ -315,6 +325,7 @@ private:
     mutable std::condition_variable _pauseCond;
     std::atomic<bool>               _paused;
     std::atomic<bool>               _throttle_apply_bucket_diff_ops;
+    std::atomic<uint32_t>           _max_feed_op_batch_size;
     std::optional<ActiveOperationsStats> _last_active_operations_stats;
 
     // Returns the index in the targets array we are sending to, or -1 if none of them match.
@@ -338,6 +349,10 @@ private:
         return _throttle_apply_bucket_diff_ops.load(std::memory_order_relaxed);
     }
 
+    [[nodiscard]] uint32_t max_feed_op_batch_size() const noexcept {
+        return _max_feed_op_batch_size.load(std::memory_order_relaxed);
+    }
+
     /**
      * Return whether msg has timed out based on waitTime and the message's
      * specified timeout.
@@ -216,6 +216,8 @@ FileStorManager::configure(std::unique_ptr<StorFilestorConfig> config)
     const bool use_dynamic_throttling = ((config->asyncOperationThrottlerType  == StorFilestorConfig::AsyncOperationThrottlerType::DYNAMIC) ||
                                          (config->asyncOperationThrottler.type == StorFilestorConfig::AsyncOperationThrottler::Type::DYNAMIC));
     const bool throttle_merge_feed_ops = config->asyncOperationThrottler.throttleIndividualMergeFeedOps;
+    const bool use_merge_hash_tree_summary = config->useMergeHashTreeSummary;
+    const uint32_t max_feed_op_batch_size = std::max(1, config->maxFeedOpBatchSize);
 
     if (!liveUpdate) {
         _config = std::move(config);
@@ -246,9 +248,11 @@ FileStorManager::configure(std::unique_ptr<StorFilestorConfig> config)
     {
         _filestorHandler->use_dynamic_operation_throttling(use_dynamic_throttling);
         _filestorHandler->set_throttle_apply_bucket_diff_ops(!throttle_merge_feed_ops);
+        _filestorHandler->set_max_feed_op_batch_size(max_feed_op_batch_size);
         std::lock_guard guard(_lock);
         for (auto& ph : _persistenceHandlers) {
             ph->set_throttle_merge_feed_ops(throttle_merge_feed_ops);
+            ph->set_use_merge_hash_tree_summary(use_merge_hash_tree_summary);
         }
     }
 }
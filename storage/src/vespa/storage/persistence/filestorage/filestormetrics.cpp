@@ -195,7 +195,13 @@ FileStorStripeMetrics::FileStorStripeMetrics(const std::string& name, const std:
                                          "queued async operation because it was disallowed by the throttle policy", this),
       timeouts_waiting_for_throttle_token("timeouts_waiting_for_throttle_token", {},
                                           "Number of times a persistence thread timed out waiting for an available "
-                                          "throttle policy token", this)
+                                          "throttle policy token", this),
+      feed_op_batch_size("feed_op_batch_size", {},
+                         "Number of feed operations for the same bucket dispatched together to the "
+                         "persistence provider under a single bucket lock", this),
+      coalesced_feed_ops("coalesced_feed_ops", {},
+                         "Number of feed operations dispatched as part of a batch headed by another "
+                         "operation for the same bucket", this)
 {
 }
 
@@ -132,6 +132,8 @@ public:
     metrics::LongCountMetric throttled_rpc_direct_dispatches;
     metrics::LongCountMetric throttled_persistence_thread_polls;
     metrics::LongCountMetric timeouts_waiting_for_throttle_token;
+    metrics::LongAverageMetric feed_op_batch_size;
+    metrics::LongCountMetric coalesced_feed_ops;
     FileStorStripeMetrics(const std::string& name, const std::string& description);
     ~FileStorStripeMetrics() override;
 };
@@ -29,6 +29,10 @@ public:
     framework::MilliSecTimer startTime;
     std::optional<std::future<vespalib::string>> delayed_error;
     spi::Context context;
+    // Leaf count of the bucket hash trees compared in a pending summary GetBucketDiff
+    uint32_t pendingHashTreeLeafCount;
+    // Local entries of the first node, kept for the GetBucketDiff following a summary GetBucketDiff
+    std::vector<api::GetBucketDiffCommand::Entry> hashTreeLocalEntries;
  	
     MergeStatus(const framework::Clock&, api::StorageMessage::Priority, uint32_t traceLevel);
     ~MergeStatus() override;
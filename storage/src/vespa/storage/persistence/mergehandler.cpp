@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "mergehandler.h"
+#include "bucket_hash_tree.h"
 #include "persistenceutil.h"
 #include "shared_operation_throttler.h"
 #include "apply_bucket_diff_entry_complete.h"
@@ -37,7 +38,8 @@ MergeHandler::MergeHandler(PersistenceUtil& env, spi::PersistenceProvider& spi,
       _maxChunkSize(maxChunkSize),
       _commonMergeChainOptimalizationMinimumSize(commonMergeChainOptimalizationMinimumSize),
       _executor(executor),
-      _throttle_merge_feed_ops(true)
+      _throttle_merge_feed_ops(true),
+      _use_hash_tree_summary(false)
 {
 }
 
@@ -323,6 +325,77 @@ namespace {
         return api::StorageMessageAddress::create(clusterName, lib::NodeType::STORAGE, node);
     }
 
+    /**
+     * Buckets with fewer entries than this are merged by exchanging all
+     * metadata at once, as the summary round trip is not worth it.
+     *
+     * The summary carries all leaf hashes of the first node, so its size
+     * is linear in the bucket size (about 8 bytes per 32 entries) and each
+     * node builds its tree from a full metadata iteration. Exchanging the
+     * tree level by level would cost one round trip through the merge
+     * chain per level, so only a single summary round is used.
+     */
+    constexpr size_t minEntriesForHashTreeSummary = 1024;
+
+    BucketHashTree buildHashTree(const std::vector<api::GetBucketDiffCommand::Entry>& entries,
+                                 uint32_t leafCount)
+    {
+        BucketHashTree tree(leafCount);
+        for (const auto& e : entries) {
+            tree.add(e._timestamp, e._gid, (e._flags & getDeleteFlag()) != 0);
+        }
+        return tree;
+    }
+
+    /**
+     * Turn a GetBucketDiff holding the local entries of the first node
+     * into a summary request carrying their hash tree instead. The
+     * entries are moved to localEntries.
+     */
+    void setupHashTreeSummary(api::GetBucketDiffCommand& cmd, uint32_t leafCount,
+                              std::vector<api::GetBucketDiffCommand::Entry>& localEntries)
+    {
+        cmd.getHashTreeLeaves() = buildHashTree(cmd.getDiff(), leafCount).leaf_hashes();
+        cmd.setHashTreeLeafCount(leafCount);
+        localEntries.swap(cmd.getDiff());
+        cmd.getDiff().clear();
+    }
+
+    /**
+     * Add the leaves where the local entries differ from the hash tree in
+     * a summary request to the differing leaves of the request.
+     */
+    void addDifferingLeaves(api::GetBucketDiffCommand& cmd,
+                            const std::vector<api::GetBucketDiffCommand::Entry>& local)
+    {
+        BucketHashTree remote(cmd.getHashTreeLeaves());
+        auto differing = buildHashTree(local, remote.leaf_count()).find_differing_leaves(remote);
+        std::vector<uint32_t> result;
+        std::set_union(cmd.getDifferingLeaves().begin(), cmd.getDifferingLeaves().end(),
+                       differing.begin(), differing.end(), std::back_inserter(result));
+        cmd.getDifferingLeaves().swap(result);
+    }
+
+    /**
+     * Keep only the entries within the given (sorted) hash tree leaves.
+     */
+    void filterToLeaves(std::vector<api::GetBucketDiffCommand::Entry>& entries,
+                        uint32_t leafCount, const std::vector<uint32_t>& leaves)
+    {
+        std::erase_if(entries, [&](const auto& e) {
+            return !std::binary_search(leaves.begin(), leaves.end(), BucketHashTree::leaf_of(e._timestamp, leafCount));
+        });
+    }
+
+    bool validHashTree(const api::GetBucketDiffCommand& cmd) {
+        uint32_t leafCount = cmd.getHashTreeLeafCount();
+        return BucketHashTree::valid_leaf_count(leafCount) &&
+               (!cmd.isHashTreeSummary() || (cmd.getHashTreeLeaves().size() == leafCount)) &&
+               std::all_of(cmd.getDifferingLeaves().begin(), cmd.getDifferingLeaves().end(),
+                           [leafCount](uint32_t leaf) { return leaf < leafCount; }) &&
+               std::is_sorted(cmd.getDifferingLeaves().begin(), cmd.getDifferingLeaves().end());
+    }
+
     void assertContainedInBucket(const document::DocumentId& docId,
                                  const document::BucketId& bucket,
                                  const document::BucketIdFactory& idFactory)
@@ -946,6 +1019,10 @@ MergeHandler::handleMergeBucket(api::MergeBucketCommand& cmd, MessageTracker::UP
         return tracker;
     }
     _env._metrics.merge_handler_metrics.mergeMetadataReadLatency.addValue(s->startTime.getElapsedTimeAsDouble());
+    if (use_hash_tree_summary() && (cmd2->getDiff().size() >= minEntriesForHashTreeSummary)) {
+        s->pendingHashTreeLeafCount = BucketHashTree::leaf_count_for(cmd2->getDiff().size());
+        setupHashTreeSummary(*cmd2, s->pendingHashTreeLeafCount, s->hashTreeLocalEntries);
+    }
     LOG(spam, "Sending GetBucketDiff %" PRIu64 " for %s to next node %u "
         "with diff of %u entries.",
         cmd2->getMsgId(),
@@ -1113,8 +1190,21 @@ MergeHandler::handleGetBucketDiffStage2(api::GetBucketDiffCommand& cmd, MessageT
         tracker->fail(api::ReturnCode::BUCKET_DELETED, "Bucket not found in buildBucketInfo step");
         return tracker;
     }
-    if (!mergeLists(remote, local, local)) {
-        LOG(error, "Diffing %s found suspect entries.", bucket.toString().c_str());
+    if (((cmd.getHashTreeLeafCount() != 0) || cmd.isHashTreeSummary()) && !validHashTree(cmd)) {
+        tracker->fail(api::ReturnCode::ILLEGAL_PARAMETERS, "Invalid bucket hash tree in GetBucketDiff");
+        return tracker;
+    }
+    if (cmd.isHashTreeSummary()) {
+        // Only hash tree leaves are exchanged, entries are added in a later GetBucketDiff
+        addDifferingLeaves(cmd, local);
+        local.clear();
+    } else {
+        if (cmd.getHashTreeLeafCount() != 0) {
+            filterToLeaves(local, cmd.getHashTreeLeafCount(), cmd.getDifferingLeaves());
+        }
+        if (!mergeLists(remote, local, local)) {
+            LOG(error, "Diffing %s found suspect entries.", bucket.toString().c_str());
+        }
     }
     _env._metrics.merge_handler_metrics.mergeMetadataReadLatency.addValue(startTime.getElapsedTimeAsDouble());
 
@@ -1141,6 +1231,10 @@ MergeHandler::handleGetBucketDiffStage2(api::GetBucketDiffCommand& cmd, MessageT
 
         auto reply = std::make_shared<api::GetBucketDiffReply>(cmd);
         reply->getDiff().swap(final);
+        if (cmd.isHashTreeSummary()) {
+            reply->getDifferingLeaves().swap(cmd.getDifferingLeaves());
+            reply->setHashTreeSummaryHandled(true);
+        }
         tracker->setReply(std::move(reply));
     } else {
         // When not the last node in merge chain, we must save reply, and
@@ -1158,6 +1252,9 @@ MergeHandler::handleGetBucketDiffStage2(api::GetBucketDiffCommand& cmd, MessageT
         auto cmd2 = std::make_shared<api::GetBucketDiffCommand>(bucket.getBucket(), cmd.getNodes(), cmd.getMaxTimestamp());
         cmd2->setAddress(createAddress(_cluster_context.cluster_name_ptr(), cmd.getNodes()[index + 1].index));
         cmd2->getDiff().swap(local);
+        cmd2->getHashTreeLeaves().swap(cmd.getHashTreeLeaves());
+        cmd2->setHashTreeLeafCount(cmd.getHashTreeLeafCount());
+        cmd2->getDifferingLeaves().swap(cmd.getDifferingLeaves());
         cmd2->setPriority(cmd.getPriority());
         cmd2->setTimeout(cmd.getTimeout());
         s->pendingId = cmd2->getMsgId();
@@ -1199,6 +1296,14 @@ MergeHandler::handleGetBucketDiffReply(api::GetBucketDiffReply& reply, MessageSe
             if (reply.getResult().failed()) {
                 // We failed, so we should reply to the pending message.
                 replyToSend = s->reply;
+            } else if (s->pendingHashTreeLeafCount != 0) {
+                replyToSend = sendDifferingLeavesGetBucketDiff(bucket, *s, reply);
+                if (!replyToSend) {
+                    clearState = false;
+                } else {
+                    _env._metrics.merge_handler_metrics.mergeLatencyTotal.addValue(
+                            s->startTime.getElapsedTimeAsDouble());
+                }
             } else {
                 // If we didn't fail, reply should have good content
                 // Sanity check for nodes
@@ -1228,6 +1333,8 @@ MergeHandler::handleGetBucketDiffReply(api::GetBucketDiffReply& reply, MessageSe
                 "size %zu. Sending it on.",
                 bucket.toString().c_str(), reply.getDiff().size());
             s->pendingGetDiff->getDiff().swap(reply.getDiff());
+            s->pendingGetDiff->getDifferingLeaves().swap(reply.getDifferingLeaves());
+            s->pendingGetDiff->setHashTreeSummaryHandled(reply.isHashTreeSummaryHandled());
         }
     } catch (std::exception& e) {
         _env._fileStorHandler.clearMergeStatus(
@@ -1246,6 +1353,43 @@ MergeHandler::handleGetBucketDiffReply(api::GetBucketDiffReply& reply, MessageSe
     }
 }
 
+api::StorageReply::SP
+MergeHandler::sendDifferingLeavesGetBucketDiff(const spi::Bucket& bucket, MergeStatus& status,
+                                               api::GetBucketDiffReply& reply) const
+{
+    uint32_t leafCount = status.pendingHashTreeLeafCount;
+    status.pendingHashTreeLeafCount = 0;
+    std::vector<api::GetBucketDiffCommand::Entry> local;
+    local.swap(status.hashTreeLocalEntries);
+    std::vector<uint32_t>& differingLeaves(reply.getDifferingLeaves());
+    auto cmd = std::make_shared<api::GetBucketDiffCommand>(bucket.getBucket(), status.nodeList,
+                                                           status.maxTimestamp.getTime());
+    if (!reply.isHashTreeSummaryHandled()) {
+        // A node not knowing about hash trees has treated the summary as a regular
+        // GetBucketDiff without our entries, so all entries must be exchanged.
+        LOG(debug, "Bucket hash tree summary for %s was not supported by all nodes. "
+                   "Sending GetBucketDiff with diff of %zu entries.",
+            bucket.toString().c_str(), local.size());
+        cmd->getDiff().swap(local);
+    } else if (differingLeaves.empty()) {
+        LOG(debug, "Done with merge of %s. All copies have the same bucket hash tree.", bucket.toString().c_str());
+        return status.reply;
+    } else {
+        filterToLeaves(local, leafCount, differingLeaves);
+        LOG(debug, "Sending GetBucketDiff for %s with %zu of %u hash tree leaves differing, diff of %zu entries.",
+            bucket.toString().c_str(), differingLeaves.size(), leafCount, local.size());
+        cmd->getDiff().swap(local);
+        cmd->setHashTreeLeafCount(leafCount);
+        cmd->getDifferingLeaves().swap(differingLeaves);
+    }
+    cmd->setAddress(createAddress(_cluster_context.cluster_name_ptr(), status.nodeList[1].index));
+    cmd->setPriority(status.context.getPriority());
+    cmd->setTimeout(status.timeout);
+    status.pendingId = cmd->getMsgId();
+    _env._fileStorHandler.sendCommand(cmd);
+    return api::StorageReply::SP();
+}
+
 MessageTracker::UP
 MergeHandler::handleApplyBucketDiff(api::ApplyBucketDiffCommand& cmd, MessageTracker::UP tracker) const
 {
@@ -89,6 +89,15 @@ public:
         return _throttle_merge_feed_ops.load(std::memory_order_relaxed);
     }
 
+    // Thread safe, as it's set during live reconfig from the main filestor manager.
+    void set_use_hash_tree_summary(bool use_summary) noexcept {
+        _use_hash_tree_summary.store(use_summary, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool use_hash_tree_summary() const noexcept {
+        return _use_hash_tree_summary.load(std::memory_order_relaxed);
+    }
+
 private:
     using DocEntryList = std::vector<std::unique_ptr<spi::DocEntry>>;
     const framework::Clock   &_clock;
@@ -100,8 +109,19 @@ private:
     const uint32_t            _commonMergeChainOptimalizationMinimumSize;
     vespalib::ISequencedTaskExecutor& _executor;
     std::atomic<bool>         _throttle_merge_feed_ops;
+    std::atomic<bool>         _use_hash_tree_summary;
 
     MessageTrackerUP handleGetBucketDiffStage2(api::GetBucketDiffCommand&, MessageTrackerUP) const;
+    /**
+     * Sends the GetBucketDiff for the hash tree leaves where the copies
+     * differ, using the local entries kept from the summary GetBucketDiff.
+     * Falls back to a GetBucketDiff of all entries if a node in the chain
+     * does not support the summary. Returns a reply if there is nothing
+     * left to merge.
+     */
+    api::StorageReply::SP sendDifferingLeavesGetBucketDiff(const spi::Bucket& bucket,
+                                                           MergeStatus& status,
+                                                           api::GetBucketDiffReply& reply) const;
     /** Returns a reply if merge is complete */
     api::StorageReply::SP processBucketMerge(const spi::Bucket& bucket,
                                              MergeStatus& status,
@@ -168,6 +168,10 @@ PersistenceHandler::processMessage(api::StorageMessage& msg, MessageTracker::UP
 
 void
 PersistenceHandler::processLockedMessage(FileStorHandler::LockedMessage lock) const {
+    if ( ! lock.coalesced.empty()) {
+        processLockedFeedBatch(std::move(lock));
+        return;
+    }
     LOG(debug, "NodeIndex %d, ptr=%p", _env._nodeIndex, lock.msg.get());
     api::StorageMessage & msg(*lock.msg);
 
@@ -181,10 +185,56 @@ PersistenceHandler::processLockedMessage(FileStorHandler::LockedMessage lock) co
     }
 }
 
+void
+PersistenceHandler::processLockedFeedBatch(FileStorHandler::LockedMessage lock) const {
+    LOG(debug, "NodeIndex %d, ptr=%p, batch of %zu", _env._nodeIndex, lock.msg.get(), lock.coalesced.size() + 1);
+    // All operations in the batch share the bucket lock, which is released when the last one is done.
+    std::shared_ptr<FileStorHandler::BucketLockInterface> bucketLock(std::move(lock.lock));
+    AsyncHandler::FeedBatchOps ops;
+    ops.reserve(lock.coalesced.size() + 1);
+    // Keep the commands alive to be able to fail them if the batch throws.
+    std::vector<std::shared_ptr<api::StorageMessage>> msgs;
+    msgs.reserve(lock.coalesced.size() + 1);
+    auto add_op = [&](std::shared_ptr<api::StorageMessage> msg, ThrottleToken throttle_token) {
+        MBUS_TRACE(msg->getTrace(), 5, "PersistenceHandler: Processing message in persistence layer as part of a batch");
+        _env._metrics.operations.inc();
+        msgs.push_back(msg);
+        auto* cmd = static_cast<api::StorageCommand*>(msg.get());
+        ops.emplace_back(cmd, std::make_unique<MessageTracker>(framework::MilliSecTimer(_clock), _env, _env._fileStorHandler,
+                                                               bucketLock, std::move(msg), std::move(throttle_token)));
+    };
+    add_op(std::move(lock.msg), std::move(lock.throttle_token));
+    for (auto& coalesced : lock.coalesced) {
+        add_op(std::move(coalesced.msg), std::move(coalesced.throttle_token));
+    }
+    std::vector<MessageTracker::UP> failed;
+    try {
+        failed = _asyncHandler.handleFeedBatch(std::move(ops));
+    } catch (std::exception& e) {
+        // The trackers of the batch are gone, so reply directly like processMessage() does.
+        for (const auto& msg : msgs) {
+            LOG(debug, "Caught exception for %s in batch: %s", msg->toString().c_str(), e.what());
+            api::StorageReply::SP reply(static_cast<api::StorageCommand&>(*msg).makeReply());
+            reply->setResult(api::ReturnCode(api::ReturnCode::INTERNAL_FAILURE, e.what()));
+            _env._fileStorHandler.sendReply(reply);
+        }
+        return;
+    }
+    for (auto& tracker : failed) {
+        tracker->sendReply();
+    }
+}
+
 void
 PersistenceHandler::set_throttle_merge_feed_ops(bool throttle) noexcept
 {
     _mergeHandler.set_throttle_merge_feed_ops(throttle);
 }
 
+void
+PersistenceHandler::set_use_merge_hash_tree_summary(bool use_summary) noexcept
+{
+    _mergeHandler.set_use_hash_tree_summary(use_summary);
+}
+
 }
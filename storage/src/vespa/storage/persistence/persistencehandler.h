@@ -37,12 +37,14 @@ public:
     const SimpleMessageHandler & simpleMessageHandler() const { return _simpleHandler; }
 
     void set_throttle_merge_feed_ops(bool throttle) noexcept;
+    void set_use_merge_hash_tree_summary(bool use_summary) noexcept;
 private:
     // Message handling functions
     MessageTracker::UP handleCommandSplitByType(api::StorageCommand&, MessageTracker::UP tracker) const;
     MessageTracker::UP handleReply(api::StorageReply&, MessageTracker::UP) const;
 
     MessageTracker::UP processMessage(api::StorageMessage& msg, MessageTracker::UP tracker) const;
+    void processLockedFeedBatch(FileStorHandler::LockedMessage lock) const;
 
     const framework::Clock  & _clock;
     PersistenceUtil           _env;
@@ -175,6 +175,15 @@ ProviderErrorWrapper::updateAsync(const spi::Bucket &bucket, spi::Timestamp ts,
     _impl.updateAsync(bucket, ts, std::move(upd), std::move(onComplete));
 }
 
+void
+ProviderErrorWrapper::feedBatchAsync(const spi::Bucket &bucket, spi::FeedBatch batch)
+{
+    for (auto &entry : batch.entries()) {
+        entry.on_complete->addResultHandler(this);
+    }
+    _impl.feedBatchAsync(bucket, std::move(batch));
+}
+
 std::unique_ptr<vespalib::IDestructorCallback>
 ProviderErrorWrapper::register_executor(std::shared_ptr<spi::BucketExecutor> executor)
 {
@@ -61,6 +61,7 @@ public:
     void removeAsync(const spi::Bucket&, std::vector<spi::IdAndTimestamp>, spi::OperationComplete::UP) override;
     void removeIfFoundAsync(const spi::Bucket&, spi::Timestamp, const document::DocumentId&, spi::OperationComplete::UP) override;
     void updateAsync(const spi::Bucket &, spi::Timestamp, spi::DocumentUpdateSP, spi::OperationComplete::UP) override;
+    void feedBatchAsync(const spi::Bucket&, spi::FeedBatch) override;
     void setActiveStateAsync(const spi::Bucket& b, spi::BucketInfo::ActiveState newState, spi::OperationComplete::UP onComplete) override;
     void createBucketAsync(const spi::Bucket&, spi::OperationComplete::UP) noexcept override;
     void deleteBucketAsync(const spi::Bucket&, spi::OperationComplete::UP) noexcept override;
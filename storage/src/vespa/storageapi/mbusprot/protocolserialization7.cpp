@@ -924,12 +924,17 @@ void ProtocolSerialization7::onEncode(GBBuf& buf, const api::GetBucketDiffComman
         set_merge_nodes(*req.mutable_nodes(), msg.getNodes());
         req.set_max_timestamp(msg.getMaxTimestamp());
         fill_proto_meta_diff(*req.mutable_diff(), msg.getDiff());
+        req.mutable_hash_tree_leaves()->Add(msg.getHashTreeLeaves().begin(), msg.getHashTreeLeaves().end());
+        req.set_hash_tree_leaf_count(msg.getHashTreeLeafCount());
+        req.mutable_differing_leaves()->Add(msg.getDifferingLeaves().begin(), msg.getDifferingLeaves().end());
     });
 }
 
 void ProtocolSerialization7::onEncode(GBBuf& buf, const api::GetBucketDiffReply& msg) const {
     encode_bucket_response<protobuf::GetBucketDiffResponse>(buf, msg, [&](auto& res) {
         fill_proto_meta_diff(*res.mutable_diff(), msg.getDiff());
+        res.mutable_differing_leaves()->Add(msg.getDifferingLeaves().begin(), msg.getDifferingLeaves().end());
+        res.set_hash_tree_summary_handled(msg.isHashTreeSummaryHandled());
     });
 }
 
@@ -938,6 +943,9 @@ api::StorageCommand::UP ProtocolSerialization7::onDecodeGetBucketDiffCommand(BBu
         auto nodes = get_merge_nodes(req.nodes());
         auto cmd = std::make_unique<api::GetBucketDiffCommand>(bucket, std::move(nodes), req.max_timestamp());
         fill_api_meta_diff(cmd->getDiff(), req.diff());
+        cmd->getHashTreeLeaves().assign(req.hash_tree_leaves().begin(), req.hash_tree_leaves().end());
+        cmd->setHashTreeLeafCount(req.hash_tree_leaf_count());
+        cmd->getDifferingLeaves().assign(req.differing_leaves().begin(), req.differing_leaves().end());
         return cmd;
     });
 }
@@ -946,6 +954,8 @@ api::StorageReply::UP ProtocolSerialization7::onDecodeGetBucketDiffReply(const S
     return decode_bucket_response<protobuf::GetBucketDiffResponse>(buf, [&](auto& res) {
         auto reply = std::make_unique<api::GetBucketDiffReply>(static_cast<const api::GetBucketDiffCommand&>(cmd));
         fill_api_meta_diff(reply->getDiff(), res.diff());
+        reply->getDifferingLeaves().assign(res.differing_leaves().begin(), res.differing_leaves().end());
+        reply->setHashTreeSummaryHandled(res.hash_tree_summary_handled());
         return reply;
     });
 }
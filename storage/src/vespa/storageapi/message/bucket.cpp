@@ -214,7 +214,11 @@ GetBucketDiffCommand::GetBucketDiffCommand(
         Timestamp maxTimestamp)
     : BucketCommand(MessageType::GETBUCKETDIFF, bucket),
       _nodes(nodes),
-      _maxTimestamp(maxTimestamp)
+      _maxTimestamp(maxTimestamp),
+      _diff(),
+      _hashTreeLeaves(),
+      _hashTreeLeafCount(0),
+      _differingLeaves()
 {}
 
 GetBucketDiffCommand::~GetBucketDiffCommand() = default;
@@ -242,6 +246,11 @@ GetBucketDiffCommand::print(std::ostream& out, bool verbose,
         out << ", " << _diff.size() << " entries";
         out << ", id " << _msgId;
     }
+    if (_hashTreeLeafCount != 0) {
+        out << ", hash tree of " << _hashTreeLeafCount << " leaves"
+            << (isHashTreeSummary() ? " (summary)" : "")
+            << ", " << _differingLeaves.size() << " differing";
+    }
     out << ")";
     if (verbose) {
         out << " : ";
@@ -253,7 +262,9 @@ GetBucketDiffReply::GetBucketDiffReply(const GetBucketDiffCommand& cmd)
     : BucketReply(cmd),
       _nodes(cmd.getNodes()),
       _maxTimestamp(cmd.getMaxTimestamp()),
-      _diff(cmd.getDiff())
+      _diff(cmd.getDiff()),
+      _differingLeaves(),
+      _hashTreeSummaryHandled(false)
 {}
 
 GetBucketDiffReply::~GetBucketDiffReply() = default;
@@ -280,6 +291,9 @@ GetBucketDiffReply::print(std::ostream& out, bool verbose,
         out << ", " << _diff.size() << " entries";
         out << ", id " << _msgId;
     }
+    if (_hashTreeSummaryHandled) {
+        out << ", " << _differingLeaves.size() << " differing hash tree leaves";
+    }
     out << ")";
     if (verbose) {
         out << " : ";
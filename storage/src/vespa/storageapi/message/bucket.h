@@ -202,6 +202,14 @@ private:
     std::vector<Node> _nodes;
     Timestamp _maxTimestamp;
     std::vector<Entry> _diff;
+    // Leaf hashes of the bucket hash tree of the first node. If set, the
+    // command is a summary request, where each node adds the leaves where
+    // its copy differs to the differing leaves instead of adding entries.
+    std::vector<uint64_t> _hashTreeLeaves;
+    // If non-zero, only entries within the differing leaves of a hash tree
+    // with this many leaves are part of the diff.
+    uint32_t _hashTreeLeafCount;
+    std::vector<uint32_t> _differingLeaves;
 
 public:
     GetBucketDiffCommand(const document::Bucket &bucket,
@@ -213,6 +221,13 @@ public:
     Timestamp getMaxTimestamp() const { return _maxTimestamp; }
     const std::vector<Entry>& getDiff() const { return _diff; }
     std::vector<Entry>& getDiff() { return _diff; }
+    const std::vector<uint64_t>& getHashTreeLeaves() const { return _hashTreeLeaves; }
+    std::vector<uint64_t>& getHashTreeLeaves() { return _hashTreeLeaves; }
+    bool isHashTreeSummary() const { return !_hashTreeLeaves.empty(); }
+    uint32_t getHashTreeLeafCount() const { return _hashTreeLeafCount; }
+    void setHashTreeLeafCount(uint32_t leafCount) { _hashTreeLeafCount = leafCount; }
+    const std::vector<uint32_t>& getDifferingLeaves() const { return _differingLeaves; }
+    std::vector<uint32_t>& getDifferingLeaves() { return _differingLeaves; }
 
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
 
@@ -234,6 +249,11 @@ private:
     std::vector<Node> _nodes;
     Timestamp _maxTimestamp;
     std::vector<Entry> _diff;
+    // Hash tree leaves where any node differs, set in reply to a summary request
+    std::vector<uint32_t> _differingLeaves;
+    // Set if all nodes in the merge chain handled the summary request. Nodes
+    // not knowing about hash trees treat it as a regular request instead.
+    bool _hashTreeSummaryHandled;
 
 public:
     explicit GetBucketDiffReply(const GetBucketDiffCommand& cmd);
@@ -243,6 +263,10 @@ public:
     Timestamp getMaxTimestamp() const { return _maxTimestamp; }
     const std::vector<Entry>& getDiff() const { return _diff; }
     std::vector<Entry>& getDiff() { return _diff; }
+    const std::vector<uint32_t>& getDifferingLeaves() const { return _differingLeaves; }
+    std::vector<uint32_t>& getDifferingLeaves() { return _differingLeaves; }
+    bool isHashTreeSummaryHandled() const { return _hashTreeSummaryHandled; }
+    void setHashTreeSummaryHandled(bool handled) { _hashTreeSummaryHandled = handled; }
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
 
     DECLARE_STORAGEREPLY(GetBucketDiffReply, onGetBucketDiffReply)
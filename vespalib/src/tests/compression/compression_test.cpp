@@ -3,7 +3,10 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/exceptions.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("compression_test");
@@ -67,6 +70,83 @@ TEST("requiret that zstd compression/decompression works") {
     EXPECT_EQUAL(_G_compressableText, vespalib::string(decompress.data(), decompress.size()));
 }
 
+namespace {
+
+vespalib::string
+make_document(uint32_t id) {
+    return make_string("{\"id\":\"id:music:music::%u\",\"fields\":{\"title\":\"Title number %u\","
+                       "\"artist\":\"Artist %u\",\"year\":%u,\"genre\":\"rock\"}}", id, id * 7, id % 13, 1950 + id % 70);
+}
+
+}
+
+TEST("require that zstd compression with a trained dictionary works") {
+    std::vector<vespalib::string> documents;
+    for (uint32_t id = 0; id < 2000; ++id) {
+        documents.push_back(make_document(id));
+    }
+    std::vector<ConstBufferRef> samples;
+    for (const auto & document : documents) {
+        samples.emplace_back(document.c_str(), document.size());
+    }
+    auto dictionary = ZStdDictionary::train(samples, 4096, 9);
+    ASSERT_TRUE(dictionary);
+    EXPECT_NOT_EQUAL(0u, dictionary->id());
+    EXPECT_GREATER_EQUAL(4096u, dictionary->content().size());
+
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD, 9, 100);
+    vespalib::string document = make_document(4711);
+    ConstBufferRef ref(document.c_str(), document.size());
+    DataBuffer plain;
+    DataBuffer compressed;
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD, compress(cfg, ref, compressed, false, dictionary.get()));
+    compress(cfg, ref, plain, false);
+    EXPECT_LESS(compressed.getDataLen(), plain.getDataLen());
+
+    DataBuffer decompressed;
+    decompress(CompressionConfig::Type::ZSTD, document.size(), ConstBufferRef(compressed.getData(), compressed.getDataLen()),
+               decompressed, false, dictionary.get());
+    EXPECT_EQUAL(document, vespalib::string(decompressed.getData(), decompressed.getDataLen()));
+
+    // Data compressed without the dictionary can still be decompressed when given one.
+    DataBuffer decompressedPlain;
+    decompress(CompressionConfig::Type::ZSTD, document.size(), ConstBufferRef(plain.getData(), plain.getDataLen()),
+               decompressedPlain, false, dictionary.get());
+    EXPECT_EQUAL(document, vespalib::string(decompressedPlain.getData(), decompressedPlain.getDataLen()));
+
+    // A different compression level than the dictionary was built for is also handled.
+    DataBuffer compressedOtherLevel;
+    CompressionConfig cfgOtherLevel(CompressionConfig::Type::ZSTD, 3, 100);
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD, compress(cfgOtherLevel, ref, compressedOtherLevel, false, dictionary.get()));
+    DataBuffer decompressedOtherLevel;
+    decompress(CompressionConfig::Type::ZSTD, document.size(),
+               ConstBufferRef(compressedOtherLevel.getData(), compressedOtherLevel.getDataLen()),
+               decompressedOtherLevel, false, dictionary.get());
+    EXPECT_EQUAL(document, vespalib::string(decompressedOtherLevel.getData(), decompressedOtherLevel.getDataLen()));
+}
+
+TEST("require that training a zstd dictionary without enough samples fails") {
+    vespalib::string document = make_document(1);
+    std::vector<ConstBufferRef> samples;
+    samples.emplace_back(document.c_str(), document.size());
+    EXPECT_FALSE(ZStdDictionary::train(samples, 4096, 9));
+}
+
+TEST("require that creating a zstd dictionary from corrupt content fails") {
+    // zstd dictionary magic number followed by garbage entropy tables
+    std::vector<char> content(64, char(0xff));
+    const char magic[] = {char(0x37), char(0xa4), char(0x30), char(0xec), 1, 0, 0, 0};
+    memcpy(content.data(), magic, sizeof(magic));
+    EXPECT_EXCEPTION(ZStdDictionary(ConstBufferRef(content.data(), content.size()), 9),
+                     IllegalArgumentException, "Invalid zstd dictionary");
+}
+
+TEST("require that creating a zstd dictionary from raw content fails") {
+    vespalib::string content = make_document(1);
+    EXPECT_EXCEPTION(ZStdDictionary(ConstBufferRef(content.c_str(), content.size()), 9),
+                     IllegalArgumentException, "raw content dictionaries are not supported");
+}
+
 TEST("require that CompressionConfig is Atomic") {
     EXPECT_EQUAL(8u, sizeof(CompressionConfig));
     EXPECT_TRUE(std::atomic<CompressionConfig>::is_always_lock_free);
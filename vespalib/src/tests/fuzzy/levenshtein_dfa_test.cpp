@@ -0,0 +1,136 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/fuzzy/levenshtein_dfa.h>
+#include <vespa/vespalib/fuzzy/fuzzy_matcher.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace vespalib;
+
+namespace {
+
+vespalib::string successor(const LevenshteinDfa& dfa, std::string_view source) {
+    vespalib::string result;
+    EXPECT_FALSE(dfa.match(source, result));
+    return result;
+}
+
+// All strings up to max_len over the given alphabet, in sorted order.
+std::vector<std::string> all_strings(std::string_view alphabet, size_t max_len) {
+    std::vector<std::string> result{""};
+    std::vector<std::string> current{""};
+    for (size_t len = 1; len <= max_len; ++len) {
+        std::vector<std::string> next;
+        for (const auto& s : current) {
+            for (char c : alphabet) {
+                next.push_back(s + c);
+            }
+        }
+        result.insert(result.end(), next.begin(), next.end());
+        current = std::move(next);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+}
+
+TEST(LevenshteinDfaTest, matches_within_max_edit_distance) {
+    LevenshteinDfa dfa("abc", 2, 0, false);
+    EXPECT_TRUE(dfa.is_match("abc"));
+    EXPECT_TRUE(dfa.is_match("ABC"));
+    EXPECT_TRUE(dfa.is_match("ab1"));
+    EXPECT_TRUE(dfa.is_match("a12"));
+    EXPECT_TRUE(dfa.is_match("a"));
+    EXPECT_TRUE(dfa.is_match("abcde"));
+    EXPECT_FALSE(dfa.is_match("123"));
+    EXPECT_FALSE(dfa.is_match("abcdef"));
+}
+
+TEST(LevenshteinDfaTest, cased_match) {
+    LevenshteinDfa dfa("abc", 2, 0, true);
+    EXPECT_TRUE(dfa.is_match("abc"));
+    EXPECT_TRUE(dfa.is_match("abC"));
+    EXPECT_TRUE(dfa.is_match("aBC"));
+    EXPECT_FALSE(dfa.is_match("ABC"));
+}
+
+TEST(LevenshteinDfaTest, match_with_prefix) {
+    LevenshteinDfa dfa("abcdef", 2, 2, false);
+    EXPECT_TRUE(dfa.is_match("abcdef"));
+    EXPECT_TRUE(dfa.is_match("ABCDEF"));
+    EXPECT_TRUE(dfa.is_match("abcde1"));
+    EXPECT_TRUE(dfa.is_match("abcd12"));
+    EXPECT_FALSE(dfa.is_match("abc123"));
+    EXPECT_FALSE(dfa.is_match("12cdef"));
+}
+
+TEST(LevenshteinDfaTest, prefix_longer_than_term_requires_exact_match) {
+    LevenshteinDfa dfa("abc", 2, 5, false);
+    EXPECT_TRUE(dfa.is_match("abc"));
+    EXPECT_FALSE(dfa.is_match("abcd"));
+    EXPECT_FALSE(dfa.is_match("ab"));
+}
+
+TEST(LevenshteinDfaTest, successor_is_smallest_greater_string_that_can_match) {
+    LevenshteinDfa dfa("food", 1, 0, false);
+    EXPECT_EQ("fo\x01" "d", successor(dfa, "fo"));   // source is a prefix of a match
+    EXPECT_EQ("fooad", successor(dfa, "fooa\x01"));  // "fooa" matches, but needs an exact "d" to continue
+    EXPECT_EQ("fxod", successor(dfa, "fx"));        // only an exact suffix can match after a substitution
+    EXPECT_EQ("gfood", successor(dfa, "gaaa"));     // "ga..." cannot match, "gf..." and "go..." can
+    EXPECT_EQ("zfood", successor(dfa, "z"));        // "z" can only be an insertion
+    EXPECT_EQ("{food", successor(dfa, "zz"));       // next code point after 'z' as a substitution
+}
+
+TEST(LevenshteinDfaTest, successor_respects_frozen_prefix) {
+    LevenshteinDfa dfa("abcd", 1, 2, false);
+    EXPECT_EQ("ab\x01" "cd", successor(dfa, "aa"));
+    EXPECT_EQ("ab\x01" "cd", successor(dfa, "a"));
+    EXPECT_EQ("", successor(dfa, "ac"));
+}
+
+TEST(LevenshteinDfaTest, uncased_successor_only_contains_lowercase_code_points) {
+    LevenshteinDfa dfa("xyz", 1, 0, false);
+    // 'A' would be folded to 'a' by the dictionary, skipping entries starting with '@' < c < 'a'
+    EXPECT_EQ("[xyz", successor(dfa, "@zz"));
+}
+
+TEST(LevenshteinDfaTest, agrees_with_fuzzy_matcher_and_never_skips_matches) {
+    auto strings = all_strings("abcd", 5);
+    for (const char* term : {"", "a", "ab", "abc", "dcba", "bad", "aaa"}) {
+        for (uint32_t max_edits = 0; max_edits <= LevenshteinDfa::MaxEditDistance; ++max_edits) {
+            for (uint32_t prefix_size = 0; prefix_size <= 3; ++prefix_size) {
+                SCOPED_TRACE(std::string("term=") + term + " max_edits=" + std::to_string(max_edits) +
+                             " prefix_size=" + std::to_string(prefix_size));
+                LevenshteinDfa dfa(term, max_edits, prefix_size, false);
+                FuzzyMatcher matcher(term, max_edits, prefix_size, false);
+                for (size_t i = 0; i < strings.size(); ++i) {
+                    const auto& source = strings[i];
+                    bool expected = matcher.isMatch(source);
+                    vespalib::string next;
+                    ASSERT_EQ(expected, dfa.match(source, next)) << source;
+                    ASSERT_EQ(expected, dfa.is_match(source)) << source;
+                    if (expected) {
+                        continue;
+                    }
+                    auto next_match = std::find_if(strings.begin() + i + 1, strings.end(),
+                                                   [&matcher](const auto& s) { return matcher.isMatch(s); });
+                    if (next.empty()) {
+                        ASSERT_EQ(strings.end(), next_match) << source;
+                    } else {
+                        std::string next_str(next.c_str());
+                        ASSERT_GT(next_str, source);
+                        ASSERT_TRUE(matcher.isMatch(next_str)) << next_str;
+                        if (next_match != strings.end()) {
+                            ASSERT_LE(next_str, *next_match) << source;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
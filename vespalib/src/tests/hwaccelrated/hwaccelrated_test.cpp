@@ -47,4 +47,63 @@ TEST("test euclidean distance") {
     TEST_DO(verifyEuclideanDistance(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
 }
 
+template<typename T>
+void verifyEuclideanDistances(const hwaccelrated::IAccelrated & accel, size_t testLength, double approxFactor) {
+    srand(1);
+    std::vector<std::vector<T>> a;
+    for (size_t n(0); n < 7; n++) {
+        a.push_back(createAndFill<T>(testLength));
+    }
+    std::vector<T> b = createAndFill<T>(testLength);
+    for (size_t j(0); j < 0x20; j++) {
+        std::vector<const T *> lhs;
+        for (const auto & v : a) {
+            lhs.push_back(&v[j]);
+        }
+        std::vector<double> result(lhs.size());
+        accel.squaredEuclideanDistances(lhs.data(), lhs.size(), &b[j], testLength - j, result.data());
+        for (size_t n(0); n < lhs.size(); n++) {
+            double expected = accel.squaredEuclideanDistance(lhs[n], &b[j], testLength - j);
+            EXPECT_APPROX(expected, result[n], expected*approxFactor);
+        }
+    }
+}
+
+TEST("test euclidean distances from many vectors to one") {
+    constexpr size_t TEST_LENGTH = 1000;
+    TEST_DO(verifyEuclideanDistances<float>(hwaccelrated::GenericAccelrator(), TEST_LENGTH, 0.0001));
+    TEST_DO(verifyEuclideanDistances<double>(hwaccelrated::GenericAccelrator(), TEST_LENGTH, 0.0));
+    TEST_DO(verifyEuclideanDistances<float>(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH, 0.0001));
+    TEST_DO(verifyEuclideanDistances<double>(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH, 0.0));
+}
+
+void
+verifyMaxAndSumUint8(const hwaccelrated::IAccelrated & accel, size_t testLength) {
+    srand(1);
+    std::vector<uint8_t> a(testLength);
+    std::vector<uint8_t> b(testLength);
+    for (size_t i(0); i < testLength; i++) {
+        a[i] = rand();
+        b[i] = rand();
+    }
+    for (size_t j(0); j < 0x20; j++) {
+        std::vector<uint8_t> expected(a);
+        uint64_t sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            expected[i] = std::max(a[i], b[i]);
+            sum += expected[i];
+        }
+        std::vector<uint8_t> result(a);
+        accel.maxUint8(&result[j], &b[j], testLength - j);
+        EXPECT_TRUE(expected == result);
+        EXPECT_EQUAL(sum, accel.sumUint8(&result[j], testLength - j));
+    }
+}
+
+TEST("test max and sum of uint8") {
+    constexpr size_t TEST_LENGTH = 70000;
+    TEST_DO(verifyMaxAndSumUint8(hwaccelrated::GenericAccelrator(), TEST_LENGTH));
+    TEST_DO(verifyMaxAndSumUint8(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -41,7 +41,9 @@ struct Fixture {
     Selector<Context> selector;
     std::vector<SocketPair> sockets;
     std::vector<Context> contexts;
-    Fixture(size_t size, bool read_enabled, bool write_enabled) : wakeup(false), selector(), sockets(), contexts() {
+    Fixture(size_t size, bool read_enabled, bool write_enabled, SelectorBackend backend = SelectorBackend::EPOLL)
+        : wakeup(false), selector(backend), sockets(), contexts()
+    {
         for (size_t i = 0; i < size; ++i) {
             sockets.push_back(SocketPair::create());
             contexts.push_back(Context(sockets.back().a.get()));
@@ -107,20 +109,24 @@ constexpr std::pair<bool,bool> in   = std::make_pair(true,  false);
 constexpr std::pair<bool,bool> out  = std::make_pair(false, true);
 constexpr std::pair<bool,bool> both = std::make_pair(true,  true);
 
+void verify_basic_events(Fixture &f) {
+    TEST_DO(f.reset().poll().verify(false, {out}));
+    EXPECT_TRUE(f.write(0, "test"));
+    TEST_DO(f.reset().poll().verify(false, {both}));
+    f.update(0, true, false);
+    TEST_DO(f.reset().poll().verify(false, {in}));
+    f.update(0, false, true);
+    TEST_DO(f.reset().poll().verify(false, {out}));
+    f.update(0, false, false);
+    TEST_DO(f.reset().poll(10).verify(false, {none}));
+    f.update(0, true, true);
+    f.selector.wakeup();
+    TEST_DO(f.reset().poll().verify(true, {both}));
+    TEST_DO(f.reset().poll().verify(false, {both}));
+}
+
 TEST_F("require that basic events trigger correctly", Fixture(1, true, true)) {
-    TEST_DO(f1.reset().poll().verify(false, {out}));
-    EXPECT_TRUE(f1.write(0, "test"));
-    TEST_DO(f1.reset().poll().verify(false, {both}));
-    f1.update(0, true, false);
-    TEST_DO(f1.reset().poll().verify(false, {in}));
-    f1.update(0, false, true);
-    TEST_DO(f1.reset().poll().verify(false, {out}));
-    f1.update(0, false, false);
-    TEST_DO(f1.reset().poll(10).verify(false, {none}));
-    f1.update(0, true, true);
-    f1.selector.wakeup();
-    TEST_DO(f1.reset().poll().verify(true, {both}));
-    TEST_DO(f1.reset().poll().verify(false, {both}));
+    verify_basic_events(f1);
 }
 
 TEST_FFF("require that sources can be added with some events disabled",
@@ -140,37 +146,80 @@ TEST_FFF("require that sources can be added with some events disabled",
     TEST_DO(f3.reset().poll().verify(false, {both}));
 }
 
+void verify_multiple_sources(Fixture &f) {
+    TEST_DO(f.reset().poll(10).verify(false, {none, none, none, none, none}));
+    EXPECT_TRUE(f.write(1, "test"));
+    EXPECT_TRUE(f.write(3, "test"));
+    TEST_DO(f.reset().poll().verify(false, {none, in, none, in, none}));
+    EXPECT_TRUE(f.read(1, strlen("test")));
+    EXPECT_TRUE(f.read(3, strlen("te")));
+    TEST_DO(f.reset().poll().verify(false, {none, none, none, in, none}));
+    EXPECT_TRUE(f.read(3, strlen("st")));
+    TEST_DO(f.reset().poll(10).verify(false, {none, none, none, none, none}));
+}
+
 TEST_F("require that multiple sources can be selected on", Fixture(5, true, false)) {
-    TEST_DO(f1.reset().poll(10).verify(false, {none, none, none, none, none}));
-    EXPECT_TRUE(f1.write(1, "test"));
-    EXPECT_TRUE(f1.write(3, "test"));
-    TEST_DO(f1.reset().poll().verify(false, {none, in, none, in, none}));
-    EXPECT_TRUE(f1.read(1, strlen("test")));
-    EXPECT_TRUE(f1.read(3, strlen("te")));
-    TEST_DO(f1.reset().poll().verify(false, {none, none, none, in, none}));
-    EXPECT_TRUE(f1.read(3, strlen("st")));
-    TEST_DO(f1.reset().poll(10).verify(false, {none, none, none, none, none}));
+    verify_multiple_sources(f1);
+}
+
+void verify_removed_sources(Fixture &f) {
+    TEST_DO(f.reset().poll().verify(false, {out, out}));
+    EXPECT_TRUE(f.write(0, "test"));
+    EXPECT_TRUE(f.write(1, "test"));
+    TEST_DO(f.reset().poll().verify(false, {both, both}));
+    f.selector.remove(f.contexts[0].fd);
+    TEST_DO(f.reset().poll().verify(false, {none, both}));
 }
 
 TEST_F("require that removed sources no longer produce events", Fixture(2, true, true)) {
-    TEST_DO(f1.reset().poll().verify(false, {out, out}));
-    EXPECT_TRUE(f1.write(0, "test"));
-    EXPECT_TRUE(f1.write(1, "test"));
-    TEST_DO(f1.reset().poll().verify(false, {both, both}));
-    f1.selector.remove(f1.contexts[0].fd);
-    TEST_DO(f1.reset().poll().verify(false, {none, both}));
+    verify_removed_sources(f1);
 }
 
-TEST_F("require that filling the output buffer disables write events", Fixture(1, true, true)) {
-    EXPECT_TRUE(f1.write(0, "test"));
-    TEST_DO(f1.reset().poll().verify(false, {both}));
+void verify_full_output_buffer(Fixture &f) {
+    EXPECT_TRUE(f.write(0, "test"));
+    TEST_DO(f.reset().poll().verify(false, {both}));
     size_t buffer_size = 0;
-    while (f1.write_self(0, "x")) {
+    while (f.write_self(0, "x")) {
         ++buffer_size;
     }
     EXPECT_TRUE((errno == EWOULDBLOCK) || (errno == EAGAIN));
     fprintf(stderr, "buffer size: %zu\n", buffer_size);
-    TEST_DO(f1.reset().poll().verify(false, {in}));
+    TEST_DO(f.reset().poll().verify(false, {in}));
+}
+
+TEST_F("require that filling the output buffer disables write events", Fixture(1, true, true)) {
+    verify_full_output_buffer(f1);
+}
+
+// The io_uring backend falls back to epoll when not supported by the
+// kernel; it only supports changes from the polling thread.
+
+TEST_F("require that io_uring backend triggers basic events correctly", Fixture(1, true, true, SelectorBackend::IO_URING)) {
+    fprintf(stderr, "using io_uring: %s\n", f1.selector.using_io_uring() ? "yes" : "no (not supported)");
+    verify_basic_events(f1);
+}
+
+TEST_F("require that io_uring backend can select on multiple sources", Fixture(5, true, false, SelectorBackend::IO_URING)) {
+    verify_multiple_sources(f1);
+}
+
+TEST_F("require that io_uring backend does not produce events for removed sources", Fixture(2, true, true, SelectorBackend::IO_URING)) {
+    verify_removed_sources(f1);
+}
+
+TEST_F("require that io_uring backend disables write events when the output buffer is full", Fixture(1, true, true, SelectorBackend::IO_URING)) {
+    verify_full_output_buffer(f1);
+}
+
+TEST_MT_FF("require that io_uring backend can be woken while waiting for events", 2,
+           Fixture(0, true, false, SelectorBackend::IO_URING), TimeBomb(60))
+{
+    if (thread_id == 0) {
+        TEST_DO(f1.reset().poll().verify(true, {}));
+    } else {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        f1.selector.wakeup();
+    }
 }
 
 TEST_MT_FF("require that selector can be woken while waiting for events", 2, Fixture(0, true, false), TimeBomb(60)) {
@@ -48,6 +48,37 @@ TEST("testCache") {
     EXPECT_TRUE(cache.size() == 1);
 }
 
+TEST("require that populate inserts without writing to backing store") {
+    B m;
+    cache< CacheParam<P, B, zero<uint32_t>, size<string> > > cache(m, -1);
+    cache.populate(1, "Fetched in a batch", cache.getGeneration(1));
+    EXPECT_TRUE(cache.hasKey(1));
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQUAL(1u, cache.getInsert());
+    EXPECT_EQUAL("Fetched in a batch", cache.read(1));
+    EXPECT_EQUAL(1u, cache.getHit());
+    cache.write(2, "Written");
+    cache.populate(2, "Stale", cache.getGeneration(2));
+    EXPECT_EQUAL("Written", cache.read(2));
+    EXPECT_EQUAL(1u, cache.getInsert());
+}
+
+TEST("require that populate does not insert objects written or invalidated after they were read") {
+    B m;
+    cache< CacheParam<P, B, zero<uint32_t>, size<string> > > cache(m, -1);
+    uint64_t generation = cache.getGeneration(1);
+    cache.invalidate(1);
+    cache.populate(1, "Removed while fetched", generation);
+    EXPECT_FALSE(cache.hasKey(1));
+    generation = cache.getGeneration(2);
+    cache.write(2, "Written while fetched");
+    cache.invalidate(2);
+    cache.populate(2, "Stale", generation);
+    EXPECT_FALSE(cache.hasKey(2));
+    EXPECT_EQUAL(0u, cache.getInsert());
+    EXPECT_EQUAL(2u, cache.getRace());
+}
+
 TEST("testCacheSize")
 {
     B m;
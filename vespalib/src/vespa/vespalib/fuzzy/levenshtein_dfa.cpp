@@ -0,0 +1,289 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "levenshtein_dfa.h"
+#include <vespa/vespalib/text/lowercase.h>
+#include <vespa/vespalib/text/utf8.h>
+#include <algorithm>
+#include <cassert>
+#include <map>
+
+namespace vespalib {
+
+namespace {
+
+constexpr uint32_t Inf = static_cast<uint32_t>(-1);
+constexpr uint32_t MaxCodepoint = 0x10ffff;
+
+// Positions in the query term (after the prefix) and the edit distance to each of them, sorted by position.
+using Row = std::vector<std::pair<uint32_t, uint32_t>>;
+
+uint32_t
+edits_at(const Row & row, uint32_t pos)
+{
+    auto itr = std::lower_bound(row.begin(), row.end(), pos,
+                                [](const auto & elem, uint32_t value) { return elem.first < value; });
+    return (itr != row.end() && itr->first == pos) ? itr->second : Inf;
+}
+
+/*
+ * Calculates the next row of the Levenshtein matrix when consuming code point c
+ * from the source, only keeping the positions within max edit distance.
+ */
+Row
+step(const Row & row, const std::vector<uint32_t> & term, uint32_t c, uint32_t max_edits)
+{
+    Row next;
+    uint32_t last_pos = row.back().first;
+    uint32_t prev = Inf; // edits at the previous position in the next row
+    for (uint32_t pos = row.front().first; pos <= term.size(); ++pos) {
+        uint32_t best = Inf;
+        uint32_t edits = edits_at(row, pos);
+        if (edits != Inf) {
+            best = edits + 1;
+        }
+        if (pos > 0) {
+            uint32_t diag = edits_at(row, pos - 1);
+            if (diag != Inf) {
+                best = std::min(best, diag + ((term[pos - 1] == c) ? 0u : 1u));
+            }
+        }
+        if (prev != Inf) {
+            best = std::min(best, prev + 1);
+        }
+        if (best <= max_edits) {
+            next.emplace_back(pos, best);
+            prev = best;
+        } else {
+            prev = Inf;
+            if (pos > last_pos) {
+                break; // nothing more can be reached
+            }
+        }
+    }
+    return next;
+}
+
+std::vector<uint32_t>
+cased_convert_to_ucs4(std::string_view input)
+{
+    std::vector<uint32_t> result;
+    result.reserve(input.size());
+    Utf8Reader reader(input.data(), input.size());
+    while (reader.hasMore()) {
+        result.emplace_back(reader.getChar());
+    }
+    return result;
+}
+
+}
+
+uint32_t
+LevenshteinDfa::State::next(uint32_t c) const noexcept
+{
+    auto itr = std::lower_bound(edges.begin(), edges.end(), c,
+                                [](const auto & edge, uint32_t value) { return edge.first < value; });
+    return (itr != edges.end() && itr->first == c) ? itr->second : other;
+}
+
+LevenshteinDfa::LevenshteinDfa(std::string_view term, uint32_t max_edit_distance, uint32_t prefix_size, bool is_cased)
+    : _prefix(),
+      _suffix(),
+      _states(),
+      _max_edit_distance(max_edit_distance),
+      _is_cased(is_cased)
+{
+    assert(supports(max_edit_distance));
+    auto codepoints = to_codepoints(term);
+    if (prefix_size > codepoints.size()) {
+        // Same as FuzzyMatcher: the whole term is frozen, and only an exact match is a match.
+        _prefix = std::move(codepoints);
+        _max_edit_distance = 0;
+    } else {
+        _prefix.assign(codepoints.begin(), codepoints.begin() + prefix_size);
+        _suffix.assign(codepoints.begin() + prefix_size, codepoints.end());
+    }
+    build();
+}
+
+LevenshteinDfa::~LevenshteinDfa() = default;
+
+void
+LevenshteinDfa::build()
+{
+    std::map<Row, uint32_t> ids;
+    std::vector<Row> rows;
+    auto intern = [&](Row row) -> uint32_t {
+        if (row.empty()) {
+            return Dead;
+        }
+        auto [itr, inserted] = ids.emplace(std::move(row), rows.size());
+        if (inserted) {
+            rows.push_back(itr->first);
+        }
+        return itr->second;
+    };
+    Row start;
+    for (uint32_t pos = 0; pos <= std::min(_max_edit_distance, uint32_t(_suffix.size())); ++pos) {
+        start.emplace_back(pos, pos);
+    }
+    intern(std::move(start));
+    for (uint32_t id = 0; id < rows.size(); ++id) {
+        Row row = rows[id];
+        State state;
+        state.accepting = (row.back().first == _suffix.size());
+        std::vector<uint32_t> chars;
+        for (const auto & elem : row) {
+            if (elem.first < _suffix.size()) {
+                chars.push_back(_suffix[elem.first]);
+            }
+        }
+        std::sort(chars.begin(), chars.end());
+        chars.erase(std::unique(chars.begin(), chars.end()), chars.end());
+        for (uint32_t c : chars) {
+            state.edges.emplace_back(c, intern(step(row, _suffix, c, _max_edit_distance)));
+        }
+        // Inf never occurs in the term, and represents all code points without an explicit edge.
+        state.other = intern(step(row, _suffix, Inf, _max_edit_distance));
+        _states.push_back(std::move(state));
+    }
+}
+
+std::vector<uint32_t>
+LevenshteinDfa::to_codepoints(std::string_view source) const
+{
+    return _is_cased ? cased_convert_to_ucs4(source) : LowerCase::convert_to_ucs4(source);
+}
+
+uint32_t
+LevenshteinDfa::smallest_alive_above(const State & state, uint32_t c) const
+{
+    uint32_t result = Dead;
+    for (const auto & edge : state.edges) {
+        if (edge.first > c && edge.second != Dead) {
+            result = edge.first;
+            break;
+        }
+    }
+    if (state.other != Dead) {
+        uint32_t candidate = c + 1;
+        for (;;) {
+            if (candidate >= 0xd800 && candidate <= 0xdfff) {
+                candidate = 0xe000; // surrogates are not valid code points
+            } else if (!_is_cased && LowerCase::convert(candidate) != candidate) {
+                ++candidate; // an uncased dictionary only orders lowercased code points
+            } else if (state.next(candidate) != state.other) {
+                ++candidate; // has an explicit edge
+            } else {
+                break;
+            }
+        }
+        if (candidate <= MaxCodepoint) {
+            result = std::min(result, candidate);
+        }
+    }
+    return result;
+}
+
+void
+LevenshteinDfa::complete_successor(uint32_t state, std::vector<uint32_t> & successor) const
+{
+    // Every live state can reach an accepting state, and the language is finite, so this terminates.
+    while (!_states[state].accepting) {
+        uint32_t c = smallest_alive_above(_states[state], 0);
+        assert(c != Dead);
+        successor.push_back(c);
+        state = _states[state].next(c);
+    }
+}
+
+void
+LevenshteinDfa::write_successor(const std::vector<uint32_t> & successor, vespalib::string & successor_out)
+{
+    successor_out.clear();
+    Utf8Writer writer(successor_out);
+    for (uint32_t c : successor) {
+        writer.putChar(c);
+    }
+}
+
+bool
+LevenshteinDfa::is_match(std::string_view source) const
+{
+    Utf8Reader reader(source.data(), source.size());
+    for (uint32_t expected : _prefix) {
+        if (!reader.hasMore()) {
+            return false;
+        }
+        uint32_t c = reader.getChar();
+        if ((_is_cased ? c : LowerCase::convert(c)) != expected) {
+            return false;
+        }
+    }
+    uint32_t state = 0;
+    while (reader.hasMore()) {
+        uint32_t c = reader.getChar();
+        state = _states[state].next(_is_cased ? c : LowerCase::convert(c));
+        if (state == Dead) {
+            return false;
+        }
+    }
+    return _states[state].accepting;
+}
+
+bool
+LevenshteinDfa::match(std::string_view source, vespalib::string & successor_out) const
+{
+    auto s = to_codepoints(source);
+    std::vector<uint32_t> successor;
+    size_t p = _prefix.size();
+    for (size_t i = 0; i < p; ++i) {
+        if (i == s.size() || s[i] < _prefix[i]) {
+            successor.assign(s.begin(), s.begin() + i);
+            successor.insert(successor.end(), _prefix.begin() + i, _prefix.end());
+            complete_successor(0, successor);
+            write_successor(successor, successor_out);
+            return false;
+        }
+        if (s[i] > _prefix[i]) {
+            successor_out.clear();
+            return false;
+        }
+    }
+    std::vector<uint32_t> path; // path[i - p] is the state before consuming s[i]
+    path.reserve(s.size() - p + 1);
+    uint32_t state = 0;
+    path.push_back(state);
+    size_t i = p;
+    for (; i < s.size(); ++i) {
+        state = _states[state].next(s[i]);
+        if (state == Dead) {
+            break;
+        }
+        path.push_back(state);
+    }
+    if (i == s.size()) {
+        if (_states[state].accepting) {
+            return true;
+        }
+        successor = std::move(s);
+        complete_successor(state, successor);
+        write_successor(successor, successor_out);
+        return false;
+    }
+    // Nothing starting with s[0..i] can match. Find the last position where a greater code point keeps the match alive.
+    for (size_t j = i + 1; j-- > p; ) {
+        const State & prev = _states[path[j - p]];
+        uint32_t c = smallest_alive_above(prev, s[j]);
+        if (c != Dead) {
+            successor.assign(s.begin(), s.begin() + j);
+            successor.push_back(c);
+            complete_successor(prev.next(c), successor);
+            write_successor(successor, successor_out);
+            return false;
+        }
+    }
+    successor_out.clear();
+    return false;
+}
+
+}
@@ -0,0 +1,74 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Deterministic Levenshtein automaton matching the same terms as FuzzyMatcher, i.e. terms within
+ * max edit distance of the query term after a frozen (non-fuzzy) prefix, optionally cased.
+ *
+ * A state in the automaton is the set of positions in the query term (after the prefix) that
+ * can be reached within max edit distance, together with the edit distance to each of them.
+ * All states are built up front, so matching a source term is a single pass over its code points.
+ * The number of states grows quickly with max edit distance, so it is limited to MaxEditDistance.
+ *
+ * In addition to matching, the automaton can calculate the successor of a non-matching source term:
+ * the smallest term (ordered by code points, after lowercasing if uncased) that is greater than the
+ * source term and might match. This allows a sorted dictionary to be walked by seeking directly to
+ * the next candidate instead of testing every entry.
+ */
+class LevenshteinDfa {
+public:
+    static constexpr uint32_t MaxEditDistance = 2u;
+
+    LevenshteinDfa(std::string_view term, uint32_t max_edit_distance, uint32_t prefix_size, bool is_cased);
+    LevenshteinDfa(const LevenshteinDfa &) = delete;
+    LevenshteinDfa & operator = (const LevenshteinDfa &) = delete;
+    ~LevenshteinDfa();
+
+    static bool supports(uint32_t max_edit_distance) noexcept { return max_edit_distance <= MaxEditDistance; }
+
+    [[nodiscard]] bool is_match(std::string_view source) const;
+
+    /**
+     * Returns whether the source term matches. If it does not, the UTF-8 encoded successor is
+     * written to successor_out. If no term greater than the source term can match, successor_out
+     * is left empty.
+     */
+    [[nodiscard]] bool match(std::string_view source, vespalib::string & successor_out) const;
+
+    size_t num_states() const noexcept { return _states.size(); }
+
+private:
+    static constexpr uint32_t Dead = static_cast<uint32_t>(-1);
+
+    struct State {
+        // Transitions for code points that are present in the part of the query term covered by this state.
+        std::vector<std::pair<uint32_t, uint32_t>> edges;
+        // Transition for all other code points.
+        uint32_t other;
+        bool     accepting;
+        State() noexcept : edges(), other(Dead), accepting(false) {}
+        uint32_t next(uint32_t c) const noexcept;
+    };
+
+    std::vector<uint32_t> _prefix;
+    std::vector<uint32_t> _suffix;
+    std::vector<State>    _states;
+    uint32_t              _max_edit_distance;
+    bool                  _is_cased;
+
+    void build();
+    std::vector<uint32_t> to_codepoints(std::string_view source) const;
+    uint32_t smallest_alive_above(const State & state, uint32_t c) const;
+    void complete_successor(uint32_t state, std::vector<uint32_t> & successor) const;
+    static void write_successor(const std::vector<uint32_t> & successor, vespalib::string & successor_out);
+};
+
+}
@@ -10,6 +10,16 @@ Avx2Accelrator::populationCount(const uint64_t *a, size_t sz) const {
     return helper::populationCount(a, sz);
 }
 
+void
+Avx2Accelrator::maxUint8(uint8_t * a, const uint8_t * b, size_t sz) const {
+    helper::maxUint8(a, b, sz);
+}
+
+uint64_t
+Avx2Accelrator::sumUint8(const uint8_t * a, size_t sz) const {
+    return helper::sumUint8(a, sz);
+}
+
 double
 Avx2Accelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const {
     return helper::squaredEuclideanDistance(a, b, sz);
@@ -25,6 +35,16 @@ Avx2Accelrator::squaredEuclideanDistance(const double * a, const double * b, siz
     return avx::euclideanDistanceSelectAlignment<double, 32>(a, b, sz);
 }
 
+void
+Avx2Accelrator::squaredEuclideanDistances(const float * const * a, size_t num_a, const float * b, size_t sz, double * result) const {
+    helper::squaredEuclideanDistances<float, 32>(a, num_a, b, sz, result);
+}
+
+void
+Avx2Accelrator::squaredEuclideanDistances(const double * const * a, size_t num_a, const double * b, size_t sz, double * result) const {
+    helper::squaredEuclideanDistances<double, 32>(a, num_a, b, sz, result);
+}
+
 void
 Avx2Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<32u, 2u>(offset, src, dest);
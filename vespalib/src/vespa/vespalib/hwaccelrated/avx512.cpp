@@ -22,6 +22,16 @@ Avx512Accelrator::populationCount(const uint64_t *a, size_t sz) const {
     return helper::populationCount(a, sz);
 }
 
+void
+Avx512Accelrator::maxUint8(uint8_t * a, const uint8_t * b, size_t sz) const {
+    helper::maxUint8(a, b, sz);
+}
+
+uint64_t
+Avx512Accelrator::sumUint8(const uint8_t * a, size_t sz) const {
+    return helper::sumUint8(a, sz);
+}
+
 double
 Avx512Accelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const {
     return helper::squaredEuclideanDistance(a, b, sz);
@@ -37,6 +47,16 @@ Avx512Accelrator::squaredEuclideanDistance(const double * a, const double * b, s
     return avx::euclideanDistanceSelectAlignment<double, 64>(a, b, sz);
 }
 
+void
+Avx512Accelrator::squaredEuclideanDistances(const float * const * a, size_t num_a, const float * b, size_t sz, double * result) const {
+    helper::squaredEuclideanDistances<float, 64>(a, num_a, b, sz, result);
+}
+
+void
+Avx512Accelrator::squaredEuclideanDistances(const double * const * a, size_t num_a, const double * b, size_t sz, double * result) const {
+    helper::squaredEuclideanDistances<double, 64>(a, num_a, b, sz, result);
+}
+
 void
 Avx512Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<64, 1>(offset, src, dest);
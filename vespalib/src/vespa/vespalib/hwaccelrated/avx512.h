@@ -15,9 +15,13 @@ public:
     float dotProduct(const float * a, const float * b, size_t sz) const override;
     double dotProduct(const double * a, const double * b, size_t sz) const override;
     size_t populationCount(const uint64_t *a, size_t sz) const override;
+    void maxUint8(uint8_t * a, const uint8_t * b, size_t sz) const override;
+    uint64_t sumUint8(const uint8_t * a, size_t sz) const override;
     double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const override;
     double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const override;
     double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const override;
+    void squaredEuclideanDistances(const float * const * a, size_t num_a, const float * b, size_t sz, double * result) const override;
+    void squaredEuclideanDistances(const double * const * a, size_t num_a, const double * b, size_t sz, double * result) const override;
     void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
     void or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
 };
@@ -157,6 +157,16 @@ GenericAccelrator::populationCount(const uint64_t *a, size_t sz) const {
     return helper::populationCount(a, sz);
 }
 
+void
+GenericAccelrator::maxUint8(uint8_t * a, const uint8_t * b, size_t sz) const {
+    helper::maxUint8(a, b, sz);
+}
+
+uint64_t
+GenericAccelrator::sumUint8(const uint8_t * a, size_t sz) const {
+    return helper::sumUint8(a, sz);
+}
+
 double
 GenericAccelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const {
     return helper::squaredEuclideanDistance(a, b, sz);
@@ -172,6 +182,16 @@ GenericAccelrator::squaredEuclideanDistance(const double * a, const double * b,
     return squaredEuclideanDistanceT<double, 2>(a, b, sz);
 }
 
+void
+GenericAccelrator::squaredEuclideanDistances(const float * const * a, size_t num_a, const float * b, size_t sz, double * result) const {
+    helper::squaredEuclideanDistances<float, 16>(a, num_a, b, sz, result);
+}
+
+void
+GenericAccelrator::squaredEuclideanDistances(const double * const * a, size_t num_a, const double * b, size_t sz, double * result) const {
+    helper::squaredEuclideanDistances<double, 16>(a, num_a, b, sz, result);
+}
+
 void
 GenericAccelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<16, 4>(offset, src, dest);
@@ -28,9 +28,15 @@ public:
     virtual void andNotBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void notBit(void * a, size_t bytes) const = 0;
     virtual size_t populationCount(const uint64_t *a, size_t sz) const = 0;
+    // a[i] = max(a[i], b[i])
+    virtual void maxUint8(uint8_t * a, const uint8_t * b, size_t sz) const = 0;
+    virtual uint64_t sumUint8(const uint8_t * a, size_t sz) const = 0;
     virtual double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const = 0;
     virtual double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const = 0;
     virtual double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const = 0;
+    // result[i] = squaredEuclideanDistance(a[i], b, sz) for i in [0, num_a)
+    virtual void squaredEuclideanDistances(const float * const * a, size_t num_a, const float * b, size_t sz, double * result) const = 0;
+    virtual void squaredEuclideanDistances(const double * const * a, size_t num_a, const double * b, size_t sz, double * result) const = 0;
     // AND 64 bytes from multiple, optionally inverted sources
     virtual void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
     // OR 64 bytes from multiple, optionally inverted sources
@@ -24,6 +24,33 @@ populationCount(const uint64_t *a, size_t sz) {
     return count;
 }
 
+// Plain loops, vectorized by the compiler for the instruction set of each accelerator
+inline void
+maxUint8(uint8_t * a, const uint8_t * b, size_t sz) {
+    for (size_t i(0); i < sz; i++) {
+        a[i] = (a[i] < b[i]) ? b[i] : a[i];
+    }
+}
+
+inline uint64_t
+sumUint8(const uint8_t * a, size_t sz) {
+    // 16 bit partial sums can hold the sum of 256 bytes
+    constexpr size_t BLOCK = 256;
+    uint64_t sum(0);
+    size_t i(0);
+    for (; i + BLOCK <= sz; i += BLOCK) {
+        uint16_t partial(0);
+        for (size_t j(0); j < BLOCK; j++) {
+            partial += a[i + j];
+        }
+        sum += partial;
+    }
+    for (; i < sz; i++) {
+        sum += a[i];
+    }
+    return sum;
+}
+
 template<typename T, unsigned ChunkSize>
 T get(const void * base, bool invert) {
     static_assert(sizeof(T) == ChunkSize, "sizeof(T) == ChunkSize");
@@ -76,6 +103,51 @@ orChunks(size_t offset, const std::vector<std::pair<const void *, bool>> & src,
     }
 }
 
+// Squared euclidean distance between each of the vectors in a and the vector b.
+// A block of vectors from a is processed together, so each chunk of b is loaded once per block.
+template <typename T, unsigned VLEN, size_t NumA>
+void
+squaredEuclideanDistancesBlock(const T * const * a, const T * b, size_t sz, double * result) {
+    typedef T V __attribute__ ((vector_size (VLEN)));
+    typedef T U __attribute__ ((vector_size (VLEN), aligned(alignof(T))));
+    constexpr size_t ElemsPerVector = VLEN/sizeof(T);
+    V partial[NumA];
+    memset(partial, 0, sizeof(partial));
+    const size_t numVectors(sz/ElemsPerVector);
+    const U * bv = reinterpret_cast<const U *>(b);
+    for (size_t i(0); i < numVectors; i++) {
+        V bi = bv[i];
+        for (size_t n(0); n < NumA; n++) {
+            V d = reinterpret_cast<const U *>(a[n])[i] - bi;
+            partial[n] += d * d;
+        }
+    }
+    for (size_t n(0); n < NumA; n++) {
+        double sum(0);
+        for (size_t i(0); i < ElemsPerVector; i++) {
+            sum += partial[n][i];
+        }
+        for (size_t i(numVectors*ElemsPerVector); i < sz; i++) {
+            T d = a[n][i] - b[i];
+            sum += d * d;
+        }
+        result[n] = sum;
+    }
+}
+
+template <typename T, unsigned VLEN>
+void
+squaredEuclideanDistances(const T * const * a, size_t num_a, const T * b, size_t sz, double * result) {
+    constexpr size_t BLOCK = 4;
+    size_t n(0);
+    for (; n + BLOCK <= num_a; n += BLOCK) {
+        squaredEuclideanDistancesBlock<T, VLEN, BLOCK>(a + n, b, sz, result + n);
+    }
+    for (; n < num_a; n++) {
+        squaredEuclideanDistancesBlock<T, VLEN, 1>(a + n, b, sz, result + n);
+    }
+}
+
 template<typename TemporaryT=int32_t>
 double squaredEuclideanDistanceT(const int8_t * a, const int8_t * b, size_t sz) __attribute__((noinline));
 template<typename TemporaryT>
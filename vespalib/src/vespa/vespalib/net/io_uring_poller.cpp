@@ -0,0 +1,431 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "io_uring_poller.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+
+// the features we depend on are found in the kernel headers of linux 5.11 and later
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(IORING_SETUP_CQSIZE) && \
+    defined(IORING_FEAT_SINGLE_MMAP) && defined(IORING_FEAT_NODROP) && \
+    defined(IORING_FEAT_EXT_ARG) && defined(IORING_ENTER_EXT_ARG)
+#define HAS_IO_URING_POLLER 1
+#endif
+
+#ifdef HAS_IO_URING_POLLER
+
+#include <sys/mman.h>
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <poll.h>
+#include <unistd.h>
+
+namespace vespalib {
+
+namespace {
+
+constexpr uint32_t sq_size = 1024;
+constexpr uint32_t cq_size = 8192;
+
+// user_data of poll remove requests; their completions are ignored
+constexpr uint64_t cancel_tag = ~uint64_t(0);
+
+uint32_t maybe(uint32_t value, bool yes) { return yes ? value : 0; }
+
+uint64_t make_user_data(int fd, uint32_t gen) { return (uint64_t(gen) << 32) | uint32_t(fd); }
+
+template <typename T>
+T *offset_ptr(void *base, uint32_t offset) { return reinterpret_cast<T *>(static_cast<char *>(base) + offset); }
+
+int sys_io_uring_setup(uint32_t entries, io_uring_params *params) {
+    return syscall(__NR_io_uring_setup, entries, params);
+}
+
+int sys_io_uring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags, const void *arg, size_t argsz) {
+    return syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, argsz);
+}
+
+int setup_ring(io_uring_params &params) {
+    // prefer submitting past failing requests and not interrupting
+    // the event loop to run completion work, when supported
+    uint32_t optional_flags = 0;
+#ifdef IORING_SETUP_SUBMIT_ALL
+    optional_flags |= IORING_SETUP_SUBMIT_ALL;
+#endif
+#ifdef IORING_SETUP_COOP_TASKRUN
+    optional_flags |= IORING_SETUP_COOP_TASKRUN;
+#endif
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE | optional_flags;
+    params.cq_entries = cq_size;
+    int fd = sys_io_uring_setup(sq_size, &params);
+    if ((fd == -1) && (errno == EINVAL) && (optional_flags != 0)) {
+        memset(&params, 0, sizeof(params));
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = cq_size;
+        fd = sys_io_uring_setup(sq_size, &params);
+    }
+    return fd;
+}
+
+} // namespace vespalib::<unnamed>
+
+/**
+ * The memory mapped submission and completion queues of an io_uring
+ * instance.
+ **/
+struct IoUringPoller::Ring {
+    int           fd;
+    void         *ring_ptr;
+    size_t        ring_bytes;
+    io_uring_sqe *sqes;
+    size_t        sqe_bytes;
+    uint32_t     *sq_head;
+    uint32_t     *sq_tail;
+    uint32_t      sq_mask;
+    uint32_t      sq_entries;
+    uint32_t     *cq_head;
+    uint32_t     *cq_tail;
+    uint32_t      cq_mask;
+    io_uring_cqe *cqes;
+    uint32_t      local_tail;
+    uint32_t      to_submit;
+
+    Ring(int fd_in, const io_uring_params &params, void *ring_ptr_in, size_t ring_bytes_in, void *sqes_in, size_t sqe_bytes_in)
+        : fd(fd_in),
+          ring_ptr(ring_ptr_in),
+          ring_bytes(ring_bytes_in),
+          sqes(static_cast<io_uring_sqe *>(sqes_in)),
+          sqe_bytes(sqe_bytes_in),
+          sq_head(offset_ptr<uint32_t>(ring_ptr, params.sq_off.head)),
+          sq_tail(offset_ptr<uint32_t>(ring_ptr, params.sq_off.tail)),
+          sq_mask(*offset_ptr<uint32_t>(ring_ptr, params.sq_off.ring_mask)),
+          sq_entries(params.sq_entries),
+          cq_head(offset_ptr<uint32_t>(ring_ptr, params.cq_off.head)),
+          cq_tail(offset_ptr<uint32_t>(ring_ptr, params.cq_off.tail)),
+          cq_mask(*offset_ptr<uint32_t>(ring_ptr, params.cq_off.ring_mask)),
+          cqes(offset_ptr<io_uring_cqe>(ring_ptr, params.cq_off.cqes)),
+          local_tail(*sq_tail),
+          to_submit(0)
+    {
+        // submission queue entries are always used in ring order
+        uint32_t *array = offset_ptr<uint32_t>(ring_ptr, params.sq_off.array);
+        for (uint32_t i = 0; i < sq_entries; ++i) {
+            array[i] = i;
+        }
+    }
+    ~Ring() {
+        munmap(sqes, sqe_bytes);
+        munmap(ring_ptr, ring_bytes);
+        close(fd);
+    }
+
+    // submit queued requests and optionally wait for completions
+    void enter(uint32_t min_complete, int timeout_ms) {
+        __atomic_store_n(sq_tail, local_tail, __ATOMIC_RELEASE);
+        uint32_t flags = 0;
+        io_uring_getevents_arg arg;
+        timespec ts;
+        if (min_complete > 0) {
+            flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+            memset(&arg, 0, sizeof(arg));
+            arg.sigmask_sz = _NSIG / 8;
+            if (timeout_ms >= 0) {
+                ts.tv_sec = timeout_ms / 1000;
+                ts.tv_nsec = (timeout_ms % 1000) * 1000000L;
+                arg.ts = reinterpret_cast<uint64_t>(&ts);
+            }
+        } else if (to_submit == 0) {
+            return;
+        }
+        int res = (flags != 0)
+                  ? sys_io_uring_enter(fd, to_submit, min_complete, flags, &arg, sizeof(arg))
+                  : sys_io_uring_enter(fd, to_submit, 0, 0, nullptr, 0);
+        // timeouts and interrupted waits are reported as errors when
+        // nothing was submitted; both simply yield no events
+        if (res > 0) {
+            to_submit -= std::min(uint32_t(res), to_submit);
+        }
+    }
+
+    // returns nullptr only if queued requests could not be submitted
+    io_uring_sqe *next_sqe() {
+        if ((local_tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE)) == sq_entries) {
+            enter(0, 0);
+            if ((local_tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE)) == sq_entries) {
+                return nullptr;
+            }
+        }
+        io_uring_sqe *sqe = &sqes[local_tail & sq_mask];
+        memset(sqe, 0, sizeof(*sqe));
+        ++local_tail;
+        ++to_submit;
+        return sqe;
+    }
+
+    bool has_completions() const {
+        return (*cq_head != __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE));
+    }
+};
+
+IoUringPoller::IoUringPoller(std::unique_ptr<Ring> ring)
+    : _ring(std::move(ring)),
+      _entries(),
+      _pending(),
+      _pending_cancels(),
+      _backlog()
+{
+}
+
+IoUringPoller::~IoUringPoller() = default;
+
+std::unique_ptr<IoUringPoller>
+IoUringPoller::try_create()
+{
+    io_uring_params params;
+    int fd = setup_ring(params);
+    if (fd == -1) {
+        return {};
+    }
+    uint32_t required = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG;
+    if ((params.features & required) != required) {
+        close(fd);
+        return {};
+    }
+    size_t sq_bytes = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    size_t cq_bytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    size_t ring_bytes = std::max(sq_bytes, cq_bytes);
+    void *ring_ptr = mmap(nullptr, ring_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ring_ptr == MAP_FAILED) {
+        close(fd);
+        return {};
+    }
+    size_t sqe_bytes = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = mmap(nullptr, sqe_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        munmap(ring_ptr, ring_bytes);
+        close(fd);
+        return {};
+    }
+    auto ring = std::make_unique<Ring>(fd, params, ring_ptr, ring_bytes, sqes, sqe_bytes);
+    return std::unique_ptr<IoUringPoller>(new IoUringPoller(std::move(ring)));
+}
+
+IoUringPoller::Entry &
+IoUringPoller::entry(int fd)
+{
+    if (size_t(fd) >= _entries.size()) {
+        _entries.resize(fd + 1);
+    }
+    return _entries[fd];
+}
+
+void
+IoUringPoller::arm(int fd, Entry &e)
+{
+    io_uring_sqe *sqe = _ring->next_sqe();
+    if (sqe == nullptr) {
+        e.pending = true;
+        _pending.push_back(fd);
+        return;
+    }
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = e.events;
+    sqe->user_data = make_user_data(fd, e.gen);
+    e.armed = true;
+}
+
+void
+IoUringPoller::cancel(Entry &e, int fd)
+{
+    if (e.armed) {
+        submit_cancel(make_user_data(fd, e.gen));
+        e.armed = false;
+    }
+    // completions for the old request are recognized as stale
+    ++e.gen;
+}
+
+void
+IoUringPoller::submit_cancel(uint64_t target)
+{
+    io_uring_sqe *sqe = _ring->next_sqe();
+    if (sqe == nullptr) {
+        // the kernel refuses new requests while the completion queue
+        // is full; make room for the completions and try again
+        flush();
+        sqe = _ring->next_sqe();
+    }
+    if (sqe == nullptr) {
+        // the poll request must be cancelled for the file to be released
+        _pending_cancels.push_back(target);
+        return;
+    }
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = target;
+    sqe->user_data = cancel_tag;
+}
+
+void
+IoUringPoller::flush()
+{
+    uint32_t head = *_ring->cq_head;
+    uint32_t tail = __atomic_load_n(_ring->cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+        const io_uring_cqe &cqe = _ring->cqes[head & _ring->cq_mask];
+        if (cqe.user_data != cancel_tag) {
+            _backlog.push_back({cqe.user_data, cqe.res});
+        }
+    }
+    __atomic_store_n(_ring->cq_head, head, __ATOMIC_RELEASE);
+    _ring->enter(0, 0);
+}
+
+bool
+IoUringPoller::complete(uint64_t user_data, int32_t res, epoll_event &event)
+{
+    if (user_data == cancel_tag) {
+        return false;
+    }
+    int fd = int(uint32_t(user_data));
+    uint32_t gen = uint32_t(user_data >> 32);
+    if ((size_t(fd) >= _entries.size()) || (_entries[fd].gen != gen)) {
+        return false;
+    }
+    Entry &e = _entries[fd];
+    e.armed = false;
+    if (!e.pending) {
+        e.pending = true;
+        _pending.push_back(fd);
+    }
+    uint32_t mask = (res < 0) ? uint32_t(EPOLLERR) : uint32_t(res);
+    event.events = mask & (EPOLLIN | EPOLLOUT | EPOLLERR | EPOLLHUP);
+    event.data.ptr = e.ctx;
+    return true;
+}
+
+void
+IoUringPoller::add(int fd, void *ctx, bool read, bool write)
+{
+    Entry &e = entry(fd);
+    cancel(e, fd);
+    e.ctx = ctx;
+    e.events = maybe(POLLIN, read) | maybe(POLLOUT, write);
+    e.active = true;
+    if (!e.pending) {
+        e.pending = true;
+        _pending.push_back(fd);
+    }
+}
+
+void
+IoUringPoller::update(int fd, void *ctx, bool read, bool write)
+{
+    Entry &e = entry(fd);
+    uint32_t events = maybe(POLLIN, read) | maybe(POLLOUT, write);
+    e.ctx = ctx;
+    if (e.events != events) {
+        cancel(e, fd);
+        e.events = events;
+        if (!e.pending) {
+            e.pending = true;
+            _pending.push_back(fd);
+        }
+    }
+}
+
+void
+IoUringPoller::remove(int fd)
+{
+    Entry &e = entry(fd);
+    cancel(e, fd);
+    e.ctx = nullptr;
+    e.events = 0;
+    e.active = false;
+    // the poll request holds a reference to the file; cancel it right
+    // away so that closing the file descriptor takes effect
+    _ring->enter(0, 0);
+}
+
+size_t
+IoUringPoller::wait(epoll_event *events, size_t max_events, int timeout_ms)
+{
+    std::vector<uint64_t> cancels;
+    cancels.swap(_pending_cancels);
+    for (uint64_t target: cancels) {
+        submit_cancel(target);
+    }
+    std::vector<int> pending;
+    pending.swap(_pending);
+    for (int fd: pending) {
+        Entry &e = _entries[fd];
+        e.pending = false;
+        if (e.active && !e.armed) {
+            arm(fd, e);
+        }
+    }
+    if (_backlog.empty() && !_ring->has_completions() && (timeout_ms != 0)) {
+        _ring->enter(1, timeout_ms);
+    } else {
+        _ring->enter(0, 0);
+    }
+    size_t num_events = 0;
+    size_t done = 0;
+    for (; (done < _backlog.size()) && (num_events < max_events); ++done) {
+        if (complete(_backlog[done].user_data, _backlog[done].res, events[num_events])) {
+            ++num_events;
+        }
+    }
+    _backlog.erase(_backlog.begin(), _backlog.begin() + done);
+    uint32_t head = *_ring->cq_head;
+    uint32_t tail = __atomic_load_n(_ring->cq_tail, __ATOMIC_ACQUIRE);
+    for (; (head != tail) && (num_events < max_events); ++head) {
+        const io_uring_cqe &cqe = _ring->cqes[head & _ring->cq_mask];
+        if (complete(cqe.user_data, cqe.res, events[num_events])) {
+            ++num_events;
+        }
+    }
+    __atomic_store_n(_ring->cq_head, head, __ATOMIC_RELEASE);
+    return num_events;
+}
+
+}
+
+#else
+
+namespace vespalib {
+
+struct IoUringPoller::Ring {};
+
+IoUringPoller::IoUringPoller(std::unique_ptr<Ring> ring)
+    : _ring(std::move(ring)),
+      _entries(),
+      _pending(),
+      _pending_cancels(),
+      _backlog()
+{
+}
+
+IoUringPoller::~IoUringPoller() = default;
+
+std::unique_ptr<IoUringPoller>
+IoUringPoller::try_create()
+{
+    return {};
+}
+
+void IoUringPoller::add(int, void *, bool, bool) {}
+void IoUringPoller::update(int, void *, bool, bool) {}
+void IoUringPoller::remove(int) {}
+size_t IoUringPoller::wait(epoll_event *, size_t, int) { return 0; }
+
+}
+
+#endif
@@ -0,0 +1,85 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#ifdef __APPLE__
+#include "emulated_epoll.h"
+#else
+#include "native_epoll.h"
+#endif
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Readiness polling on top of io_uring, offering the same interface
+ * and level-triggered semantics as the Epoll class.
+ *
+ * Each registered file descriptor has a one-shot poll request in
+ * flight that is re-armed when its completion has been reported.
+ * Changes in interest and re-arming are queued and submitted together
+ * with the next wait, so that a busy event loop performs a single
+ * system call per iteration instead of one epoll_ctl per change.
+ *
+ * Only readiness is reported through io_uring. Reading from and
+ * writing to the sockets is still done with regular system calls by
+ * the owner of each socket, so the data path is the same as with
+ * Epoll.
+ *
+ * Unlike Epoll, this class is not thread-safe; add, update, remove
+ * and wait must all be called by the thread running the event loop.
+ **/
+class IoUringPoller
+{
+private:
+    struct Entry {
+        void     *ctx;
+        uint32_t  gen;
+        uint32_t  events;
+        bool      active;
+        bool      armed;
+        bool      pending;
+        Entry() noexcept : ctx(nullptr), gen(0), events(0), active(false), armed(false), pending(false) {}
+    };
+    struct Completion {
+        uint64_t user_data;
+        int32_t  res;
+    };
+    struct Ring;
+
+    std::unique_ptr<Ring>   _ring;
+    std::vector<Entry>      _entries;
+    std::vector<int>        _pending;
+    // poll requests to cancel when the submission queue has room again
+    std::vector<uint64_t>   _pending_cancels;
+    // completions moved out of the completion queue, not yet reported
+    std::vector<Completion> _backlog;
+
+    explicit IoUringPoller(std::unique_ptr<Ring> ring);
+    Entry &entry(int fd);
+    void arm(int fd, Entry &entry);
+    void cancel(Entry &entry, int fd);
+    void submit_cancel(uint64_t target);
+    void flush();
+    bool complete(uint64_t user_data, int32_t res, epoll_event &event);
+public:
+    IoUringPoller(const IoUringPoller &) = delete;
+    IoUringPoller &operator=(const IoUringPoller &) = delete;
+    ~IoUringPoller();
+
+    /**
+     * Create a poller, or return nullptr if io_uring (or a feature we
+     * depend on) is not available on this system or was not known by
+     * the kernel headers used when building.
+     **/
+    static std::unique_ptr<IoUringPoller> try_create();
+
+    void add(int fd, void *ctx, bool read, bool write);
+    void update(int fd, void *ctx, bool read, bool write);
+    void remove(int fd);
+    size_t wait(epoll_event *events, size_t max_events, int timeout_ms);
+};
+
+}
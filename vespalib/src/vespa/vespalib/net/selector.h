@@ -3,11 +3,7 @@
 #pragma once
 
 #include "wakeup_pipe.h"
-#ifdef __APPLE__
-#include "emulated_epoll.h"
-#else
-#include "native_epoll.h"
-#endif
+#include "io_uring_poller.h"
 #include <vector>
 
 namespace vespalib {
@@ -22,8 +18,9 @@ private:
     size_t                   _num_events;
 public:
     EpollEvents(size_t max_events) : _epoll_events(max_events), _num_events(0) {}
-    void extract(Epoll &epoll, int timeout_ms) {
-        _num_events = epoll.wait(&_epoll_events[0], _epoll_events.size(), timeout_ms);
+    template <typename Poller>
+    void extract(Poller &poller, int timeout_ms) {
+        _num_events = poller.wait(&_epoll_events[0], _epoll_events.size(), timeout_ms);
     }
     const epoll_event *begin() const { return &_epoll_events[0]; }
     const epoll_event *end() const { return &_epoll_events[_num_events]; }
@@ -33,27 +30,65 @@ public:
 //-----------------------------------------------------------------------------
 enum class SelectorDispatchResult {WAKEUP_CALLED, NO_WAKEUP};
 
+/**
+ * The mechanism used by a Selector to wait for events. IO_URING is
+ * only used when supported by the running kernel, otherwise the
+ * selector falls back to EPOLL. With IO_URING, add, update and remove
+ * must be called by the thread polling the selector.
+ **/
+enum class SelectorBackend {EPOLL, IO_URING};
+
 template <typename Context>
 class Selector
 {
 private:
-    Epoll       _epoll;
+    std::unique_ptr<IoUringPoller> _uring;
+    std::unique_ptr<Epoll>         _epoll;
     WakeupPipe  _wakeup_pipe;
     EpollEvents _events;
+
+    void add_fd(int fd, void *ctx, bool read, bool write) {
+        if (_uring) {
+            _uring->add(fd, ctx, read, write);
+        } else {
+            _epoll->add(fd, ctx, read, write);
+        }
+    }
 public:
-    Selector()
-        : _epoll(), _wakeup_pipe(), _events(4096)
+    Selector() : Selector(SelectorBackend::EPOLL) {}
+    explicit Selector(SelectorBackend backend)
+        : _uring((backend == SelectorBackend::IO_URING) ? IoUringPoller::try_create() : nullptr),
+          _epoll(_uring ? nullptr : std::make_unique<Epoll>()), _wakeup_pipe(), _events(4096)
     {
-        _epoll.add(_wakeup_pipe.get_read_fd(), nullptr, true, false);    
+        add_fd(_wakeup_pipe.get_read_fd(), nullptr, true, false);
     }
     ~Selector() {
-        _epoll.remove(_wakeup_pipe.get_read_fd());
+        remove(_wakeup_pipe.get_read_fd());
+    }
+    bool using_io_uring() const { return bool(_uring); }
+    void add(int fd, Context &ctx, bool read, bool write) { add_fd(fd, &ctx, read, write); }
+    void update(int fd, Context &ctx, bool read, bool write) {
+        if (_uring) {
+            _uring->update(fd, &ctx, read, write);
+        } else {
+            _epoll->update(fd, &ctx, read, write);
+        }
+    }
+    void remove(int fd) {
+        if (_uring) {
+            _uring->remove(fd);
+        } else {
+            _epoll->remove(fd);
+        }
     }
-    void add(int fd, Context &ctx, bool read, bool write) { _epoll.add(fd, &ctx, read, write); }
-    void update(int fd, Context &ctx, bool read, bool write) { _epoll.update(fd, &ctx, read, write); }
-    void remove(int fd) { _epoll.remove(fd); }
     void wakeup() { _wakeup_pipe.write_token(); }
-    void poll(int timeout_ms) { _events.extract(_epoll, timeout_ms); }
+    void poll(int timeout_ms) {
+        if (_uring) {
+            _events.extract(*_uring, timeout_ms);
+        } else {
+            _events.extract(*_epoll, timeout_ms);
+        }
+    }
     size_t num_events() const { return _events.size(); }
     template <typename Handler>
     SelectorDispatchResult dispatch(Handler &handler) {
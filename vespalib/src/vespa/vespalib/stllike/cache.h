@@ -105,6 +105,22 @@ public:
      */
     void write(const K & key, V value);
 
+    /**
+     * Returns the generation of the given key. It changes every time the key is written or
+     * invalidated. Fetch it before reading an object from the backing store by other means,
+     * and hand it to populate().
+     */
+    uint64_t getGeneration(const K & key) const;
+
+    /**
+     * Insert an object that was read from the backing store by other means, e.g. in a batch,
+     * as if it was fetched by read(). Nothing is written to the backing store, and an object
+     * already in the cache is kept as is. The object is only inserted when the generation of the
+     * key is still the given one, so a concurrent write or invalidation is never overwritten
+     * by an older object.
+     */
+    void populate(const K & key, V value, uint64_t generation);
+
     /**
      * Tell if an object with given key exists in the cache.
      * Does not alter the LRU list.
@@ -137,9 +153,13 @@ private:
      */
     bool removeOldest(const value_type & v) override;
     size_t calcSize(const K & k, const V & v) const { return sizeof(value_type) + _sizeK(k) + _sizeV(v); }
+    static constexpr size_t NUM_STRIPES = 113;
+    size_t getStripe(const K & k) const { return _hasher(k) % NUM_STRIPES; }
     std::mutex & getLock(const K & k) {
-        size_t h(_hasher(k));
-        return _addLocks[h%(sizeof(_addLocks)/sizeof(_addLocks[0]))];
+        return _addLocks[getStripe(k)];
+    }
+    void bumpGeneration(const K & k) {
+        _generations[getStripe(k)].fetch_add(1, std::memory_order_relaxed);
     }
 
     template <typename V>
@@ -168,7 +188,9 @@ private:
     BackingStore      & _store;
     mutable std::mutex  _hashLock;
     /// Striped locks that can be used for having a locked access to the backing store.
-    std::mutex          _addLocks[113];
+    std::mutex          _addLocks[NUM_STRIPES];
+    /// Striped generations, bumped with the hash lock held when a key is written or invalidated.
+    std::atomic<uint64_t> _generations[NUM_STRIPES];
 };
 
 }
@@ -60,7 +60,11 @@ cache<P>::cache(BackingStore & b, size_t maxBytes) :
     _invalidate(0),
     _lookup(0),
     _store(b)
-{ }
+{
+    for (auto & generation : _generations) {
+        generation.store(0, std::memory_order_relaxed);
+    }
+}
 
 template< typename P >
 bool
@@ -132,10 +136,36 @@ cache<P>::write(const K & key, V value)
         std::lock_guard guard(_hashLock);
         (*this)[key] = std::move(value);
         _sizeBytes.store(sizeBytes() + newSize, std::memory_order_relaxed);
+        bumpGeneration(key);
         increment_stat(_write, guard);
     }
 }
 
+template< typename P >
+uint64_t
+cache<P>::getGeneration(const K & key) const
+{
+    std::lock_guard guard(_hashLock);
+    return _generations[getStripe(key)].load(std::memory_order_relaxed);
+}
+
+template< typename P >
+void
+cache<P>::populate(const K & key, V value, uint64_t generation)
+{
+    size_t newSize = calcSize(key, value);
+    std::lock_guard storeGuard(getLock(key));
+    std::lock_guard guard(_hashLock);
+    if (_generations[getStripe(key)].load(std::memory_order_relaxed) != generation) {
+        // Written or invalidated since the object was read, it might be stale.
+        increment_stat(_race, guard);
+    } else if ( ! Lru::hasKey(key)) {
+        Lru::insert(key, std::move(value));
+        _sizeBytes.store(sizeBytes() + newSize, std::memory_order_relaxed);
+        increment_stat(_insert, guard);
+    }
+}
+
 template< typename P >
 void
 cache<P>::erase(const K & key)
@@ -150,6 +180,7 @@ void
 cache<P>::invalidate(const UniqueLock & guard, const K & key)
 {
     verifyHashLock(guard);
+    bumpGeneration(key);
     if (Lru::hasKey(key)) {
         _sizeBytes.store(sizeBytes() - calcSize(key, (*this)[key]), std::memory_order_relaxed);
         increment_stat(_invalidate, guard);
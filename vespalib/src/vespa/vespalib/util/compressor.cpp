@@ -55,7 +55,7 @@ compress(ICompressor & compressor, CompressionConfig compression, const ConstBuf
 }
 
 CompressionConfig::Type
-docompress(CompressionConfig compression, const ConstBufferRef & org, DataBuffer & dest)
+docompress(CompressionConfig compression, const ConstBufferRef & org, DataBuffer & dest, const ZStdDictionary * dictionary)
 {
     switch (compression.type) {
     case CompressionConfig::LZ4:
@@ -65,7 +65,7 @@ docompress(CompressionConfig compression, const ConstBufferRef & org, DataBuffer
         }
     case CompressionConfig::ZSTD:
         {
-            ZStdCompressor zstd;
+            ZStdCompressor zstd(dictionary);
             return compress(zstd, compression, org, dest);
         }
     case CompressionConfig::NONE_MULTI:
@@ -83,10 +83,16 @@ compress(CompressionConfig::Type compression, const ConstBufferRef & org, DataBu
 
 CompressionConfig::Type
 compress(CompressionConfig compression, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap)
+{
+    return compress(compression, org, dest, allowSwap, nullptr);
+}
+
+CompressionConfig::Type
+compress(CompressionConfig compression, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap, const ZStdDictionary * dictionary)
 {
     CompressionConfig::Type type(CompressionConfig::NONE);
     if (org.size() >= compression.minSize) {
-        type = docompress(compression, org, dest);
+        type = docompress(compression, org, dest, dictionary);
     }
     if ((type == CompressionConfig::NONE) || (type == CompressionConfig::NONE_MULTI)) {
         if (allowSwap) {
@@ -126,6 +132,13 @@ decompress(ICompressor & decompressor, size_t uncompressedLen, const ConstBuffer
 
 void
 decompress(CompressionConfig::Type type, size_t uncompressedLen, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap)
+{
+    decompress(type, uncompressedLen, org, dest, allowSwap, nullptr);
+}
+
+void
+decompress(CompressionConfig::Type type, size_t uncompressedLen, const ConstBufferRef & org, DataBuffer & dest,
+           bool allowSwap, const ZStdDictionary * dictionary)
 {
     switch (type) {
     case CompressionConfig::LZ4:
@@ -136,7 +149,7 @@ decompress(CompressionConfig::Type type, size_t uncompressedLen, const ConstBuff
         break;
         case CompressionConfig::ZSTD:
         {
-            ZStdCompressor zstd;
+            ZStdCompressor zstd(dictionary);
             decompress(zstd, uncompressedLen, org, dest, allowSwap);
         }
         break;
@@ -2,7 +2,10 @@
 
 #include "zstdcompressor.h"
 #include <vespa/vespalib/util/alloc.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <zstd.h>
+#include <zdict.h>
 #include <cassert>
 
 using vespalib::alloc::Alloc;
@@ -33,6 +36,64 @@ thread_local std::unique_ptr<DecompressContext> _tlDecompressState;
 
 }
 
+ZStdDictionary::ZStdDictionary(ConstBufferRef content, int compressionLevel)
+    : _content(content.c_str(), content.c_str() + content.size()),
+      _compressionLevel(compressionLevel),
+      _id(ZDICT_getDictID(_content.data(), _content.size())),
+      _ddict(ZSTD_createDDict(_content.data(), _content.size())),
+      _cdict(nullptr),
+      _cdictOnce()
+{
+    if (_ddict == nullptr) {
+        throw IllegalArgumentException(make_string("Invalid zstd dictionary of %zu bytes (id=%u)", _content.size(), _id));
+    }
+    if (_id == 0) {
+        // Frames compressed with a raw content dictionary do not refer to it, and could not be
+        // told apart from frames compressed without a dictionary when decompressing.
+        ZSTD_freeDDict(_ddict);
+        throw IllegalArgumentException(make_string("Invalid zstd dictionary of %zu bytes, raw content dictionaries are not supported",
+                                                   _content.size()));
+    }
+}
+
+ZStdDictionary::~ZStdDictionary()
+{
+    ZSTD_freeCDict(_cdict);
+    ZSTD_freeDDict(_ddict);
+}
+
+ZSTD_CDict *
+ZStdDictionary::compressDict() const
+{
+    std::call_once(_cdictOnce, [this]() {
+        _cdict = ZSTD_createCDict(_content.data(), _content.size(), _compressionLevel);
+        if (_cdict == nullptr) {
+            throw IllegalArgumentException(make_string("Failed creating zstd compression dictionary of %zu bytes (id=%u)",
+                                                       _content.size(), _id));
+        }
+    });
+    return _cdict;
+}
+
+ZStdDictionary::SP
+ZStdDictionary::train(const std::vector<ConstBufferRef> & samples, size_t maxSize, int compressionLevel)
+{
+    std::vector<char> samplesBuffer;
+    std::vector<size_t> sampleSizes;
+    sampleSizes.reserve(samples.size());
+    for (const ConstBufferRef & sample : samples) {
+        samplesBuffer.insert(samplesBuffer.end(), sample.c_str(), sample.c_str() + sample.size());
+        sampleSizes.push_back(sample.size());
+    }
+    std::vector<char> dictionary(maxSize);
+    size_t sz = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samplesBuffer.data(),
+                                      sampleSizes.data(), sampleSizes.size());
+    if (ZDICT_isError(sz)) {
+        return SP();
+    }
+    return std::make_shared<ZStdDictionary>(ConstBufferRef(dictionary.data(), sz), compressionLevel);
+}
+
 size_t ZStdCompressor::adjustProcessLen(uint16_t, size_t len)   const { return ZSTD_compressBound(len); }
 
 bool
@@ -42,7 +103,18 @@ ZStdCompressor::process(CompressionConfig config, const void * inputV, size_t in
     if ( ! _tlCompressState) {
         _tlCompressState = std::make_unique<CompressContext>();
     }
-    size_t sz = ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
+    size_t sz;
+    if (_dictionary == nullptr) {
+        sz = ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
+    } else if (_dictionary->compressionLevel() == config.compressionLevel) {
+        sz = ZSTD_compress_usingCDict(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen,
+                                      _dictionary->compressDict());
+    } else {
+        // The digested dictionary is bound to a compression level, fall back to digesting it on every call.
+        ConstBufferRef content = _dictionary->content();
+        sz = ZSTD_compress_usingDict(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen,
+                                     content.c_str(), content.size(), config.compressionLevel);
+    }
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
@@ -54,7 +126,12 @@ ZStdCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV,
     if ( ! _tlDecompressState) {
         _tlDecompressState = std::make_unique<DecompressContext>();
     }
-    size_t sz = ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
+    // Only frames compressed with a dictionary refer to one, others are decompressed as is.
+    bool useDictionary = (_dictionary != nullptr) && (ZSTD_getDictID_fromFrame(inputV, inputLen) != 0);
+    size_t sz = useDictionary
+                ? ZSTD_decompress_usingDDict(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen,
+                                             _dictionary->decompressDict())
+                : ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
@@ -2,15 +2,68 @@
 #pragma once
 
 #include "compressor.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
 
 namespace vespalib::compression {
 
+/**
+ * A zstd dictionary, typically trained from a sample of the data it will be used for.
+ * Small buffers with similar content, like a chunk of documents of the same type,
+ * compress a lot better with a shared dictionary than on their own.
+ *
+ * The digested dictionary used for decompression is built up front, while the one used
+ * for compression is built on first use with the given compression level.
+ * Both are read only after being built and can be shared between threads.
+ */
+class ZStdDictionary
+{
+public:
+    using SP = std::shared_ptr<const ZStdDictionary>;
+    /**
+     * Creates a dictionary from previously trained content.
+     * Throws IllegalArgumentException if the content is not a valid zstd dictionary,
+     * or if it is a raw content dictionary without a dictionary id.
+     */
+    ZStdDictionary(ConstBufferRef content, int compressionLevel);
+    ZStdDictionary(const ZStdDictionary &) = delete;
+    ZStdDictionary & operator = (const ZStdDictionary &) = delete;
+    ~ZStdDictionary();
+
+    /**
+     * Trains a dictionary of at most maxSize bytes from the given samples.
+     * Returns an empty pointer if there is too little sample data to train from.
+     */
+    static SP train(const std::vector<ConstBufferRef> & samples, size_t maxSize, int compressionLevel);
+
+    ConstBufferRef content() const { return ConstBufferRef(_content.data(), _content.size()); }
+    uint32_t id() const { return _id; }
+    int compressionLevel() const { return _compressionLevel; }
+    ZSTD_CDict_s * compressDict() const;
+    ZSTD_DDict_s * decompressDict() const { return _ddict; }
+private:
+    std::vector<char>       _content;
+    int                     _compressionLevel;
+    uint32_t                _id;
+    ZSTD_DDict_s          * _ddict;
+    mutable ZSTD_CDict_s  * _cdict;
+    mutable std::once_flag  _cdictOnce;
+};
+
 class ZStdCompressor : public ICompressor
 {
 public:
+    ZStdCompressor() noexcept : ZStdCompressor(nullptr) { }
+    explicit ZStdCompressor(const ZStdDictionary * dictionary) noexcept : _dictionary(dictionary) { }
     bool process(CompressionConfig config, const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     bool unprocess(const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     size_t adjustProcessLen(uint16_t options, size_t len)   const override;
+private:
+    const ZStdDictionary * _dictionary;
 };
 
 }